@@ -0,0 +1,124 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "data.h"
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include "filesystem/filesystem.hpp"
+#include "genie/util/runtime-exception.h"
+#include "genie/util/string-helpers.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace benchmark_common {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string getDataPath(const std::string& name) { return std::string(GENIE_DATA_DIR) + "/" + name; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<std::string> readSamColumn(size_t column) {
+    std::vector<std::string> files;
+    for (const auto& entry : ghc::filesystem::directory_iterator(getDataPath("sam"))) {
+        if (entry.path().extension() == ".sam") {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<std::string> ret;
+    for (const auto& file : files) {
+        std::ifstream in(file);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line.front() == '@') {
+                continue;
+            }
+            auto fields = genie::util::tokenize(line, '\t');
+            if (fields.size() > column && fields[column] != "*") {
+                ret.push_back(fields[column]);
+            }
+        }
+    }
+    UTILS_DIE_IF(ret.empty(), "No SAM data found in " + getDataPath("sam"));
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<std::string> readFastqNames(const std::string& name) {
+    std::ifstream in(getDataPath(name));
+    UTILS_DIE_IF(!in, "Could not open " + getDataPath(name));
+    std::vector<std::string> ret;
+    std::string line;
+    for (size_t i = 0; std::getline(in, line); ++i) {
+        if (i % 4 == 0 && !line.empty()) {
+            ret.push_back(line.substr(1));
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Mask of the bits a symbol of some word size can hold
+ * @param wordSize Bytes per symbol
+ * @return Mask
+ */
+static uint64_t getMask(uint8_t wordSize) { return wordSize >= 8 ? ~uint64_t(0) : (uint64_t(1) << (wordSize * 8)) - 1; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+genie::util::DataBlock makeGeometric(size_t count, uint8_t wordSize, double p) {
+    std::mt19937_64 rng(SEED);
+    std::geometric_distribution<uint64_t> dist(p);
+    genie::util::DataBlock ret(0, wordSize);
+    ret.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        ret.push_back(std::min(dist(rng), getMask(wordSize)));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+genie::util::DataBlock makeUniform(size_t count, uint8_t wordSize, uint64_t max) {
+    std::mt19937_64 rng(SEED);
+    std::uniform_int_distribution<uint64_t> dist(0, std::min(max, getMask(wordSize)));
+    genie::util::DataBlock ret(0, wordSize);
+    ret.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        ret.push_back(dist(rng));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+genie::util::DataBlock makeRuns(size_t count, uint8_t wordSize, uint64_t max, double meanRun) {
+    std::mt19937_64 rng(SEED);
+    std::uniform_int_distribution<uint64_t> value(0, std::min(max, getMask(wordSize)));
+    std::geometric_distribution<size_t> length(1.0 / meanRun);
+    genie::util::DataBlock ret(0, wordSize);
+    ret.reserve(count);
+    while (ret.size() < count) {
+        const auto v = value(rng);
+        for (size_t i = std::min(length(rng) + 1, count - ret.size()); i > 0; --i) {
+            ret.push_back(v);
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace benchmark_common
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef BENCHMARK_LIBS_COMMON_DATA_H_
+#define BENCHMARK_LIBS_COMMON_DATA_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "genie/util/data-block.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace benchmark_common {
+
+/**
+ * @brief Seed of all synthetic inputs, so that runs are comparable
+ */
+constexpr uint64_t SEED = 42;
+
+/**
+ * @brief Locate a file of the test data
+ * @param name Path relative to the data/ directory of the repository
+ * @return Absolute path
+ */
+std::string getDataPath(const std::string& name);
+
+/**
+ * @brief Read one column of all alignment lines of the SAM files in data/sam
+ * @param column Column index, 0 for QNAME
+ * @return Values, in file order. Missing values ("*") are skipped.
+ */
+std::vector<std::string> readSamColumn(size_t column);
+
+/**
+ * @brief Read the record names of a FASTQ file
+ * @param name Path relative to the data/ directory
+ * @return Names without the leading '@'
+ */
+std::vector<std::string> readFastqNames(const std::string& name);
+
+/**
+ * @brief Draw symbols from a geometric distribution, the typical shape of descriptor subsequences
+ * @param count Number of symbols
+ * @param wordSize Bytes per symbol
+ * @param p Success probability, smaller values result in larger symbols
+ * @return Symbols, clipped to the word size
+ */
+genie::util::DataBlock makeGeometric(size_t count, uint8_t wordSize, double p);
+
+/**
+ * @brief Draw symbols uniformly
+ * @param count Number of symbols
+ * @param wordSize Bytes per symbol
+ * @param max Largest symbol
+ * @return Symbols
+ */
+genie::util::DataBlock makeUniform(size_t count, uint8_t wordSize, uint64_t max);
+
+/**
+ * @brief Draw runs of equal symbols
+ * @param count Number of symbols
+ * @param wordSize Bytes per symbol
+ * @param max Largest symbol
+ * @param meanRun Mean run length
+ * @return Symbols
+ */
+genie::util::DataBlock makeRuns(size_t count, uint8_t wordSize, uint64_t max, double meanRun);
+
+}  // namespace benchmark_common
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // BENCHMARK_LIBS_COMMON_DATA_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
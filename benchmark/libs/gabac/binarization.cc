@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include <genie/entropy/gabac/bin-params.h>
+#include <genie/entropy/gabac/reader.h>
+#include <genie/entropy/gabac/streams.h>
+#include <genie/entropy/gabac/writer.h>
+#include <genie/util/data-block.h>
+#include <algorithm>
+#include <vector>
+#include "data.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+using BinId = genie::entropy::paramcabac::BinarizationParameters::BinarizationId;
+
+static const size_t NUM_SYMBOLS = 1u << 18u;  //!< @brief Symbols per iteration
+static const unsigned int NUM_CONTEXTS = 64;  //!< @brief Context models of the writer and reader
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Parameters of a binarization, sized for 8 bit symbols
+ * @param binID Binarization
+ * @return Parameters
+ */
+static genie::entropy::gabac::BinParams getParams(BinId binID) {
+    genie::entropy::gabac::BinParams ret;
+    ret.cMax = binID == BinId::TU ? 32 : 8;
+    ret.splitUnitSize = 3;
+    ret.cMaxDtu = 4;
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Geometrically distributed symbols, clipped to what the binarization can represent
+ * @param binID Binarization
+ * @return Symbols
+ */
+static std::vector<uint64_t> makeSymbols(BinId binID) {
+    const auto block = benchmark_common::makeGeometric(NUM_SYMBOLS, 1, 0.1);
+    const uint64_t max = binID == BinId::TU ? getParams(binID).cMax : 255;
+    std::vector<uint64_t> ret(block.size());
+    for (size_t i = 0; i < block.size(); ++i) {
+        ret[i] = std::min(block.get(i), max);
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Write symbols with one binarization kernel
+ * @param symbols Symbols
+ * @return Bitstream
+ */
+template <BinId binID, bool bypass>
+static genie::util::DataBlock write(const std::vector<uint64_t>& symbols) {
+    auto params = getParams(binID);
+    genie::util::DataBlock block(0, 1);
+    genie::util::DataBlock bitstream(0, 1);
+    genie::entropy::gabac::OBufferStream stream(&block);
+    genie::entropy::gabac::Writer writer(&stream, bypass, NUM_CONTEXTS);
+    writer.start();
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        params.ctxIdx = i % 4;
+        writer.writeAs<binID, bypass>(symbols[i], params);
+    }
+    writer.close();
+    stream.flush(&bitstream);
+    return bitstream;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <BinId binID, bool bypass>
+static void BM_BinarizationWrite(benchmark::State& state) {
+    const auto symbols = makeSymbols(binID);
+    for (auto _ : state) {
+        auto bitstream = write<binID, bypass>(symbols);
+        benchmark::DoNotOptimize(bitstream.getData());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * symbols.size()));
+}
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::BI, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::BI, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::TU, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::TU, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::EG, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::EG, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::TEG, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::TEG, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::SUTU, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::SUTU, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::DTU, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationWrite, BinId::DTU, true)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <BinId binID, bool bypass>
+static void BM_BinarizationRead(benchmark::State& state) {
+    const auto symbols = makeSymbols(binID);
+    const auto bitstream = write<binID, bypass>(symbols);
+    auto params = getParams(binID);
+    for (auto _ : state) {
+        auto input = bitstream;
+        genie::entropy::gabac::Reader reader(&input, bypass, NUM_CONTEXTS);
+        reader.start();
+        uint64_t sum = 0;
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            params.ctxIdx = i % 4;
+            sum += reader.readAs<binID, bypass>(params);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * symbols.size()));
+}
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::BI, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::BI, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::TU, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::TU, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::EG, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::EG, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::TEG, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::TEG, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::SUTU, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::SUTU, true)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::DTU, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BinarizationRead, BinId::DTU, true)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include <genie/entropy/gabac/bin-params.h>
+#include <genie/entropy/gabac/reader.h>
+#include <genie/entropy/gabac/streams.h>
+#include <genie/entropy/gabac/writer.h>
+#include <genie/util/data-block.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "data.h"
+
+// The arithmetic coder is compiled into the writer and reader to inline its hot functions, so the benchmarks drive it
+// through a binary binarization of one bin per symbol
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+using BinId = genie::entropy::paramcabac::BinarizationParameters::BinarizationId;
+
+static const size_t NUM_BINS = 1u << 20u;      //!< @brief Bins per iteration
+static const unsigned int NUM_CONTEXTS = 16;  //!< @brief Context models the bins are spread over
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Bins for the benchmarks. Argument 0 takes the bits of the SAM files in data/, the other arguments are the
+ * probability of a one in per mille.
+ * @param arg Benchmark argument
+ * @return Bins
+ */
+static std::vector<unsigned int> makeBins(int64_t arg) {
+    std::vector<unsigned int> bins;
+    bins.reserve(NUM_BINS);
+    if (arg == 0) {
+        std::string text;
+        for (const auto& seq : benchmark_common::readSamColumn(9)) {
+            text += seq;
+        }
+        while (bins.size() < NUM_BINS) {
+            for (size_t i = 0; i < text.size() * 8 && bins.size() < NUM_BINS; ++i) {
+                bins.push_back((static_cast<unsigned char>(text[i / 8]) >> (7 - i % 8)) & 1u);
+            }
+        }
+    } else {
+        std::mt19937_64 rng(benchmark_common::SEED);
+        std::bernoulli_distribution dist(static_cast<double>(arg) / 1000.0);
+        for (size_t i = 0; i < NUM_BINS; ++i) {
+            bins.push_back(dist(rng));
+        }
+    }
+    return bins;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Encode bins with context models or in bypass mode
+ * @param bins Bins
+ * @param bypass Bypass mode
+ * @return Bitstream
+ */
+static genie::util::DataBlock encode(const std::vector<unsigned int>& bins, bool bypass) {
+    genie::util::DataBlock block(0, 1);
+    genie::util::DataBlock bitstream(0, 1);
+    genie::entropy::gabac::OBufferStream stream(&block);
+    genie::entropy::gabac::Writer writer(&stream, bypass, NUM_CONTEXTS);
+    genie::entropy::gabac::BinParams params;
+    params.cMax = 1;
+    writer.start();
+    for (size_t i = 0; i < bins.size(); ++i) {
+        if (bypass) {
+            writer.writeAs<BinId::BI, true>(bins[i], params);
+        } else {
+            params.ctxIdx = i % NUM_CONTEXTS;
+            writer.writeAs<BinId::BI, false>(bins[i], params);
+        }
+    }
+    writer.close();
+    stream.flush(&bitstream);
+    return bitstream;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_BinaryArithmeticEncoder(benchmark::State& state) {
+    const auto bins = makeBins(state.range(0));
+    const bool bypass = state.range(1) != 0;
+    for (auto _ : state) {
+        auto bitstream = encode(bins, bypass);
+        benchmark::DoNotOptimize(bitstream.getData());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bins.size()));
+    state.SetLabel("bins");
+}
+BENCHMARK(BM_BinaryArithmeticEncoder)
+    ->ArgNames({"p_one", "bypass"})
+    ->Args({0, 0})
+    ->Args({10, 0})
+    ->Args({100, 0})
+    ->Args({500, 0})
+    ->Args({500, 1})
+    ->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_BinaryArithmeticDecoder(benchmark::State& state) {
+    const auto bins = makeBins(state.range(0));
+    const bool bypass = state.range(1) != 0;
+    const auto bitstream = encode(bins, bypass);
+    for (auto _ : state) {
+        auto input = bitstream;
+        genie::entropy::gabac::Reader reader(&input, bypass, NUM_CONTEXTS);
+        genie::entropy::gabac::BinParams params;
+        params.cMax = 1;
+        reader.start();
+        uint64_t sum = 0;
+        if (bypass) {
+            for (size_t i = 0; i < bins.size(); ++i) {
+                sum += reader.readAs<BinId::BI, true>(params);
+            }
+        } else {
+            for (size_t i = 0; i < bins.size(); ++i) {
+                params.ctxIdx = i % NUM_CONTEXTS;
+                sum += reader.readAs<BinId::BI, false>(params);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * bins.size()));
+    state.SetLabel("bins");
+}
+BENCHMARK(BM_BinaryArithmeticDecoder)
+    ->ArgNames({"p_one", "bypass"})
+    ->Args({0, 0})
+    ->Args({10, 0})
+    ->Args({100, 0})
+    ->Args({500, 0})
+    ->Args({500, 1})
+    ->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,168 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include <genie/core/constants.h>
+#include <genie/entropy/gabac/configuration.h>
+#include <genie/entropy/gabac/decode-desc-subseq.h>
+#include <genie/entropy/gabac/decode-transformed-subseq.h>
+#include <genie/entropy/gabac/encode-desc-subseq.h>
+#include <genie/entropy/gabac/encode-transformed-subseq.h>
+#include <genie/util/data-block.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "data.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+using TransformIdSubseq = genie::entropy::paramcabac::TransformedParameters::TransformIdSubseq;
+
+static const size_t NUM_SYMBOLS = 1u << 20u;  //!< @brief Symbols per iteration
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Configuration of a subsequence transformation, the transformed subsequences are not needed
+ * @param id Transformation
+ * @param param Guard of the RLE, buffer size of the match coding
+ * @return Configuration
+ */
+static genie::entropy::paramcabac::Subsequence createConfig(TransformIdSubseq id, uint16_t param) {
+    genie::entropy::paramcabac::TransformedParameters transform(id, param);
+    return genie::entropy::paramcabac::Subsequence(std::move(transform), 0, true,
+                                                   std::vector<genie::entropy::paramcabac::TransformedSubSeq>());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Input of a subsequence transformation
+ * @param id Transformation
+ * @return Runs for the RLE, repeating patterns for the match coding and geometric symbols for the equality coding
+ */
+static genie::util::DataBlock makeInput(TransformIdSubseq id) {
+    if (id == TransformIdSubseq::RLE_CODING) {
+        return benchmark_common::makeRuns(NUM_SYMBOLS, 1, 15, 8.0);
+    }
+    if (id == TransformIdSubseq::MATCH_CODING) {
+        // Short runs, so that matches of all lengths occur
+        return benchmark_common::makeRuns(NUM_SYMBOLS, 1, 3, 2.0);
+    }
+    return benchmark_common::makeGeometric(NUM_SYMBOLS, 1, 0.3);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_SubseqTransform(benchmark::State& state) {
+    const auto id = static_cast<TransformIdSubseq>(state.range(0));
+    const auto config = createConfig(id, 255);
+    const auto input = makeInput(id);
+    for (auto _ : state) {
+        std::vector<genie::util::DataBlock> subseqs = {input};
+        genie::entropy::gabac::doSubsequenceTransform(config, &subseqs);
+        benchmark::DoNotOptimize(subseqs.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_SubseqTransform)
+    ->ArgName("transform")
+    ->Arg(static_cast<int64_t>(TransformIdSubseq::EQUALITY_CODING))
+    ->Arg(static_cast<int64_t>(TransformIdSubseq::MATCH_CODING))
+    ->Arg(static_cast<int64_t>(TransformIdSubseq::RLE_CODING))
+    ->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_InverseSubseqTransform(benchmark::State& state) {
+    const auto id = static_cast<TransformIdSubseq>(state.range(0));
+    const auto config = createConfig(id, 255);
+    const auto input = makeInput(id);
+    std::vector<genie::util::DataBlock> transformed = {input};
+    genie::entropy::gabac::doSubsequenceTransform(config, &transformed);
+    for (auto _ : state) {
+        auto subseqs = transformed;
+        genie::entropy::gabac::doInverseSubsequenceTransform(config, &subseqs);
+        benchmark::DoNotOptimize(subseqs.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_InverseSubseqTransform)
+    ->ArgName("transform")
+    ->Arg(static_cast<int64_t>(TransformIdSubseq::EQUALITY_CODING))
+    ->Arg(static_cast<int64_t>(TransformIdSubseq::MATCH_CODING))
+    ->Arg(static_cast<int64_t>(TransformIdSubseq::RLE_CODING))
+    ->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Symbols of a subsequence coded with the LUT transformation in the default configuration
+ * @param sub UREADS (coding order 2) or MMTYPE substitutions (coding order 1)
+ * @return Bases of the SAM files in data/ repeated to NUM_SYMBOLS / 4 symbols, mapped to the ACGTN alphabet
+ */
+static genie::util::DataBlock makeLutInput(genie::core::GenSubIndex sub) {
+    const auto& alphabet = genie::core::getAlphabetProperties(genie::core::AlphabetID::ACGTN);
+    const auto seqs = benchmark_common::readSamColumn(9);
+    genie::util::DataBlock ret(0, genie::core::range2bytes(genie::core::getSubsequence(sub).range));
+    while (ret.size() < NUM_SYMBOLS / 4) {
+        for (const auto& seq : seqs) {
+            for (const auto& c : seq) {
+                ret.push_back(alphabet.inverseLut[static_cast<uint8_t>(c)]);
+            }
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Subsequence selected by a benchmark argument
+ * @param arg 0 for UREADS, 1 for MMTYPE substitutions
+ * @return Subsequence
+ */
+static genie::core::GenSubIndex getLutSubsequence(int64_t arg) {
+    return arg == 0 ? genie::core::GenSub::UREADS : genie::core::GenSub::MMTYPE_SUBSTITUTION;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_LutTransformEncode(benchmark::State& state) {
+    const auto sub = getLutSubsequence(state.range(0));
+    const genie::entropy::gabac::EncodingConfiguration config(sub);
+    const auto& subseqConfig = config.getSubseqConfig().getTransformSubseqCfg(0);
+    const auto input = makeLutInput(sub);
+    for (auto _ : state) {
+        auto block = input;
+        genie::entropy::gabac::encodeTransformSubseq(subseqConfig, &block);
+        benchmark::DoNotOptimize(block.getData());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_LutTransformEncode)->ArgName("mmtype")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_LutTransformDecode(benchmark::State& state) {
+    const auto sub = getLutSubsequence(state.range(0));
+    const genie::entropy::gabac::EncodingConfiguration config(sub);
+    const auto& subseqConfig = config.getSubseqConfig().getTransformSubseqCfg(0);
+    const auto input = makeLutInput(sub);
+    auto bitstream = input;
+    genie::entropy::gabac::encodeTransformSubseq(subseqConfig, &bitstream);
+    for (auto _ : state) {
+        auto block = bitstream;
+        genie::entropy::gabac::decodeTransformSubseq(subseqConfig, static_cast<unsigned int>(input.size()), &block,
+                                                     input.getWordSize());
+        benchmark::DoNotOptimize(block.getData());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_LutTransformDecode)->ArgName("mmtype")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include <genie/core/access-unit.h>
+#include <genie/name/tokenizer/token.h>
+#include <genie/name/tokenizer/tokenizer.h>
+#include <cctype>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "data.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const size_t NUM_NAMES = 1u << 16u;  //!< @brief Names per iteration
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Read names of the SAM and FASTQ files in data/, extended to NUM_NAMES by cycling through them and
+ * incrementing their numeric fields, like the tile coordinates of consecutive reads
+ * @return Names
+ */
+static std::vector<std::string> makeNames() {
+    auto templates = benchmark_common::readSamColumn(0);
+    for (auto& n : benchmark_common::readFastqNames("fastq/fourteen-records.fastq")) {
+        templates.push_back(n.substr(0, n.find(' ')));
+    }
+
+    std::mt19937_64 rng(benchmark_common::SEED);
+    std::geometric_distribution<uint64_t> step(0.2);
+    std::vector<std::string> ret;
+    ret.reserve(NUM_NAMES);
+    uint64_t offset = 0;
+    while (ret.size() < NUM_NAMES) {
+        for (const auto& t : templates) {
+            if (ret.size() == NUM_NAMES) {
+                break;
+            }
+            offset += step(rng);
+
+            // Add the offset to the last number of the name
+            std::string name = t;
+            auto end = name.find_last_of("0123456789");
+            if (end != std::string::npos) {
+                auto begin = end;
+                while (begin > 0 && std::isdigit(static_cast<unsigned char>(name[begin - 1]))) {
+                    --begin;
+                }
+                const auto value = std::stoull(name.substr(begin, end - begin + 1)) + offset;
+                name.replace(begin, end - begin + 1, std::to_string(value));
+            }
+            ret.push_back(std::move(name));
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_TokenStateRun(benchmark::State& state) {
+    const auto names = makeNames();
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        std::vector<genie::name::tokenizer::SingleToken> old;
+        for (const auto& n : names) {
+            genie::name::tokenizer::TokenState tokenState(old, n);
+            auto tokens = tokenState.run();
+            old = genie::name::tokenizer::patch(old, tokens);
+            bytes += static_cast<int64_t>(n.size());
+        }
+        benchmark::DoNotOptimize(old.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * names.size()));
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_TokenStateRun)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_TokenStateEncode(benchmark::State& state) {
+    const auto names = makeNames();
+    std::vector<std::vector<genie::name::tokenizer::SingleToken>> tokens;
+    std::vector<genie::name::tokenizer::SingleToken> old;
+    for (const auto& n : names) {
+        genie::name::tokenizer::TokenState tokenState(old, n);
+        tokens.push_back(tokenState.run());
+        old = genie::name::tokenizer::patch(old, tokens.back());
+    }
+    for (auto _ : state) {
+        genie::core::AccessUnit::Descriptor streams(genie::core::GenDesc::RNAME);
+        for (const auto& t : tokens) {
+            genie::name::tokenizer::TokenState::encode(t, streams);
+        }
+        benchmark::DoNotOptimize(streams.getSize());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * names.size()));
+}
+BENCHMARK(BM_TokenStateEncode)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
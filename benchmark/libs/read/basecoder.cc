@@ -0,0 +1,55 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include <genie/core/record/alignment-box.h>
+#include <genie/core/record/record.h>
+#include <genie/read/basecoder/encoder.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "reads.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const size_t NUM_READS = 1u << 14u;  //!< @brief Records per iteration
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_BaseCoderAdd(benchmark::State& state) {
+    const auto type = static_cast<genie::core::record::ClassType>(state.range(0));
+    const auto ref = benchmark_read::makeReference(NUM_READS * 16);
+    const auto reads = benchmark_read::makeReads(ref, NUM_READS, type);
+
+    std::vector<genie::core::record::Record> records;
+    records.reserve(reads.size());
+    for (const auto& r : reads) {
+        genie::core::record::Record rec(1, type, "", "", 0);
+        rec.addSegment(genie::core::record::Segment(std::string(r.seq)));
+        rec.addAlignment(0, genie::core::record::AlignmentBox(
+                                r.position, genie::core::record::Alignment(std::string(r.ecigar), 0)));
+        records.push_back(std::move(rec));
+    }
+
+    for (auto _ : state) {
+        genie::read::basecoder::Encoder encoder(reads.front().position);
+        for (size_t i = 0; i < records.size(); ++i) {
+            encoder.add(records[i], reads[i].ref, "");
+        }
+        auto au = encoder.moveStreams();
+        benchmark::DoNotOptimize(&au);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+}
+BENCHMARK(BM_BaseCoderAdd)
+    ->ArgName("class")
+    ->Arg(static_cast<int64_t>(genie::core::record::ClassType::CLASS_P))
+    ->Arg(static_cast<int64_t>(genie::core::record::ClassType::CLASS_M))
+    ->Arg(static_cast<int64_t>(genie::core::record::ClassType::CLASS_I))
+    ->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
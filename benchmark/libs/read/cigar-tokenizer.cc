@@ -0,0 +1,64 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include <genie/core/cigar-tokenizer.h>
+#include <genie/core/constants.h>
+#include <string>
+#include <vector>
+#include "data.h"
+#include "reads.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const size_t NUM_CIGARS = 1u << 14u;  //!< @brief Cigars per iteration
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Extended cigars to tokenize
+ * @param synthetic False for the cigars of the SAM files in data/, true for synthetic reads with indels
+ * @return Extended cigars
+ */
+static std::vector<std::string> makeCigars(bool synthetic) {
+    std::vector<std::string> ret;
+    ret.reserve(NUM_CIGARS);
+    if (synthetic) {
+        const auto ref = benchmark_read::makeReference(NUM_CIGARS * 16);
+        for (auto& r : benchmark_read::makeReads(ref, NUM_CIGARS, genie::core::record::ClassType::CLASS_I)) {
+            ret.push_back(std::move(r.ecigar));
+        }
+        return ret;
+    }
+    const auto cigars = benchmark_common::readSamColumn(5);
+    for (size_t i = 0; i < NUM_CIGARS; ++i) {
+        ret.push_back(benchmark_read::samToECigar(cigars[i % cigars.size()]));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_CigarTokenize(benchmark::State& state) {
+    const auto cigars = makeCigars(state.range(0) != 0);
+    for (auto _ : state) {
+        size_t bases = 0;
+        for (const auto& c : cigars) {
+            genie::core::CigarTokenizer::tokenize(
+                c, genie::core::getECigarInfo(),
+                [&bases](uint8_t, const genie::util::StringView& bs, const genie::util::StringView&) -> bool {
+                    bases += bs.length();
+                    return true;
+                });
+        }
+        benchmark::DoNotOptimize(bases);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cigars.size()));
+}
+BENCHMARK(BM_CigarTokenize)->ArgName("synthetic")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
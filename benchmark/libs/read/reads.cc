@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "reads.h"
+#include <genie/core/constants.h>
+#include <genie/util/runtime-exception.h>
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <utility>
+#include "data.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace benchmark_read {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const size_t READ_LENGTH = 100;  //!< @brief Bases per synthetic read
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string makeReference(size_t length) {
+    const auto& alphabet = genie::core::getAlphabetProperties(genie::core::AlphabetID::ACGTN);
+    std::string bases;
+    for (const auto& seq : benchmark_common::readSamColumn(9)) {
+        for (const auto& c : seq) {
+            if (alphabet.isIncluded(c)) {
+                bases.push_back(c);
+            }
+        }
+    }
+    UTILS_DIE_IF(bases.empty(), "No bases for the reference");
+
+    std::string ret;
+    ret.reserve(length);
+    while (ret.size() < length) {
+        ret.append(bases, 0, std::min(bases.size(), length - ret.size()));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<AlignedRead> makeReads(const std::string& ref, size_t count, genie::core::record::ClassType type) {
+    static const std::string BASES = "ACGT";
+    const bool substitutions = type >= genie::core::record::ClassType::CLASS_M;
+    const bool indels = type >= genie::core::record::ClassType::CLASS_I;
+
+    std::mt19937_64 rng(benchmark_common::SEED);
+    std::uniform_real_distribution<double> event(0.0, 1.0);
+    std::uniform_int_distribution<size_t> eventLength(1, 3);
+    std::geometric_distribution<uint64_t> step(0.1);
+
+    std::vector<AlignedRead> ret;
+    ret.reserve(count);
+    uint64_t position = 0;
+    for (size_t i = 0; i < count; ++i) {
+        position += step(rng);
+        UTILS_DIE_IF(position + 2 * READ_LENGTH > ref.size(), "Reference too short");
+        AlignedRead read{position, "", "", ""};
+        size_t refPos = position;
+        size_t matches = 0;
+        auto flushMatches = [&]() {
+            if (matches) {
+                read.ecigar += std::to_string(matches) + "=";
+                matches = 0;
+            }
+        };
+
+        if (indels && event(rng) < 0.1) {
+            const auto length = 5 * eventLength(rng);
+            read.ecigar += "(" + std::to_string(length) + ")";
+            for (size_t j = 0; j < length; ++j) {
+                read.seq += BASES[rng() % 4];
+            }
+        }
+        while (read.seq.size() < READ_LENGTH) {
+            const auto e = event(rng);
+            if (substitutions && e < 0.02) {
+                const auto refBase = BASES.find(ref[refPos]);
+                const auto base =
+                    refBase == std::string::npos ? BASES[rng() % 4] : BASES[(refBase + 1 + rng() % 3) % 4];
+                flushMatches();
+                read.ecigar += base;
+                read.seq += base;
+                ++refPos;
+            } else if (indels && matches && e < 0.025) {
+                const auto length = std::min(eventLength(rng), READ_LENGTH - read.seq.size());
+                flushMatches();
+                read.ecigar += std::to_string(length) + "+";
+                for (size_t j = 0; j < length; ++j) {
+                    read.seq += BASES[rng() % 4];
+                }
+            } else if (indels && matches && e < 0.03) {
+                const auto length = eventLength(rng);
+                flushMatches();
+                read.ecigar += std::to_string(length) + "-";
+                refPos += length;
+            } else {
+                read.seq += ref[refPos++];
+                ++matches;
+            }
+        }
+        flushMatches();
+        read.ref = ref.substr(position, refPos - position);
+        ret.push_back(std::move(read));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string samToECigar(const std::string& cigar) {
+    std::string ret;
+    std::string count;
+    for (const auto& c : cigar) {
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            count += c;
+            continue;
+        }
+        switch (c) {
+            case 'M':
+            case '=':
+            case 'X':
+                ret += count + "=";
+                break;
+            case 'I':
+                ret += count + "+";
+                break;
+            case 'D':
+                ret += count + "-";
+                break;
+            case 'N':
+                ret += count + "*";
+                break;
+            case 'S':
+                ret += "(" + count + ")";
+                break;
+            case 'H':
+                ret += "[" + count + "]";
+                break;
+            case 'P':
+                break;
+            default:
+                UTILS_DIE("Unknown cigar operation " + std::string(1, c));
+        }
+        count.clear();
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace benchmark_read
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef BENCHMARK_LIBS_READ_READS_H_
+#define BENCHMARK_LIBS_READ_READS_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <genie/core/record/class-type.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace benchmark_read {
+
+/**
+ * @brief Single end read aligned to the synthetic reference
+ */
+struct AlignedRead {
+    uint64_t position;   //!< @brief Mapping position, 0 based
+    std::string ecigar;  //!< @brief Extended cigar
+    std::string seq;     //!< @brief Bases
+    std::string ref;     //!< @brief Reference bases covered by the alignment
+};
+
+/**
+ * @brief Reference of the synthetic reads, the bases of the SAM files in data/ repeated to the requested length
+ * @param length Number of bases
+ * @return Reference, ACGTN only
+ */
+std::string makeReference(size_t length);
+
+/**
+ * @brief Draw reads with sorted positions from a reference
+ * @param ref Reference
+ * @param count Number of reads
+ * @param type CLASS_P for perfect matches, CLASS_M adds substitutions, CLASS_I also adds indels and soft clips
+ * @return Reads
+ */
+std::vector<AlignedRead> makeReads(const std::string& ref, size_t count, genie::core::record::ClassType type);
+
+/**
+ * @brief Convert a SAM cigar to an extended cigar, without the substitutions that need the reference
+ * @param cigar SAM cigar
+ * @return Extended cigar
+ */
+std::string samToECigar(const std::string& cigar);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace benchmark_read
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // BENCHMARK_LIBS_READ_READS_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
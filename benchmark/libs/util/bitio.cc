@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <benchmark/benchmark.h>
+#include <genie/util/bitreader.h>
+#include <genie/util/bitwriter.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "data.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const size_t NUM_FIELDS = 1u << 18u;  //!< @brief Fields per iteration
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Fields of a bitstream
+ * @param width Bits per field, 0 for a mix of 1 to 32 bits as in the parameter set and record syntax
+ * @return Pairs of value and width
+ */
+static std::vector<std::pair<uint64_t, uint8_t>> makeFields(uint8_t width) {
+    std::mt19937_64 rng(benchmark_common::SEED);
+    std::uniform_int_distribution<unsigned int> widths(1, 32);
+    std::vector<std::pair<uint64_t, uint8_t>> ret(NUM_FIELDS);
+    for (auto& f : ret) {
+        f.second = width ? width : static_cast<uint8_t>(widths(rng));
+        f.first = rng() & ((uint64_t(1) << f.second) - 1);
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Write fields to a string
+ * @param fields Pairs of value and width
+ * @return Bitstream
+ */
+static std::string write(const std::vector<std::pair<uint64_t, uint8_t>>& fields) {
+    std::stringstream stream;
+    genie::util::BitWriter writer(&stream);
+    for (const auto& f : fields) {
+        writer.write(f.first, f.second);
+    }
+    writer.flush();
+    return stream.str();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_BitWriter(benchmark::State& state) {
+    const auto fields = makeFields(static_cast<uint8_t>(state.range(0)));
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        auto str = write(fields);
+        bytes += static_cast<int64_t>(str.size());
+        benchmark::DoNotOptimize(str.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * fields.size()));
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_BitWriter)->ArgName("width")->Arg(0)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void BM_BitReader(benchmark::State& state) {
+    const auto fields = makeFields(static_cast<uint8_t>(state.range(0)));
+    const auto str = write(fields);
+    for (auto _ : state) {
+        std::istringstream stream(str);
+        genie::util::BitReader reader(stream);
+        uint64_t sum = 0;
+        for (const auto& f : fields) {
+            sum += reader.read_b(f.second);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * fields.size()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * str.size()));
+}
+BENCHMARK(BM_BitReader)->ArgName("width")->Arg(0)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
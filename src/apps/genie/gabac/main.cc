@@ -10,6 +10,7 @@
 #include <csignal>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -18,6 +19,8 @@
 #include "apps/genie/gabac/program-options.h"
 #include "genie/entropy/gabac/benchmark.h"
 #include "genie/entropy/gabac/gabac.h"
+#include "genie/util/make-unique.h"
+#include "genie/util/task-scheduler.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -51,18 +54,28 @@ int main(int argc, char* argv[]) {
                 }
             }
         } else if (programOptions.task == "benchmark") {
-            float timeweight = 0.0f;
-            if (programOptions.fastBenchmark) {
-                timeweight = 1.0f;
+            std::unique_ptr<genie::util::TaskScheduler> scheduler;
+            if (programOptions.threads > 1) {
+                scheduler = genie::util::make_unique<genie::util::TaskScheduler>(programOptions.threads);
             }
-            auto result = genie::entropy::gabac::benchmark_full(
+            genie::entropy::gabac::BenchmarkOptions options;
+            options.timeweight = programOptions.fastBenchmark ? 1.0f : 0.0f;
+            options.scheduler = scheduler.get();
+            options.sampleSize = programOptions.sampleSize;
+            options.confirmedCandidates = programOptions.confirmedCandidates;
+            auto report = genie::entropy::gabac::benchmark_full(
                 programOptions.inputFilePath,
                 genie::core::GenSubIndex(
                     std::make_pair(genie::core::GenDesc(programOptions.descID), programOptions.subseqID)),
-                timeweight);
-            auto json = result.config.toJoson().dump(4);
+                options);
+            std::cout << report.getBest().toCSV(programOptions.inputFilePath) << std::endl;
+            auto json = report.getBest().config.toJoson().dump(4);
             std::ofstream output_stream(programOptions.outputFilePath);
             output_stream.write(json.c_str(), json.length());
+            if (!programOptions.reportFilePath.empty()) {
+                std::ofstream report_stream(programOptions.reportFilePath);
+                report_stream << report.toJson().dump(4);
+            }
 
         } else {
             UTILS_DIE("Invalid task: " + std::string(programOptions.task));
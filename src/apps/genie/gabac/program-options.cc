@@ -5,8 +5,10 @@
  */
 
 #include "apps/genie/gabac/program-options.h"
+#include <algorithm>
 #include <cassert>
 #include <fstream>
+#include <thread>
 #include "cli11/CLI11.hpp"
 #include "genie/util/runtime-exception.h"
 
@@ -22,8 +24,12 @@ ProgramOptions::ProgramOptions(int argc, char *argv[])
       logLevel(),
       inputFilePath(),
       outputFilePath(),
+      reportFilePath(),
       task(),
       blocksize(0),
+      threads(1),
+      sampleSize(0),
+      confirmedCandidates(8),
       descID(0),
       subseqID(0) {
     processCommandLine(argc, argv);
@@ -45,6 +51,18 @@ void ProgramOptions::processCommandLine(int argc, char *argv[]) {
     app.add_option("-o,--output_file", this->outputFilePath, "Output file");
     app.add_option("-t,--task", this->task, "Task ('encode' or 'decode')");
     app.add_flag("--fast-benchmark", this->fastBenchmark, "Optimize for speed");
+    app.add_option("--report_file", this->reportFilePath, "Benchmark report output file (JSON)");
+
+    this->threads = std::max(std::thread::hardware_concurrency(), 1u);
+    app.add_option("--threads", this->threads, "Benchmark threads (default all cores)");
+
+    this->sampleSize = 0;
+    app.add_option("--sample_size", this->sampleSize,
+                   "Benchmark symbols to preselect candidates on, 0 for the full input (default 0)");
+
+    this->confirmedCandidates = 8;
+    app.add_option("--confirm", this->confirmedCandidates,
+                   "Benchmark candidates per stream confirmed on the full input after the sample (default 8)");
 
     this->blocksize = 0;
     // app.add_option("-b,--block_size", this->blocksize, "Block size - 0 means infinite");
@@ -74,7 +92,10 @@ void ProgramOptions::validate() const {
         UTILS_DIE_IF(this->inputFilePath.empty(), "Input file path both not provided!");
 
         UTILS_DIE_IF(this->outputFilePath.empty(), "Output file path both not provided!");
-    } else if (this->task == "writeconfigs" || this->task == "benchmark") {
+    } else if (this->task == "benchmark") {
+        UTILS_DIE_IF(this->threads < 1, "Invalid number of threads");
+        UTILS_DIE_IF(this->confirmedCandidates < 1, "At least one candidate must be confirmed");
+    } else if (this->task == "writeconfigs") {
     } else {
         UTILS_DIE("Task '" + this->task + "' is invalid");
     }
@@ -41,8 +41,12 @@ class ProgramOptions {
     std::string dependencyFilePath;  //!< @brief
     std::string outputFilePath;      //!< @brief
     std::string paramFilePath;       //!< @brief
+    std::string reportFilePath;      //!< @brief Benchmark report output, empty for none
     std::string task;                //!< @brief
     size_t blocksize;                //!< @brief
+    size_t threads;                  //!< @brief Benchmark worker threads
+    size_t sampleSize;               //!< @brief Benchmark sample length, 0 to search on the full input
+    size_t confirmedCandidates;      //!< @brief Benchmark candidates confirmed on the full input after the sample
 
     uint8_t descID;    //!< @brief
     uint8_t subseqID;  //!< @brief
@@ -13,7 +13,10 @@
 #include <vector>
 #include "apps/genie/run/program-options.h"
 #include "genie/core/format-importer-null.h"
+#include "genie/core/locus-filter.h"
 #include "genie/core/name-encoder-none.h"
+#include "genie/core/stats/perf-stats.h"
+#include "genie/entropy/gabac/encoder.h"
 #include "genie/format/fasta/exporter.h"
 #include "genie/format/fasta/manager.h"
 #include "genie/format/fastq/exporter.h"
@@ -27,7 +30,14 @@
 #include "genie/quality/calq/encoder.h"
 #include "genie/quality/qvwriteout/encoder-none.h"
 #include "genie/read/lowlatency/encoder.h"
+#include "genie/read/spring/encoder.h"
+#include "genie/util/mapped-file.h"
+#include "genie/util/task-scheduler.h"
 #include "genie/util/watch.h"
+#ifdef GENIE_SAM_SUPPORT
+#include "apps/genie/transcode-sam/sam/sam_to_mgrec/sam_source.h"
+#include "genie/format/sam/importer.h"
+#endif
 
 // TODO(Fabian): For some reason, compilation on windows fails if we move this include further up. Investigate.
 #include "filesystem/filesystem.hpp"
@@ -84,8 +94,24 @@ OperationCase getOperation(FileType in, FileType out) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#ifdef GENIE_SAM_SUPPORT
+bool isSamFile(const std::string& path) {
+    auto ext = file_extension(path);
+    return ext == "sam" || ext == "bam" || ext == "cram";
+}
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 OperationCase getOperation(const std::string& filenameIn, const std::string& filenameOut) {
-    return getOperation(getType(file_extension(filenameIn)), getType(file_extension(filenameOut)));
+    auto in = getType(file_extension(filenameIn));
+#ifdef GENIE_SAM_SUPPORT
+    // Alignments are imported directly, decoding to SAM is left to transcode-sam
+    if (isSamFile(filenameIn)) {
+        in = FileType::THIRD_PARTY;
+    }
+#endif
+    return getOperation(in, getType(file_extension(filenameOut)));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -107,23 +133,59 @@ void attachExporter(T& flow, const ProgramOptions& pOpts, std::vector<std::uniqu
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void addFasta(const std::string& fastaFile, genie::core::FlowGraphEncode* flow,
-              std::vector<std::unique_ptr<std::ifstream>>& inputFiles) {
-    std::string fai = fastaFile.substr(0, fastaFile.find_last_of('.') + 1) + "fai";
-    std::string sha = fastaFile.substr(0, fastaFile.find_last_of('.') + 1) + "sha256";
-    auto fasta_file = genie::util::make_unique<std::ifstream>(fastaFile);
+genie::format::fasta::FastaReader::Progress printProgress(const std::string& task) {
+    auto last = std::make_shared<uint64_t>(101);
+    return [task, last](uint64_t done, uint64_t total) {
+        uint64_t percent = total ? done * 100 / total : 100;
+        if (percent != *last) {
+            *last = percent;
+            std::cerr << "\r" << task << " ... " << percent << "%" << (percent == 100 ? "\n" : "") << std::flush;
+        }
+    };
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void indexFasta(const std::string& fastaFile, const std::string& fai, const std::string& sha, size_t threads) {
+    if (ghc::filesystem::exists(fai) && ghc::filesystem::exists(sha)) {
+        return;
+    }
+    genie::util::MappedFile fasta_map(fastaFile);
+    genie::util::TaskScheduler scheduler(threads);
     if (!ghc::filesystem::exists(fai)) {
-        std::cerr << "Indexing " << fastaFile << " ..." << std::endl;
         std::ofstream fai_file(fai);
-        genie::format::fasta::FastaReader::index(*fasta_file, fai_file);
+        if (fasta_map.isMapped()) {
+            genie::format::fasta::FastaReader::index(fasta_map, fai_file, &scheduler,
+                                                     printProgress("Indexing " + fastaFile));
+        } else {
+            std::cerr << "Indexing " << fastaFile << " ..." << std::endl;
+            std::ifstream fasta_file(fastaFile);
+            genie::format::fasta::FastaReader::index(fasta_file, fai_file);
+        }
     }
     if (!ghc::filesystem::exists(sha)) {
-        std::cerr << "Calculaing hashes " << fastaFile << " ..." << std::endl;
         std::ofstream sha_file(sha);
         std::ifstream fai_file(fai);
         genie::format::fasta::FaiFile fai_reader(fai_file);
-        genie::format::fasta::FastaReader::hash(fai_reader, *fasta_file, sha_file);
+        if (fasta_map.isMapped()) {
+            genie::format::fasta::FastaReader::hash(fai_reader, fasta_map, sha_file, &scheduler,
+                                                    printProgress("Calculating hashes " + fastaFile));
+        } else {
+            std::cerr << "Calculating hashes " << fastaFile << " ..." << std::endl;
+            std::ifstream fasta_file(fastaFile);
+            genie::format::fasta::FastaReader::hash(fai_reader, fasta_file, sha_file);
+        }
     }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void addFasta(const std::string& fastaFile, genie::core::FlowGraphEncode* flow,
+              std::vector<std::unique_ptr<std::ifstream>>& inputFiles, size_t threads) {
+    std::string fai = fastaFile.substr(0, fastaFile.find_last_of('.') + 1) + "fai";
+    std::string sha = fastaFile.substr(0, fastaFile.find_last_of('.') + 1) + "sha256";
+    indexFasta(fastaFile, fai, sha, threads);
+    auto fasta_file = genie::util::make_unique<std::ifstream>(fastaFile);
     auto fai_file = genie::util::make_unique<std::ifstream>(fai);
     auto sha_file = genie::util::make_unique<std::ifstream>(sha);
     inputFiles.push_back(std::move(fasta_file));
@@ -140,6 +202,14 @@ template <class T>
 void attachImporter(T& flow, const ProgramOptions& pOpts, std::vector<std::unique_ptr<std::ifstream>>& inputFiles,
                     std::vector<std::unique_ptr<std::ofstream>>& outputFiles) {
     constexpr size_t BLOCKSIZE = 128000;
+#ifdef GENIE_SAM_SUPPORT
+    if (isSamFile(pOpts.inputFile)) {
+        flow.addImporter(genie::util::make_unique<genie::format::sam::Importer>(
+            BLOCKSIZE, genie::util::make_unique<genieapp::transcode_sam::sam::sam_to_mgrec::SamSource>(
+                           pOpts.inputFile, pOpts.inputRefFile, pOpts.numberOfThreads)));
+        return;
+    }
+#endif
     std::istream* in_ptr = &std::cin;
     if (pOpts.inputFile.substr(0, 2) != "-.") {
         inputFiles.emplace_back(genie::util::make_unique<std::ifstream>(pOpts.inputFile));
@@ -172,22 +242,26 @@ std::unique_ptr<genie::core::FlowGraph> buildEncoder(const ProgramOptions& pOpts
         mode = genie::core::ClassifierRegroup::RefMode::FULL;
     }
     auto flow = genie::module::buildDefaultEncoder(pOpts.numberOfThreads, pOpts.workingDirectory, BLOCKSIZE, mode,
-                                                   pOpts.rawReference, pOpts.rawStreams);
+                                                   pOpts.rawReference, pOpts.rawStreams,
+                                                   uint64_t(pOpts.refCache) * 1024 * 1024);
     if (file_extension(pOpts.inputFile) == "fasta") {
-        addFasta(pOpts.inputFile, flow.get(), inputFiles);
+        addFasta(pOpts.inputFile, flow.get(), inputFiles, pOpts.numberOfThreads);
     } else if (!pOpts.inputRefFile.empty()) {
         if (file_extension(pOpts.inputRefFile) == "fasta" || file_extension(pOpts.inputRefFile) == "fa") {
-            addFasta(pOpts.inputRefFile, flow.get(), inputFiles);
+            addFasta(pOpts.inputRefFile, flow.get(), inputFiles, pOpts.numberOfThreads);
         } else {
             UTILS_DIE("Unknown reference format");
         }
     }
     std::ostream* out_ptr = &std::cout;
+    std::ostream* index_ptr = nullptr;
     if (pOpts.outputFile.substr(0, 2) != "-.") {
         outputFiles.emplace_back(genie::util::make_unique<std::ofstream>(pOpts.outputFile, std::ios::binary));
         out_ptr = outputFiles.back().get();
+        outputFiles.emplace_back(genie::util::make_unique<std::ofstream>(pOpts.outputFile + ".idx", std::ios::binary));
+        index_ptr = outputFiles.back().get();
     }
-    flow->addExporter(genie::util::make_unique<genie::format::mgb::Exporter>(out_ptr));
+    flow->addExporter(genie::util::make_unique<genie::format::mgb::Exporter>(out_ptr, index_ptr));
     attachImporter(*flow, pOpts, inputFiles, outputFiles);
     if (pOpts.qvMode == "none") {
         flow->setQVCoder(genie::util::make_unique<genie::quality::qvwriteout::NoneEncoder>(), 0);
@@ -198,21 +272,56 @@ std::unique_ptr<genie::core::FlowGraph> buildEncoder(const ProgramOptions& pOpts
     if (pOpts.readNameMode == "none") {
         flow->setNameCoder(genie::util::make_unique<genie::core::NameEncoderNone>(), 0);
     }
+    if (pOpts.adaptiveEntropy) {
+        auto entropyCoder = genie::util::make_unique<genie::entropy::gabac::Encoder>(pOpts.rawStreams);
+        entropyCoder->setAdaptiveConfig(genie::util::make_unique<genie::entropy::gabac::AdaptiveConfigSelector>(
+            pOpts.adaptiveTimeWeight, 1u << 16u, pOpts.adaptiveInterval));
+        flow->setEntropyCoder(std::move(entropyCoder), 0);
+    }
     if (pOpts.lowLatency) {
         flow->setReadCoder(genie::util::make_unique<genie::read::lowlatency::Encoder>(pOpts.rawStreams), 3);
         flow->setReadCoder(genie::util::make_unique<genie::read::lowlatency::Encoder>(pOpts.rawStreams), 4);
+    } else if (pOpts.inMemory || pOpts.reorderMemory) {
+        const uint64_t memoryBudget = uint64_t(pOpts.reorderMemory) * 1024 * 1024;
+        flow->setReadCoder(
+            genie::util::make_unique<genie::read::spring::Encoder>(pOpts.workingDirectory, pOpts.numberOfThreads, false,
+                                                                   pOpts.rawStreams, pOpts.inMemory, memoryBudget),
+            3);
+        flow->setReadCoder(
+            genie::util::make_unique<genie::read::spring::Encoder>(pOpts.workingDirectory, pOpts.numberOfThreads, true,
+                                                                   pOpts.rawStreams, pOpts.inMemory, memoryBudget),
+            4);
     }
     return flow;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+uint16_t findSequence(const std::string& name, const std::string& inputFile) {
+    if (ghc::filesystem::exists(inputFile + ".json") && ghc::filesystem::file_size(inputFile + ".json")) {
+        genie::core::meta::Dataset data(nlohmann::json::parse(std::ifstream(inputFile + ".json")));
+        if (data.getReference()) {
+            for (const auto& s : data.getReference()->getSequences()) {
+                if (s.getName() == name) {
+                    return s.getID();
+                }
+            }
+        }
+    }
+    UTILS_DIE_IF(name.empty() || name.find_first_not_of("0123456789") != std::string::npos,
+                 "Unknown reference sequence: " + name);
+    return static_cast<uint16_t>(std::stoul(name));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<genie::core::FlowGraph> buildDecoder(const ProgramOptions& pOpts,
                                                      std::vector<std::unique_ptr<std::ifstream>>& inputFiles,
                                                      std::vector<std::unique_ptr<std::ofstream>>& outputFiles) {
     constexpr size_t BLOCKSIZE = 128000;
     auto flow = genie::module::buildDefaultDecoder(pOpts.numberOfThreads, pOpts.workingDirectory,
-                                                   pOpts.combinePairsFlag, BLOCKSIZE);
+                                                   pOpts.combinePairsFlag, BLOCKSIZE,
+                                                   uint64_t(pOpts.refCache) * 1024 * 1024);
 
     std::string json_uri_path = pOpts.inputRefFile;
     if (ghc::filesystem::exists(pOpts.inputFile + ".json") && ghc::filesystem::file_size(pOpts.inputFile + ".json")) {
@@ -236,19 +345,8 @@ std::unique_ptr<genie::core::FlowGraph> buildDecoder(const ProgramOptions& pOpts
         if (file_extension(json_uri_path) == "fasta" || file_extension(json_uri_path) == "fa") {
             std::string fai = json_uri_path.substr(0, json_uri_path.find_last_of('.') + 1) + "fai";
             std::string sha = json_uri_path.substr(0, json_uri_path.find_last_of('.') + 1) + "sha256";
+            indexFasta(json_uri_path, fai, sha, pOpts.numberOfThreads);
             auto fasta_file = genie::util::make_unique<std::ifstream>(json_uri_path);
-            if (!ghc::filesystem::exists(fai)) {
-                std::cerr << "Indexing " << json_uri_path << " ..." << std::endl;
-                std::ofstream fai_file(fai);
-                genie::format::fasta::FastaReader::index(*fasta_file, fai_file);
-            }
-            if (!ghc::filesystem::exists(sha)) {
-                std::cerr << "Calculating hashes " << json_uri_path << " ..." << std::endl;
-                std::ofstream sha_file(sha);
-                std::ifstream fai_file(fai);
-                genie::format::fasta::FaiFile fai_reader(fai_file);
-                genie::format::fasta::FastaReader::hash(fai_reader, *fasta_file, sha_file);
-            }
             auto fai_file = genie::util::make_unique<std::ifstream>(fai);
             auto sha_file = genie::util::make_unique<std::ifstream>(sha);
             inputFiles.push_back(std::move(fasta_file));
@@ -268,8 +366,38 @@ std::unique_ptr<genie::core::FlowGraph> buildDecoder(const ProgramOptions& pOpts
         inputFiles.emplace_back(genie::util::make_unique<std::ifstream>(pOpts.inputFile, std::ios::binary));
         in_ptr = inputFiles.back().get();
     }
-    flow->addImporter(genie::util::make_unique<genie::format::mgb::Importer>(
-        *in_ptr, &flow->getRefMgr(), flow->getRefDecoder(), file_extension(pOpts.outputFile) == "fasta"));
+    auto importer = genie::util::make_unique<genie::format::mgb::Importer>(
+        *in_ptr, &flow->getRefMgr(), flow->getRefDecoder(), file_extension(pOpts.outputFile) == "fasta");
+    const std::string index_path = pOpts.inputFile + ".idx";
+    if (pOpts.inputFile.substr(0, 2) != "-." && ghc::filesystem::exists(index_path) &&
+        ghc::filesystem::file_size(index_path)) {
+        // The index must be written after the stream and still match its size and parameter sets
+        bool current = false;
+        try {
+            std::ifstream index_file(index_path, std::ios::binary);
+            genie::util::BitReader index_reader(index_file);
+            genie::format::mgb::AUIndex index(index_reader);
+            std::ifstream stream(pOpts.inputFile, std::ios::binary);
+            current =
+                ghc::filesystem::last_write_time(index_path) >= ghc::filesystem::last_write_time(pOpts.inputFile) &&
+                index.matches(stream, ghc::filesystem::file_size(pOpts.inputFile));
+            if (current) {
+                importer->setIndex(std::move(index));
+            }
+        } catch (genie::util::RuntimeException&) {
+        }
+        if (!current) {
+            std::cerr << "Index " << index_path << " is outdated, scanning stream." << std::endl;
+        }
+    }
+    if (!pOpts.region.empty()) {
+        auto locus = genie::core::Locus::fromString(pOpts.region);
+        auto filter =
+            genie::util::make_unique<genie::core::LocusFilter>(findSequence(locus.getRef(), pOpts.inputFile), locus);
+        importer->setRegion(*filter);
+        flow->setRecordFilter(std::move(filter));
+    }
+    flow->addImporter(std::move(importer));
     attachExporter(*flow, pOpts, outputFiles);
     return flow;
 }
@@ -281,6 +409,7 @@ int main(int argc, char* argv[]) {
     if (pOpts.help) {
         return 0;
     }
+    genie::core::stats::PerfStats::setDefaultActive(!pOpts.noStats);
     genie::util::Watch watch;
     std::unique_ptr<genie::core::FlowGraph> flowGraph;
     std::vector<std::unique_ptr<std::ifstream>> inputFiles;
@@ -308,9 +437,11 @@ int main(int argc, char* argv[]) {
         jsonfile.write(jsonstring.data(), jsonstring.length());
     }
 
-    auto stats = flowGraph->getStats();
-    stats.addDouble("time-total", watch.check());
-    std::cerr << stats << std::endl;
+    if (!pOpts.noStats) {
+        auto stats = flowGraph->getStats();
+        stats.addDouble("time-total", watch.check());
+        std::cerr << stats << std::endl;
+    }
 
     return 0;
 }
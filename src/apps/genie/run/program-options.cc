@@ -12,6 +12,7 @@
 #include <vector>
 #include "cli11/CLI11.hpp"
 #include "filesystem/filesystem.hpp"
+#include "genie/core/reference-manager.h"
 #include "genie/util/runtime-exception.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -42,7 +43,7 @@ std::string parent_dir(const std::string &path) {
 ProgramOptions::ProgramOptions(int argc, char *argv[]) : help(false) {
     CLI::App app("Genie MPEG-G reference encoder\n");
 
-    app.add_option("-i,--input-file", inputFile, "Input file (mgrec or mgb)\n")->mandatory(true);
+    app.add_option("-i,--input-file", inputFile, "Input file (mgrec, mgb, sam, bam or cram)\n")->mandatory(true);
     app.add_option("-o,--output-file", outputFile, "Output file (mgrec or mgb)\n")->mandatory(true);
 
     inputRefFile = "";
@@ -86,9 +87,58 @@ ProgramOptions::ProgramOptions(int argc, char *argv[]) : help(false) {
         "Flag, if set no global reference will be \n"
         "calculated for unaligned records. \nThis will increase encoding speed, \nbut decrease compression rate.\n");
 
+    inMemory = false;
+    app.add_flag("--in-memory", inMemory,
+                 "Flag, if set global assembly keeps its \n"
+                 "temporary files in memory instead of \nthe working directory. Needs enough RAM \n"
+                 "to hold the unaligned reads.\n");
+
+    reorderMemory = 0;
+    app.add_option("--reorder-memory", reorderMemory,
+                   "Approximate memory in MiB for the global \n"
+                   "assembly of unaligned reads. Larger inputs \nare split by minimizer into partitions "
+                   "\nthat are assembled independently, which \ncosts some compression. 0 for no limit.\n");
+
+    refCache = genie::core::ReferenceManager::DEFAULT_CACHE_SIZE / (1024 * 1024);
+    app.add_option("--ref-cache", refCache,
+                   "Memory in MiB for caching reference \n"
+                   "chunks (default 256). Chunks are 1 MiB.\n");
+
+    adaptiveEntropy = false;
+    app.add_flag("--adaptive-entropy", adaptiveEntropy,
+                 "Flag, if set the entropy coder configuration \n"
+                 "of each descriptor subsequence is chosen by \ntrial encoding a sample of the data. "
+                 "\nRead names keep their configuration. \nIncreases encoding time.\n");
+
+    adaptiveTimeWeight = 0.0f;
+    app.add_option("--adaptive-time-weight", adaptiveTimeWeight,
+                   "Weight of the encoding time against the \n"
+                   "compressed size for --adaptive-entropy, \nfrom 0 (size only) to 1 (time only). "
+                   "\nIgnored without --non-reproducible.\n");
+
+    adaptiveInterval = 0;
+    app.add_option("--adaptive-interval", adaptiveInterval,
+                   "Number of records after which \n"
+                   "--adaptive-entropy chooses the configuration \nof a subsequence again, at most 16 times. "
+                   "\nGlobal assembly counts its records after \nall others. 0 to keep the first choice.\n");
+
+    nonReproducible = false;
+    app.add_flag("--non-reproducible", nonReproducible,
+                 "Flag, if set the output may depend on \n"
+                 "the machine and its load, e.g. when \n--adaptive-time-weight is used.\n");
+
     rawStreams = false;
     app.add_flag("--write-raw-streams", rawStreams, "Flag, if set raw uncompressed descriptors will be written out\n");
 
+    noStats = false;
+    app.add_flag("--no-stats", noStats, "Flag, if set no performance statistics are collected or printed\n");
+
+    region = "";
+    app.add_option("--region", region,
+                   "Only decode records overlapping a locus \"sequence:start-end\" \n"
+                   "(0-based, end exclusive) or \"sequence\". Sequence \ncan be a name from the "
+                   "dataset reference \nor a numeric sequence ID. Mgb input only.\n");
+
     refMode = "none";
     // Deactivated for now, as broken in connection with part 1
     /*  app.add_option("--embedded-ref", refMode,
@@ -278,9 +328,18 @@ void ProgramOptions::validate() {
 
     std::cerr << std::endl;
 
+    UTILS_DIE_IF(!region.empty() && inputFile.substr(inputFile.find_last_of('.') + 1) != "mgb",
+                 "Region queries need an mgb input file");
     UTILS_DIE_IF(qvMode != "none" && qvMode != "lossless" && qvMode != "calq", "QVMode " + qvMode + " unknown");
     UTILS_DIE_IF(refMode != "none" && refMode != "relevant" && refMode != "full", "RefMode " + refMode + " unknown");
     UTILS_DIE_IF(readNameMode != "none" && readNameMode != "lossless", "Read name mode " + readNameMode + " unknown");
+    UTILS_DIE_IF(adaptiveTimeWeight < 0.0f || adaptiveTimeWeight > 1.0f, "Adaptive time weight must be in [0, 1]");
+    if (adaptiveTimeWeight > 0.0f && !nonReproducible) {
+        std::cerr << "Warning: --adaptive-time-weight makes the output depend on timing, it is ignored without "
+                     "--non-reproducible"
+                  << std::endl;
+        adaptiveTimeWeight = 0.0f;
+    }
 
     if (std::thread::hardware_concurrency()) {
         UTILS_DIE_IF(numberOfThreads < 1 || numberOfThreads > std::thread::hardware_concurrency(),
@@ -47,12 +47,22 @@ class ProgramOptions {
 
     bool combinePairsFlag;  //!< @brief
 
-    bool lowLatency;      //!< @brief
-    std::string refMode;  //!< @brief
+    bool lowLatency;       //!< @brief
+    bool inMemory;         //!< @brief Keep global assembly temporary files in memory
+    size_t reorderMemory;  //!< @brief Approximate global assembly memory in MiB, 0 for no limit
+    std::string refMode;   //!< @brief
+    size_t refCache;       //!< @brief Reference chunk cache size in MiB
+
+    bool adaptiveEntropy;      //!< @brief Choose entropy coder configurations while encoding
+    float adaptiveTimeWeight;  //!< @brief Weight of the encoding time in the choice
+    size_t adaptiveInterval;   //!< @brief Records per choice, 0 for once
+    bool nonReproducible;      //!< @brief Allow output that depends on timing
 
     size_t numberOfThreads;  //!< @brief
     bool rawReference;       //!< @brief
     bool rawStreams;         //!< @brief
+    bool noStats;            //!< @brief
+    std::string region;      //!< @brief Only decode records overlapping this locus
 
     bool help;  //!< @brief
 
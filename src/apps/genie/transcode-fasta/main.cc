@@ -66,7 +66,8 @@ int main(int argc, char* argv[]) {
     auto fastaFile = genie::util::make_unique<std::ifstream>(pOpts.inputFile);
     auto faiFile = genie::util::make_unique<std::ifstream>(fai_name);
     auto shaFile = genie::util::make_unique<std::ifstream>(sha_name);
-    auto refMgr = genie::util::make_unique<genie::core::ReferenceManager>(4);
+    auto refMgr = genie::util::make_unique<genie::core::ReferenceManager>(
+        4 * genie::core::ReferenceManager::getChunkSize());
     auto fastaMgr = genie::util::make_unique<genie::format::fasta::Manager>(*fastaFile, *faiFile, *shaFile,
                                                                             refMgr.get(), pOpts.inputFile);
     genie::format::mgb::RawReference raw_ref(true);
@@ -25,6 +25,7 @@
 #include "genie/module/default-setup.h"
 #include "genie/quality/qvwriteout/encoder-none.h"
 #include "genie/read/lowlatency/encoder.h"
+#include "genie/util/gzip-stream.h"
 #include "genie/util/watch.h"
 
 // TODO(Fabian): For some reason, compilation on windows fails if we move this include further up. Investigate.
@@ -48,6 +49,12 @@ std::string file_extension(const std::string& path) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+std::string strip_gzip_extension(const std::string& path) {
+    return file_extension(path) == "gz" ? path.substr(0, path.find_last_of('.')) : path;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 enum class OperationCase { UNKNOWN = 0, CONVERT = 3 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -79,7 +86,8 @@ OperationCase getOperation(FileType in, FileType out) {
 // ---------------------------------------------------------------------------------------------------------------------
 
 OperationCase getOperation(const std::string& filenameIn, const std::string& filenameOut) {
-    return getOperation(getType(file_extension(filenameIn)), getType(file_extension(filenameOut)));
+    return getOperation(getType(file_extension(strip_gzip_extension(filenameIn))),
+                        getType(file_extension(filenameOut)));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -112,27 +120,37 @@ void attachExporter(T& flow, const ProgramOptions& pOpts, std::vector<std::uniqu
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+std::istream* openInput(const std::string& path, size_t numThreads,
+                        std::vector<std::unique_ptr<std::istream>>& inputFiles) {
+    bool gzip = file_extension(path) == "gz";
+    std::istream* file = &std::cin;
+    if (path.substr(0, 2) != "-.") {
+        inputFiles.emplace_back(
+            genie::util::make_unique<std::ifstream>(path, gzip ? std::ios::in | std::ios::binary : std::ios::in));
+        file = inputFiles.back().get();
+    }
+    if (gzip) {
+        inputFiles.emplace_back(genie::util::make_unique<genie::util::GzipStream>(*file, numThreads));
+        file = inputFiles.back().get();
+    }
+    return file;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 template <class T>
-void attachImporter(T& flow, const ProgramOptions& pOpts, std::vector<std::unique_ptr<std::ifstream>>& inputFiles,
+void attachImporter(T& flow, const ProgramOptions& pOpts, std::vector<std::unique_ptr<std::istream>>& inputFiles,
                     std::vector<std::unique_ptr<std::ofstream>>& outputFiles) {
     constexpr size_t BLOCKSIZE = 256000;
-    std::istream* file1 = &std::cin;
-    if (pOpts.inputFile.substr(0, 2) != "-.") {
-        inputFiles.emplace_back(genie::util::make_unique<std::ifstream>(pOpts.inputFile));
-        file1 = inputFiles.back().get();
-    }
-    if (file_extension(pOpts.inputFile) == "fastq") {
-        if (file_extension(pOpts.inputSupFile) == "fastq") {
-            std::istream* file2 = &std::cin;
-            if (pOpts.inputSupFile.substr(0, 2) != "-.") {
-                inputFiles.emplace_back(genie::util::make_unique<std::ifstream>(pOpts.inputSupFile));
-                file2 = inputFiles.back().get();
-            }
+    std::istream* file1 = openInput(pOpts.inputFile, pOpts.numberOfThreads, inputFiles);
+    if (file_extension(strip_gzip_extension(pOpts.inputFile)) == "fastq") {
+        if (file_extension(strip_gzip_extension(pOpts.inputSupFile)) == "fastq") {
+            std::istream* file2 = openInput(pOpts.inputSupFile, pOpts.numberOfThreads, inputFiles);
             flow.addImporter(genie::util::make_unique<genie::format::fastq::Importer>(BLOCKSIZE, *file1, *file2));
         } else {
             flow.addImporter(genie::util::make_unique<genie::format::fastq::Importer>(BLOCKSIZE, *file1));
         }
-    } else if (file_extension(pOpts.inputFile) == "mgrec") {
+    } else if (file_extension(strip_gzip_extension(pOpts.inputFile)) == "mgrec") {
         auto tmpFile = pOpts.outputFile + ".unsupported.mgrec";
         outputFiles.emplace_back(genie::util::make_unique<std::ofstream>(tmpFile));
         flow.addImporter(
@@ -144,7 +162,7 @@ void attachImporter(T& flow, const ProgramOptions& pOpts, std::vector<std::uniqu
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::unique_ptr<genie::core::FlowGraph> buildConverter(const ProgramOptions& pOpts,
-                                                       std::vector<std::unique_ptr<std::ifstream>>& inputFiles,
+                                                       std::vector<std::unique_ptr<std::istream>>& inputFiles,
                                                        std::vector<std::unique_ptr<std::ofstream>>& outputFiles) {
     auto flow = genie::module::buildDefaultConverter(pOpts.numberOfThreads);
     attachExporter(*flow, pOpts, outputFiles);
@@ -161,7 +179,7 @@ int main(int argc, char* argv[]) {
     }
     genie::util::Watch watch;
     std::unique_ptr<genie::core::FlowGraph> flowGraph;
-    std::vector<std::unique_ptr<std::ifstream>> inputFiles;
+    std::vector<std::unique_ptr<std::istream>> inputFiles;
     std::vector<std::unique_ptr<std::ofstream>> outputFiles;
     switch (getOperation(pOpts.inputFile, pOpts.outputFile)) {
         case OperationCase::UNKNOWN:
@@ -42,11 +42,12 @@ std::string parent_dir(const std::string &path) {
 ProgramOptions::ProgramOptions(int argc, char *argv[]) : help(false) {
     CLI::App app("Genie MPEG-G reference encoder\n");
 
-    app.add_option("-i,--input-file", inputFile, "Input file (fastq or mgrec)\n")->mandatory(true);
+    app.add_option("-i,--input-file", inputFile, "Input file (fastq or mgrec, optionally gzip compressed)\n")
+        ->mandatory(true);
     app.add_option("-o,--output-file", outputFile, "Output file (fastq or mgrec)\n")->mandatory(true);
 
     inputSupFile = "";
-    app.add_option("--input-suppl-file", inputSupFile, "Paired input fastq file\n");
+    app.add_option("--input-suppl-file", inputSupFile, "Paired input fastq file, optionally gzip compressed\n");
 
     outputSupFile = "";
     app.add_option("--output-suppl-file", outputSupFile, "Paired output fastq file\n");
@@ -56,6 +56,10 @@ void Config::processCommandLine(int argc, char *argv[]) {
     app.add_flag("--no_ref", no_ref, "Don't use a reference.\n");
     clean = false;
     app.add_flag("-c,--clean_records", clean, "Remove unsupported reads.\n");
+    split_by_ref = false;
+    app.add_flag("--split-by-ref", split_by_ref,
+                 "Write the records of each reference sequence to its own mgrec file\n"
+                 "named <output>.<reference ID>.mgrec, unmapped records go to <output>.unmapped.mgrec.\n");
     num_threads = std::thread::hardware_concurrency();
     app.add_option("-t,--threads", num_threads, "Number of threads to use.\n");
     fasta_file_path = "";
@@ -208,6 +212,7 @@ void Config::validate() {
 
     std::cerr << std::endl;
 
+    UTILS_DIE_IF(split_by_ref && outputFile.substr(0, 2) == "-.", "Output split by reference needs an output file");
     validateOutputFile(outputFile, forceOverwrite);
     if (outputFile.substr(0, 2) != "-.") {
         outputFile = ghc::filesystem::weakly_canonical(outputFile).string();
@@ -53,6 +53,7 @@ class Config {
     bool help;                    //!< @brief
     bool no_ref;                  //!< @brief
     bool clean;                   //!< @brief
+    bool split_by_ref;            //!< @brief Write one mgrec file per reference sequence
     uint32_t num_threads;         //!< @brief
 
  private:
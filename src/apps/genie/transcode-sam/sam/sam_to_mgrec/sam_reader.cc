@@ -88,6 +88,40 @@ bool SamReader::isValid() {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+bool SamReader::isCoordinateSorted() {
+    return sam_hdr_find_tag_hd(sam_header, "SO", &header_info) == 0 && std::strcmp(header_info.s, "coordinate") == 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SamReader::setThreads(int num_threads) {
+    UTILS_DIE_IF(hts_set_threads(sam_file, num_threads) != 0, "Could not start decompression threads");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SamReader::setReference(const std::string& fasta_path) {
+    UTILS_DIE_IF(hts_set_fai_filename(sam_file, fasta_path.c_str()) != 0, "Could not set reference " + fasta_path);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int SamReader::readSamRecord(SamRecord& sr) {
+    if (buffered_rec) {
+        sr = std::move(buffered_rec.get());
+        buffered_rec.reset();
+        return 0;
+    }
+    auto res = sam_read1(sam_file, sam_header, sam_alignment);
+    if (res < 0) {
+        return res;
+    }
+    sr = SamRecord(sam_alignment);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 int SamReader::readSamQuery(std::vector<SamRecord>& sr) {
     sr.clear();
     if (buffered_rec) {
@@ -71,12 +71,37 @@ class SamReader {
      */
     bool isValid();
 
+    /**
+     * @brief
+     * @return True if the SAM header documents that records are ordered by coordinate
+     */
+    bool isCoordinateSorted();
+
+    /**
+     * @brief Decompress BGZF blocks in background threads while records are processed
+     * @param num_threads Number of decompression threads
+     */
+    void setThreads(int num_threads);
+
+    /**
+     * @brief Set the reference needed to decode CRAM files
+     * @param fasta_path FASTA file
+     */
+    void setReference(const std::string& fasta_path);
+
     /**
      * @brief
      * @param sr
      * @return
      */
     int readSamQuery(std::vector<SamRecord>& sr);
+
+    /**
+     * @brief Read the next alignment, without grouping by read name
+     * @param sr Alignment
+     * @return 0 on success, -1 at the end of the file, smaller on errors
+     */
+    int readSamRecord(SamRecord& sr);
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
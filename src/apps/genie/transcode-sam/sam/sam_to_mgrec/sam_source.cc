@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "apps/genie/transcode-sam/sam/sam_to_mgrec/sam_source.h"
+#include <iostream>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+#include "apps/genie/transcode-sam/sam/sam_to_mgrec/sam_group.h"
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genieapp {
+namespace transcode_sam {
+namespace sam {
+namespace sam_to_mgrec {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+SamSource::SamSource(const std::string& inputFile, const std::string& fastaFile, size_t numThreads)
+    : reader(inputFile), refinf(fastaFile) {
+    UTILS_DIE_IF(!reader.isReady(), "Cannot open SAM file " + inputFile);
+    UTILS_DIE_IF(!reader.isCoordinateSorted(),
+                 "Sam file must be ordered by coordinate! That ordering must be documented in the SAM header.");
+    if (numThreads > 1) {
+        reader.setThreads(static_cast<int>(numThreads));
+    }
+    if (!fastaFile.empty()) {
+        reader.setReference(fastaFile);
+    }
+    refs = reader.getRefs();
+    sam_hdr_to_fasta_lut = build_ref_lut(refs, refinf, fastaFile.empty());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SamSource::read(genie::format::sam::Alignment* alignment) {
+    auto ret = reader.readSamRecord(current);
+    if (ret == -1) {
+        return false;
+    }
+    UTILS_DIE_IF(ret < 0, "Error reading sam record: " + std::to_string(ret));
+
+    alignment->qname = current.getQname();
+    alignment->rid = current.getRID();
+    alignment->pos = current.getPos();
+    alignment->mrid = current.getMRID();
+    alignment->mpos = current.getMPos();
+    alignment->paired = current.isPaired();
+    alignment->additional = current.isSecondary() || current.isSupplementary();
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SamSource::keep() {
+    auto& query = queries[current.getQname()];
+    query.push_back(std::move(current));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SamSource::convert(const std::string& qname, std::vector<genie::core::record::Record>* records) {
+    auto it = queries.find(qname);
+    UTILS_DIE_IF(it == queries.end(), "No alignments kept for read " + qname);
+    SamRecordGroup group;
+    for (auto& r : it->second) {
+        group.addRecord(std::move(r));
+    }
+    queries.erase(it);
+
+    std::list<genie::core::record::Record> converted;
+    group.convert(converted);
+    for (auto& m : converted) {
+        auto r = cleanRecord(std::move(m));
+        cleanStats.splice_recs += r.second.splice_recs;
+        cleanStats.distance += r.second.distance;
+        cleanStats.additional_alignments += r.second.additional_alignments;
+        cleanStats.hm_recs += r.second.hm_recs;
+        for (auto& c : r.first) {
+            records->push_back(std::move(c));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SamSource::finish(genie::core::record::Record* record) {
+    if (!record->getAlignments().empty()) {
+        record->patchRefID(sam_hdr_to_fasta_lut[record->getAlignmentSharedData().getSeqID()]);
+    }
+    return fix_ecigar(*record, refs, refinf);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SamSource::printStats() const {
+    std::cerr << std::endl;
+    std::cerr << "HM records dealigned: " << cleanStats.hm_recs << std::endl;
+    std::cerr << "I records split because of large mapping distance: " << cleanStats.distance << std::endl;
+    std::cerr << "Additional alignments removed: " << cleanStats.additional_alignments << std::endl;
+    std::cerr << "Records dealigned because of splices: " << cleanStats.splice_recs << std::endl;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace sam_to_mgrec
+}  // namespace sam
+}  // namespace transcode_sam
+}  // namespace genieapp
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
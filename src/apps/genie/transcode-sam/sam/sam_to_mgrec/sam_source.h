@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_APPS_GENIE_TRANSCODE_SAM_SAM_SAM_TO_MGREC_SAM_SOURCE_H_
+#define SRC_APPS_GENIE_TRANSCODE_SAM_SAM_SAM_TO_MGREC_SAM_SOURCE_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "apps/genie/transcode-sam/sam/sam_to_mgrec/sam_reader.h"
+#include "apps/genie/transcode-sam/sam/sam_to_mgrec/transcoder.h"
+#include "genie/core/record/record.h"
+#include "genie/format/sam/alignment-source.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genieapp {
+namespace transcode_sam {
+namespace sam {
+namespace sam_to_mgrec {
+
+/**
+ * @brief Alignments of a SAM, BAM or CRAM file read with htslib, converted and cleaned like in transcode-sam
+ */
+class SamSource : public genie::format::sam::AlignmentSource {
+ private:
+    SamReader reader;                                                 //!< @brief Input
+    std::vector<std::pair<std::string, size_t>> refs;                 //!< @brief SAM header references
+    RefInfo refinf;                                                   //!< @brief Reference to patch eCIGARs
+    std::vector<size_t> sam_hdr_to_fasta_lut;                         //!< @brief SAM header to reference IDs
+    SamRecord current;                                                //!< @brief Alignment read last
+    std::unordered_map<std::string, std::vector<SamRecord>> queries;  //!< @brief Kept alignments, by read name
+    CleanStatistics cleanStats;                                       //!< @brief Records changed to be supported
+
+ public:
+    /**
+     * @brief
+     * @param inputFile SAM, BAM or CRAM file
+     * @param fastaFile Reference, empty if none is used
+     * @param numThreads Number of decompression threads
+     */
+    SamSource(const std::string& inputFile, const std::string& fastaFile, size_t numThreads);
+
+    /**
+     * @brief
+     * @param alignment
+     * @return
+     */
+    bool read(genie::format::sam::Alignment* alignment) override;
+
+    /**
+     * @brief
+     */
+    void keep() override;
+
+    /**
+     * @brief
+     * @param qname
+     * @param records
+     */
+    void convert(const std::string& qname, std::vector<genie::core::record::Record>* records) override;
+
+    /**
+     * @brief
+     * @param record
+     * @return
+     */
+    bool finish(genie::core::record::Record* record) override;
+
+    /**
+     * @brief
+     */
+    void printStats() const override;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace sam_to_mgrec
+}  // namespace sam
+}  // namespace transcode_sam
+}  // namespace genieapp
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_APPS_GENIE_TRANSCODE_SAM_SAM_SAM_TO_MGREC_SAM_SOURCE_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
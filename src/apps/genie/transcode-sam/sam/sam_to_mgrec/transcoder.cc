@@ -6,6 +6,7 @@
 
 #include "apps/genie/transcode-sam/sam/sam_to_mgrec/transcoder.h"
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -19,6 +20,7 @@
 #include "boost/optional/optional.hpp"
 #include "filesystem/filesystem.hpp"
 #include "genie/core/record/alignment_split/other-rec.h"
+#include "genie/util/ordered-lock.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -30,7 +32,9 @@ namespace sam_to_mgrec {
 // ---------------------------------------------------------------------------------------------------------------------
 
 RefInfo::RefInfo(const std::string& fasta_name)
-    : refMgr(genie::util::make_unique<genie::core::ReferenceManager>(4)), valid(false) {
+    : refMgr(genie::util::make_unique<genie::core::ReferenceManager>(
+          4 * genie::core::ReferenceManager::getChunkSize())),
+      valid(false) {
     if (!ghc::filesystem::exists(fasta_name)) {
         return;
     }
@@ -188,13 +192,6 @@ bool isECigarSupported(const std::string& ecigar) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-struct CleanStatistics {
-    size_t hm_recs{};
-    size_t splice_recs{};
-    size_t distance{};
-    size_t additional_alignments{};
-};
-
 std::pair<std::vector<genie::core::record::Record>, CleanStatistics> cleanRecord(genie::core::record::Record&& input) {
     std::vector<genie::core::record::Record> ret;
     CleanStatistics stats;
@@ -244,8 +241,36 @@ std::pair<std::vector<genie::core::record::Record>, CleanStatistics> cleanRecord
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+uint32_t get_partition(const genie::core::record::Record& record) {
+    if (record.getAlignments().empty()) {
+        return UNALIGNED_PARTITION;
+    }
+    return record.getAlignmentSharedData().getSeqID();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string gen_p1_fpath(const std::string& tmp_path, int chunk, uint32_t partition) {
+    return tmp_path + "/" + std::to_string(chunk) + "." + std::to_string(partition) + PHASE1_EXT;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string gen_p2_fpath(const Config& options, uint32_t partition, size_t ref_id) {
+    if (!options.split_by_ref) {
+        return options.tmp_dir_path + "/" + std::to_string(partition) + PHASE2_EXT;
+    }
+    auto stem = options.outputFile.substr(0, options.outputFile.find_last_of('.'));
+    if (partition == UNALIGNED_PARTITION) {
+        return stem + ".unmapped.mgrec";
+    }
+    return stem + "." + std::to_string(ref_id) + ".mgrec";
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void phase1_thread(SamReader& sam_reader, int& chunk_id, const std::string& tmp_path, bool clean, std::mutex& lock,
-                   CleanStatistics& stats) {
+                   CleanStatistics& stats, PartitionMap& partitions) {
     while (true) {
         std::vector<genie::core::record::Record> output_buffer;
         std::vector<std::vector<SamRecord>> queries;
@@ -305,21 +330,30 @@ void phase1_thread(SamReader& sam_reader, int& chunk_id, const std::string& tmp_
 
         std::sort(output_buffer.begin(), output_buffer.end(), compare);
 
-        // Write data
-        {
-            std::string fpath = tmp_path + "/" + std::to_string(this_chunk) + PHASE1_EXT;
-            std::ofstream output_file(fpath, std::ios::trunc | std::ios::binary);
+        // Write data, one file per partition so that phase 2 can merge the partitions independently
+        std::vector<uint32_t> written_partitions;
+        auto begin = output_buffer.begin();
+        while (begin != output_buffer.end()) {
+            const auto partition = get_partition(*begin);
+            auto end = std::find_if(begin, output_buffer.end(), [partition](const genie::core::record::Record& r) {
+                return get_partition(r) != partition;
+            });
+
+            std::ofstream output_file(gen_p1_fpath(tmp_path, this_chunk, partition),
+                                      std::ios::trunc | std::ios::binary);
             genie::util::BitWriter bwriter(&output_file);
-
-            for (auto& r : output_buffer) {
-                r.write(bwriter);
+            for (; begin != end; ++begin) {
+                begin->write(bwriter);
             }
-
             bwriter.flush();
+            written_partitions.push_back(partition);
         }
 
         {
             std::lock_guard<std::mutex> guard(lock);
+            for (auto p : written_partitions) {
+                partitions[p].push_back(this_chunk);
+            }
             stats.splice_recs += local_stats.splice_recs;
             stats.hm_recs += local_stats.hm_recs;
             stats.additional_alignments += local_stats.additional_alignments;
@@ -335,7 +369,8 @@ void phase1_thread(SamReader& sam_reader, int& chunk_id, const std::string& tmp_
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-std::vector<std::pair<std::string, size_t>> sam_to_mgrec_phase1(Config& options, int& chunk_id) {
+std::vector<std::pair<std::string, size_t>> sam_to_mgrec_phase1(Config& options, int& chunk_id,
+                                                                PartitionMap& partitions) {
     auto sam_reader = SamReader(options.inputFile);
     UTILS_DIE_IF(!sam_reader.isReady() || !sam_reader.isValid(), "Cannot open SAM file.");
 
@@ -345,8 +380,9 @@ std::vector<std::pair<std::string, size_t>> sam_to_mgrec_phase1(Config& options,
     threads.reserve(options.num_threads);
     CleanStatistics stats;
     for (uint32_t i = 0; i < options.num_threads; ++i) {
-        threads.emplace_back(
-            [&]() { phase1_thread(sam_reader, chunk_id, options.tmp_dir_path, options.clean, lock, stats); });
+        threads.emplace_back([&]() {
+            phase1_thread(sam_reader, chunk_id, options.tmp_dir_path, options.clean, lock, stats, partitions);
+        });
     }
     for (auto& t : threads) {
         t.join();
@@ -546,13 +582,10 @@ bool fix_ecigar(genie::core::record::Record& r, const std::vector<std::pair<std:
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void sam_to_mgrec_phase2(Config& options, int num_chunks, const std::vector<std::pair<std::string, size_t>>& refs) {
-    std::cerr << "Merging " << num_chunks << " chunks..." << std::endl;
-    RefInfo refinf(options.fasta_file_path);
-    size_t removed_unsupported_base = 0;
-
+std::vector<size_t> build_ref_lut(const std::vector<std::pair<std::string, size_t>>& refs, RefInfo& refinf,
+                                  bool no_ref) {
     std::vector<size_t> sam_hdr_to_fasta_lut;
-    if (!options.no_ref) {
+    if (!no_ref) {
         for (size_t i = 0; i < refs.size(); ++i) {
             bool found = false;
             for (size_t j = 0; j < refinf.getMgr()->getSequences().size(); ++j) {
@@ -569,69 +602,149 @@ void sam_to_mgrec_phase2(Config& options, int num_chunks, const std::vector<std:
             sam_hdr_to_fasta_lut.push_back(i);
         }
     }
+    return sam_hdr_to_fasta_lut;
+}
 
-    std::unique_ptr<std::ostream> total_output;
-    std::ostream* out_stream = &std::cout;
-    if (options.outputFile.substr(0, 2) != "-.") {
-        total_output = genie::util::make_unique<std::ofstream>(options.outputFile, std::ios::binary | std::ios::trunc);
-        out_stream = total_output.get();
-    }
-    genie::util::BitWriter total_output_writer(out_stream);
+// ---------------------------------------------------------------------------------------------------------------------
 
+size_t merge_partition(const std::vector<std::string>& paths, const std::vector<size_t>& sam_hdr_to_fasta_lut,
+                       const std::vector<std::pair<std::string, size_t>>& refs, RefInfo& refinf,
+                       genie::util::BitWriter& writer) {
+    size_t removed_unsupported_base = 0;
     std::vector<std::unique_ptr<SubfileReader>> readers;
-    readers.reserve(num_chunks);
+    readers.reserve(paths.size());
     auto cmp = [&](const SubfileReader* a, SubfileReader* b) {
         return !compare(a->getRecord().get(), b->getRecord().get());
     };
     std::priority_queue<SubfileReader*, std::vector<SubfileReader*>, decltype(cmp)> heap(cmp);
-    for (int i = 0; i < num_chunks; ++i) {
-        readers.emplace_back(
-            genie::util::make_unique<SubfileReader>(options.tmp_dir_path + "/" + std::to_string(i) + PHASE1_EXT));
-        if (!readers.back()->getRecord()) {
-            auto path = readers.back()->getPath();
-            std::cerr << path << " depleted" << std::endl;
-            readers.pop_back();
-            std::remove(path.c_str());
-        } else {
+    for (const auto& p : paths) {
+        readers.emplace_back(genie::util::make_unique<SubfileReader>(p));
+        if (readers.back()->getRecord()) {
             heap.push(readers.back().get());
         }
     }
 
-    if (!heap.empty()) {
-        while (true) {
-            auto* reader = heap.top();
-            heap.pop();
-            auto rec = reader->moveRecord();
-            rec.patchRefID(sam_hdr_to_fasta_lut[rec.getAlignmentSharedData().getSeqID()]);
+    while (!heap.empty()) {
+        auto* reader = heap.top();
+        heap.pop();
+        auto rec = reader->moveRecord();
+        rec.patchRefID(sam_hdr_to_fasta_lut[rec.getAlignmentSharedData().getSeqID()]);
 
-            if (fix_ecigar(rec, refs, refinf)) {
-                rec.write(total_output_writer);
-            } else {
-                removed_unsupported_base++;
-            }
+        if (fix_ecigar(rec, refs, refinf)) {
+            rec.write(writer);
+        } else {
+            removed_unsupported_base++;
+        }
 
-            if (reader->getRecord()) {
-                heap.push(reader);
-            } else {
-                auto path = reader->getPath();
-                std::cerr << path << " depleted" << std::endl;
-                for (auto it = readers.begin(); it != readers.end(); ++it) {
-                    if (it->get() == reader) {
-                        readers.erase(it);
-                        break;
-                    }
-                }
-                std::remove(path.c_str());
+        if (reader->getRecord()) {
+            heap.push(reader);
+        }
+    }
 
-                if (heap.empty()) {
-                    break;
-                }
-            }
+    readers.clear();
+    for (const auto& p : paths) {
+        std::remove(p.c_str());
+    }
+    return removed_unsupported_base;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void phase2_thread(const Config& options, const std::vector<std::pair<uint32_t, std::vector<int>>>& partitions,
+                   std::atomic<size_t>& next_partition, const std::vector<size_t>& sam_hdr_to_fasta_lut,
+                   const std::vector<std::pair<std::string, size_t>>& refs, genie::util::OrderedLock& output_lock,
+                   std::ostream* output, std::atomic<size_t>& removed_unsupported_base) {
+    // The reference manager caches loaded reference chunks and is not shared between threads
+    RefInfo refinf(options.fasta_file_path);
+    while (true) {
+        const size_t id = next_partition++;
+        if (id >= partitions.size()) {
+            return;
+        }
+        const auto partition = partitions[id].first;
+
+        std::vector<std::string> paths;
+        for (auto chunk : partitions[id].second) {
+            paths.push_back(gen_p1_fpath(options.tmp_dir_path, chunk, partition));
+        }
+
+        // Partitions are handed out in order. If all previous partitions have been written already, the partition
+        // is merged straight into the output. Only partitions finishing out of order go through a temporary file.
+        if (!options.split_by_ref && output_lock.tryWait(id)) {
+            genie::util::BitWriter writer(output);
+            removed_unsupported_base += merge_partition(paths, sam_hdr_to_fasta_lut, refs, refinf, writer);
+            writer.flush();
+            output_lock.finished(1);
+            continue;
         }
+
+        const auto ref_id = partition == UNALIGNED_PARTITION ? 0 : sam_hdr_to_fasta_lut[partition];
+        const auto path = gen_p2_fpath(options, partition, ref_id);
+        {
+            std::ofstream output_file(path, std::ios::binary | std::ios::trunc);
+            genie::util::BitWriter writer(&output_file);
+            removed_unsupported_base += merge_partition(paths, sam_hdr_to_fasta_lut, refs, refinf, writer);
+            writer.flush();
+        }
+
+        if (options.split_by_ref) {
+            std::cerr << "Merged " << path << std::endl;
+            continue;
+        }
+
+        // Records are byte aligned, so the merged partitions can simply be concatenated
+        output_lock.wait(id);
+        if (ghc::filesystem::file_size(path)) {
+            std::ifstream input_file(path, std::ios::binary);
+            *output << input_file.rdbuf();
+        }
+        output_lock.finished(1);
+        std::remove(path.c_str());
     }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void sam_to_mgrec_phase2(Config& options, int num_chunks, const std::vector<std::pair<std::string, size_t>>& refs,
+                         const PartitionMap& partitions) {
+    std::cerr << "Merging " << num_chunks << " chunks in " << partitions.size() << " partitions..." << std::endl;
+    RefInfo refinf(options.fasta_file_path);
+    const auto sam_hdr_to_fasta_lut = build_ref_lut(refs, refinf, options.no_ref);
 
-    total_output_writer.flush();
-    out_stream->flush();
+    std::unique_ptr<std::ostream> total_output;
+    std::ostream* out_stream = &std::cout;
+    if (options.split_by_ref) {
+        out_stream = nullptr;
+    } else if (options.outputFile.substr(0, 2) != "-.") {
+        total_output = genie::util::make_unique<std::ofstream>(options.outputFile, std::ios::binary | std::ios::trunc);
+        out_stream = total_output.get();
+    }
+
+    // Phase 1 threads finish their chunks in any order, sort them so that the output does not depend on it
+    std::vector<std::pair<uint32_t, std::vector<int>>> partition_list(partitions.begin(), partitions.end());
+    for (auto& p : partition_list) {
+        std::sort(p.second.begin(), p.second.end());
+    }
+
+    std::atomic<size_t> next_partition(0);
+    std::atomic<size_t> removed_unsupported_base(0);
+    genie::util::OrderedLock output_lock;
+    std::vector<std::thread> threads;
+    const auto num_threads = std::min<size_t>(options.num_threads, std::max<size_t>(partition_list.size(), 1));
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&]() {
+            phase2_thread(options, partition_list, next_partition, sam_hdr_to_fasta_lut, refs, output_lock,
+                          out_stream, removed_unsupported_base);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    if (out_stream) {
+        out_stream->flush();
+    }
 
     std::cerr << "Finished merging!" << std::endl;
     std::cerr << removed_unsupported_base << " records removed because of unsupported bases." << std::endl;
@@ -641,9 +754,10 @@ void sam_to_mgrec_phase2(Config& options, int num_chunks, const std::vector<std:
 
 void transcode_sam2mpg(Config& options) {
     int nref;
+    PartitionMap partitions;
 
-    auto refs = sam_to_mgrec_phase1(options, nref);
-    sam_to_mgrec_phase2(options, nref, refs);
+    auto refs = sam_to_mgrec_phase1(options, nref, partitions);
+    sam_to_mgrec_phase2(options, nref, refs, partitions);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
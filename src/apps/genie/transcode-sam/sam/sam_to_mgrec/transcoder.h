@@ -36,6 +36,79 @@ namespace sam_to_mgrec {
 #define PHASE2_TMP_EXT ".phase2.tmp"
 // #define PHASE1_BUFFER_SIZE 50000
 #define PHASE2_BUFFER_SIZE 1000000
+#define UNALIGNED_PARTITION 0x10000
+
+/**
+ * @brief
+ */
+class RefInfo {
+ private:
+    std::unique_ptr<genie::core::ReferenceManager> refMgr;    //!< @brief
+    std::unique_ptr<genie::format::fasta::Manager> fastaMgr;  //!< @brief
+    std::unique_ptr<std::istream> fastaFile;                  //!< @brief
+    std::unique_ptr<std::istream> faiFile;                    //!< @brief
+    std::unique_ptr<std::istream> shaFile;                    //!< @brief
+    bool valid;                                               //!< @brief
+
+ public:
+    /**
+     * @brief
+     * @param fasta_name
+     */
+    explicit RefInfo(const std::string& fasta_name);
+
+    /**
+     * @brief
+     * @return
+     */
+    bool isValid() const;
+
+    /**
+     * @brief
+     * @return
+     */
+    genie::core::ReferenceManager* getMgr();
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Records changed by cleanRecord()
+ */
+struct CleanStatistics {
+    size_t hm_recs{};                //!< @brief Class HM records dealigned
+    size_t splice_recs{};            //!< @brief Records dealigned because of splices
+    size_t distance{};               //!< @brief Records split because of a large mapping distance
+    size_t additional_alignments{};  //!< @brief Additional alignments removed
+};
+
+/**
+ * @brief Turn a record into records the encoders support
+ * @param input Record
+ * @return Supported records and what was changed
+ */
+std::pair<std::vector<genie::core::record::Record>, CleanStatistics> cleanRecord(genie::core::record::Record&& input);
+
+/**
+ * @brief Patch the eCIGARs of a record against the reference and update its class
+ * @param r Record, its reference ID already patched to the reference of refinf
+ * @param refs
+ * @param ref
+ * @return False if the record contains bases not supported
+ */
+bool fix_ecigar(genie::core::record::Record& r, const std::vector<std::pair<std::string, size_t>>& refs, RefInfo& ref);
+
+/**
+ * @brief
+ * @param refs SAM header references
+ * @param refinf Reference
+ * @param no_ref If no reference is used
+ * @return Reference IDs of the output for the SAM header reference IDs
+ */
+std::vector<size_t> build_ref_lut(const std::vector<std::pair<std::string, size_t>>& refs, RefInfo& refinf,
+                                  bool no_ref);
+
+// ---------------------------------------------------------------------------------------------------------------------
 
 /**
  * @brief
@@ -46,30 +119,72 @@ namespace sam_to_mgrec {
 bool save_mgrecs_by_rid(std::list<genie::core::record::Record>& mpegg_recs,
                         std::map<int32_t, genie::util::BitWriter>& bitwriters);
 
+/**
+ * @brief Phase 1 chunks holding records of each partition. Partitions are the SAM header reference IDs, unaligned
+ * records go to UNALIGNED_PARTITION. Iterating the map visits the partitions in output order.
+ */
+using PartitionMap = std::map<uint32_t, std::vector<int>>;
+
 /**
  * @brief
  * @param options
  * @param nref
+ * @param partitions Filled with the chunks of each partition
  * @return
  */
-std::vector<std::pair<std::string, size_t>> sam_to_mgrec_phase1(Config& options, int& nref);
+std::vector<std::pair<std::string, size_t>> sam_to_mgrec_phase1(Config& options, int& nref,
+                                                                PartitionMap& partitions);
 
 /**
  * @brief
- * @param options
- * @param rid
- * @param ifile
- * @return
+ * @param record Record
+ * @return Partition of the record
  */
-std::string gen_p2_tmp_fpath(Config& options, int rid, int ifile);
+uint32_t get_partition(const genie::core::record::Record& record);
+
+/**
+ * @brief
+ * @param tmp_path Working directory
+ * @param chunk Phase 1 chunk
+ * @param partition Partition
+ * @return Path of the sorted records of one partition in one chunk
+ */
+std::string gen_p1_fpath(const std::string& tmp_path, int chunk, uint32_t partition);
 
 /**
  * @brief
  * @param options
+ * @param partition Partition
+ * @param ref_id Reference ID in the output, ignored for unaligned records
+ * @return Path of the merged records of one partition. A temporary file, or the final output file if the output is
+ * split by reference.
+ */
+std::string gen_p2_fpath(const Config& options, uint32_t partition, size_t ref_id);
+
+/**
+ * @brief Merge the sorted phase 1 files of one partition and patch the eCIGARs
+ * @param paths Phase 1 files, removed afterwards
+ * @param sam_hdr_to_fasta_lut Reference IDs of the output for the SAM header reference IDs
+ * @param refs
+ * @param refinf Reference, only used by the calling thread
+ * @param writer Output
+ * @return Number of records removed because of unsupported bases
+ */
+size_t merge_partition(const std::vector<std::string>& paths, const std::vector<size_t>& sam_hdr_to_fasta_lut,
+                       const std::vector<std::pair<std::string, size_t>>& refs, RefInfo& refinf,
+                       genie::util::BitWriter& writer);
+
+/**
+ * @brief Merge the partitions concurrently. Each thread merges whole partitions. Unless the output is split by
+ * reference, the merged partitions are appended to the output in partition order. The next partition in order is
+ * merged straight into the output, only partitions merged ahead of their turn are buffered in temporary files.
+ * @param options
  * @param nref
- * @return
+ * @param refs
+ * @param partitions
  */
-void sam_to_mgrec_phase2(Config& options, int nref, const std::vector<std::pair<std::string, size_t>>& refs);
+void sam_to_mgrec_phase2(Config& options, int nref, const std::vector<std::pair<std::string, size_t>>& refs,
+                         const PartitionMap& partitions);
 
 /**
  * @brief
@@ -92,38 +207,6 @@ void transcode_sam2mpg(Config& options);
  */
 void transcode_mpg2sam(Config& options);
 
-/**
- * @brief
- */
-class RefInfo {
- private:
-    std::unique_ptr<genie::core::ReferenceManager> refMgr;    //!< @brief
-    std::unique_ptr<genie::format::fasta::Manager> fastaMgr;  //!< @brief
-    std::unique_ptr<std::istream> fastaFile;                  //!< @brief
-    std::unique_ptr<std::istream> faiFile;                    //!< @brief
-    std::unique_ptr<std::istream> shaFile;                    //!< @brief
-    bool valid;                                               //!< @brief
-
- public:
-    /**
-     * @brief
-     * @param fasta_name
-     */
-    explicit RefInfo(const std::string& fasta_name);
-
-    /**
-     * @brief
-     * @return
-     */
-    bool isValid() const;
-
-    /**
-     * @brief
-     * @return
-     */
-    genie::core::ReferenceManager* getMgr();
-};
-
 // ---------------------------------------------------------------------------------------------------------------------
 
 }  // namespace sam_to_mgrec
@@ -109,6 +109,17 @@ class AccessUnit {
          */
         void push(uint64_t val);
 
+        /**
+         * @brief Append a range of symbols at once
+         * @tparam T Input type
+         * @tparam Func Callable mapping one input to one symbol
+         * @param begin First input
+         * @param end Behind the last input
+         * @param translate Mapping, e.g. an alphabet lookup
+         */
+        template <typename T, typename Func>
+        void push(const T* begin, const T* end, Func translate);
+
         /**
          * @brief
          * @param val
@@ -149,6 +160,17 @@ class AccessUnit {
          */
         uint64_t pull();
 
+        /**
+         * @brief Read a range of symbols at once
+         * @tparam T Output type
+         * @tparam Func Callable mapping one symbol to one output
+         * @param begin First output
+         * @param end Behind the last output
+         * @param translate Mapping, e.g. an alphabet lookup
+         */
+        template <typename T, typename Func>
+        void pull(T* begin, T* end, Func translate);
+
         /**
          * @brief
          * @return
@@ -609,6 +631,10 @@ class AccessUnit {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#include "genie/core/access-unit.impl.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 #endif  // SRC_GENIE_CORE_ACCESS_UNIT_H_
 
 // ---------------------------------------------------------------------------------------------------------------------
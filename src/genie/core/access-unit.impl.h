@@ -0,0 +1,48 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_CORE_ACCESS_UNIT_IMPL_H_
+#define SRC_GENIE_CORE_ACCESS_UNIT_IMPL_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename Func>
+void AccessUnit::Subsequence::push(const T* begin, const T* end, Func translate) {
+    data.appendTransformed(begin, end, translate);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename Func>
+void AccessUnit::Subsequence::pull(T* begin, T* end, Func translate) {
+    const auto count = static_cast<size_t>(end - begin);
+    if (position + count > data.size()) {
+        UTILS_DIE("Tried to read descriptor that has already ended");
+    }
+    data.extractTransformed(position, begin, end, translate);
+    position += count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_ACCESS_UNIT_IMPL_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
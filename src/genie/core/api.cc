@@ -5,6 +5,17 @@
  */
 
 #include "genie/core/api.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include "genie/core/cigar-tokenizer.h"
+#include "genie/core/flowgraph-decode.h"
+#include "genie/core/locus-filter.h"
+#include "genie/core/record-collector.h"
+#include "genie/core/record-filter.h"
+#include "genie/core/record/alignment_split/same-rec.h"
+#include "genie/core/statistics-decoder.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -96,31 +107,314 @@ std::string ExceptionBitstreamInvalid::msg() const {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief
+ * @param type Record class
+ * @return Index of the class in the class arrays of the API, which have no entry for ClassType::NONE
+ */
+static size_t classIndex(record::ClassType type) {
+    UTILS_DIE_IF(type == record::ClassType::NONE || uint8_t(type) > uint8_t(record::ClassType::COUNT),
+                 "Invalid record class");
+    return uint8_t(type) - 1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+StrandPaired getPairedStrand(Strand first, Strand second) {
+    if (first == Strand::UNMAPPED_UNKNOWN) {
+        return StrandPaired(uint8_t(second));
+    }
+    if (second == Strand::UNMAPPED_UNKNOWN) {
+        return StrandPaired(uint8_t(StrandPaired::FORWARD_UNMAPPED) + uint8_t(first) - 1);
+    }
+    return StrandPaired(uint8_t(StrandPaired::FORWARD_FORWARD) + (uint8_t(first) - 1) * 2 + uint8_t(second) - 1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool auMatches(const SimpleFilter& filter, record::ClassType auClass, uint16_t seqID, uint64_t startPos,
+               uint64_t endPos) {
+    if (!filter.classID[classIndex(auClass)]) {
+        return false;
+    }
+    if (auClass == record::ClassType::CLASS_U) {
+        return true;
+    }
+    return seqID == filter.sequenceID && startPos <= filter.endPos && endPos >= filter.startPos;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Strand of a segment
+ * @param rec Record
+ * @param segment Segment index in the record
+ * @return Strand, unmapped if the segment has no alignment in this record
+ */
+static Strand getStrand(const record::Record& rec, size_t segment) {
+    if (rec.getClassID() == record::ClassType::CLASS_U || rec.getAlignments().empty()) {
+        return Strand::UNMAPPED_UNKNOWN;
+    }
+    const auto& box = rec.getAlignments().front();
+    if (segment == 0) {
+        return box.getAlignment().getRComp() ? Strand::REVERSE : Strand::FORWARD;
+    }
+    if (box.getAlignmentSplits().size() < segment ||
+        box.getAlignmentSplits()[segment - 1]->getType() != record::AlignmentSplit::Type::SAME_REC) {
+        return Strand::UNMAPPED_UNKNOWN;
+    }
+    const auto& split = dynamic_cast<const record::alignment_split::SameRec&>(*box.getAlignmentSplits()[segment - 1]);
+    return split.getAlignment().getRComp() ? Strand::REVERSE : Strand::FORWARD;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Extended CIGAR of a segment in the primary alignment
+ * @param rec Record
+ * @param segment Segment index in the record
+ * @return ECIGAR, nullptr if the segment is not mapped in this record
+ */
+static const std::string* getECigar(const record::Record& rec, size_t segment) {
+    if (getStrand(rec, segment) == Strand::UNMAPPED_UNKNOWN) {
+        return nullptr;
+    }
+    const auto& box = rec.getAlignments().front();
+    if (segment == 0) {
+        return &box.getAlignment().getECigar();
+    }
+    return &dynamic_cast<const record::alignment_split::SameRec&>(*box.getAlignmentSplits()[segment - 1])
+                .getAlignment()
+                .getECigar();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool recordMatches(const SimpleFilter& filter, const record::Record& rec) {
+    if (!filter.classID[classIndex(rec.getClassID())]) {
+        return false;
+    }
+    if (!filter.groupNames.empty() &&
+        std::find(filter.groupNames.begin(), filter.groupNames.end(), rec.getGroup()) == filter.groupNames.end()) {
+        return false;
+    }
+    if (!filter.includeMultipleAlignments && rec.getAlignments().size() > 1) {
+        return false;
+    }
+    if (!filter.includeOpticalDuplicates && (rec.getFlags() & GenConst::FLAGS_PCR_DUPLICATE_MASK)) {
+        return false;
+    }
+    if (!filter.includeQualityCheckFailed && (rec.getFlags() & GenConst::FLAGS_QUALITY_FAIL_MASK)) {
+        return false;
+    }
+    if (rec.getClassID() != record::ClassType::CLASS_U) {
+        auto end = filter.endPos == std::numeric_limits<uint64_t>::max() ? filter.endPos : filter.endPos + 1;
+        if (!LocusFilter::overlaps(rec, static_cast<uint16_t>(filter.sequenceID), filter.startPos, end)) {
+            return false;
+        }
+    }
+
+    // Strand
+    auto first = getStrand(rec, 0);
+    if (rec.getNumberOfTemplateSegments() < 2) {
+        if (!filter.singleEndsStrand[uint8_t(first)]) {
+            return false;
+        }
+    } else if (!filter.pairedEndsStrand[uint8_t(getPairedStrand(first, getStrand(rec, 1)))]) {
+        return false;
+    }
+
+    // Clipping
+    for (size_t s = 0; s < rec.getSegments().size(); ++s) {
+        const auto* ecigar = getECigar(rec, s);
+        if (!ecigar) {
+            continue;
+        }
+        if ((!filter.includeClippedReads[uint8_t(ClipType::SOFT)] && ecigar->find('(') != std::string::npos) ||
+            (!filter.includeClippedReads[uint8_t(ClipType::HARD)] && ecigar->find('[') != std::string::npos)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @tparam T Range type
+ * @tparam V Value type
+ * @param range Inclusive range
+ * @param value Value
+ * @return True if the value is inside the range
+ */
+template <typename T, typename V>
+static bool inRange(const SegmentFilter::Range<T>& range, V value) {
+    return range.min <= value && value <= range.max;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool segmentsMatch(const SegmentFilter& filter, const record::Record& rec) {
+    for (size_t s = 0; s < rec.getSegments().size(); ++s) {
+        auto type = rec.getNumberOfTemplateSegments() < 2 ? SegmentType::SINGLE
+                                                           : (s == 0) == rec.isRead1First() ? SegmentType::FIRST
+                                                                                            : SegmentType::SECOND;
+        if (!filter.filterScope[uint8_t(type)]) {
+            continue;
+        }
+
+        uint64_t mapped = 0, substitutions = 0, insertions = 0, insertionsLength = 0, deletions = 0,
+                 deletionsLength = 0, splices = 0, splicesLength = 0;
+        if (const auto* ecigar = getECigar(rec, s)) {
+            CigarTokenizer::tokenize(*ecigar, getECigarInfo(),
+                                     [&](char op, const util::StringView& bases, const util::StringView& ref) {
+                                         switch (op) {
+                                             case '=':
+                                                 mapped += bases.length();
+                                                 break;
+                                             case '+':
+                                                 insertions++;
+                                                 insertionsLength += bases.length();
+                                                 break;
+                                             case '-':
+                                                 deletions++;
+                                                 deletionsLength += ref.length();
+                                                 break;
+                                             case '*':
+                                             case '/':
+                                             case '%':
+                                                 splices++;
+                                                 splicesLength += ref.length();
+                                                 break;
+                                             case ')':
+                                             case ']':
+                                                 break;
+                                             default:
+                                                 mapped += bases.length();
+                                                 substitutions += bases.length();
+                                                 break;
+                                         }
+                                         return true;
+                                     });
+        }
+        const auto length = static_cast<float>(std::max<size_t>(rec.getSegments()[s].getSequence().length(), 1));
+        const auto errors = substitutions + insertionsLength + deletionsLength;
+        if (!inRange(filter.mappedBasesRange, mapped) || !inRange(filter.mappedFractionRange, mapped / length) ||
+            !inRange(filter.errorsRange, errors) || !inRange(filter.errorsFractionRange, errors / length) ||
+            !inRange(filter.substitutionsRange, substitutions) ||
+            !inRange(filter.substitutionsFractionRange, substitutions / length) ||
+            !inRange(filter.insertionsRange, insertions) ||
+            !inRange(filter.insertionsFractionRange, insertions / length) ||
+            !inRange(filter.insertionsLengthRange, insertionsLength) ||
+            !inRange(filter.insertionsLengthFractionRange, insertionsLength / length) ||
+            !inRange(filter.deletionsRange, deletions) || !inRange(filter.deletionsFractionRange, deletions / length) ||
+            !inRange(filter.deletionsLengthRange, deletionsLength) ||
+            !inRange(filter.deletionsLengthFractionRange, deletionsLength / length) ||
+            !inRange(filter.splicesRange, splices) || !inRange(filter.splicesFractionRange, splices / length) ||
+            !inRange(filter.splicesLengthRange, splicesLength)) {
+            return false;
+        }
+
+        if (s == 0 && !rec.getAlignments().empty() &&
+            !rec.getAlignments().front().getAlignment().getMappingScores().empty() &&
+            !inRange(filter.alignmentScoreRange,
+                     rec.getAlignments().front().getAlignment().getMappingScores().front())) {
+            return false;
+        }
+
+        const auto& qualities = rec.getSegments()[s].getQualities();
+        if (!qualities.empty() && !qualities.front().empty()) {
+            const auto& qv = qualities.front();
+            auto sum = std::accumulate(qv.begin(), qv.end(), uint64_t(0),
+                                       [](uint64_t a, char c) { return a + static_cast<uint8_t>(c - 33); });
+            if (!inRange(filter.qualityScoreRange, sum / qv.length())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void GenieState::addDataset(uint64_t datasetGroupID, uint64_t datasetID, DecoderFactory factory) {
+    datasets[datasetGroupID][datasetID] = std::move(factory);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 Hierarchy GenieState::getHierarchy() {
-    // UTILS_DIE("Not implemented");
-    return Hierarchy{};
+    Hierarchy ret;
+    for (const auto& g : datasets) {
+        ret.groups.push_back({g.first, {}});
+        for (const auto& d : g.second) {
+            ret.groups.back().dataset_ids.push_back(d.first);
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<FlowGraphDecode> GenieState::buildDecoder(uint64_t datasetGroupID, uint64_t datasetID) {
+    auto group = datasets.find(datasetGroupID);
+    if (group == datasets.end()) {
+        throw ExceptionDatasetGroupNotFound(__FILE__, __FUNCTION__, __LINE__, std::to_string(datasetGroupID));
+    }
+    auto dataset = group->second.find(datasetID);
+    if (dataset == group->second.end()) {
+        throw ExceptionDatasetNotFound(__FILE__, __FUNCTION__, __LINE__, std::to_string(datasetID));
+    }
+    return dataset->second();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<Records> GenieState::query(uint64_t datasetGroupID, uint64_t datasetID, const SimpleFilter& filter,
+                                       const std::function<bool(const record::Record&)>& predicate) {
+    if (filter.includeAuxRecords) {
+        // The record model carries no optional fields, so there is nothing to decode them into
+        throw ExceptionParameterInvalid(__FILE__, __FUNCTION__, __LINE__, "Auxiliary records are not supported yet");
+    }
+    auto flow = buildDecoder(datasetGroupID, datasetID);
+    flow->setAUSelector([&filter](record::ClassType auClass, uint16_t seqID, uint64_t startPos, uint64_t endPos) {
+        return auMatches(filter, auClass, seqID, startPos, endPos);
+    });
+    std::vector<GenDesc> skipped;
+    if (!filter.includeReadNames) {
+        skipped.push_back(GenDesc::RNAME);
+    }
+    if (!filter.includeQualityValues) {
+        skipped.push_back(GenDesc::QV);
+    }
+    flow->setSkippedDescriptors(skipped);
+    flow->setRecordFilter(genie::util::make_unique<RecordFilter>([&filter, &predicate](const record::Record& r) {
+        return recordMatches(filter, r) && (!predicate || predicate(r));
+    }));
+    auto collector = genie::util::make_unique<RecordCollector>();
+    auto collectorPtr = collector.get();
+    flow->addExporter(std::move(collector));
+    flow->run();
+
+    return {Records{datasetGroupID, datasetID, collectorPtr->moveRecords(), {}}};
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::vector<Records> GenieState::getDataBySimpleFilter(uint64_t datasetGroupID, uint64_t datasetID,
                                                        const SimpleFilter& filter) {
-    (void)datasetGroupID;
-    (void)datasetID;
-    (void)filter;
-    // UTILS_DIE("Not implemented");
-    return std::vector<Records>();
+    return query(datasetGroupID, datasetID, filter, nullptr);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::vector<Records> GenieState::getDataByAdvancedFilter(uint64_t datasetGroupID, uint64_t datasetID,
                                                          const AdvancedFilter& filter) {
-    (void)datasetGroupID;
-    (void)datasetID;
-    (void)filter;
-    // UTILS_DIE("Not implemented");
-    return std::vector<Records>();
+    return query(datasetGroupID, datasetID, filter.filter, [&filter](const record::Record& r) {
+        return std::all_of(filter.segmentFilters.begin(), filter.segmentFilters.end(),
+                           [&r](const SegmentFilter& f) { return segmentsMatch(f, r); });
+    });
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -205,16 +499,40 @@ OutReference GenieState::getDatasetReference(uint64_t datasetGroupID, uint64_t d
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void GenieState::computeStatistics(uint64_t datasetGroupID, uint64_t datasetID, uint64_t sequenceID,
+                                   uint64_t startPos, uint64_t endPos, bool extended,
+                                   const std::function<void(StatisticsDecoder&)>& result) {
+    auto flow = buildDecoder(datasetGroupID, datasetID);
+    flow->setAUSelector([=](record::ClassType auClass, uint16_t seqID, uint64_t auStart, uint64_t auEnd) {
+        return auClass != record::ClassType::CLASS_U && seqID == sequenceID && auStart <= endPos &&
+               auEnd >= startPos;
+    });
+    std::vector<GenDesc> skipped = {GenDesc::RNAME};
+    if (!extended) {
+        skipped.push_back(GenDesc::QV);
+    }
+    flow->setSkippedDescriptors(skipped);
+
+    // All access units go to the statistics decoder instead of the read decoders of the dataset
+    auto decoder = genie::util::make_unique<StatisticsDecoder>(static_cast<uint16_t>(sequenceID), startPos, endPos,
+                                                                extended);
+    auto decoderPtr = decoder.get();
+    const auto index = flow->getNumReadCoders();
+    flow->addReadCoder(std::move(decoder));
+    flow->setReadCoderSelector([index](const AccessUnit&) { return index; });
+    flow->run();
+    result(*decoderPtr);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 std::vector<SimpleSegmentStatistics> GenieState::getSimpleStatistics(uint64_t datasetGroupID, uint64_t datasetID,
                                                                      uint64_t sequenceID, uint64_t startPos,
                                                                      uint64_t endPos) {
-    (void)datasetGroupID;
-    (void)datasetID;
-    (void)sequenceID;
-    (void)startPos;
-    (void)endPos;
-    // UTILS_DIE("Not implemented");
-    return std::vector<SimpleSegmentStatistics>();
+    std::vector<SimpleSegmentStatistics> ret;
+    computeStatistics(datasetGroupID, datasetID, sequenceID, startPos, endPos, false,
+                      [&ret](StatisticsDecoder& d) { ret.push_back(d.getSimpleStatistics()); });
+    return ret;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -222,13 +540,10 @@ std::vector<SimpleSegmentStatistics> GenieState::getSimpleStatistics(uint64_t da
 std::vector<AdvancedSegmentStatistics> GenieState::getAdvancedStatistics(uint64_t datasetGroupID, uint64_t datasetID,
                                                                          uint64_t sequenceID, uint64_t startPos,
                                                                          uint64_t endPos) {
-    (void)datasetGroupID;
-    (void)datasetID;
-    (void)sequenceID;
-    (void)startPos;
-    (void)endPos;
-    // UTILS_DIE("Not implemented");
-    return std::vector<AdvancedSegmentStatistics>();
+    std::vector<AdvancedSegmentStatistics> ret;
+    computeStatistics(datasetGroupID, datasetID, sequenceID, startPos, endPos, true,
+                      [&ret](StatisticsDecoder& d) { ret.push_back(d.getAdvancedStatistics()); });
+    return ret;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -11,6 +11,9 @@
 
 #include <array>
 #include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include "boost/variant/variant.hpp"
@@ -22,6 +25,10 @@
 
 namespace genie {
 namespace core {
+
+class FlowGraphDecode;
+class StatisticsDecoder;
+
 namespace api {
 
 /**
@@ -77,6 +84,8 @@ class ExceptionDecryptionFailed : public genie::util::RuntimeException {
  */
 class ExceptionDatasetGroupNotFound : public genie::util::RuntimeException {
  public:
+    using genie::util::RuntimeException::RuntimeException;
+
     /**
      * @brief
      * @return
@@ -89,6 +98,8 @@ class ExceptionDatasetGroupNotFound : public genie::util::RuntimeException {
  */
 class ExceptionDatasetNotFound : public genie::util::RuntimeException {
  public:
+    using genie::util::RuntimeException::RuntimeException;
+
     /**
      * @brief
      * @return
@@ -173,6 +184,8 @@ class ExceptionReferenceInvalid : public genie::util::RuntimeException {
  */
 class ExceptionParameterInvalid : public genie::util::RuntimeException {
  public:
+    using genie::util::RuntimeException::RuntimeException;
+
     /**
      * @brief
      * @return
@@ -418,7 +431,7 @@ struct AdvancedSegmentStatistics {
  */
 struct SimpleFilter {
     std::vector<std::string> groupNames;                                //!< @brief
-    std::array<bool, uint8_t(core::record::ClassType::COUNT)> classID;  //!< @brief
+    std::array<bool, uint8_t(core::record::ClassType::COUNT)> classID;  //!< @brief Indexed by class ID - 1
     uint64_t sequenceID;                                                //!< @brief
     uint64_t startPos;                                                  //!< @brief
     uint64_t endPos;                                                    //!< @brief
@@ -428,7 +441,7 @@ struct SimpleFilter {
     bool includeMultipleAlignments;                                     //!< @brief
     bool includeOpticalDuplicates;                                      //!< @brief
     bool includeQualityCheckFailed;                                     //!< @brief
-    bool includeAuxRecords;                                             //!< @brief
+    bool includeAuxRecords;                                             //!< @brief Not supported yet, must be false
     bool includeReadNames;                                              //!< @brief
     bool includeQualityValues;                                          //!< @brief
     bool mismatchesIncludeNs;                                           //!< @brief
@@ -479,11 +492,100 @@ struct AdvancedFilter {
     std::vector<SegmentFilter> segmentFilters;  //!< @brief
 };
 
+/**
+ * @brief
+ * @param first Strand of the first segment
+ * @param second Strand of the second segment
+ * @return Combined strand of a pair
+ */
+StrandPaired getPairedStrand(Strand first, Strand second);
+
+/**
+ * @brief Check the access unit header against a filter, to skip access units before reading their payload
+ * @param filter Filter
+ * @param auClass Class of the access unit
+ * @param seqID Reference sequence, ignored for class U
+ * @param startPos First mapping position, ignored for class U
+ * @param endPos Last mapping position (inclusive), ignored for class U
+ * @return False if no record of the access unit can match the filter
+ */
+bool auMatches(const SimpleFilter& filter, record::ClassType auClass, uint16_t seqID, uint64_t startPos,
+               uint64_t endPos);
+
+/**
+ * @brief Check a decoded record against a filter. The position range (inclusive) applies to mapped records, class U
+ * records are selected by class only.
+ * @param filter Filter
+ * @param rec Record
+ * @return True if the record is selected
+ */
+bool recordMatches(const SimpleFilter& filter, const record::Record& rec);
+
+/**
+ * @brief Check the segments of a record in the scope of a segment filter. The counts are taken from the primary
+ * alignment, unmapped segments have no mapped bases and no errors.
+ * @param filter Segment filter
+ * @param rec Record
+ * @return True if all segments in scope are within all ranges
+ */
+bool segmentsMatch(const SegmentFilter& filter, const record::Record& rec);
+
 /**
  * @brief
  */
 class GenieState {
  public:
+    /**
+     * @brief Builds the decoder of a dataset: importer, reference sources and decoders, but no exporter
+     */
+    using DecoderFactory = std::function<std::unique_ptr<FlowGraphDecode>()>;
+
+ private:
+    std::map<uint64_t, std::map<uint64_t, DecoderFactory>> datasets;  //!< @brief Decoders by group and dataset ID
+
+    /**
+     * @brief
+     * @param datasetGroupID Dataset group
+     * @param datasetID Dataset
+     * @return New decoder for the dataset
+     */
+    std::unique_ptr<FlowGraphDecode> buildDecoder(uint64_t datasetGroupID, uint64_t datasetID);
+
+    /**
+     * @brief Compute statistics of the aligned records overlapping a region from their descriptors, without decoding
+     * records
+     * @param datasetGroupID Dataset group
+     * @param datasetID Dataset
+     * @param sequenceID Reference sequence
+     * @param startPos First position
+     * @param endPos Last position
+     * @param extended If the extended statistics, including quality values, are needed
+     * @param result Receives the decoder holding the statistics after the run
+     */
+    void computeStatistics(uint64_t datasetGroupID, uint64_t datasetID, uint64_t sequenceID, uint64_t startPos,
+                           uint64_t endPos, bool extended, const std::function<void(StatisticsDecoder&)>& result);
+
+    /**
+     * @brief Decode the records of a dataset matching a filter. Access units are skipped by their header, read names
+     * and quality values are only decoded if requested and the records are filtered in the decoder threads.
+     * @param datasetGroupID Dataset group
+     * @param datasetID Dataset
+     * @param filter Filter
+     * @param predicate Additional condition for selected records, may be empty
+     * @return Records in stream order
+     */
+    std::vector<Records> query(uint64_t datasetGroupID, uint64_t datasetID, const SimpleFilter& filter,
+                               const std::function<bool(const record::Record&)>& predicate);
+
+ public:
+    /**
+     * @brief Make a dataset available to queries
+     * @param datasetGroupID Dataset group
+     * @param datasetID Dataset
+     * @param factory Builds a new decoder for each query
+     */
+    void addDataset(uint64_t datasetGroupID, uint64_t datasetID, DecoderFactory factory);
+
     /**
      * @brief
      * @return
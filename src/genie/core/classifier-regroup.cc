@@ -293,12 +293,44 @@ void ClassifierRegroup::add(record::Chunk&& c) {
             currentChunks[refBased][paired][(uint8_t)classtype - 1].getStats().add(chunk.getStats());
             movedStats = true;
         }
-        currentChunks[refBased][paired][(uint8_t)classtype - 1].getData().push_back(r);
+        if (!currentChunks[refBased][paired][(uint8_t)classtype - 1].getColumns().empty()) {
+            // Access units hold either columnar records or full records
+            queueFinishedChunk(currentChunks[refBased][paired][(uint8_t)classtype - 1]);
+        }
+        currentChunks[refBased][paired][(uint8_t)classtype - 1].getData().push_back(std::move(r));
         if (currentChunks[refBased][paired][(uint8_t)classtype - 1].getData().size() == auSize) {
             auto& classblock = currentChunks[refBased][paired][(uint8_t)classtype - 1];
             queueFinishedChunk(classblock);
         }
     }
+
+    // Columnar unaligned records are only cut into access units
+    auto& columns = chunk.getColumns();
+    if (!columns.empty()) {
+        bool paired = columns.getNumberOfTemplateSegments() > 1;
+        auto& classblock = currentChunks[false][paired][(uint8_t)core::record::ClassType::CLASS_U - 1];
+        if (!classblock.getData().empty()) {
+            queueFinishedChunk(classblock);
+        }
+        if (!movedStats) {
+            classblock.getStats().add(chunk.getStats());
+        }
+        if (classblock.getColumns().empty() && columns.size() == auSize) {
+            // Whole block, no copy
+            classblock.getColumns() = std::move(columns);
+            queueFinishedChunk(classblock);
+            return;
+        }
+        size_t pos = 0;
+        while (pos < columns.size()) {
+            size_t count = std::min(auSize - classblock.getColumns().size(), columns.size() - pos);
+            classblock.getColumns().append(columns, pos, count);
+            pos += count;
+            if (classblock.getColumns().size() == auSize) {
+                queueFinishedChunk(classblock);
+            }
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -307,7 +339,7 @@ void ClassifierRegroup::flush() {
     for (auto& refblock : currentChunks) {
         for (auto& pairblock : refblock) {
             for (auto& classblock : pairblock) {
-                if (classblock.getData().empty()) {
+                if (!classblock.getNumRecords()) {
                     continue;
                 }
                 queueFinishedChunk(classblock);
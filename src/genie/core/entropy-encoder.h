@@ -13,6 +13,7 @@
 #include "genie/core/access-unit.h"
 #include "genie/core/module.h"
 #include "genie/core/parameter/descriptor_present/decoder.h"
+#include "genie/util/drain.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -35,9 +36,17 @@ class EntropyEncoder {
     /**
      * @brief
      * @param desc
+     * @param records Section the access unit holds, the same for every run on the same input
      * @return
      */
-    virtual EntropyCoded process(core::AccessUnit::Descriptor& desc) = 0;
+    virtual EntropyCoded process(core::AccessUnit::Descriptor& desc, const util::Section& records) = 0;
+
+    /**
+     * @brief Pass over a section that does not become an access unit, so that coders keeping state across access
+     * units do not wait for it
+     * @param records Section
+     */
+    virtual void skip(const util::Section& records) { (void)records; }
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -35,9 +35,9 @@ genie::core::RefDecoder* FlowGraphDecode::getRefDecoder() { return refDecoder; }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-FlowGraphDecode::FlowGraphDecode(size_t threads) : mgr(threads) {
+FlowGraphDecode::FlowGraphDecode(size_t threads, uint64_t refCacheBytes) : mgr(threads) {
     readSelector.setDrain(&exporterSelector);
-    refMgr = genie::util::make_unique<ReferenceManager>(16);
+    refMgr = genie::util::make_unique<ReferenceManager>(refCacheBytes);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -66,6 +66,10 @@ void FlowGraphDecode::addReadCoder(std::unique_ptr<genie::core::ReadDecoder> dat
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+size_t FlowGraphDecode::getNumReadCoders() const { return readCoders.size(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void FlowGraphDecode::setReadCoder(std::unique_ptr<genie::core::ReadDecoder> dat, size_t index) {
     readCoders[index] = std::move(dat);
     readSelector.setBranch(readCoders[index].get(), readCoders[index].get(), index);
@@ -147,6 +151,30 @@ void FlowGraphDecode::setExporterSelector(const std::function<size_t(const genie
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void FlowGraphDecode::setRecordFilter(std::unique_ptr<Module<record::Chunk, record::Chunk>> filter) {
+    recordFilter = std::move(filter);
+    recordFilter->setDrain(&exporterSelector);
+    readSelector.setDrain(recordFilter.get());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FlowGraphDecode::setAUSelector(const FormatImporterCompressed::AUSelector& selector) {
+    for (auto& i : importers) {
+        i->setAUSelector(selector);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FlowGraphDecode::setSkippedDescriptors(const std::vector<GenDesc>& desc) {
+    for (auto& i : importers) {
+        i->setSkippedDescriptors(desc);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void FlowGraphDecode::addNameCoder(std::unique_ptr<genie::core::NameDecoder> dat) {
     nameCoders.emplace_back(std::move(dat));
     nameSelector.addMod(nameCoders.back().get());
@@ -191,6 +219,12 @@ core::stats::PerfStats FlowGraphDecode::getStats() {
     for (auto& e : exporters) {
         ret.add(e->getStats());
     }
+    auto cache = refMgr->getCacheStats();
+    if (cache.hits + cache.misses > 0) {
+        ret.addInteger("ref-cache-hits", cache.hits);
+        ret.addInteger("ref-cache-misses", cache.misses);
+        ret.addInteger("ref-cache-evictions", cache.evictions);
+    }
     return ret;
 }
 
@@ -16,8 +16,10 @@
 #include "genie/core/flowgraph.h"
 #include "genie/core/format-exporter.h"
 #include "genie/core/format-importer-compressed.h"
+#include "genie/core/module.h"
 #include "genie/core/read-decoder.h"
 #include "genie/core/ref-decoder.h"
+#include "genie/core/reference-manager.h"
 #include "genie/core/reference-source.h"
 #include "genie/util/selector.h"
 #include "genie/util/side-selector.h"
@@ -53,6 +55,7 @@ class FlowGraphDecode : public FlowGraph {
 
     std::vector<std::unique_ptr<genie::core::FormatExporter>> exporters;     //!< @brief
     genie::util::SelectorHead<genie::core::record::Chunk> exporterSelector;  //!< @brief
+    std::unique_ptr<Module<record::Chunk, record::Chunk>> recordFilter;      //!< @brief Optional query filter
 
  public:
     /**
@@ -82,8 +85,9 @@ class FlowGraphDecode : public FlowGraph {
     /**
      * @brief
      * @param threads
+     * @param refCacheBytes Memory budget of the reference chunk cache
      */
-    explicit FlowGraphDecode(size_t threads);
+    explicit FlowGraphDecode(size_t threads, uint64_t refCacheBytes = ReferenceManager::DEFAULT_CACHE_SIZE);
 
     /**
      * @brief
@@ -104,6 +108,12 @@ class FlowGraphDecode : public FlowGraph {
      */
     void addReadCoder(std::unique_ptr<genie::core::ReadDecoder> dat);
 
+    /**
+     * @brief
+     * @return Number of read decoders, the index of the next one added
+     */
+    size_t getNumReadCoders() const;
+
     /**
      * @brief
      * @param dat
@@ -171,6 +181,24 @@ class FlowGraphDecode : public FlowGraph {
      */
     void setExporterSelector(const std::function<size_t(const genie::core::record::Chunk&)>& fun);
 
+    /**
+     * @brief Only pass selected records to the exporters, e.g. the ones overlapping a locus
+     * @param filter Record filter, inserted between read decoders and exporters
+     */
+    void setRecordFilter(std::unique_ptr<Module<record::Chunk, record::Chunk>> filter);
+
+    /**
+     * @brief Let all importers skip access units by their header
+     * @param selector Access units to read
+     */
+    void setAUSelector(const FormatImporterCompressed::AUSelector& selector);
+
+    /**
+     * @brief Let all importers drop descriptors which are not needed
+     * @param desc Descriptors to skip
+     */
+    void setSkippedDescriptors(const std::vector<GenDesc>& desc);
+
     /**
      * @brief
      * @param dat
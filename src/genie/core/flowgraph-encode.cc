@@ -26,9 +26,9 @@ ReferenceManager& FlowGraphEncode::getRefMgr() { return *refMgr; }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-FlowGraphEncode::FlowGraphEncode(size_t threads) : mgr(threads) {
+FlowGraphEncode::FlowGraphEncode(size_t threads, uint64_t refCacheBytes) : mgr(threads) {
     readSelector.setDrain(&exporterSelector);
-    refMgr = genie::util::make_unique<ReferenceManager>(16);
+    refMgr = genie::util::make_unique<ReferenceManager>(refCacheBytes);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -161,7 +161,7 @@ void FlowGraphEncode::setNameSelector(std::function<size_t(const genie::core::re
 // ---------------------------------------------------------------------------------------------------------------------
 
 void FlowGraphEncode::setEntropyCoderSelector(
-    const std::function<size_t(const genie::core::AccessUnit::Descriptor&)>& fun) {
+    const std::function<size_t(const genie::core::AccessUnit::Descriptor&, const genie::util::Section&)>& fun) {
     entropySelector.setSelection(fun);
 }
 
@@ -193,6 +193,12 @@ core::stats::PerfStats FlowGraphEncode::getStats() {
     for (auto& e : exporters) {
         ret.add(e->getStats());
     }
+    auto cache = refMgr->getCacheStats();
+    if (cache.hits + cache.misses > 0) {
+        ret.addInteger("ref-cache-hits", cache.hits);
+        ret.addInteger("ref-cache-misses", cache.misses);
+        ret.addInteger("ref-cache-evictions", cache.evictions);
+    }
     return ret;
 }
 
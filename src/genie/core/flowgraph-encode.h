@@ -16,6 +16,7 @@
 #include "genie/core/format-exporter-compressed.h"
 #include "genie/core/format-importer.h"
 #include "genie/core/read-encoder.h"
+#include "genie/core/reference-manager.h"
 #include "genie/core/reference-source.h"
 #include "genie/util/thread-manager.h"
 
@@ -47,9 +48,7 @@ class FlowGraphEncode : public FlowGraph {
     genie::core::ReadEncoder::NameSelector nameSelector;                //!< @brief
 
     std::vector<std::unique_ptr<genie::core::EntropyEncoder>> entropyCoders;  //!< @brief
-    genie::util::SideSelector<genie::core::EntropyEncoder, genie::core::EntropyEncoder::EntropyCoded,
-                              genie::core::AccessUnit::Descriptor&>
-        entropySelector;  //!< @brief
+    genie::core::ReadEncoder::EntropySelector entropySelector;                //!< @brief
 
     std::vector<std::unique_ptr<genie::core::FormatExporterCompressed>> exporters;  //!< @brief
     genie::util::SelectorHead<genie::core::AccessUnit> exporterSelector;            //!< @brief
@@ -58,8 +57,9 @@ class FlowGraphEncode : public FlowGraph {
     /**
      * @brief
      * @param threads
+     * @param refCacheBytes Memory budget of the reference chunk cache
      */
-    explicit FlowGraphEncode(size_t threads);
+    explicit FlowGraphEncode(size_t threads, uint64_t refCacheBytes = ReferenceManager::DEFAULT_CACHE_SIZE);
 
     /**
      * @brief
@@ -179,7 +179,8 @@ class FlowGraphEncode : public FlowGraph {
      * @brief
      * @param fun
      */
-    void setEntropyCoderSelector(const std::function<size_t(const genie::core::AccessUnit::Descriptor&)>& fun);
+    void setEntropyCoderSelector(
+        const std::function<size_t(const genie::core::AccessUnit::Descriptor&, const genie::util::Section&)>& fun);
 
     /**
      * @brief
@@ -5,6 +5,7 @@
  */
 
 #include "genie/core/format-importer-compressed.h"
+#include <utility>
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -13,6 +14,14 @@ namespace core {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void FormatImporterCompressed::setAUSelector(AUSelector selector) { auSelector = std::move(selector); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FormatImporterCompressed::setSkippedDescriptors(std::vector<GenDesc> desc) { skippedDesc = std::move(desc); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void FormatImporterCompressed::flushIn(uint64_t& pos) { flushOut(pos); }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -9,6 +9,8 @@
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#include <functional>
+#include <vector>
 #include "genie/core/access-unit.h"
 #include "genie/util/original-source.h"
 #include "genie/util/source.h"
@@ -23,6 +25,31 @@ namespace core {
  */
 class FormatImporterCompressed : public util::Source<AccessUnit>, public util::OriginalSource {
  public:
+    /**
+     * @brief Decides from the access unit header if an access unit is read at all. Arguments are the class,
+     * reference sequence, first and last mapping position; the position arguments are 0 for class U.
+     */
+    using AUSelector = std::function<bool(record::ClassType, uint16_t, uint64_t, uint64_t)>;
+
+ protected:
+    AUSelector auSelector;             //!< @brief Access units to read, all if empty
+    std::vector<GenDesc> skippedDesc;  //!< @brief Descriptors dropped before entropy decoding
+
+ public:
+    /**
+     * @brief Only read access units accepted by the selector. Importers without random access may ignore it, so
+     * records still have to be filtered downstream.
+     * @param selector Selector
+     */
+    void setAUSelector(AUSelector selector);
+
+    /**
+     * @brief Drop descriptors from all access units before they are passed on, so they are never entropy decoded.
+     * Only descriptors the read decoders can do without (read names, quality values) may be skipped.
+     * @param desc Descriptors
+     */
+    void setSkippedDescriptors(std::vector<GenDesc> desc);
+
     /**
      * @brief
      */
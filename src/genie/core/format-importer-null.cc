@@ -13,7 +13,7 @@ namespace core {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-bool NullImporter::pumpRetrieve(Classifier*) { return false; }
+bool NullImporter::pumpRetrieve(record::Chunk*) { return false; }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
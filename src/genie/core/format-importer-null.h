@@ -22,10 +22,10 @@ class NullImporter : public FormatImporter {
  protected:
     /**
      * @brief
-     * @param _classifier
+     * @param _chunk Output block of records, left empty
      * @return
      */
-    bool pumpRetrieve(Classifier* _classifier) override;
+    bool pumpRetrieve(record::Chunk* _chunk) override;
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
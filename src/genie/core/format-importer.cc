@@ -21,34 +21,72 @@ void FormatImporter::setClassifier(Classifier* _classifier) { classifier = _clas
 bool FormatImporter::pump(uint64_t& id, std::mutex& lock) {
     record::Chunk chunk;
     util::Section sec{};
+    bool done = false;
     {
-        std::unique_lock<std::mutex> guard(lock);
+        // Hand out a finished access unit first
+        std::lock_guard<std::mutex> guard(classifierLock);
         chunk = classifier->getChunk();
-        uint32_t segment_count = 0;
-        for (const auto& r : chunk.getData()) {
-            segment_count += uint32_t(r.getSegments().size());
-        }
-        if (chunk.getData().empty()) {
-            segment_count = 1;
-        }
-        if (!chunk.getData().empty() || !chunk.getRefToWrite().empty()) {
+        if (chunk.getNumRecords() || !chunk.getRefToWrite().empty()) {
+            auto segment_count = uint32_t(chunk.getColumns().getNumberOfSegments());
+            for (const auto& r : chunk.getData()) {
+                segment_count += uint32_t(r.getSegments().size());
+            }
+            if (!chunk.getNumRecords()) {
+                segment_count = 1;
+            }
+            std::lock_guard<std::mutex> idGuard(lock);
             sec = {size_t(id), segment_count, true};
             id += segment_count;
         } else {
-            bool dataLeft = pumpRetrieve(classifier);
-            if (!dataLeft && !flushing) {
-                classifier->flush();
-                flushing = true;
-                return true;
-            }
-            if (!dataLeft && flushing) {
-                flushing = false;
-                return false;
-            }
+            done = flushing || failed;
         }
     }
-    if (!chunk.getData().empty() || !chunk.getRefToWrite().empty()) {
+    if (chunk.getNumRecords() || !chunk.getRefToWrite().empty()) {
         Source<record::Chunk>::flowOut(std::move(chunk), sec);
+        return true;
+    }
+    if (done) {
+        return false;
+    }
+
+    // Read the next block, the classifier stays available for other lanes meanwhile
+    record::Chunk block;
+    uint64_t ticket = 0;
+    bool haveBlock = false;
+    {
+        std::lock_guard<std::mutex> guard(inputLock);
+        if (!inputDone) {
+            const bool dataLeft = pumpRetrieve(&block);
+            ticket = readTickets++;
+            haveBlock = true;
+            if (!dataLeft) {
+                inputDone = true;
+            }
+        }
+    }
+
+    std::unique_lock<std::mutex> guard(classifierLock);
+    if (haveBlock) {
+        classifierCond.wait(guard, [this, ticket]() -> bool { return addedTickets == ticket || failed; });
+        if (failed) {
+            return false;
+        }
+        try {
+            classifier->add(std::move(block));
+        } catch (...) {
+            failed = true;
+            classifierCond.notify_all();
+            throw;
+        }
+        addedTickets++;
+        classifierCond.notify_all();
+    } else {
+        // Input is exhausted, wait for the blocks still being read by other lanes
+        classifierCond.wait(guard, [this]() -> bool { return addedTickets == readTickets || failed; });
+    }
+    if (inputDone && addedTickets == readTickets && !flushing && !failed) {
+        classifier->flush();
+        flushing = true;
     }
     return true;
 }
@@ -9,6 +9,9 @@
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include "genie/core/access-unit.h"
 #include "genie/core/classifier.h"
@@ -23,19 +26,30 @@ namespace core {
 
 /**
  * @brief Interface for importers of various file formats. Note that each importer has to convert to mpegg-records
+ *
+ * Import runs as a two stage pipeline: reading a block of input is serialized by the input lock, classifying it by
+ * the classifier lock. One lane can thus read the next block while another one classifies the previous one. Blocks
+ * carry a ticket, so that they reach the classifier in input order no matter which lane finishes reading first.
  */
 class FormatImporter : public util::OriginalSource, public util::Source<record::Chunk> {
  private:
-    Classifier* classifier;  //!< @brief
-    bool flushing{false};    //!< @brief
+    Classifier* classifier;                  //!< @brief
+    bool flushing{false};                    //!< @brief Classifier flushed at end of input, guarded by classifierLock
+    std::mutex inputLock;                    //!< @brief Serializes pumpRetrieve()
+    std::mutex classifierLock;               //!< @brief Serializes the classifier
+    std::condition_variable classifierCond;  //!< @brief Signals that a block was added to the classifier
+    std::atomic<uint64_t> readTickets{0};    //!< @brief Number of blocks read
+    uint64_t addedTickets{0};                //!< @brief Number of blocks added, guarded by classifierLock
+    std::atomic<bool> inputDone{false};      //!< @brief pumpRetrieve() reported the end of input
+    bool failed{false};                      //!< @brief A block could not be added, guarded by classifierLock
 
  protected:
     /**
-     * @brief
-     * @param _classifier
-     * @return
+     * @brief Read the next block of input. Calls are serialized, but may run concurrently to the classifier.
+     * @param chunk Output block of records
+     * @return False if the end of input was reached
      */
-    virtual bool pumpRetrieve(Classifier* _classifier) = 0;
+    virtual bool pumpRetrieve(record::Chunk* chunk) = 0;
 
  public:
     /**
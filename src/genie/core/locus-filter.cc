@@ -0,0 +1,89 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/core/locus-filter.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+LocusFilter::LocusFilter(uint16_t _seqID, Locus _locus) : seqID(_seqID), locus(std::move(_locus)) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint16_t LocusFilter::getSeqID() const { return seqID; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const Locus& LocusFilter::getLocus() const { return locus; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool LocusFilter::overlaps(uint16_t seq, uint64_t start, uint64_t end) const {
+    if (seq != seqID) {
+        return false;
+    }
+    if (!locus.positionPresent()) {
+        return true;
+    }
+    return start < locus.getEnd() && end >= locus.getStart();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool LocusFilter::overlaps(const record::Record& rec) const {
+    if (!locus.positionPresent()) {
+        return overlaps(rec, seqID, 0, std::numeric_limits<uint64_t>::max());
+    }
+    return overlaps(rec, seqID, locus.getStart(), locus.getEnd());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool LocusFilter::overlaps(const record::Record& rec, uint16_t seq, uint64_t start, uint64_t end) {
+    if (rec.getClassID() == record::ClassType::CLASS_U || rec.getAlignmentSharedData().getSeqID() != seq) {
+        return false;
+    }
+    for (size_t a = 0; a < rec.getAlignments().size(); ++a) {
+        const auto& splits = rec.getAlignments()[a].getAlignmentSplits();
+        for (size_t s = 0; s <= splits.size(); ++s) {
+            // Other segments may be mapped to a different sequence, they don't carry a position here
+            if (s > 0 && splits[s - 1]->getType() != record::AlignmentSplit::Type::SAME_REC) {
+                continue;
+            }
+            uint64_t pos = rec.getPosition(a, s);
+            uint64_t length = std::max<uint64_t>(rec.getMappedLength(a, s), 1);
+            if (pos < end && pos + length > start) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void LocusFilter::flowIn(record::Chunk&& t, const util::Section& id) {
+    auto chunk = std::move(t);
+    auto& data = chunk.getData();
+    data.erase(std::remove_if(data.begin(), data.end(), [this](const record::Record& r) { return !overlaps(r); }),
+               data.end());
+    flowOut(std::move(chunk), id);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_CORE_LOCUS_FILTER_H_
+#define SRC_GENIE_CORE_LOCUS_FILTER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include "genie/core/locus.h"
+#include "genie/core/module.h"
+#include "genie/core/record/chunk.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+/**
+ * @brief Drops all records not overlapping a locus. Access units are selected by their position range only, so
+ * they usually contain records on both sides of the locus borders.
+ */
+class LocusFilter : public Module<record::Chunk, record::Chunk> {
+ private:
+    uint16_t seqID;  //!< @brief Numeric ID of the locus reference sequence
+    Locus locus;     //!< @brief Region to keep
+
+ public:
+    /**
+     * @brief
+     * @param _seqID Numeric ID of the reference sequence the locus name refers to
+     * @param _locus Region to keep, end is exclusive
+     */
+    LocusFilter(uint16_t _seqID, Locus _locus);
+
+    /**
+     * @brief
+     * @return Numeric ID of the locus reference sequence
+     */
+    uint16_t getSeqID() const;
+
+    /**
+     * @brief
+     * @return Region to keep
+     */
+    const Locus& getLocus() const;
+
+    /**
+     * @brief Check a position range, e.g. of an access unit
+     * @param seq Reference sequence
+     * @param start First position
+     * @param end Last position (inclusive)
+     * @return True if the range overlaps the locus
+     */
+    bool overlaps(uint16_t seq, uint64_t start, uint64_t end) const;
+
+    /**
+     * @brief Check if any segment of a record is mapped into the locus. Unmapped records never overlap.
+     * @param rec Record
+     * @return True if the record overlaps the locus
+     */
+    bool overlaps(const record::Record& rec) const;
+
+    /**
+     * @brief Check if any segment of a record is mapped into a range. Unmapped records never overlap.
+     * @param rec Record
+     * @param seq Reference sequence
+     * @param start First position
+     * @param end Position after the last one
+     * @return True if the record overlaps the range
+     */
+    static bool overlaps(const record::Record& rec, uint16_t seq, uint64_t start, uint64_t end);
+
+    /**
+     * @brief Remove all records not overlapping the locus and pass on the chunk
+     * @param t Chunk
+     * @param id Section
+     */
+    void flowIn(record::Chunk&& t, const util::Section& id) override;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_LOCUS_FILTER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
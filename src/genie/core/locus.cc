@@ -51,7 +51,8 @@ Locus Locus::fromString(const std::string& string) {
     } else if (tok.size() == NUM_START_END) {
         auto pos = util::tokenize(tok.back(), '-');  // Sequence + position
         UTILS_DIE_IF(pos.size() != NUM_START_END, "Invalid locus");
-        return Locus(tok.front(), static_cast<uint32_t>(std::stoi(pos[0])), static_cast<uint32_t>(std::stoi(pos[1])));
+        return Locus(tok.front(), static_cast<uint32_t>(std::stoul(pos[0])),
+                     static_cast<uint32_t>(std::stoul(pos[1])));
     } else {
         UTILS_DIE("Invalid locus");
     }
@@ -6,6 +6,8 @@
 
 #include "genie/core/read-decoder.h"
 #include <utility>
+#include "genie/util/make-unique.h"
+#include "genie/util/runtime-exception.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -44,6 +46,69 @@ AccessUnit ReadDecoder::entropyCodeAU(AccessUnit&& a, bool mmCoderEnabled) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+ReadDecoder::PendingAU::PendingAU(AccessUnit&& t, const util::Section& _id) : au(std::move(t)), id(_id) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadDecoder::decodeRecords(AccessUnit&&, const util::Section&) {
+    UTILS_DIE("Decode-ahead not supported by this decoder");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadDecoder::decodeAhead(AccessUnit&& t, const util::Section& id) {
+    if (!decodeAheadFlag) {
+        decodeRecords(entropyCodeAU(std::move(t), true), id);
+        return;
+    }
+
+    auto next = util::make_unique<PendingAU>(std::move(t), id);
+    auto* n = next.get();
+    next->group.run([this, n]() { n->au = entropyCodeAU(std::move(n->au), true); });
+    {
+        std::lock_guard<std::mutex> guard(aheadLock);
+        std::swap(next, pending);
+    }
+    if (next) {
+        next->group.wait();
+        decodeRecords(std::move(next->au), next->id);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadDecoder::finishPending() {
+    std::unique_ptr<PendingAU> last;
+    {
+        std::lock_guard<std::mutex> guard(aheadLock);
+        std::swap(last, pending);
+    }
+    if (last) {
+        last->group.wait();
+        decodeRecords(std::move(last->au), last->id);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadDecoder::setDecodeAhead(bool flag) { decodeAheadFlag = flag; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadDecoder::skipIn(const util::Section& id) {
+    finishPending();
+    Module<AccessUnit, record::Chunk>::skipIn(id);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadDecoder::flushIn(uint64_t& pos) {
+    finishPending();
+    Module<AccessUnit, record::Chunk>::flushIn(pos);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace core
 }  // namespace genie
 
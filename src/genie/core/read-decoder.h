@@ -9,6 +9,8 @@
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -21,6 +23,7 @@
 #include "genie/util/selector.h"
 #include "genie/util/side-selector.h"
 #include "genie/util/source.h"
+#include "genie/util/task-scheduler.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -46,7 +49,69 @@ class ReadDecoder : public Module<AccessUnit, record::Chunk> {
     NameSelector* namecoder{};        //!< @brief
     EntropySelector* entropycoder{};  //!< @brief
 
+    /**
+     * @brief Reconstruct the records of an entropy decoded access unit and pass them on. Decoders supporting
+     * decode-ahead override this and call decodeAhead() in flowIn().
+     * @param t Entropy decoded access unit
+     * @param id Section of the access unit
+     */
+    virtual void decodeRecords(AccessUnit&& t, const util::Section& id);
+
+    /**
+     * @brief Entropy decode an access unit and pass it to decodeRecords(). In decode-ahead mode, entropy decoding of
+     * the access unit is only started as a background task, while the records of the previously started access unit
+     * are reconstructed.
+     * @param t Access unit
+     * @param id Section of the access unit
+     */
+    void decodeAhead(AccessUnit&& t, const util::Section& id);
+
+ private:
+    /**
+     * @brief Access unit being entropy decoded in the background
+     */
+    struct PendingAU {
+        AccessUnit au;          //!< @brief Access unit, entropy decoded in place
+        util::Section id;       //!< @brief Section of the access unit
+        util::TaskGroup group;  //!< @brief Background entropy decoding task
+
+        /**
+         * @brief
+         * @param t Access unit
+         * @param _id Section of the access unit
+         */
+        PendingAU(AccessUnit&& t, const util::Section& _id);
+    };
+
+    bool decodeAheadFlag{false};         //!< @brief If decode-ahead is enabled
+    std::mutex aheadLock;                //!< @brief Protects the pending access unit
+    std::unique_ptr<PendingAU> pending;  //!< @brief Access unit started by the last call to decodeAhead()
+
+    /**
+     * @brief Wait for the pending access unit, if any, and reconstruct its records
+     */
+    void finishPending();
+
  public:
+    /**
+     * @brief Enable decode-ahead. A pending access unit is reconstructed at the latest when the next access unit
+     * arrives, is skipped or the stream is flushed.
+     * @param flag If decode-ahead should be enabled
+     */
+    void setDecodeAhead(bool flag);
+
+    /**
+     * @brief Finish the pending access unit, then pass the skip on
+     * @param id Skipped section
+     */
+    void skipIn(const util::Section& id) override;
+
+    /**
+     * @brief Finish the pending access unit, then pass the flush on
+     * @param pos Position
+     */
+    void flushIn(uint64_t& pos) override;
+
     /**
      * @brief
      * @param coder
@@ -5,9 +5,12 @@
  */
 
 #include "genie/core/read-encoder.h"
+#include <algorithm>
 #include <atomic>
 #include <fstream>
 #include <utility>
+#include <vector>
+#include "genie/util/task-scheduler.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -30,7 +33,8 @@ void ReadEncoder::setEntropyCoder(EntropySelector* coder) { entropycoder = coder
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-AccessUnit ReadEncoder::entropyCodeAU(EntropySelector* _entropycoder, AccessUnit&& a, bool write_raw) {
+AccessUnit ReadEncoder::entropyCodeAU(EntropySelector* _entropycoder, AccessUnit&& a, bool write_raw,
+                                      const util::Section& records, const std::vector<GenDesc>& later) {
     AccessUnit au = std::move(a);
     if (write_raw) {
         static std::atomic<uint64_t> id(0);
@@ -47,19 +51,60 @@ AccessUnit ReadEncoder::entropyCodeAU(EntropySelector* _entropycoder, AccessUnit
             }
         }
     }
+    // Descriptors are independent, so idle threads may steal their entropy coding
+    auto isLater = [&later](GenDesc desc) { return std::find(later.begin(), later.end(), desc) != later.end(); };
+    std::vector<EntropyEncoder::EntropyCoded> encoded(au.end() - au.begin());
+    {
+        util::TaskGroup group;
+        auto* result = encoded.data();
+        for (auto& d : au) {
+            auto* desc = &d;
+            if (!isLater(d.getID())) {
+                group.run(
+                    [_entropycoder, desc, result, &records]() { *result = _entropycoder->process(*desc, records); });
+            }
+            result++;
+        }
+        group.wait();
+    }
+    auto* result = encoded.data();
     for (auto& d : au) {
-        auto encoded = _entropycoder->process(d);
-        au.getParameters().setDescriptor(d.getID(), std::move(std::get<0>(encoded)));
-        au.set(d.getID(), std::move(std::get<1>(encoded)));
-        au.getStats().add(std::get<2>(encoded));
+        if (isLater(d.getID())) {
+            result++;
+            continue;
+        }
+        au.getParameters().setDescriptor(d.getID(), std::move(std::get<0>(*result)));
+        au.set(d.getID(), std::move(std::get<1>(*result)));
+        au.getStats().add(std::get<2>(*result));
+        result++;
     }
     return au;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-AccessUnit ReadEncoder::entropyCodeAU(AccessUnit&& a) {
-    return entropyCodeAU(entropycoder, std::move(a), writeOutStreams);
+AccessUnit ReadEncoder::entropyCodeAU(AccessUnit&& a, const util::Section& id) {
+    return entropyCodeAU(entropycoder, std::move(a), writeOutStreams, id);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadEncoder::skipEntropyCoding(const util::Section& id) {
+    if (!entropycoder) {
+        return;
+    }
+    for (auto* coder : entropycoder->getMods()) {
+        coder->skip(id);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadEncoder::skipIn(const util::Section& id) {
+    if (id.strongSkip) {
+        skipEntropyCoding(id);
+    }
+    skipOut(id);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
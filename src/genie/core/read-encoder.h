@@ -10,6 +10,7 @@
 // ---------------------------------------------------------------------------------------------------------------------
 
 #include <tuple>
+#include <vector>
 #include "genie/core/access-unit.h"
 #include "genie/core/entropy-encoder.h"
 #include "genie/core/module.h"
@@ -33,8 +34,8 @@ class ReadEncoder : public Module<record::Chunk, AccessUnit> {
     using QvSelector = util::SideSelector<QVEncoder, QVEncoder::QVCoded, const record::Chunk&>;  //!< @brief
     using NameSelector = util::SideSelector<NameEncoder, std::tuple<AccessUnit::Descriptor, core::stats::PerfStats>,
                                             const record::Chunk&>;  //!< @brief
-    using EntropySelector =
-        util::SideSelector<EntropyEncoder, EntropyEncoder::EntropyCoded, AccessUnit::Descriptor&>;  //!< @brief
+    using EntropySelector = util::SideSelector<EntropyEncoder, EntropyEncoder::EntropyCoded, AccessUnit::Descriptor&,
+                                               const util::Section&>;  //!< @brief
 
  protected:
     QvSelector* qvcoder{};            //!< @brief
@@ -66,16 +67,32 @@ class ReadEncoder : public Module<record::Chunk, AccessUnit> {
      * @param _entropycoder
      * @param a
      * @param write_raw
+     * @param records Section the access unit holds
+     * @param later Descriptors that are entropy coded separately later, they are left untouched
      * @return
      */
-    static AccessUnit entropyCodeAU(EntropySelector* _entropycoder, AccessUnit&& a, bool write_raw);
+    static AccessUnit entropyCodeAU(EntropySelector* _entropycoder, AccessUnit&& a, bool write_raw,
+                                    const util::Section& records, const std::vector<GenDesc>& later = {});
 
     /**
      * @brief
      * @param a
+     * @param id Section the access unit was generated from
      * @return
      */
-    AccessUnit entropyCodeAU(AccessUnit&& a);
+    AccessUnit entropyCodeAU(AccessUnit&& a, const util::Section& id);
+
+    /**
+     * @brief Tell the entropy coders that a section does not become an access unit here
+     * @param id
+     */
+    void skipEntropyCoding(const util::Section& id);
+
+    /**
+     * @brief Pass strong skips to the entropy coders, weak skips are sections another read encoder takes care of
+     * @param id
+     */
+    void skipIn(const util::Section& id) override;
 
     /**
      * @brief For polymorphic destruction
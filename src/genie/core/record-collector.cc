@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/core/record-collector.h"
+#include <iterator>
+#include <utility>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void RecordCollector::flowIn(record::Chunk&& t, const util::Section& id) {
+    auto chunk = std::move(t);
+    std::lock_guard<std::mutex> guard(lock);
+    auto& records = chunks[id.start];
+    records.insert(records.end(), std::make_move_iterator(chunk.getData().begin()),
+                   std::make_move_iterator(chunk.getData().end()));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<record::Record> RecordCollector::moveRecords() {
+    std::lock_guard<std::mutex> guard(lock);
+    std::vector<record::Record> ret;
+    for (auto& c : chunks) {
+        ret.insert(ret.end(), std::make_move_iterator(c.second.begin()), std::make_move_iterator(c.second.end()));
+    }
+    chunks.clear();
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,55 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_CORE_RECORD_COLLECTOR_H_
+#define SRC_GENIE_CORE_RECORD_COLLECTOR_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include "genie/core/format-exporter.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+/**
+ * @brief Exporter keeping all records in memory, e.g. to answer API queries
+ */
+class RecordCollector : public FormatExporter {
+ private:
+    std::mutex lock;                                       //!< @brief Protects chunks
+    std::map<size_t, std::vector<record::Record>> chunks;  //!< @brief Records by start of their section
+
+ public:
+    /**
+     * @brief
+     * @param t Records
+     * @param id Section
+     */
+    void flowIn(record::Chunk&& t, const util::Section& id) override;
+
+    /**
+     * @brief Hand over all records received so far
+     * @return Records in stream order
+     */
+    std::vector<record::Record> moveRecords();
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_RECORD_COLLECTOR_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,36 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/core/record-filter.h"
+#include <algorithm>
+#include <utility>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+RecordFilter::RecordFilter(Predicate _predicate) : predicate(std::move(_predicate)) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void RecordFilter::flowIn(record::Chunk&& t, const util::Section& id) {
+    auto chunk = std::move(t);
+    auto& data = chunk.getData();
+    data.erase(std::remove_if(data.begin(), data.end(), [this](const record::Record& r) { return !predicate(r); }),
+               data.end());
+    flowOut(std::move(chunk), id);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_CORE_RECORD_FILTER_H_
+#define SRC_GENIE_CORE_RECORD_FILTER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <functional>
+#include "genie/core/module.h"
+#include "genie/core/record/chunk.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+/**
+ * @brief Drops all records not accepted by a predicate. Runs in the thread of the access unit, so predicates of
+ * different access units are evaluated in parallel.
+ */
+class RecordFilter : public Module<record::Chunk, record::Chunk> {
+ public:
+    using Predicate = std::function<bool(const record::Record&)>;  //!< @brief True for records to keep
+
+ private:
+    Predicate predicate;  //!< @brief Records to keep, must be thread safe
+
+ public:
+    /**
+     * @brief
+     * @param _predicate Records to keep, must be thread safe
+     */
+    explicit RecordFilter(Predicate _predicate);
+
+    /**
+     * @brief Remove all rejected records and pass on the chunk
+     * @param t Chunk
+     * @param id Section
+     */
+    void flowIn(record::Chunk&& t, const util::Section& id) override;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_RECORD_FILTER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
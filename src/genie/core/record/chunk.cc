@@ -16,6 +16,28 @@ namespace record {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+ReadColumns& Chunk::getColumns() { return columns; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const ReadColumns& Chunk::getColumns() const { return columns; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t Chunk::getNumRecords() const { return data.size() + columns.size(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Chunk::expandColumns() {
+    data.reserve(data.size() + columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        data.emplace_back(columns.getRecord(i));
+    }
+    columns = ReadColumns();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 ReferenceManager::ReferenceExcerpt& Chunk::getRef() { return reference; }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 
 #include <utility>
 #include <vector>
+#include "genie/core/record/read-columns.h"
 #include "genie/core/record/record.h"
 #include "genie/core/reference-manager.h"
 
@@ -26,6 +27,7 @@ namespace record {
 class Chunk {
  private:
     std::vector<Record> data;                           //!< @brief
+    ReadColumns columns;                                //!< @brief Unaligned records stored by column
     ReferenceManager::ReferenceExcerpt reference;       //!< @brief
     std::vector<std::pair<size_t, size_t>> refToWrite;  //!< @brief
     size_t refID{};                                     //!< @brief
@@ -39,6 +41,30 @@ class Chunk {
      */
     std::vector<Record>& getData();
 
+    /**
+     * @brief Unaligned records stored by column. Producers fill either these or getData() for one class of records,
+     * consumers which only work on records call expandColumns() first.
+     * @return Columnar records
+     */
+    ReadColumns& getColumns();
+
+    /**
+     * @brief
+     * @return Columnar records
+     */
+    const ReadColumns& getColumns() const;
+
+    /**
+     * @brief
+     * @return Number of records in getData() and getColumns()
+     */
+    size_t getNumRecords() const;
+
+    /**
+     * @brief Move the columnar records to getData() as full records
+     */
+    void expandColumns();
+
     /**
      * @brief
      * @return
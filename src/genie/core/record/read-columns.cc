@@ -0,0 +1,210 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/core/record/read-columns.h"
+#include <string>
+#include <utility>
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+namespace record {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Grow a buffer and return the new part
+ * @param buffer Buffer
+ * @param ends End offsets of the entries, the new one is appended
+ * @param length Length of the new entry
+ * @return Storage for the new entry
+ */
+static char* appendEntry(std::string& buffer, std::vector<uint64_t>& ends, size_t length) {
+    size_t start = buffer.size();
+    buffer.resize(start + length);
+    ends.push_back(buffer.size());
+    return &buffer[0] + start;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param buffer Buffer
+ * @param ends End offsets of the entries
+ * @param index Entry
+ * @return View of the entry
+ */
+static util::StringView getEntry(const std::string& buffer, const std::vector<uint64_t>& ends, size_t index) {
+    return {index ? ends[index - 1] : 0, ends[index], buffer.data()};
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param dst Buffer to append to
+ * @param dstEnds End offsets to append to
+ * @param src Buffer to append from
+ * @param srcEnds End offsets to append from
+ * @param first First entry to append
+ * @param count Number of entries to append
+ */
+static void appendRange(std::string& dst, std::vector<uint64_t>& dstEnds, const std::string& src,
+                        const std::vector<uint64_t>& srcEnds, size_t first, size_t count) {
+    if (!count) {
+        return;
+    }
+    auto start = first ? srcEnds[first - 1] : 0;
+    auto offset = dst.size();
+    dst.append(src, start, srcEnds[first + count - 1] - start);
+    dstEnds.reserve(dstEnds.size() + count);
+    for (size_t i = first; i < first + count; ++i) {
+        dstEnds.push_back(srcEnds[i] - start + offset);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint8_t ReadColumns::getNumberOfTemplateSegments() const { return numberOfTemplateSegments; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadColumns::setNumberOfTemplateSegments(uint8_t num) {
+    UTILS_DIE_IF(!empty() && num != numberOfTemplateSegments, "Number of segments changed in non-empty columns");
+    numberOfTemplateSegments = num;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadColumns::reserve(size_t records, size_t bases, size_t nameLength) {
+    names.reserve(nameLength);
+    nameEnds.reserve(records);
+    flags.reserve(records);
+    sequences.reserve(bases);
+    sequenceEnds.reserve(records * numberOfTemplateSegments);
+    qualities.reserve(bases);
+    qualityEnds.reserve(records * numberOfTemplateSegments);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t ReadColumns::size() const { return nameEnds.size(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool ReadColumns::empty() const { return nameEnds.empty(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t ReadColumns::getNumberOfSegments() const { return sequenceEnds.size(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadColumns::clear() {
+    names.clear();
+    nameEnds.clear();
+    flags.clear();
+    sequences.clear();
+    sequenceEnds.clear();
+    qualities.clear();
+    qualityEnds.clear();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+char* ReadColumns::addRecord(size_t nameLength, uint8_t _flags) {
+    flags.push_back(_flags);
+    return appendEntry(names, nameEnds, nameLength);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadColumns::setFlags(uint8_t _flags) { flags.back() = _flags; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+char* ReadColumns::addSequence(size_t length) {
+    qualityEnds.push_back(qualities.size());
+    return appendEntry(sequences, sequenceEnds, length);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+char* ReadColumns::addQualities(size_t length) {
+    qualityEnds.pop_back();
+    return appendEntry(qualities, qualityEnds, length);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReadColumns::append(const ReadColumns& other, size_t first, size_t count) {
+    UTILS_DIE_IF(!empty() && other.numberOfTemplateSegments != numberOfTemplateSegments,
+                 "Appending columns with a different number of segments");
+    numberOfTemplateSegments = other.numberOfTemplateSegments;
+    auto segments = size_t(numberOfTemplateSegments);
+    appendRange(names, nameEnds, other.names, other.nameEnds, first, count);
+    flags.insert(flags.end(), other.flags.begin() + first, other.flags.begin() + first + count);
+    appendRange(sequences, sequenceEnds, other.sequences, other.sequenceEnds, first * segments, count * segments);
+    appendRange(qualities, qualityEnds, other.qualities, other.qualityEnds, first * segments, count * segments);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+util::StringView ReadColumns::getName(size_t record) const { return getEntry(names, nameEnds, record); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint8_t ReadColumns::getFlags(size_t record) const { return flags[record]; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+util::StringView ReadColumns::getSequence(size_t segment) const {
+    return getEntry(sequences, sequenceEnds, segment);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+util::StringView ReadColumns::getQualities(size_t segment) const {
+    return getEntry(qualities, qualityEnds, segment);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+Record ReadColumns::getRecord(size_t record) const {
+    auto name = getName(record);
+    Record ret(numberOfTemplateSegments, ClassType::CLASS_U, std::string(name.begin(), name.end()), "",
+               getFlags(record));
+    size_t first = record * numberOfTemplateSegments;
+    size_t last = first + numberOfTemplateSegments;
+
+    // All segments of a record have the same quality value depth, empty segments have empty quality values
+    bool hasQualities = false;
+    for (size_t s = first; s < last; ++s) {
+        hasQualities = hasQualities || getQualities(s).length();
+    }
+    for (size_t s = first; s < last; ++s) {
+        auto seq = getSequence(s);
+        auto qual = getQualities(s);
+        Segment seg(std::string(seq.begin(), seq.end()));
+        if (hasQualities) {
+            seg.addQualities(std::string(qual.begin(), qual.end()));
+        }
+        ret.addSegment(std::move(seg));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace record
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_CORE_RECORD_READ_COLUMNS_H_
+#define SRC_GENIE_CORE_RECORD_READ_COLUMNS_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "genie/core/record/record.h"
+#include "genie/util/stringview.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+namespace record {
+
+/**
+ * @brief Unaligned (class U) records of a chunk stored column by column. Names, sequences and quality values of all
+ * records are kept back to back in one buffer each, so a block costs a handful of allocations instead of several per
+ * record. All records carry the same number of segments and at most one quality value string per segment.
+ *
+ * Views returned by the getters point into the buffers and are invalidated when records are added.
+ */
+class ReadColumns {
+ private:
+    uint8_t numberOfTemplateSegments{1};  //!< @brief Segments per record
+    std::string names;                    //!< @brief Read names
+    std::vector<uint64_t> nameEnds;       //!< @brief End of each name in names
+    std::vector<uint8_t> flags;           //!< @brief Flags of each record
+    std::string sequences;                //!< @brief Sequences
+    std::vector<uint64_t> sequenceEnds;   //!< @brief End of each segment in sequences
+    std::string qualities;                //!< @brief Quality values
+    std::vector<uint64_t> qualityEnds;    //!< @brief End of each segment in qualities, unchanged if there are none
+
+ public:
+    /**
+     * @brief
+     * @return Segments per record
+     */
+    uint8_t getNumberOfTemplateSegments() const;
+
+    /**
+     * @brief Set the number of segments per record. Only allowed while empty.
+     * @param num Segments per record
+     */
+    void setNumberOfTemplateSegments(uint8_t num);
+
+    /**
+     * @brief Allocate the buffers for a block up front
+     * @param records Number of records
+     * @param bases Total length of all sequences
+     * @param nameLength Total length of all names
+     */
+    void reserve(size_t records, size_t bases, size_t nameLength);
+
+    /**
+     * @brief
+     * @return Number of records
+     */
+    size_t size() const;
+
+    /**
+     * @brief
+     * @return True if there are no records
+     */
+    bool empty() const;
+
+    /**
+     * @brief
+     * @return Number of segments of all records
+     */
+    size_t getNumberOfSegments() const;
+
+    /**
+     * @brief Remove all records, keeping the memory
+     */
+    void clear();
+
+    /**
+     * @brief Start a new record, its segments follow
+     * @param nameLength Length of the read name
+     * @param _flags Record flags
+     * @return Storage for the read name
+     */
+    char* addRecord(size_t nameLength, uint8_t _flags = 0);
+
+    /**
+     * @brief Set the flags of the last record
+     * @param _flags Record flags
+     */
+    void setFlags(uint8_t _flags);
+
+    /**
+     * @brief Start a new segment of the last record
+     * @param length Sequence length
+     * @return Storage for the sequence
+     */
+    char* addSequence(size_t length);
+
+    /**
+     * @brief Attach quality values to the last segment
+     * @param length Number of quality values, equal to the sequence length
+     * @return Storage for the quality values
+     */
+    char* addQualities(size_t length);
+
+    /**
+     * @brief Append records of another set with the same number of segments
+     * @param other Records to append
+     * @param first First record to append
+     * @param count Number of records to append
+     */
+    void append(const ReadColumns& other, size_t first, size_t count);
+
+    /**
+     * @brief
+     * @param record Record index
+     * @return Read name
+     */
+    util::StringView getName(size_t record) const;
+
+    /**
+     * @brief
+     * @param record Record index
+     * @return Flags
+     */
+    uint8_t getFlags(size_t record) const;
+
+    /**
+     * @brief
+     * @param segment Segment index, counted over all records
+     * @return Sequence
+     */
+    util::StringView getSequence(size_t segment) const;
+
+    /**
+     * @brief
+     * @param segment Segment index, counted over all records
+     * @return Quality values, empty if there are none
+     */
+    util::StringView getQualities(size_t segment) const;
+
+    /**
+     * @brief Build a full record, for modules working on records
+     * @param record Record index
+     * @return Class U record
+     */
+    Record getRecord(size_t record) const;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace record
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_RECORD_READ_COLUMNS_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
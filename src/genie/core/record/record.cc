@@ -62,26 +62,46 @@ Record::Record(uint8_t _number_of_template_segments, ClassType _auTypeCfg, std::
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-Record::Record(util::BitReader &reader)
-    : number_of_template_segments(reader.readBypassBE<uint8_t>()),
-      reads(reader.readBypassBE<uint8_t>()),
-      alignmentInfo(reader.readBypassBE<uint16_t>()),
-      class_ID(reader.readBypassBE<ClassType>()),
-      read_group(reader.readBypassBE<uint8_t>(), 0),
-      read_1_first(reader.readBypassBE<uint8_t>()),
-      sharedAlignmentInfo(!alignmentInfo.empty() ? AlignmentSharedData(reader) : AlignmentSharedData()) {
-    std::vector<uint32_t> readSizes(reads.size());
-    for (auto &s : readSizes) {
+Record::Header::Header(util::BitReader &reader) { read(reader); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Record::Header::read(util::BitReader &reader) {
+    numberOfTemplateSegments = reader.readBypassBE<uint8_t>();
+    readLengths.resize(reader.readBypassBE<uint8_t>());
+    numberOfAlignments = reader.readBypassBE<uint16_t>();
+    classID = reader.readBypassBE<ClassType>();
+    readGroupLength = reader.readBypassBE<uint8_t>();
+    read1First = reader.readBypassBE<uint8_t>();
+    sharedAlignmentInfo = numberOfAlignments ? AlignmentSharedData(reader) : AlignmentSharedData();
+    for (auto &s : readLengths) {
         s = reader.readBypassBE<uint32_t, 3>();
     }
-    qv_depth = reader.readBypassBE<uint8_t>();
+    qvDepth = reader.readBypassBE<uint8_t>();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+Record::Record(util::BitReader &reader) : Record(Header(reader), reader) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+Record::Record(const Header &header, util::BitReader &reader)
+    : number_of_template_segments(header.numberOfTemplateSegments),
+      reads(header.readLengths.size()),
+      alignmentInfo(header.numberOfAlignments),
+      class_ID(header.classID),
+      read_group(header.readGroupLength, 0),
+      read_1_first(header.read1First),
+      sharedAlignmentInfo(header.sharedAlignmentInfo),
+      qv_depth(header.qvDepth) {
     read_name.resize(reader.readBypassBE<uint8_t>());
     reader.readBypass(&read_name[0], read_name.size());
     reader.readBypass(&read_group[0], read_group.size());
 
     size_t index = 0;
     for (auto &r : reads) {
-        r = Segment(readSizes[index], qv_depth, reader);
+        r = Segment(header.readLengths[index], qv_depth, reader);
         ++index;
     }
     for (auto &a : alignmentInfo) {
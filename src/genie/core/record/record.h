@@ -103,12 +103,50 @@ class Record {
      */
     Record& operator=(Record&& rec) noexcept;
 
+    /**
+     * @brief Fields preceding the read name in the binary format, enough to decide how to store a record
+     */
+    struct Header {
+        uint8_t numberOfTemplateSegments{};       //!< @brief
+        uint16_t numberOfAlignments{};            //!< @brief
+        ClassType classID{ClassType::NONE};       //!< @brief
+        uint8_t readGroupLength{};                //!< @brief
+        bool read1First{};                        //!< @brief
+        AlignmentSharedData sharedAlignmentInfo;  //!< @brief
+        std::vector<uint32_t> readLengths;        //!< @brief One per segment present
+        uint8_t qvDepth{};                        //!< @brief
+
+        /**
+         * @brief
+         */
+        Header() = default;
+
+        /**
+         * @brief
+         * @param reader
+         */
+        explicit Header(util::BitReader& reader);
+
+        /**
+         * @brief Read the next header, reusing the memory of this one
+         * @param reader
+         */
+        void read(util::BitReader& reader);
+    };
+
     /**
      * @brief
      * @param reader
      */
     explicit Record(util::BitReader& reader);
 
+    /**
+     * @brief Read the rest of a record
+     * @param header Header already read
+     * @param reader Positioned after the header
+     */
+    Record(const Header& header, util::BitReader& reader);
+
     /**
      * @brief
      * @param rec
@@ -5,6 +5,8 @@
  */
 
 #include "genie/core/reference-manager.h"
+#include <algorithm>
+#include <limits>
 #include <string>
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -18,42 +20,88 @@ const uint64_t ReferenceManager::CHUNK_SIZE = 1 * 1024 * 1024;  //!
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void ReferenceManager::touch(const std::string& name, size_t num) {
-    if (cacheInfo.size() < cacheSize) {
-        cacheInfo.push_front(std::make_pair(name, num));
+const uint64_t ReferenceManager::DEFAULT_CACHE_SIZE = 256 * 1024 * 1024;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const size_t ReferenceManager::UNKNOWN_SEQ = std::numeric_limits<size_t>::max();
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ReferenceManager::CacheShard::touch(CacheLine* line, bool known) {
+    if (known) {
+        lru.splice(lru.begin(), lru, line->lruPos);
         return;
     }
+    lru.push_front(line);
+    line->lruPos = lru.begin();
+    bytes += line->chunk->size();
+
+    while (bytes > budget && lru.size() > 1) {
+        auto* victim = lru.back();
+        lru.pop_back();
+        bytes -= victim->chunk->size();
+        victim->chunk.reset();
+        stats.evictions++;
+    }
+}
 
-    for (auto it = cacheInfo.begin(); it != cacheInfo.end(); ++it) {
-        if (it->first == name && it->second == num) {
-            cacheInfo.erase(it);
-            cacheInfo.push_front(std::make_pair(name, num));
-            return;
-        }
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t ReferenceManager::getSeqID(const std::string& name) {
+    auto it = seqIDs.find(name);
+    if (it != seqIDs.end()) {
+        return it->second;
+    }
+    const size_t seq = seqIDs.size();
+    seqIDs.emplace(name, seq);
+
+    // Only writers replace the directory and they hold refLock, so no atomic load is needed here
+    auto dir = directory;
+    if (seq == dir->tables.size()) {
+        const size_t MIN_SLOTS = 16;
+        auto larger = std::make_shared<Directory>();
+        larger->tables.resize(std::max(MIN_SLOTS, 2 * seq));
+        std::copy(dir->tables.begin(), dir->tables.end(), larger->tables.begin());
+        larger->size.store(seq, std::memory_order_relaxed);
+        std::atomic_store(&directory, larger);
+        dir = std::move(larger);
     }
+    std::atomic_store(&dir->tables[seq], std::make_shared<const ChunkTable>(ChunkTable{name, {}}));
+    dir->size.store(seq + 1, std::memory_order_release);
+    return seq;
+}
 
-    cacheInfo.push_front(std::make_pair(name, num));
-    auto& line = data[cacheInfo.back().first][cacheInfo.back().second];
-    cacheInfo.pop_back();
+// ---------------------------------------------------------------------------------------------------------------------
 
-    line->chunk.reset();
-    line->memory.reset();
+void ReferenceManager::growSequence(size_t seq, size_t numChunks) {
+    auto& slot = directory->tables[seq];
+    if (slot->lines.size() >= numChunks) {
+        return;
+    }
+    auto table = std::make_shared<ChunkTable>(*slot);
+    for (size_t i = table->lines.size(); i < numChunks; i++) {
+        ownedLines.push_back(genie::util::make_unique<CacheLine>());
+        ownedLines.back()->shard = (seq * 31 + i) % shards.size();
+        table->lines.push_back(ownedLines.back().get());
+    }
+    std::atomic_store(&slot, std::shared_ptr<const ChunkTable>(std::move(table)));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 void ReferenceManager::validateRefID(size_t id) {
-    std::unique_lock<std::mutex> lock2(cacheInfoLock);
-    for (size_t i = 0; i <= id; ++i) {
-        auto s = std::to_string(i);
-        data[std::string(s.size() < 3 ? (3 - s.size()) : 0, '0') + s];
+    std::unique_lock<std::mutex> lock2(refLock);
+    for (; validatedIDs <= id; ++validatedIDs) {
+        auto s = std::to_string(validatedIDs);
+        getSeqID(std::string(s.size() < 3 ? (3 - s.size()) : 0, '0') + s);
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 size_t ReferenceManager::ref2ID(const std::string& ref) {
-    std::unique_lock<std::mutex> lock2(cacheInfoLock);
+    std::unique_lock<std::mutex> lock2(refLock);
     for (const auto& r : indices) {
         if (r.second == ref) {
             return r.first;
@@ -65,7 +113,7 @@ size_t ReferenceManager::ref2ID(const std::string& ref) {
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::string ReferenceManager::ID2Ref(size_t id) {
-    std::unique_lock<std::mutex> lock2(cacheInfoLock);
+    std::unique_lock<std::mutex> lock2(refLock);
     auto it = indices.find(id);
     UTILS_DIE_IF(it == indices.end(), "Unknown reference ID. Forgot to specify external reference?");
     return it->second;
@@ -74,7 +122,7 @@ std::string ReferenceManager::ID2Ref(size_t id) {
 // ---------------------------------------------------------------------------------------------------------------------
 
 bool ReferenceManager::refKnown(size_t id) {
-    std::unique_lock<std::mutex> lock2(cacheInfoLock);
+    std::unique_lock<std::mutex> lock2(refLock);
     auto it = indices.find(id);
     return it != indices.end();
 }
@@ -236,67 +284,106 @@ std::string ReferenceManager::ReferenceExcerpt::getString(size_t start, size_t e
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-ReferenceManager::ReferenceManager(size_t csize) : cacheSize(csize) {}
+ReferenceManager::ReferenceManager(uint64_t cacheBytes) : directory(std::make_shared<Directory>()) {
+    // Every shard should be able to hold a few chunks, otherwise hash collisions ruin the LRU order
+    const size_t MAX_SHARDS = 16;
+    const size_t MIN_CHUNKS_PER_SHARD = 4;
+    size_t numShards = std::min<size_t>(MAX_SHARDS, cacheBytes / (MIN_CHUNKS_PER_SHARD * CHUNK_SIZE));
+    numShards = std::max<size_t>(1, numShards);
+    for (size_t i = 0; i < numShards; ++i) {
+        shards.emplace_back(genie::util::make_unique<CacheShard>());
+        shards.back()->budget = cacheBytes / numShards;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+ReferenceManager::CacheStats ReferenceManager::getCacheStats() {
+    CacheStats ret;
+    for (auto& s : shards) {
+        std::lock_guard<std::mutex> guard(s->lock);
+        ret.hits += s->stats.hits;
+        ret.misses += s->stats.misses;
+        ret.evictions += s->stats.evictions;
+        ret.bytes += s->bytes;
+    }
+    return ret;
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 void ReferenceManager::addRef(size_t index, std::unique_ptr<Reference> ref) {
-    std::unique_lock<std::mutex> lock2(cacheInfoLock);
+    std::unique_lock<std::mutex> lock2(refLock);
     UTILS_DIE_IF(indices.find(index) != indices.end(), "Ref index already taken");
     indices.insert(std::make_pair(index, ref->getName()));
-    auto sequence = data.find(ref->getName());
-    size_t curChunks = sequence == data.end() ? 0 : sequence->second.size();
-    for (size_t i = curChunks; i < (ref->getEnd() - 1) / CHUNK_SIZE + 1; i++) {
-        data[ref->getName()].push_back(genie::util::make_unique<CacheLine>());
-    }
+    growSequence(getSeqID(ref->getName()), (ref->getEnd() - 1) / CHUNK_SIZE + 1);
     mgr.registerRef(std::move(ref));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::shared_ptr<const std::string> ReferenceManager::loadAt(const std::string& name, size_t pos) {
-    std::unique_lock<std::mutex> lock2(cacheInfoLock);
+    return loadAt(resolve(name), pos);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t ReferenceManager::resolve(const std::string& name) {
+    std::lock_guard<std::mutex> lock2(refLock);
+    auto it = seqIDs.find(name);
+    return it == seqIDs.end() ? UNKNOWN_SEQ : it->second;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::shared_ptr<const std::string> ReferenceManager::loadAt(size_t seq, size_t pos) {
     size_t id = pos / CHUNK_SIZE;
-    auto it = data.find(name);
+    const auto dir = std::atomic_load(&directory);
 
     // Invalid chunk
-    if (it == data.end()) {
+    if (seq >= dir->size.load(std::memory_order_acquire)) {
         return ReferenceExcerpt::undef_page();
     }
-
-    auto& cacheline = *it->second[id];
-    lock2.unlock();
-
-    // Very important that lock2 is released and we lock again in that specific order, to avoid deadlocks.
-    std::lock_guard<std::mutex> lock1(cacheline.loadMutex);
-    lock2.lock();
-
-    // Chunk already loaded
-    auto ret = cacheline.chunk;
-    if (ret) {
-        touch(name, id);
-        return ret;
+    const auto table = std::atomic_load(&dir->tables[seq]);
+    if (id >= table->lines.size()) {
+        return ReferenceExcerpt::undef_page();
     }
+    CacheLine* line = table->lines[id];
+
+    // Only one thread loads a chunk, others wait for it. The shard lock is always taken after the load lock.
+    std::lock_guard<std::mutex> lock1(line->loadMutex);
+    auto& shard = *shards[line->shard];
+    {
+        std::lock_guard<std::mutex> lock3(shard.lock);
+
+        // Chunk already loaded
+        auto ret = line->chunk;
+        if (ret) {
+            shard.stats.hits++;
+            shard.touch(line, true);
+            return ret;
+        }
 
-    // Try quick load. Maybe another thread unloaded this reference but it is still in memory, reachable via weak
-    // ptr.
-    ret = cacheline.memory.lock();
-    if (ret) {
-        cacheline.chunk = ret;
-        cacheline.memory = ret;
-        touch(name, id);
-        return ret;
+        // Try quick load. Maybe the chunk was evicted but it is still in memory, reachable via weak ptr.
+        ret = line->memory.lock();
+        if (ret) {
+            shard.stats.hits++;
+            line->chunk = ret;
+            shard.touch(line, false);
+            return ret;
+        }
+        shard.stats.misses++;
     }
 
     // Reference is not in memory. We have to do a slow read from disc...
-    // Loading mutex keeps locked for this chunk, but other chunks can be accessed, main lock is opened.
-    lock2.unlock();
-    ret = std::make_shared<const std::string>(mgr.getSequence(name, id * CHUNK_SIZE, (id + 1) * CHUNK_SIZE));
-    lock2.lock();
-
-    cacheline.chunk = ret;
-    cacheline.memory = ret;
-    touch(name, id);
+    // Loading mutex keeps locked for this chunk, but other chunks can be accessed.
+    auto ret =
+        std::make_shared<const std::string>(mgr.getSequence(table->name, id * CHUNK_SIZE, (id + 1) * CHUNK_SIZE));
+
+    std::lock_guard<std::mutex> lock3(shard.lock);
+    line->chunk = ret;
+    line->memory = ret;
+    shard.touch(line, false);
     return ret;
 }
 
@@ -304,8 +391,9 @@ std::shared_ptr<const std::string> ReferenceManager::loadAt(const std::string& n
 
 ReferenceManager::ReferenceExcerpt ReferenceManager::load(const std::string& name, size_t start, size_t end) {
     ReferenceExcerpt ret(name, start, end);
+    const size_t seq = resolve(name);
     for (size_t i = start / CHUNK_SIZE; i <= (end - 1) / CHUNK_SIZE; i++) {
-        ret.mapChunkAt(i * CHUNK_SIZE, loadAt(name, i * CHUNK_SIZE));
+        ret.mapChunkAt(i * CHUNK_SIZE, loadAt(seq, i * CHUNK_SIZE));
     }
     return ret;
 }
@@ -10,7 +10,8 @@
 // ---------------------------------------------------------------------------------------------------------------------
 
 #include <algorithm>
-#include <deque>
+#include <atomic>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -30,28 +31,93 @@ namespace core {
  * @brief
  */
 class ReferenceManager {
+ public:
+    /**
+     * @brief Cache counters
+     */
+    struct CacheStats {
+        uint64_t hits{};       //!< @brief Chunk found in the cache or still in memory
+        uint64_t misses{};     //!< @brief Chunk had to be loaded
+        uint64_t evictions{};  //!< @brief Chunk dropped from the cache
+        uint64_t bytes{};      //!< @brief Size of all cached chunks
+    };
+
+    static const uint64_t DEFAULT_CACHE_SIZE;  //!< @brief Default cache budget in bytes
+    static const size_t UNKNOWN_SEQ;           //!< @brief Returned by resolve() for unknown sequence names
+
  private:
     ReferenceCollection mgr;  //!< @brief
 
+    /**
+     * @brief One chunk of a reference sequence
+     */
     struct CacheLine {
-        std::shared_ptr<const std::string> chunk;  //!< @brief
-        std::weak_ptr<const std::string> memory;   //!< @brief
-        std::mutex loadMutex;                      //!< @brief
+        std::shared_ptr<const std::string> chunk;  //!< @brief Set while the chunk is in the cache
+        std::weak_ptr<const std::string> memory;   //!< @brief Still reachable if evicted but in use somewhere else
+        std::mutex loadMutex;                      //!< @brief Prevents loading the same chunk twice
+        size_t shard{};                            //!< @brief Cache shard this chunk belongs to
+        std::list<CacheLine*>::iterator lruPos;    //!< @brief Position in the LRU list of the shard, if cached
     };
 
-    std::map<std::string, std::vector<std::unique_ptr<CacheLine>>> data;  //!< @brief
-    std::map<size_t, std::string> indices;
-    std::deque<std::pair<std::string, size_t>> cacheInfo;  //!< @brief
-    std::mutex cacheInfoLock;                              //!< @brief
-    uint64_t cacheSize;                                    //!< @brief
-    static const uint64_t CHUNK_SIZE;                      //!< @brief
+    /**
+     * @brief Independently locked part of the cache. Chunks are assigned to shards by hashing their position.
+     */
+    struct CacheShard {
+        std::mutex lock;            //!< @brief Protects the shard and the chunk pointers of its cache lines
+        std::list<CacheLine*> lru;  //!< @brief Cached chunks, most recently used first
+        uint64_t bytes{};           //!< @brief Size of all cached chunks
+        uint64_t budget{};          //!< @brief Maximum size of all cached chunks
+        CacheStats stats;           //!< @brief
+
+        /**
+         * @brief Move a chunk to the front of the LRU list, inserting it if necessary, and evict old chunks until
+         * the shard fits its budget again. The most recently used chunk is never evicted.
+         * @param line Chunk, must be loaded
+         * @param known If the chunk is already in the LRU list
+         */
+        void touch(CacheLine* line, bool known);
+    };
 
     /**
-     * @brief
-     * @param name
-     * @param num
+     * @brief Cache lines of one sequence. Never modified once published, so readers need no lock.
+     */
+    struct ChunkTable {
+        std::string name;               //!< @brief Sequence name
+        std::vector<CacheLine*> lines;  //!< @brief Cache line for each chunk
+    };
+
+    /**
+     * @brief Chunk tables by sequence ID. A grown table replaces the old one in its slot, and a directory with twice
+     * the slots is published once all are taken. Replaced tables and directories are freed by their last reader.
+     */
+    struct Directory {
+        std::vector<std::shared_ptr<const ChunkTable>> tables;  //!< @brief Fixed number of slots, accessed atomically
+        std::atomic<size_t> size{0};                            //!< @brief Number of slots in use
+    };
+
+    std::map<std::string, size_t> seqIDs;                //!< @brief Sequence name to integer ID
+    std::shared_ptr<Directory> directory;                //!< @brief Current chunk tables, accessed atomically
+    std::vector<std::unique_ptr<CacheLine>> ownedLines;  //!< @brief Storage of all cache lines
+    std::map<size_t, std::string> indices;               //!< @brief
+    size_t validatedIDs{0};                              //!< @brief Number of IDs registered by validateRefID()
+    std::mutex refLock;                                  //!< @brief Serializes changes to the tables
+    std::vector<std::unique_ptr<CacheShard>> shards;     //!< @brief
+    static const uint64_t CHUNK_SIZE;                    //!< @brief
+
+    /**
+     * @brief Get the ID of a sequence, registering it if necessary. refLock must be held.
+     * @param name Sequence name
+     * @return Sequence ID
      */
-    void touch(const std::string& name, size_t num);
+    size_t getSeqID(const std::string& name);
+
+    /**
+     * @brief Publish a chunk table with at least numChunks cache lines for a sequence. The table is copied instead of
+     * modified, because concurrent loads may still read the old one. refLock must be held.
+     * @param seq Sequence ID
+     * @param numChunks Minimum number of chunks
+     */
+    void growSequence(size_t seq, size_t numChunks);
 
  public:
     /**
@@ -235,9 +301,15 @@ class ReferenceManager {
 
     /**
      * @brief
-     * @param csize
+     * @param cacheBytes Maximum size of the chunks kept in the cache
      */
-    explicit ReferenceManager(size_t csize);
+    explicit ReferenceManager(uint64_t cacheBytes = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief
+     * @return Summed counters of all cache shards
+     */
+    CacheStats getCacheStats();
 
     /**
      * @brief
@@ -254,6 +326,21 @@ class ReferenceManager {
      */
     std::shared_ptr<const std::string> loadAt(const std::string& name, size_t pos);
 
+    /**
+     * @brief Get the integer ID of a sequence, so that repeated loads can skip the name lookup
+     * @param name Sequence name
+     * @return Sequence ID or UNKNOWN_SEQ
+     */
+    size_t resolve(const std::string& name);
+
+    /**
+     * @brief Load a chunk without taking the global lock. Only the lock of the chunk's cache shard is used.
+     * @param seq Sequence ID from resolve()
+     * @param pos Position inside the chunk
+     * @return Chunk, undef_page() if the sequence or position is unknown
+     */
+    std::shared_ptr<const std::string> loadAt(size_t seq, size_t pos);
+
     /**
      * @brief
      * @param name
@@ -0,0 +1,760 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/core/statistics-decoder.h"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "genie/core/constants.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+constexpr size_t StatisticsDecoder::QUALITY_RANGE;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const uint8_t BASE_N = 4;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StatisticsDecoder::Summary::add(uint64_t value, uint64_t times) {
+    if (!times) {
+        return;
+    }
+    min = std::min(min, value);
+    max = std::max(max, value);
+    sum += value * times;
+    count += times;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StatisticsDecoder::Summary::merge(const Summary& other) {
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sum += other.sum;
+    count += other.count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::array<uint64_t, uint8_t(api::StatisticsIndex::COUNT)> StatisticsDecoder::Summary::get() const {
+    if (!count) {
+        return {{0, 0, 0}};
+    }
+    return {{min, max, sum / count}};
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Increment a histogram, growing it as needed
+ * @param hist Histogram
+ * @param index Bin
+ */
+static void increment(std::vector<uint64_t>& hist, size_t index) {
+    if (hist.size() <= index) {
+        hist.resize(index + 1, 0);
+    }
+    hist[index]++;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void addTo(uint64_t& a, uint64_t b) { a += b; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void addTo(StatisticsDecoder::Summary& a, const StatisticsDecoder::Summary& b) { a.merge(b); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename T, size_t N>
+static void addTo(std::array<T, N>& a, const std::array<T, N>& b) {
+    for (size_t i = 0; i < N; ++i) {
+        addTo(a[i], b[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+static void addTo(std::vector<T>& a, const std::vector<T>& b) {
+    if (a.size() < b.size()) {
+        a.resize(b.size(), T{});
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+        addTo(a[i], b[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Sort coverage changes and combine those at the same reference position, dropping the ones that cancel out
+ * @param changes Changes of coverage by reference position
+ */
+static void compact(std::vector<std::pair<uint64_t, int64_t>>& changes) {
+    std::sort(changes.begin(), changes.end());
+    size_t out = 0;
+    for (const auto& c : changes) {
+        if (out && changes[out - 1].first == c.first) {
+            changes[out - 1].second += c.second;
+        } else {
+            changes[out++] = c;
+        }
+        if (changes[out - 1].second == 0) {
+            out--;
+        }
+    }
+    changes.resize(out);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StatisticsDecoder::Accumulator::merge(Accumulator&& other) {
+    reads += other.reads;
+    addTo(segmentsPerRead, other.segmentsPerRead);
+    qualityCheckFailed += other.qualityCheckFailed;
+    properlyPaired += other.properlyPaired;
+    opticalDuplicates += other.opticalDuplicates;
+    chimeras += other.chimeras;
+    addTo(pairStrands, other.pairStrands);
+    addTo(segmentStrands, other.segmentStrands);
+    addTo(segmentClasses, other.segmentClasses);
+    addTo(segmentClips, other.segmentClips);
+    alignedSegments += other.alignedSegments;
+
+    for (auto s : {std::make_pair(&segmentLength, &other.segmentLength), std::make_pair(&errors, &other.errors),
+                   std::make_pair(&substitutions, &other.substitutions),
+                   std::make_pair(&insertions, &other.insertions),
+                   std::make_pair(&insertionsLength, &other.insertionsLength),
+                   std::make_pair(&deletions, &other.deletions),
+                   std::make_pair(&deletionsLength, &other.deletionsLength),
+                   std::make_pair(&alignmentScore, &other.alignmentScore)}) {
+        s.first->merge(*s.second);
+    }
+
+    for (auto h : {std::make_pair(&mappedBasesDistribution, &other.mappedBasesDistribution),
+                   std::make_pair(&errorsDistribution, &other.errorsDistribution),
+                   std::make_pair(&substitutionsDistribution, &other.substitutionsDistribution),
+                   std::make_pair(&insertionsDistribution, &other.insertionsDistribution),
+                   std::make_pair(&insertionsLengthDistribution, &other.insertionsLengthDistribution),
+                   std::make_pair(&deletionsDistribution, &other.deletionsDistribution),
+                   std::make_pair(&deletionsLengthDistribution, &other.deletionsLengthDistribution),
+                   std::make_pair(&alignmentScoreDistribution, &other.alignmentScoreDistribution),
+                   std::make_pair(&errorsPositions, &other.errorsPositions),
+                   std::make_pair(&substitutionsPositions, &other.substitutionsPositions),
+                   std::make_pair(&insertionsPositions, &other.insertionsPositions),
+                   std::make_pair(&deletionsPositions, &other.deletionsPositions),
+                   std::make_pair(&qualityScores, &other.qualityScores)}) {
+        addTo(*h.first, *h.second);
+    }
+    addTo(alignmentScoreBySegmentLength, other.alignmentScoreBySegmentLength);
+    addTo(substitutionsTransitions, other.substitutionsTransitions);
+    addTo(qualityByPosition, other.qualityByPosition);
+
+    if (coverageChanges.empty()) {
+        coverageChanges = std::move(other.coverageChanges);
+        compactedChanges = other.compactedChanges;
+    } else {
+        coverageChanges.insert(coverageChanges.end(), other.coverageChanges.begin(), other.coverageChanges.end());
+    }
+
+    // Keep the total proportional to the number of distinct positions rather than to the number of segments
+    if (coverageChanges.size() > 2 * compactedChanges + 1024) {
+        compactCoverage();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StatisticsDecoder::Accumulator::cover(uint64_t start, uint64_t end) {
+    if (start >= end) {
+        return;
+    }
+    coverageChanges.emplace_back(start, 1);
+    coverageChanges.emplace_back(end, -1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StatisticsDecoder::Accumulator::compactCoverage() {
+    compact(coverageChanges);
+    compactedChanges = coverageChanges.size();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t StatisticsDecoder::SegmentInfo::getReferenceLength() const {
+    uint64_t ret = length - softClips[0] - softClips[1];
+    for (const auto& m : mismatches) {
+        if (m.type == GenConst::MMTYPE_INSERTION) {
+            ret--;
+        } else if (m.type == GenConst::MMTYPE_DELETION) {
+            ret++;
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Run length encode an extended CIGAR with one character per base
+ * @param expanded Extended CIGAR with one character per base
+ * @return Extended CIGAR
+ */
+static std::string contractECigar(const std::string& expanded) {
+    std::string ret;
+    for (size_t i = 0; i < expanded.size();) {
+        const auto c = expanded[i];
+        size_t j = i;
+        while (j < expanded.size() && expanded[j] == c) {
+            j++;
+        }
+        if (getAlphabetProperties(AlphabetID::ACGTN).isIncluded(c)) {
+            ret.append(j - i, c);
+        } else {
+            if (c == ')') {
+                ret += '(';
+            } else if (c == ']') {
+                ret += '[';
+            }
+            ret += std::to_string(j - i) + c;
+        }
+        i = j;
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string StatisticsDecoder::SegmentInfo::getECigar() const {
+    // Same steps as in the base decoder: reference span, clips, then mismatches
+    std::string expanded(getReferenceLength() + softClips[0] + softClips[1], '=');
+    expanded.insert(0, hardClips[0], ']');
+    expanded.append(hardClips[1], ']');
+    std::fill_n(expanded.begin() + hardClips[0], softClips[0], ')');
+    std::fill_n(expanded.end() - hardClips[1] - softClips[1], softClips[1], ')');
+    auto offset = hardClips[0];
+    for (const auto& m : mismatches) {
+        if (m.type == GenConst::MMTYPE_SUBSTITUTION) {
+            expanded[m.position + offset] = getAlphabetProperties(AlphabetID::ACGTN).lut[m.base];
+        } else if (m.type == GenConst::MMTYPE_INSERTION) {
+            expanded.insert(m.position + offset, 1, '+');
+        } else {
+            expanded[m.position + offset] = '-';
+            offset++;
+        }
+    }
+    return contractECigar(expanded);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param excerpt Reference of the access unit
+ * @param pos Reference position
+ * @return Reference base as index in ACGTN, N if not available
+ */
+static uint8_t referenceBase(const ReferenceManager::ReferenceExcerpt& excerpt, uint64_t pos) {
+    if (excerpt.isEmpty() || pos < excerpt.getGlobalStart() || pos >= excerpt.getGlobalEnd() ||
+        !excerpt.isMapped(pos)) {
+        return BASE_N;
+    }
+    return getAlphabetProperties(AlphabetID::ACGTN).inverseLut[excerpt.getString(pos, pos + 1).front()];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+StatisticsDecoder::RecordInfo StatisticsDecoder::readRecord(AccessUnit& au, size_t recordIndex,
+                                                             uint64_t& position) const {
+    RecordInfo rec;
+    rec.paired = au.getParameters().getNumberTemplateSegments() == 2;
+    int16_t delta = 0;
+    if (rec.paired) {
+        switch (au.pull(GenSub::PAIR_DECODING_CASE)) {
+            case GenConst::PAIR_SAME_RECORD:
+                rec.numSegments = 2;
+                delta = static_cast<int16_t>(static_cast<uint16_t>(au.pull(GenSub::PAIR_SAME_REC) >> 1u));
+                break;
+            case GenConst::PAIR_R1_SPLIT:
+                au.pull(GenSub::PAIR_R1_SPLIT);
+                break;
+            case GenConst::PAIR_R2_SPLIT:
+                au.pull(GenSub::PAIR_R2_SPLIT);
+                break;
+            case GenConst::PAIR_R1_DIFF_REF:
+                au.pull(GenSub::PAIR_R1_DIFF_POS);
+                au.pull(GenSub::PAIR_R1_DIFF_SEQ);
+                rec.chimeric = true;
+                break;
+            case GenConst::PAIR_R2_DIFF_REF:
+                au.pull(GenSub::PAIR_R2_DIFF_POS);
+                au.pull(GenSub::PAIR_R2_DIFF_SEQ);
+                rec.chimeric = true;
+                break;
+            default:
+                break;
+        }
+    }
+
+    for (size_t s = 0; s < rec.numSegments; ++s) {
+        rec.segments[s].length =
+            au.isEnd(GenSub::RLEN) ? au.getParameters().getReadLength() : au.pull(GenSub::RLEN) + 1;
+    }
+
+    if (!au.isEnd(GenSub::CLIPS_RECORD_ID) && au.peek(GenSub::CLIPS_RECORD_ID) == recordIndex) {
+        au.pull(GenSub::CLIPS_RECORD_ID);
+        for (auto type = au.pull(GenSub::CLIPS_TYPE); type != GenConst::CLIPS_RECORD_END;
+             type = au.pull(GenSub::CLIPS_TYPE)) {
+            auto& segment = rec.segments[type & 2u ? rec.numSegments - 1 : 0];
+            const size_t side = type & 1u;
+            if (type & 4u) {
+                segment.hardClips[side] += au.pull(GenSub::CLIPS_HARD_LENGTH);
+            } else {
+                const auto terminator = getAlphabetProperties(AlphabetID::ACGTN).lut.size();
+                while (au.pull(GenSub::CLIPS_SOFT_STRING) != terminator) {
+                    segment.softClips[side]++;
+                }
+            }
+        }
+    }
+
+    rec.type = au.isEnd(GenSub::RTYPE) ? au.getClassType() : record::ClassType(au.pull(GenSub::RTYPE));
+    if (!au.isEnd(GenSub::FLAGS_PCR_DUPLICATE) && au.pull(GenSub::FLAGS_PCR_DUPLICATE)) {
+        rec.flags |= GenConst::FLAGS_PCR_DUPLICATE_MASK;
+    }
+    if (!au.isEnd(GenSub::FLAGS_QUALITY_FAIL) && au.pull(GenSub::FLAGS_QUALITY_FAIL)) {
+        rec.flags |= GenConst::FLAGS_QUALITY_FAIL_MASK;
+    }
+    if (!au.isEnd(GenSub::FLAGS_PROPER_PAIR) && au.pull(GenSub::FLAGS_PROPER_PAIR)) {
+        rec.flags |= GenConst::FLAGS_PROPER_PAIR_MASK;
+    }
+    position += au.pull(GenSub::POS_MAPPING_FIRST);
+
+    for (size_t s = 0; s < rec.numSegments; ++s) {
+        auto& segment = rec.segments[s];
+        const bool rcomp = au.pull(GenSub::RCOMP) != 0;
+        segment.strand = rcomp ? api::Strand::REVERSE : api::Strand::FORWARD;
+        if (s > 0 && rec.type == record::ClassType::CLASS_HM) {
+            segment.strand = api::Strand::UNMAPPED_UNKNOWN;
+        }
+        if (!au.isEnd(GenSub::MSCORE)) {
+            segment.hasScore = true;
+            segment.score = au.pull(GenSub::MSCORE);
+        }
+        segment.position = s == 0 ? position : position + delta;
+
+        if (au.isEnd(GenSub::MMPOS_TERMINATOR)) {
+            continue;
+        }
+        uint64_t mismatchPosition = 0;
+        int64_t shift = 0;  // Deleted minus inserted bases so far
+        while (!au.pull(GenSub::MMPOS_TERMINATOR)) {
+            mismatchPosition += au.pull(GenSub::MMPOS_POSITION) + 1;
+            SegmentInfo::Mismatch m{mismatchPosition - 1 + segment.softClips[0], GenConst::MMTYPE_SUBSTITUTION,
+                                    BASE_N, BASE_N};
+            if (!au.get(GenSub::MMTYPE_TYPE).isEmpty()) {
+                m.type = static_cast<uint8_t>(au.pull(GenSub::MMTYPE_TYPE));
+            }
+            if (m.type == GenConst::MMTYPE_SUBSTITUTION) {
+                m.ref = referenceBase(au.getReferenceExcerpt(), segment.position + mismatchPosition - 1 + shift);
+                auto* decoder = au.get(GenSub::MMTYPE_SUBSTITUTION).getMismatchDecoder();
+                if (decoder && decoder->dataLeft()) {
+                    m.base = static_cast<uint8_t>(decoder->decodeMismatch(m.ref));
+                }
+            } else if (m.type == GenConst::MMTYPE_INSERTION) {
+                m.base = static_cast<uint8_t>(au.pull(GenSub::MMTYPE_INSERTION));
+                shift--;
+            } else {
+                mismatchPosition--;
+                shift++;
+            }
+            segment.mismatches.push_back(m);
+        }
+    }
+    return rec;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool StatisticsDecoder::inRegion(const RecordInfo& rec) const {
+    for (size_t s = 0; s < rec.numSegments; ++s) {
+        const auto& segment = rec.segments[s];
+        if (segment.strand != api::Strand::UNMAPPED_UNKNOWN && segment.position <= endPos &&
+            segment.position + std::max<uint64_t>(segment.getReferenceLength(), 1) > startPos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StatisticsDecoder::count(const RecordInfo& rec, const std::array<const std::string*, 2>& qualities,
+                              std::array<Accumulator, uint8_t(api::Strand::COUNT)>& acc) const {
+    auto& first = acc[uint8_t(rec.segments[0].strand)];
+    first.reads++;
+    increment(first.segmentsPerRead, rec.numSegments);
+    first.qualityCheckFailed += (rec.flags & GenConst::FLAGS_QUALITY_FAIL_MASK) ? 1 : 0;
+    first.opticalDuplicates += (rec.flags & GenConst::FLAGS_PCR_DUPLICATE_MASK) ? 1 : 0;
+    first.properlyPaired += (rec.flags & GenConst::FLAGS_PROPER_PAIR_MASK) ? 1 : 0;
+    first.chimeras += rec.chimeric ? 1 : 0;
+    if (rec.paired) {
+        auto second = rec.numSegments == 2 ? rec.segments[1].strand : api::Strand::UNMAPPED_UNKNOWN;
+        first.pairStrands[uint8_t(api::getPairedStrand(rec.segments[0].strand, second))]++;
+    }
+
+    const auto regionEnd = endPos == std::numeric_limits<uint64_t>::max() ? endPos : endPos + 1;
+    for (size_t s = 0; s < rec.numSegments; ++s) {
+        const auto& segment = rec.segments[s];
+        auto& a = acc[uint8_t(segment.strand)];
+        a.segmentStrands[uint8_t(segment.strand)]++;
+        a.segmentClasses[uint8_t(rec.type) - 1]++;
+        if (segment.hardClips[0] || segment.hardClips[1]) {
+            a.segmentClips[uint8_t(api::ClipTypeCombination::SOFT_HARD)]++;
+        } else if (segment.softClips[0] || segment.softClips[1]) {
+            a.segmentClips[uint8_t(api::ClipTypeCombination::SOFT)]++;
+        } else {
+            a.segmentClips[uint8_t(api::ClipTypeCombination::NONE)]++;
+        }
+        a.segmentLength.add(segment.length);
+        if (segment.strand == api::Strand::UNMAPPED_UNKNOWN) {
+            continue;
+        }
+        a.alignedSegments++;
+
+        // Adjacent insertions share one run, deletions of one run all have the same position
+        uint64_t substitutions = 0, insertions = 0, insertionsLength = 0, deletions = 0, deletionsLength = 0;
+        const SegmentInfo::Mismatch* previous = nullptr;
+        for (const auto& m : segment.mismatches) {
+            if (m.type == GenConst::MMTYPE_SUBSTITUTION) {
+                substitutions++;
+            } else if (m.type == GenConst::MMTYPE_INSERTION) {
+                insertionsLength++;
+                if (!previous || previous->type != m.type || previous->position + 1 != m.position) {
+                    insertions++;
+                }
+            } else {
+                deletionsLength++;
+                if (!previous || previous->type != m.type || previous->position != m.position) {
+                    deletions++;
+                }
+            }
+            previous = &m;
+        }
+        const auto errors = substitutions + insertionsLength + deletionsLength;
+        const auto referenceLength = segment.getReferenceLength();
+        a.errors.add(errors);
+        a.substitutions.add(substitutions);
+        a.insertions.add(insertions);
+        a.insertionsLength.add(insertionsLength);
+        a.deletions.add(deletions);
+        a.deletionsLength.add(deletionsLength);
+        if (segment.hasScore) {
+            a.alignmentScore.add(segment.score);
+        }
+        a.cover(std::max(segment.position, startPos), std::min(segment.position + referenceLength, regionEnd));
+
+        if (!extended) {
+            continue;
+        }
+        increment(a.mappedBasesDistribution,
+                  segment.length - segment.softClips[0] - segment.softClips[1] - insertionsLength);
+        increment(a.errorsDistribution, errors);
+        increment(a.substitutionsDistribution, substitutions);
+        increment(a.insertionsDistribution, insertions);
+        increment(a.insertionsLengthDistribution, insertionsLength);
+        increment(a.deletionsDistribution, deletions);
+        increment(a.deletionsLengthDistribution, deletionsLength);
+        if (segment.hasScore) {
+            increment(a.alignmentScoreDistribution, segment.score);
+            if (a.alignmentScoreBySegmentLength.size() < segment.length) {
+                a.alignmentScoreBySegmentLength.resize(segment.length);
+            }
+            a.alignmentScoreBySegmentLength[segment.length - 1].add(segment.score);
+        }
+        for (const auto& m : segment.mismatches) {
+            increment(a.errorsPositions, m.position);
+            if (m.type == GenConst::MMTYPE_SUBSTITUTION) {
+                increment(a.substitutionsPositions, m.position);
+                if (a.substitutionsTransitions.size() <= m.position) {
+                    a.substitutionsTransitions.resize(m.position + 1, {});
+                }
+                a.substitutionsTransitions[m.position][m.ref][m.base]++;
+            } else if (m.type == GenConst::MMTYPE_INSERTION) {
+                increment(a.insertionsPositions, m.position);
+            } else {
+                increment(a.deletionsPositions, m.position);
+            }
+        }
+
+        if (!qualities[s]) {
+            continue;
+        }
+        if (a.qualityByPosition.size() < qualities[s]->size()) {
+            a.qualityByPosition.resize(qualities[s]->size(), {});
+        }
+        for (size_t i = 0; i < qualities[s]->size(); ++i) {
+            const auto q = std::min<size_t>(static_cast<uint8_t>((*qualities[s])[i] - 33), QUALITY_RANGE - 1);
+            increment(a.qualityScores, q);
+            a.qualityByPosition[i][q]++;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Walk the coverage of a region as runs of positions with the same depth, without a per-position buffer
+ * @param acc Counts
+ * @param startPos First position of the region, raised to the first covered position if endPos is unbounded
+ * @param endPos Last position of the region, lowered to the last covered position if unbounded
+ * @param run Called in order with the first position, the number of positions and the depth of each run
+ */
+static void walkCoverage(const StatisticsDecoder::Accumulator& acc, uint64_t& startPos, uint64_t& endPos,
+                         const std::function<void(uint64_t, uint64_t, uint64_t)>& run) {
+    auto changes = acc.coverageChanges;
+    compact(changes);
+    if (endPos == std::numeric_limits<uint64_t>::max()) {
+        if (changes.empty()) {
+            startPos = 1;
+            endPos = 0;
+            return;
+        }
+        startPos = std::max(startPos, changes.front().first);
+        endPos = changes.back().first - 1;
+    }
+    int64_t depth = 0;
+    uint64_t pos = startPos;
+    for (const auto& c : changes) {
+        if (c.first > endPos) {
+            break;
+        }
+        if (c.first > pos) {
+            run(pos, c.first - pos, static_cast<uint64_t>(depth));
+            pos = c.first;
+        }
+        depth += c.second;
+    }
+    if (pos <= endPos) {
+        run(pos, endPos - pos + 1, static_cast<uint64_t>(depth));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+api::SimpleSegmentStatistics StatisticsDecoder::toSimple(const Accumulator& acc) const {
+    api::SimpleSegmentStatistics ret{};
+    ret.readsNumber = acc.reads;
+    ret.segmentsNumberReadsDistribution = acc.segmentsPerRead;
+    ret.qualityCheckFailedReadsNumber = acc.qualityCheckFailed;
+    ret.segmentLength = acc.segmentLength.get();
+    ret.mappedStrandSegmentDistribution = acc.segmentStrands;
+    ret.properlyPairedNumber = acc.properlyPaired;
+    ret.mappedStrandPairDistribution = acc.pairStrands;
+
+    // Only the primary alignment is coded in the descriptors read here
+    ret.maxAlignments = acc.alignedSegments ? 1 : 0;
+    ret.multipleAlignmentSegmentDistribution = {acc.segmentLength.count - acc.alignedSegments, acc.alignedSegments};
+
+    Summary coverage;
+    auto first = startPos;
+    auto last = endPos;
+    walkCoverage(acc, first, last, [&coverage](uint64_t, uint64_t length, uint64_t depth) {
+        coverage.add(depth, length);
+    });
+    ret.coverage = coverage.get();
+    ret.weightedCoverage = ret.coverage;
+    ret.errorsNumber = acc.errors.get();
+    ret.substitutionsNumber = acc.substitutions.get();
+    ret.insertionsNumber = acc.insertions.get();
+    ret.insertionsLength = acc.insertionsLength.get();
+    ret.deletionsNumber = acc.deletions.get();
+    ret.deletionsLength = acc.deletionsLength.get();
+    ret.alignmentScore = acc.alignmentScore.get();
+    ret.classSegmentDistribution = acc.segmentClasses;
+    ret.clippedSegmentDistribution = acc.segmentClips;
+    ret.opticalDuplicatesNumber = acc.opticalDuplicates;
+    ret.chimerasNumber = acc.chimeras;
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+api::ExtendedSegmentStatistics StatisticsDecoder::toExtended(const Accumulator& acc) const {
+    api::ExtendedSegmentStatistics ret{};
+    ret.mappedBasesNumberDistribution = acc.mappedBasesDistribution;
+    auto first = startPos;
+    auto last = endPos;
+    walkCoverage(acc, first, last, [&](uint64_t pos, uint64_t length, uint64_t depth) {
+        if (ret.coverage.empty()) {
+            ret.coverage.resize(last + 1 - first, 0);
+        }
+        std::fill_n(ret.coverage.begin() + (pos - first), length, depth);
+    });
+    ret.weightedCoverage = ret.coverage;
+    ret.errorsNumberDistribution = acc.errorsDistribution;
+    ret.errorsPositionDistribution = acc.errorsPositions;
+    ret.substitutionsNumberDistribution = acc.substitutionsDistribution;
+    ret.substitutionsTransitionDistribution = acc.substitutionsTransitions;
+    ret.substitutionsPositionDistribution = acc.substitutionsPositions;
+    ret.insertionsNumberDistribution = acc.insertionsDistribution;
+    ret.insertionsLengthDistribution = acc.insertionsLengthDistribution;
+    ret.insertionsPositionDistribution = acc.insertionsPositions;
+    ret.deletionsNumberDistribution = acc.deletionsDistribution;
+    ret.deletionsLengthDistribution = acc.deletionsLengthDistribution;
+    ret.deletionsPositionDistribution = acc.deletionsPositions;
+    ret.alignmentScoreValueDistribution = acc.alignmentScoreDistribution;
+    for (const auto& s : acc.alignmentScoreBySegmentLength) {
+        ret.alignmentScoreSegmentLengthDistribution.push_back(s.get());
+    }
+    ret.qualityScoreDistribution = acc.qualityScores;
+
+    // Percentile bins hold the quality value reached at their upper end: 10, 25, 50, 75, 90 and 100 percent
+    static const std::array<uint64_t, uint8_t(api::PhredBins::COUNT)> PERCENTILES = {{10, 25, 50, 75, 90, 100}};
+    for (const auto& hist : acc.qualityByPosition) {
+        Summary summary;
+        uint64_t total = 0;
+        for (size_t q = 0; q < hist.size(); ++q) {
+            total += hist[q];
+            if (hist[q]) {
+                summary.min = std::min<uint64_t>(summary.min, q);
+                summary.max = std::max<uint64_t>(summary.max, q);
+                summary.sum += q * hist[q];
+                summary.count += hist[q];
+            }
+        }
+        ret.qualityScorePositionDistribution.push_back(summary.get());
+
+        std::array<uint64_t, uint8_t(api::PhredBins::COUNT)> bins{};
+        uint64_t seen = 0;
+        size_t bin = 0;
+        for (size_t q = 0; q < hist.size() && bin < bins.size(); ++q) {
+            seen += hist[q];
+            while (bin < bins.size() && hist[q] && seen * 100 >= PERCENTILES[bin] * total) {
+                bins[bin++] = q;
+            }
+        }
+        ret.qualityScorePositionPercentilesDistribution.push_back(bins);
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+StatisticsDecoder::StatisticsDecoder(uint16_t _sequenceID, uint64_t _startPos, uint64_t _endPos, bool _extended)
+    : sequenceID(_sequenceID), startPos(_startPos), endPos(_endPos), extended(_extended) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StatisticsDecoder::flowIn(AccessUnit&& t, const util::Section& id) {
+    add(entropyCodeAU(std::move(t), true));
+    skipOut(id);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StatisticsDecoder::add(AccessUnit&& au) {
+    auto t = std::move(au);
+    if (t.getClassType() == record::ClassType::CLASS_U || t.getReference() != sequenceID) {
+        return;
+    }
+
+    std::array<Accumulator, uint8_t(api::Strand::COUNT)> local;
+    uint64_t position = t.getMinPos();
+    const bool withQualities = extended && qvcoder && !t.get(GenDesc::QV).isEmpty();
+    std::vector<RecordInfo> records;
+    for (size_t r = 0, segments = 0; segments < t.getNumReads(); ++r) {
+        auto rec = readRecord(t, r, position);
+        segments += rec.numSegments;
+        if (withQualities) {
+            records.emplace_back(std::move(rec));
+        } else if (inRegion(rec)) {
+            count(rec, {{nullptr, nullptr}}, local);
+        }
+    }
+
+    if (withQualities) {
+        std::vector<std::string> ecigars;
+        std::vector<uint64_t> positions;
+        for (const auto& rec : records) {
+            for (size_t s = 0; s < rec.numSegments; ++s) {
+                const auto& segment = rec.segments[s];
+                if (segment.strand == api::Strand::UNMAPPED_UNKNOWN) {
+                    ecigars.emplace_back(std::to_string(segment.length) + '+');
+                    positions.emplace_back(std::numeric_limits<uint64_t>::max());
+                } else {
+                    ecigars.emplace_back(segment.getECigar());
+                    positions.emplace_back(segment.position);
+                }
+            }
+        }
+        auto qvs = qvcoder->process(t.getParameters().getQVConfig(t.getClassType()), ecigars, positions,
+                                    t.get(GenDesc::QV));
+        const auto& qualities = std::get<0>(qvs);
+        size_t segment = 0;
+        for (const auto& rec : records) {
+            std::array<const std::string*, 2> q{{nullptr, nullptr}};
+            for (size_t s = 0; s < rec.numSegments; ++s, ++segment) {
+                if (segment < qualities.size() && !qualities[segment].empty()) {
+                    q[s] = &qualities[segment];
+                }
+            }
+            if (inRegion(rec)) {
+                count(rec, q, local);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (size_t i = 0; i < local.size(); ++i) {
+        totals[i].merge(std::move(local[i]));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+api::SimpleSegmentStatistics StatisticsDecoder::getSimpleStatistics() {
+    std::lock_guard<std::mutex> guard(lock);
+    Accumulator all;
+    for (const auto& t : totals) {
+        all.merge(Accumulator(t));
+    }
+    return toSimple(all);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+api::AdvancedSegmentStatistics StatisticsDecoder::getAdvancedStatistics() {
+    std::lock_guard<std::mutex> guard(lock);
+    api::AdvancedSegmentStatistics ret{};
+    for (auto strand : {api::StrandStrict::FORWARD, api::StrandStrict::REVERSE}) {
+        const auto& acc = totals[strand == api::StrandStrict::FORWARD ? uint8_t(api::Strand::FORWARD)
+                                                                       : uint8_t(api::Strand::REVERSE)];
+        ret.simpleStatistics[uint8_t(strand)] = toSimple(acc);
+        ret.extendedStatistics[uint8_t(strand)] = toExtended(acc);
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,278 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_CORE_STATISTICS_DECODER_H_
+#define SRC_GENIE_CORE_STATISTICS_DECODER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "genie/core/access-unit.h"
+#include "genie/core/api.h"
+#include "genie/core/read-decoder.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace core {
+
+/**
+ * @brief Computes segment statistics of the aligned records overlapping a region directly from the entropy decoded
+ * descriptor streams (pos, rcomp, rlen, mmpos, mmtype, clips, flags, mscore and optionally qv) of base coded access
+ * units, without reconstructing records or sequences. Each access unit is processed by the thread decoding it and
+ * merged into the total afterwards. No records are passed on.
+ *
+ * The reference base of substitutions is only known for access units decoded against an external reference, it is
+ * counted as N otherwise. Base composition and splices are not available from the descriptors and stay empty. If the
+ * region has no end, the coverage is reported from the first to the last covered position.
+ */
+class StatisticsDecoder : public ReadDecoder {
+ public:
+    static constexpr size_t QUALITY_RANGE = 94;  //!< @brief Phred scores 0 to 93
+
+    /**
+     * @brief Minimum, maximum and mean of a value
+     */
+    struct Summary {
+        uint64_t min{std::numeric_limits<uint64_t>::max()};  //!< @brief
+        uint64_t max{0};                                     //!< @brief
+        uint64_t sum{0};                                     //!< @brief
+        uint64_t count{0};                                   //!< @brief
+
+        /**
+         * @brief
+         * @param value Observation
+         * @param times Number of times it was observed
+         */
+        void add(uint64_t value, uint64_t times = 1);
+
+        /**
+         * @brief
+         * @param other Observations to add
+         */
+        void merge(const Summary& other);
+
+        /**
+         * @brief
+         * @return Minimum, maximum and average as indexed by api::StatisticsIndex, all 0 without observations
+         */
+        std::array<uint64_t, uint8_t(api::StatisticsIndex::COUNT)> get() const;
+    };
+
+    /**
+     * @brief Counts of one strand, mergeable across access units
+     */
+    struct Accumulator {
+        uint64_t reads{0};                                                        //!< @brief
+        std::vector<uint64_t> segmentsPerRead;                                    //!< @brief
+        uint64_t qualityCheckFailed{0};                                           //!< @brief
+        uint64_t properlyPaired{0};                                               //!< @brief
+        uint64_t opticalDuplicates{0};                                            //!< @brief
+        uint64_t chimeras{0};                                                     //!< @brief
+        std::array<uint64_t, uint8_t(api::StrandPaired::COUNT)> pairStrands{};    //!< @brief
+        std::array<uint64_t, uint8_t(api::Strand::COUNT)> segmentStrands{};       //!< @brief
+        std::array<uint64_t, uint8_t(record::ClassType::COUNT)> segmentClasses{};  //!< @brief By class ID - 1
+        std::array<uint64_t, uint8_t(api::ClipTypeCombination::COUNT)> segmentClips{};  //!< @brief
+        uint64_t alignedSegments{0};                                                     //!< @brief
+
+        Summary segmentLength;     //!< @brief
+        Summary errors;            //!< @brief Substituted, inserted and deleted bases
+        Summary substitutions;     //!< @brief
+        Summary insertions;        //!< @brief
+        Summary insertionsLength;  //!< @brief
+        Summary deletions;         //!< @brief
+        Summary deletionsLength;   //!< @brief
+        Summary alignmentScore;    //!< @brief
+
+        std::vector<uint64_t> mappedBasesDistribution;         //!< @brief Extended only
+        std::vector<uint64_t> errorsDistribution;              //!< @brief Extended only
+        std::vector<uint64_t> substitutionsDistribution;       //!< @brief Extended only
+        std::vector<uint64_t> insertionsDistribution;          //!< @brief Extended only
+        std::vector<uint64_t> insertionsLengthDistribution;    //!< @brief Extended only
+        std::vector<uint64_t> deletionsDistribution;           //!< @brief Extended only
+        std::vector<uint64_t> deletionsLengthDistribution;     //!< @brief Extended only
+        std::vector<uint64_t> alignmentScoreDistribution;      //!< @brief Extended only
+        std::vector<uint64_t> errorsPositions;                 //!< @brief Extended only
+        std::vector<uint64_t> substitutionsPositions;          //!< @brief Extended only
+        std::vector<uint64_t> insertionsPositions;             //!< @brief Extended only
+        std::vector<uint64_t> deletionsPositions;              //!< @brief Extended only
+        std::vector<Summary> alignmentScoreBySegmentLength;    //!< @brief Extended only
+        std::vector<std::array<std::array<uint64_t, api::ACGTN_SIZE>, api::ACGTN_SIZE>>
+            substitutionsTransitions;                                         //!< @brief Extended only, [ref][base]
+        std::vector<uint64_t> qualityScores;                                   //!< @brief Extended only
+        std::vector<std::array<uint64_t, QUALITY_RANGE>> qualityByPosition;  //!< @brief Extended only
+
+        std::vector<std::pair<uint64_t, int64_t>> coverageChanges;  //!< @brief Coverage change by position, unordered
+        size_t compactedChanges{0};                                  //!< @brief Size after the last compactCoverage()
+
+        /**
+         * @brief Add the counts of another accumulator
+         * @param other Counts to add, left in an unspecified state
+         */
+        void merge(Accumulator&& other);
+
+        /**
+         * @brief Change the coverage of a range
+         * @param start First reference position
+         * @param end Reference position after the last one
+         */
+        void cover(uint64_t start, uint64_t end);
+
+        /**
+         * @brief Sort the coverage changes and combine those at the same reference position
+         */
+        void compactCoverage();
+    };
+
+    /**
+     * @brief A segment as far as it is known from the descriptors
+     */
+    struct SegmentInfo {
+        /**
+         * @brief Substitution, insertion or deletion of one base
+         */
+        struct Mismatch {
+            uint64_t position;  //!< @brief Position in the segment sequence
+            uint8_t type;       //!< @brief GenConst::MMTYPE_*
+            uint8_t ref;        //!< @brief Reference base of substitutions, index in ACGTN
+            uint8_t base;       //!< @brief Substituted base, index in ACGTN
+        };
+
+        api::Strand strand{api::Strand::UNMAPPED_UNKNOWN};  //!< @brief
+        uint64_t position{0};                                //!< @brief First mapped reference position
+        uint64_t length{0};                                  //!< @brief Sequence length including soft clips
+        std::array<uint64_t, 2> softClips{};                 //!< @brief Start and end
+        std::array<uint64_t, 2> hardClips{};                 //!< @brief Start and end
+        bool hasScore{false};                                //!< @brief
+        uint64_t score{0};                                   //!< @brief
+        std::vector<Mismatch> mismatches;                    //!< @brief In sequence order
+
+        /**
+         * @brief
+         * @return Number of reference bases covered by the alignment
+         */
+        uint64_t getReferenceLength() const;
+
+        /**
+         * @brief
+         * @return Extended CIGAR as produced by the base decoder
+         */
+        std::string getECigar() const;
+    };
+
+    /**
+     * @brief
+     */
+    struct RecordInfo {
+        record::ClassType type{record::ClassType::NONE};  //!< @brief
+        uint8_t flags{0};                                 //!< @brief
+        bool chimeric{false};                             //!< @brief Mate mapped to another sequence
+        bool paired{false};                               //!< @brief Two template segments
+        std::array<SegmentInfo, 2> segments;              //!< @brief
+        uint8_t numSegments{1};                           //!< @brief Segments in this record
+    };
+
+ private:
+    uint16_t sequenceID;  //!< @brief Region
+    uint64_t startPos;    //!< @brief Region, inclusive
+    uint64_t endPos;      //!< @brief Region, inclusive
+    bool extended;        //!< @brief If the extended statistics are computed
+
+    std::mutex lock;                                                 //!< @brief Protects the totals
+    std::array<Accumulator, uint8_t(api::Strand::COUNT)> totals;  //!< @brief By segment strand
+
+    /**
+     * @brief Parse the descriptors of the next record
+     * @param au Entropy decoded access unit
+     * @param recordIndex Index of the record in the access unit
+     * @param position Position of the previous record, updated
+     * @return Record
+     */
+    RecordInfo readRecord(AccessUnit& au, size_t recordIndex, uint64_t& position) const;
+
+    /**
+     * @brief
+     * @param rec Record
+     * @return True if a mapped segment overlaps the region
+     */
+    bool inRegion(const RecordInfo& rec) const;
+
+    /**
+     * @brief Count a record
+     * @param rec Record
+     * @param qualities Quality values of the segments, empty if unknown
+     * @param acc Accumulators by segment strand
+     */
+    void count(const RecordInfo& rec, const std::array<const std::string*, 2>& qualities,
+               std::array<Accumulator, uint8_t(api::Strand::COUNT)>& acc) const;
+
+    /**
+     * @brief
+     * @param acc Counts of one or more strands
+     * @return Simple statistics
+     */
+    api::SimpleSegmentStatistics toSimple(const Accumulator& acc) const;
+
+    /**
+     * @brief
+     * @param acc Counts of one strand
+     * @return Extended statistics
+     */
+    api::ExtendedSegmentStatistics toExtended(const Accumulator& acc) const;
+
+ public:
+    /**
+     * @brief
+     * @param _sequenceID Reference sequence of the region
+     * @param _startPos First position of the region
+     * @param _endPos Last position of the region
+     * @param _extended If the extended statistics are computed, which requires decoding quality values
+     */
+    StatisticsDecoder(uint16_t _sequenceID, uint64_t _startPos, uint64_t _endPos, bool _extended);
+
+    /**
+     * @brief Entropy decode the access unit and count its records
+     * @param t Access unit
+     * @param id Section of the access unit, skipped downstream
+     */
+    void flowIn(AccessUnit&& t, const util::Section& id) override;
+
+    /**
+     * @brief Count the records of an entropy decoded access unit. Thread safe.
+     * @param au Access unit
+     */
+    void add(AccessUnit&& au);
+
+    /**
+     * @brief
+     * @return Statistics of all strands
+     */
+    api::SimpleSegmentStatistics getSimpleStatistics();
+
+    /**
+     * @brief
+     * @return Statistics by strand
+     */
+    api::AdvancedSegmentStatistics getAdvancedStatistics();
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace core
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_CORE_STATISTICS_DECODER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -7,7 +7,9 @@
 #include "genie/core/stats/perf-stats.h"
 #include <algorithm>
 #include <iomanip>
+#include <mutex>
 #include <ostream>
+#include <unordered_map>
 #include "genie/util/runtime-exception.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -28,68 +30,173 @@ double PerfStats::Stat::avg() const {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Global table of metric names
+ */
+struct StatRegistry {
+    std::mutex lock;                               //!< @brief
+    std::map<std::string, PerfStats::StatID> ids;  //!< @brief
+    std::vector<std::string> names;                //!< @brief
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static StatRegistry& getRegistry() {
+    static StatRegistry registry;
+    return registry;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::atomic<bool> PerfStats::defaultActive(true);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+PerfStats::StatID PerfStats::intern(const std::string& name) {
+    // Names seen before by this thread are resolved without touching the global lock
+    thread_local std::unordered_map<std::string, StatID> cache;
+    auto cached = cache.find(name);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    auto it = registry.ids.find(name);
+    if (it == registry.ids.end()) {
+        it = registry.ids.emplace(name, static_cast<StatID>(registry.names.size())).first;
+        registry.names.push_back(name);
+    }
+    cache.emplace(name, it->second);
+    return it->second;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string PerfStats::getName(StatID id) {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    UTILS_DIE_IF(id >= registry.names.size(), "Unknown statistics ID");
+    return registry.names[id];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void PerfStats::setDefaultActive(bool flag) { defaultActive = flag; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+PerfStats::PerfStats() : active(defaultActive) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void PerfStats::addSample(StatID id, bool isInteger, Data dat) {
+    if (id >= data.size()) {
+        data.resize(id + 1);
+    }
+    auto& s = data[id];
+    if (s.ctr == 0) {
+        s.isInteger = isInteger;
+        s.min = dat;
+        s.sum = dat;
+        s.max = dat;
+        s.ctr = 1;
+        return;
+    }
+    UTILS_DIE_IF(s.isInteger != isInteger, "Tried to combine integer and floating point numbers in statistics");
+    s.ctr++;
+    if (isInteger) {
+        s.min.iData = std::min(s.min.iData, dat.iData);
+        s.max.iData = std::max(s.max.iData, dat.iData);
+        s.sum.iData += dat.iData;
+    } else {
+        s.min.fData = std::min(s.min.fData, dat.fData);
+        s.max.fData = std::max(s.max.fData, dat.fData);
+        s.sum.fData += dat.fData;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void PerfStats::addDouble(const std::string& name, double dat) {
-    Stat s;
-    s.isInteger = false;
-    s.min.fData = dat;
-    s.sum.fData = dat;
-    s.max.fData = dat;
-    s.ctr = 1;
-    add(name, s);
+    if (active) {
+        addDouble(intern(name), dat);
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 void PerfStats::addInteger(const std::string& name, int64_t dat) {
-    Stat s;
-    s.isInteger = true;
-    s.min.iData = dat;
-    s.sum.iData = dat;
-    s.max.iData = dat;
-    s.ctr = 1;
-    add(name, s);
+    if (active) {
+        addInteger(intern(name), dat);
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void PerfStats::add(const std::string& name, const Stat& s) {
-    if (!active) {
+void PerfStats::add(StatID id, const Stat& s) {
+    if (!active || s.ctr == 0) {
+        return;
+    }
+    if (id >= data.size()) {
+        data.resize(id + 1);
+    }
+    auto& it = data[id];
+    if (it.ctr == 0) {
+        it = s;
         return;
     }
-    auto it = data.find(name);
-    if (it == data.end()) {
-        data[name] = s;
+    it.ctr += s.ctr;
+    UTILS_DIE_IF(it.isInteger != s.isInteger, "Tried to combine integer and floating point numbers in statistics");
+    if (it.isInteger) {
+        it.min.iData = std::min(it.min.iData, s.min.iData);
+        it.max.iData = std::max(it.max.iData, s.max.iData);
+        it.sum.iData += s.sum.iData;
     } else {
-        it->second.ctr += s.ctr;
-        UTILS_DIE_IF(it->second.isInteger != s.isInteger,
-                     "Tried to combine integer and floating point numbers in statistics");
-        if (it->second.isInteger) {
-            it->second.min.iData = std::min(it->second.min.iData, s.min.iData);
-            it->second.max.iData = std::max(it->second.max.iData, s.max.iData);
-            it->second.sum.iData += s.sum.iData;
-        } else {
-            it->second.min.fData = std::min(it->second.min.fData, s.min.fData);
-            it->second.max.fData = std::max(it->second.max.fData, s.max.fData);
-            it->second.sum.fData += s.sum.fData;
-        }
+        it.min.fData = std::min(it.min.fData, s.min.fData);
+        it.max.fData = std::max(it.max.fData, s.max.fData);
+        it.sum.fData += s.sum.fData;
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void PerfStats::add(const PerfStats& stats) {
-    for (const auto& p : stats.data) {
-        add(p.first, p.second);
+void PerfStats::add(const std::string& name, const Stat& s) {
+    if (active) {
+        add(intern(name), s);
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-std::map<std::string, PerfStats::Stat>::const_iterator PerfStats::begin() const { return data.begin(); }
+void PerfStats::add(const PerfStats& stats) {
+    if (!active) {
+        return;
+    }
+    // Trailing IDs without samples must not grow this instance
+    size_t used = stats.data.size();
+    while (used && stats.data[used - 1].ctr == 0) {
+        used--;
+    }
+    if (used > data.size()) {
+        data.resize(used);
+    }
+    for (size_t i = 0; i < used; ++i) {
+        add(static_cast<StatID>(i), stats.data[i]);
+    }
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-std::map<std::string, PerfStats::Stat>::const_iterator PerfStats::end() const { return data.end(); }
+std::map<std::string, PerfStats::Stat> PerfStats::getAll() const {
+    std::map<std::string, Stat> ret;
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (data[i].ctr) {
+            ret.emplace(getName(static_cast<StatID>(i)), data[i]);
+        }
+    }
+    return ret;
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -102,7 +209,7 @@ bool PerfStats::isActive() const { return active; }
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::ostream& operator<<(std::ostream& stream, const PerfStats& stats) {
-    for (const auto& s : stats) {
+    for (const auto& s : stats.getAll()) {
         stream << std::setw(40) << std::left << s.first;
         if (s.second.isInteger) {
             //   stream << "min: " << std::setw(16) << std::left << std::fixed << s.second.min.iData;
@@ -9,9 +9,11 @@
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -20,10 +22,14 @@ namespace core {
 namespace stats {
 
 /**
- * @brief
+ * @brief Performance statistics. Metric names are interned once into integer IDs, so that hot paths only index
+ * into a flat counter array. Every chunk of data carries its own instance, which is merged into the exporter's
+ * statistics in stream order. Names are only resolved again when reporting.
  */
 class PerfStats {
  public:
+    using StatID = uint32_t;  //!< @brief Interned metric name
+
     /**
      * @brief
      */
@@ -42,7 +48,7 @@ class PerfStats {
         Data min{};        //!< @brief
         Data sum{};        //!< @brief
         Data max{};        //!< @brief
-        uint64_t ctr{};    //!< @brief
+        uint64_t ctr{};    //!< @brief Number of samples, zero if the metric was never set
 
         /**
          * @brief
@@ -51,6 +57,58 @@ class PerfStats {
         double avg() const;
     };
 
+    /**
+     * @brief Get the ID of a metric name, registering it if necessary. Thread safe. Hot paths should look up their
+     * IDs once and reuse them.
+     * @param name Metric name
+     * @return ID of the metric
+     */
+    static StatID intern(const std::string& name);
+
+    /**
+     * @brief
+     * @param id Metric ID
+     * @return Name the ID was registered with
+     */
+    static std::string getName(StatID id);
+
+    /**
+     * @brief Enable or disable statistics for all instances created afterwards. Disabled instances drop all samples.
+     * @param flag If statistics should be collected
+     */
+    static void setDefaultActive(bool flag);
+
+    /**
+     * @brief
+     */
+    PerfStats();
+
+    /**
+     * @brief
+     * @param id
+     * @param dat
+     */
+    void addDouble(StatID id, double dat) {
+        if (active) {
+            Data d;
+            d.fData = dat;
+            addSample(id, false, d);
+        }
+    }
+
+    /**
+     * @brief
+     * @param id
+     * @param dat
+     */
+    void addInteger(StatID id, int64_t dat) {
+        if (active) {
+            Data d;
+            d.iData = dat;
+            addSample(id, true, d);
+        }
+    }
+
     /**
      * @brief
      * @param name
@@ -67,28 +125,29 @@ class PerfStats {
 
     /**
      * @brief
-     * @param name
+     * @param id
      * @param s
      */
-    void add(const std::string& name, const Stat& s);
+    void add(StatID id, const Stat& s);
 
     /**
      * @brief
-     * @param stats
+     * @param name
+     * @param s
      */
-    void add(const PerfStats& stats);
+    void add(const std::string& name, const Stat& s);
 
     /**
      * @brief
-     * @return
+     * @param stats
      */
-    std::map<std::string, Stat>::const_iterator begin() const;
+    void add(const PerfStats& stats);
 
     /**
-     * @brief
-     * @return
+     * @brief Resolve the metric names
+     * @return All metrics which were set, sorted by name
      */
-    std::map<std::string, Stat>::const_iterator end() const;
+    std::map<std::string, Stat> getAll() const;
 
     /**
      * @brief
@@ -103,8 +162,18 @@ class PerfStats {
     bool isActive() const;
 
  private:
-    bool active{true};                 //!< @brief
-    std::map<std::string, Stat> data;  //!< @brief
+    static std::atomic<bool> defaultActive;  //!< @brief Initial state of new instances
+
+    bool active;             //!< @brief
+    std::vector<Stat> data;  //!< @brief Indexed by metric ID
+
+    /**
+     * @brief Add a single sample
+     * @param id Metric ID
+     * @param isInteger Type of the sample
+     * @param dat Sample
+     */
+    void addSample(StatID id, bool isInteger, Data dat);
 };
 
 /**
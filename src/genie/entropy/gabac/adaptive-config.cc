@@ -0,0 +1,532 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/entropy/gabac/adaptive-config.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include "genie/entropy/gabac/bin-params.h"
+#include "genie/entropy/gabac/encode-desc-subseq.h"
+#include "genie/entropy/gabac/encode-transformed-subseq.h"
+#include "genie/util/watch.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace entropy {
+namespace gabac {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Result of one trial encoding
+ */
+struct Trial {
+    size_t size{};     //!< @brief Compressed size in bytes
+    double seconds{};  //!< @brief Time spent
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Variations of a transformed subsequence configuration. The first entry is the configuration itself.
+ * @param base Configuration to vary
+ * @param sub Subsequence
+ * @param original If this is the last transformed subsequence
+ * @param isUnsigned If the symbols are unsigned
+ * @return Configurations
+ */
+static std::vector<paramcabac::TransformedSubSeq> getStreamVariants(const paramcabac::TransformedSubSeq &base,
+                                                                    const core::GenSubIndex sub, const bool original,
+                                                                    const bool isUnsigned) {
+    using BinId = paramcabac::BinarizationParameters::BinarizationId;
+    const auto &support = base.getSupportValues();
+    const auto &binarization = base.getBinarization();
+    const bool lut = base.getTransformIDSubsym() == paramcabac::SupportValues::TransformIdSubsym::LUT_TRANSFORM;
+
+    std::vector<BinId> binIDs = {binarization.getBinarizationID()};
+    if (isUnsigned && binIDs.front() != BinId::EG && getUnsignedBinarization(binIDs.front()) == binIDs.front()) {
+        binIDs.push_back(BinId::EG);
+    }
+
+    auto make = [&](BinId binID, uint8_t order, bool bypass) {
+        auto binParams = binID == binarization.getBinarizationID()
+                             ? binarization.getCabacBinarizationParameters()
+                             : paramcabac::BinarizationParameters(binID, std::vector<uint8_t>(2, 0));
+        auto context = binarization.getCabacContextParameters();
+        return paramcabac::TransformedSubSeq(
+            base.getTransformIDSubsym(),
+            paramcabac::SupportValues(support.getOutputSymbolSize(), support.getCodingSubsymSize(), order,
+                                      support.getShareSubsymLutFlag(), support.getShareSubsymPrvFlag()),
+            paramcabac::Binarization(binID, bypass, std::move(binParams), std::move(context)), sub, original);
+    };
+
+    std::vector<paramcabac::TransformedSubSeq> ret = {base};
+    for (const auto binID : binIDs) {
+        // Coding orders are only tried while the number of context sets stays small
+        for (uint8_t order = 0; order <= 2; ++order) {
+            const bool isBase = binID == binarization.getBinarizationID() && order == support.getCodingOrder();
+            if (!isBase && (order > 0 || !lut) && support.getCodingSubsymSize() * order <= 8) {
+                ret.emplace_back(make(binID, order, binarization.getBypassFlag()));
+            }
+        }
+        if (!binarization.getBypassFlag() && !lut) {
+            // The lookup table needs context coding. Without it, the coding order has no effect in bypass mode.
+            ret.emplace_back(make(binID, support.getCodingOrder(), true));
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Subsequence transformations to try. The first entry is the manual configuration. The last transformed
+ * subsequence of the manual configuration carries the symbol values and is reused by the other transformations.
+ * @param manual Manual configuration
+ * @param sub Subsequence
+ * @param isUnsigned If the symbols are unsigned
+ * @return Configurations
+ */
+static std::vector<paramcabac::Subsequence> getTransformCandidates(const paramcabac::Subsequence &manual,
+                                                                   const core::GenSubIndex sub, const bool isUnsigned) {
+    using TransformId = paramcabac::TransformedParameters::TransformIdSubseq;
+    using BinId = paramcabac::BinarizationParameters::BinarizationId;
+    std::vector<paramcabac::Subsequence> ret = {manual};
+
+    const auto manualID = manual.getTransformParameters().getTransformIdSubseq();
+    if (!isUnsigned || (manualID != TransformId::NO_TRANSFORM && manualID != TransformId::EQUALITY_CODING &&
+                        manualID != TransformId::RLE_CODING)) {
+        return ret;
+    }
+    const auto &values = manual.getTransformSubseqCfgs().back();
+
+    auto make = [&](TransformId id, std::vector<paramcabac::TransformedSubSeq> &&streams) {
+        streams.push_back(values);
+        return paramcabac::Subsequence(paramcabac::TransformedParameters(id, 255), manual.getDescriptorSubsequenceID(),
+                                       false, std::move(streams));
+    };
+
+    if (manualID != TransformId::NO_TRANSFORM) {
+        ret.emplace_back(make(TransformId::NO_TRANSFORM, {}));
+    }
+    if (manualID != TransformId::EQUALITY_CODING) {
+        // One bit equality flags
+        std::vector<paramcabac::TransformedSubSeq> streams;
+        streams.emplace_back(
+            paramcabac::SupportValues::TransformIdSubsym::NO_TRANSFORM, paramcabac::SupportValues(1, 1, 2),
+            paramcabac::Binarization(BinId::BI, false, paramcabac::BinarizationParameters(BinId::BI, {0, 0}),
+                                     paramcabac::Context(true, 1, 1, false)),
+            sub, false);
+        ret.emplace_back(make(TransformId::EQUALITY_CODING, std::move(streams)));
+    }
+    if (manualID != TransformId::RLE_CODING) {
+        // Run lengths with a guard of 255
+        std::vector<paramcabac::TransformedSubSeq> streams;
+        streams.emplace_back(
+            paramcabac::SupportValues::TransformIdSubsym::NO_TRANSFORM, paramcabac::SupportValues(8, 8, 0),
+            paramcabac::Binarization(BinId::EG, false, paramcabac::BinarizationParameters(BinId::EG, {0, 0}),
+                                     paramcabac::Context(true, 8, 8, false)),
+            sub, false);
+        ret.emplace_back(make(TransformId::RLE_CODING, std::move(streams)));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Encode one transformed subsequence
+ * @param conf Configuration
+ * @param symbols Transformed subsequence
+ * @return Size and time
+ */
+static Trial encodeStream(const paramcabac::TransformedSubSeq &conf, const util::DataBlock &symbols) {
+    Trial ret;
+    if (symbols.empty()) {
+        return ret;
+    }
+    auto input = symbols;
+    util::Watch watch;
+    ret.size = encodeTransformSubseq(conf, &input);
+    ret.seconds = watch.check();
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+constexpr size_t AdaptiveConfigSelector::MAX_ROUNDS;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+AdaptiveConfigSelector::AdaptiveConfigSelector(float _timeWeight, size_t _sampleSize, size_t _interval)
+    : timeWeight(_timeWeight), sampleSize(_sampleSize), interval(_interval), waiting(nullptr) {
+    UTILS_DIE_IF(timeWeight < 0.0f || timeWeight > 1.0f, "Time weight must be between 0 and 1");
+    UTILS_DIE_IF(sampleSize == 0, "Sample size must not be 0");
+    slots.resize(core::getDescriptors().size());
+    for (const auto &desc : core::getDescriptors()) {
+        auto &subseqs = slots[uint8_t(desc.id)];
+        subseqs.resize(desc.subseqs.size());
+        for (auto &rounds : subseqs) {
+            rounds = std::vector<Round>(interval ? MAX_ROUNDS : 1);
+        }
+    }
+    owners.resize(interval ? MAX_ROUNDS : 1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t AdaptiveConfigSelector::getRound(uint64_t record) const {
+    return interval ? size_t(std::min<uint64_t>(record / interval, MAX_ROUNDS - 1)) : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t AdaptiveConfigSelector::getRoundEnd(size_t round) const {
+    return interval && round < MAX_ROUNDS - 1 ? (round + 1) * interval : std::numeric_limits<uint64_t>::max();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool AdaptiveConfigSelector::isKnown(uint64_t from, uint64_t to) const {
+    if (from >= to) {
+        return true;
+    }
+    auto it = known.upper_bound(from);
+    if (it == known.begin()) {
+        return false;
+    }
+    return std::prev(it)->second >= to;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AdaptiveConfigSelector::addKnown(uint64_t from, uint64_t to) {
+    if (from >= to) {
+        return;
+    }
+    auto it = known.upper_bound(from);
+    if (it != known.begin() && std::prev(it)->second >= from) {
+        from = std::prev(it)->first;
+        to = std::max(to, std::prev(it)->second);
+        known.erase(std::prev(it));
+    }
+    while (it != known.end() && it->first <= to) {
+        to = std::max(to, it->second);
+        it = known.erase(it);
+    }
+    known.emplace(from, to);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool AdaptiveConfigSelector::arrive(const util::Section &records) {
+    addKnown(records.start, records.start + records.length);
+    auto &owner = owners[getRound(records.start)];
+    owner.first = std::min<uint64_t>(owner.first, records.start);
+    return update();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool AdaptiveConfigSelector::update() {
+    bool ret = false;
+    for (size_t index = 0; index < owners.size(); ++index) {
+        auto &owner = owners[index];
+        const bool empty = owner.first == std::numeric_limits<uint64_t>::max();
+        // Without access unit, the round is over once all its records are known
+        if (owner.final || !isKnown(index * interval, empty ? getRoundEnd(index) : owner.first)) {
+            continue;
+        }
+        owner.final = true;
+        for (auto &subseqs : slots) {
+            for (auto &rounds : subseqs) {
+                auto &round = rounds[index];
+                if (round.state != Round::State::OPEN) {
+                    continue;
+                }
+                const auto offer = round.offers.find(owner.first);
+                if (empty || offer != round.offers.end()) {
+                    settle(round, empty ? nullptr : offer->second);
+                    ret = true;
+                } else {
+                    // The first access unit offers later and decides right away
+                    round.offers.clear();
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool AdaptiveConfigSelector::offer(Round &round, size_t index, uint64_t first,
+                                   std::shared_ptr<const EncodingConfiguration> conf) {
+    const auto &owner = owners[index];
+    if (round.state != Round::State::OPEN || first != owner.first) {
+        return false;
+    }
+    if (owner.final) {
+        settle(round, std::move(conf));
+        return true;
+    }
+    round.offers[first] = std::move(conf);
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AdaptiveConfigSelector::settle(Round &round, std::shared_ptr<const EncodingConfiguration> conf) {
+    round.conf = std::move(conf);
+    round.state = round.conf ? Round::State::SELECTED : Round::State::INHERITED;
+    round.offers.clear();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AdaptiveConfigSelector::wakeUp() const {
+    decided.notify_all();
+    auto *scheduler = waiting.load();
+    if (scheduler) {
+        scheduler->wakeUp();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::shared_ptr<const EncodingConfiguration> AdaptiveConfigSelector::resolve(const core::GenSubIndex sub,
+                                                                             size_t round) const {
+    const auto &rounds = slots[uint8_t(sub.first)][uint8_t(sub.second)];
+    while (true) {
+        const auto &r = rounds[round];
+        auto isDecided = [&r]() -> bool { return r.state != Round::State::OPEN; };
+        if (!isDecided()) {
+            // Helping keeps the scheduler busy with the sections the round may be waiting for
+            auto *scheduler = util::TaskScheduler::getCurrent();
+            if (scheduler && scheduler->isWorkerThread()) {
+                waiting = scheduler;
+                scheduler->helpUntil(isDecided);
+            } else {
+                std::unique_lock<std::mutex> guard(lock);
+                decided.wait(guard, isDecided);
+            }
+        }
+        if (r.state == Round::State::SELECTED) {
+            return r.conf;
+        }
+        if (round == 0) {
+            return nullptr;
+        }
+        round--;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AdaptiveConfigSelector::begin(core::AccessUnit::Descriptor &desc, const util::Section &records) {
+    bool settled = false;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        settled = arrive(records);
+        if (!core::getDescriptor(desc.getID()).tokentype) {
+            auto &subseqs = slots[uint8_t(desc.getID())];
+            std::vector<bool> selecting(subseqs.size(), false);
+            for (auto &s : desc) {
+                if (!s.isEmpty() && isAdaptable(s.getID(), s.getDependency() != nullptr)) {
+                    selecting[uint8_t(s.getID().second)] = true;
+                }
+            }
+            const size_t index = getRound(records.start);
+            for (size_t i = 0; i < subseqs.size(); ++i) {
+                if (!selecting[i]) {
+                    settled = offer(subseqs[i][index], index, records.start, nullptr) || settled;
+                }
+            }
+        }
+    }
+    if (settled) {
+        wakeUp();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool AdaptiveConfigSelector::isAdaptable(const core::GenSubIndex sub, const bool hasDependency) {
+    return !core::getDescriptor(sub.first).tokentype && !hasDependency &&
+           paramcabac::StateVars::getNumAlphaSpecial(sub, core::AlphabetID::ACGTN) == 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+paramcabac::Subsequence AdaptiveConfigSelector::search(const util::DataBlock &sample,
+                                                       const paramcabac::Subsequence &manual,
+                                                       const core::GenSubIndex sub, const float timeWeight) {
+    const bool isUnsigned = core::getSubsequence(sub).range.first >= 0;
+    auto candidates = getTransformCandidates(manual, sub, isUnsigned);
+
+    // Run all trials first, the manual configuration (first variant of the first candidate) is the reference
+    std::vector<double> transformSeconds;
+    std::vector<size_t> overheads;
+    std::vector<std::vector<std::vector<paramcabac::TransformedSubSeq>>> variants;
+    std::vector<std::vector<std::vector<Trial>>> trials;
+    for (const auto &candidate : candidates) {
+        std::vector<util::DataBlock> streams(1, sample);
+        util::Watch watch;
+        doSubsequenceTransform(candidate, &streams);
+        transformSeconds.push_back(watch.check());
+
+        // Sizes of the transformed subsequences and their symbol counts
+        overheads.push_back(streams.size() > 1 ? streams.size() * 8 - 4 : 0);
+        variants.emplace_back();
+        trials.emplace_back();
+        for (size_t i = 0; i < streams.size(); ++i) {
+            variants.back().emplace_back(getStreamVariants(candidate.getTransformSubseqCfg(uint8_t(i)), sub,
+                                                           i == streams.size() - 1, isUnsigned));
+            trials.back().emplace_back();
+            for (const auto &variant : variants.back().back()) {
+                trials.back().back().push_back(encodeStream(variant, streams[i]));
+            }
+        }
+    }
+
+    Trial reference;
+    reference.size = overheads.front();
+    reference.seconds = transformSeconds.front();
+    for (const auto &stream : trials.front()) {
+        reference.size += stream.front().size;
+        reference.seconds += stream.front().seconds;
+    }
+    if (reference.size == 0) {
+        return manual;
+    }
+    const double refSeconds = std::max(reference.seconds, 1e-9);
+    auto score = [&](size_t size, double seconds) {
+        return (1.0 - timeWeight) * double(size) / double(reference.size) + timeWeight * seconds / refSeconds;
+    };
+
+    // Transformed subsequences are independent, so the best variant of each one is chosen separately
+    double bestScore = std::numeric_limits<double>::infinity();
+    size_t bestCandidate = 0;
+    std::vector<size_t> bestVariants;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        double candidateScore = score(overheads[c], transformSeconds[c]);
+        std::vector<size_t> chosen;
+        for (const auto &stream : trials[c]) {
+            size_t best = 0;
+            for (size_t v = 1; v < stream.size(); ++v) {
+                if (score(stream[v].size, stream[v].seconds) < score(stream[best].size, stream[best].seconds)) {
+                    best = v;
+                }
+            }
+            candidateScore += score(stream[best].size, stream[best].seconds);
+            chosen.push_back(best);
+        }
+        if (candidateScore < bestScore) {
+            bestScore = candidateScore;
+            bestCandidate = c;
+            bestVariants = std::move(chosen);
+        }
+    }
+
+    auto ret = std::move(candidates[bestCandidate]);
+    for (size_t i = 0; i < bestVariants.size(); ++i) {
+        ret.setTransformSubseqCfg(i, std::move(variants[bestCandidate][i][bestVariants[i]]));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::shared_ptr<const EncodingConfiguration> AdaptiveConfigSelector::select(core::AccessUnit::Subsequence &data,
+                                                                            const EncodingConfiguration &manual,
+                                                                            const util::Section &records) {
+    const auto id = data.getID();
+    if (!isAdaptable(id, data.getDependency() != nullptr)) {
+        return std::make_shared<const EncodingConfiguration>(manual);
+    }
+
+    const size_t index = getRound(records.start);
+    auto &round = slots[uint8_t(id.first)][uint8_t(id.second)][index];
+    bool settled = false;
+    bool selecting = false;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        settled = arrive(records);
+        // Access units arriving before an earlier one of their round select in vain
+        selecting = round.state == Round::State::OPEN && owners[index].first == records.start;
+    }
+    if (selecting) {
+        const auto &block = data.getData();
+        const size_t count = std::min<size_t>(sampleSize, block.size());
+        util::DataBlock sample(0, block.getWordSize());
+        if (count == block.size()) {
+            sample = block;
+        } else {
+            sample.reserve(count);
+            // Contiguous chunks spread over the subsequence keep both the local statistics and the trends
+            const size_t chunks = std::min<size_t>(16, count);
+            const size_t chunkSize = count / chunks;
+            for (size_t c = 0; c < chunks; ++c) {
+                const size_t start = c * (block.size() - chunkSize) / std::max<size_t>(chunks - 1, 1);
+                for (size_t i = start; i < start + chunkSize; ++i) {
+                    sample.push_back(block.get(i));
+                }
+            }
+        }
+        auto conf = std::make_shared<const EncodingConfiguration>(
+            search(sample, manual.getSubseqConfig(), id, timeWeight));
+        std::lock_guard<std::mutex> guard(lock);
+        settled = offer(round, index, records.start, std::move(conf)) || settled;
+    }
+    if (settled) {
+        wakeUp();
+    }
+    auto ret = resolve(id, index);
+    return ret ? ret : std::make_shared<const EncodingConfiguration>(manual);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::shared_ptr<const EncodingConfiguration> AdaptiveConfigSelector::get(core::GenSubIndex sub,
+                                                                         const util::Section &records) {
+    if (!isAdaptable(sub, false)) {
+        return nullptr;
+    }
+    bool settled = false;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        settled = arrive(records);
+    }
+    if (settled) {
+        wakeUp();
+    }
+    return resolve(sub, getRound(records.start));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AdaptiveConfigSelector::skip(const util::Section &records) {
+    bool settled = false;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        addKnown(records.start, records.start + records.length);
+        settled = update();
+    }
+    if (settled) {
+        wakeUp();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace gabac
+}  // namespace entropy
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,237 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_ENTROPY_GABAC_ADAPTIVE_CONFIG_H_
+#define SRC_GENIE_ENTROPY_GABAC_ADAPTIVE_CONFIG_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "genie/core/access-unit.h"
+#include "genie/entropy/gabac/configuration.h"
+#include "genie/entropy/paramcabac/subsequence.h"
+#include "genie/util/drain.h"
+#include "genie/util/task-scheduler.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace entropy {
+namespace gabac {
+
+/**
+ * @brief Chooses the gabac configuration of each descriptor subsequence while encoding. A sample of the subsequence is
+ * trial encoded with a small set of candidates derived from the manual configuration: the subsequence transformations
+ * without parameters and, per transformed subsequence, the coding order, bypass mode and binarization.
+ *
+ * Access units are known by the section of records they hold, which does not depend on thread timing. The records
+ * are grouped into rounds of a fixed size. The first access unit starting in a round selects, sections without access
+ * unit are passed over. All other access units of the round wait for its choice. A round is decided as soon as all
+ * sections before its first access unit are known, by whichever thread completes that knowledge, so the first access
+ * unit itself never waits for it. If the first access unit has no data for a subsequence, the choice of the previous
+ * round is kept. The number of rounds is limited, so that the number of parameter sets stays bounded. Token type
+ * descriptors, e.g. the read names, keep their manual configuration.
+ */
+class AdaptiveConfigSelector {
+ public:
+    /**
+     * @brief Maximum number of selections per subsequence. Each round can add a parameter set to the output.
+     */
+    static constexpr size_t MAX_ROUNDS = 16;
+
+    /**
+     * @brief Create a selector
+     * @param _timeWeight Weight of the encoding time in the score, between 0 (size only) and 1 (time only). Anything
+     * but 0 makes the output depend on the machine and its load.
+     * @param _sampleSize Number of symbols to trial encode
+     * @param _interval Number of records per round, 0 to select once
+     */
+    explicit AdaptiveConfigSelector(float _timeWeight = 0.0f, size_t _sampleSize = 1u << 16u, size_t _interval = 0);
+
+    /**
+     * @brief Settle the subsequences of a descriptor that the access unit has no data for or that cannot be adapted,
+     * so that other access units do not wait for them. Call before select() and get().
+     * @param desc Descriptor to encode
+     * @param records Section of the access unit
+     */
+    void begin(core::AccessUnit::Descriptor &desc, const util::Section &records);
+
+    /**
+     * @brief Get the configuration to encode a subsequence with, selecting one first if this access unit may be the
+     * first of its round. Thread safe, may wait until the round is decided.
+     * @param data Subsequence to encode next
+     * @param manual Configuration used when no selection is possible, also the reference for the score
+     * @param records Section of the access unit
+     * @return Configuration, stays valid while held
+     */
+    std::shared_ptr<const EncodingConfiguration> select(core::AccessUnit::Subsequence &data,
+                                                        const EncodingConfiguration &manual,
+                                                        const util::Section &records);
+
+    /**
+     * @brief Get the selection valid for an access unit without selecting. May wait until the round is decided.
+     * @param sub Subsequence
+     * @param records Section of the access unit
+     * @return Configuration, nullptr if the manual one is used
+     */
+    std::shared_ptr<const EncodingConfiguration> get(core::GenSubIndex sub, const util::Section &records);
+
+    /**
+     * @brief Pass over a section without access unit, so that the rounds it touches do not wait for it
+     * @param records Section
+     */
+    void skip(const util::Section &records);
+
+    /**
+     * @brief Check if a subsequence can be adapted at all. Token type descriptors, subsequences with a dependency and
+     * subsequences with a special alphabet keep their manual configuration.
+     * @param sub Subsequence
+     * @param hasDependency If the subsequence is coded with a dependency
+     * @return True if candidates exist
+     */
+    static bool isAdaptable(core::GenSubIndex sub, bool hasDependency);
+
+    /**
+     * @brief Trial encode a sample with the candidates and return the best configuration
+     * @param sample Symbols of the subsequence
+     * @param manual Manual configuration of the subsequence
+     * @param sub Subsequence
+     * @param timeWeight Weight of the encoding time in the score
+     * @return Best configuration, the manual one unless a candidate scores better
+     */
+    static paramcabac::Subsequence search(const util::DataBlock &sample, const paramcabac::Subsequence &manual,
+                                          core::GenSubIndex sub, float timeWeight);
+
+ private:
+    /**
+     * @brief Selection of one subsequence in one round
+     */
+    struct Round {
+        /**
+         * @brief Open until the first access unit of the round selected or found nothing to select
+         */
+        enum class State : uint8_t { OPEN, SELECTED, INHERITED };
+
+
+        std::atomic<State> state{State::OPEN};              //!< @brief Set after conf
+        std::shared_ptr<const EncodingConfiguration> conf;  //!< @brief Selection if state is SELECTED
+
+        //! @brief Selections of access units that may be the first of the round, by their first record
+        std::map<uint64_t, std::shared_ptr<const EncodingConfiguration>> offers;
+    };
+
+    /**
+     * @brief First access unit of a round
+     */
+    struct Owner {
+        uint64_t first{std::numeric_limits<uint64_t>::max()};  //!< @brief Earliest start of an access unit so far
+        bool final{false};                                     //!< @brief Set once no earlier one can show up
+    };
+
+    float timeWeight;                                    //!< @brief Weight of the encoding time in the score
+    size_t sampleSize;                                   //!< @brief Number of symbols to trial encode
+    size_t interval;                                     //!< @brief Records per round, 0 for one round
+    std::vector<std::vector<std::vector<Round>>> slots;  //!< @brief Rounds of each descriptor subsequence
+    std::vector<Owner> owners;                           //!< @brief First access unit of each round
+    std::map<uint64_t, uint64_t> known;                  //!< @brief Records seen so far, merged, start to end
+    mutable std::mutex lock;                             //!< @brief Protects state changes
+    mutable std::condition_variable decided;             //!< @brief Signals decisions to threads without scheduler
+    mutable std::atomic<util::TaskScheduler *> waiting;  //!< @brief Scheduler of helping waiters, woken on decisions
+
+    /**
+     * @brief
+     * @param record Position of a record
+     * @return Round of the record
+     */
+    size_t getRound(uint64_t record) const;
+
+    /**
+     * @brief
+     * @param round Round
+     * @return First record after the round, the maximum value for the last round
+     */
+    uint64_t getRoundEnd(size_t round) const;
+
+    /**
+     * @brief Check if the records of a range were all seen as access units or skips. Call with the lock held.
+     * @param from First record
+     * @param to Record after the last one
+     * @return True if nothing unknown is left in the range
+     */
+    bool isKnown(uint64_t from, uint64_t to) const;
+
+    /**
+     * @brief Add a range to the known records. Call with the lock held.
+     * @param from First record
+     * @param to Record after the last one
+     */
+    void addKnown(uint64_t from, uint64_t to);
+
+    /**
+     * @brief Register an access unit. Call with the lock held.
+     * @param records Section of the access unit
+     * @return True if a round was decided
+     */
+    bool arrive(const util::Section &records);
+
+    /**
+     * @brief Decide the rounds whose first access unit became known, using its offers. Call with the lock held.
+     * @return True if a round was decided
+     */
+    bool update();
+
+    /**
+     * @brief Offer a selection for a round, decide it if the access unit is known to be the first of the round. Call
+     * with the lock held.
+     * @param round Round of a subsequence
+     * @param index Number of the round
+     * @param first First record of the access unit
+     * @param conf Selection, nullptr to keep the previous one
+     * @return True if the round was decided
+     */
+    bool offer(Round &round, size_t index, uint64_t first, std::shared_ptr<const EncodingConfiguration> conf);
+
+    /**
+     * @brief Decide a round. Call with the lock held and wake up waiting threads afterwards.
+     * @param round Open round
+     * @param conf Selection, nullptr to keep the previous one
+     */
+    static void settle(Round &round, std::shared_ptr<const EncodingConfiguration> conf);
+
+    /**
+     * @brief Wake up threads waiting for decisions
+     */
+    void wakeUp() const;
+
+    /**
+     * @brief Get the selection of a round, waiting for it to be decided
+     * @param sub Subsequence
+     * @param round Round
+     * @return Configuration, nullptr for the manual one
+     */
+    std::shared_ptr<const EncodingConfiguration> resolve(core::GenSubIndex sub, size_t round) const;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace gabac
+}  // namespace entropy
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_ENTROPY_GABAC_ADAPTIVE_CONFIG_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -10,10 +10,13 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
-#include "filesystem/filesystem.hpp"
+#include <memory>
+#include <mutex>
 #include "genie/entropy/gabac/encode-desc-subseq.h"
 #include "genie/entropy/gabac/encode-transformed-subseq.h"
 #include "genie/entropy/gabac/stream-handler.h"
+#include "genie/util/make-unique.h"
+#include "genie/util/runtime-exception.h"
 #include "genie/util/watch.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -355,72 +358,167 @@ std::string ResultFull::getCSVHeader() {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-ResultFull benchmark_full(const std::string& input_file, const genie::core::GenSubIndex& desc, float timeweight) {
-    std::ifstream input_stream(input_file);
-    util::DataBlock sequence(0, core::range2bytes(core::getSubsequence(desc).range));
-    gabac::StreamHandler::readFull(input_stream, &sequence);
+nlohmann::json ResultTransformed::toJson() const {
+    nlohmann::json ret;
+    if (full) {
+        ret["size"] = size;
+    }
+    if (sampleSize) {
+        ret["sample_size"] = sampleSize;
+    }
+    ret["milliseconds"] = milliseconds;
+    ret["pruned"] = pruned;
+    ret["config"] = config.toJson();
+    return ret;
+}
 
-    ResultFull best_result;
-    float best_score = INFINITY;
-    ConfigSearch config(genie::core::getSubsequence(desc).range);
-    bool new_file = !ghc::filesystem::exists("benchmark_total.csv");
-    std::ofstream results_file("benchmark_total.csv", std::ios_base::app);
-    do {
-        std::cerr << "Optimizing transformation " << static_cast<int>(config.getTransform()) << "..." << std::endl;
-        // Execute transformation
-        std::vector<util::DataBlock> transformedSubseqs;
-        transformedSubseqs.resize(1);
-        auto subsequence = sequence;
-        transformedSubseqs[0].swap(&subsequence);
-        util::Watch timer;
-        timer.reset();
-        auto cfg = config.createConfig(desc, core::getDescriptor(desc.first).tokentype);
-        gabac::doSubsequenceTransform(cfg, &transformedSubseqs);
-        size_t total_time = static_cast<size_t>(timer.check() * 1000);
-        std::vector<ResultTransformed> trans_results;
-
-        // Optimze transformed sequences independently
-        for (size_t i = 0; i < transformedSubseqs.size(); ++i) {
-            std::cerr << "Optimizing subsequence " << i << "..." << std::endl;
-            trans_results.emplace_back(optimizeTransformedSequence(
-                config.getTransformedSeqs()[i], desc, transformedSubseqs[i], timeweight,
-                i == transformedSubseqs.size() - 1, config.getTransform(), config.getTransformParam(), i, input_file));
-            auto tmp = trans_results.back().config;
-            cfg.setTransformSubseqCfg(i, std::move(tmp));
-        }
+// ---------------------------------------------------------------------------------------------------------------------
 
-        // Sum up compressed sizes and times
-        size_t total_size = 0;
-        for (const auto& r : trans_results) {
-            total_size += r.size;
-            total_time += r.milliseconds;  // Transformation time already added above
+nlohmann::json ResultFull::toJson() const {
+    nlohmann::json ret;
+    ret["size"] = size;
+    ret["milliseconds"] = milliseconds;
+    ret["config"] = config.toJoson();
+    std::vector<nlohmann::json> subseqs;
+    for (const auto& c : candidates) {
+        std::vector<nlohmann::json> tmp;
+        for (const auto& r : c) {
+            tmp.emplace_back(r.toJson());
         }
+        subseqs.emplace_back(tmp);
+    }
+    ret["candidates"] = subseqs;
+    return ret;
+}
 
-        // Calculate weighted score
-        float score = timeweight * total_time + (1 - timeweight) * total_size;
+// ---------------------------------------------------------------------------------------------------------------------
 
-        // Found new best score
-        if (score < best_score) {
-            best_score = score;
-            best_result.milliseconds = total_time;
-            best_result.size = total_size;
-            best_result.config = cfg;
-        }
+const ResultFull& BenchmarkReport::getBest() const { return transformations[best]; }
 
-        ResultFull result_current;
-        result_current.milliseconds = total_time;
-        result_current.size = total_size;
-        result_current.config = cfg;
+// ---------------------------------------------------------------------------------------------------------------------
 
-        if (new_file) {
-            results_file << result_current.getCSVHeader() << std::endl;
-            new_file = false;
+nlohmann::json BenchmarkReport::toJson() const {
+    nlohmann::json ret;
+    ret["symbols"] = symbols;
+    ret["sample_symbols"] = sampleSymbols;
+    ret["timeweight"] = timeweight;
+    ret["milliseconds"] = milliseconds;
+    ret["best"] = getBest().config.toJoson();
+    std::vector<nlohmann::json> tmp;
+    for (const auto& t : transformations) {
+        tmp.emplace_back(t.toJson());
+    }
+    ret["transformations"] = tmp;
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Draw contiguous chunks spread over a subsequence, which keeps both the local statistics and the trends
+ * @param sequence Subsequence
+ * @param count Number of symbols to draw
+ * @return Sample
+ */
+static util::DataBlock drawSample(const util::DataBlock& sequence, size_t count) {
+    util::DataBlock sample(0, sequence.getWordSize());
+    sample.reserve(count);
+    const size_t chunks = std::min<size_t>(16, count);
+    const size_t chunkSize = count / chunks;
+    for (size_t c = 0; c < chunks; ++c) {
+        const size_t start = c * (sequence.size() - chunkSize) / std::max<size_t>(chunks - 1, 1);
+        for (size_t i = start; i < start + chunkSize; ++i) {
+            sample.push_back(sequence.get(i));
         }
-        results_file << result_current.toCSV(input_file) << std::endl;
+    }
+    return sample;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+BenchmarkReport benchmark(const util::DataBlock& sequence, const genie::core::GenSubIndex& desc,
+                          const BenchmarkOptions& options) {
+    util::Watch watch;
+    BenchmarkReport report;
+    report.symbols = sequence.size();
+    report.timeweight = options.timeweight;
+
+    std::unique_ptr<util::DataBlock> sample;
+    if (options.sampleSize && options.sampleSize < sequence.size()) {
+        sample = util::make_unique<util::DataBlock>(drawSample(sequence, options.sampleSize));
+        report.sampleSymbols = sample->size();
+    }
+
+    // Collect the transformations first, so that they can be searched independently
+    std::vector<std::pair<paramcabac::Subsequence, std::vector<ConfigSearchTranformedSeq>>> transformations;
+    ConfigSearch config(genie::core::getSubsequence(desc).range);
+    do {
+        transformations.emplace_back(config.createConfig(desc, core::getDescriptor(desc.first).tokentype),
+                                     config.getTransformedSeqs());
     } while (config.increment());
 
-    std::cout << best_result.toCSV(input_file) << std::endl;
-    return best_result;
+    report.transformations.resize(transformations.size());
+    util::TaskGroup group(options.scheduler);
+    for (size_t t = 0; t < transformations.size(); ++t) {
+        group.run([&, t]() {
+            auto& cfg = transformations[t].first;
+            auto& result = report.transformations[t];
+
+            // Execute transformation
+            std::vector<util::DataBlock> transformedSubseqs(1);
+            auto subsequence = sequence;
+            transformedSubseqs[0].swap(&subsequence);
+            util::Watch timer;
+            gabac::doSubsequenceTransform(cfg, &transformedSubseqs);
+            result.milliseconds = static_cast<size_t>(timer.check() * 1000);
+
+            std::vector<util::DataBlock> transformedSamples;
+            if (sample) {
+                transformedSamples.resize(1);
+                auto sampleCopy = *sample;
+                transformedSamples[0].swap(&sampleCopy);
+                gabac::doSubsequenceTransform(cfg, &transformedSamples);
+            }
+
+            // Optimize transformed sequences independently
+            result.candidates.resize(transformedSubseqs.size());
+            for (size_t i = 0; i < transformedSubseqs.size(); ++i) {
+                const util::DataBlock* transformedSample = sample ? &transformedSamples[i] : nullptr;
+                auto best = optimizeTransformedSequence(transformations[t].second[i], desc, transformedSubseqs[i],
+                                                        transformedSample, i == transformedSubseqs.size() - 1, options,
+                                                        &result.candidates[i]);
+                result.size += best.size;
+                result.milliseconds += best.milliseconds;  // Transformation time already added above
+                cfg.setTransformSubseqCfg(i, std::move(best.config));
+            }
+            result.config = cfg;
+        });
+    }
+    group.wait();
+
+    // Pick the best transformation, the earlier one on a tie
+    double bestScore = std::numeric_limits<double>::infinity();
+    for (size_t t = 0; t < report.transformations.size(); ++t) {
+        const auto& r = report.transformations[t];
+        const double score = options.timeweight * r.milliseconds + (1.0 - options.timeweight) * r.size;
+        if (score < bestScore) {
+            bestScore = score;
+            report.best = t;
+        }
+    }
+    report.milliseconds = static_cast<size_t>(watch.check() * 1000);
+    return report;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+BenchmarkReport benchmark_full(const std::string& input_file, const genie::core::GenSubIndex& desc,
+                               const BenchmarkOptions& options) {
+    std::ifstream input_stream(input_file);
+    UTILS_DIE_IF(!input_stream, "Could not open " + input_file);
+    util::DataBlock sequence(0, core::range2bytes(core::getSubsequence(desc).range));
+    gabac::StreamHandler::readFull(input_stream, &sequence);
+    return benchmark(sequence, desc, options);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -559,6 +657,7 @@ paramcabac::Subsequence ConfigSearch::createConfig(genie::core::GenSubIndex desc
         tss.emplace_back(p.createConfig(
             descriptor_subsequence,
             i == params[transformation.getIndex(transformation_search_idx)].getTransformedSeqs().size() - 1));
+        ++i;
     }
     paramcabac::Subsequence ret(std::move(t), descriptor_subsequence.second, tokentype, std::move(tss));
     return ret;
@@ -566,43 +665,108 @@ paramcabac::Subsequence ConfigSearch::createConfig(genie::core::GenSubIndex desc
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Upper bound for the compressed size of a candidate that can still beat a score
+ * @param score Best score so far
+ * @param timeweight Weight of the encoding time in the score
+ * @return Size at which the encoding can stop
+ */
+static size_t getSizeBound(double score, float timeweight) {
+    if (timeweight >= 1.0f || score == std::numeric_limits<double>::infinity()) {
+        return std::numeric_limits<size_t>::max();
+    }
+    return static_cast<size_t>(score / (1.0 - timeweight)) + 1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Encode candidates in parallel. The best score is shared between the tasks, so that a candidate whose
+ * compressed size alone makes its score worse than the best finished one is stopped early.
+ * @param indices Candidates to evaluate
+ * @param data Transformed subsequence
+ * @param isSample If data is a sample
+ * @param options Search settings
+ * @param results Candidates, receive their sizes and times
+ */
+static void evaluateCandidates(const std::vector<size_t>& indices, const util::DataBlock& data, bool isSample,
+                               const BenchmarkOptions& options, std::vector<ResultTransformed>* results) {
+    std::mutex lock;
+    double bestScore = std::numeric_limits<double>::infinity();
+    util::TaskGroup group(options.scheduler);
+    for (auto idx : indices) {
+        group.run([&, idx]() {
+            size_t bound;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                bound = getSizeBound(bestScore, options.timeweight);
+            }
+            auto& result = (*results)[idx];
+            auto input = data;
+            util::Watch watch;
+            const size_t size = gabac::encodeTransformSubseq(result.config, &input, nullptr, bound);
+            result.milliseconds = static_cast<size_t>(watch.check() * 1000);
+            result.pruned = size >= bound;
+            if (isSample) {
+                result.sampleSize = size;
+            } else {
+                result.size = size;
+                result.full = true;
+            }
+            if (!result.pruned) {
+                std::lock_guard<std::mutex> guard(lock);
+                bestScore = std::min(bestScore, options.timeweight * result.milliseconds +
+                                                    (1.0 - options.timeweight) * static_cast<double>(size));
+            }
+        });
+    }
+    group.wait();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 ResultTransformed optimizeTransformedSequence(ConfigSearchTranformedSeq& seq, const genie::core::GenSubIndex& gensub,
-                                              util::DataBlock& data, float timeweight, bool original,
-                                              size_t transformation, size_t transformation_param, size_t sequence_id,
-                                              const std::string& filename) {
-    ResultTransformed ret;
-    float score = INFINITY;
-    bool new_file = !ghc::filesystem::exists("benchmark_trans_" + std::to_string(transformation) + ".csv");
-    std::ofstream results_file("benchmark_trans_" + std::to_string(transformation) + ".csv", std::ios_base::app);
+                                              const util::DataBlock& data, const util::DataBlock* sample,
+                                              bool original, const BenchmarkOptions& options,
+                                              std::vector<ResultTransformed>* candidates) {
+    std::vector<ResultTransformed> results;
     do {
-        auto cfg = seq.createConfig(gensub, original);
-        auto input = data;
-
-        util::Watch watch;
-        watch.reset();
-        gabac::encodeTransformSubseq(cfg, &input);
-        auto time = size_t(watch.check() * 1000);  // Milliseconds
-        auto size = input.getRawSize();
-
-        float newscore = static_cast<float>(timeweight * time + (1.0 - timeweight) * size);
-        if (newscore < score) {
-            // Found new bets score
-            score = newscore;
-            ret.milliseconds = time;
-            ret.size = size;
-            ret.config = cfg;
-        }
-        ResultTransformed result_current;
-        result_current.milliseconds = time;
-        result_current.size = size;
-        result_current.config = cfg;
-
-        if (new_file) {
-            results_file << result_current.getCSVHeader() << std::endl;
-            new_file = false;
-        }
-        results_file << result_current.toCSV(filename, transformation, transformation_param, sequence_id) << std::endl;
+        results.emplace_back();
+        results.back().config = seq.createConfig(gensub, original);
     } while (seq.increment());
+
+    // Ranking of the finished candidates, the earlier one on a tie
+    auto rank = [&](bool onSample) {
+        std::vector<size_t> ranking;
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (!results[i].pruned && (onSample || results[i].full)) {
+                ranking.push_back(i);
+            }
+        }
+        auto score = [&](size_t i) {
+            return options.timeweight * results[i].milliseconds +
+                   (1.0 - options.timeweight) * static_cast<double>(onSample ? results[i].sampleSize : results[i].size);
+        };
+        std::stable_sort(ranking.begin(), ranking.end(), [&](size_t a, size_t b) { return score(a) < score(b); });
+        return ranking;
+    };
+
+    std::vector<size_t> indices(results.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+    if (sample) {
+        evaluateCandidates(indices, *sample, true, options, &results);
+        indices = rank(true);
+        indices.resize(std::min(indices.size(), std::max<size_t>(options.confirmedCandidates, 1)));
+        std::sort(indices.begin(), indices.end());
+    }
+    evaluateCandidates(indices, data, false, options, &results);
+
+    auto ret = results[rank(false).front()];
+    if (candidates) {
+        *candidates = std::move(results);
+    }
     return ret;
 }
 
@@ -15,10 +15,12 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include <nlohmann/json.hpp>
 #include "genie/entropy/paramcabac/binarization.h"
 #include "genie/entropy/paramcabac/subsequence.h"
 #include "genie/entropy/paramcabac/transformed-subseq.h"
 #include "genie/util/data-block.h"
+#include "genie/util/task-scheduler.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -295,9 +297,18 @@ class ConfigSearchTranformedSeq {
  * @brief
  */
 struct ResultTransformed {
-    size_t milliseconds{};                 //!< @brief
-    size_t size{};                         //!< @brief
+    size_t milliseconds{};                 //!< @brief Encoding time of the last evaluation
+    size_t size{};                         //!< @brief Compressed size of the full data
     paramcabac::TransformedSubSeq config;  //!< @brief
+    size_t sampleSize{};                   //!< @brief Compressed size of the sample, 0 if no sample was evaluated
+    bool full{};                           //!< @brief Evaluated on the full data, not only on the sample
+    bool pruned{};                         //!< @brief Encoding stopped early, as the candidate could not win anymore
+
+    /**
+     * @brief
+     * @return Result as part of the benchmark report
+     */
+    nlohmann::json toJson() const;
 
     /**
      * @brief
@@ -320,9 +331,16 @@ struct ResultTransformed {
  * @brief
  */
 struct ResultFull {
-    size_t milliseconds{};           //!< @brief
-    size_t size{};                   //!< @brief
-    paramcabac::Subsequence config;  //!< @brief
+    size_t milliseconds{};                                   //!< @brief
+    size_t size{};                                           //!< @brief
+    paramcabac::Subsequence config;                          //!< @brief
+    std::vector<std::vector<ResultTransformed>> candidates;  //!< @brief All candidates per transformed subsequence
+
+    /**
+     * @brief
+     * @return Result as part of the benchmark report
+     */
+    nlohmann::json toJson() const;
 
     /**
      * @brief
@@ -338,31 +356,76 @@ struct ResultFull {
 };
 
 /**
- * @brief
- * @param seq
- * @param gensub
- * @param data
- * @param timeweight
- * @param original
- * @param transformation
- * @param transformation_param
- * @param sequence_id
- * @param filename
- * @return
+ * @brief Settings of the configuration search
+ */
+struct BenchmarkOptions {
+    float timeweight{};                //!< @brief Weight of the encoding time in the score, 0 for the size only
+    util::TaskScheduler* scheduler{};  //!< @brief Where to evaluate candidates in parallel, nullptr to run serially
+    size_t sampleSize{};               //!< @brief Symbols to preselect candidates on, 0 to use the full data only
+    size_t confirmedCandidates{8};     //!< @brief Best candidates on the sample to confirm on the full data
+};
+
+/**
+ * @brief Outcome of a configuration search
+ */
+struct BenchmarkReport {
+    size_t symbols{};                         //!< @brief Length of the input subsequence
+    size_t sampleSymbols{};                   //!< @brief Length of the sample, 0 if no sample was used
+    float timeweight{};                       //!< @brief Weight of the encoding time in the score
+    size_t milliseconds{};                    //!< @brief Duration of the whole search
+    size_t best{};                            //!< @brief Index of the best transformation
+    std::vector<ResultFull> transformations;  //!< @brief Best result per subsequence transformation
+
+    /**
+     * @brief
+     * @return Best result over all transformations
+     */
+    const ResultFull& getBest() const;
+
+    /**
+     * @brief
+     * @return Report with all evaluated candidates
+     */
+    nlohmann::json toJson() const;
+};
+
+/**
+ * @brief Search the best configuration of one transformed subsequence. Candidates are encoded in parallel and stopped
+ * as soon as their compressed size alone rules them out. With a sample, all candidates are ranked on the sample first
+ * and only the best ones are encoded with the full data.
+ * @param seq Search space
+ * @param gensub Descriptor subsequence
+ * @param data Transformed subsequence
+ * @param sample Same transformed subsequence of the sample, nullptr to evaluate all candidates on the full data
+ * @param original If this is the last transformed subsequence
+ * @param options Search settings
+ * @param candidates Output for all evaluated candidates, may be nullptr
+ * @return Best candidate
  */
 ResultTransformed optimizeTransformedSequence(ConfigSearchTranformedSeq& seq, const genie::core::GenSubIndex& gensub,
-                                              util::DataBlock& data, float timeweight, bool original,
-                                              size_t transformation, size_t transformation_param, size_t sequence_id,
-                                              const std::string& filename);
+                                              const util::DataBlock& data, const util::DataBlock* sample,
+                                              bool original, const BenchmarkOptions& options,
+                                              std::vector<ResultTransformed>* candidates);
 
 /**
- * @brief
- * @param input_file
- * @param desc
- * @param timeweight
- * @return
+ * @brief Search the best configuration of a descriptor subsequence over all subsequence transformations
+ * @param sequence Descriptor subsequence
+ * @param desc Descriptor subsequence ID
+ * @param options Search settings
+ * @return Report
+ */
+BenchmarkReport benchmark(const util::DataBlock& sequence, const genie::core::GenSubIndex& desc,
+                          const BenchmarkOptions& options);
+
+/**
+ * @brief Search the best configuration of a descriptor subsequence stored in a file
+ * @param input_file Raw subsequence file
+ * @param desc Descriptor subsequence ID
+ * @param options Search settings
+ * @return Report
  */
-ResultFull benchmark_full(const std::string& input_file, const genie::core::GenSubIndex& desc, float timeweight);
+BenchmarkReport benchmark_full(const std::string& input_file, const genie::core::GenSubIndex& desc,
+                               const BenchmarkOptions& options);
 
 /**
  * @brief
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/entropy/gabac/bin-params.h"
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace entropy {
+namespace gabac {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+paramcabac::BinarizationParameters::BinarizationId getUnsignedBinarization(
+    paramcabac::BinarizationParameters::BinarizationId binID) {
+    switch (binID) {
+        case paramcabac::BinarizationParameters::BinarizationId::BI:
+        case paramcabac::BinarizationParameters::BinarizationId::TU:
+        case paramcabac::BinarizationParameters::BinarizationId::EG:
+        case paramcabac::BinarizationParameters::BinarizationId::TEG:
+        case paramcabac::BinarizationParameters::BinarizationId::SUTU:
+        case paramcabac::BinarizationParameters::BinarizationId::DTU:
+            return binID;
+        case paramcabac::BinarizationParameters::BinarizationId::SEG:
+            return paramcabac::BinarizationParameters::BinarizationId::EG;
+        case paramcabac::BinarizationParameters::BinarizationId::STEG:
+            return paramcabac::BinarizationParameters::BinarizationId::TEG;
+        case paramcabac::BinarizationParameters::BinarizationId::SSUTU:
+            return paramcabac::BinarizationParameters::BinarizationId::SUTU;
+        case paramcabac::BinarizationParameters::BinarizationId::SDTU:
+            return paramcabac::BinarizationParameters::BinarizationId::DTU;
+        default:
+            UTILS_DIE("Unknown Binarization");
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+BinParams getBinParams(const uint8_t outputSymbolSize, const paramcabac::BinarizationParameters::BinarizationId binID,
+                       const paramcabac::BinarizationParameters &binarzationParams,
+                       const paramcabac::StateVars &stateVars) {
+    BinParams binParams;
+    switch (getUnsignedBinarization(binID)) {
+        case paramcabac::BinarizationParameters::BinarizationId::BI:
+            binParams.cMax = stateVars.getCLengthBI();
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::TU:
+            binParams.cMax = binarzationParams.getCMax();
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::EG:
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::TEG:
+            binParams.cMax = binarzationParams.getCMaxTeg();
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::SUTU:
+            binParams.cMax = outputSymbolSize;
+            binParams.splitUnitSize = binarzationParams.getSplitUnitSize();
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::DTU:
+            binParams.cMax = outputSymbolSize;
+            binParams.splitUnitSize = binarzationParams.getSplitUnitSize();
+            binParams.cMaxDtu = binarzationParams.getCMaxDtu();
+            break;
+        default:
+            UTILS_DIE("Unknown Binarization");
+    }
+    return binParams;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace gabac
+}  // namespace entropy
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
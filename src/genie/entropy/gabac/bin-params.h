@@ -0,0 +1,88 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_ENTROPY_GABAC_BIN_PARAMS_H_
+#define SRC_GENIE_ENTROPY_GABAC_BIN_PARAMS_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <utility>
+#include "genie/entropy/paramcabac/binarization_parameters.h"
+#include "genie/entropy/paramcabac/state_vars.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace entropy {
+namespace gabac {
+
+/**
+ * @brief Parameters of one binarization, small enough to be passed around in registers
+ */
+struct BinParams {
+    unsigned int cMax = 0;           //!< @brief cLength (BI), cMax (TU), cMaxTeg (TEG) or symbol size (SUTU, DTU)
+    unsigned int splitUnitSize = 0;  //!< @brief Split unit size (SUTU, DTU)
+    unsigned int cMaxDtu = 0;        //!< @brief cMax of the truncated unary part (DTU)
+    unsigned int ctxIdx = 0;         //!< @brief First context model
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Map the signed binarizations to the unsigned ones, the sign flag is coded separately
+ * @param binID Binarization
+ * @return Binarization of the absolute value
+ */
+paramcabac::BinarizationParameters::BinarizationId getUnsignedBinarization(
+    paramcabac::BinarizationParameters::BinarizationId binID);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Collect the parameters a binarization needs, the context index is left at zero
+ * @param outputSymbolSize Output symbol size
+ * @param binID Binarization
+ * @param binarzationParams Binarization parameters of the configuration
+ * @param stateVars State variables of the configuration
+ * @return Parameters
+ */
+BinParams getBinParams(uint8_t outputSymbolSize, paramcabac::BinarizationParameters::BinarizationId binID,
+                       const paramcabac::BinarizationParameters &binarzationParams,
+                       const paramcabac::StateVars &stateVars);
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Call the kernel instantiated for a binarization chosen at runtime, so the choice is made once per
+ * subsequence and not per symbol. Signed binarizations use the kernel of their unsigned counterpart.
+ * @tparam Kernel Type with a static member template run<BinarizationId, bool bypass>(Args...)
+ * @param binID Binarization
+ * @param bypassFlag If the bins are bypass coded
+ * @param args Arguments forwarded to the kernel
+ * @return Result of the kernel
+ */
+template <typename Kernel, typename... Args>
+auto dispatchBinarization(paramcabac::BinarizationParameters::BinarizationId binID, bool bypassFlag, Args &&...args)
+    -> decltype(Kernel::template run<paramcabac::BinarizationParameters::BinarizationId::BI, true>(
+        std::forward<Args>(args)...));
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace gabac
+}  // namespace entropy
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include "genie/entropy/gabac/bin-params.impl.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_ENTROPY_GABAC_BIN_PARAMS_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,76 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_ENTROPY_GABAC_BIN_PARAMS_IMPL_H_
+#define SRC_GENIE_ENTROPY_GABAC_BIN_PARAMS_IMPL_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace entropy {
+namespace gabac {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename Kernel, typename... Args>
+auto dispatchBinarization(const paramcabac::BinarizationParameters::BinarizationId binID, const bool bypassFlag,
+                          Args &&...args)
+    -> decltype(Kernel::template run<paramcabac::BinarizationParameters::BinarizationId::BI, true>(
+        std::forward<Args>(args)...)) {
+    using BinId = paramcabac::BinarizationParameters::BinarizationId;
+    if (bypassFlag) {
+        switch (getUnsignedBinarization(binID)) {
+            case BinId::BI:
+                return Kernel::template run<BinId::BI, true>(std::forward<Args>(args)...);
+            case BinId::TU:
+                return Kernel::template run<BinId::TU, true>(std::forward<Args>(args)...);
+            case BinId::EG:
+                return Kernel::template run<BinId::EG, true>(std::forward<Args>(args)...);
+            case BinId::TEG:
+                return Kernel::template run<BinId::TEG, true>(std::forward<Args>(args)...);
+            case BinId::SUTU:
+                return Kernel::template run<BinId::SUTU, true>(std::forward<Args>(args)...);
+            case BinId::DTU:
+                return Kernel::template run<BinId::DTU, true>(std::forward<Args>(args)...);
+            default:
+                UTILS_DIE("Unknown Binarization");
+        }
+    } else {
+        switch (getUnsignedBinarization(binID)) {
+            case BinId::BI:
+                return Kernel::template run<BinId::BI, false>(std::forward<Args>(args)...);
+            case BinId::TU:
+                return Kernel::template run<BinId::TU, false>(std::forward<Args>(args)...);
+            case BinId::EG:
+                return Kernel::template run<BinId::EG, false>(std::forward<Args>(args)...);
+            case BinId::TEG:
+                return Kernel::template run<BinId::TEG, false>(std::forward<Args>(args)...);
+            case BinId::SUTU:
+                return Kernel::template run<BinId::SUTU, false>(std::forward<Args>(args)...);
+            case BinId::DTU:
+                return Kernel::template run<BinId::DTU, false>(std::forward<Args>(args)...);
+            default:
+                UTILS_DIE("Unknown Binarization");
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace gabac
+}  // namespace entropy
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_ENTROPY_GABAC_BIN_PARAMS_IMPL_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
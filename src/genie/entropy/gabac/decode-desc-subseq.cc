@@ -132,6 +132,95 @@ uint64_t decodeDescSubsequence(const IOConfiguration &ioConf, const EncodingConf
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+static uint64_t readUInt(const uint8_t *&pos, const uint8_t *end, size_t numBytes) {
+    UTILS_DIE_IF(size_t(end - pos) < numBytes, "Descriptor subsequence payload smaller than expected");
+    uint64_t retVal = 0;
+    while (numBytes-- > 0) {
+        retVal = (retVal << 8u) | *pos++;
+    }
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static uint64_t readU7(const uint8_t *&pos, const uint8_t *end) {
+    uint64_t retVal = 0;
+    uint8_t byte = 0;
+    do {
+        byte = uint8_t(readUInt(pos, end, 1));
+        retVal = (retVal << 7u) | (byte & 0x7Fu);
+    } while ((byte & 0x80u) != 0);
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t decodeDescSubsequence(const EncodingConfiguration &enConf, const util::DataBlock &input,
+                               util::DataBlock *output, uint8_t outputWordsize) {
+    const paramcabac::Subsequence &subseqCfg = enConf.getSubseqConfig();
+    const auto *const begin = static_cast<const uint8_t *>(input.getData());
+    const uint8_t *const end = begin + input.getRawSize();
+    const uint8_t *pos = begin;
+
+    *output = util::DataBlock(0, outputWordsize);
+    if (pos == end) {
+        return 0;
+    }
+
+    // read number of symbols in descriptor subsequence
+    const uint64_t numDescSubseqSymbols = subseqCfg.getTokentypeFlag() ? readU7(pos, end) : readUInt(pos, end, 4);
+    if (numDescSubseqSymbols == 0 || pos == end) {
+        return uint64_t(pos - begin);
+    }
+
+    size_t numTrnsfSubseqsCfgs = subseqCfg.getNumTransformSubseqCfgs();
+    std::vector<util::DataBlock> transformedSubseqs(numTrnsfSubseqsCfgs);
+    for (size_t i = 0; i < numTrnsfSubseqsCfgs; i++) {
+        uint8_t wordsize = i == numTrnsfSubseqsCfgs - 1 ? outputWordsize : 1;
+        transformedSubseqs[i].setWordSize(wordsize);
+
+        uint64_t trnsfSubseqPayloadSizeRemain = 0;
+        if (i < (numTrnsfSubseqsCfgs - 1)) {
+            trnsfSubseqPayloadSizeRemain = readUInt(pos, end, 4);
+        } else {
+            trnsfSubseqPayloadSizeRemain = uint64_t(end - pos);
+        }
+        if (trnsfSubseqPayloadSizeRemain == 0) {
+            continue;
+        }
+
+        uint64_t numtrnsfSymbols = numDescSubseqSymbols;
+        if (numTrnsfSubseqsCfgs > 1) {
+            numtrnsfSymbols = readUInt(pos, end, 4);
+            trnsfSubseqPayloadSizeRemain -= 4;
+        }
+        if (numtrnsfSymbols == 0) {
+            continue;
+        }
+
+        // The payload is decoded in place, so this is the only copy of the input
+        UTILS_DIE_IF(uint64_t(end - pos) < trnsfSubseqPayloadSizeRemain,
+                     "Descriptor subsequence payload smaller than expected");
+        util::DataBlock decodedTransformedSubseq(pos, trnsfSubseqPayloadSizeRemain, 1);
+        pos += gabac::decodeTransformSubseq(subseqCfg.getTransformSubseqCfg((uint8_t)i), (unsigned int)numtrnsfSymbols,
+                                            &decodedTransformedSubseq, wordsize);
+        transformedSubseqs[i].swap(&(decodedTransformedSubseq));
+    }
+
+    doInverseSubsequenceTransform(subseqCfg, &transformedSubseqs);
+
+    if (transformedSubseqs[0].getWordSize() == outputWordsize) {
+        output->swap(&transformedSubseqs[0]);
+    } else {
+        *output = util::DataBlock(static_cast<const uint8_t *>(transformedSubseqs[0].getData()),
+                                  transformedSubseqs[0].getRawSize() / outputWordsize, outputWordsize);
+    }
+
+    return uint64_t(pos - begin);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace gabac
 }  // namespace entropy
 }  // namespace genie
@@ -41,6 +41,17 @@ void doInverseSubsequenceTransform(const paramcabac::Subsequence& subseqCfg,
  */
 uint64_t decodeDescSubsequence(const IOConfiguration& ioConf, const EncodingConfiguration& enConf);
 
+/**
+ * @brief Decode a descriptor subsequence straight from memory, without stream wrappers. Dependencies are not supported.
+ * @param enConf Configuration of the descriptor subsequence
+ * @param input Encoded descriptor subsequence
+ * @param output Decoded symbols
+ * @param outputWordsize Word size of the decoded symbols
+ * @return Number of bytes consumed from the input
+ */
+uint64_t decodeDescSubsequence(const EncodingConfiguration& enConf, const util::DataBlock& input,
+                               util::DataBlock* output, uint8_t outputWordsize);
+
 // ---------------------------------------------------------------------------------------------------------------------
 
 }  // namespace gabac
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include "genie/entropy/gabac/bin-params.h"
 #include "genie/entropy/gabac/context-selector.h"
 #include "genie/entropy/gabac/luts-subsymbol-transform.h"
 #include "genie/entropy/paramcabac/subsequence.h"
@@ -40,90 +41,28 @@ void decodeSignFlag(Reader &reader, const paramcabac::BinarizationParameters::Bi
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-binFunc getBinarizorReader(const uint8_t outputSymbolSize, const bool bypassFlag,
-                           const paramcabac::BinarizationParameters::BinarizationId binID,
-                           const paramcabac::BinarizationParameters &binarzationParams,
-                           const paramcabac::StateVars &stateVars, std::vector<unsigned int> &binParams) {
-    binFunc func = nullptr;
-    if (bypassFlag) {
-        switch (binID) {
-            case paramcabac::BinarizationParameters::BinarizationId::BI:
-                func = &Reader::readAsBIbypass;
-                binParams[0] = stateVars.getCLengthBI();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::TU:
-                func = &Reader::readAsTUbypass;
-                binParams[0] = binarzationParams.getCMax();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::EG:
-            case paramcabac::BinarizationParameters::BinarizationId::SEG:
-                func = &Reader::readAsEGbypass;
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::TEG:
-            case paramcabac::BinarizationParameters::BinarizationId::STEG:
-                func = &Reader::readAsTEGbypass;
-                binParams[0] = binarzationParams.getCMaxTeg();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::SUTU:
-            case paramcabac::BinarizationParameters::BinarizationId::SSUTU:
-                func = &Reader::readAsSUTUbypass;
-                binParams[0] = outputSymbolSize;
-                binParams[1] = binarzationParams.getSplitUnitSize();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::DTU:
-            case paramcabac::BinarizationParameters::BinarizationId::SDTU:
-                func = &Reader::readAsDTUbypass;
-                binParams[0] = outputSymbolSize;
-                binParams[1] = binarzationParams.getSplitUnitSize();
-                binParams[2] = binarzationParams.getCMaxDtu();
-                break;
-            default:
-                UTILS_DIE("Unknown Binarization");
-        }
-    } else {
-        switch (binID) {
-            case paramcabac::BinarizationParameters::BinarizationId::BI:
-                func = &Reader::readAsBIcabac;
-                binParams[0] = stateVars.getCLengthBI();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::TU:
-                func = &Reader::readAsTUcabac;
-                binParams[0] = binarzationParams.getCMax();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::EG:
-            case paramcabac::BinarizationParameters::BinarizationId::SEG:
-                func = &Reader::readAsEGcabac;
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::TEG:
-            case paramcabac::BinarizationParameters::BinarizationId::STEG:
-                func = &Reader::readAsTEGcabac;
-                binParams[0] = binarzationParams.getCMaxTeg();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::SUTU:
-            case paramcabac::BinarizationParameters::BinarizationId::SSUTU:
-                func = &Reader::readAsSUTUcabac;
-                binParams[0] = outputSymbolSize;
-                binParams[1] = binarzationParams.getSplitUnitSize();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::DTU:
-            case paramcabac::BinarizationParameters::BinarizationId::SDTU:
-                func = &Reader::readAsDTUcabac;
-                binParams[0] = outputSymbolSize;
-                binParams[1] = binarzationParams.getSplitUnitSize();
-                binParams[2] = binarzationParams.getCMaxDtu();
-                break;
-            default:
-                UTILS_DIE("Unknown Binarization");
-        }
+/**
+ * @brief Binarization reader of one binarization and bypass mode
+ */
+struct BinarizorReaderKernel {
+    template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+    static binFunc run() {
+        return &Reader::readAs<binID, bypass>;
     }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
 
-    return func;
+binFunc getBinarizorReader(const bool bypassFlag, const paramcabac::BinarizationParameters::BinarizationId binID) {
+    return dispatchBinarization<BinarizorReaderKernel>(binID, bypassFlag);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-size_t decodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
-                                   const unsigned int numEncodedSymbols, util::DataBlock *bitstream, uint8_t wordsize) {
+template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+static size_t decodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
+                                          const unsigned int numEncodedSymbols, util::DataBlock *bitstream,
+                                          uint8_t wordsize) {
     if (bitstream == nullptr) {
         UTILS_DIE("Bitstream is null");
     }
@@ -134,7 +73,6 @@ size_t decodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
     const paramcabac::Binarization &binarzation = trnsfSubseqConf.getBinarization();
     const paramcabac::BinarizationParameters &binarzationParams = binarzation.getCabacBinarizationParameters();
     const paramcabac::StateVars &stateVars = trnsfSubseqConf.getStateVars();
-    const paramcabac::BinarizationParameters::BinarizationId binID = binarzation.getBinarizationID();
 
     const uint8_t outputSymbolSize = supportVals.getOutputSymbolSize();
     const uint8_t codingSubsymSize = supportVals.getCodingSubsymSize();
@@ -144,8 +82,7 @@ size_t decodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
     Reader reader(bitstream, bypassFlag, (unsigned int)stateVars.getNumCtxTotal());
     reader.start();
 
-    std::vector<unsigned int> binParams(4,  // first three elements are for binarization params, last one is for ctxIdx
-                                        0);
+    BinParams binParams = getBinParams(outputSymbolSize, binID, binarzationParams, stateVars);
 
     util::DataBlock decodedSymbols(numEncodedSymbols, wordsize);
     util::BlockStepper r = decodedSymbols.getReader();
@@ -155,17 +92,15 @@ size_t decodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
     const bool diffEnabled =
         (trnsfSubseqConf.getTransformIDSubsym() == paramcabac::SupportValues::TransformIdSubsym::DIFF_CODING);
 
-    binFunc func = getBinarizorReader(outputSymbolSize, bypassFlag, binID, binarzationParams, stateVars, binParams);
-
     while (r.isValid()) {
         // Decode subsymbols and merge them to construct symbols
         uint64_t symbolValue = 0;
 
         for (uint8_t s = 0; s < stateVars.getNumSubsymbols(); s++) {
             subsymbols[s].subsymIdx = s;
-            binParams[3] = ctxSelector.getContextIdxOrder0(s);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrder0(s);
 
-            subsymbols[s].subsymValue = (reader.*func)(binParams);
+            subsymbols[s].subsymValue = reader.readAs<binID, bypass>(binParams);
 
             if (diffEnabled) {
                 subsymbols[s].subsymValue += subsymbols[s].prvValues[0];
@@ -175,7 +110,7 @@ size_t decodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
             symbolValue = (symbolValue << codingSubsymSize) | subsymbols[s].subsymValue;
         }
 
-        decodeSignFlag(reader, binID, symbolValue);
+        decodeSignFlag(reader, binarzation.getBinarizationID(), symbolValue);
 
         r.set(symbolValue);
         r.inc();
@@ -190,9 +125,10 @@ size_t decodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-size_t decodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
-                                   const unsigned int numEncodedSymbols, util::DataBlock *bitstream,
-                                   util::DataBlock *const depSymbols, uint8_t wordsize) {
+template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+static size_t decodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
+                                          const unsigned int numEncodedSymbols, util::DataBlock *bitstream,
+                                          util::DataBlock *const depSymbols, uint8_t wordsize) {
     if (bitstream == nullptr) {
         UTILS_DIE("Bitstream is null");
     }
@@ -203,7 +139,6 @@ size_t decodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
     const paramcabac::Binarization &binarzation = trnsfSubseqConf.getBinarization();
     const paramcabac::BinarizationParameters &binarzationParams = binarzation.getCabacBinarizationParameters();
     const paramcabac::StateVars &stateVars = trnsfSubseqConf.getStateVars();
-    const paramcabac::BinarizationParameters::BinarizationId binID = binarzation.getBinarizationID();
 
     const uint8_t outputSymbolSize = supportVals.getOutputSymbolSize();
     const uint8_t codingSubsymSize = supportVals.getCodingSubsymSize();
@@ -220,8 +155,7 @@ size_t decodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
     Reader reader(bitstream, bypassFlag, (unsigned int)stateVars.getNumCtxTotal());
     reader.start();
 
-    std::vector<unsigned int> binParams(4,  // first three elements are for binarization params, last one is for ctxIdx
-                                        0);
+    BinParams binParams = getBinParams(outputSymbolSize, binID, binarzationParams, stateVars);
 
     util::DataBlock decodedSymbols(numEncodedSymbols, wordsize);
     util::BlockStepper r = decodedSymbols.getReader();
@@ -243,8 +177,6 @@ size_t decodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
 
     ContextSelector ctxSelector(stateVars);
 
-    binFunc func = getBinarizorReader(outputSymbolSize, bypassFlag, binID, binarzationParams, stateVars, binParams);
-
     while (r.isValid()) {
         // Decode subsymbols and merge them to construct symbols
         uint64_t symbolValue = 0;
@@ -266,14 +198,14 @@ size_t decodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
             }
 
             subsymbols[s].subsymIdx = s;
-            binParams[3] = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
 
             if (customCmaxTU) {
                 subsymbols[s].lutNumMaxElems = invLutsSubsymTrnsfm.getNumMaxElemsOrder1(subsymbols, lutIdx, prvIdx);
-                binParams[0] = (unsigned int)std::min((uint64_t)binarzationParams.getCMax(),
-                                                      subsymbols[s].lutNumMaxElems);  // update cMax
+                binParams.cMax = (unsigned int)std::min((uint64_t)binarzationParams.getCMax(),
+                                                        subsymbols[s].lutNumMaxElems);  // update cMax
             }
-            subsymbols[s].subsymValue = (reader.*func)(binParams);
+            subsymbols[s].subsymValue = reader.readAs<binID, bypass>(binParams);
 
             if (numLuts > 0) {
                 subsymbols[s].lutEntryIdx = subsymbols[s].subsymValue;
@@ -285,7 +217,7 @@ size_t decodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
             symbolValue = (symbolValue << codingSubsymSize) | subsymbols[s].subsymValue;
         }
 
-        decodeSignFlag(reader, binID, symbolValue);
+        decodeSignFlag(reader, binarzation.getBinarizationID(), symbolValue);
 
         r.set(symbolValue);
         r.inc();
@@ -300,8 +232,10 @@ size_t decodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-size_t decodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
-                                   const unsigned int numEncodedSymbols, util::DataBlock *bitstream, uint8_t wordsize) {
+template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+static size_t decodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
+                                          const unsigned int numEncodedSymbols, util::DataBlock *bitstream,
+                                          uint8_t wordsize) {
     if (bitstream == nullptr) {
         UTILS_DIE("Bitstream is null");
     }
@@ -312,7 +246,6 @@ size_t decodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
     const paramcabac::Binarization &binarzation = trnsfSubseqConf.getBinarization();
     const paramcabac::BinarizationParameters &binarzationParams = binarzation.getCabacBinarizationParameters();
     const paramcabac::StateVars &stateVars = trnsfSubseqConf.getStateVars();
-    const paramcabac::BinarizationParameters::BinarizationId binID = binarzation.getBinarizationID();
 
     const uint8_t outputSymbolSize = supportVals.getOutputSymbolSize();
     const uint8_t codingSubsymSize = supportVals.getCodingSubsymSize();
@@ -328,8 +261,7 @@ size_t decodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
     Reader reader(bitstream, bypassFlag, (unsigned int)stateVars.getNumCtxTotal());
     reader.start();
 
-    std::vector<unsigned int> binParams(4,  // first three elements are for binarization params, last one is for ctxIdx
-                                        0);
+    BinParams binParams = getBinParams(outputSymbolSize, binID, binarzationParams, stateVars);
 
     util::DataBlock decodedSymbols(numEncodedSymbols, wordsize);
     util::BlockStepper r = decodedSymbols.getReader();
@@ -346,8 +278,6 @@ size_t decodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
 
     ContextSelector ctxSelector(stateVars);
 
-    binFunc func = getBinarizorReader(outputSymbolSize, bypassFlag, binID, binarzationParams, stateVars, binParams);
-
     while (r.isValid()) {
         // Decode subsymbols and merge them to construct symbols
         uint64_t symbolValue = 0;
@@ -357,14 +287,14 @@ size_t decodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
             const uint8_t prvIdx = (numPrvs > 1) ? s : 0;  // either private or shared PRV
 
             subsymbols[s].subsymIdx = s;
-            binParams[3] = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
 
             if (customCmaxTU) {
                 subsymbols[s].lutNumMaxElems = invLutsSubsymTrnsfm.getNumMaxElemsOrder2(subsymbols, lutIdx, prvIdx);
-                binParams[0] = (unsigned int)std::min((uint64_t)binarzationParams.getCMax(),
-                                                      subsymbols[s].lutNumMaxElems);  // update cMax
+                binParams.cMax = (unsigned int)std::min((uint64_t)binarzationParams.getCMax(),
+                                                        subsymbols[s].lutNumMaxElems);  // update cMax
             }
-            subsymbols[s].subsymValue = (reader.*func)(binParams);
+            subsymbols[s].subsymValue = reader.readAs<binID, bypass>(binParams);
 
             if (numLuts > 0) {
                 subsymbols[s].lutEntryIdx = subsymbols[s].subsymValue;
@@ -377,7 +307,7 @@ size_t decodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
             symbolValue = (symbolValue << codingSubsymSize) | subsymbols[s].subsymValue;
         }
 
-        decodeSignFlag(reader, binID, symbolValue);
+        decodeSignFlag(reader, binarzation.getBinarizationID(), symbolValue);
 
         r.set(symbolValue);
         r.inc();
@@ -392,21 +322,40 @@ size_t decodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Decoder of one binarization and bypass mode for all coding orders
+ */
+struct DecodeTransformSubseqKernel {
+    template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+    static size_t run(const paramcabac::TransformedSubSeq &trnsfSubseqConf, const unsigned int numEncodedSymbols,
+                      util::DataBlock *bitstream, uint8_t wordsize, util::DataBlock *const depSymbols) {
+        switch (trnsfSubseqConf.getSupportValues().getCodingOrder()) {
+            case 0:
+                return decodeTransformSubseqOrder0<binID, bypass>(trnsfSubseqConf, numEncodedSymbols, bitstream,
+                                                                  wordsize);
+                break;
+            case 1:
+                return decodeTransformSubseqOrder1<binID, bypass>(trnsfSubseqConf, numEncodedSymbols, bitstream,
+                                                                  depSymbols, wordsize);
+                break;
+            case 2:
+                return decodeTransformSubseqOrder2<binID, bypass>(trnsfSubseqConf, numEncodedSymbols, bitstream,
+                                                                  wordsize);
+                break;
+            default:
+                UTILS_DIE("Unknown coding order");
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 size_t decodeTransformSubseq(const paramcabac::TransformedSubSeq &trnsfSubseqConf, const unsigned int numEncodedSymbols,
                              util::DataBlock *bitstream, uint8_t wordsize, util::DataBlock *const depSymbols) {
-    switch (trnsfSubseqConf.getSupportValues().getCodingOrder()) {
-        case 0:
-            return decodeTransformSubseqOrder0(trnsfSubseqConf, numEncodedSymbols, bitstream, wordsize);
-            break;
-        case 1:
-            return decodeTransformSubseqOrder1(trnsfSubseqConf, numEncodedSymbols, bitstream, depSymbols, wordsize);
-            break;
-        case 2:
-            return decodeTransformSubseqOrder2(trnsfSubseqConf, numEncodedSymbols, bitstream, wordsize);
-            break;
-        default:
-            UTILS_DIE("Unknown coding order");
-    }
+    const paramcabac::Binarization &binarzation = trnsfSubseqConf.getBinarization();
+    return dispatchBinarization<DecodeTransformSubseqKernel>(binarzation.getBinarizationID(),
+                                                             binarzation.getBypassFlag(), trnsfSubseqConf,
+                                                             numEncodedSymbols, bitstream, wordsize, depSymbols);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
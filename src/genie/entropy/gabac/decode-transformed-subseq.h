@@ -33,7 +33,7 @@ namespace gabac {
 /**
  * @brief
  */
-typedef uint64_t (Reader::*binFunc)(const std::vector<unsigned int>);
+typedef uint64_t (Reader::*binFunc)(const BinParams &);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -50,18 +50,11 @@ void decodeSignFlag(Reader &reader, const paramcabac::BinarizationParameters::Bi
 
 /**
  * @brief
- * @param outputSymbolSize
  * @param bypassFlag
  * @param binID
- * @param binarzationParams
- * @param stateVars
- * @param binParams
- * @return
+ * @return Reader kernel of the binarization, signed binarizations use the kernel of the unsigned one
  */
-binFunc getBinarizorReader(const uint8_t outputSymbolSize, const bool bypassFlag,
-                           const paramcabac::BinarizationParameters::BinarizationId binID,
-                           const paramcabac::BinarizationParameters &binarzationParams,
-                           const paramcabac::StateVars &stateVars, std::vector<unsigned int> &binParams);
+binFunc getBinarizorReader(const bool bypassFlag, const paramcabac::BinarizationParameters::BinarizationId binID);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
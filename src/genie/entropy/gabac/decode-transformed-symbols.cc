@@ -40,11 +40,10 @@ TransformedSymbolsDecoder::TransformedSymbolsDecoder(util::DataBlock *bitstream,
       customCmaxTU(false),
       defaultCmax(trnsfSubseqConf.getBinarization().getCabacBinarizationParameters().getCMax()),
       binID(trnsfSubseqConf.getBinarization().getBinarizationID()),
-      binParams(
-          std::vector<unsigned int>(4, 0)),  // first three elements are for binarization params, last one is for ctxIdx
-      binarizor(getBinarizorReader(outputSymbolSize, trnsfSubseqConf.getBinarization().getBypassFlag(), binID,
-                                   trnsfSubseqConf.getBinarization().getCabacBinarizationParameters(),
-                                   trnsfSubseqConf.getStateVars(), binParams)) {
+      binParams(getBinParams(outputSymbolSize, binID,
+                             trnsfSubseqConf.getBinarization().getCabacBinarizationParameters(),
+                             trnsfSubseqConf.getStateVars())),
+      binarizor(getBinarizorReader(trnsfSubseqConf.getBinarization().getBypassFlag(), binID)) {
     if (bitstream == nullptr || bitstream->size() <= 0) return;  // Simple return as bitstream can be empty
     if (numEncodedSymbols <= 0) return;                          // Simple return as numEncodedSymbols can be zero
 
@@ -109,7 +108,7 @@ uint64_t TransformedSymbolsDecoder::decodeNextSymbolOrder0() {
         std::vector<Subsymbol> subsymbols(numSubSyms);
         for (uint8_t s = 0; s < numSubSyms; s++) {
             subsymbols[s].subsymIdx = s;
-            binParams[3] = ctxSelector.getContextIdxOrder0(s);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrder0(s);
 
             subsymbols[s].subsymValue = (reader.*binarizor)(binParams);
 
@@ -149,11 +148,11 @@ uint64_t TransformedSymbolsDecoder::decodeNextSymbolOrder1(uint64_t *depSymbol)
             }
 
             subsymbols[s].subsymIdx = s;
-            binParams[3] = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
 
             if (customCmaxTU) {
                 subsymbols[s].lutNumMaxElems = invLutsSubsymTrnsfm.getNumMaxElemsOrder1(subsymbols, lutIdx, prvIdx);
-                binParams[0] = (unsigned int)std::min(defaultCmax, subsymbols[s].lutNumMaxElems);  // update cMax
+                binParams.cMax = (unsigned int)std::min(defaultCmax, subsymbols[s].lutNumMaxElems);  // update cMax
             }
             subsymbols[s].subsymValue = (reader.*binarizor)(binParams);
 
@@ -187,11 +186,11 @@ uint64_t TransformedSymbolsDecoder::decodeNextSymbolOrder2() {
             const uint8_t prvIdx = (numPrvs > 1) ? s : 0;  // either private or shared PRV
 
             subsymbols[s].subsymIdx = s;
-            binParams[3] = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
 
             if (customCmaxTU) {
                 subsymbols[s].lutNumMaxElems = invLutsSubsymTrnsfm.getNumMaxElemsOrder2(subsymbols, lutIdx, prvIdx);
-                binParams[0] = (unsigned int)std::min(defaultCmax, subsymbols[s].lutNumMaxElems);  // update cMax
+                binParams.cMax = (unsigned int)std::min(defaultCmax, subsymbols[s].lutNumMaxElems);  // update cMax
             }
             subsymbols[s].subsymValue = (reader.*binarizor)(binParams);
 
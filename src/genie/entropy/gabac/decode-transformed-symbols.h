@@ -98,7 +98,7 @@ class TransformedSymbolsDecoder {
     uint64_t defaultCmax;  //!< @brief
 
     paramcabac::BinarizationParameters::BinarizationId binID;  //!< @brief
-    std::vector<unsigned int> binParams;                       //!< @brief
+    BinParams binParams;                                       //!< @brief
     binFunc binarizor;                                         //!< @brief
 };
 
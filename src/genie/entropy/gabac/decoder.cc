@@ -6,14 +6,15 @@
 
 #include "genie/entropy/gabac/decoder.h"
 #include <algorithm>
-#include <iostream>
 #include <tuple>
 #include <utility>
 #include "genie/entropy/gabac/decode-desc-subseq.h"
 #include "genie/entropy/gabac/decode-transformed-subseq.h"
 #include "genie/entropy/gabac/mismatch-decoder.h"
+#include "genie/entropy/gabac/stat-ids.h"
 #include "genie/entropy/gabac/stream-handler.h"
 #include "genie/util/runtime-exception.h"
+#include "genie/util/task-scheduler.h"
 #include "genie/util/watch.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -127,31 +128,12 @@ core::AccessUnit::Subsequence Decoder::decompress(const gabac::EncodingConfigura
         return in;
     }
 
-    // Interface to GABAC library
+    // Interface to GABAC library, decoding straight into the output block
     util::DataBlock buffer = in.move();
-    gabac::IBufferStream in_stream(&buffer, 0);
-
     uint8_t bytes = genie::core::range2bytes(core::getSubsequence(id).range);
     util::DataBlock tmp(0, bytes);
-    gabac::OBufferStream outbuffer(&tmp);
-
-    // Setup
-    const size_t GABAC_BLOCK_SIZE = 0;  // 0 means single block (block size is equal to input size)
-    std::ostream* const GABC_LOG_OUTPUT_STREAM = &std::cerr;
-    const gabac::IOConfiguration GABAC_IO_SETUP = {&in_stream,
-                                                   1,
-                                                   nullptr,
-                                                   &outbuffer,
-                                                   bytes,
-                                                   GABAC_BLOCK_SIZE,
-                                                   GABC_LOG_OUTPUT_STREAM,
-                                                   gabac::IOConfiguration::LogLevel::LOG_TRACE};
-    const bool GABAC_DECODING_MODE = true;
-
-    // Run
-    gabac::run(GABAC_IO_SETUP, conf, GABAC_DECODING_MODE);
-
-    outbuffer.flush(&tmp);
+    gabac::decodeDescSubsequence(conf, buffer, &tmp, bytes);
+
     return core::AccessUnit::Subsequence(std::move(tmp), in.getID());
 }
 
@@ -160,6 +142,7 @@ core::AccessUnit::Subsequence Decoder::decompress(const gabac::EncodingConfigura
 std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> Decoder::process(
     const core::parameter::DescriptorSubseqCfg& param, core::AccessUnit::Descriptor& d, bool mmCoderEnabled) {
     util::Watch watch;
+    const auto& ids = StatIDs::get();
     std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> desc;
     std::get<0>(desc) = std::move(d);
     const auto& param_desc = dynamic_cast<const core::parameter::desc_pres::DescriptorPresent&>(param.get());
@@ -170,9 +153,8 @@ std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> Decoder::proces
         }
 
         if (size) {
-            std::get<1>(desc).addInteger("size-gabac-total-comp", size);
-            std::get<1>(desc).addInteger("size-gabac-" + core::getDescriptor(std::get<0>(desc).getID()).name + "-comp",
-                                         size);
+            std::get<1>(desc).addInteger(ids.total.comp, size);
+            std::get<1>(desc).addInteger(ids.get(std::get<0>(desc).getID()).comp, size);
         }
 
         const auto& token_param = dynamic_cast<const paramcabac::DecoderTokenType&>(param_desc.getDecoder());
@@ -183,41 +165,37 @@ std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> Decoder::proces
                              gabac::EncodingConfiguration(std::move(conf1)), std::move(*std::get<0>(desc).begin()));
 
         if (size) {
-            std::get<1>(desc).addInteger("size-gabac-total-raw", std::get<0>(desc).begin()->getRawSize());
-            std::get<1>(desc).addInteger("size-gabac-" + core::getDescriptor(std::get<0>(desc).getID()).name + "-raw",
+            std::get<1>(desc).addInteger(ids.total.raw, std::get<0>(desc).begin()->getRawSize());
+            std::get<1>(desc).addInteger(ids.get(std::get<0>(desc).getID()).raw,
                                          std::get<0>(desc).begin()->getRawSize());
         }
     } else {
+        // Subsequences are independent streams, decode them concurrently
+        const auto& token_param = dynamic_cast<const paramcabac::DecoderRegular&>(param_desc.getDecoder());
+        util::TaskGroup group;
         for (auto& subseq : std::get<0>(desc)) {
             if (subseq.isEmpty()) {
                 continue;
             }
-            auto d_id = subseq.getID();
-
-            const auto& token_param = dynamic_cast<const paramcabac::DecoderRegular&>(param_desc.getDecoder());
-            auto conf0 = token_param.getSubsequenceCfg((uint8_t)d_id.second);
+            std::get<1>(desc).addInteger(ids.total.comp, subseq.getRawSize());
+            std::get<1>(desc).addInteger(ids.get(subseq.getID()).comp, subseq.getRawSize());
+
+            auto* s = &subseq;
+            group.run([&token_param, s, mmCoderEnabled]() {
+                auto conf0 = token_param.getSubsequenceCfg((uint8_t)s->getID().second);
+                *s = decompress(gabac::EncodingConfiguration(std::move(conf0)), std::move(*s), mmCoderEnabled);
+            });
+        }
+        group.wait();
 
+        for (const auto& subseq : std::get<0>(desc)) {
             if (!subseq.isEmpty()) {
-                std::get<1>(desc).addInteger("size-gabac-total-comp", subseq.getRawSize());
-                std::get<1>(desc).addInteger(
-                    "size-gabac-" + core::getDescriptor(std::get<0>(desc).getID()).name + "-" +
-                        core::getDescriptor(std::get<0>(desc).getID()).subseqs[d_id.second].name + "-comp",
-                    subseq.getRawSize());
-            }
-
-            std::get<0>(desc).set(d_id.second, decompress(gabac::EncodingConfiguration(std::move(conf0)),
-                                                          std::move(subseq), mmCoderEnabled));
-
-            if (!std::get<0>(desc).get(d_id.second).isEmpty()) {
-                std::get<1>(desc).addInteger("size-gabac-total-raw", std::get<0>(desc).get(d_id.second).getRawSize());
-                std::get<1>(desc).addInteger(
-                    "size-gabac-" + core::getDescriptor(std::get<0>(desc).getID()).name + "-" +
-                        core::getDescriptor(std::get<0>(desc).getID()).subseqs[d_id.second].name + "-raw",
-                    std::get<0>(desc).get(d_id.second).getRawSize());
+                std::get<1>(desc).addInteger(ids.total.raw, subseq.getRawSize());
+                std::get<1>(desc).addInteger(ids.get(subseq.getID()).raw, subseq.getRawSize());
             }
         }
     }
-    std::get<1>(desc).addDouble("time-gabac", watch.check());
+    std::get<1>(desc).addDouble(ids.time, watch.check());
     return desc;
 }
 
@@ -7,6 +7,7 @@
 #include "genie/entropy/gabac/encode-transformed-subseq.h"
 #include <algorithm>
 #include <cassert>
+#include "genie/entropy/gabac/bin-params.h"
 #include "genie/entropy/gabac/context-selector.h"
 #include "genie/entropy/gabac/luts-subsymbol-transform.h"
 #include "genie/entropy/gabac/writer.h"
@@ -21,10 +22,6 @@ namespace gabac {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-typedef void (Writer::*binFunc)(uint64_t, const std::vector<unsigned int>);
-
-// ---------------------------------------------------------------------------------------------------------------------
-
 /* static inline void encodeSignflag(Writer &writer, const paramcabac::BinarizationParameters::BinarizationId binID,
                                   const int64_t signedSymbolValue) {
     if (signedSymbolValue != 0) {
@@ -43,90 +40,9 @@ typedef void (Writer::*binFunc)(uint64_t, const std::vector<unsigned int>);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-static inline binFunc getBinarizorWriter(const uint8_t outputSymbolSize, const bool bypassFlag,
-                                         const paramcabac::BinarizationParameters::BinarizationId binID,
-                                         const paramcabac::BinarizationParameters &binarzationParams,
-                                         const paramcabac::StateVars &stateVars, std::vector<unsigned int> &binParams) {
-    binFunc func = nullptr;
-    if (bypassFlag) {
-        switch (binID) {
-            case paramcabac::BinarizationParameters::BinarizationId::BI:
-                func = &Writer::writeAsBIbypass;
-                binParams[0] = stateVars.getCLengthBI();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::TU:
-                func = &Writer::writeAsTUbypass;
-                binParams[0] = binarzationParams.getCMax();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::EG:
-            case paramcabac::BinarizationParameters::BinarizationId::SEG:
-                func = &Writer::writeAsEGbypass;
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::TEG:
-            case paramcabac::BinarizationParameters::BinarizationId::STEG:
-                func = &Writer::writeAsTEGbypass;
-                binParams[0] = binarzationParams.getCMaxTeg();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::SUTU:
-            case paramcabac::BinarizationParameters::BinarizationId::SSUTU:
-                func = &Writer::writeAsSUTUbypass;
-                binParams[0] = outputSymbolSize;
-                binParams[1] = binarzationParams.getSplitUnitSize();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::DTU:
-            case paramcabac::BinarizationParameters::BinarizationId::SDTU:
-                func = &Writer::writeAsDTUbypass;
-                binParams[0] = outputSymbolSize;
-                binParams[1] = binarzationParams.getSplitUnitSize();
-                binParams[2] = binarzationParams.getCMaxDtu();
-                break;
-            default:
-                UTILS_DIE("Unknown Binarization");
-        }
-    } else {
-        switch (binID) {
-            case paramcabac::BinarizationParameters::BinarizationId::BI:
-                func = &Writer::writeAsBIcabac;
-                binParams[0] = stateVars.getCLengthBI();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::TU:
-                func = &Writer::writeAsTUcabac;
-                binParams[0] = binarzationParams.getCMax();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::EG:
-            case paramcabac::BinarizationParameters::BinarizationId::SEG:
-                func = &Writer::writeAsEGcabac;
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::TEG:
-            case paramcabac::BinarizationParameters::BinarizationId::STEG:
-                func = &Writer::writeAsTEGcabac;
-                binParams[0] = binarzationParams.getCMaxTeg();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::SUTU:
-            case paramcabac::BinarizationParameters::BinarizationId::SSUTU:
-                func = &Writer::writeAsSUTUcabac;
-                binParams[0] = outputSymbolSize;
-                binParams[1] = binarzationParams.getSplitUnitSize();
-                break;
-            case paramcabac::BinarizationParameters::BinarizationId::DTU:
-            case paramcabac::BinarizationParameters::BinarizationId::SDTU:
-                func = &Writer::writeAsDTUcabac;
-                binParams[0] = outputSymbolSize;
-                binParams[1] = binarzationParams.getSplitUnitSize();
-                binParams[2] = binarzationParams.getCMaxDtu();
-                break;
-            default:
-                UTILS_DIE("Unknown Binarization");
-        }
-    }
-
-    return func;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-size_t encodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSubseqConf, util::DataBlock *symbols,
-                                   size_t maxSize) {
+template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+static size_t encodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
+                                          util::DataBlock *symbols, size_t maxSize) {
     assert(symbols != nullptr);
 
     size_t numSymbols = symbols->size();
@@ -136,7 +52,6 @@ size_t encodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
     const paramcabac::Binarization &binarzation = trnsfSubseqConf.getBinarization();
     const paramcabac::BinarizationParameters &binarzationParams = binarzation.getCabacBinarizationParameters();
     const paramcabac::StateVars &stateVars = trnsfSubseqConf.getStateVars();
-    const paramcabac::BinarizationParameters::BinarizationId binID = binarzation.getBinarizationID();
 
     const uint8_t outputSymbolSize = supportVals.getOutputSymbolSize();
     const uint8_t codingSubsymSize = supportVals.getCodingSubsymSize();
@@ -148,8 +63,7 @@ size_t encodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
     Writer writer(&bitstream, bypassFlag, (unsigned int)stateVars.getNumCtxTotal());
     writer.start();
 
-    std::vector<unsigned int> binParams(4,  // first three elements are for binarization params, last one is for ctxIdx
-                                        0);
+    BinParams binParams = getBinParams(outputSymbolSize, binID, binarzationParams, stateVars);
 
     util::BlockStepper r = symbols->getReader();
     std::vector<Subsymbol> subsymbols(stateVars.getNumSubsymbols());
@@ -158,8 +72,6 @@ size_t encodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
     const bool diffEnabled =
         (trnsfSubseqConf.getTransformIDSubsym() == paramcabac::SupportValues::TransformIdSubsym::DIFF_CODING);
 
-    binFunc func = getBinarizorWriter(outputSymbolSize, bypassFlag, binID, binarzationParams, stateVars, binParams);
-
     while (r.isValid()) {
         if (maxSize <= bitstream.size()) {
             break;
@@ -182,9 +94,9 @@ size_t encodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
                 subsymbols[s].prvValues[0] = subsymbols[s].subsymValue;
             }
 
-            binParams[3] = ctxSelector.getContextIdxOrder0(s);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrder0(s);
 
-            (writer.*func)(subsymValToCode, binParams);
+            writer.writeAs<binID, bypass>(subsymValToCode, binParams);
         }
 
         // encodeSignflag(writer, binID, signedSymbolValue);
@@ -201,8 +113,9 @@ size_t encodeTransformSubseqOrder0(const paramcabac::TransformedSubSeq &trnsfSub
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-size_t encodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSubseqConf, util::DataBlock *symbols,
-                                   util::DataBlock *const depSymbols, size_t maxSize) {
+template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+static size_t encodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
+                                          util::DataBlock *symbols, util::DataBlock *const depSymbols, size_t maxSize) {
     assert(symbols != nullptr);
 
     size_t numSymbols = symbols->size();
@@ -212,7 +125,6 @@ size_t encodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
     const paramcabac::Binarization &binarzation = trnsfSubseqConf.getBinarization();
     const paramcabac::BinarizationParameters &binarzationParams = binarzation.getCabacBinarizationParameters();
     const paramcabac::StateVars &stateVars = trnsfSubseqConf.getStateVars();
-    const paramcabac::BinarizationParameters::BinarizationId binID = binarzation.getBinarizationID();
 
     const uint8_t outputSymbolSize = supportVals.getOutputSymbolSize();
     const uint8_t codingSubsymSize = supportVals.getCodingSubsymSize();
@@ -230,8 +142,7 @@ size_t encodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
     Writer writer(&bitstream, bypassFlag, (unsigned int)stateVars.getNumCtxTotal());
     writer.start();
 
-    std::vector<unsigned int> binParams(4,  // first three elements are for binarization params, last one is for ctxIdx
-                                        0);
+    BinParams binParams = getBinParams(outputSymbolSize, binID, binarzationParams, stateVars);
 
     util::BlockStepper r = symbols->getReader();
     std::vector<Subsymbol> subsymbols(stateVars.getNumSubsymbols());
@@ -248,8 +159,6 @@ size_t encodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
 
     ContextSelector ctxSelector(stateVars);
 
-    binFunc func = getBinarizorWriter(outputSymbolSize, bypassFlag, binID, binarzationParams, stateVars, binParams);
-
     while (r.isValid()) {
         if (maxSize <= bitstream.size()) {
             break;
@@ -283,19 +192,19 @@ size_t encodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
             subsymValToCode = subsymbols[s].subsymValue = (symbolValue >> (oss -= codingSubsymSize)) & subsymMask;
             subsymbols[s].subsymIdx = s;
 
-            binParams[3] = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
 
             if (numLuts > 0) {
                 subsymbols[s].lutEntryIdx = 0;
                 lutsSubsymTrnsfm.transformOrder1(subsymbols, s, lutIdx, prvIdx);
                 subsymValToCode = subsymbols[s].lutEntryIdx;
                 if (binID == paramcabac::BinarizationParameters::BinarizationId::TU) {
-                    binParams[0] = (unsigned int)std::min((uint64_t)binarzationParams.getCMax(),
-                                                          subsymbols[s].lutNumMaxElems);  // update cMax
+                    binParams.cMax = (unsigned int)std::min((uint64_t)binarzationParams.getCMax(),
+                                                            subsymbols[s].lutNumMaxElems);  // update cMax
                 }
             }
 
-            (writer.*func)(subsymValToCode, binParams);
+            writer.writeAs<binID, bypass>(subsymValToCode, binParams);
 
             subsymbols[prvIdx].prvValues[0] = subsymbols[s].subsymValue;
         }
@@ -314,8 +223,9 @@ size_t encodeTransformSubseqOrder1(const paramcabac::TransformedSubSeq &trnsfSub
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-size_t encodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSubseqConf, util::DataBlock *symbols,
-                                   size_t maxSize) {
+template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+static size_t encodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSubseqConf,
+                                          util::DataBlock *symbols, size_t maxSize) {
     assert(symbols != nullptr);
 
     size_t numSymbols = symbols->size();
@@ -325,7 +235,6 @@ size_t encodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
     const paramcabac::Binarization &binarzation = trnsfSubseqConf.getBinarization();
     const paramcabac::BinarizationParameters &binarzationParams = binarzation.getCabacBinarizationParameters();
     const paramcabac::StateVars &stateVars = trnsfSubseqConf.getStateVars();
-    const paramcabac::BinarizationParameters::BinarizationId binID = binarzation.getBinarizationID();
 
     const uint8_t outputSymbolSize = supportVals.getOutputSymbolSize();
     const uint8_t codingSubsymSize = supportVals.getCodingSubsymSize();
@@ -343,8 +252,7 @@ size_t encodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
     Writer writer(&bitstream, bypassFlag, (unsigned int)stateVars.getNumCtxTotal());
     writer.start();
 
-    std::vector<unsigned int> binParams(4,  // first three elements are for binarization params, last one is for ctxIdx
-                                        0);
+    BinParams binParams = getBinParams(outputSymbolSize, binID, binarzationParams, stateVars);
 
     util::BlockStepper r = symbols->getReader();
     std::vector<Subsymbol> subsymbols(stateVars.getNumSubsymbols());
@@ -356,8 +264,6 @@ size_t encodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
 
     ContextSelector ctxSelector(stateVars);
 
-    binFunc func = getBinarizorWriter(outputSymbolSize, bypassFlag, binID, binarzationParams, stateVars, binParams);
-
     while (r.isValid()) {
         if (maxSize <= bitstream.size()) {
             break;
@@ -378,19 +284,19 @@ size_t encodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
             subsymValToCode = subsymbols[s].subsymValue = (symbolValue >> (oss -= codingSubsymSize)) & subsymMask;
             subsymbols[s].subsymIdx = s;
 
-            binParams[3] = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
+            binParams.ctxIdx = ctxSelector.getContextIdxOrderGT0(s, prvIdx, subsymbols, codingOrder);
 
             if (numLuts > 0) {
                 subsymbols[s].lutEntryIdx = 0;
                 lutsSubsymTrnsfm.transformOrder2(subsymbols, s, lutIdx, prvIdx);
                 subsymValToCode = subsymbols[s].lutEntryIdx;
                 if (binID == paramcabac::BinarizationParameters::BinarizationId::TU) {
-                    binParams[0] = (unsigned int)std::min((uint64_t)binarzationParams.getCMax(),
-                                                          subsymbols[s].lutNumMaxElems);  // update cMax
+                    binParams.cMax = (unsigned int)std::min((uint64_t)binarzationParams.getCMax(),
+                                                            subsymbols[s].lutNumMaxElems);  // update cMax
                 }
             }
 
-            (writer.*func)(subsymValToCode, binParams);
+            writer.writeAs<binID, bypass>(subsymValToCode, binParams);
 
             subsymbols[prvIdx].prvValues[1] = subsymbols[prvIdx].prvValues[0];
             subsymbols[prvIdx].prvValues[0] = subsymbols[s].subsymValue;
@@ -410,21 +316,37 @@ size_t encodeTransformSubseqOrder2(const paramcabac::TransformedSubSeq &trnsfSub
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Encoder of one binarization and bypass mode for all coding orders
+ */
+struct EncodeTransformSubseqKernel {
+    template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+    static size_t run(const paramcabac::TransformedSubSeq &trnsfSubseqConf, util::DataBlock *symbols,
+                      util::DataBlock *const depSymbols, size_t maxSize) {
+        switch (trnsfSubseqConf.getSupportValues().getCodingOrder()) {
+            case 0:
+                return encodeTransformSubseqOrder0<binID, bypass>(trnsfSubseqConf, symbols, maxSize);
+                break;
+            case 1:
+                return encodeTransformSubseqOrder1<binID, bypass>(trnsfSubseqConf, symbols, depSymbols, maxSize);
+                break;
+            case 2:
+                return encodeTransformSubseqOrder2<binID, bypass>(trnsfSubseqConf, symbols, maxSize);
+                break;
+            default:
+                UTILS_DIE("Unknown coding order");
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 size_t encodeTransformSubseq(const paramcabac::TransformedSubSeq &trnsfSubseqConf, util::DataBlock *symbols,
                              util::DataBlock *const depSymbols, size_t maxSize) {
-    switch (trnsfSubseqConf.getSupportValues().getCodingOrder()) {
-        case 0:
-            return encodeTransformSubseqOrder0(trnsfSubseqConf, symbols, maxSize);
-            break;
-        case 1:
-            return encodeTransformSubseqOrder1(trnsfSubseqConf, symbols, depSymbols, maxSize);
-            break;
-        case 2:
-            return encodeTransformSubseqOrder2(trnsfSubseqConf, symbols, maxSize);
-            break;
-        default:
-            UTILS_DIE("Unknown coding order");
-    }
+    const paramcabac::Binarization &binarzation = trnsfSubseqConf.getBinarization();
+    return dispatchBinarization<EncodeTransformSubseqKernel>(binarzation.getBinarizationID(),
+                                                             binarzation.getBypassFlag(), trnsfSubseqConf, symbols,
+                                                             depSymbols, maxSize);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
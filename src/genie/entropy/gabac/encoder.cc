@@ -8,9 +8,13 @@
 #include <atomic>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
+#include "genie/entropy/gabac/stat-ids.h"
 #include "genie/util/make-unique.h"
+#include "genie/util/task-scheduler.h"
 #include "genie/util/watch.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -44,11 +48,21 @@ core::AccessUnit::Descriptor Encoder::compressTokens(const gabac::EncodingConfig
     writer.write(desc.begin()->getNumSymbols(), 32);
     writer.write(num_streams, 16);
 
+    // Token types are independent streams, compress them concurrently and write them in order afterwards
+    util::TaskGroup group;
+    for (auto &subsequence : desc) {
+        if (subsequence.getNumSymbols()) {
+            auto *s = &subsequence;
+            group.run([&conf0, s]() { *s = compress(conf0, std::move(*s)); });
+        }
+    }
+    group.wait();
+
     for (auto &subsequence : desc) {
         if (subsequence.getNumSymbols()) {
             writer.write(subsequence.getID().second & 0xfu, 4);
             writer.write(3, 4);
-            compress(conf0, std::move(subsequence)).write(writer);
+            subsequence.write(writer);
         }
     }
 
@@ -107,59 +121,87 @@ core::AccessUnit::Subsequence Encoder::compress(const gabac::EncodingConfigurati
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-core::EntropyEncoder::EntropyCoded Encoder::process(core::AccessUnit::Descriptor &desc) {
+core::EntropyEncoder::EntropyCoded Encoder::process(core::AccessUnit::Descriptor &desc,
+                                                   const util::Section &records) {
     EntropyCoded ret;
     util::Watch watch;
+    const auto& ids = StatIDs::get();
     std::get<1>(ret) = std::move(desc);
+    if (adaptive) {
+        // Other access units may wait for the selections of this one, so settle the trivial ones first
+        adaptive->begin(std::get<1>(ret), records);
+    }
     if (!getDescriptor(std::get<1>(ret).getID()).tokentype) {
+        // Adaptively selected configurations, they have to end up in the parameter set
+        std::vector<std::shared_ptr<const gabac::EncodingConfiguration>> selected(
+            getDescriptor(std::get<1>(ret).getID()).subseqs.size());
+        std::vector<core::GenSubIndex> empty;
+
+        // Subsequences are independent streams, compress them concurrently
+        util::TaskGroup group;
         for (auto &subdesc : std::get<1>(ret)) {
+            auto id = subdesc.getID();
             if (!subdesc.isEmpty()) {
-                const auto &conf = configSet.getConfAsGabac(subdesc.getID());
+                const auto *manual = &configSet.getConfAsGabac(id);
+
+                std::get<2>(ret).addInteger(ids.total.raw, subdesc.getRawSize());
+                std::get<2>(ret).addInteger(ids.get(id).raw, subdesc.getRawSize());
+
                 // add compressed payload
-                auto id = subdesc.getID();
-
-                std::get<2>(ret).addInteger("size-gabac-total-raw", subdesc.getRawSize());
-                std::get<2>(ret).addInteger("size-gabac-" + core::getDescriptor(std::get<1>(ret).getID()).name + "-" +
-                                                core::getDescriptor(std::get<1>(ret).getID()).subseqs[id.second].name +
-                                                "-raw",
-                                            subdesc.getRawSize());
-
-                std::get<1>(ret).set(id.second, compress(conf, std::move(subdesc)));
-
-                if (!std::get<1>(ret).get(id.second).isEmpty()) {
-                    std::get<2>(ret).addInteger("size-gabac-total-comp", std::get<1>(ret).get(id.second).getRawSize());
-                    std::get<2>(ret).addInteger(
-                        "size-gabac-" + core::getDescriptor(std::get<1>(ret).getID()).name + "-" +
-                            core::getDescriptor(std::get<1>(ret).getID()).subseqs[id.second].name + "-comp",
-                        std::get<1>(ret).get(id.second).getRawSize());
-                }
+                auto *s = &subdesc;
+                auto *selection = &selected[uint8_t(id.second)];
+                auto *selector = adaptive.get();
+                group.run([manual, selection, selector, s, &records]() {
+                    const auto *conf = manual;
+                    if (selector) {
+                        *selection = selector->select(*s, *manual, records);
+                        conf = selection->get();
+                    }
+                    *s = compress(*conf, std::move(*s));
+                });
             } else {
+                empty.push_back(id);
                 // add empty payload
                 std::get<1>(ret).set(subdesc.getID().second,
                                      core::AccessUnit::Subsequence(subdesc.getID(), util::DataBlock(0, 1)));
             }
         }
-        configSet.storeParameters(std::get<1>(ret).getID(), std::get<0>(ret));
+        group.wait();
+        if (adaptive) {
+            // Keep the parameter set stable for subsequences without data in this access unit
+            for (const auto &id : empty) {
+                selected[uint8_t(id.second)] = adaptive->get(id, records);
+            }
+        }
+
+        for (const auto &subdesc : std::get<1>(ret)) {
+            if (!subdesc.isEmpty()) {
+                std::get<2>(ret).addInteger(ids.total.comp, subdesc.getRawSize());
+                std::get<2>(ret).addInteger(ids.get(subdesc.getID()).comp, subdesc.getRawSize());
+            }
+        }
+        std::vector<const gabac::EncodingConfiguration *> overrides;
+        for (const auto &s : selected) {
+            overrides.push_back(s.get());
+        }
+        configSet.storeParameters(std::get<1>(ret).getID(), overrides, std::get<0>(ret));
     } else {
         size_t size = 0;
         for (const auto &s : std::get<1>(ret)) {
             size += s.getNumSymbols() * sizeof(uint32_t);
         }
-        std::string name = getDescriptor(std::get<1>(ret).getID()).name;
         const auto &conf = configSet.getConfAsGabac({std::get<1>(ret).getID(), (uint16_t)0});
         std::get<1>(ret) = compressTokens(conf, std::move(std::get<1>(ret)));
         configSet.storeParameters(std::get<1>(ret).getID(), std::get<0>(ret));
 
         if (size) {
-            std::get<2>(ret).addInteger("size-gabac-total-raw", size);
-            std::get<2>(ret).addInteger("size-gabac-" + core::getDescriptor(std::get<1>(ret).getID()).name + "-raw",
-                                        size);
-            std::get<2>(ret).addInteger("size-gabac-total-comp", std::get<1>(ret).begin()->getRawSize());
-            std::get<2>(ret).addInteger("size-gabac-" + core::getDescriptor(std::get<1>(ret).getID()).name + "-comp",
-                                        std::get<1>(ret).begin()->getRawSize());
+            std::get<2>(ret).addInteger(ids.total.raw, size);
+            std::get<2>(ret).addInteger(ids.get(std::get<1>(ret).getID()).raw, size);
+            std::get<2>(ret).addInteger(ids.total.comp, std::get<1>(ret).begin()->getRawSize());
+            std::get<2>(ret).addInteger(ids.get(std::get<1>(ret).getID()).comp, std::get<1>(ret).begin()->getRawSize());
         }
     }
-    std::get<2>(ret).addDouble("time-gabac", watch.check());
+    std::get<2>(ret).addDouble(ids.time, watch.check());
     return ret;
 }
 
@@ -169,6 +211,18 @@ Encoder::Encoder(bool _writeOutStreams) : writeOutStreams(_writeOutStreams) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void Encoder::skip(const util::Section &records) {
+    if (adaptive) {
+        adaptive->skip(records);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Encoder::setAdaptiveConfig(std::unique_ptr<AdaptiveConfigSelector> selector) { adaptive = std::move(selector); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace gabac
 }  // namespace entropy
 }  // namespace genie
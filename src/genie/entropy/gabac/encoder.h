@@ -11,6 +11,7 @@
 
 #include "genie/core/access-unit.h"
 #include "genie/core/entropy-encoder.h"
+#include "genie/entropy/gabac/adaptive-config.h"
 #include "genie/entropy/gabac/gabac-seq-conf-set.h"
 #include "genie/entropy/gabac/gabac.h"
 #include "genie/util/make-unique.h"
@@ -27,6 +28,8 @@ namespace gabac {
  */
 class Encoder : public core::EntropyEncoder {
  private:
+    std::unique_ptr<AdaptiveConfigSelector> adaptive;  //!< @brief Online configuration selection, nullptr if off
+
     /**
      * @brief Run the actual gabac compression
      * @param conf GABAC configuration to use
@@ -52,15 +55,29 @@ class Encoder : public core::EntropyEncoder {
     /**
      * @brief
      * @param desc
+     * @param records
      * @return
      */
-    EntropyCoded process(core::AccessUnit::Descriptor& desc) override;
+    EntropyCoded process(core::AccessUnit::Descriptor& desc, const util::Section& records) override;
+
+    /**
+     * @brief Pass the section to the adaptive selection
+     * @param records
+     */
+    void skip(const util::Section& records) override;
 
     /**
      * @brief
      * @param _writeOutStreams
      */
     explicit Encoder(bool _writeOutStreams);
+
+    /**
+     * @brief Select the configuration of each subsequence online instead of using the static config set. The chosen
+     * configurations are stored in the parameter set of every access unit.
+     * @param selector Selector to use, nullptr to go back to the static config set
+     */
+    void setAdaptiveConfig(std::unique_ptr<AdaptiveConfigSelector> selector);
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -77,15 +77,23 @@ void GabacSeqConfSet::storeParameters(core::parameter::ParameterSet &parameterSe
 // ---------------------------------------------------------------------------------------------------------------------
 
 void GabacSeqConfSet::storeParameters(core::GenDesc desc, core::parameter::DescriptorSubseqCfg &parameterSet) const {
+    storeParameters(desc, {}, parameterSet);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void GabacSeqConfSet::storeParameters(core::GenDesc desc,
+                                      const std::vector<const gabac::EncodingConfiguration *> &overrides,
+                                      core::parameter::DescriptorSubseqCfg &parameterSet) const {
     auto descriptor_configuration = util::make_unique<core::parameter::desc_pres::DescriptorPresent>();
 
     if (desc == core::GenDesc::RNAME || desc == core::GenDesc::MSAR) {
         auto decoder_config = util::make_unique<paramcabac::DecoderTokenType>();
-        fillDecoder(core::getDescriptor(desc), *decoder_config);
+        fillDecoder(core::getDescriptor(desc), *decoder_config, overrides);
         descriptor_configuration->setDecoder(std::move(decoder_config));
     } else {
         auto decoder_config = util::make_unique<paramcabac::DecoderRegular>(desc);
-        fillDecoder(core::getDescriptor(desc), *decoder_config);
+        fillDecoder(core::getDescriptor(desc), *decoder_config, overrides);
         descriptor_configuration->setDecoder(std::move(decoder_config));
     }
 
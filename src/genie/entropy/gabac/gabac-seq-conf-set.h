@@ -99,6 +99,15 @@ class GabacSeqConfSet {
      */
     void storeParameters(core::GenDesc desc, core::parameter::DescriptorSubseqCfg &parameterSet) const;
 
+    /**
+     * @brief Store the configurations of one descriptor, replacing some of them
+     * @param desc Descriptor
+     * @param overrides Configuration per subsequence, missing and nullptr entries are taken from this set
+     * @param parameterSet Output object
+     */
+    void storeParameters(core::GenDesc desc, const std::vector<const gabac::EncodingConfiguration *> &overrides,
+                         core::parameter::DescriptorSubseqCfg &parameterSet) const;
+
     /**
      * @brief Load a complete set of gabac configurations to the internal memory of gabac configurations
      * @param parameterSet Input object
@@ -110,11 +119,15 @@ class GabacSeqConfSet {
      * @tparam T
      * @param desc
      * @param decoder_config
+     * @param overrides Configuration per subsequence, missing and nullptr entries are taken from this set
      */
     template <typename T>
-    void fillDecoder(const core::GenomicDescriptorProperties &desc, T &decoder_config) const {
+    void fillDecoder(const core::GenomicDescriptorProperties &desc, T &decoder_config,
+                     const std::vector<const gabac::EncodingConfiguration *> &overrides = {}) const {
         for (const auto &subdesc : desc.subseqs) {
-            auto subseqCfg = getConfAsGabac(subdesc.id).getSubseqConfig();
+            const auto index = uint8_t(subdesc.id.second);
+            const auto *replacement = index < overrides.size() ? overrides[index] : nullptr;
+            auto subseqCfg = (replacement ? *replacement : getConfAsGabac(subdesc.id)).getSubseqConfig();
             decoder_config.setSubsequenceCfg(uint8_t(subdesc.id.second), std::move(subseqCfg));
         }
     }
@@ -6,6 +6,7 @@
 
 #include "genie/entropy/gabac/reader.h"
 #include "genie/entropy/gabac/context-tables.h"
+#include "genie/util/runtime-exception.h"
 
 //
 // #include binary-arithmetic-decoder.cc from here instead of compiling it
@@ -38,17 +39,13 @@ Reader::~Reader() = default;
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-uint64_t Reader::readAsBIbypass(const std::vector<unsigned int> binParams) {
-    return m_decBinCabac.decodeBinsEP(binParams[0]);
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-uint64_t Reader::readAsBIcabac(const std::vector<unsigned int> binParams) {
+template <bool bypass>
+inline uint64_t Reader::readBI(const unsigned int cLength, const unsigned int ctxIdx) {
+    if (bypass) {
+        return m_decBinCabac.decodeBinsEP(cLength);
+    }
     unsigned int bins = 0;
-    unsigned int cm = binParams[3];
-    const unsigned int cLength = binParams[0];
-    auto scan = m_contextModels.begin() + cm;
+    auto scan = m_contextModels.begin() + ctxIdx;
     for (size_t i = cLength; i > 0; i--) {
         bins = (bins << 1u) | m_decBinCabac.decodeBin(&*(scan++));
     }
@@ -57,23 +54,17 @@ uint64_t Reader::readAsBIcabac(const std::vector<unsigned int> binParams) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-uint64_t Reader::readAsTUbypass(const std::vector<unsigned int> binParams) {
+template <bool bypass>
+inline uint64_t Reader::readTU(const unsigned int cMax, const unsigned int ctxIdx) {
     unsigned int i = 0;
-    const unsigned int cMax = binParams[0];
-    while (i < cMax) {
-        if (m_decBinCabac.decodeBinsEP(1) == 0) break;
-        i++;
+    if (bypass) {
+        while (i < cMax) {
+            if (m_decBinCabac.decodeBinsEP(1) == 0) break;
+            i++;
+        }
+        return static_cast<uint64_t>(i);
     }
-    return static_cast<uint64_t>(i);
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-uint64_t Reader::readAsTUcabac(const std::vector<unsigned int> binParams) {
-    unsigned int i = 0;
-    unsigned int cm = binParams[3];
-    const unsigned int cMax = binParams[0];
-    auto scan = m_contextModels.begin() + cm;
+    auto scan = m_contextModels.begin() + ctxIdx;
     while (i < cMax) {
         if (m_decBinCabac.decodeBin(&*scan) == 0) break;
         i++;
@@ -84,73 +75,52 @@ uint64_t Reader::readAsTUcabac(const std::vector<unsigned int> binParams) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-uint64_t Reader::readAsEGbypass(const std::vector<unsigned int>) {
-    unsigned int bins = 0;
+template <bool bypass>
+inline uint64_t Reader::readEG(const unsigned int ctxIdx) {
     unsigned int i = 0;
-    while (readAsBIbypass(std::vector<unsigned int>({1})) == 0) {
-        i++;
-    }
-    if (i != 0) {
-        bins = (1u << i) | m_decBinCabac.decodeBinsEP(i);
+    if (bypass) {
+        while (m_decBinCabac.decodeBinsEP(1) == 0) {
+            i++;
+        }
     } else {
-        return 0;
+        auto scan = m_contextModels.begin() + ctxIdx;
+        while (m_decBinCabac.decodeBin(&*scan) == 0) {
+            scan++;
+            i++;
+        }
     }
-    return static_cast<uint64_t>(bins - 1);
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-uint64_t Reader::readAsEGcabac(const std::vector<unsigned int> binParams) {
-    unsigned int cm = binParams[3];
-    auto scan = m_contextModels.begin() + cm;
-    unsigned int i = 0;
-    while (m_decBinCabac.decodeBin(&*scan) == 0) {
-        scan++;
-        i++;
-    }
-    unsigned int bins = 0;
-    if (i != 0) {
-        bins = (1u << i) | m_decBinCabac.decodeBinsEP(i);
-    } else {
+    if (i == 0) {
         return 0;
     }
+    unsigned int bins = (1u << i) | m_decBinCabac.decodeBinsEP(i);
     return static_cast<uint64_t>(bins - 1);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-uint64_t Reader::readAsTEGbypass(const std::vector<unsigned int> binParams) {
-    uint64_t value = readAsTUbypass(binParams);
-    if (static_cast<unsigned int>(value) == binParams[0]) {
-        value += readAsEGbypass(std::vector<unsigned int>({0}));
-    }
-    return value;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-uint64_t Reader::readAsTEGcabac(const std::vector<unsigned int> binParams) {
-    uint64_t value = readAsTUcabac(binParams);
-    if (static_cast<unsigned int>(value) == binParams[0]) {
-        value += readAsEGcabac(std::vector<unsigned int>({0, 0, 0, binParams[3] + binParams[0]}));
+template <bool bypass>
+inline uint64_t Reader::readTEG(const unsigned int cMaxTeg, const unsigned int ctxIdx) {
+    uint64_t value = readTU<bypass>(cMaxTeg, ctxIdx);
+    if (static_cast<unsigned int>(value) == cMaxTeg) {
+        value += readEG<bypass>(ctxIdx + cMaxTeg);
     }
     return value;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-uint64_t Reader::readAsSUTUbypass(const std::vector<unsigned int> binParams) {
-    const uint32_t outputSymSize = binParams[0];
-    const uint32_t splitUnitSize = binParams[1];
-
+template <bool bypass>
+inline uint64_t Reader::readSUTU(const unsigned int outputSymSize, const unsigned int splitUnitSize,
+                                 const unsigned int ctxIdx) {
+    unsigned int cm = ctxIdx;
     uint32_t i;
     uint64_t value = 0;
 
     for (i = 0; i < outputSymSize; i += splitUnitSize) {
-        uint64_t val = 0;
         uint32_t cMax = (i == 0 && outputSymSize % splitUnitSize) ? (1u << (outputSymSize % splitUnitSize)) - 1
                                                                   : (1u << splitUnitSize) - 1;
-        val = readAsTUbypass(std::vector<unsigned int>({cMax}));
+        uint64_t val = readTU<bypass>(cMax, cm);
+        cm += cMax;
 
         value = (value << splitUnitSize) | val;
     }
@@ -160,22 +130,13 @@ uint64_t Reader::readAsSUTUbypass(const std::vector<unsigned int> binParams) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-uint64_t Reader::readAsSUTUcabac(const std::vector<unsigned int> binParams) {
-    const uint32_t outputSymSize = binParams[0];
-    const uint32_t splitUnitSize = binParams[1];
+template <bool bypass>
+inline uint64_t Reader::readDTU(const unsigned int outputSymSize, const unsigned int splitUnitSize,
+                                const unsigned int cMaxDtu, const unsigned int ctxIdx) {
+    uint64_t value = readTU<bypass>(cMaxDtu, ctxIdx);
 
-    uint32_t cm = binParams[3];
-    uint32_t i;
-    uint64_t value = 0;
-
-    for (i = 0; i < outputSymSize; i += splitUnitSize) {
-        uint64_t val = 0;
-        uint32_t cMax = (i == 0 && outputSymSize % splitUnitSize) ? (1u << (outputSymSize % splitUnitSize)) - 1
-                                                                  : (1u << splitUnitSize) - 1;
-        val = readAsTUcabac(std::vector<unsigned int>({cMax, 0, 0, cm}));
-        cm += cMax;
-
-        value = (value << splitUnitSize) | val;
+    if (value >= cMaxDtu) {
+        value += readSUTU<bypass>(outputSymSize, splitUnitSize, ctxIdx + cMaxDtu);
     }
 
     return value;
@@ -183,48 +144,57 @@ uint64_t Reader::readAsSUTUcabac(const std::vector<unsigned int> binParams) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-uint64_t Reader::readAsDTUbypass(const std::vector<unsigned int> binParams) {
-    const uint32_t cMaxDTU = binParams[2];
-
-    uint64_t value = readAsTUbypass(std::vector<unsigned int>({cMaxDTU}));
-
-    if (value >= cMaxDTU) {
-        value += readAsSUTUbypass(binParams);
+template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+uint64_t Reader::readAs(const BinParams &binParams) {
+    // binID is a constant, only one branch is left after inlining
+    switch (binID) {
+        case paramcabac::BinarizationParameters::BinarizationId::BI:
+            return readBI<bypass>(binParams.cMax, binParams.ctxIdx);
+        case paramcabac::BinarizationParameters::BinarizationId::TU:
+            return readTU<bypass>(binParams.cMax, binParams.ctxIdx);
+        case paramcabac::BinarizationParameters::BinarizationId::EG:
+            return readEG<bypass>(binParams.ctxIdx);
+        case paramcabac::BinarizationParameters::BinarizationId::TEG:
+            return readTEG<bypass>(binParams.cMax, binParams.ctxIdx);
+        case paramcabac::BinarizationParameters::BinarizationId::SUTU:
+            return readSUTU<bypass>(binParams.cMax, binParams.splitUnitSize, binParams.ctxIdx);
+        case paramcabac::BinarizationParameters::BinarizationId::DTU:
+            return readDTU<bypass>(binParams.cMax, binParams.splitUnitSize, binParams.cMaxDtu, binParams.ctxIdx);
+        default:
+            UTILS_DIE("Unknown Binarization");
     }
-
-    return value;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-uint64_t Reader::readAsDTUcabac(const std::vector<unsigned int> binParams) {
-    const uint32_t cMaxDTU = binParams[2];
-
-    uint64_t value = readAsTUcabac(std::vector<unsigned int>({cMaxDTU, 0, 0, binParams[3]}));
-
-    if (value >= cMaxDTU) {
-        value += readAsSUTUcabac(std::vector<unsigned int>({binParams[0], binParams[1], 0, binParams[3] + cMaxDTU}));
-    }
+using BinId = paramcabac::BinarizationParameters::BinarizationId;
 
-    return value;
-}
+template uint64_t Reader::readAs<BinId::BI, true>(const BinParams &);
+template uint64_t Reader::readAs<BinId::BI, false>(const BinParams &);
+template uint64_t Reader::readAs<BinId::TU, true>(const BinParams &);
+template uint64_t Reader::readAs<BinId::TU, false>(const BinParams &);
+template uint64_t Reader::readAs<BinId::EG, true>(const BinParams &);
+template uint64_t Reader::readAs<BinId::EG, false>(const BinParams &);
+template uint64_t Reader::readAs<BinId::TEG, true>(const BinParams &);
+template uint64_t Reader::readAs<BinId::TEG, false>(const BinParams &);
+template uint64_t Reader::readAs<BinId::SUTU, true>(const BinParams &);
+template uint64_t Reader::readAs<BinId::SUTU, false>(const BinParams &);
+template uint64_t Reader::readAs<BinId::DTU, true>(const BinParams &);
+template uint64_t Reader::readAs<BinId::DTU, false>(const BinParams &);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 uint64_t Reader::readLutSymbol(const uint8_t codingSubsymSize) {
-    std::vector<unsigned int> binParams({codingSubsymSize, 2, 0, 0});  // ctxIdx = 0
-    return readAsSUTUcabac(binParams);
+    return readSUTU<false>(codingSubsymSize, 2, 0);  // ctxIdx = 0
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 bool Reader::readSignFlag() {
-    std::vector<unsigned int> binParams({1});
     if (m_bypassFlag)
-        return static_cast<bool>(readAsBIbypass(std::vector<unsigned int>({1})));
+        return static_cast<bool>(readBI<true>(1, 0));
     else
-        return static_cast<bool>(
-            readAsBIcabac(std::vector<unsigned int>({1, 0, 0, static_cast<unsigned int>(m_numContexts - 1)})));
+        return static_cast<bool>(readBI<false>(1, static_cast<unsigned int>(m_numContexts - 1)));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
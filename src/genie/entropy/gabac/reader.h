@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <vector>
+#include "genie/entropy/gabac/bin-params.h"
 #include "genie/entropy/gabac/binary-arithmetic-decoder.h"
 #include "genie/entropy/gabac/bit-input-stream.h"
 
@@ -48,140 +49,109 @@ class Reader {
     ~Reader();
 
     /**
-     * @brief
-     * @param binParams
-     * @return
-     */
-    uint64_t readAsBIbypass(const std::vector<unsigned int> binParams);
-
-    /**
-     * @brief
-     * @param binParams
-     * @return
+     * @brief Decode the bins of a symbol and debinarize it. Instantiated for the unsigned binarizations in both modes,
+     * so that the binarization is inlined and its parameters stay in registers.
+     * @tparam binID Binarization, one of BI, TU, EG, TEG, SUTU and DTU
+     * @tparam bypass If the bins are bypass coded
+     * @param binParams Binarization parameters and first context model
+     * @return Symbol
      */
-    uint64_t readAsBIcabac(const std::vector<unsigned int> binParams);
+    template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+    uint64_t readAs(const BinParams &binParams);
 
     /**
      * @brief
-     * @param binParams
-     * @return
-     */
-    uint64_t readAsTUbypass(const std::vector<unsigned int> binParams);
-
-    /**
-     * @brief
-     * @param binParams
-     * @return
-     */
-    uint64_t readAsTUcabac(const std::vector<unsigned int> binParams);
-
-    /**
-     * @brief
-     * @param binParams
-     * @return
-     */
-    uint64_t readAsEGbypass(const std::vector<unsigned int> binParams);
-
-    /**
-     * @brief
-     * @param binParams
+     * @param codingSubsymSize
      * @return
      */
-    uint64_t readAsEGcabac(const std::vector<unsigned int> binParams);
+    uint64_t readLutSymbol(const uint8_t codingSubsymSize);
 
     /**
      * @brief
-     * @param binParams
      * @return
      */
-    uint64_t readAsSEGbypass(const std::vector<unsigned int> binParams);
+    bool readSignFlag();
 
     /**
      * @brief
-     * @param binParams
-     * @return
      */
-    uint64_t readAsSEGcabac(const std::vector<unsigned int> binParams);
+    void start();
 
     /**
      * @brief
-     * @param binParams
      * @return
      */
-    uint64_t readAsTEGbypass(const std::vector<unsigned int> binParams);
+    size_t close();
 
     /**
      * @brief
-     * @param binParams
-     * @return
      */
-    uint64_t readAsTEGcabac(const std::vector<unsigned int> binParams);
+    void reset();
 
-    /**
-     * @brief
-     * @param binParams
-     * @return
-     */
-    uint64_t readAsSUTUbypass(const std::vector<unsigned int> binParams);
+ private:
+    BitInputStream m_bitInputStream;        //!< @brief
+    BinaryArithmeticDecoder m_decBinCabac;  //!< @brief
 
-    /**
-     * @brief
-     * @param binParams
-     * @return
-     */
-    uint64_t readAsSUTUcabac(const std::vector<unsigned int> binParams);
+    bool m_bypassFlag;       //!< @brief
+    uint64_t m_numContexts;  //!< @brief
 
-    /**
-     * @brief
-     * @param binParams
-     * @return
-     */
-    uint64_t readAsDTUbypass(const std::vector<unsigned int> binParams);
+    std::vector<ContextModel> m_contextModels;  //!< @brief
 
     /**
-     * @brief
-     * @param binParams
-     * @return
+     * @brief Binary binarization
+     * @param cLength Number of bins
+     * @param ctxIdx First context model
+     * @return Symbol
      */
-    uint64_t readAsDTUcabac(const std::vector<unsigned int> binParams);
+    template <bool bypass>
+    uint64_t readBI(unsigned int cLength, unsigned int ctxIdx);
 
     /**
-     * @brief
-     * @param codingSubsymSize
-     * @return
+     * @brief Truncated unary binarization
+     * @param cMax Largest symbol
+     * @param ctxIdx First context model
+     * @return Symbol
      */
-    uint64_t readLutSymbol(const uint8_t codingSubsymSize);
+    template <bool bypass>
+    uint64_t readTU(unsigned int cMax, unsigned int ctxIdx);
 
     /**
-     * @brief
-     * @return
+     * @brief Exponential Golomb binarization, the suffix is always bypass coded
+     * @param ctxIdx First context model
+     * @return Symbol
      */
-    bool readSignFlag();
+    template <bool bypass>
+    uint64_t readEG(unsigned int ctxIdx);
 
     /**
-     * @brief
+     * @brief Truncated exponential Golomb binarization
+     * @param cMaxTeg Largest symbol of the truncated unary prefix
+     * @param ctxIdx First context model
+     * @return Symbol
      */
-    void start();
+    template <bool bypass>
+    uint64_t readTEG(unsigned int cMaxTeg, unsigned int ctxIdx);
 
     /**
-     * @brief
-     * @return
+     * @brief Split unit truncated unary binarization
+     * @param outputSymSize Bits per symbol
+     * @param splitUnitSize Bits per split unit
+     * @param ctxIdx First context model
+     * @return Symbol
      */
-    size_t close();
+    template <bool bypass>
+    uint64_t readSUTU(unsigned int outputSymSize, unsigned int splitUnitSize, unsigned int ctxIdx);
 
     /**
-     * @brief
+     * @brief Double truncated unary binarization
+     * @param outputSymSize Bits per symbol
+     * @param splitUnitSize Bits per split unit
+     * @param cMaxDtu Largest symbol of the truncated unary prefix
+     * @param ctxIdx First context model
+     * @return Symbol
      */
-    void reset();
-
- private:
-    BitInputStream m_bitInputStream;        //!< @brief
-    BinaryArithmeticDecoder m_decBinCabac;  //!< @brief
-
-    bool m_bypassFlag;       //!< @brief
-    uint64_t m_numContexts;  //!< @brief
-
-    std::vector<ContextModel> m_contextModels;  //!< @brief
+    template <bool bypass>
+    uint64_t readDTU(unsigned int outputSymSize, unsigned int splitUnitSize, unsigned int cMaxDtu, unsigned int ctxIdx);
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,47 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/entropy/gabac/stat-ids.h"
+#include <string>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace entropy {
+namespace gabac {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+StatIDs::StatIDs() {
+    using core::stats::PerfStats;
+    total = {PerfStats::intern("size-gabac-total-raw"), PerfStats::intern("size-gabac-total-comp")};
+    time = PerfStats::intern("time-gabac");
+    for (const auto& d : core::getDescriptors()) {
+        const std::string prefix = "size-gabac-" + d.name + "-";
+        descriptors.push_back({PerfStats::intern(prefix + "raw"), PerfStats::intern(prefix + "comp")});
+        subsequences.emplace_back();
+        for (const auto& s : d.subseqs) {
+            subsequences.back().push_back(
+                {PerfStats::intern(prefix + s.name + "-raw"), PerfStats::intern(prefix + s.name + "-comp")});
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const StatIDs& StatIDs::get() {
+    static const StatIDs ids;
+    return ids;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace gabac
+}  // namespace entropy
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_ENTROPY_GABAC_STAT_IDS_H_
+#define SRC_GENIE_ENTROPY_GABAC_STAT_IDS_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <vector>
+#include "genie/core/constants.h"
+#include "genie/core/stats/perf-stats.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace entropy {
+namespace gabac {
+
+/**
+ * @brief Interned statistics IDs of all gabac metrics, so that no metric names have to be built per access unit
+ */
+struct StatIDs {
+    using ID = core::stats::PerfStats::StatID;  //!< @brief
+
+    /**
+     * @brief Raw and compressed size of one stream
+     */
+    struct Sizes {
+        ID raw;   //!< @brief
+        ID comp;  //!< @brief
+    };
+
+    Sizes total{};                                 //!< @brief Sum over all streams
+    ID time{};                                     //!< @brief Time spent in gabac
+    std::vector<Sizes> descriptors;                //!< @brief Per descriptor, used for token types
+    std::vector<std::vector<Sizes>> subsequences;  //!< @brief Per descriptor subsequence
+
+    /**
+     * @brief
+     * @return The IDs, registered on first use
+     */
+    static const StatIDs& get();
+
+    /**
+     * @brief
+     * @param id Descriptor subsequence
+     * @return IDs of the descriptor subsequence
+     */
+    const Sizes& get(core::GenSubIndex id) const { return subsequences[uint8_t(id.first)][id.second]; }
+
+    /**
+     * @brief
+     * @param id Descriptor
+     * @return IDs of the whole descriptor
+     */
+    const Sizes& get(core::GenDesc id) const { return descriptors[uint8_t(id)]; }
+
+ private:
+    /**
+     * @brief Register all metric names
+     */
+    StatIDs();
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace gabac
+}  // namespace entropy
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_ENTROPY_GABAC_STAT_IDS_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
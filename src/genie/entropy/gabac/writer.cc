@@ -6,9 +6,9 @@
 
 #include "genie/entropy/gabac/writer.h"
 #include <cassert>
-#include <cmath>
 #include <limits>
 #include "genie/entropy/gabac/context-tables.h"
+#include "genie/util/runtime-exception.h"
 //
 // #include binary-arithmetic-decoder.cc from here instead of compiling it
 // separately, so that we may call inlined member functions of class
@@ -56,16 +56,13 @@ void Writer::reset() {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Writer::writeAsBIbypass(uint64_t input, const std::vector<unsigned int> binParams) {
-    m_binaryArithmeticEncoder.encodeBinsEP(static_cast<unsigned int>(input), binParams[0]);
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-void Writer::writeAsBIcabac(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int cLength = binParams[0];
-    unsigned int cm = binParams[3];
-    auto scan = m_contextModels.begin() + cm;
+template <bool bypass>
+inline void Writer::writeBI(uint64_t input, const unsigned int cLength, const unsigned int ctxIdx) {
+    if (bypass) {
+        m_binaryArithmeticEncoder.encodeBinsEP(static_cast<unsigned int>(input), cLength);
+        return;
+    }
+    auto scan = m_contextModels.begin() + ctxIdx;
     for (int i = cLength - 1; i >= 0; i--) {  // i must be signed
         unsigned int bin = static_cast<unsigned int>(static_cast<uint64_t>(input) >> static_cast<uint8_t>(i)) & 0x1u;
         m_binaryArithmeticEncoder.encodeBin(bin, &*(scan++));
@@ -74,22 +71,18 @@ void Writer::writeAsBIcabac(uint64_t input, const std::vector<unsigned int> binP
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Writer::writeAsTUbypass(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int cMax = binParams[0];
-    for (uint64_t i = 0; i < input; i++) {
-        m_binaryArithmeticEncoder.encodeBinEP(1);
+template <bool bypass>
+inline void Writer::writeTU(uint64_t input, const unsigned int cMax, const unsigned int ctxIdx) {
+    if (bypass) {
+        for (uint64_t i = 0; i < input; i++) {
+            m_binaryArithmeticEncoder.encodeBinEP(1);
+        }
+        if (cMax > input) {
+            m_binaryArithmeticEncoder.encodeBinEP(0);
+        }
+        return;
     }
-    if (cMax > input) {
-        m_binaryArithmeticEncoder.encodeBinEP(0);
-    }
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-void Writer::writeAsTUcabac(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int cMax = binParams[0];
-    unsigned int cm = binParams[3];
-    auto scan = m_contextModels.begin() + cm;
+    auto scan = m_contextModels.begin() + ctxIdx;
     for (uint64_t i = 0; i < input; i++) {
         m_binaryArithmeticEncoder.encodeBin(1, &*(scan++));
     }
@@ -100,133 +93,124 @@ void Writer::writeAsTUcabac(uint64_t input, const std::vector<unsigned int> binP
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Writer::writeAsEGbypass(uint64_t input, const std::vector<unsigned int>) {
+template <bool bypass>
+inline void Writer::writeEG(uint64_t input, const unsigned int ctxIdx) {
     auto valuePlus1 = (unsigned int)(input + 1);
-    auto numLeadZeros = (unsigned int)floor(log2(valuePlus1));
-
-    /* prefix */
-    writeAsBIbypass(1, std::vector<unsigned int>({numLeadZeros + 1}));
-    if (numLeadZeros) {
-        /* suffix */
-        writeAsBIbypass(valuePlus1 & ((1u << numLeadZeros) - 1), std::vector<unsigned int>({numLeadZeros}));
+    unsigned int numLeadZeros = 0;  // floor(log2(valuePlus1))
+    while (valuePlus1 >> (numLeadZeros + 1)) {
+        numLeadZeros++;
     }
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-void Writer::writeAsEGcabac(uint64_t input, const std::vector<unsigned int> binParams) {
-    auto valuePlus1 = (unsigned int)(input + 1);
-    auto numLeadZeros = (unsigned int)floor(log2(valuePlus1));
 
     /* prefix */
-    writeAsBIcabac(1, std::vector<unsigned int>({numLeadZeros + 1, 0, 0, binParams[3]}));
+    writeBI<bypass>(1, numLeadZeros + 1, ctxIdx);
     if (numLeadZeros) {
         /* suffix */
-        writeAsBIbypass(valuePlus1 & ((1u << numLeadZeros) - 1), std::vector<unsigned int>({numLeadZeros}));
+        writeBI<true>(valuePlus1 & ((1u << numLeadZeros) - 1), numLeadZeros, 0);
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Writer::writeAsTEGbypass(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int cTruncExpGolParam = binParams[0];
-    if (input < cTruncExpGolParam) {
-        writeAsTUbypass(input, binParams);
+template <bool bypass>
+inline void Writer::writeTEG(uint64_t input, const unsigned int cMaxTeg, const unsigned int ctxIdx) {
+    if (input < cMaxTeg) {
+        writeTU<bypass>(input, cMaxTeg, ctxIdx);
     } else {
-        writeAsTUbypass(cTruncExpGolParam, binParams);
-        writeAsEGbypass(input - cTruncExpGolParam, std::vector<unsigned int>({0}));
-    }
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-void Writer::writeAsTEGcabac(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int cTruncExpGolParam = binParams[0];
-
-    writeAsTUcabac(input, std::vector<unsigned int>({cTruncExpGolParam, 0, 0, binParams[3]}));
-    if (input >= cTruncExpGolParam) {
-        writeAsEGcabac(input - cTruncExpGolParam,
-                       std::vector<unsigned int>({0, 0, 0, binParams[3] + cTruncExpGolParam}));
-    }
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-void Writer::writeAsSUTUbypass(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int outputSymSize = binParams[0];
-    const unsigned int splitUnitSize = binParams[1];
-
-    unsigned int i, j;
-    for (i = 0, j = outputSymSize; i < outputSymSize; i += splitUnitSize) {
-        unsigned int unitSize =
-            (i == 0 && outputSymSize % splitUnitSize) ? outputSymSize % splitUnitSize : splitUnitSize;
-        unsigned int cMax = (1u << unitSize) - 1;
-        unsigned int val = (input >> (j -= unitSize)) & cMax;
-        writeAsTUbypass(val, std::vector<unsigned int>({cMax}));
+        writeTU<bypass>(cMaxTeg, cMaxTeg, ctxIdx);
+        writeEG<bypass>(input - cMaxTeg, ctxIdx + cMaxTeg);
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Writer::writeAsSUTUcabac(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int outputSymSize = binParams[0];
-    const unsigned int splitUnitSize = binParams[1];
-
-    unsigned int cm = binParams[3];
+template <bool bypass>
+inline void Writer::writeSUTU(uint64_t input, const unsigned int outputSymSize, const unsigned int splitUnitSize,
+                              const unsigned int ctxIdx) {
+    unsigned int cm = ctxIdx;
     unsigned int i, j;
     for (i = 0, j = outputSymSize; i < outputSymSize; i += splitUnitSize) {
         unsigned int unitSize =
             (i == 0 && outputSymSize % splitUnitSize) ? outputSymSize % splitUnitSize : splitUnitSize;
         unsigned int cMax = (1u << unitSize) - 1;
         unsigned int val = (input >> (j -= unitSize)) & cMax;
-        writeAsTUcabac(val, std::vector<unsigned int>({cMax, 0, 0, cm}));
+        writeTU<bypass>(val, cMax, cm);
         cm += cMax;
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Writer::writeAsDTUbypass(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int cMaxDtu = binParams[2];
-
-    writeAsTUbypass((input < cMaxDtu) ? input : cMaxDtu, std::vector<unsigned int>({cMaxDtu}));
+template <bool bypass>
+inline void Writer::writeDTU(uint64_t input, const unsigned int outputSymSize, const unsigned int splitUnitSize,
+                             const unsigned int cMaxDtu, const unsigned int ctxIdx) {
+    writeTU<bypass>((input < cMaxDtu) ? input : cMaxDtu, cMaxDtu, ctxIdx);
 
     if (input >= cMaxDtu) {
         input -= cMaxDtu;
 
-        writeAsSUTUbypass(input, binParams);
+        writeSUTU<bypass>(input, outputSymSize, splitUnitSize, ctxIdx + cMaxDtu);
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Writer::writeAsDTUcabac(uint64_t input, const std::vector<unsigned int> binParams) {
-    const unsigned int cMaxDtu = binParams[2];
+template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+void Writer::writeAs(uint64_t input, const BinParams &binParams) {
+    // binID is a constant, only one branch is left after inlining
+    switch (binID) {
+        case paramcabac::BinarizationParameters::BinarizationId::BI:
+            writeBI<bypass>(input, binParams.cMax, binParams.ctxIdx);
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::TU:
+            writeTU<bypass>(input, binParams.cMax, binParams.ctxIdx);
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::EG:
+            writeEG<bypass>(input, binParams.ctxIdx);
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::TEG:
+            writeTEG<bypass>(input, binParams.cMax, binParams.ctxIdx);
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::SUTU:
+            writeSUTU<bypass>(input, binParams.cMax, binParams.splitUnitSize, binParams.ctxIdx);
+            break;
+        case paramcabac::BinarizationParameters::BinarizationId::DTU:
+            writeDTU<bypass>(input, binParams.cMax, binParams.splitUnitSize, binParams.cMaxDtu, binParams.ctxIdx);
+            break;
+        default:
+            UTILS_DIE("Unknown Binarization");
+    }
+}
 
-    writeAsTUcabac((input < cMaxDtu) ? input : cMaxDtu, std::vector<unsigned int>({cMaxDtu, 0, 0, binParams[3]}));
+// ---------------------------------------------------------------------------------------------------------------------
 
-    if (input >= cMaxDtu) {
-        input -= cMaxDtu;
+using BinId = paramcabac::BinarizationParameters::BinarizationId;
 
-        writeAsSUTUcabac(input, std::vector<unsigned int>({binParams[0], binParams[1], 0, binParams[3] + cMaxDtu}));
-    }
-}
+template void Writer::writeAs<BinId::BI, true>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::BI, false>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::TU, true>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::TU, false>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::EG, true>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::EG, false>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::TEG, true>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::TEG, false>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::SUTU, true>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::SUTU, false>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::DTU, true>(uint64_t, const BinParams &);
+template void Writer::writeAs<BinId::DTU, false>(uint64_t, const BinParams &);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 void Writer::writeLutSymbol(uint64_t input, const uint8_t codingSubsymSize) {
-    std::vector<unsigned int> binParams({codingSubsymSize, 2, 0, 0});  // ctxIdx = 0
-    writeAsSUTUcabac(input, binParams);
+    writeSUTU<false>(input, codingSubsymSize, 2, 0);  // ctxIdx = 0
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 void Writer::writeSignFlag(int64_t input) {
-    std::vector<unsigned int> binParams({1});
     if (m_bypassFlag)
-        writeAsBIbypass(input < 0, std::vector<unsigned int>({1}));
+        writeBI<true>(input < 0, 1, 0);
     else
-        writeAsBIcabac(input < 0, std::vector<unsigned int>({1, 0, 0, static_cast<unsigned int>(m_numContexts - 1)}));
+        writeBI<false>(input < 0, 1, static_cast<unsigned int>(m_numContexts - 1));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <vector>
+#include "genie/entropy/gabac/bin-params.h"
 #include "genie/entropy/gabac/binary-arithmetic-encoder.h"
 #include "genie/entropy/gabac/streams.h"
 #include "genie/util/bitwriter.h"
@@ -64,111 +65,95 @@ class Writer {
     void reset();
 
     /**
-     * @brief
-     * @param input
-     * @param binParams
-     */
-    void writeAsBIbypass(uint64_t input, const std::vector<unsigned int> binParams);
-
-    /**
-     * @brief
-     * @param input
-     * @param binParams
+     * @brief Binarize a symbol and encode the bins. Instantiated for the unsigned binarizations in both modes, so
+     * that the binarization is inlined and its parameters stay in registers.
+     * @tparam binID Binarization, one of BI, TU, EG, TEG, SUTU and DTU
+     * @tparam bypass If the bins are bypass coded
+     * @param input Symbol
+     * @param binParams Binarization parameters and first context model
      */
-    void writeAsBIcabac(uint64_t input, const std::vector<unsigned int> binParams);
+    template <paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+    void writeAs(uint64_t input, const BinParams &binParams);
 
     /**
      * @brief
      * @param input
-     * @param binParams
+     * @param codingSubsymSize
      */
-    void writeAsTUbypass(uint64_t input, const std::vector<unsigned int> binParams);
+    void writeLutSymbol(uint64_t input, const uint8_t codingSubsymSize);
 
     /**
      * @brief
      * @param input
-     * @param binParams
      */
-    void writeAsTUcabac(uint64_t input, const std::vector<unsigned int> binParams);
+    void writeSignFlag(int64_t input);
 
-    /**
-     * @brief
-     * @param input
-     * @param binParams
-     */
-    void writeAsEGbypass(uint64_t input, const std::vector<unsigned int> binParams);
+ private:
+    util::BitWriter m_bitOutputStream;  //!< @brief
 
-    /**
-     * @brief
-     * @param input
-     * @param binParams
-     */
-    void writeAsEGcabac(uint64_t input, const std::vector<unsigned int> binParams);
+    BinaryArithmeticEncoder m_binaryArithmeticEncoder;  //!< @brief
 
-    /**
-     * @brief
-     * @param input
-     * @param binParams
-     */
-    void writeAsTEGbypass(uint64_t input, const std::vector<unsigned int> binParams);
+    bool m_bypassFlag;       //!< @brief
+    uint64_t m_numContexts;  //!< @brief
 
-    /**
-     * @brief
-     * @param input
-     * @param binParams
-     */
-    void writeAsTEGcabac(uint64_t input, const std::vector<unsigned int> binParams);
+    std::vector<ContextModel> m_contextModels;  //!< @brief
 
     /**
-     * @brief
-     * @param input
-     * @param binParams
+     * @brief Binary binarization
+     * @param input Symbol
+     * @param cLength Number of bins
+     * @param ctxIdx First context model
      */
-    void writeAsSUTUbypass(uint64_t input, const std::vector<unsigned int> binParams);
+    template <bool bypass>
+    void writeBI(uint64_t input, unsigned int cLength, unsigned int ctxIdx);
 
     /**
-     * @brief
-     * @param input
-     * @param binParams
+     * @brief Truncated unary binarization
+     * @param input Symbol
+     * @param cMax Largest symbol
+     * @param ctxIdx First context model
      */
-    void writeAsSUTUcabac(uint64_t input, const std::vector<unsigned int> binParams);
+    template <bool bypass>
+    void writeTU(uint64_t input, unsigned int cMax, unsigned int ctxIdx);
 
     /**
-     * @brief
-     * @param input
-     * @param binParams
+     * @brief Exponential Golomb binarization, the suffix is always bypass coded
+     * @param input Symbol
+     * @param ctxIdx First context model
      */
-    void writeAsDTUbypass(uint64_t input, const std::vector<unsigned int> binParams);
+    template <bool bypass>
+    void writeEG(uint64_t input, unsigned int ctxIdx);
 
     /**
-     * @brief
-     * @param input
-     * @param binParams
+     * @brief Truncated exponential Golomb binarization
+     * @param input Symbol
+     * @param cMaxTeg Largest symbol of the truncated unary prefix
+     * @param ctxIdx First context model
      */
-    void writeAsDTUcabac(uint64_t input, const std::vector<unsigned int> binParams);
+    template <bool bypass>
+    void writeTEG(uint64_t input, unsigned int cMaxTeg, unsigned int ctxIdx);
 
     /**
-     * @brief
-     * @param input
-     * @param codingSubsymSize
+     * @brief Split unit truncated unary binarization
+     * @param input Symbol
+     * @param outputSymSize Bits per symbol
+     * @param splitUnitSize Bits per split unit
+     * @param ctxIdx First context model
      */
-    void writeLutSymbol(uint64_t input, const uint8_t codingSubsymSize);
+    template <bool bypass>
+    void writeSUTU(uint64_t input, unsigned int outputSymSize, unsigned int splitUnitSize, unsigned int ctxIdx);
 
     /**
-     * @brief
-     * @param input
+     * @brief Double truncated unary binarization
+     * @param input Symbol
+     * @param outputSymSize Bits per symbol
+     * @param splitUnitSize Bits per split unit
+     * @param cMaxDtu Largest symbol of the truncated unary prefix
+     * @param ctxIdx First context model
      */
-    void writeSignFlag(int64_t input);
-
- private:
-    util::BitWriter m_bitOutputStream;  //!< @brief
-
-    BinaryArithmeticEncoder m_binaryArithmeticEncoder;  //!< @brief
-
-    bool m_bypassFlag;       //!< @brief
-    uint64_t m_numContexts;  //!< @brief
-
-    std::vector<ContextModel> m_contextModels;  //!< @brief
+    template <bool bypass>
+    void writeDTU(uint64_t input, unsigned int outputSymSize, unsigned int splitUnitSize, unsigned int cMaxDtu,
+                  unsigned int ctxIdx);
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -89,6 +89,14 @@ uint64_t FaiFile::getLength(const std::string& seq) const {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+const FaiFile::FaiSequence& FaiFile::getSequence(const std::string& seq) const {
+    auto it = seqs.find(seq);
+    UTILS_DIE_IF(it == seqs.end(), "Unknown ref sequence");
+    return it->second;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 std::ostream& operator<<(std::ostream& stream, const FaiFile::FaiSequence& file) {
     stream << file.name << "\n";
     stream << file.length << "\n";
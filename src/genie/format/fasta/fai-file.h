@@ -91,6 +91,13 @@ class FaiFile {
      */
     uint64_t getLength(const std::string& seq) const;
 
+    /**
+     * @brief
+     * @param seq
+     * @return Line geometry and file offset of a sequence
+     */
+    const FaiSequence& getSequence(const std::string& seq) const;
+
  private:
     std::map<std::string, FaiSequence> seqs;  //!< @brief
     std::map<size_t, std::string> indices;    //!< @brief
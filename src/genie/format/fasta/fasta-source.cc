@@ -7,7 +7,7 @@
 #include "genie/format/fasta/fasta-source.h"
 #include <algorithm>
 #include <iostream>
-#include "genie/util/ordered-section.h"
+#include <utility>
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -18,7 +18,10 @@ namespace fasta {
 // ---------------------------------------------------------------------------------------------------------------------
 
 FastaSource::FastaSource(std::ostream* _outfile, core::ReferenceManager* _refMgr)
-    : outfile(_outfile), refMgr(_refMgr), line_length(0) {
+    : outfile(_outfile),
+      refMgr(_refMgr),
+      line_length(0),
+      outbuffer([this](LoadedChunk&& chunk) { write(std::move(chunk)); }) {
     auto seqs = refMgr->getSequences();
     size_t pos = 0;
     for (const auto& s : seqs) {
@@ -59,8 +62,17 @@ bool FastaSource::pump(uint64_t& id, std::mutex& lock) {
     std::cerr << "Decompressing " << seq << " [" << pos * refMgr->getChunkSize() << ", "
               << pos * refMgr->getChunkSize() + actual_length << "]" << std::endl;
 
-    util::OrderedSection outSec(&outlock, loc_id);
-    if (pos == 0) {
+    outbuffer.deposit({seq, pos, std::move(string), actual_length}, loc_id);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FastaSource::write(LoadedChunk&& chunk) {
+    const auto& seq = chunk.seq;
+    const auto& string = chunk.string;
+    const size_t actual_length = chunk.length;
+    if (chunk.pos == 0) {
         if (line_length > 0) {
             outfile->write("\n", 1);
             line_length = 0;
@@ -80,14 +92,14 @@ bool FastaSource::pump(uint64_t& id, std::mutex& lock) {
             line_length = 0;
         }
         if (s_pos == actual_length) {
-            return true;
+            return;
         }
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void FastaSource::flushIn(uint64_t&) {}
+void FastaSource::flushIn(uint64_t&) { outbuffer.flush(); }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
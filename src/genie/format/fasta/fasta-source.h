@@ -10,9 +10,10 @@
 // ---------------------------------------------------------------------------------------------------------------------
 
 #include <map>
+#include <memory>
 #include <string>
 #include "genie/core/reference-manager.h"
-#include "genie/util/ordered-lock.h"
+#include "genie/util/reorder-buffer.h"
 #include "genie/util/original-source.h"
 #include "genie/util/source.h"
 
@@ -27,11 +28,27 @@ namespace fasta {
  */
 class FastaSource : public util::OriginalSource, public util::Source<std::string> {
  private:
+    /**
+     * @brief A loaded chunk of a reference sequence, waiting to be written
+     */
+    struct LoadedChunk {
+        std::string seq;                            //!< @brief Sequence name
+        size_t pos;                                 //!< @brief Chunk index inside the sequence
+        std::shared_ptr<const std::string> string;  //!< @brief Chunk data
+        size_t length;                              //!< @brief Number of valid bases in the chunk
+    };
+
     std::ostream* outfile;                       //!< @brief
-    util::OrderedLock outlock;                   //!< @brief
     core::ReferenceManager* refMgr;              //!< @brief
     std::map<std::string, size_t> accu_lengths;  //!< @brief
     size_t line_length;                          //!< @brief
+    util::ReorderBuffer<LoadedChunk> outbuffer;  //!< @brief Brings loaded chunks in order for writing
+
+    /**
+     * @brief Write one chunk in fasta format. Called in order by the reorder buffer.
+     * @param chunk Loaded chunk
+     */
+    void write(LoadedChunk&& chunk);
 
  public:
     /**
@@ -40,6 +40,10 @@ uint64_t Manager::getLength(const std::string& seq) const { return reader.getLen
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::string Manager::getRef(const std::string& sequence, uint64_t start, uint64_t end) {
+    // The mapped file has no shared seek position, so reads may run concurrently
+    if (reader.isMapped()) {
+        return reader.loadSection(sequence, start, end);
+    }
     std::lock_guard<std::mutex> guard(Manager::readerMutex);
     return reader.loadSection(sequence, start, end);
 }
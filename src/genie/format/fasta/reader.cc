@@ -6,7 +6,11 @@
 
 #include "genie/format/fasta/reader.h"
 #include <algorithm>
+#include <cstring>
+#include <iostream>
 #include <istream>
+#include <mutex>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -22,7 +26,11 @@ namespace fasta {
 // ---------------------------------------------------------------------------------------------------------------------
 
 FastaReader::FastaReader(std::istream& fastaFile, std::istream& faiFile, std::istream& sha256File, std::string _path)
-    : hashFile(sha256File), fai(faiFile), fasta(&fastaFile), path(std::move(_path)) {}
+    : hashFile(sha256File),
+      fai(faiFile),
+      fasta(&fastaFile),
+      path(std::move(_path)),
+      map(genie::util::make_unique<util::MappedFile>(path)) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -34,13 +42,49 @@ uint64_t FastaReader::getLength(const std::string& name) const { return fai.getL
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+bool FastaReader::isMapped() const { return map->isMapped(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string FastaReader::loadMappedSection(const FaiFile::FaiSequence& seq, uint64_t start, uint64_t end) const {
+    end = std::min(end, seq.length);
+    std::string ret;
+    if (start >= end) {
+        return ret;
+    }
+    UTILS_DIE_IF(seq.linebases == 0, "Invalid fasta line length");
+    ret.resize(end - start);
+    char* out = &ret[0];
+    while (start < end) {
+        uint64_t column = start % seq.linebases;
+        uint64_t count = std::min(seq.linebases - column, end - start);
+        uint64_t filePos = seq.offset + (start / seq.linebases) * seq.linewidth + column;
+        UTILS_DIE_IF(filePos + count > map->size(), "Fasta file shorter than indexed");
+        const char* in = map->data() + filePos;
+        for (uint64_t i = 0; i < count; ++i) {
+            out[i] = (in[i] >= 'a' && in[i] <= 'z') ? static_cast<char>(in[i] - ('a' - 'A')) : in[i];
+        }
+        out += count;
+        start += count;
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 std::string FastaReader::loadSection(const std::string& sequence, uint64_t start, uint64_t end) {
+    if (map->isMapped()) {
+        return loadMappedSection(fai.getSequence(sequence), start, end);
+    }
     auto startPos = fai.getFilePosition(sequence, start);
     std::string ret;
     ret.reserve(end - start);
     fasta->seekg(startPos);
     std::string buffer;
     while (getline(*fasta, buffer)) {
+        if (!buffer.empty() && buffer.back() == '\r') {
+            buffer.pop_back();
+        }
         start += buffer.size();
         if (start < end) {
             ret += buffer;
@@ -55,42 +99,73 @@ std::string FastaReader::loadSection(const std::string& sequence, uint64_t start
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Add an indexed sequence, records without bases are skipped
+ * @param seq Sequence
+ * @param fai Index
+ */
+static void addIndexedSequence(const FaiFile::FaiSequence& seq, FaiFile* fai) {
+    if (seq.length == 0) {
+        std::cerr << "Skipping empty fasta record " << seq.name << std::endl;
+        return;
+    }
+    fai->addSequence(seq);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void FastaReader::index(std::istream& fasta, std::ostream& fai) {
     std::string buffer;
     FaiFile faiFile;
     FaiFile::FaiSequence seq;
+    bool inRecord = false;
     bool lastline = false;
-    uint64_t nextoffset = 0;
+    bool blankline = false;
+    uint64_t filePos = 0;
     while (getline(fasta, buffer)) {
+        const uint64_t lineStart = filePos;
+        filePos += buffer.size() + 1;
+        const bool cr = !buffer.empty() && buffer.back() == '\r';
+        if (cr) {
+            buffer.pop_back();
+        }
+
+        // Blank lines are allowed between records only, the index cannot describe them inside a sequence
         if (buffer.empty()) {
+            blankline = seq.length > 0;
             continue;
         }
         if (buffer.front() == '>') {
-            lastline = false;
-            if (seq.offset != 0) {
-                uint64_t tmp = seq.offset;
-                seq.offset = nextoffset;
-                faiFile.addSequence(seq);
-                seq.offset = tmp;
+            if (inRecord) {
+                addIndexedSequence(seq, &faiFile);
             }
+            inRecord = true;
+            lastline = false;
+            blankline = false;
             seq.name = buffer.substr(1, buffer.find_first_of(' ') - 1);
-            seq.offset += buffer.size() + 1;
-            nextoffset = seq.offset;
-            UTILS_DIE_IF(!getline(fasta, buffer), "Missing line in fasta");
             seq.length = 0;
+            continue;
+        }
+        UTILS_DIE_IF(!inRecord, "Missing header line in fasta");
+        UTILS_DIE_IF(blankline, "Blank line inside fasta sequence " + seq.name);
+        if (seq.length == 0) {
+            seq.offset = lineStart;
             seq.linebases = buffer.size();
-            seq.linewidth = buffer.size() + 1;
+            seq.linewidth = buffer.size() + (cr ? 2 : 1);
         } else {
-            UTILS_DIE_IF(lastline, "Invalid fasta line length");
+            UTILS_DIE_IF(lastline || buffer.size() > seq.linebases, "Invalid fasta line length");
         }
+
+        // The last line of the file may end without a line break
+        UTILS_DIE_IF(!fasta.eof() && (seq.linewidth - seq.linebases == 2) != cr, "Mixed line endings in fasta");
         seq.length += buffer.size();
-        seq.offset += buffer.size() + 1;
         if (buffer.size() != seq.linebases) {
             lastline = true;
         }
     }
-    seq.offset = nextoffset;
-    faiFile.addSequence(seq);
+    if (inRecord) {
+        addIndexedSequence(seq, &faiFile);
+    }
     fai << faiFile;
 }
 
@@ -109,6 +184,202 @@ void FastaReader::hash(const FaiFile& fai, std::istream& fasta, std::ostream& ha
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+static const uint64_t INDEX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FastaReader::index(const util::MappedFile& fasta, std::ostream& fai, util::TaskScheduler* scheduler,
+                        const Progress& progress) {
+    const char* data = fasta.data();
+    const uint64_t size = fasta.size();
+    const uint64_t total = 2 * size;  // Header search and line check
+    uint64_t done = 0;
+    std::mutex progressLock;
+    auto report = [&](uint64_t count) {
+        if (progress) {
+            std::lock_guard<std::mutex> guard(progressLock);
+            done += count;
+            progress(done, total);
+        }
+    };
+
+    // Find all header lines. There is no '>' in sequence data, so memchr skips over bases quickly.
+    const uint64_t numBlocks = (size + INDEX_BLOCK_SIZE - 1) / INDEX_BLOCK_SIZE;
+    std::vector<std::vector<uint64_t>> blockHeaders(numBlocks);
+    {
+        util::TaskGroup group(scheduler);
+        for (uint64_t b = 0; b < numBlocks; ++b) {
+            group.run([&, b]() {
+                const uint64_t begin = b * INDEX_BLOCK_SIZE;
+                const uint64_t end = std::min(size, begin + INDEX_BLOCK_SIZE);
+                uint64_t pos = begin;
+                while (pos < end) {
+                    const auto* hit = static_cast<const char*>(std::memchr(data + pos, '>', end - pos));
+                    if (!hit) {
+                        break;
+                    }
+                    pos = static_cast<uint64_t>(hit - data);
+                    if (pos == 0 || data[pos - 1] == '\n') {
+                        blockHeaders[b].push_back(pos);
+                    }
+                    pos++;
+                }
+                report(end - begin);
+            });
+        }
+        group.wait();
+    }
+    std::vector<uint64_t> headers;
+    for (const auto& h : blockHeaders) {
+        headers.insert(headers.end(), h.begin(), h.end());
+    }
+    UTILS_DIE_IF(headers.empty(), "No sequence in fasta");
+
+    auto isBreak = [](char c) { return c == '\n' || c == '\r'; };
+    UTILS_DIE_IF(!std::all_of(data, data + headers.front(), isBreak), "Missing header line in fasta");
+
+    // Line geometry is defined by the first line of each sequence. Split the sequences into blocks starting at line
+    // beginnings, so that every block can check the positions of its line breaks on its own.
+    struct LineBlock {
+        size_t seq;
+        uint64_t begin;
+        uint64_t end;
+        uint64_t newlines;
+        bool valid;
+    };
+    std::vector<FaiFile::FaiSequence> seqs;
+    std::vector<uint64_t> seqEnds;
+    std::vector<LineBlock> blocks;
+    for (size_t i = 0; i < headers.size(); ++i) {
+        const uint64_t next = i + 1 < headers.size() ? headers[i + 1] : size;
+        const auto* headerEnd = static_cast<const char*>(std::memchr(data + headers[i], '\n', next - headers[i]));
+        std::string header(data + headers[i] + 1, headerEnd ? headerEnd : data + next);
+        if (!header.empty() && header.back() == '\r') {
+            header.pop_back();
+        }
+        FaiFile::FaiSequence seq;
+        seq.name = header.substr(0, header.find_first_of(' '));
+        seq.offset = headerEnd ? static_cast<uint64_t>(headerEnd - data) + 1 : next;
+
+        // Blank lines after the header, line break of the last line and blank lines before the next header
+        while (seq.offset < next && isBreak(data[seq.offset])) {
+            seq.offset++;
+        }
+        uint64_t end = next;
+        while (end > seq.offset && isBreak(data[end - 1])) {
+            end--;
+        }
+        if (end == seq.offset) {
+            // Empty record, skipped when adding it to the index
+            seq.linebases = 0;
+            seq.linewidth = 1;
+            seqs.push_back(seq);
+            seqEnds.push_back(end);
+            continue;
+        }
+        // The break of a single line sequence is behind end, but still decides the line width
+        const auto* firstBreak = static_cast<const char*>(std::memchr(data + seq.offset, '\n', next - seq.offset));
+        const bool crlf = firstBreak && firstBreak[-1] == '\r';
+        seq.linebases = firstBreak ? static_cast<size_t>(firstBreak - (data + seq.offset)) : end - seq.offset;
+        seq.linebases = std::min<size_t>(seq.linebases - (crlf ? 1 : 0), end - seq.offset);
+        seq.linewidth = seq.linebases + (crlf ? 2 : 1);
+        UTILS_DIE_IF(seq.linebases == 0, "Invalid fasta line length");
+
+        const uint64_t blockSize = std::max<uint64_t>(1, INDEX_BLOCK_SIZE / seq.linewidth) * seq.linewidth;
+        for (uint64_t b = seq.offset; b < end; b += blockSize) {
+            blocks.push_back({seqs.size(), b, std::min(end, b + blockSize), 0, true});
+        }
+        seqs.push_back(seq);
+        seqEnds.push_back(end);
+    }
+    {
+        util::TaskGroup group(scheduler);
+        for (auto& block : blocks) {
+            auto* blk = &block;
+            group.run([&, blk]() {
+                const auto& seq = seqs[blk->seq];
+                uint64_t pos = blk->begin;
+                while (pos < blk->end) {
+                    const auto* hit = static_cast<const char*>(std::memchr(data + pos, '\n', blk->end - pos));
+                    if (!hit) {
+                        break;
+                    }
+                    pos = static_cast<uint64_t>(hit - data);
+                    // Also catches blank lines and stray carriage returns, as they shift the following breaks
+                    const uint64_t column = (pos - seq.offset) % seq.linewidth;
+                    const bool crlf = seq.linewidth - seq.linebases == 2;
+                    if (column != seq.linewidth - 1 || crlf != (data[pos - 1] == '\r')) {
+                        blk->valid = false;
+                        break;
+                    }
+                    blk->newlines++;
+                    pos++;
+                }
+                report(blk->end - blk->begin);
+            });
+        }
+        group.wait();
+    }
+
+    std::vector<uint64_t> newlines(seqs.size(), 0);
+    for (const auto& block : blocks) {
+        UTILS_DIE_IF(!block.valid, "Invalid fasta line length or blank line inside sequence " + seqs[block.seq].name);
+        newlines[block.seq] += block.newlines;
+    }
+    FaiFile faiFile;
+    for (size_t i = 0; i < seqs.size(); ++i) {
+        // All line breaks found are at the right places, make sure none is missing (i.e. no overlong last line)
+        const uint64_t bytes = seqEnds[i] - seqs[i].offset;
+        UTILS_DIE_IF(newlines[i] != bytes / seqs[i].linewidth ||
+                         bytes - newlines[i] * seqs[i].linewidth > seqs[i].linebases,
+                     "Invalid fasta line length");
+        seqs[i].length = bytes - newlines[i] * (seqs[i].linewidth - seqs[i].linebases);
+        addIndexedSequence(seqs[i], &faiFile);
+    }
+    report(total - done);
+    fai << faiFile;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FastaReader::hash(const FaiFile& fai, const util::MappedFile& fasta, std::ostream& hash,
+                       util::TaskScheduler* scheduler, const Progress& progress) {
+    std::vector<std::pair<std::string, std::string>> hashes;
+    uint64_t total = 0;
+    for (const auto& s : fai.getSequences()) {
+        hashes.emplace_back(s.second, "");
+        total += fai.getLength(s.second);
+    }
+    uint64_t done = 0;
+    std::mutex progressLock;
+    auto report = [&](size_t count) {
+        if (progress) {
+            std::lock_guard<std::mutex> guard(progressLock);
+            done += count;
+            progress(done, total);
+        }
+    };
+
+    // Hashing a sequence is serial, start the long ones first so that they do not end up as a serial tail
+    std::vector<size_t> order(hashes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return fai.getLength(hashes[a].first) > fai.getLength(hashes[b].first);
+    });
+    util::TaskGroup group(scheduler);
+    for (auto i : order) {
+        group.run([&, i]() {
+            const auto& name = hashes[i].first;
+            hashes[i].second = Sha256File::hash(fasta.data(), fasta.size(), fai.getFilePosition(name, 0),
+                                                fai.getLength(name), report);
+        });
+    }
+    group.wait();
+    Sha256File::write(hash, hashes);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 core::meta::Reference FastaReader::getMeta() const {
     std::string basename = path.substr(path.find_last_of('/') + 1, path.find_last_of('.') - path.find_last_of('/') - 1);
     auto f = genie::util::make_unique<core::meta::external_ref::Fasta>(
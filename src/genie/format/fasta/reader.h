@@ -9,7 +9,9 @@
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include "genie/core/meta/external-ref/fasta.h"
@@ -17,6 +19,8 @@
 #include "genie/format/fasta/fai-file.h"
 #include "genie/format/fasta/sha256File.h"
 #include "genie/util/make-unique.h"
+#include "genie/util/mapped-file.h"
+#include "genie/util/task-scheduler.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -28,11 +32,24 @@ namespace fasta {
  * @brief
  */
 class FastaReader {
+ public:
+    using Progress = std::function<void(uint64_t, uint64_t)>;  //!< @brief Called with processed and total work
+
  private:
-    Sha256File hashFile;  //!< @brief
-    FaiFile fai;          //!< @brief
-    std::istream* fasta;  //!< @brief
-    std::string path;     //!< @brief
+    Sha256File hashFile;                    //!< @brief
+    FaiFile fai;                            //!< @brief
+    std::istream* fasta;                    //!< @brief
+    std::string path;                       //!< @brief
+    std::unique_ptr<util::MappedFile> map;  //!< @brief Fasta file mapped into memory, replaces the stream if valid
+
+    /**
+     * @brief Copy a section straight out of the mapped file, using the fai line geometry to skip line breaks
+     * @param seq Sequence index entry
+     * @param start First base
+     * @param end Last base + 1, clamped to the sequence length
+     * @return Bases in upper case
+     */
+    std::string loadMappedSection(const FaiFile::FaiSequence& seq, uint64_t start, uint64_t end) const;
 
  public:
     /**
@@ -66,6 +83,12 @@ class FastaReader {
      */
     std::string loadSection(const std::string& sequence, uint64_t start, uint64_t end);
 
+    /**
+     * @brief
+     * @return True if sections are served from a memory mapping. loadSection() is thread safe in this case.
+     */
+    bool isMapped() const;
+
     /**
      * @brief
      * @return
@@ -86,6 +109,28 @@ class FastaReader {
      * @param hash
      */
     static void hash(const FaiFile& fai, std::istream& fasta, std::ostream& hash);
+
+    /**
+     * @brief Build the fai index of a mapped fasta file. Header lines are searched and line lengths are checked in
+     * parallel blocks. The output is equivalent to the stream based index().
+     * @param fasta Mapped fasta file
+     * @param fai Output fai file
+     * @param scheduler Where to run the blocks, nullptr to run them on the calling thread
+     * @param progress Progress notification, may be called from any thread but never concurrently. May be empty.
+     */
+    static void index(const util::MappedFile& fasta, std::ostream& fai, util::TaskScheduler* scheduler,
+                      const Progress& progress = nullptr);
+
+    /**
+     * @brief Hash all sequences of a mapped fasta file in parallel, one task per sequence, longest first
+     * @param fai Index of the fasta file
+     * @param fasta Mapped fasta file
+     * @param hash Output sha256 file
+     * @param scheduler Where to run the hash tasks, nullptr to run them on the calling thread
+     * @param progress Progress notification, may be called from any thread but never concurrently. May be empty.
+     */
+    static void hash(const FaiFile& fai, const util::MappedFile& fasta, std::ostream& hash,
+                     util::TaskScheduler* scheduler, const Progress& progress = nullptr);
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -6,6 +6,8 @@
 
 #include "genie/format/fasta/sha256File.h"
 #include <algorithm>
+#include <cstring>
+#include "genie/util/runtime-exception.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -65,7 +67,8 @@ std::string Sha256File::hash(std::istream& file, size_t posStart, size_t length)
         size_t this_size = std::min(CHUNK_SIZE, length);
         std::string buffer(this_size, 0);
         file.read(&buffer[0], this_size);
-        buffer.erase(std::remove(buffer.begin(), buffer.end(), '\n'), buffer.end());
+        buffer.erase(std::remove_if(buffer.begin(), buffer.end(), [](char c) { return c == '\n' || c == '\r'; }),
+                     buffer.end());
         hasher.process(buffer.begin(), buffer.end());
         length -= buffer.size();
     }
@@ -77,6 +80,39 @@ std::string Sha256File::hash(std::istream& file, size_t posStart, size_t length)
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+std::string Sha256File::hash(const char* file, size_t fileSize, size_t posStart, size_t length,
+                             const std::function<void(size_t)>& progress) {
+    const size_t CHUNK_SIZE = 1 * 1024 * 1024;
+    picosha2::hash256_one_by_one hasher;
+    hasher.init();
+    std::string buffer;
+    buffer.reserve(CHUNK_SIZE);
+    size_t pos = posStart;
+    while (length) {
+        // Collect lines without their line breaks until the buffer is full
+        buffer.clear();
+        while (length && buffer.size() < CHUNK_SIZE) {
+            UTILS_DIE_IF(pos >= fileSize, "Fasta file shorter than indexed");
+            size_t window = std::min(std::min(fileSize - pos, length), CHUNK_SIZE - buffer.size());
+            const auto* newline = static_cast<const char*>(std::memchr(file + pos, '\n', window));
+            size_t count = newline ? static_cast<size_t>(newline - (file + pos)) : window;
+            const size_t before = buffer.size();
+            buffer.append(file + pos, count);
+            buffer.erase(std::remove(buffer.begin() + before, buffer.end(), '\r'), buffer.end());
+            length -= buffer.size() - before;
+            pos += count + (newline ? 1 : 0);
+        }
+        hasher.process(buffer.begin(), buffer.end());
+        if (progress) {
+            progress(buffer.size());
+        }
+    }
+    hasher.finish();
+    return picosha2::get_hash_hex_string(hasher);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace fasta
 }  // namespace format
 }  // namespace genie
@@ -10,6 +10,7 @@
 // ---------------------------------------------------------------------------------------------------------------------
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -61,6 +62,18 @@ class Sha256File {
      * @return
      */
     static std::string hash(std::istream& file, size_t posStart, size_t length);
+
+    /**
+     * @brief Hash a sequence in memory, skipping line breaks
+     * @param file Start of the fasta file content
+     * @param fileSize Size of the fasta file content
+     * @param posStart Offset of the first base
+     * @param length Number of bases
+     * @param progress Called with the number of newly hashed bases every now and then, may be empty
+     * @return Hash as hex string
+     */
+    static std::string hash(const char* file, size_t fileSize, size_t posStart, size_t length,
+                            const std::function<void(size_t)>& progress = nullptr);
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -7,7 +7,6 @@
 #include "genie/format/fastq/exporter.h"
 #include <string>
 #include <utility>
-#include "genie/util/ordered-section.h"
 #include "genie/util/watch.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -18,21 +17,35 @@ namespace fastq {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-Exporter::Exporter(std::ostream &_file_1) : file{&_file_1} {}
+Exporter::Exporter(std::ostream &_file_1)
+    : file{&_file_1}, buffer([this](SerializedChunk &&c) { write(std::move(c)); }) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-Exporter::Exporter(std::ostream &_file_1, std::ostream &_file_2) : file{&_file_1, &_file_2} {}
+Exporter::Exporter(std::ostream &_file_1, std::ostream &_file_2)
+    : file{&_file_1, &_file_2}, buffer([this](SerializedChunk &&c) { write(std::move(c)); }) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Exporter::skipIn(const util::Section &id) { util::OrderedSection sec(&lock, id); }
+void Exporter::skipIn(const util::Section &id) { buffer.skip(id); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Exporter::write(SerializedChunk &&c) {
+    for (size_t i = 0; i < file.size(); ++i) {
+        file[i]->write(c.data[i].data(), c.data[i].length());
+    }
+    getStats().add(c.stats);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
 
 void Exporter::flowIn(core::record::Chunk &&t, const util::Section &id) {
     core::record::Chunk data = std::move(t);
-    getStats().add(data.getStats());
     util::Watch watch;
-    util::OrderedSection section(&lock, id);
+    data.expandColumns();
+    // Formatting runs in parallel, only the copy into the files is ordered
+    SerializedChunk out{std::vector<std::string>(file.size()), std::move(data.getStats())};
     size_t size_seq = 0;
     size_t size_qual = 0;
     size_t size_name = 0;
@@ -44,43 +57,43 @@ void Exporter::flowIn(core::record::Chunk &&t, const util::Section &id) {
     bool second_read_flag = false;  // true when we are handling second read
 
     for (const auto &i : data.getData()) {
-        auto file_ptr = file.data();
+        auto file_ptr = out.data.data();
         second_read_flag = false;
         if (!i.isRead1First()) {
             second_read_flag = true;
-            if (num_files == 2) file_ptr = &file.back();
+            if (num_files == 2) file_ptr = &out.data.back();
         }
         for (const auto &rec : i.getSegments()) {
             // ID
             size_name += i.getName().size();
             constexpr const char *ID_TOKEN = "@";
-            (*file_ptr)->write(ID_TOKEN, 1);
-            (*file_ptr)->write(i.getName().c_str(), i.getName().length());
+            file_ptr->append(ID_TOKEN, 1);
+            file_ptr->append(i.getName().c_str(), i.getName().length());
             if (i.getNumberOfTemplateSegments() == 2 && num_files == 1)
-                (*file_ptr)->write(readname_suffix[second_read_flag], 2);
-            (*file_ptr)->write("\n", 1);
+                file_ptr->append(readname_suffix[second_read_flag], 2);
+            file_ptr->append("\n", 1);
 
             // Sequence
             size_seq += rec.getSequence().size();
-            (*file_ptr)->write(rec.getSequence().c_str(), rec.getSequence().length());
-            (*file_ptr)->write("\n", 1);
+            file_ptr->append(rec.getSequence().c_str(), rec.getSequence().length());
+            file_ptr->append("\n", 1);
 
             // Reserved Line
             constexpr const char *RESERVED_TOKEN = "+";
-            (*file_ptr)->write(RESERVED_TOKEN, 1);
-            (*file_ptr)->write("\n", 1);
+            file_ptr->append(RESERVED_TOKEN, 1);
+            file_ptr->append("\n", 1);
 
             // Qualities
             if (!rec.getQualities().empty()) {
                 size_qual += rec.getQualities().front().size();
-                (*file_ptr)->write(rec.getQualities().front().c_str(), rec.getQualities().front().length());
+                file_ptr->append(rec.getQualities().front().c_str(), rec.getQualities().front().length());
             } else {
                 // Make up default quality values
                 size_qual += rec.getSequence().length();
                 std::string qual(rec.getSequence().length(), '#');
-                (*file_ptr)->write(qual.c_str(), qual.length());
+                file_ptr->append(qual.c_str(), qual.length());
             }
-            (*file_ptr)->write("\n", 1);
+            file_ptr->append("\n", 1);
             second_read_flag = !second_read_flag;
             if (num_files == 2) {
                 if (i.isRead1First()) {
@@ -92,11 +105,19 @@ void Exporter::flowIn(core::record::Chunk &&t, const util::Section &id) {
         }
     }
 
-    getStats().addInteger("size-fastq-seq", size_seq);
-    getStats().addInteger("size-fastq-name", size_name);
-    getStats().addInteger("size-fastq-qual", size_qual);
-    getStats().addInteger("size-fastq-total", size_qual + size_name + size_seq);
-    getStats().addDouble("time-fastq-export", watch.check());
+    out.stats.addInteger("size-fastq-seq", size_seq);
+    out.stats.addInteger("size-fastq-name", size_name);
+    out.stats.addInteger("size-fastq-qual", size_qual);
+    out.stats.addInteger("size-fastq-total", size_qual + size_name + size_seq);
+    out.stats.addDouble("time-fastq-export", watch.check());
+    buffer.deposit(std::move(out), id);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Exporter::flushIn(uint64_t &pos) {
+    buffer.flush();
+    FormatExporter::flushIn(pos);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
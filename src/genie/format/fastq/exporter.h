@@ -9,14 +9,14 @@
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#include <string>
 #include <vector>
 #include "genie/core/format-exporter.h"
 #include "genie/core/record/chunk.h"
 #include "genie/core/stats/perf-stats.h"
 #include "genie/util/drain.h"
 #include "genie/util/make-unique.h"
-#include "genie/util/ordered-lock.h"
-#include "genie/util/ordered-section.h"
+#include "genie/util/reorder-buffer.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -28,8 +28,22 @@ namespace fastq {
  * @brief Module to export MPEG-G record to fastq files
  */
 class Exporter : public core::FormatExporter {
-    std::vector<std::ostream *> file;  //!< @brief Support for paired output files
-    util::OrderedLock lock;            //!< @brief Lock to ensure in order execution
+    /**
+     * @brief A chunk of records already formatted as fastq text
+     */
+    struct SerializedChunk {
+        std::vector<std::string> data;  //!< @brief Text for each output file
+        core::stats::PerfStats stats;   //!< @brief Performance statistics of the chunk
+    };
+
+    std::vector<std::ostream *> file;             //!< @brief Support for paired output files
+    util::ReorderBuffer<SerializedChunk> buffer;  //!< @brief Ensures in order output
+
+    /**
+     * @brief Write one formatted chunk. Called in order by the reorder buffer.
+     * @param c Formatted chunk
+     */
+    void write(SerializedChunk &&c);
 
  public:
     /**
@@ -57,6 +71,12 @@ class Exporter : public core::FormatExporter {
      * @param id Block identifier (for multithreading)
      */
     void flowIn(core::record::Chunk &&records, const util::Section &id) override;
+
+    /**
+     * @brief Checks that all chunks were written
+     * @param pos
+     */
+    void flushIn(uint64_t &pos) override;
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -5,6 +5,7 @@
  */
 
 #include "genie/format/fastq/importer.h"
+#include <cstring>
 #include <utility>
 #include "genie/core/record/class-type.h"
 #include "genie/util/ordered-section.h"
@@ -18,92 +19,93 @@ namespace fastq {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-Importer::Importer(size_t _blockSize, std::istream &_file_1) : blockSize(_blockSize), file_list{&_file_1} {}
+Importer::Importer(size_t _blockSize, std::istream &_file_1) : blockSize(_blockSize), lines(1) {
+    file_list.emplace_back(_file_1);
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-Importer::Importer(size_t _blockSize, std::istream &_file_1, std::istream &_file_2)
-    : blockSize(_blockSize), file_list{&_file_1, &_file_2} {}
+Importer::Importer(size_t _blockSize, std::istream &_file_1, std::istream &_file_2) : blockSize(_blockSize), lines(2) {
+    file_list.reserve(2);
+    file_list.emplace_back(_file_1);
+    file_list.emplace_back(_file_2);
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-bool Importer::pumpRetrieve(core::Classifier *_classifier) {
+bool Importer::pumpRetrieve(core::record::Chunk *_chunk) {
     util::Watch watch;
     core::record::Chunk chunk;
+    auto &columns = chunk.getColumns();
+    columns.setNumberOfTemplateSegments(uint8_t(file_list.size()));
+    columns.reserve(blockSize, lastBlockBases, lastBlockNames);
     size_t size_seq = 0;
     size_t size_qual = 0;
     size_t size_name = 0;
     bool eof = false;
     {
         for (size_t cur_record = 0; cur_record < blockSize; ++cur_record) {
-            auto data = readData(file_list);
-            if (data.empty()) {
+            if (!readRecord()) {
                 eof = true;
                 break;
             }
-            auto record = buildRecord(data);
-            for (const auto &seg : record.getSegments()) {
-                size_seq += seg.getSequence().size();
-                for (const auto &q : seg.getQualities()) {
-                    size_qual += q.size();
+            const auto &id = lines[Files::FIRST][Lines::ID];
+            std::memcpy(columns.addRecord(id.length() - 1), id.begin() + 1, id.length() - 1);
+            size_name += (id.length() - 1) * 2;
+            for (const auto &cur_rec : lines) {
+                const auto &seq = cur_rec[Lines::SEQUENCE];
+                std::memcpy(columns.addSequence(seq.length()), seq.begin(), seq.length());
+                size_seq += seq.length();
+                const auto &qual = cur_rec[Lines::QUALITY];
+                if (qual.length()) {
+                    std::memcpy(columns.addQualities(qual.length()), qual.begin(), qual.length());
+                    size_qual += qual.length();
                 }
             }
-            size_name += record.getName().size() * 2;
-            chunk.getData().push_back(std::move(record));
         }
     }
+    lastBlockBases = size_seq;
+    lastBlockNames = size_name / 2;
 
     chunk.getStats().addInteger("size-fastq-seq", size_seq);
     chunk.getStats().addInteger("size-fastq-qual", size_qual);
     chunk.getStats().addInteger("size-fastq-name", size_name);
     chunk.getStats().addInteger("size-fastq-total", size_name + size_qual + size_seq);
     chunk.getStats().addDouble("time-fastq-import", watch.check());
-    _classifier->add(std::move(chunk));
+    *_chunk = std::move(chunk);
     return !eof;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-core::record::Record Importer::buildRecord(std::vector<std::array<std::string, LINES_PER_RECORD>> data) {
-    auto ret = core::record::Record(uint8_t(data.size()), core::record::ClassType::CLASS_U,
-                                    data[Files::FIRST][Lines::ID].substr(1), "", 0);
-
-    for (auto &cur_rec : data) {
-        auto seg = core::record::Segment(std::move(cur_rec[Lines::SEQUENCE]));
-        if (!cur_rec[Lines::QUALITY].empty()) {
-            seg.addQualities(std::move(cur_rec[Lines::QUALITY]));
-        }
-        ret.addSegment(std::move(seg));
-    }
-    return ret;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-std::vector<std::array<std::string, Importer::LINES_PER_RECORD>> Importer::readData(
-    const std::vector<std::istream *> &_file_list) {
-    std::vector<std::array<std::string, LINES_PER_RECORD>> data(_file_list.size());
-    for (size_t cur_file = 0; cur_file < _file_list.size(); ++cur_file) {
+bool Importer::readRecord() {
+    for (size_t cur_file = 0; cur_file < file_list.size(); ++cur_file) {
+        auto &file = file_list[cur_file];
+        file.discard();
         for (size_t cur_line = 0; cur_line < LINES_PER_RECORD; ++cur_line) {
-            if (!std::getline(*(_file_list[cur_file]), data[cur_file][cur_line])) {
-                data.clear();
-                return data;
+            if (!file.readLine(lines[cur_file][cur_line])) {
+                return false;
             }
         }
 
-        sanityCheck(data[cur_file]);
+        // All lines of the record are in memory now, point the views at them
+        for (auto &line : lines[cur_file]) {
+            line = line.deploy(file.data());
+        }
+        sanityCheck(lines[cur_file]);
     }
-    return data;
+    return true;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Importer::sanityCheck(const std::array<std::string, LINES_PER_RECORD> &data) {
+void Importer::sanityCheck(const std::array<util::StringView, LINES_PER_RECORD> &data) {
     constexpr char ID_TOKEN = '@';
-    UTILS_DIE_IF(data[Lines::ID].front() != ID_TOKEN, "Invald fastq identifier");
+    UTILS_DIE_IF(!data[Lines::ID].length() || *data[Lines::ID].begin() != ID_TOKEN, "Invald fastq identifier");
     constexpr char RESERVED_TOKEN = '+';
-    UTILS_DIE_IF(data[Lines::RESERVED].front() != RESERVED_TOKEN, "Invald fastq line 3");
-    UTILS_DIE_IF(data[Lines::SEQUENCE].size() != data[Lines::QUALITY].size(),
+    UTILS_DIE_IF(!data[Lines::RESERVED].length() || *data[Lines::RESERVED].begin() != RESERVED_TOKEN,
+                 "Invald fastq line 3");
+    UTILS_DIE_IF(data[Lines::SEQUENCE].length() != data[Lines::QUALITY].length(),
                  "Qual and Seq in fastq do not match in length");
 }
 
@@ -15,11 +15,13 @@
 #include "genie/core/format-importer.h"
 #include "genie/core/record/record.h"
 #include "genie/core/stats/perf-stats.h"
+#include "genie/util/line-reader.h"
 #include "genie/util/make-unique.h"
 #include "genie/util/ordered-lock.h"
 #include "genie/util/original-source.h"
 #include "genie/util/runtime-exception.h"
 #include "genie/util/source.h"
+#include "genie/util/stringview.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -34,32 +36,27 @@ class Importer : public core::FormatImporter {
  private:
     static constexpr size_t LINES_PER_RECORD = 4;  //!< @brief How many lines in a fastq file belong to one record
     size_t blockSize;                              //!< @brief How many records to read in one pump() run
-    std::vector<std::istream *> file_list;         //!< @brief Input streams (paired files supported)
+    std::vector<util::LineReader> file_list;       //!< @brief Input streams (paired files supported)
     util::OrderedLock lock;                        //!< @brief Lock to ensure in order execution
 
     enum Lines { ID = 0, SEQUENCE = 1, RESERVED = 2, QUALITY = 3 };  //!< @brief FASTQ format lines
     enum Files { FIRST = 0, SECOND = 1 };                            //!< @brief File shortcuts
 
+    std::vector<std::array<util::StringView, LINES_PER_RECORD>> lines;  //!< @brief Current record per file
+    size_t lastBlockBases{0};                                           //!< @brief Bases of the last block
+    size_t lastBlockNames{0};                                           //!< @brief Name bytes of the last block
+
     /**
-     * @brief Read one chunk of fastq data
-     * @param _file_list Where to read data from (2 streams in paired mode)
-     * @return Data extracted from the fastq files, not converted yet
+     * @brief Read the lines of the next record from all files. The lines stay valid until the next call.
+     * @return False if the files ended
      */
-    static std::vector<std::array<std::string, LINES_PER_RECORD>> readData(
-        const std::vector<std::istream *> &_file_list);
+    bool readRecord();
 
     /**
      * @brief Check if read record data is actually valid for fastq files or if anything went wrong
      * @param data Data read previously
      */
-    static void sanityCheck(const std::array<std::string, LINES_PER_RECORD> &data);
-
-    /**
-     * @brief Do the conversion to MPEG-G records
-     * @param data Raw fastq data
-     * @return Finished MPEG-G record
-     */
-    static core::record::Record buildRecord(std::vector<std::array<std::string, LINES_PER_RECORD>> data);
+    static void sanityCheck(const std::array<util::StringView, LINES_PER_RECORD> &data);
 
  public:
     /**
@@ -79,10 +76,10 @@ class Importer : public core::FormatImporter {
 
     /**
      * @brief
-     * @param _classifier
+     * @param _chunk Output block of records
      * @return
      */
-    bool pumpRetrieve(core::Classifier *_classifier) override;
+    bool pumpRetrieve(core::record::Chunk *_chunk) override;
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -24,20 +24,27 @@ namespace mgb {
 // ---------------------------------------------------------------------------------------------------------------------
 
 void AccessUnit::debugPrint(const core::parameter::EncodingSet &ps) const {
+    std::cerr << "AU " << header.getID() << ": " << getDescription(ps) << "..." << std::endl;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string AccessUnit::getDescription(const core::parameter::EncodingSet &ps) const {
     std::string lut[] = {"NONE", "P", "N", "M", "I", "HM", "U"};
-    std::cerr << "AU " << header.getID() << ": class " << lut[static_cast<int>(header.getClass())];
+    std::ostringstream output;
+    output << "class " << lut[static_cast<int>(header.getClass())];
     if (header.getClass() != genie::core::record::ClassType::CLASS_U) {
-        std::cerr << ", Position [" << header.getAlignmentInfo().getRefID() << "-"
-                  << header.getAlignmentInfo().getStartPos() << ":" << header.getAlignmentInfo().getEndPos() << "]";
+        output << ", Position [" << header.getAlignmentInfo().getRefID() << "-"
+               << header.getAlignmentInfo().getStartPos() << ":" << header.getAlignmentInfo().getEndPos() << "]";
     }
-    std::cerr << ", " << header.getReadCount() << " records";
+    output << ", " << header.getReadCount() << " records";
 
     if (header.getClass() == genie::core::record::ClassType::CLASS_U) {
         if (!ps.isComputedReference()) {
-            std::cerr << " (Low Latency)";
+            output << " (Low Latency)";
         } else {
             if (ps.getComputedRef().getAlgorithm() == core::parameter::ComputedRef::Algorithm::GLOBAL_ASSEMBLY) {
-                std::cerr << " (Global Assembly)";
+                output << " (Global Assembly)";
             } else {
                 UTILS_DIE("Computed ref not supported: " +
                           std::to_string(static_cast<int>(ps.getComputedRef().getAlgorithm())));
@@ -45,17 +52,17 @@ void AccessUnit::debugPrint(const core::parameter::EncodingSet &ps) const {
         }
     } else {
         if (!ps.isComputedReference()) {
-            std::cerr << " (Reference)";
+            output << " (Reference)";
         } else {
             if (ps.getComputedRef().getAlgorithm() == core::parameter::ComputedRef::Algorithm::LOCAL_ASSEMBLY) {
-                std::cerr << " (Local Assembly)";
+                output << " (Local Assembly)";
             } else {
                 UTILS_DIE("Computed ref not supported: " +
                           std::to_string(static_cast<int>(ps.getComputedRef().getAlgorithm())));
             }
         }
     }
-    std::cerr << "..." << std::endl;
+    return output.str();
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -177,6 +184,14 @@ uint8_t AUHeader::getParameterID() const { return parameter_set_ID; }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void AUHeader::setID(uint32_t _access_unit_ID) { access_unit_ID = _access_unit_ID; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AUHeader::setParameterID(uint8_t _parameter_set_ID) { parameter_set_ID = _parameter_set_ID; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 const AuTypeCfg &AUHeader::getAlignmentInfo() const { return *au_Type_U_Cfg; }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -203,6 +218,7 @@ void AccessUnit::write(util::BitWriter &writer) const {
     bits += TYPE_SIZE_SIZE;
     uint64_t bytes = bits / 8;
 
+    bytes += serializedBlocks.size();
     for (auto &i : blocks) {
         bytes += i.getWrittenSize();
     }
@@ -210,6 +226,7 @@ void AccessUnit::write(util::BitWriter &writer) const {
     // Now size is known, write to final destination
     writer.write(bytes, 29);
     writer.writeBypass(&ss);
+    writer.writeBypass(serializedBlocks.data(), serializedBlocks.size());
     for (auto &i : blocks) {
         i.write(writer);
     }
@@ -224,6 +241,20 @@ void AccessUnit::addBlock(Block block) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void AccessUnit::serializeBlocks() {
+    std::ostringstream stream;
+    {
+        util::BitWriter blockWriter(&stream);
+        for (auto &i : blocks) {
+            i.write(blockWriter);
+        }
+    }
+    serializedBlocks += stream.str();
+    blocks.clear();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 const AUHeader &AccessUnit::getHeader() const { return header; }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 // ---------------------------------------------------------------------------------------------------------------------
 
 #include <map>
+#include <string>
 #include <vector>
 #include "genie/format/mgb/access_unit_header.h"
 #include "genie/format/mgb/block.h"
@@ -30,6 +31,13 @@ class AccessUnit : public core::parameter::DataUnit {
      */
     void debugPrint(const core::parameter::EncodingSet &ps) const;
 
+    /**
+     * @brief
+     * @param ps
+     * @return Class, position, number of records and coding mode as printed by debugPrint()
+     */
+    std::string getDescription(const core::parameter::EncodingSet &ps) const;
+
     /**
      * @brief
      * @param parameterSets
@@ -78,6 +86,12 @@ class AccessUnit : public core::parameter::DataUnit {
      */
     void addBlock(Block block);
 
+    /**
+     * @brief Convert all blocks added so far to their binary representation, so that write() only has to copy them.
+     * The header can still be changed afterwards.
+     */
+    void serializeBlocks();
+
     /**
      * @brief
      * @return
@@ -112,7 +126,8 @@ class AccessUnit : public core::parameter::DataUnit {
  private:
     AUHeader header;  //!< @brief
 
-    std::vector<Block> blocks;  //!< @brief
+    std::vector<Block> blocks;     //!< @brief
+    std::string serializedBlocks;  //!< @brief Blocks converted by serializeBlocks(), written before the others
 
     size_t payloadbytes;  //!< @brief
     size_t qv_payloads;   //!< @brief
@@ -113,6 +113,18 @@ class AUHeader {
      */
     uint8_t getParameterID() const;
 
+    /**
+     * @brief
+     * @param _access_unit_ID
+     */
+    void setID(uint32_t _access_unit_ID);
+
+    /**
+     * @brief
+     * @param _parameter_set_ID
+     */
+    void setParameterID(uint8_t _parameter_set_ID);
+
     /**
      * @brief
      * @return
@@ -0,0 +1,178 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/format/mgb/au-index.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "genie/core/parameter/data_unit.h"
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace format {
+namespace mgb {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const uint32_t INDEX_MAGIC = 0x47494458;  // "GIDX"
+static const uint8_t INDEX_VERSION = 2;
+static const uint64_t FNV_OFFSET = 0xcbf29ce484222325;
+static const uint64_t FNV_PRIME = 0x100000001b3;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Continue a 64 bit FNV-1a hash
+ * @param hash Hash so far
+ * @param data Bytes to add
+ * @return New hash
+ */
+static uint64_t fnv1a(uint64_t hash, const std::string& data) {
+    for (auto c : data) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+AUIndex::AUIndex() : parameterChecksum(FNV_OFFSET) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+AUIndex::AUIndex(util::BitReader& reader) {
+    UTILS_DIE_IF(reader.read<uint32_t>() != INDEX_MAGIC || !reader.isGood(), "Not an mgb index");
+    UTILS_DIE_IF(reader.read<uint8_t>() != INDEX_VERSION, "Unsupported mgb index version");
+    streamSize = reader.read<uint64_t>();
+    parameterChecksum = reader.read<uint64_t>();
+    setupUnits.resize(reader.read<uint32_t>());
+    for (auto& s : setupUnits) {
+        s = reader.read<uint64_t>();
+    }
+    entries.resize(reader.read<uint32_t>());
+    for (auto& e : entries) {
+        e.offset = reader.read<uint64_t>();
+        e.parameterID = reader.read<uint8_t>();
+        e.auClass = reader.read<core::record::ClassType>(8);
+        e.readCount = reader.read<uint32_t>();
+        e.seqID = reader.read<uint16_t>();
+        e.startPos = reader.read<uint64_t>();
+        e.endPos = reader.read<uint64_t>();
+    }
+    UTILS_DIE_IF(!reader.isGood(), "Truncated mgb index");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AUIndex::write(util::BitWriter& writer) const {
+    writer.write(INDEX_MAGIC, 32);
+    writer.write(INDEX_VERSION, 8);
+    writer.write(streamSize, 64);
+    writer.write(parameterChecksum, 64);
+    writer.write(setupUnits.size(), 32);
+    for (const auto& s : setupUnits) {
+        writer.write(s, 64);
+    }
+    writer.write(entries.size(), 32);
+    for (const auto& e : entries) {
+        writer.write(e.offset, 64);
+        writer.write(e.parameterID, 8);
+        writer.write(static_cast<uint8_t>(e.auClass), 8);
+        writer.write(e.readCount, 32);
+        writer.write(e.seqID, 16);
+        writer.write(e.startPos, 64);
+        writer.write(e.endPos, 64);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AUIndex::add(const Entry& e) { entries.push_back(e); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const std::vector<AUIndex::Entry>& AUIndex::getEntries() const { return entries; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AUIndex::addSetupUnit(uint64_t offset) { setupUnits.push_back(offset); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const std::vector<uint64_t>& AUIndex::getSetupUnits() const { return setupUnits; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AUIndex::addParameterSet(uint64_t offset, const std::string& unit) {
+    addSetupUnit(offset);
+    parameterChecksum = fnv1a(parameterChecksum, unit);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool AUIndex::matches(std::istream& stream, uint64_t size) const {
+    if (size != streamSize) {
+        return false;
+    }
+
+    // Data units are contiguous, so each one ends where the next one starts
+    std::vector<uint64_t> bounds(setupUnits);
+    for (const auto& e : entries) {
+        bounds.push_back(e.offset);
+    }
+    bounds.push_back(streamSize);
+    std::sort(bounds.begin(), bounds.end());
+
+    uint64_t checksum = FNV_OFFSET;
+    for (const auto& offset : setupUnits) {
+        auto next = std::upper_bound(bounds.begin(), bounds.end(), offset);
+        if (next == bounds.end()) {
+            return false;
+        }
+        stream.clear();
+        stream.seekg(offset);
+        if (stream.peek() != static_cast<int>(core::parameter::DataUnit::DataUnitType::PARAMETER_SET)) {
+            continue;
+        }
+        std::string unit(*next - offset, '\0');
+        if (!stream.read(&unit[0], unit.size())) {
+            return false;
+        }
+        checksum = fnv1a(checksum, unit);
+    }
+    return checksum == parameterChecksum;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void AUIndex::setStreamSize(uint64_t size) { streamSize = size; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t AUIndex::getStreamSize() const { return streamSize; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<AUIndex::Entry> AUIndex::query(const core::LocusFilter& filter) const {
+    std::vector<Entry> ret;
+    for (const auto& e : entries) {
+        if (e.auClass != core::record::ClassType::CLASS_U && filter.overlaps(e.seqID, e.startPos, e.endPos)) {
+            ret.push_back(e);
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace mgb
+}  // namespace format
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
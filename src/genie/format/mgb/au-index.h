@@ -0,0 +1,142 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_FORMAT_MGB_AU_INDEX_H_
+#define SRC_GENIE_FORMAT_MGB_AU_INDEX_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "genie/core/locus-filter.h"
+#include "genie/core/record/class-type.h"
+#include "genie/util/bitreader.h"
+#include "genie/util/bitwriter.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace format {
+namespace mgb {
+
+/**
+ * @brief Position of all data units in an mgb stream, in stream order. Data access units are listed with their
+ * header information, parameter sets and references only by position. The mgb exporter writes the index next to the
+ * stream, so a decoder can seek to the access units without scanning the file.
+ */
+class AUIndex {
+ public:
+    /**
+     * @brief One access unit
+     */
+    struct Entry {
+        uint64_t offset;                  //!< @brief Byte position of the data unit (type field) in the stream
+        uint8_t parameterID;              //!< @brief Parameter set used by the access unit
+        core::record::ClassType auClass;  //!< @brief Record class
+        uint32_t readCount;               //!< @brief Number of records
+        uint16_t seqID;                   //!< @brief Reference sequence, 0 for class U
+        uint64_t startPos;                //!< @brief First mapping position, 0 for class U
+        uint64_t endPos;                  //!< @brief Last mapping position (inclusive), 0 for class U
+    };
+
+ private:
+    std::vector<Entry> entries;        //!< @brief Access units in stream order
+    std::vector<uint64_t> setupUnits;  //!< @brief Parameter sets and references, needed before decoding any AU
+    uint64_t streamSize{0};            //!< @brief Size of the indexed stream in bytes, to detect outdated indices
+    uint64_t parameterChecksum;        //!< @brief Checksum of all parameter set data units, same purpose
+
+ public:
+    /**
+     * @brief Empty index
+     */
+    AUIndex();
+
+    /**
+     * @brief Read an index written by write()
+     * @param reader Input
+     */
+    explicit AUIndex(util::BitReader& reader);
+
+    /**
+     * @brief Serialize the index
+     * @param writer Output
+     */
+    void write(util::BitWriter& writer) const;
+
+    /**
+     * @brief Append an access unit
+     * @param e Access unit
+     */
+    void add(const Entry& e);
+
+    /**
+     * @brief
+     * @return Access units in stream order
+     */
+    const std::vector<Entry>& getEntries() const;
+
+    /**
+     * @brief Append a parameter set or reference data unit
+     * @param offset Byte position of the data unit in the stream
+     */
+    void addSetupUnit(uint64_t offset);
+
+    /**
+     * @brief
+     * @return Positions of parameter sets and references in stream order
+     */
+    const std::vector<uint64_t>& getSetupUnits() const;
+
+    /**
+     * @brief Append a parameter set data unit and add it to the checksum
+     * @param offset Byte position of the data unit in the stream
+     * @param unit Serialized data unit
+     */
+    void addParameterSet(uint64_t offset, const std::string& unit);
+
+    /**
+     * @brief Check if the index still describes a stream. Compares the size and the checksum of the parameter sets,
+     * which are read from the stream at the indexed positions.
+     * @param stream Indexed stream, its read position is changed
+     * @param size Size of the stream in bytes
+     * @return True if the index can be used
+     */
+    bool matches(std::istream& stream, uint64_t size) const;
+
+    /**
+     * @brief
+     * @param size Size of the indexed stream in bytes
+     */
+    void setStreamSize(uint64_t size);
+
+    /**
+     * @brief
+     * @return Size of the indexed stream in bytes
+     */
+    uint64_t getStreamSize() const;
+
+    /**
+     * @brief Select the aligned access units which may contain records overlapping a locus
+     * @param filter Locus
+     * @return Access units in stream order
+     */
+    std::vector<Entry> query(const core::LocusFilter& filter) const;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace mgb
+}  // namespace format
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_FORMAT_MGB_AU_INDEX_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -29,72 +29,150 @@ const core::parameter::EncodingSet& DataUnitFactory::getParams(size_t id) const
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+bool DataUnitFactory::isReferenceOnly() const { return referenceOnly; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 boost::optional<AccessUnit> DataUnitFactory::read(util::BitReader& bitReader) {
-    core::parameter::DataUnit::DataUnitType type;
-    int i = 0;
+    uint64_t offset = 0;
+    return readNext(bitReader, false, offset);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+AUIndex DataUnitFactory::buildIndex(util::BitReader& bitReader) {
+    AUIndex ret;
+    do {
+        uint64_t offset = bitReader.getPos();
+        auto type = bitReader.read<core::parameter::DataUnit::DataUnitType>();
+        if (!bitReader.isGood()) {
+            bitReader.clear();
+            ret.setStreamSize(offset);
+            return ret;
+        }
+        auto au = readUnit(bitReader, type, true);
+        if (!au) {
+            ret.addSetupUnit(offset);
+            continue;
+        }
+        const auto& header = au->getHeader();
+        AUIndex::Entry e{offset, header.getParameterID(), header.getClass(), header.getReadCount(), 0, 0, 0};
+        if (header.getClass() != core::record::ClassType::CLASS_U) {
+            e.seqID = header.getAlignmentInfo().getRefID();
+            e.startPos = header.getAlignmentInfo().getStartPos();
+            e.endPos = header.getAlignmentInfo().getEndPos();
+        }
+        ret.add(e);
+    } while (true);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void DataUnitFactory::loadIndex(util::BitReader& bitReader, const AUIndex& index) {
+    for (const auto& offset : index.getSetupUnits()) {
+        bitReader.setPos(offset);
+        auto type = bitReader.read<core::parameter::DataUnit::DataUnitType>();
+        UTILS_DIE_IF(!bitReader.isGood(), "Truncated mgb stream");
+        UTILS_DIE_IF(readUnit(bitReader, type, true), "Access unit listed as parameter set or reference in index");
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+AccessUnit DataUnitFactory::readAt(util::BitReader& bitReader, uint64_t offset) {
+    bitReader.setPos(offset);
+    auto type = bitReader.read<core::parameter::DataUnit::DataUnitType>();
+    UTILS_DIE_IF(!bitReader.isGood() || type != core::parameter::DataUnit::DataUnitType::ACCESS_UNIT,
+                 "No access unit at indexed position");
+    auto ret = AccessUnit(parameters, bitReader, true);
+    loadPayload(ret, bitReader);
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void DataUnitFactory::loadPayload(AccessUnit& au, util::BitReader& bitReader) {
+    au.loadPayload(bitReader);
+    for (auto& b : au.getBlocks()) {
+        b.load();
+        b.parse();
+    }
+    UTILS_DIE_IF(au.getHeader().getClass() == genie::core::record::ClassType::CLASS_HM, "Class HM not supported");
+    au.debugPrint(parameters.at(au.getHeader().getParameterID()));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+boost::optional<AccessUnit> DataUnitFactory::readNext(util::BitReader& bitReader, bool skipPayload,
+                                                      uint64_t& offset) {
     do {
-        type = bitReader.read<core::parameter::DataUnit::DataUnitType>();
-        size_t pos = bitReader.getPos();
+        offset = bitReader.getPos();
+        auto type = bitReader.read<core::parameter::DataUnit::DataUnitType>();
         if (!bitReader.isGood()) {
             bitReader.clear();
             return boost::none;
         }
-        switch (type) {
-            case core::parameter::DataUnit::DataUnitType::RAW_REFERENCE: {
-                pos += 10;
-                auto r = RawReference(bitReader, true);
-                for (auto& ref : r) {
-                    pos += 12;
-                    std::cerr << "Found ref(raw) " << ref.getSeqID() << ":[" << ref.getStart() << ", " << ref.getEnd()
-                              << "] ..." << std::endl;
-                    refmgr->validateRefID(ref.getSeqID());
-                    refmgr->addRef(i++,
-                                   util::make_unique<mgb::Reference>(refmgr->ID2Ref(ref.getSeqID()), ref.getStart(),
-                                                                     ref.getEnd() + 1, importer, pos, true));
-                    pos += (ref.getEnd() - ref.getStart() + 1);
-                }
-                break;
+        if (auto ret = readUnit(bitReader, type, skipPayload)) {
+            return ret;
+        }
+    } while (true);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+boost::optional<AccessUnit> DataUnitFactory::readUnit(util::BitReader& bitReader,
+                                                      core::parameter::DataUnit::DataUnitType type, bool skipPayload) {
+    size_t pos = bitReader.getPos();
+    switch (type) {
+        case core::parameter::DataUnit::DataUnitType::RAW_REFERENCE: {
+            pos += 10;
+            auto r = RawReference(bitReader, true);
+            for (auto& ref : r) {
+                pos += 12;
+                std::cerr << "Found ref(raw) " << ref.getSeqID() << ":[" << ref.getStart() << ", " << ref.getEnd()
+                          << "] ..." << std::endl;
+                refmgr->validateRefID(ref.getSeqID());
+                refmgr->addRef(refIndex++,
+                               util::make_unique<mgb::Reference>(refmgr->ID2Ref(ref.getSeqID()), ref.getStart(),
+                                                                 ref.getEnd() + 1, importer, pos, true));
+                pos += (ref.getEnd() - ref.getStart() + 1);
             }
-            case core::parameter::DataUnit::DataUnitType::PARAMETER_SET: {
-                auto p = core::parameter::ParameterSet(bitReader);
-                std::cerr << "Found PS " << (uint32_t)p.getID() << "..." << std::endl;
-                parameters.insert(std::make_pair(p.getID(), std::move(p.getEncodingSet())));
-                break;
+            return boost::none;
+        }
+        case core::parameter::DataUnit::DataUnitType::PARAMETER_SET: {
+            auto p = core::parameter::ParameterSet(bitReader);
+            std::cerr << "Found PS " << (uint32_t)p.getID() << "..." << std::endl;
+            parameters.insert(std::make_pair(p.getID(), std::move(p.getEncodingSet())));
+            return boost::none;
+        }
+        case core::parameter::DataUnit::DataUnitType::ACCESS_UNIT: {
+            auto ret = AccessUnit(parameters, bitReader, true);
+            if (getParams(ret.getHeader().getParameterID()).getDatasetType() ==
+                mgb::AccessUnit::DatasetType::REFERENCE) {
+                const auto& ref = ret.getHeader().getRefCfg();
+                refmgr->validateRefID(ref.getSeqID());
+                std::cerr << "Found ref(compressed) " << ref.getSeqID() << ":[" << ref.getStart() << ", "
+                          << ref.getEnd() << "] ..." << std::endl;
+                refmgr->addRef(refIndex++,
+                               util::make_unique<mgb::Reference>(refmgr->ID2Ref(ref.getSeqID()), ref.getStart(),
+                                                                 ref.getEnd() + 1, importer, pos, false));
+                bitReader.skip(ret.getPayloadSize());
+                return boost::none;
             }
-            case core::parameter::DataUnit::DataUnitType::ACCESS_UNIT: {
-                auto ret = AccessUnit(parameters, bitReader, true);
-                if (getParams(ret.getHeader().getParameterID()).getDatasetType() ==
-                    mgb::AccessUnit::DatasetType::REFERENCE) {
-                    const auto& ref = ret.getHeader().getRefCfg();
-                    refmgr->validateRefID(ref.getSeqID());
-                    std::cerr << "Found ref(compressed) " << ref.getSeqID() << ":[" << ref.getStart() << ", "
-                              << ref.getEnd() << "] ..." << std::endl;
-                    refmgr->addRef(i++,
-                                   util::make_unique<mgb::Reference>(refmgr->ID2Ref(ref.getSeqID()), ref.getStart(),
-                                                                     ref.getEnd() + 1, importer, pos, false));
-                    bitReader.skip(ret.getPayloadSize());
-                } else {
-                    if (!referenceOnly) {
-                        ret.loadPayload(bitReader);
-                        for (auto& b : ret.getBlocks()) {
-                            b.load();
-                            b.parse();
-                        }
-                        UTILS_DIE_IF(ret.getHeader().getClass() == genie::core::record::ClassType::CLASS_HM,
-                                     "Class HM not supported");
-                        ret.debugPrint(parameters.at(ret.getHeader().getParameterID()));
-                        return ret;
-                    } else {
-                        bitReader.skip(ret.getPayloadSize());
-                    }
-                }
-                break;
+            if (referenceOnly || skipPayload) {
+                bitReader.skip(ret.getPayloadSize());
+            } else {
+                loadPayload(ret, bitReader);
             }
-            default: {
-                UTILS_DIE("DataUnitFactory invalid DataUnitType!");
+            if (referenceOnly) {
+                return boost::none;
             }
+            return ret;
         }
-    } while (true);
+        default: {
+            UTILS_DIE("DataUnitFactory invalid DataUnitType!");
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include <map>
 #include "genie/core/parameter/parameter_set.h"
 #include "genie/format/mgb/access_unit.h"
+#include "genie/format/mgb/au-index.h"
 #include "genie/format/mgb/raw_reference.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -33,6 +34,33 @@ class DataUnitFactory {
     core::ReferenceManager* refmgr;                             //!< @brief
     Importer* importer;                                         //!< @brief
     bool referenceOnly;                                         //!< @brief
+    size_t refIndex{0};                                         //!< @brief Next free index in the reference manager
+
+    /**
+     * @brief Read data units until the next data access unit. Parameter sets and references are registered on the way.
+     * @param bitReader Input stream
+     * @param skipPayload Only parse the access unit header and skip the payload
+     * @param offset Set to the stream position of the returned access unit
+     * @return Access unit or none at the end of the stream
+     */
+    boost::optional<AccessUnit> readNext(util::BitReader& bitReader, bool skipPayload, uint64_t& offset);
+
+    /**
+     * @brief Read one data unit. Parameter sets and references are registered, data access units are returned.
+     * @param bitReader Input stream, positioned after the data unit type
+     * @param type Data unit type
+     * @param skipPayload Only parse the access unit header and skip the payload
+     * @return Data access unit or none for all other data units
+     */
+    boost::optional<AccessUnit> readUnit(util::BitReader& bitReader, core::parameter::DataUnit::DataUnitType type,
+                                         bool skipPayload);
+
+    /**
+     * @brief Load and parse the blocks of an access unit whose header was just read
+     * @param au Access unit
+     * @param bitReader Input stream, positioned at the payload
+     */
+    void loadPayload(AccessUnit& au, util::BitReader& bitReader);
 
  public:
     /**
@@ -56,12 +84,40 @@ class DataUnitFactory {
      */
     const std::map<size_t, core::parameter::EncodingSet>& getParams() const;
 
+    /**
+     * @brief
+     * @return True if only references are read and data access units are skipped
+     */
+    bool isReferenceOnly() const;
+
     /**
      * @brief
      * @param bitReader
      * @return
      */
     boost::optional<AccessUnit> read(util::BitReader& bitReader);
+
+    /**
+     * @brief Scan the rest of the stream without loading any access unit payload
+     * @param bitReader Input stream
+     * @return Positions of all data units and header information of the data access units
+     */
+    AUIndex buildIndex(util::BitReader& bitReader);
+
+    /**
+     * @brief Register the parameter sets and references of a stream from its index instead of scanning the stream
+     * @param bitReader Input stream
+     * @param index Index of the stream
+     */
+    void loadIndex(util::BitReader& bitReader, const AUIndex& index);
+
+    /**
+     * @brief Read a data access unit at a known position. Its parameter set must have been read before.
+     * @param bitReader Input stream
+     * @param offset Stream position of the data unit, e.g. from an AUIndex
+     * @return Access unit with loaded payload
+     */
+    AccessUnit readAt(util::BitReader& bitReader, uint64_t offset);
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -6,9 +6,13 @@
 
 #include "genie/format/mgb/exporter.h"
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
 #include <utility>
 #include "genie/format/mgb/raw_reference.h"
+#include "genie/util/make-unique.h"
+#include "genie/util/runtime-exception.h"
 #include "genie/util/watch.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -19,17 +23,21 @@ namespace mgb {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-Exporter::Exporter(std::ostream* _file) : writer(_file), id_ctr(0) {}
+Exporter::Exporter(std::ostream* _file, std::ostream* _index_file)
+    : writer(_file),
+      file(_file),
+      id_ctr(0),
+      buffer([this](SerializedUnit&& t) { write(std::move(t)); }),
+      index_file(_index_file) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 void Exporter::flowIn(core::AccessUnit&& t, const util::Section& id) {
     util::Watch watch;
     core::AccessUnit data = std::move(t);
-    util::OrderedSection section(&lock, id);
-    getStats().add(data.getStats());
-    auto parameter_id = static_cast<uint8_t>(parameter_stash.size());
-    core::parameter::ParameterSet out_set(parameter_id, parameter_id, std::move(data.getParameters()));
+    SerializedUnit unit;
+    unit.stats = std::move(data.getStats());
+
     mgb::RawReference ref;
     for (const auto& p : data.getRefToWrite()) {
         auto string = *data.getReferenceExcerpt().getChunkAt(p.first);
@@ -39,64 +47,138 @@ void Exporter::flowIn(core::AccessUnit&& t, const util::Section& id) {
         ref.addSequence(std::move(refseq));
     }
     if (!ref.isEmpty()) {
+        std::ostringstream messages;
         for (auto& r : ref) {
-            std::cerr << "Writing Ref " << r.getSeqID() << ":" << r.getStart() << "-" << r.getEnd() << "..."
-                      << std::endl;
+            messages << "Writing Ref " << r.getSeqID() << ":" << r.getStart() << "-" << r.getEnd() << "...\n";
+        }
+        unit.messages = messages.str();
+        std::ostringstream stream;
+        {
+            util::BitWriter refWriter(&stream);
+            ref.write(refWriter);
+        }
+        unit.reference = stream.str();
+    }
+
+    if (data.getNumReads() != 0) {
+        // IDs are assigned when the unit is written
+        unit.parameters = util::make_unique<core::parameter::ParameterSet>(0, 0, std::move(data.getParameters()));
+
+        auto datasetType = data.getClassType() != core::record::ClassType::CLASS_U
+                               ? core::parameter::DataUnit::DatasetType::ALIGNED
+                               : (data.isReferenceOnly() ? core::parameter::DataUnit::DatasetType::REFERENCE
+                                                         : core::parameter::DataUnit::DatasetType::NON_ALIGNED);
+
+        unit.au = util::make_unique<mgb::AccessUnit>(0, 0, data.getClassType(), (uint32_t)data.getNumReads(),
+                                                     datasetType, 32, false, core::AlphabetID::ACGTN);
+        auto& au = *unit.au;
+        if (data.isReferenceOnly()) {
+            au.getHeader().setRefCfg(RefCfg(data.getReference(), data.getReferenceExcerpt().getGlobalStart(),
+                                            data.getReferenceExcerpt().getGlobalEnd() - 1, 32));
+        }
+        if (au.getHeader().getClass() != core::record::ClassType::CLASS_U) {
+            au.getHeader().setAuTypeCfg(AuTypeCfg(data.getReference(), data.getMinPos(), data.getMaxPos(),
+                                                  unit.parameters->getEncodingSet().getPosSize()));
+        }
+        for (uint8_t descriptor = 0; descriptor < (uint8_t)core::getDescriptors().size(); ++descriptor) {
+            if (data.get(core::GenDesc(descriptor)).isEmpty()) {
+                continue;
+            }
+            au.addBlock(Block(descriptor, std::move(data.get(core::GenDesc(descriptor)))));
         }
-        ref.write(writer);
-        ref = mgb::RawReference();
+        au.serializeBlocks();
+        unit.description = au.getDescription(unit.parameters->getEncodingSet());
+
+        unit.referenceOnly = data.isReferenceOnly();
+        if (data.getClassType() == core::record::ClassType::CLASS_U) {
+            unit.entry = {0, 0, data.getClassType(), (uint32_t)data.getNumReads(), 0, 0, 0};
+        } else {
+            unit.entry = {0, 0, data.getClassType(), (uint32_t)data.getNumReads(), data.getReference(),
+                          data.getMinPos(), data.getMaxPos()};
+        }
+    }
+    unit.time = watch.check();
+    buffer.deposit(std::move(unit), id);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Exporter::write(SerializedUnit&& t) {
+    util::Watch watch;
+    SerializedUnit unit = std::move(t);
+    getStats().add(unit.stats);
+    if (!unit.reference.empty()) {
+        std::cerr << unit.messages << std::flush;
+        index.addSetupUnit(writer.getBitsWritten() / 8);
+        writer.writeBypass(unit.reference.data(), unit.reference.size());
     }
 
-    if (data.getNumReads() == 0) {
+    if (!unit.au) {
         return;
     }
 
+    auto parameter_id = static_cast<uint8_t>(parameter_stash.size());
     bool found = false;
     for (const auto& p : parameter_stash) {
-        if (out_set == p) {
+        if (*unit.parameters == p) {
             found = true;
             parameter_id = p.getID();
         }
     }
 
     if (!found) {
+        UTILS_DIE_IF(parameter_stash.size() > std::numeric_limits<uint8_t>::max(), "Too many parameter sets");
+        core::parameter::ParameterSet out_set(parameter_id, parameter_id,
+                                              std::move(unit.parameters->getEncodingSet()));
         std::cerr << "Writing PS " << uint32_t(out_set.getID()) << "..." << std::endl;
-        out_set.write(writer);
-        parameter_stash.push_back(out_set);
-    }
-
-    auto datasetType = data.getClassType() != core::record::ClassType::CLASS_U
-                           ? core::parameter::DataUnit::DatasetType::ALIGNED
-                           : (data.isReferenceOnly() ? core::parameter::DataUnit::DatasetType::REFERENCE
-                                                     : core::parameter::DataUnit::DatasetType::NON_ALIGNED);
-
-    mgb::AccessUnit au((uint32_t)id_ctr, parameter_id, data.getClassType(), (uint32_t)data.getNumReads(), datasetType,
-                       32, false, core::AlphabetID::ACGTN);
-    if (data.isReferenceOnly()) {
-        au.getHeader().setRefCfg(RefCfg(data.getReference(), data.getReferenceExcerpt().getGlobalStart(),
-                                        data.getReferenceExcerpt().getGlobalEnd() - 1, 32));
-    }
-    if (au.getHeader().getClass() != core::record::ClassType::CLASS_U) {
-        au.getHeader().setAuTypeCfg(
-            AuTypeCfg(data.getReference(), data.getMinPos(), data.getMaxPos(), data.getParameters().getPosSize()));
-    }
-    for (uint8_t descriptor = 0; descriptor < (uint8_t)core::getDescriptors().size(); ++descriptor) {
-        if (data.get(core::GenDesc(descriptor)).isEmpty()) {
-            continue;
+        std::ostringstream stream;
+        {
+            util::BitWriter unitWriter(&stream);
+            out_set.write(unitWriter);
         }
-        au.addBlock(Block(descriptor, std::move(data.get(core::GenDesc(descriptor)))));
+        index.addParameterSet(writer.getBitsWritten() / 8, stream.str());
+        writer.writeBypass(stream.str().data(), stream.str().size());
+        parameter_stash.push_back(std::move(out_set));
     }
 
-    au.debugPrint(parameter_stash[au.getHeader().getParameterID()].getEncodingSet());
-
+    auto& au = *unit.au;
+    au.getHeader().setID((uint32_t)id_ctr);
+    au.getHeader().setParameterID(parameter_id);
+    std::cerr << "AU " << id_ctr << ": " << unit.description << "..." << std::endl;
+
+    if (unit.referenceOnly) {
+        index.addSetupUnit(writer.getBitsWritten() / 8);
+    } else {
+        unit.entry.offset = writer.getBitsWritten() / 8;
+        unit.entry.parameterID = parameter_id;
+        index.add(unit.entry);
+    }
     au.write(writer);
     id_ctr++;
-    getStats().addDouble("time-mgb-export", watch.check());
+    getStats().addDouble("time-mgb-export", unit.time + watch.check());
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Exporter::skipIn(const genie::util::Section& id) { util::OrderedSection sec(&lock, id); }
+void Exporter::skipIn(const genie::util::Section& id) { buffer.skip(id); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Exporter::flushIn(uint64_t& pos) {
+    buffer.flush();
+    if (index_file) {
+        // The stream must not be modified after the index, which would mark the index as outdated
+        writer.flush();
+        file->flush();
+        index.setStreamSize(writer.getBitsWritten() / 8);
+        {
+            util::BitWriter index_writer(index_file);
+            index.write(index_writer);
+        }
+        index_file->flush();
+    }
+    FormatExporterCompressed::flushIn(pos);
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -10,15 +10,16 @@
 // ---------------------------------------------------------------------------------------------------------------------
 
 #include <memory>
+#include <string>
 #include <vector>
 #include "genie/core/access-unit.h"
 #include "genie/core/format-exporter-compressed.h"
 #include "genie/core/format-exporter.h"
 #include "genie/core/stats/perf-stats.h"
 #include "genie/format/mgb/access_unit.h"
+#include "genie/format/mgb/au-index.h"
 #include "genie/util/drain.h"
-#include "genie/util/ordered-lock.h"
-#include "genie/util/ordered-section.h"
+#include "genie/util/reorder-buffer.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -31,20 +32,47 @@ namespace mgb {
  */
 class Exporter : public core::FormatExporterCompressed {
  private:
+    /**
+     * @brief An access unit already converted to its binary representation, except for the access unit and parameter
+     * set IDs, which depend on the order of the stream
+     */
+    struct SerializedUnit {
+        std::string reference;                                      //!< @brief Raw reference data unit, may be empty
+        std::string messages;                                       //!< @brief Progress output of the reference
+        std::unique_ptr<core::parameter::ParameterSet> parameters;  //!< @brief Null if there are no records
+        std::unique_ptr<AccessUnit> au;                             //!< @brief Blocks serialized, null without records
+        std::string description;                                    //!< @brief Progress output of the access unit
+        bool referenceOnly{false};                                  //!< @brief Indexed as setup unit if set
+        AUIndex::Entry entry{};                                     //!< @brief Offset and parameter set still missing
+        core::stats::PerfStats stats;                               //!< @brief Performance statistics of the unit
+        double time{0};                                             //!< @brief Seconds spent on the conversion
+    };
+
     util::BitWriter writer;                                      //!< @brief
-    util::OrderedLock lock;                                      //!< @brief
+    std::ostream* file;                                          //!< @brief Output stream of the writer
     size_t id_ctr;                                               //!< @brief
     std::vector<core::parameter::ParameterSet> parameter_stash;  //!< @brief
+    util::ReorderBuffer<SerializedUnit> buffer;                  //!< @brief Brings access units in order for writing
+    std::ostream* index_file;                                    //!< @brief Where to write the index, may be null
+    AUIndex index;                                               //!< @brief Positions of all written data units
+
+    /**
+     * @brief Write one access unit and its parameters / reference, assigning the IDs. Called in order by the
+     * reorder buffer.
+     * @param t Serialized access unit
+     */
+    void write(SerializedUnit&& t);
 
  public:
     /**
      * @brief
      * @param _file
+     * @param _index_file If not null, an AUIndex of the written stream is stored here at the end
      */
-    explicit Exporter(std::ostream* _file);
+    explicit Exporter(std::ostream* _file, std::ostream* _index_file = nullptr);
 
     /**
-     * @brief
+     * @brief Serialize an access unit, in parallel with the other ones. Only the stream write is in order.
      * @param t
      * @param id
      */
@@ -55,6 +83,12 @@ class Exporter : public core::FormatExporterCompressed {
      * @param id
      */
     void skipIn(const genie::util::Section& id) override;
+
+    /**
+     * @brief Write the index, all access units have been written at this point
+     * @param pos
+     */
+    void flushIn(uint64_t& pos) override;
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
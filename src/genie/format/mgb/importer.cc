@@ -5,6 +5,8 @@
  */
 
 #include "genie/format/mgb/importer.h"
+#include <algorithm>
+#include <iostream>
 #include <string>
 #include <utility>
 #include "genie/format/mgb/access_unit.h"
@@ -27,13 +29,60 @@ Importer::Importer(std::istream& _file, core::ReferenceManager* manager, core::R
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void Importer::setRegion(const core::LocusFilter& _region) {
+    region = genie::util::make_unique<core::LocusFilter>(_region.getSeqID(), _region.getLocus());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Importer::setIndex(AUIndex&& _index) { index = genie::util::make_unique<AUIndex>(std::move(_index)); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Importer::selectAUs() {
+    if (index) {
+        factory.loadIndex(reader, *index);
+    } else {
+        index = genie::util::make_unique<AUIndex>(factory.buildIndex(reader));
+    }
+    if (factory.isReferenceOnly()) {
+        selectedAUs.clear();
+    } else if (region) {
+        selectedAUs = index->query(*region);
+        std::cerr << "Region " << region->getLocus().toString() << ": " << selectedAUs.size() << " access units"
+                  << std::endl;
+    } else {
+        selectedAUs = index->getEntries();
+    }
+    if (auSelector) {
+        selectedAUs.erase(std::remove_if(selectedAUs.begin(), selectedAUs.end(),
+                                         [this](const AUIndex::Entry& e) {
+                                             return !auSelector(e.auClass, e.seqID, e.startPos, e.endPos);
+                                         }),
+                          selectedAUs.end());
+    }
+    indexed = true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 bool Importer::pump(uint64_t& id, std::mutex&) {
     util::Watch watch;
     boost::optional<mgb::AccessUnit> unit;
     util::Section sec{};
     {
         std::unique_lock<std::mutex> lock_guard(lock);
-        unit = factory.read(reader);
+        if (region || index || auSelector) {
+            if (!indexed) {
+                selectAUs();
+            }
+            if (nextAU == selectedAUs.size()) {
+                return false;
+            }
+            unit = factory.readAt(reader, selectedAUs[nextAU++].offset);
+        } else {
+            unit = factory.read(reader);
+        }
         if (!unit) {
             return false;
         }
@@ -83,7 +132,11 @@ core::AccessUnit Importer::convertAU(mgb::AccessUnit&& au) {
     core::AccessUnit set(std::move(paramset), unit.getHeader().getReadCount());
 
     for (auto& b : unit.getBlocks()) {
-        set.set(core::GenDesc(b.getDescriptorID()), b.movePayload());
+        auto desc = core::GenDesc(b.getDescriptorID());
+        if (std::find(skippedDesc.begin(), skippedDesc.end(), desc) != skippedDesc.end()) {
+            continue;
+        }
+        set.set(desc, b.movePayload());
     }
     if (unit.getHeader().getClass() != core::record::ClassType::CLASS_U) {
         set.setReference(unit.getHeader().getAlignmentInfo().getRefID());
@@ -10,9 +10,12 @@
 // ---------------------------------------------------------------------------------------------------------------------
 
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 #include "genie/core/format-importer-compressed.h"
 #include "genie/core/format-importer.h"
+#include "genie/core/locus-filter.h"
 #include "genie/core/ref-decoder.h"
 #include "genie/core/reference-source.h"
 #include "genie/core/stats/perf-stats.h"
@@ -39,6 +42,18 @@ class Importer : public core::FormatImporterCompressed, public core::ReferenceSo
     core::ReferenceManager* ref_manager;  //!< @brief
     core::RefDecoder* decoder;            //!< @brief
 
+    std::unique_ptr<core::LocusFilter> region;  //!< @brief Region query, only overlapping access units are read
+    std::unique_ptr<AUIndex> index;             //!< @brief Index of the stream, if known before reading
+    bool indexed{false};                        //!< @brief If the access units to read were looked up already
+    std::vector<AUIndex::Entry> selectedAUs;    //!< @brief Access units to read, if an index or a selection is set
+    size_t nextAU{0};                           //!< @brief Next access unit in selectedAUs to read
+
+    /**
+     * @brief Register parameter sets and references from the index (building it first if needed) and select the
+     * access units to read by region and AU selector
+     */
+    void selectAUs();
+
     /**
      * @brief
      * @param au
@@ -56,6 +71,20 @@ class Importer : public core::FormatImporterCompressed, public core::ReferenceSo
      */
     explicit Importer(std::istream& _file, core::ReferenceManager* manager, core::RefDecoder* refd, bool refOnly);
 
+    /**
+     * @brief Only read the access units overlapping a region. Without a stored index, the stream is indexed on the
+     * first call to pump(). The selected access units are read directly from their positions.
+     * @param _region Region, records inside these access units still have to be filtered with the same locus
+     */
+    void setRegion(const core::LocusFilter& _region);
+
+    /**
+     * @brief Use a stored index of the stream. Parameter sets, references and access units are then read from their
+     * indexed positions and the stream is never scanned.
+     * @param _index Index of the stream, must be up to date
+     */
+    void setIndex(AUIndex&& _index);
+
     /**
      * @brief
      * @param id
@@ -5,8 +5,8 @@
  */
 
 #include "genie/format/mgrec/exporter.h"
+#include <sstream>
 #include <utility>
-#include "genie/util/ordered-section.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -16,20 +16,36 @@ namespace mgrec {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-Exporter::Exporter(std::ostream &_file_1) : writer(&_file_1) {}
+Exporter::Exporter(std::ostream &_file_1)
+    : writer(&_file_1), buffer([this](SerializedChunk &&c) {
+          getStats().add(c.stats);
+          writer.writeBypass(c.data.data(), c.data.length());
+      }) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 void Exporter::flowIn(core::record::Chunk &&t, const util::Section &id) {
     core::record::Chunk data = std::move(t);
-    util::OrderedSection section(&lock, id);
-    getStats().add(data.getStats());
+    data.expandColumns();
+    // Serialization runs in parallel, only the copy into the file is ordered
+    std::ostringstream stream;
+    util::BitWriter serializer(&stream);
     for (auto &i : data.getData()) {
-        i.write(writer);
+        i.write(serializer);
     }
+    buffer.deposit({stream.str(), std::move(data.getStats())}, id);
 }
 
-void Exporter::skipIn(const util::Section &id) { util::OrderedSection sec(&lock, id); }
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Exporter::skipIn(const util::Section &id) { buffer.skip(id); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Exporter::flushIn(uint64_t &pos) {
+    buffer.flush();
+    FormatExporter::flushIn(pos);
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
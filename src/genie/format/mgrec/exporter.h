@@ -13,8 +13,9 @@
 #include "genie/core/record/chunk.h"
 #include "genie/core/stats/perf-stats.h"
 #include "genie/util/bitwriter.h"
+#include <string>
 #include "genie/util/drain.h"
-#include "genie/util/ordered-lock.h"
+#include "genie/util/reorder-buffer.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -26,8 +27,16 @@ namespace mgrec {
  * @brief
  */
 class Exporter : public core::FormatExporter {
-    util::BitWriter writer;  //!< @brief
-    util::OrderedLock lock;  //!< @brief
+    /**
+     * @brief A chunk of records already converted to its binary representation
+     */
+    struct SerializedChunk {
+        std::string data;              //!< @brief Binary mgrec records
+        core::stats::PerfStats stats;  //!< @brief Performance statistics of the chunk
+    };
+
+    util::BitWriter writer;                       //!< @brief
+    util::ReorderBuffer<SerializedChunk> buffer;  //!< @brief Brings chunks in order for writing
 
  public:
     /**
@@ -48,6 +57,12 @@ class Exporter : public core::FormatExporter {
      * @param id
      */
     void skipIn(const util::Section& id) override;
+
+    /**
+     * @brief Checks that all chunks were written
+     * @param pos
+     */
+    void flushIn(uint64_t& pos) override;
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
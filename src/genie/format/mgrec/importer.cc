@@ -8,6 +8,7 @@
 #include <iostream>
 #include <string>
 #include <utility>
+#include "genie/core/record/alignment_external/other-rec.h"
 #include "genie/util/ordered-section.h"
 #include "genie/util/watch.h"
 
@@ -23,7 +24,6 @@ Importer::Importer(size_t _blockSize, std::istream& _file_1, std::ostream& _unsu
     : blockSize(_blockSize),
       reader(_file_1),
       writer(&_unsupported),
-      bufferedRecord(boost::none),
       checkSupport(_checkSupport) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -77,41 +77,83 @@ bool Importer::isRecordSupported(const core::record::Record& rec) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-bool Importer::pumpRetrieve(core::Classifier* _classifier) {
+bool Importer::isColumnar(const core::record::ReadColumns& columns) const {
+    // Unaligned, complete records without read group and at most one quality value string
+    return header.classID == core::record::ClassType::CLASS_U && header.numberOfAlignments == 0 &&
+           header.readGroupLength == 0 && header.qvDepth <= 1 &&
+           header.readLengths.size() == header.numberOfTemplateSegments &&
+           (columns.empty() || columns.getNumberOfTemplateSegments() == header.numberOfTemplateSegments);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Importer::readColumnar(core::record::ReadColumns& columns) {
+    auto nameLength = reader.readBypassBE<uint8_t>();
+    if (columns.empty()) {
+        // Reserve the block assuming all records look like the first one
+        size_t bases = 0;
+        for (auto l : header.readLengths) {
+            bases += l;
+        }
+        columns.setNumberOfTemplateSegments(header.numberOfTemplateSegments);
+        columns.reserve(blockSize, bases * blockSize, nameLength * blockSize);
+    }
+    reader.readBypass(columns.addRecord(nameLength), nameLength);
+    for (auto l : header.readLengths) {
+        reader.readBypass(columns.addSequence(l), l);
+        if (header.qvDepth) {
+            reader.readBypass(columns.addQualities(l), l);
+        }
+    }
+    columns.setFlags(reader.readBypassBE<uint8_t>());
+
+    // Links to other records are not encoded for unaligned reads
+    if (reader.readBypassBE<core::record::AlignmentExternal::Type>() ==
+        core::record::AlignmentExternal::Type::OTHER_REC) {
+        core::record::alignment_external::OtherRec skipped(reader);
+    }
+    UTILS_DIE_IF(!reader.isGood(), "Unexpected end of file in record");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool Importer::pumpRetrieve(core::record::Chunk* _chunk) {
     util::Watch watch;
     core::record::Chunk chunk;
     bool seqid_valid = false;
     for (size_t i = 0; i < blockSize; ++i) {
-        if (bufferedRecord) {
-            chunk.setRefID(bufferedRecord->getAlignmentSharedData().getSeqID());
-            seqid_valid = true;
-            if (isRecordSupported(bufferedRecord.get())) {
-                chunk.getData().emplace_back(std::move(bufferedRecord.get()));
-            } else {
-                bufferedRecord.get().write(writer);
+        if (!headerBuffered) {
+            header.read(reader);
+            if (!reader.isGood()) {
+                break;
             }
-            bufferedRecord = boost::none;
-            continue;
-        }
-        core::record::Record rec(reader);
-        if (!reader.isGood()) {
-            break;
         }
+        headerBuffered = false;
 
         if (!seqid_valid) {
-            chunk.setRefID(rec.getAlignmentSharedData().getSeqID());
+            chunk.setRefID(header.sharedAlignmentInfo.getSeqID());
             seqid_valid = true;
         }
 
-        if (chunk.getRefID() != rec.getAlignmentSharedData().getSeqID()) {
-            bufferedRecord = std::move(rec);
+        if (chunk.getRefID() != header.sharedAlignmentInfo.getSeqID()) {
+            headerBuffered = true;
+            break;
+        }
+
+        // Common unaligned records go straight into the columns without building a record
+        if (isColumnar(chunk.getColumns())) {
+            readColumnar(chunk.getColumns());
+            continue;
+        }
+
+        core::record::Record rec(header, reader);
+        if (!reader.isGood()) {
             break;
+        }
+        if (isRecordSupported(rec)) {
+            chunk.getData().emplace_back(std::move(rec));
         } else {
-            if (isRecordSupported(rec)) {
-                chunk.getData().emplace_back(std::move(rec));
-            } else {
-                rec.write(writer);
-            }
+            rec.write(writer);
         }
     }
 
@@ -119,8 +161,8 @@ bool Importer::pumpRetrieve(core::Classifier* _classifier) {
     for (const auto& c : chunk.getData()) {
         missing_additional_alignments += c.getAlignments().empty() ? 0 : c.getAlignments().size() - 1;
     }
-    _classifier->add(std::move(chunk));
-    return reader.isGood() || bufferedRecord;
+    *_chunk = std::move(chunk);
+    return reader.isGood() || headerBuffered;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -39,11 +39,25 @@ class Importer : public core::FormatImporter {
     size_t discarded_missing_pair_U{};       //!< @brief
     size_t missing_additional_alignments{};  //!< @brief
 
-    boost::optional<core::record::Record> bufferedRecord;  //!< @brief
-    bool checkSupport;                                     //!< @brief
+    core::record::Record::Header header;  //!< @brief Header of the current record
+    bool headerBuffered{false};           //!< @brief If header belongs to a record not yet read, for the next block
+    bool checkSupport;                    //!< @brief
 
     bool isRecordSupported(const core::record::Record& rec);  //!< @brief
 
+    /**
+     * @brief
+     * @param columns Columns of the current block
+     * @return True if the record of the current header can be stored in the columns
+     */
+    bool isColumnar(const core::record::ReadColumns& columns) const;
+
+    /**
+     * @brief Read the rest of the current record into columns
+     * @param columns Columns of the current block
+     */
+    void readColumnar(core::record::ReadColumns& columns);
+
  public:
     /**
      * @brief
@@ -56,10 +70,10 @@ class Importer : public core::FormatImporter {
 
     /**
      * @brief
-     * @param _classifier
+     * @param _chunk Output block of records
      * @return
      */
-    bool pumpRetrieve(core::Classifier* _classifier) override;
+    bool pumpRetrieve(core::record::Chunk* _chunk) override;
 
     /**
      * @brief
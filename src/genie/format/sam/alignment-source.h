@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_FORMAT_SAM_ALIGNMENT_SOURCE_H_
+#define SRC_GENIE_FORMAT_SAM_ALIGNMENT_SOURCE_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "genie/core/record/record.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace format {
+namespace sam {
+
+/**
+ * @brief Location of one alignment in a coordinate sorted alignment file
+ */
+struct Alignment {
+    std::string qname;       //!< @brief Read name
+    int64_t rid{-1};         //!< @brief Reference ID in the file header, negative if unmapped
+    uint64_t pos{0};         //!< @brief Position on the reference
+    int64_t mrid{-1};        //!< @brief Reference ID of the next mate, negative if unmapped
+    uint64_t mpos{0};        //!< @brief Position of the next mate
+    bool paired{false};      //!< @brief If the read has more than one segment
+    bool additional{false};  //!< @brief Secondary or supplementary alignment
+};
+
+/**
+ * @brief Reads the alignments of a coordinate sorted file and converts them to MPEG-G records. The alignments of a
+ * read are kept by the source until the importer asks to convert them.
+ */
+class AlignmentSource {
+ public:
+    /**
+     * @brief Read the next alignment
+     * @param alignment Location of the alignment
+     * @return False at the end of the input
+     */
+    virtual bool read(Alignment* alignment) = 0;
+
+    /**
+     * @brief Keep the alignment read last with the other alignments of its read
+     */
+    virtual void keep() = 0;
+
+    /**
+     * @brief Convert the kept alignments of a read and forget them
+     * @param qname Read name
+     * @param records Output, converted records with the reference IDs of the file header
+     */
+    virtual void convert(const std::string& qname, std::vector<core::record::Record>* records) = 0;
+
+    /**
+     * @brief Prepare a record in output order for the encoder
+     * @param record Record, its reference ID is patched to the reference used for encoding
+     * @return False if the record is not supported and has to be removed
+     */
+    virtual bool finish(core::record::Record* record) = 0;
+
+    /**
+     * @brief Print what was changed or removed during conversion
+     */
+    virtual void printStats() const = 0;
+
+    /**
+     * @brief
+     */
+    virtual ~AlignmentSource() = default;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace sam
+}  // namespace format
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_FORMAT_SAM_ALIGNMENT_SOURCE_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
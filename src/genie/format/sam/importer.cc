@@ -0,0 +1,207 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/format/sam/importer.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include "genie/util/runtime-exception.h"
+#include "genie/util/watch.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace format {
+namespace sam {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+constexpr uint64_t Importer::MAX_MATE_DISTANCE;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Heap order, the record with the earliest position on top
+ * @param a First record
+ * @param b Second record
+ * @return True if a comes after b
+ */
+static bool later(const core::record::Record& a, const core::record::Record& b) {
+    return Importer::recordKey(a) > Importer::recordKey(b);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t Importer::positionKey(int64_t rid, uint64_t pos) {
+    if (rid < 0) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return (static_cast<uint64_t>(rid) << 32) | pos;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t Importer::recordKey(const core::record::Record& rec) {
+    if (rec.getAlignments().empty()) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return positionKey(rec.getAlignmentSharedData().getSeqID(), rec.getAlignments().front().getPosition());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+Importer::Importer(size_t _blockSize, std::unique_ptr<AlignmentSource> _source)
+    : blockSize(_blockSize), source(std::move(_source)) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Importer::convertRead(const std::string& qname) {
+    std::vector<core::record::Record> converted;
+    source->convert(qname, &converted);
+    for (auto& c : converted) {
+        heap.push_back(std::move(c));
+        std::push_heap(heap.begin(), heap.end(), later);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Importer::readAlignment() {
+    Alignment rec;
+    if (!source->read(&rec)) {
+        eof = true;
+        for (auto& p : pending) {
+            convertRead(p.first);
+        }
+        pending.clear();
+        pendingStarts.clear();
+        pendingMates.clear();
+        return;
+    }
+
+    const auto key = positionKey(rec.rid, rec.pos);
+    UTILS_DIE_IF(key < inputPosition, "Sam file is not ordered by coordinate at read " + rec.qname);
+    inputPosition = key;
+
+    // Reads whose mate should have been read by now have none in this file
+    while (!pendingMates.empty() && pendingMates.begin()->first < inputPosition) {
+        auto it = pending.find(pendingMates.begin()->second);
+        pendingStarts.erase(it->second.start);
+        pendingMates.erase(pendingMates.begin());
+        convertRead(it->first);
+        pending.erase(it);
+    }
+
+    // Additional alignments are removed during conversion anyway
+    if (rec.additional) {
+        removed_secondary++;
+        return;
+    }
+
+    source->keep();
+    auto it = pending.find(rec.qname);
+    if (it == pending.end()) {
+        const auto mateKey = positionKey(rec.mrid, rec.mpos);
+        if (!rec.paired || rec.mrid != rec.rid || mateKey < key || mateKey - key > MAX_MATE_DISTANCE) {
+            convertRead(rec.qname);
+            return;
+        }
+        auto start = pendingStarts.emplace(key, rec.qname);
+        auto mate = pendingMates.emplace(mateKey, rec.qname);
+        pending.emplace(rec.qname, PendingRead{start, mate});
+        return;
+    }
+
+    pendingStarts.erase(it->second.start);
+    pendingMates.erase(it->second.mate);
+    convertRead(it->first);
+    pending.erase(it);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Importer::release() {
+    const auto MAX_KEY = std::numeric_limits<uint64_t>::max();
+    auto bound = inputPosition;
+    if (!pendingStarts.empty()) {
+        bound = std::min(bound, pendingStarts.begin()->first);
+    }
+    if (eof) {
+        bound = MAX_KEY;
+    }
+    while (!heap.empty()) {
+        // Unmapped records are not ordered, they can leave once the input reached them
+        const auto key = recordKey(heap.front());
+        if (key >= bound && !(key == MAX_KEY && bound == MAX_KEY)) {
+            break;
+        }
+        std::pop_heap(heap.begin(), heap.end(), later);
+        auto rec = std::move(heap.back());
+        heap.pop_back();
+
+        if (source->finish(&rec)) {
+            sorted.push_back(std::move(rec));
+        } else {
+            removed_unsupported++;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool Importer::pumpRetrieve(core::record::Chunk* _chunk) {
+    util::Watch watch;
+    while (!eof && sorted.size() < blockSize) {
+        readAlignment();
+        release();
+    }
+
+    core::record::Chunk chunk;
+    bool seqid_valid = false;
+    while (!sorted.empty() && chunk.getData().size() < blockSize) {
+        const auto seqID = sorted.front().getAlignmentSharedData().getSeqID();
+        if (!seqid_valid) {
+            chunk.setRefID(seqID);
+            seqid_valid = true;
+        }
+        if (chunk.getRefID() != seqID) {
+            break;
+        }
+        chunk.getData().push_back(std::move(sorted.front()));
+        sorted.pop_front();
+    }
+
+    chunk.getStats().addDouble("time-sam-import", watch.check());
+    *_chunk = std::move(chunk);
+    return !eof || !sorted.empty();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Importer::printStats() const {
+    source->printStats();
+    std::cerr << "Secondary and supplementary alignments removed: " << removed_secondary << std::endl;
+    std::cerr << removed_unsupported << " records removed because of unsupported bases." << std::endl;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Importer::flushIn(uint64_t& pos) {
+    FormatImporter::flushIn(pos);
+    printStats();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace sam
+}  // namespace format
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
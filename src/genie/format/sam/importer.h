@@ -0,0 +1,132 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_FORMAT_SAM_IMPORTER_H_
+#define SRC_GENIE_FORMAT_SAM_IMPORTER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "genie/core/format-importer.h"
+#include "genie/core/record/record.h"
+#include "genie/format/sam/alignment-source.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace format {
+namespace sam {
+
+/**
+ * @brief Imports coordinate sorted SAM, BAM or CRAM files directly into the encoder, without writing an mgrec file.
+ *
+ * Alignments of a read are collected until all of its primary alignments are read, then converted by the source.
+ * The converted records are sorted by position in a heap and released as soon as no record with an earlier position
+ * can follow: no read still waiting for a mate started earlier and the input is past them. Only mates close enough
+ * to stay in one record are waited for, so the heap covers a window of about a read pair.
+ */
+class Importer : public core::FormatImporter {
+ private:
+    /**
+     * @brief Entries of a read whose mates are not all read yet
+     */
+    struct PendingRead {
+        std::multimap<uint64_t, std::string>::iterator start;  //!< @brief Entry in pendingStarts
+        std::multimap<uint64_t, std::string>::iterator mate;   //!< @brief Entry in pendingMates
+    };
+
+    size_t blockSize;                                      //!< @brief Records per chunk
+    std::unique_ptr<AlignmentSource> source;               //!< @brief Input
+    std::unordered_map<std::string, PendingRead> pending;  //!< @brief Reads waiting for a mate, by name
+    std::multimap<uint64_t, std::string> pendingStarts;    //!< @brief First alignment position of each waiting read
+    std::multimap<uint64_t, std::string> pendingMates;     //!< @brief Expected mate position of each waiting read
+    std::vector<core::record::Record> heap;                //!< @brief Converted records, earliest on top
+    std::deque<core::record::Record> sorted;               //!< @brief Records released in order
+    uint64_t inputPosition{0};                             //!< @brief Position of the last alignment read
+    bool eof{false};                                       //!< @brief If the input is exhausted
+    size_t removed_secondary{0};                           //!< @brief Secondary and supplementary alignments removed
+    size_t removed_unsupported{0};                         //!< @brief Records the source could not finish
+
+    /**
+     * @brief Read one alignment and convert its read if all mates are there
+     */
+    void readAlignment();
+
+    /**
+     * @brief Convert the alignments of one read and add the records to the heap
+     * @param qname Read name
+     */
+    void convertRead(const std::string& qname);
+
+    /**
+     * @brief Move all records that can not be preceded by records still to come from the heap to the sorted records
+     */
+    void release();
+
+ public:
+    /**
+     * @brief Mates further apart are split into separate records during conversion, so they are not waited for
+     */
+    static constexpr uint64_t MAX_MATE_DISTANCE = 32767;
+
+    /**
+     * @brief
+     * @param rid Reference ID in the file header, negative if unmapped
+     * @param pos Position
+     * @return Sort key, unmapped last
+     */
+    static uint64_t positionKey(int64_t rid, uint64_t pos);
+
+    /**
+     * @brief
+     * @param rec Converted record, reference ID not patched yet
+     * @return Sort key
+     */
+    static uint64_t recordKey(const core::record::Record& rec);
+
+    /**
+     * @brief
+     * @param _blockSize Records per chunk
+     * @param _source Alignments of a coordinate sorted file
+     */
+    Importer(size_t _blockSize, std::unique_ptr<AlignmentSource> _source);
+
+    /**
+     * @brief
+     * @param _chunk Output block of records
+     * @return
+     */
+    bool pumpRetrieve(core::record::Chunk* _chunk) override;
+
+    /**
+     * @brief
+     */
+    void printStats() const;
+
+    /**
+     * @brief
+     * @param pos
+     */
+    void flushIn(uint64_t& pos) override;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace sam
+}  // namespace format
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_FORMAT_SAM_IMPORTER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -37,8 +37,9 @@ namespace module {
 std::unique_ptr<core::FlowGraphEncode> buildDefaultEncoder(size_t threads, const std::string& working_dir,
                                                            size_t blocksize,
                                                            core::ClassifierRegroup::RefMode externalref, bool rawref,
-                                                           bool writeRawStreams) {
-    std::unique_ptr<core::FlowGraphEncode> ret = genie::util::make_unique<core::FlowGraphEncode>(threads);
+                                                           bool writeRawStreams, uint64_t refCacheBytes) {
+    std::unique_ptr<core::FlowGraphEncode> ret =
+        genie::util::make_unique<core::FlowGraphEncode>(threads, refCacheBytes);
 
     ret->setClassifier(
         genie::util::make_unique<genie::core::ClassifierRegroup>(blocksize, &ret->getRefMgr(), externalref, rawref));
@@ -51,6 +52,9 @@ std::unique_ptr<core::FlowGraphEncode> buildDefaultEncoder(size_t threads, const
     ret->addReadCoder(
         genie::util::make_unique<genie::read::spring::Encoder>(working_dir, threads, true, writeRawStreams));
     ret->setReadCoderSelector([](const genie::core::record::Chunk& chunk) -> size_t {
+        if (!chunk.getColumns().empty()) {
+            return chunk.getColumns().getNumberOfTemplateSegments() > 1 ? 4 : 3;
+        }
         if (chunk.getData().empty()) {
             return 2;
         }
@@ -80,7 +84,8 @@ std::unique_ptr<core::FlowGraphEncode> buildDefaultEncoder(size_t threads, const
     ret->setNameSelector([](const genie::core::record::Chunk&) -> size_t { return 0; });
 
     ret->addEntropyCoder(genie::util::make_unique<genie::entropy::gabac::Encoder>(writeRawStreams));
-    ret->setEntropyCoderSelector([](const genie::core::AccessUnit::Descriptor&) -> size_t { return 0; });
+    ret->setEntropyCoderSelector(
+        [](const genie::core::AccessUnit::Descriptor&, const genie::util::Section&) -> size_t { return 0; });
 
     ret->setExporterSelector([](const genie::core::AccessUnit&) -> size_t { return 0; });
 
@@ -90,12 +95,19 @@ std::unique_ptr<core::FlowGraphEncode> buildDefaultEncoder(size_t threads, const
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::unique_ptr<core::FlowGraphDecode> buildDefaultDecoder(size_t threads, const std::string& working_dir,
-                                                           bool combinePairsFlag, size_t) {
-    std::unique_ptr<core::FlowGraphDecode> ret = genie::util::make_unique<core::FlowGraphDecode>(threads);
-
-    ret->addReadCoder(genie::util::make_unique<genie::read::refcoder::Decoder>());
-    ret->addReadCoder(genie::util::make_unique<genie::read::localassembly::Decoder>());
+                                                           bool combinePairsFlag, size_t, uint64_t refCacheBytes) {
+    std::unique_ptr<core::FlowGraphDecode> ret =
+        genie::util::make_unique<core::FlowGraphDecode>(threads, refCacheBytes);
+
+    // With more than one thread, entropy decoding of the next access unit overlaps with record reconstruction
+    auto refd = genie::util::make_unique<genie::read::refcoder::Decoder>();
+    refd->setDecodeAhead(threads > 1);
+    ret->addReadCoder(std::move(refd));
+    auto lad = genie::util::make_unique<genie::read::localassembly::Decoder>();
+    lad->setDecodeAhead(threads > 1);
+    ret->addReadCoder(std::move(lad));
     auto lld = genie::util::make_unique<genie::read::lowlatency::Decoder>();
+    lld->setDecodeAhead(threads > 1);
     ret->setRefDecoder(lld.get());
     ret->addReadCoder(std::move(lld));
     ret->addReadCoder(genie::util::make_unique<genie::read::spring::Decoder>(working_dir, combinePairsFlag, false));
@@ -28,20 +28,23 @@ namespace module {
  * @param externalref
  * @param rawref
  * @param writeRawStreams
+ * @param refCacheBytes Memory budget of the reference chunk cache
  * @return
  */
-std::unique_ptr<core::FlowGraphEncode> buildDefaultEncoder(size_t threads, const std::string& working_dir, size_t,
-                                                           core::ClassifierRegroup::RefMode externalref, bool rawref,
-                                                           bool writeRawStreams);
+std::unique_ptr<core::FlowGraphEncode> buildDefaultEncoder(
+    size_t threads, const std::string& working_dir, size_t, core::ClassifierRegroup::RefMode externalref, bool rawref,
+    bool writeRawStreams, uint64_t refCacheBytes = core::ReferenceManager::DEFAULT_CACHE_SIZE);
 
 /**
  * @brief
  * @param threads
  * @param combinePairsFlag
+ * @param refCacheBytes Memory budget of the reference chunk cache
  * @return
  */
-std::unique_ptr<core::FlowGraphDecode> buildDefaultDecoder(size_t threads, const std::string&, bool combinePairsFlag,
-                                                           size_t);
+std::unique_ptr<core::FlowGraphDecode> buildDefaultDecoder(
+    size_t threads, const std::string&, bool combinePairsFlag, size_t,
+    uint64_t refCacheBytes = core::ReferenceManager::DEFAULT_CACHE_SIZE);
 
 /**
  * @brief
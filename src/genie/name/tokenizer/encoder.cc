@@ -5,7 +5,9 @@
  */
 
 #include "genie/name/tokenizer/encoder.h"
+#include <string>
 #include <tuple>
+#include <vector>
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -21,6 +23,15 @@ std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> Encoder::proces
         std::make_tuple(core::AccessUnit::Descriptor(core::GenDesc::RNAME), core::stats::PerfStats());
     std::vector<SingleToken> old;
 
+    std::string name;
+    for (size_t i = 0; i < recs.getColumns().size(); ++i) {
+        auto view = recs.getColumns().getName(i);
+        name.assign(view.begin(), view.length());
+        TokenState state(old, name);
+        auto newTok = state.run();
+        TokenState::encode(newTok, std::get<0>(ret));
+        old = patch(old, newTok);
+    }
     for (const auto& r : recs.getData()) {
         TokenState state(old, r.getName());
         auto newTok = state.run();
@@ -171,6 +171,12 @@ void Encoder::encodeUnaligned(const core::record::Chunk& chunk, paramqv1::Qualit
     desc.add(core::AccessUnit::Subsequence(1, core::GenSub::QV_STEPS_0));
 
     // encode values
+    auto& subsequence = desc.get((uint16_t)desc.getSize() - 1);
+    for (size_t s = 0; s < chunk.getColumns().getNumberOfSegments(); ++s) {
+        for (auto c : chunk.getColumns().getQualities(s)) {
+            subsequence.push(static_cast<uint8_t>(quantizer.valueToIndex(c)));
+        }
+    }
     for (const auto& rec : chunk.getData()) {
         for (const auto& seg : rec.getSegments()) {
             addQualities(seg, desc, quantizer);
@@ -185,9 +191,7 @@ core::QVEncoder::QVCoded Encoder::process(const core::record::Chunk& chunk) {
     auto param = util::make_unique<paramqv1::QualityValues1>(paramqv1::QualityValues1::QvpsPresetId::ASCII, false);
     core::AccessUnit::Descriptor desc(core::GenDesc::QV);
 
-    const ClassType& classType = chunk.getData()[0].getClassID();
-
-    if (classType == ClassType::CLASS_U) {
+    if (!chunk.getColumns().empty() || chunk.getData()[0].getClassID() == ClassType::CLASS_U) {
         encodeUnaligned(chunk, *param, desc);
     } else {
         encodeAligned(chunk, *param, desc);
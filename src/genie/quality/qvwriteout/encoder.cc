@@ -28,8 +28,8 @@ void Encoder::setUpParameters(const core::record::Chunk& rec, paramqv1::QualityV
     desc.add(core::AccessUnit::Subsequence(1, core::GenSub::QV_PRESENT));
     desc.add(core::AccessUnit::Subsequence(1, core::GenSub::QV_CODEBOOK));
     desc.add(core::AccessUnit::Subsequence(1, core::GenSub::QV_STEPS_0));
-    if (rec.getData().front().getClassID() == core::record::ClassType::CLASS_I ||
-        rec.getData().front().getClassID() == core::record::ClassType::CLASS_HM) {
+    if (!rec.getData().empty() && (rec.getData().front().getClassID() == core::record::ClassType::CLASS_I ||
+                                   rec.getData().front().getClassID() == core::record::ClassType::CLASS_HM)) {
         desc.add(core::AccessUnit::Subsequence(1, core::GenSub::QV_STEPS_1));
 
         codebook = paramqv1::QualityValues1::getPresetCodebook(paramqv1::QualityValues1::QvpsPresetId::ASCII);
@@ -52,10 +52,7 @@ void Encoder::encodeAlignedSegment(const core::record::Segment& s, const std::st
                                            core::getAlphabetProperties(core::AlphabetID::ACGTN).isIncluded(cigar)
                                        ? 2
                                        : (uint8_t)desc.getSize() - 1;
-                for (const auto& c : qvs) {
-                    UTILS_DIE_IF(c < 33 || c > 126, "Invalid quality score");
-                    desc.get(codebook).push(c - 33);
-                }
+                pushQualities(qvs, desc.get(codebook));
                 return true;
             });
     }
@@ -65,11 +62,26 @@ void Encoder::encodeAlignedSegment(const core::record::Segment& s, const std::st
 
 void Encoder::encodeUnalignedSegment(const core::record::Segment& s, core::AccessUnit::Descriptor& desc) {
     for (const auto& q : s.getQualities()) {
-        for (const auto& c : q) {
-            UTILS_DIE_IF(c < 33 || c > 126, "Invalid quality score");
-            desc.get((uint16_t)desc.getSize() - 1).push(c - 33);
-        }
+        encodeUnalignedSegment(util::StringView(0, q.length(), q.data()), desc);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Encoder::encodeUnalignedSegment(const util::StringView& qualities, core::AccessUnit::Descriptor& desc) {
+    pushQualities(qualities, desc.get((uint16_t)desc.getSize() - 1));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Encoder::pushQualities(const util::StringView& qualities, core::AccessUnit::Subsequence& subseq) {
+    // No early exit, so that the check vectorizes
+    bool valid = true;
+    for (auto c : qualities) {
+        valid &= c >= 33 && c <= 126;
     }
+    UTILS_DIE_IF(!valid, "Invalid quality score");
+    subseq.push(qualities.begin(), qualities.end(), [](char c) { return c - 33; });
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -81,6 +93,10 @@ core::QVEncoder::QVCoded Encoder::process(const core::record::Chunk& rec) {
 
     setUpParameters(rec, *param, desc);
 
+    for (size_t s = 0; s < rec.getColumns().getNumberOfSegments(); ++s) {
+        encodeUnalignedSegment(rec.getColumns().getQualities(s), desc);
+    }
+
     for (const auto& r : rec.getData()) {
         auto& s_first = r.getSegments()[0];
 
@@ -51,6 +51,20 @@ class Encoder : public core::QVEncoder {
      */
     static void encodeUnalignedSegment(const core::record::Segment& s, core::AccessUnit::Descriptor& desc);
 
+    /**
+     * @brief
+     * @param qualities Quality values of one unaligned segment
+     * @param desc
+     */
+    static void encodeUnalignedSegment(const util::StringView& qualities, core::AccessUnit::Descriptor& desc);
+
+    /**
+     * @brief Check a run of ASCII quality values and append them to a subsequence in one pass
+     * @param qualities Quality values
+     * @param subseq Subsequence of the codebook
+     */
+    static void pushQualities(const util::StringView& qualities, core::AccessUnit::Subsequence& subseq);
+
  public:
     /**
      * @brief
@@ -120,9 +120,12 @@ void DecoderStub::addECigar(const core::record::Record& rec, std::vector<std::st
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void DecoderStub::flowIn(core::AccessUnit&& t, const util::Section& id) {
+void DecoderStub::flowIn(core::AccessUnit&& t, const util::Section& id) { decodeAhead(std::move(t), id); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void DecoderStub::decodeRecords(core::AccessUnit&& t, const util::Section& id) {
     auto t_data = std::move(t);
-    t_data = entropyCodeAU(std::move(t_data), true);
     auto state = createDecodingState(t_data);
     auto chunk = decodeSequences(*state, t_data);
     decodeQualities(*state, chunk);
@@ -103,6 +103,13 @@ class DecoderStub : public core::ReadDecoder {
      */
     virtual void recordDecodedHook(DecodingState&, const core::record::Record&) {}
 
+    /**
+     * @brief Decode the records of an entropy decoded access unit
+     * @param t Access unit
+     * @param id Section
+     */
+    void decodeRecords(core::AccessUnit&& t, const util::Section& id) override;
+
  public:
     /**
      * @brief
@@ -7,6 +7,7 @@
 #include "genie/read/basecoder/encoderstub.h"
 #include <string>
 #include <utility>
+#include "genie/util/task-scheduler.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -104,19 +105,21 @@ void EncoderStub::removeRedundantDescriptors(core::AccessUnit& rawAU) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-core::QVEncoder::QVCoded EncoderStub::encodeQVs(QvSelector* qvcoder, core::record::Chunk& data) {
+core::QVEncoder::QVCoded EncoderStub::encodeQVs(QvSelector* qvcoder, const core::record::Chunk& data,
+                                                core::stats::PerfStats& stats) {
     util::Watch watch;
     auto qv = qvcoder->process(data);
-    data.getStats().addDouble("time-quality", watch.check());
+    stats.addDouble("time-quality", watch.check());
     return qv;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-core::AccessUnit::Descriptor EncoderStub::encodeNames(NameSelector* namecoder, core::record::Chunk& data) {
+core::AccessUnit::Descriptor EncoderStub::encodeNames(NameSelector* namecoder, const core::record::Chunk& data,
+                                                      core::stats::PerfStats& stats) {
     util::Watch watch;
     auto name = namecoder->process(data);
-    data.getStats().addDouble("time-name", watch.check());
+    stats.addDouble("time-name", watch.check());
     return std::get<0>(name);
 }
 
@@ -127,20 +130,31 @@ void EncoderStub::flowIn(core::record::Chunk&& t, const util::Section& id) {
 
     // Empty block: do nothing
     if (data.getData().empty()) {
+        skipEntropyCoding(id);
         skipOut(id);
         return;
     }
 
-    auto qv = encodeQVs(qvcoder, data);
-    auto rname = encodeNames(namecoder, data);
-
+    // Quality values and names only read the chunk, so idle threads may steal them while the sequences are coded
+    core::QVEncoder::QVCoded qv;
+    core::AccessUnit::Descriptor rname;
+    core::stats::PerfStats qvStats;
+    core::stats::PerfStats nameStats;
     auto state = createState(data);
-    encodeSeq(data, *state);
+    {
+        util::TaskGroup group;
+        group.run([&]() { qv = encodeQVs(qvcoder, data, qvStats); });
+        group.run([&]() { rname = encodeNames(namecoder, data, nameStats); });
+        encodeSeq(data, *state);
+        group.wait();
+    }
+    data.getStats().add(qvStats);
+    data.getStats().add(nameStats);
 
     auto rawAU = pack(id.start, std::move(qv), std::move(rname), *state);
     rawAU.setStats(std::move(data.getStats()));
     data.getData().clear();
-    rawAU = entropyCodeAU(std::move(rawAU));
+    rawAU = entropyCodeAU(std::move(rawAU), id);
     flowOut(std::move(rawAU), id);
 }
 
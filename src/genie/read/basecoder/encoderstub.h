@@ -92,17 +92,21 @@ class EncoderStub : public core::ReadEncoder {
      * @brief Encode all quality values in a chunk of data
      * @param qvcoder QV encoder
      * @param data Chunk of data
+     * @param stats Receives the coding time
      * @return Encoded quality values
      */
-    static core::QVEncoder::QVCoded encodeQVs(QvSelector* qvcoder, core::record::Chunk& data);
+    static core::QVEncoder::QVCoded encodeQVs(QvSelector* qvcoder, const core::record::Chunk& data,
+                                              core::stats::PerfStats& stats);
 
     /**
      * @brief Encode read names in a chunk of data
      * @param namecoder Name encoder
      * @param data Chunk to encode
+     * @param stats Receives the coding time
      * @return Encoded read names
      */
-    static core::AccessUnit::Descriptor encodeNames(NameSelector* namecoder, core::record::Chunk& data);
+    static core::AccessUnit::Descriptor encodeNames(NameSelector* namecoder, const core::record::Chunk& data,
+                                                    core::stats::PerfStats& stats);
 
  public:
     /**
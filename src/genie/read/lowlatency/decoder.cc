@@ -25,7 +25,6 @@ core::record::Chunk Decoder::decode_common(core::AccessUnit&& t) {
     util::Watch watch;
     core::record::Chunk ret;
     core::AccessUnit data = std::move(t);
-    data = entropyCodeAU(std::move(data), true);
     const auto& qvparam = data.getParameters().getQVConfig(data.getClassType());
     auto qvStream = std::move(data.get(core::GenDesc::QV));
     auto names = namecoder->process(data.get(core::GenDesc::RNAME));
@@ -61,9 +60,8 @@ core::record::Chunk Decoder::decode_common(core::AccessUnit&& t) {
                 length = data.pull(core::GenSub::RLEN) + 1;
             }
             std::string seq(length, '\0');
-            for (auto& c : seq) {
-                c = core::getAlphabetProperties(core::AlphabetID::ACGTN).lut[data.pull(core::GenSub::UREADS)];
-            }
+            const auto& lut = core::getAlphabetProperties(core::AlphabetID::ACGTN).lut;
+            data.get(core::GenSub::UREADS).pull(&seq[0], &seq[0] + length, [&lut](uint64_t v) { return lut[v]; });
 
             core::record::Segment seg(std::move(seq));
             //     seg.addQualities(qvdecoder->process(data.getParameters().getQVConfig(core::record::ClassType::CLASS_U),
@@ -104,12 +102,16 @@ core::record::Chunk Decoder::decode_common(core::AccessUnit&& t) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Decoder::flowIn(core::AccessUnit&& t, const util::Section& id) { flowOut(decode_common(std::move(t)), id); }
+void Decoder::flowIn(core::AccessUnit&& t, const util::Section& id) { decodeAhead(std::move(t), id); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Decoder::decodeRecords(core::AccessUnit&& t, const util::Section& id) { flowOut(decode_common(std::move(t)), id); }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::string Decoder::decode(core::AccessUnit&& t) {
-    return decode_common(std::move(t)).getData().front().getSegments().front().getSequence();
+    return decode_common(entropyCodeAU(std::move(t), true)).getData().front().getSegments().front().getSequence();
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
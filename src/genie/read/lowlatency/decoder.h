@@ -24,7 +24,14 @@ namespace lowlatency {
  * @brief
  */
 class Decoder : public core::ReadDecoder, public core::RefDecoder {
- private:
+ protected:
+    /**
+     * @brief
+     * @param t Entropy decoded access unit
+     * @param id
+     */
+    void decodeRecords(core::AccessUnit&& t, const util::Section& id) override;
+
  public:
     /**
      * @brief
@@ -35,7 +42,7 @@ class Decoder : public core::ReadDecoder, public core::RefDecoder {
 
     /**
      * @brief
-     * @param t
+     * @param t Entropy decoded access unit
      * @return
      */
     core::record::Chunk decode_common(core::AccessUnit&& t);
@@ -6,9 +6,11 @@
 
 #include "genie/read/lowlatency/encoder.h"
 #include <memory>
+#include <tuple>
 #include <utility>
 #include "genie/name/tokenizer/decoder.h"
 #include "genie/name/tokenizer/encoder.h"
+#include "genie/util/task-scheduler.h"
 #include "genie/util/watch.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -23,33 +25,51 @@ void Encoder::flowIn(core::record::Chunk&& t, const util::Section& id) {
     util::Watch watch;
     core::record::Chunk data = std::move(t);
 
-    if (data.getData().empty()) {
+    if (!data.getNumRecords()) {
         core::parameter::ParameterSet set;
         core::AccessUnit au(std::move(set.getEncodingSet()), 0);
         au.setReference(data.getRef(), data.getRefToWrite());
         au.setReference(uint16_t(data.getRefID()));
+        skipEntropyCoding(id);
         flowOut(std::move(au), id);
         return;
     }
 
     core::parameter::ParameterSet set;
 
-    LLState state{data.getData().front().getSegments().front().getSequence().length(),
-                  data.getData().front().getNumberOfTemplateSegments() > 1,
-                  core::AccessUnit(std::move(set.getEncodingSet()), data.getData().size()), data.isReferenceOnly()};
+    const auto& columns = data.getColumns();
+    bool columnar = !columns.empty();
+    LLState state{columnar ? columns.getSequence(0).length()
+                           : data.getData().front().getSegments().front().getSequence().length(),
+                  columnar ? columns.getNumberOfTemplateSegments() > 1
+                           : data.getData().front().getNumberOfTemplateSegments() > 1,
+                  core::AccessUnit(std::move(set.getEncodingSet()), data.getNumRecords()), data.isReferenceOnly()};
     size_t num_reads = 0;
+
+    // Quality values and names only read the chunk, so idle threads may steal them while the sequences are coded
+    core::QVEncoder::QVCoded qv;
+    std::tuple<core::AccessUnit::Descriptor, core::stats::PerfStats> rname;
+    util::TaskGroup group;
+    group.run([&]() { qv = qvcoder->process(data); });
+    group.run([&]() { rname = namecoder->process(data); });
+
+    if (columnar) {
+        auto segments = size_t(columns.getNumberOfTemplateSegments());
+        for (size_t r = 0; r < columns.size(); ++r) {
+            for (size_t s = r * segments; s < (r + 1) * segments; ++s) {
+                auto seq = columns.getSequence(s);
+                encodeSegment(seq.begin(), seq.end(), state);
+            }
+            if (segments > 1) {
+                state.streams.push(core::GenSub::PAIR_DECODING_CASE, core::GenConst::PAIR_SAME_RECORD);
+            }
+        }
+        num_reads = columns.getNumberOfSegments();
+    }
     for (auto& r : data.getData()) {
         for (auto& s : r.getSegments()) {
             num_reads++;
-            state.streams.push(core::GenSub::RLEN, s.getSequence().length() - 1);
-            if (state.readLength != s.getSequence().length()) {
-                state.readLength = 0;
-            }
-
-            for (auto c : s.getSequence()) {
-                state.streams.push(core::GenSub::UREADS,
-                                   core::getAlphabetProperties(core::AlphabetID::ACGTN).inverseLut[c]);
-            }
+            encodeSegment(s.getSequence().data(), s.getSequence().data() + s.getSequence().length(), state);
         }
         if (r.getSegments().size() > 1) {
             state.streams.push(core::GenSub::PAIR_DECODING_CASE, core::GenConst::PAIR_SAME_RECORD);
@@ -62,9 +82,7 @@ void Encoder::flowIn(core::record::Chunk&& t, const util::Section& id) {
         }
     }
     watch.pause();
-
-    auto qv = qvcoder->process(data);
-    auto rname = namecoder->process(data);
+    group.wait();
     watch.resume();
     auto rawAU = pack(id, std::get<1>(qv).isEmpty() ? 0 : 1, std::move(std::get<0>(qv)), state);
 
@@ -80,7 +98,7 @@ void Encoder::flowIn(core::record::Chunk&& t, const util::Section& id) {
     rawAU.getStats().addDouble("time-lowlatency", watch.check());
     rawAU.getStats().add(std::get<2>(qv));
     rawAU.getStats().add(std::get<1>(rname));
-    rawAU = entropyCodeAU(std::move(rawAU));
+    rawAU = entropyCodeAU(std::move(rawAU), id);
     rawAU.setNumReads(num_reads);
     rawAU.setReferenceOnly(data.isReferenceOnly());
     rawAU.setReference(uint16_t(data.getRefID()));
@@ -91,6 +109,19 @@ void Encoder::flowIn(core::record::Chunk&& t, const util::Section& id) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void Encoder::encodeSegment(const char* begin, const char* end, LLState& state) {
+    auto length = size_t(end - begin);
+    state.streams.push(core::GenSub::RLEN, length - 1);
+    if (state.readLength != length) {
+        state.readLength = 0;
+    }
+
+    const auto& lut = core::getAlphabetProperties(core::AlphabetID::ACGTN).inverseLut;
+    state.streams.get(core::GenSub::UREADS).push(begin, end, [&lut](char c) { return lut[c]; });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 core::AccessUnit Encoder::pack(const util::Section& id, uint8_t qv_depth,
                                std::unique_ptr<core::parameter::QualityValues> qvparam, LLState& state) const {
     core::parameter::DataUnit::DatasetType dataType = state.refOnly
@@ -33,6 +33,14 @@ class Encoder : public core::ReadEncoder {
         bool refOnly;              //!< @brief
     };
 
+    /**
+     * @brief Add the length and bases of one segment to the access unit
+     * @param begin First base
+     * @param end Base after the last one
+     * @param state Current access unit
+     */
+    static void encodeSegment(const char* begin, const char* end, LLState& state);
+
  public:
     /**
      * @brief
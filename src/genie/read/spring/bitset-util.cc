@@ -5,7 +5,18 @@
  */
 
 #include "genie/read/spring/bitset-util.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include "genie/read/spring/params.h"
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GENIE_SPRING_X86_KERNELS
+#include <immintrin.h>
+#endif
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -55,6 +66,203 @@ void bbhashdict::remove(int64_t *dictidx, const uint64_t &startposidx, const int
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Load a 64 bit word without alignment or aliasing requirements
+ * @param p Array
+ * @param i Word index
+ * @return Word
+ */
+static inline uint64_t loadword(const void *p, size_t i) {
+    uint64_t w;
+    std::memcpy(&w, static_cast<const char *>(p) + i * sizeof(uint64_t), sizeof(uint64_t));
+    return w;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Portable kernel
+ * @param a First array
+ * @param b Second array
+ * @param mask Mask array
+ * @param num_words Length in 64 bit words
+ * @return Number of bits set in (a ^ b) & mask
+ */
+static size_t countmaskeddiffscalar(const void *a, const void *b, const void *mask, size_t num_words) {
+    size_t count = 0;
+    for (size_t i = 0; i < num_words; ++i) {
+        count += std::bitset<64>((loadword(a, i) ^ loadword(b, i)) & loadword(mask, i)).count();
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#ifdef GENIE_SPRING_X86_KERNELS
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Kernel using the popcnt instruction for each word
+ * @param a First array
+ * @param b Second array
+ * @param mask Mask array
+ * @param num_words Length in 64 bit words
+ * @return Number of bits set in (a ^ b) & mask
+ */
+__attribute__((target("popcnt"))) static size_t countmaskeddiffpopcnt(const void *a, const void *b, const void *mask,
+                                                                      size_t num_words) {
+    size_t count = 0;
+    for (size_t i = 0; i < num_words; ++i) {
+        count += __builtin_popcountll((loadword(a, i) ^ loadword(b, i)) & loadword(mask, i));
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Kernel working on four words at a time. Bits are counted per nibble with a shuffle lookup table and summed
+ * up per lane, the remaining words go through popcnt.
+ * @param a First array
+ * @param b Second array
+ * @param mask Mask array
+ * @param num_words Length in 64 bit words
+ * @return Number of bits set in (a ^ b) & mask
+ */
+__attribute__((target("avx2,popcnt"))) static size_t countmaskeddiffavx2(const void *a, const void *b,
+                                                                        const void *mask, size_t num_words) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1,
+                                            2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+    const auto *pa = static_cast<const char *>(a);
+    const auto *pb = static_cast<const char *>(b);
+    const auto *pm = static_cast<const char *>(mask);
+    __m256i sums = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= num_words; i += 4) {
+        const size_t offset = i * sizeof(uint64_t);
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pa + offset)),
+                                     _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pb + offset)));
+        v = _mm256_and_si256(v, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pm + offset)));
+        const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low_nibbles));
+        const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibbles));
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+    size_t count = static_cast<size_t>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+                                       _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+    for (; i < num_words; ++i) {
+        count += __builtin_popcountll((loadword(a, i) ^ loadword(b, i)) & loadword(mask, i));
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Kernel working on eight words at a time with a vector population count. The tail is handled with masked
+ * loads, so every read length takes a single pass.
+ * @param a First array
+ * @param b Second array
+ * @param mask Mask array
+ * @param num_words Length in 64 bit words
+ * @return Number of bits set in (a ^ b) & mask
+ */
+__attribute__((target("avx512f,avx512vpopcntdq"))) static size_t countmaskeddiffavx512(const void *a, const void *b,
+                                                                                      const void *mask,
+                                                                                      size_t num_words) {
+    const auto *pa = static_cast<const char *>(a);
+    const auto *pb = static_cast<const char *>(b);
+    const auto *pm = static_cast<const char *>(mask);
+    __m512i sums = _mm512_setzero_si512();
+    for (size_t i = 0; i < num_words; i += 8) {
+        const size_t offset = i * sizeof(uint64_t);
+        const __mmask8 active = num_words - i >= 8 ? __mmask8(0xff) : __mmask8((1u << (num_words - i)) - 1);
+        __m512i v = _mm512_xor_si512(_mm512_maskz_loadu_epi64(active, pa + offset),
+                                     _mm512_maskz_loadu_epi64(active, pb + offset));
+        v = _mm512_and_si512(v, _mm512_maskz_loadu_epi64(active, pm + offset));
+        sums = _mm512_add_epi64(sums, _mm512_popcnt_epi64(v));
+    }
+    uint64_t lane_sums[8];
+    _mm512_storeu_si512(lane_sums, sums);
+    size_t count = 0;
+    for (uint64_t sum : lane_sums) {
+        count += static_cast<size_t>(sum);
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+BitKernel getbestbitkernel() {
+    static const BitKernel best = []() {
+#ifdef GENIE_SPRING_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")) {
+            return BitKernel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+            return BitKernel::AVX2;
+        }
+        if (__builtin_cpu_supports("popcnt")) {
+            return BitKernel::POPCNT;
+        }
+#endif
+        return BitKernel::SCALAR;
+    }();
+    return best;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Run a kernel without checking if the CPU supports it
+ * @param a First array
+ * @param b Second array
+ * @param mask Mask array
+ * @param num_words Length in 64 bit words
+ * @param kernel Kernel
+ * @return Number of bits set in (a ^ b) & mask
+ */
+static size_t runkernel(const void *a, const void *b, const void *mask, size_t num_words, BitKernel kernel) {
+    switch (kernel) {
+#ifdef GENIE_SPRING_X86_KERNELS
+        case BitKernel::AVX512:
+            return countmaskeddiffavx512(a, b, mask, num_words);
+        case BitKernel::AVX2:
+            return countmaskeddiffavx2(a, b, mask, num_words);
+        case BitKernel::POPCNT:
+            return countmaskeddiffpopcnt(a, b, mask, num_words);
+#endif
+        default:
+            return countmaskeddiffscalar(a, b, mask, num_words);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t countmaskeddiff(const void *a, const void *b, const void *mask, size_t num_words, BitKernel kernel) {
+    UTILS_DIE_IF(kernel > getbestbitkernel(), "Bit counting kernel not supported by this CPU");
+    return runkernel(a, b, mask, num_words, kernel);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t countmaskeddiff(const void *a, const void *b, const void *mask, size_t num_words) {
+    // Vectors only pay off for long reads, for a few words their setup costs more than popcnt on each word
+    static const BitKernel vector_kernel = getbestbitkernel();
+    static const BitKernel word_kernel = std::min(vector_kernel, BitKernel::POPCNT);
+    static const size_t vector_words =
+        vector_kernel == BitKernel::AVX512 ? 8 : vector_kernel == BitKernel::AVX2 ? 16 : SIZE_MAX;
+    return runkernel(a, b, mask, num_words, num_words >= vector_words ? vector_kernel : word_kernel);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 }  // namespace spring
 }  // namespace read
 }  // namespace genie
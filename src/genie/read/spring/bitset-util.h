@@ -18,9 +18,11 @@
 #include <bbhash/BooPHF.h>
 #include <algorithm>
 #include <bitset>
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include "genie/read/spring/params.h"
+#include "genie/read/spring/temp-file.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -82,6 +84,68 @@ class bbhashdict {
     }
 };
 
+/**
+ * @brief Implementations of the bit counting kernels, from slowest to fastest
+ */
+enum class BitKernel : uint8_t {
+    SCALAR = 0,  //!< @brief Portable C++
+    POPCNT = 1,  //!< @brief Hardware population count
+    AVX2 = 2,    //!< @brief 256 bit vectors with a nibble lookup table for counting
+    AVX512 = 3   //!< @brief 512 bit vectors with a vector population count
+};
+
+/**
+ * @brief Fastest kernel supported by the CPU, detected once at runtime
+ * @return Kernel
+ */
+BitKernel getbestbitkernel();
+
+/**
+ * @brief Count the bits set in (a ^ b) & mask with the given kernel. The arrays are read as little endian 64 bit
+ * words, which is how reads are stored in the bitsets.
+ * @param a First array
+ * @param b Second array
+ * @param mask Mask array
+ * @param num_words Length of the arrays in 64 bit words
+ * @param kernel Kernel to use, must be supported by the CPU
+ * @return Number of bits set
+ */
+size_t countmaskeddiff(const void *a, const void *b, const void *mask, size_t num_words, BitKernel kernel);
+
+/**
+ * @brief Count the bits set in (a ^ b) & mask with the fastest kernel
+ * @param a First array
+ * @param b Second array
+ * @param mask Mask array
+ * @param num_words Length of the arrays in 64 bit words
+ * @return Number of bits set
+ */
+size_t countmaskeddiff(const void *a, const void *b, const void *mask, size_t num_words);
+
+/**
+ * @brief Bitwise distance of two reads, ((a ^ b) & mask).count() without the temporary bitsets
+ * @tparam bitset_size
+ * @param a First read
+ * @param b Second read
+ * @param mask Positions to compare
+ * @return Number of differing bits
+ */
+template <size_t bitset_size>
+size_t hammingdistance(const std::bitset<bitset_size> &a, const std::bitset<bitset_size> &b,
+                       const std::bitset<bitset_size> &mask);
+
+/**
+ * @brief Read up to 64 consecutive bits, (b >> first).to_ullong() restricted to count bits without shifting the
+ * whole bitset
+ * @tparam bitset_size
+ * @param b Bitset
+ * @param first First bit
+ * @param count Number of bits, at most 64
+ * @return Bits, the first one in the least significant position
+ */
+template <size_t bitset_size>
+uint64_t extractbits(const std::bitset<bitset_size> &b, size_t first, size_t count);
+
 /**
  * @brief
  * @tparam bitset_size
@@ -10,6 +10,7 @@
 // ---------------------------------------------------------------------------------------------------------------------
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -20,6 +21,34 @@ namespace spring {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+template <size_t bitset_size>
+size_t hammingdistance(const std::bitset<bitset_size> &a, const std::bitset<bitset_size> &b,
+                       const std::bitset<bitset_size> &mask) {
+    static_assert(bitset_size % 64 == 0, "Read bitsets consist of whole 64 bit words");
+    return countmaskeddiff(&a, &b, &mask, bitset_size / 64);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <size_t bitset_size>
+uint64_t extractbits(const std::bitset<bitset_size> &b, size_t first, size_t count) {
+    static_assert(bitset_size % 64 == 0, "Read bitsets consist of whole 64 bit words");
+    const char *words = reinterpret_cast<const char *>(&b);
+    const size_t word = first / 64;
+    const size_t shift = first % 64;
+    uint64_t value;
+    std::memcpy(&value, words + word * sizeof(uint64_t), sizeof(uint64_t));
+    value >>= shift;
+    if (shift && shift + count > 64 && word + 1 < bitset_size / 64) {
+        uint64_t next;
+        std::memcpy(&next, words + (word + 1) * sizeof(uint64_t), sizeof(uint64_t));
+        value |= next << (64 - shift);
+    }
+    return count < 64 ? value & ((uint64_t(1) << count) - 1) : value;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 template <size_t bitset_size>
 void stringtobitset(const std::string &s, const uint16_t readlen, std::bitset<bitset_size> &b,
                     std::bitset<bitset_size> **basemask) {
@@ -102,7 +131,7 @@ void constructdictionary(std::bitset<bitset_size> *read, bbhashdict *dict, uint1
             int tid = 0;
             int num_thr = 1;
 #endif
-            std::ofstream foutkey(basedir + std::string("/keys.bin.") + std::to_string(tid), std::ios::binary);
+            TempOutFile foutkey(basedir + std::string("/keys.bin.") + std::to_string(tid), std::ios::binary);
             uint64_t i, stop;
             i = uint64_t(tid) * dict[j].dict_numreads / num_thr;
             stop = uint64_t(tid + 1) * dict[j].dict_numreads / num_thr;
@@ -150,8 +179,8 @@ void constructdictionary(std::bitset<bitset_size> *read, bbhashdict *dict, uint1
             int tid = 0;
             int num_thr = 1;
 #endif
-            std::ifstream finkey(basedir + std::string("/keys.bin.") + std::to_string(tid), std::ios::binary);
-            std::ofstream fouthash(basedir + std::string("/hash.bin.") + std::to_string(tid) + '.' + std::to_string(j),
+            TempInFile finkey(basedir + std::string("/keys.bin.") + std::to_string(tid), std::ios::binary);
+            TempOutFile fouthash(basedir + std::string("/hash.bin.") + std::to_string(tid) + '.' + std::to_string(j),
                                    std::ios::binary);
             uint64_t currentkey, currenthash;
             uint64_t i, stop;
@@ -167,7 +196,7 @@ void constructdictionary(std::bitset<bitset_size> *read, bbhashdict *dict, uint1
                 fouthash.write(reinterpret_cast<char *>(&currenthash), sizeof(uint64_t));
             }
             finkey.close();
-            remove((basedir + std::string("/keys.bin.") + std::to_string(tid)).c_str());
+            removeTempFile(basedir + std::string("/keys.bin.") + std::to_string(tid));
             fouthash.close();
         }  // parallel end
     }
@@ -190,7 +219,7 @@ void constructdictionary(std::bitset<bitset_size> *read, bbhashdict *dict, uint1
             dict[j].startpos = new uint32_t[dict[j].numkeys + 1]();  // 1 extra to store end pos of last key
             uint64_t currenthash;
             for (int tid = 0; tid < num_threads; tid++) {
-                std::ifstream finhash(
+                TempInFile finhash(
                     basedir + std::string("/hash.bin.") + std::to_string(tid) + '.' + std::to_string(j),
                     std::ios::binary);
                 finhash.read(reinterpret_cast<char *>(&currenthash), sizeof(uint64_t));
@@ -209,7 +238,7 @@ void constructdictionary(std::bitset<bitset_size> *read, bbhashdict *dict, uint1
             dict[j].read_id = new uint32_t[dict[j].dict_numreads];
             uint32_t i = 0;
             for (int tid = 0; tid < num_threads; tid++) {
-                std::ifstream finhash(
+                TempInFile finhash(
                     basedir + std::string("/hash.bin.") + std::to_string(tid) + '.' + std::to_string(j),
                     std::ios::binary);
                 finhash.read(reinterpret_cast<char *>(&currenthash), sizeof(uint64_t));
@@ -220,7 +249,7 @@ void constructdictionary(std::bitset<bitset_size> *read, bbhashdict *dict, uint1
                     finhash.read(reinterpret_cast<char *>(&currenthash), sizeof(uint64_t));
                 }
                 finhash.close();
-                remove((basedir + std::string("/hash.bin.") + std::to_string(tid) + '.' + std::to_string(j)).c_str());
+                removeTempFile(basedir + std::string("/hash.bin.") + std::to_string(tid) + '.' + std::to_string(j));
             }
 
             // correcting startpos array modified during insertion
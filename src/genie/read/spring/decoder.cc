@@ -67,10 +67,11 @@ void decode_streams(core::AccessUnit& au, bool paired_end, bool combine_pairs,
         if (rtype == 5) {
             // put in refBuf
             auto rlen = (uint32_t)au.get(core::GenSub::RLEN).pull() + 1;  // rlen
-            for (uint32_t i = 0; i < rlen; i++) {
-                refBuf.push_back(
-                    getAlphabetProperties(core::AlphabetID::ACGTN).lut[au.get(core::GenSub::UREADS).pull()]);  // ureads
-            }
+            const auto offset = refBuf.size();
+            refBuf.resize(offset + rlen);
+            const auto &lut = getAlphabetProperties(core::AlphabetID::ACGTN).lut;
+            au.get(core::GenSub::UREADS)
+                .pull(&refBuf[offset], &refBuf[offset] + rlen, [&lut](uint64_t v) { return lut[v]; });  // ureads
         } else {
             // rtype can be 1 (P) or 3 (M)
             uint8_t number_of_record_segments;
@@ -8,6 +8,7 @@
 #include <string>
 #include <utility>
 #include "filesystem/filesystem.hpp"
+#include "genie/read/spring/temp-file.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -23,7 +24,7 @@ SpringSource::SpringSource(const std::string& temp_dir, const compression_params
     auId = 0;
     // read info about number of blocks (AUs) and the number of reads and records in those
     const std::string block_info_file = temp_dir + "/block_info.bin";
-    std::ifstream f_block_info(block_info_file, std::ios::binary);
+    TempInFile f_block_info(block_info_file, std::ios::binary);
     f_block_info.read(reinterpret_cast<char*>(&num_AUs), sizeof(uint32_t));
     num_reads_per_AU = std::vector<uint32_t>(num_AUs);
     num_records_per_AU = std::vector<uint32_t>(num_AUs);
@@ -34,7 +35,7 @@ SpringSource::SpringSource(const std::string& temp_dir, const compression_params
         f_block_info.read(reinterpret_cast<char*>(&num_records_per_AU[0]), num_AUs * sizeof(uint32_t));
 
     f_block_info.close();
-    ghc::filesystem::remove(block_info_file);
+    removeTempFile(block_info_file);
 
     // define descriptors corresponding to reads, ids and quality (so as to read them from file)
     read_desc_prefix = temp_dir + "/read_streams.";
@@ -67,18 +68,18 @@ bool SpringSource::pump(uint64_t& id, std::mutex& lock) {
             } else {
                 filename = read_desc_prefix + std::to_string(auId) + "." + std::to_string(uint8_t(d.getID()));
             }
-            if (!ghc::filesystem::exists(filename)) {
+            if (!tempFileExists(filename)) {
                 continue;
             }
-            if (!ghc::filesystem::file_size(filename)) {
-                ghc::filesystem::remove(filename);
+            if (!getTempFileSize(filename)) {
+                removeTempFile(filename);
                 continue;
             }
-            std::ifstream input(filename, std::ios::binary);
+            TempInFile input(filename, std::ios::binary);
             util::BitReader br(input);
-            d = core::AccessUnit::Descriptor(d.getID(), count, ghc::filesystem::file_size(filename), br);
+            d = core::AccessUnit::Descriptor(d.getID(), count, getTempFileSize(filename), br);
             input.close();
-            ghc::filesystem::remove(filename);
+            removeTempFile(filename);
         }
         auId++;
         sec = {size_t(id), au.getNumReads(), true};
@@ -6,6 +6,7 @@
 
 #include "genie/read/spring/encoder.h"
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -14,6 +15,9 @@
 #include "genie/read/spring/encoder-source.h"
 #include "genie/read/spring/generate-read-streams.h"
 #include "genie/read/spring/reorder-compress-quality-id.h"
+#include "genie/read/spring/spring-encoding.h"
+#include "genie/read/spring/temp-file.h"
+#include "genie/util/make-unique.h"
 #include "genie/util/thread-manager.h"
 #include "genie/util/watch.h"
 
@@ -27,6 +31,8 @@ namespace spring {
 
 void Encoder::flowIn(core::record::Chunk&& t, const util::Section& id) {
     preprocessor.preprocess(std::move(t), id);
+    // The access units are generated when flushing
+    skipEntropyCoding(id);
     skipOut(id);
 }
 
@@ -39,69 +45,107 @@ void Encoder::flushIn(uint64_t& pos) {
     }
     preprocessor.finish(pos);
 
-    std::vector<core::parameter::EncodingSet> params;
-    auto loc_cp = preprocessor.cp;
-    util::Watch watch;
+    std::vector<std::vector<core::parameter::EncodingSet>> params(preprocessor.partitions.size());
+    std::vector<std::unique_ptr<SpringSource>> sources;
     core::stats::PerfStats stats = preprocessor.getStats();
+    if (preprocessor.partitions.size() > 1) {
+        stats.addInteger("spring-partitions", preprocessor.partitions.size());
+        std::cerr << "Warning: reordering memory budget exceeded, input split into " << preprocessor.partitions.size()
+                  << " minimizer partitions. Reads are only matched against reads of the same partition.\n";
+    }
+    uint64_t singletons = 0;
+    // The access units are emitted from pos on, the entropy coder knows them by the same records
+    uint64_t first_record = pos;
+    for (size_t p = 0; p < preprocessor.partitions.size(); ++p) {
+        const auto& partition = preprocessor.partitions[p];
+        auto loc_cp = partition.cp;
+        util::Watch watch;
 #ifndef GENIE_USE_OPENMP
-    loc_cp.num_thr = 1;
+        loc_cp.num_thr = 1;
 #endif
+        if (preprocessor.partitions.size() > 1) {
+            std::cerr << "Partition " << p + 1 << " of " << preprocessor.partitions.size() << "\n";
+        }
+
+        watch.reset();
+        std::cerr << "Reordering ...\n";
+        call_reorder(partition.temp_dir, loc_cp);
+        std::cerr << "Reordering done!\n";
+        stats.addDouble("time-spring-reorder", watch.check());
+        if (preprocessor.partitions.size() > 1) {
+            // Reads of a partition cannot be matched against contigs of other partitions. The singleton count is
+            // reported as an upper bound for the matches lost where bucket links were split.
+            const uint32_t partition_singletons = readSingletonCount(partition.temp_dir);
+            stats.addInteger("spring-singletons", partition_singletons);
+            singletons += partition_singletons;
+        }
+
+        watch.reset();
+        std::cerr << "Encoding ...\n";
+        call_encoder(partition.temp_dir, loc_cp);
+        std::cerr << "Encoding done!\n";
+        stats.addDouble("time-spring-encoding", watch.check());
 
-    watch.reset();
-    std::cerr << "Reordering ...\n";
-    call_reorder(preprocessor.temp_dir, loc_cp);
-    std::cerr << "Reordering done!\n";
-    stats.addDouble("time-spring-reorder", watch.check());
-
-    watch.reset();
-    std::cerr << "Encoding ...\n";
-    call_encoder(preprocessor.temp_dir, loc_cp);
-    std::cerr << "Encoding done!\n";
-    stats.addDouble("time-spring-encoding", watch.check());
-
-    watch.reset();
-    std::cerr << "Generating read streams ...\n";
-    generate_read_streams(preprocessor.temp_dir, loc_cp, entropycoder, params, stats, writeOutStreams);
-    std::cerr << "Generating read streams done!\n";
-    stats.addDouble("time-spring-gen-reads", watch.check());
-
-    if (preprocessor.cp.preserve_quality || preprocessor.cp.preserve_id) {
         watch.reset();
-        std::cerr << "Reordering and compressing quality and/or ids ...\n";
-        reorder_compress_quality_id(preprocessor.temp_dir, loc_cp, qvcoder, namecoder, entropycoder, params, stats,
-                                    writeOutStreams);
-        std::cerr << "Reordering and compressing quality and/or ids done!\n";
-        stats.addDouble("time-spring-qual-name", watch.check());
+        std::cerr << "Generating read streams ...\n";
+        const auto sections = generate_read_streams(partition.temp_dir, loc_cp, entropycoder, first_record, params[p],
+                                                    stats, writeOutStreams);
+        std::cerr << "Generating read streams done!\n";
+        stats.addDouble("time-spring-gen-reads", watch.check());
+
+        if (partition.cp.preserve_quality || partition.cp.preserve_id) {
+            watch.reset();
+            std::cerr << "Reordering and compressing quality and/or ids ...\n";
+            reorder_compress_quality_id(partition.temp_dir, loc_cp, qvcoder, namecoder, entropycoder, sections,
+                                        params[p], stats, writeOutStreams);
+            std::cerr << "Reordering and compressing quality and/or ids done!\n";
+            stats.addDouble("time-spring-qual-name", watch.check());
+        }
+
+        // The statistics travel with the first access unit of each partition
+        sources.emplace_back(util::make_unique<SpringSource>(partition.temp_dir, partition.cp, params[p], stats));
+        sources.back()->setDrain(this->drain);
+        stats = core::stats::PerfStats();
     }
 
-    SpringSource src(this->preprocessor.temp_dir, this->preprocessor.cp, params, stats);
-    src.setDrain(this->drain);
-    std::vector<util::OriginalSource*> srcVec = {&src};
+    if (preprocessor.partitions.size() > 1) {
+        std::cerr << "Singleton reads in all partitions: " << singletons << "\n";
+    }
+
+    // All partitions are emitted in one run, so that access unit IDs continue across partitions
+    std::vector<util::OriginalSource*> srcVec;
+    for (auto& src : sources) {
+        srcVec.push_back(src.get());
+    }
     util::ThreadManager mgr(preprocessor.cp.num_thr, pos);
     mgr.setSource(srcVec);
     mgr.run();
 
-    ghc::filesystem::remove(preprocessor.temp_dir + "/blocks_id.bin");
-    ghc::filesystem::remove(preprocessor.temp_dir + "/read_order.bin");
-    ghc::filesystem::remove_all(preprocessor.temp_dir);
+    for (const auto& partition : preprocessor.partitions) {
+        removeTempFile(partition.temp_dir + "/blocks_id.bin");
+        removeTempFile(partition.temp_dir + "/read_order.bin");
+        removeTempDirectory(partition.temp_dir);
+    }
 
-    preprocessor.setup(preprocessor.working_dir, preprocessor.cp.num_thr, preprocessor.cp.paired_end);
+    preprocessor.setup(preprocessor.working_dir, preprocessor.cp.num_thr, preprocessor.cp.paired_end,
+                       preprocessor.in_memory, preprocessor.memory_budget);
 
     flushOut(pos);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-Encoder::Encoder(const std::string& working_dir, size_t num_thr, bool paired_end, bool _write_raw)
+Encoder::Encoder(const std::string& working_dir, size_t num_thr, bool paired_end, bool _write_raw, bool in_memory,
+                 uint64_t memory_budget)
     : ReadEncoder(_write_raw) {
-    preprocessor.setup(working_dir, num_thr, paired_end);
+    preprocessor.setup(working_dir, num_thr, paired_end, in_memory, memory_budget);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 void Encoder::skipIn(const util::Section& id) {
     preprocessor.skip(id);
-    skipOut(id);
+    ReadEncoder::skipIn(id);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
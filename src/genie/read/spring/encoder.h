@@ -34,8 +34,14 @@ class Encoder : public genie::core::ReadEncoder {
      * @param num_thr
      * @param paired_end
      * @param write_raw
+     * @param in_memory Keep the temporary files in memory instead of the working directory
+     * @param memory_budget Approximate memory for reordering in bytes. Larger inputs are split by minimizer bucket
+     * into partitions that are reordered independently, 0 for no limit. Buckets linked by overlapping reads are
+     * merged into one partition where the budget allows. The links left between partitions are reported as
+     * "spring-bucket-links-split", the singletons of all partitions as "spring-singletons".
      */
-    explicit Encoder(const std::string& working_dir, size_t num_thr, bool paired_end, bool write_raw);
+    explicit Encoder(const std::string& working_dir, size_t num_thr, bool paired_end, bool write_raw,
+                     bool in_memory = false, uint64_t memory_budget = 0);
 
     /**
      * @brief
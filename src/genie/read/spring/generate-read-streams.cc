@@ -54,6 +54,9 @@ struct se_data {
 // ---------------------------------------------------------------------------------------------------------------------
 
 void generate_subseqs(const se_data &data, uint64_t block_num, core::AccessUnit &raw_au) {
+    const auto &inverseLut = getAlphabetProperties(core::AlphabetID::ACGTN).inverseLut;
+    auto toInt = [&inverseLut](char c) { return inverseLut[c]; };
+
     int64_t rc_to_int[128];
     rc_to_int[(uint8_t)'d'] = 0;
     rc_to_int[(uint8_t)'r'] = 1;
@@ -82,9 +85,7 @@ void generate_subseqs(const se_data &data, uint64_t block_num, core::AccessUnit
         // not all unaligned
         raw_au.get(core::GenSub::RLEN).push(seq_end - seq_start - 1);  // rlen
         raw_au.get(core::GenSub::RTYPE).push(5);                       // rtype
-        for (uint64_t i = seq_start; i < seq_end; i++)
-            raw_au.get(core::GenSub::UREADS)
-                .push(getAlphabetProperties(core::AlphabetID::ACGTN).inverseLut[data.seq[i]]);  // ureads
+        raw_au.get(core::GenSub::UREADS).push(data.seq.data() + seq_start, data.seq.data() + seq_end, toInt);  // ureads
     }
     uint64_t prevpos = 0, diffpos;
     // Write streams
@@ -128,11 +129,8 @@ void generate_subseqs(const se_data &data, uint64_t block_num, core::AccessUnit
         } else {
             raw_au.get(core::GenSub::RTYPE).push(5);                           // rtype
             raw_au.get(core::GenSub::RLEN).push(data.read_length_arr[i] - 1);  // rlen
-            for (uint64_t j = 0; j < data.read_length_arr[i]; j++) {
-                raw_au.get(core::GenSub::UREADS)
-                    .push(getAlphabetProperties(core::AlphabetID::ACGTN)
-                              .inverseLut[data.unaligned_arr[data.pos_arr[i] + j]]);  // ureads
-            }
+            const char *unaligned = data.unaligned_arr.data() + data.pos_arr[i];
+            raw_au.get(core::GenSub::UREADS).push(unaligned, unaligned + data.read_length_arr[i], toInt);  // ureads
             raw_au.get(core::GenSub::POS_MAPPING_FIRST).push(seq_end - prevpos);  // pos
             raw_au.get(core::GenSub::RCOMP).push(0);                              // rcomp
             raw_au.get(core::GenSub::RLEN).push(data.read_length_arr[i] - 1);     // rlen
@@ -145,15 +143,41 @@ void generate_subseqs(const se_data &data, uint64_t block_num, core::AccessUnit
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void generate_and_compress_se(const std::string &temp_dir, const se_data &data,
-                              core::ReadEncoder::EntropySelector *entropycoder,
-                              std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
-                              bool write_raw) {
+/**
+ * @brief Descriptors that are entropy coded after the read streams, the read streams leave them alone
+ * @param cp Compression parameters
+ * @return Qualities and read names, if they are preserved
+ */
+static std::vector<core::GenDesc> getLaterDescriptors(const compression_params &cp) {
+    std::vector<core::GenDesc> ret;
+    if (cp.preserve_quality) {
+        ret.push_back(core::GenDesc::QV);
+    }
+    if (cp.preserve_id) {
+        ret.push_back(core::GenDesc::RNAME);
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<util::Section> generate_and_compress_se(const std::string &temp_dir, const se_data &data,
+                                                    core::ReadEncoder::EntropySelector *entropycoder,
+                                                    uint64_t &first_record,
+                                                    std::vector<core::parameter::EncodingSet> &params,
+                                                    core::stats::PerfStats &stats, bool write_raw) {
     // Now generate new streams and compress blocks in parallel
     // this is actually number of read pairs per block for PE
     uint64_t blocks = uint64_t(std::ceil(static_cast<float>(data.cp.num_reads) / data.cp.num_reads_per_block));
 
     params.resize(blocks);
+    std::vector<util::Section> sections(blocks);
+    for (uint64_t block_num = 0; block_num < blocks; block_num++) {
+        const uint64_t start = block_num * data.cp.num_reads_per_block;
+        const uint64_t length = std::min<uint64_t>(data.cp.num_reads_per_block, data.cp.num_reads - start);
+        sections[block_num] = {size_t(first_record + start), size_t(length), true};
+    }
+    first_record += data.cp.num_reads;
 
     std::vector<uint32_t> num_reads_per_block(blocks);
     std::vector<core::stats::PerfStats> stat_vec(blocks);
@@ -170,7 +194,8 @@ void generate_and_compress_se(const std::string &temp_dir, const se_data &data,
         generate_subseqs(data, block_num, au);
         num_reads_per_block[block_num] = (uint32_t)au.get(core::GenSub::RCOMP).getNumSymbols();  // rcomp
 
-        au = core::ReadEncoder::entropyCodeAU(entropycoder, std::move(au), write_raw);
+        au = core::ReadEncoder::entropyCodeAU(entropycoder, std::move(au), write_raw, sections[block_num],
+                                              getLaterDescriptors(data.cp));
         stat_vec[block_num].add(au.getStats());
 
         params[block_num] = std::move(au.moveParameters());
@@ -180,7 +205,7 @@ void generate_and_compress_se(const std::string &temp_dir, const se_data &data,
             if (d.isEmpty()) {
                 continue;
             }
-            std::ofstream out(file_to_save_streams + "." + std::to_string(uint8_t(d.getID())), std::ios::binary);
+            TempOutFile out(file_to_save_streams + "." + std::to_string(uint8_t(d.getID())), std::ios::binary);
             util::BitWriter bw(&out);
             d.write(bw);
         }
@@ -192,10 +217,11 @@ void generate_and_compress_se(const std::string &temp_dir, const se_data &data,
 
     // write num blocks, reads per block to a file
     const std::string block_info_file = temp_dir + "/block_info.bin";
-    std::ofstream f_block_info(block_info_file, std::ios::binary);
+    TempOutFile f_block_info(block_info_file, std::ios::binary);
     uint32_t num_blocks = (uint32_t)blocks;
     f_block_info.write(reinterpret_cast<char *>(&num_blocks), sizeof(uint32_t));
     f_block_info.write(reinterpret_cast<char *>(&num_reads_per_block[0]), num_blocks * sizeof(uint32_t));
+    return sections;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -221,19 +247,19 @@ void loadSE_Data(const compression_params &cp, const std::string &temp_dir, se_d
     data->noise_len_arr = std::vector<uint16_t>(cp.num_reads);
 
     // read streams for aligned reads
-    std::ifstream f_seq(file_seq);
+    TempInFile f_seq(file_seq);
     f_seq.seekg(0, f_seq.end);
     uint64_t seq_len = f_seq.tellg();
     data->seq.resize(seq_len);
     f_seq.seekg(0);
     f_seq.read(&data->seq[0], seq_len);
     f_seq.close();
-    std::ifstream f_order;
-    std::ifstream f_RC(file_RC);
-    std::ifstream f_readlength(file_readlength, std::ios::binary);
-    std::ifstream f_noise(file_noise);
-    std::ifstream f_noisepos(file_noisepos, std::ios::binary);
-    std::ifstream f_pos(file_pos, std::ios::binary);
+    TempInFile f_order;
+    TempInFile f_RC(file_RC);
+    TempInFile f_readlength(file_readlength, std::ios::binary);
+    TempInFile f_noise(file_noise);
+    TempInFile f_noisepos(file_noisepos, std::ios::binary);
+    TempInFile f_pos(file_pos, std::ios::binary);
     f_noisepos.seekg(0, f_noisepos.end);
     uint64_t noise_array_size = f_noisepos.tellg() / 2;
     f_noisepos.seekg(0, f_noisepos.beg);
@@ -280,13 +306,13 @@ void loadSE_Data(const compression_params &cp, const std::string &temp_dir, se_d
     // Now start with unaligned reads
     num_reads_unaligned = num_reads - num_reads_aligned;
     std::string file_unaligned_count = file_unaligned + ".count";
-    std::ifstream f_unaligned_count(file_unaligned_count, std::ios::in | std::ios::binary);
+    TempInFile f_unaligned_count(file_unaligned_count, std::ios::in | std::ios::binary);
     uint64_t unaligned_array_size;
     f_unaligned_count.read(reinterpret_cast<char *>(&unaligned_array_size), sizeof(uint64_t));
     f_unaligned_count.close();
-    remove(file_unaligned_count.c_str());
+    removeTempFile(file_unaligned_count);
     data->unaligned_arr = std::vector<char>(unaligned_array_size);
-    std::ifstream f_unaligned(file_unaligned, std::ios::binary);
+    TempInFile f_unaligned(file_unaligned, std::ios::binary);
     std::string unaligned_read;
     uint64_t pos_in_unaligned_arr = 0;
     for (uint32_t i = 0; i < num_reads_unaligned; i++) {
@@ -307,25 +333,26 @@ void loadSE_Data(const compression_params &cp, const std::string &temp_dir, se_d
     f_readlength.close();
 
     // delete old streams
-    remove(file_noise.c_str());
-    remove(file_noisepos.c_str());
-    remove(file_RC.c_str());
-    remove(file_readlength.c_str());
-    remove(file_unaligned.c_str());
-    remove(file_pos.c_str());
-    remove(file_seq.c_str());
+    removeTempFile(file_noise);
+    removeTempFile(file_noisepos);
+    removeTempFile(file_RC);
+    removeTempFile(file_readlength);
+    removeTempFile(file_unaligned);
+    removeTempFile(file_pos);
+    removeTempFile(file_seq);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void generate_read_streams_se(const std::string &temp_dir, const compression_params &cp,
-                              core::ReadEncoder::EntropySelector *entropycoder,
-                              std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
-                              bool write_raw) {
+std::vector<util::Section> generate_read_streams_se(const std::string &temp_dir, const compression_params &cp,
+                                                    core::ReadEncoder::EntropySelector *entropycoder,
+                                                    uint64_t &first_record,
+                                                    std::vector<core::parameter::EncodingSet> &params,
+                                                    core::stats::PerfStats &stats, bool write_raw) {
     se_data data;
     loadSE_Data(cp, temp_dir, &data);
 
-    generate_and_compress_se(temp_dir, data, entropycoder, params, stats, write_raw);
+    return generate_and_compress_se(temp_dir, data, entropycoder, first_record, params, stats, write_raw);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -358,20 +385,20 @@ void loadPE_Data(const compression_params &cp, const std::string &temp_dir, se_d
     // read order array
 
     // read streams for aligned reads
-    std::ifstream f_seq(file_seq);
+    TempInFile f_seq(file_seq);
     f_seq.seekg(0, f_seq.end);
     uint64_t seq_len = f_seq.tellg();
     data->seq.resize(seq_len);
     f_seq.seekg(0);
     f_seq.read(&data->seq[0], seq_len);
     f_seq.close();
-    std::ifstream f_order;
+    TempInFile f_order;
     f_order.open(file_order, std::ios::binary);
-    std::ifstream f_RC(file_RC);
-    std::ifstream f_readlength(file_readlength, std::ios::binary);
-    std::ifstream f_noise(file_noise);
-    std::ifstream f_noisepos(file_noisepos, std::ios::binary);
-    std::ifstream f_pos(file_pos, std::ios::binary);
+    TempInFile f_RC(file_RC);
+    TempInFile f_readlength(file_readlength, std::ios::binary);
+    TempInFile f_noise(file_noise);
+    TempInFile f_noisepos(file_noisepos, std::ios::binary);
+    TempInFile f_pos(file_pos, std::ios::binary);
     f_noisepos.seekg(0, f_noisepos.end);
     uint64_t noise_array_size = f_noisepos.tellg() / 2;
     f_noisepos.seekg(0, f_noisepos.beg);
@@ -419,13 +446,13 @@ void loadPE_Data(const compression_params &cp, const std::string &temp_dir, se_d
     // Now start with unaligned reads
     num_reads_unaligned = cp.num_reads - num_reads_aligned;
     std::string file_unaligned_count = file_unaligned + ".count";
-    std::ifstream f_unaligned_count(file_unaligned_count, std::ios::in | std::ios::binary);
+    TempInFile f_unaligned_count(file_unaligned_count, std::ios::in | std::ios::binary);
     uint64_t unaligned_array_size;
     f_unaligned_count.read(reinterpret_cast<char *>(&unaligned_array_size), sizeof(uint64_t));
     f_unaligned_count.close();
-    remove(file_unaligned_count.c_str());
+    removeTempFile(file_unaligned_count);
     data->unaligned_arr = std::vector<char>(unaligned_array_size);
-    std::ifstream f_unaligned(file_unaligned, std::ios::binary);
+    TempInFile f_unaligned(file_unaligned, std::ios::binary);
     std::string unaligned_read;
     uint64_t pos_in_unaligned_arr = 0;
     for (uint32_t i = 0; i < num_reads_unaligned; i++) {
@@ -449,13 +476,13 @@ void loadPE_Data(const compression_params &cp, const std::string &temp_dir, se_d
     f_readlength.close();
 
     // delete old streams
-    remove(file_noise.c_str());
-    remove(file_noisepos.c_str());
-    remove(file_RC.c_str());
-    remove(file_readlength.c_str());
-    remove(file_unaligned.c_str());
-    remove(file_pos.c_str());
-    remove(file_seq.c_str());
+    removeTempFile(file_noise);
+    removeTempFile(file_noisepos);
+    removeTempFile(file_RC);
+    removeTempFile(file_readlength);
+    removeTempFile(file_unaligned);
+    removeTempFile(file_pos);
+    removeTempFile(file_seq);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -578,9 +605,9 @@ void generate_qual_id_pe(const std::string &temp_dir, const pe_block_data &bdata
     const std::string file_blocks_id = temp_dir + "/blocks_id.bin";
 
     // quality:
-    std::ofstream f_order_quality(file_order_quality, std::ios::binary);
+    TempOutFile f_order_quality(file_order_quality, std::ios::binary);
     // store order (as usual in uint32_t)
-    std::ofstream f_blocks_quality(file_blocks_quality, std::ios::binary);
+    TempOutFile f_blocks_quality(file_blocks_quality, std::ios::binary);
     // store block start and end positions (differs from the block_start and end
     // because here we measure in terms of quality values rather than records
     uint32_t quality_block_pos = 0;
@@ -607,13 +634,13 @@ void generate_qual_id_pe(const std::string &temp_dir, const pe_block_data &bdata
     f_order_quality.close();
     f_blocks_quality.close();
     // id:
-    std::ofstream f_blocks_id(file_blocks_id, std::ios::binary);
+    TempOutFile f_blocks_id(file_blocks_id, std::ios::binary);
     // store block start and end positions (measured in terms of records since 1
     // record = 1 id)
     for (uint32_t i = 0; i < bdata.block_start.size(); i++) {
         f_blocks_id.write(reinterpret_cast<const char *>(&bdata.block_start[i]), sizeof(uint32_t));
         f_blocks_id.write(reinterpret_cast<const char *>(&bdata.block_end[i]), sizeof(uint32_t));
-        std::ofstream f_order_id(file_order_id + "." + std::to_string(i), std::ios::binary);
+        TempOutFile f_order_id(file_order_id + "." + std::to_string(i), std::ios::binary);
         // store order
         for (uint32_t j = bdata.block_start[i]; j < bdata.block_end[i]; j++) {
             uint32_t current = bdata.read_index_genomic_record[j];
@@ -639,6 +666,9 @@ struct pe_statistics {
 
 void generate_streams_pe(const se_data &data, const pe_block_data &bdata, uint64_t cur_block_num, pe_statistics *pest,
                          core::AccessUnit &raw_au) {
+    const auto &inverseLut = getAlphabetProperties(core::AlphabetID::ACGTN).inverseLut;
+    auto toInt = [&inverseLut](char c) { return inverseLut[c]; };
+
 #ifdef GENIE_USE_OPENMP
     const unsigned cur_thread_num = omp_get_thread_num();
 #else
@@ -655,9 +685,7 @@ void generate_streams_pe(const se_data &data, const pe_block_data &bdata, uint64
         // not all unaligned
         raw_au.get(core::GenSub::RLEN).push(seq_end - seq_start - 1);  // rlen
         raw_au.get(core::GenSub::RTYPE).push(5);                       // rtype
-        for (uint64_t i = seq_start; i < seq_end; i++)
-            raw_au.get(core::GenSub::UREADS)
-                .push(getAlphabetProperties(core::AlphabetID::ACGTN).inverseLut[data.seq[i]]);  // ureads
+        raw_au.get(core::GenSub::UREADS).push(data.seq.data() + seq_start, data.seq.data() + seq_end, toInt);  // ureads
     }
     uint64_t prevpos = 0, diffpos;
     // Write streams
@@ -686,16 +714,11 @@ void generate_streams_pe(const se_data &data, const pe_block_data &bdata, uint64
                 raw_au.get(core::GenSub::RTYPE).push(5);  // rtype
                 raw_au.get(core::GenSub::RLEN)
                     .push(data.read_length_arr[current] + data.read_length_arr[pair] - 1);  // rlen
-                for (uint64_t j = 0; j < data.read_length_arr[current]; j++) {
-                    raw_au.get(core::GenSub::UREADS)
-                        .push(getAlphabetProperties(core::AlphabetID::ACGTN)
-                                  .inverseLut[data.unaligned_arr[data.pos_arr[current] + j]]);  // ureads
-                }
-                for (uint64_t j = 0; j < data.read_length_arr[pair]; j++) {
-                    raw_au.get(core::GenSub::UREADS)
-                        .push(getAlphabetProperties(core::AlphabetID::ACGTN)
-                                  .inverseLut[data.unaligned_arr[data.pos_arr[pair] + j]]);  // ureads
-                }
+                const char *unaligned = data.unaligned_arr.data() + data.pos_arr[current];
+                raw_au.get(core::GenSub::UREADS)
+                    .push(unaligned, unaligned + data.read_length_arr[current], toInt);  // ureads
+                unaligned = data.unaligned_arr.data() + data.pos_arr[pair];
+                raw_au.get(core::GenSub::UREADS).push(unaligned, unaligned + data.read_length_arr[pair], toInt);
                 raw_au.get(core::GenSub::POS_MAPPING_FIRST).push(seq_end - prevpos);     // pos
                 raw_au.get(core::GenSub::RCOMP).push(0);                                 // rcomp
                 raw_au.get(core::GenSub::RCOMP).push(0);                                 // rcomp
@@ -779,11 +802,9 @@ void generate_streams_pe(const se_data &data, const pe_block_data &bdata, uint64
             } else {
                 raw_au.get(core::GenSub::RTYPE).push(5);                                 // rtype
                 raw_au.get(core::GenSub::RLEN).push(data.read_length_arr[current] - 1);  // rlen
-                for (uint64_t j = 0; j < data.read_length_arr[current]; j++) {
-                    raw_au.get(core::GenSub::UREADS)
-                        .push(getAlphabetProperties(core::AlphabetID::ACGTN)
-                                  .inverseLut[data.unaligned_arr[data.pos_arr[current] + j]]);  // ureads
-                }
+                const char *unaligned = data.unaligned_arr.data() + data.pos_arr[current];
+                raw_au.get(core::GenSub::UREADS)
+                    .push(unaligned, unaligned + data.read_length_arr[current], toInt);  // ureads
                 raw_au.get(core::GenSub::POS_MAPPING_FIRST).push(seq_end - prevpos);     // pos
                 raw_au.get(core::GenSub::RCOMP).push(0);                                 // rcomp
                 raw_au.get(core::GenSub::RLEN).push(data.read_length_arr[current] - 1);  // rlen
@@ -821,10 +842,11 @@ void generate_streams_pe(const se_data &data, const pe_block_data &bdata, uint64
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void generate_read_streams_pe(const std::string &temp_dir, const compression_params &cp,
-                              core::ReadEncoder::EntropySelector *entropycoder,
-                              std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
-                              bool write_raw) {
+std::vector<util::Section> generate_read_streams_pe(const std::string &temp_dir, const compression_params &cp,
+                                                    core::ReadEncoder::EntropySelector *entropycoder,
+                                                    uint64_t &first_record,
+                                                    std::vector<core::parameter::EncodingSet> &params,
+                                                    core::stats::PerfStats &stats, bool write_raw) {
     // basic approach: start looking at reads from left to right. If current is
     // aligned but pair is unaligned, pair is kept at the end current AU and
     // stored in different record. We try to keep number of records in AU =
@@ -853,6 +875,12 @@ void generate_read_streams_pe(const std::string &temp_dir, const compression_par
     std::vector<uint32_t> num_records_per_block(bdata.block_start.size());
 
     params.resize(bdata.block_start.size());
+    std::vector<util::Section> sections(bdata.block_start.size());
+    for (size_t block_num = 0; block_num < sections.size(); block_num++) {
+        sections[block_num] = {size_t(first_record + bdata.block_start[block_num]),
+                               size_t(bdata.block_end[block_num] - bdata.block_start[block_num]), true};
+    }
+    first_record += bdata.block_end.empty() ? 0 : bdata.block_end.back();
 
     std::vector<core::stats::PerfStats> stat_vec(bdata.block_start.size());
 
@@ -873,7 +901,8 @@ void generate_read_streams_pe(const std::string &temp_dir, const compression_par
         num_reads_per_block[cur_block_num] = (uint32_t)au.get(core::GenSub::RCOMP).getNumSymbols();  // rcomp
         num_records_per_block[cur_block_num] =
             bdata.block_end[cur_block_num] - bdata.block_start[cur_block_num];  // used later for ids
-        au = core::ReadEncoder::entropyCodeAU(entropycoder, std::move(au), write_raw);
+        au = core::ReadEncoder::entropyCodeAU(entropycoder, std::move(au), write_raw, sections[cur_block_num],
+                                              getLaterDescriptors(cp));
 
         stat_vec[cur_block_num].add(au.getStats());
 
@@ -884,7 +913,7 @@ void generate_read_streams_pe(const std::string &temp_dir, const compression_par
             if (d.isEmpty()) {
                 continue;
             }
-            std::ofstream out(file_to_save_streams + "." + std::to_string(uint8_t(d.getID())), std::ios::binary);
+            TempOutFile out(file_to_save_streams + "." + std::to_string(uint8_t(d.getID())), std::ios::binary);
             util::BitWriter bw(&out);
             d.write(bw);
         }
@@ -903,23 +932,25 @@ void generate_read_streams_pe(const std::string &temp_dir, const compression_par
 
     // write num blocks, reads per block and records per block to a file
     const std::string block_info_file = temp_dir + "/block_info.bin";
-    std::ofstream f_block_info(block_info_file, std::ios::binary);
+    TempOutFile f_block_info(block_info_file, std::ios::binary);
     auto num_blocks = (uint32_t)bdata.block_start.size();
     f_block_info.write(reinterpret_cast<char *>(&num_blocks), sizeof(uint32_t));
     f_block_info.write(reinterpret_cast<char *>(&num_reads_per_block[0]), num_blocks * sizeof(uint32_t));
     f_block_info.write(reinterpret_cast<char *>(&num_records_per_block[0]), num_blocks * sizeof(uint32_t));
+    return sections;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void generate_read_streams(const std::string &temp_dir, const compression_params &cp,
-                           core::ReadEncoder::EntropySelector *entropycoder,
-                           std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
-                           bool write_raw) {
+std::vector<util::Section> generate_read_streams(const std::string &temp_dir, const compression_params &cp,
+                                                 core::ReadEncoder::EntropySelector *entropycoder,
+                                                 uint64_t &first_record,
+                                                 std::vector<core::parameter::EncodingSet> &params,
+                                                 core::stats::PerfStats &stats, bool write_raw) {
     if (!cp.paired_end)
-        generate_read_streams_se(temp_dir, cp, entropycoder, params, stats, write_raw);
+        return generate_read_streams_se(temp_dir, cp, entropycoder, first_record, params, stats, write_raw);
     else
-        generate_read_streams_pe(temp_dir, cp, entropycoder, params, stats, write_raw);
+        return generate_read_streams_pe(temp_dir, cp, entropycoder, first_record, params, stats, write_raw);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -26,12 +26,15 @@ namespace spring {
  * @param temp_dir
  * @param cp
  * @param entropycoder
+ * @param first_record Position of the first record for the entropy coder, advanced past the records of this call
  * @param stats
  * @param write_raw
+ * @return Records of each access unit, in the numbering of first_record
  */
-void generate_read_streams(const std::string &temp_dir, const compression_params &cp,
-                           core::ReadEncoder::EntropySelector *entropycoder,
-                           std::vector<core::parameter::EncodingSet> &, core::stats::PerfStats &stats, bool write_raw);
+std::vector<util::Section> generate_read_streams(const std::string &temp_dir, const compression_params &cp,
+                                                 core::ReadEncoder::EntropySelector *entropycoder,
+                                                 uint64_t &first_record, std::vector<core::parameter::EncodingSet> &,
+                                                 core::stats::PerfStats &stats, bool write_raw);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
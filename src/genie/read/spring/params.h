@@ -43,6 +43,10 @@ const uint32_t MAX_NUM_TOKENS_ID = 1024;           //!< @brief
 const uint32_t BIN_SIZE_COMBINE_PAIRS = 30000000;  //!< @brief number of records put in memory at a time when
                                                    //!< @brief decompressing with combine_pairs on. Higher value
                                                    //!< @brief uses more memory but is slightly faster.
+const int PARTITION_KMER = 21;                     //!< @brief k-mer length of the minimizers that bucket reads
+const int PARTITION_WINDOW = 20;                   //!< @brief number of k-mers per minimizer window
+const uint32_t NUM_PARTITION_BUCKETS = 65536;      //!< @brief number of minimizer buckets partitions are formed from
+const uint64_t MAX_NUM_LINKS = 1 << 24;            //!< @brief bucket pairs counted without a memory budget
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -13,12 +13,17 @@
 #include <cstdint>
 #include <cstdio>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
+#include <vector>
 #include "genie/core/record/record.h"
 #include "genie/read/spring/params.h"
 #include "genie/read/spring/util.h"
 #include "genie/util/drain.h"
+#include "genie/util/make-unique.h"
 #include "genie/util/ordered-section.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -29,16 +34,66 @@ namespace spring {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Preprocessor::setup(const std::string &wdir, size_t num_thr, bool paired_end) {
+/**
+ * @brief Rough upper bound for the memory the global assembly needs per read. Reordering keeps a bitset and the
+ * dictionary entries of every read in memory, the singleton encoding does the same with a wider bitset and locks.
+ * @param max_readlen Maximum read length
+ * @return Bytes per read
+ */
+static uint64_t estimateMemoryPerRead(uint32_t max_readlen) {
+    const uint64_t dict_entry = 2 * sizeof(uint32_t) + sizeof(bool) + 1;  // read_id, startpos, empty_bin, hash
+    const uint64_t reorder = (2 * max_readlen + 63) / 64 * 8 + sizeof(uint16_t) + sizeof(bool) +
+                             NUM_DICT_REORDER * dict_entry + sizeof(uint64_t);
+    uint64_t encoder = (3 * max_readlen + 63) / 64 * 8 + sizeof(uint32_t) + sizeof(uint16_t) + sizeof(bool) +
+                       NUM_DICT_ENCODER * dict_entry + sizeof(uint64_t);
+#ifdef GENIE_USE_OPENMP
+    encoder += 2 * sizeof(omp_lock);
+#endif
+    return std::max(reorder, encoder);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Scramble the bits of a k-mer (splitmix64 finalizer)
+ * @param x Packed k-mer
+ * @return Hash
+ */
+static uint64_t mixKmer(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Preprocessor::setup(const std::string &wdir, size_t num_thr, bool paired_end, bool _in_memory,
+                         uint64_t _memory_budget) {
     cp.preserve_id = true;
     cp.preserve_quality = true;
     cp.num_thr = static_cast<int>(num_thr);
+    cp.paired_end = paired_end;
     working_dir = wdir;
+    in_memory = _in_memory;
+    memory_budget = _memory_budget;
     used = false;
+    partitions.clear();
+    bucket_records.assign(NUM_PARTITION_BUCKETS, 0);
+    bucket_links.clear();
+    // The links take a fraction of the budget, links first seen after that are mostly sequencing errors
+    max_bucket_links = memory_budget ? std::max<uint64_t>(memory_budget / 64, NUM_PARTITION_BUCKETS) : MAX_NUM_LINKS;
+    minimizers.clear();
 
     lock.reset();
 
-    cp.paired_end = paired_end;
+    startPartition();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Preprocessor::startPartition() {
     cp.ureads_flag = false;
     cp.num_reads = 0;
     cp.num_reads_clean[0] = 0;
@@ -54,7 +109,10 @@ void Preprocessor::setup(const std::string &wdir, size_t num_thr, bool paired_en
         if (!ghc::filesystem::exists(temp_dir)) break;
     }
     UTILS_DIE_IF(!ghc::filesystem::create_directory(temp_dir), "Cannot create temporary directory.");
-    std::cerr << "Temporary directory: " << temp_dir << "\n";
+    std::cerr << "Temporary directory: " << temp_dir << (in_memory ? " (in memory)" : "") << "\n";
+    if (in_memory) {
+        keepTempFilesInMemory(temp_dir);
+    }
 
     outfileclean[0] = temp_dir + "/input_clean_1.dna";
     outfileclean[1] = temp_dir + "/input_clean_2.dna";
@@ -65,6 +123,7 @@ void Preprocessor::setup(const std::string &wdir, size_t num_thr, bool paired_en
     outfileid = temp_dir + "/id_1";
     outfilequality[0] = temp_dir + "/quality_1";
     outfilequality[1] = temp_dir + "/quality_2";
+    outfilebucket = temp_dir + "/read_bucket.bin";
 
     for (int j = 0; j < 2; j++) {
         if (j == 1 && !cp.paired_end) continue;
@@ -74,6 +133,7 @@ void Preprocessor::setup(const std::string &wdir, size_t num_thr, bool paired_en
         if (cp.preserve_quality) fout_quality[j].open(outfilequality[j]);
     }
     if (cp.preserve_id) fout_id.open(outfileid);
+    fout_bucket.open(outfilebucket, std::ios::binary);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -85,33 +145,43 @@ void Preprocessor::preprocess(core::record::Chunk &&t, const util::Section &id)
     used = true;
     stats.add(data.getStats());
 
-    UTILS_DIE_IF(
-        data.getData().front().getNumberOfTemplateSegments() * (data.getData().size() + cp.num_reads) > MAX_NUM_READS,
-        "Too many reads in the input. Global assembly only supports up to " + std::to_string(MAX_NUM_READS) +
-            " reads.");
+    const auto &columns = data.getColumns();
+    size_t segments = columns.empty() ? data.getData().front().getNumberOfTemplateSegments()
+                                      : columns.getNumberOfTemplateSegments();
+    UTILS_DIE_IF(uint64_t(cp.num_reads) + data.getNumRecords() > MAX_NUM_READS,
+                 "Too many records. Global assembly only supports up to " + std::to_string(MAX_NUM_READS) +
+                     " records at a time.");
 
     size_t rec_index = 0;
+    std::string sequence;
+    for (size_t r = 0; r < columns.size(); ++r) {
+        UTILS_DIE_IF(segments != (static_cast<size_t>(cp.paired_end + 1)),
+                     "Number of segments differs between global assembly data chunks.");
+        for (size_t seg_index = 0; seg_index < segments; ++seg_index) {
+            auto view = columns.getSequence(r * segments + seg_index);
+            sequence.assign(view.begin(), view.length());
+            preprocessSegment(sequence, columns.getQualities(r * segments + seg_index), seg_index, rec_index);
+            addMinimizers(sequence.data(), sequence.length());
+        }
+        addRecordBucket(rec_index);
+        auto name = columns.getName(r);
+        fout_id.write(name.begin(), name.length()) << "\n";
+        ++rec_index;
+    }
     for (auto &rec : data.getData()) {
         UTILS_DIE_IF(rec.getSegments().size() != (static_cast<size_t>(cp.paired_end + 1)),
                      "Number of segments differs between global assembly data chunks.");
         size_t seg_index = 0;
         for (auto &seq : rec.getSegments()) {
-            UTILS_DIE_IF(seq.getSequence().size() > MAX_READ_LEN,
-                         "Global assembly maximum read length " + std::to_string(MAX_READ_LEN) + " exceeded.");
-            cp.max_readlen = std::max(cp.max_readlen, (uint32_t)seq.getSequence().length());
-            if (seq.getSequence().find('N') != std::string::npos) {
-                write_dnaN_in_bits(seq.getSequence(), fout_N[seg_index]);
-                auto pos_N = static_cast<uint32_t>(cp.num_reads + rec_index);
-                fout_order_N[seg_index].write(reinterpret_cast<char *>(&pos_N), sizeof(uint32_t));
-            } else {
-                write_dna_in_bits(seq.getSequence(), fout_clean[seg_index]);
-                cp.num_reads_clean[seg_index]++;
-            }
+            util::StringView qualities(0, 0, nullptr);
             if (!seq.getQualities().empty()) {
-                fout_quality[seg_index] << seq.getQualities().front() << "\n";
+                qualities = {0, seq.getQualities().front().length(), seq.getQualities().front().data()};
             }
+            preprocessSegment(seq.getSequence(), qualities, seg_index, rec_index);
+            addMinimizers(seq.getSequence().data(), seq.getSequence().length());
             ++seg_index;
         }
+        addRecordBucket(rec_index);
         fout_id << rec.getName() << "\n";
         ++rec_index;
     }
@@ -123,12 +193,141 @@ void Preprocessor::preprocess(core::record::Chunk &&t, const util::Section &id)
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+void Preprocessor::preprocessSegment(const std::string &seq, const util::StringView &qualities, size_t seg_index,
+                                     size_t rec_index) {
+    UTILS_DIE_IF(seq.size() > MAX_READ_LEN,
+                 "Global assembly maximum read length " + std::to_string(MAX_READ_LEN) + " exceeded.");
+    cp.max_readlen = std::max(cp.max_readlen, (uint32_t)seq.length());
+    if (seq.find('N') != std::string::npos) {
+        write_dnaN_in_bits(seq, fout_N[seg_index]);
+        auto pos_N = static_cast<uint32_t>(cp.num_reads + rec_index);
+        fout_order_N[seg_index].write(reinterpret_cast<char *>(&pos_N), sizeof(uint32_t));
+    } else {
+        write_dna_in_bits(seq, fout_clean[seg_index]);
+        cp.num_reads_clean[seg_index]++;
+    }
+    if (qualities.length()) {
+        fout_quality[seg_index].write(qualities.begin(), qualities.length()) << "\n";
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Preprocessor::addMinimizers(const char *seq, size_t length) {
+    const uint64_t none = std::numeric_limits<uint64_t>::max();
+    const uint64_t mask = (uint64_t(1) << (2 * PARTITION_KMER)) - 1;
+    const int shift = 2 * (PARTITION_KMER - 1);
+
+    // Canonical k-mers, so that a read and its reverse complement get the same minimizers. K-mers with N are skipped.
+    kmer_hashes.clear();
+    uint64_t forward = 0;
+    uint64_t reverse = 0;
+    int valid = 0;
+    for (size_t i = 0; i < length; ++i) {
+        uint64_t base;
+        switch (seq[i]) {
+            case 'A':
+                base = 0;
+                break;
+            case 'C':
+                base = 1;
+                break;
+            case 'G':
+                base = 2;
+                break;
+            case 'T':
+                base = 3;
+                break;
+            default:
+                base = 4;
+                break;
+        }
+        if (base == 4) {
+            valid = 0;
+        } else {
+            forward = ((forward << 2) | base) & mask;
+            reverse = (reverse >> 2) | ((3 - base) << shift);
+            valid = std::min(valid + 1, PARTITION_KMER);
+        }
+        if (i + 1 >= PARTITION_KMER) {
+            kmer_hashes.push_back(valid == PARTITION_KMER ? mixKmer(std::min(forward, reverse)) : none);
+        }
+    }
+    if (kmer_hashes.empty()) {
+        return;
+    }
+
+    // Smallest hash of every window, a window is reevaluated only when its minimum drops out
+    const size_t window = std::min<size_t>(PARTITION_WINDOW, kmer_hashes.size());
+    size_t min_pos = 0;
+    for (size_t i = 0; i < kmer_hashes.size(); ++i) {
+        if (min_pos + window <= i) {
+            min_pos = i + 1 - window;
+            for (size_t j = min_pos + 1; j <= i; ++j) {
+                if (kmer_hashes[j] < kmer_hashes[min_pos]) {
+                    min_pos = j;
+                }
+            }
+        } else if (kmer_hashes[i] < kmer_hashes[min_pos]) {
+            min_pos = i;
+        }
+        if (i + 1 >= window && kmer_hashes[min_pos] != none &&
+            (minimizers.empty() || minimizers.back() != kmer_hashes[min_pos])) {
+            minimizers.push_back(kmer_hashes[min_pos]);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Preprocessor::addRecordBucket(size_t rec_index) {
+    // Records without any k-mer are spread over the buckets by their index
+    uint64_t smallest = cp.num_reads + rec_index;
+    if (!minimizers.empty()) {
+        smallest = *std::min_element(minimizers.begin(), minimizers.end());
+    }
+    auto bucket = static_cast<uint16_t>(smallest % NUM_PARTITION_BUCKETS);
+    fout_bucket.write(reinterpret_cast<char *>(&bucket), sizeof(uint16_t));
+    bucket_records[bucket]++;
+
+    uint32_t last = bucket;
+    for (const auto m : minimizers) {
+        const auto linked = static_cast<uint32_t>(m % NUM_PARTITION_BUCKETS);
+        if (linked == bucket || linked == last) {
+            continue;
+        }
+        const uint32_t key =
+            std::min<uint32_t>(bucket, linked) * NUM_PARTITION_BUCKETS + std::max<uint32_t>(bucket, linked);
+        auto it = bucket_links.find(key);
+        if (it != bucket_links.end()) {
+            it->second++;
+        } else if (bucket_links.size() < max_bucket_links) {
+            bucket_links.emplace(key, 1);
+        }
+        last = linked;
+    }
+    minimizers.clear();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void Preprocessor::finish(size_t id) {
     if (!used) {
         return;
     }
     util::Section sec{id, 0, true};
     util::OrderedSection lsec(&lock, sec);
+    const uint64_t reads = (cp.paired_end ? 2 : 1) * uint64_t(cp.num_reads);
+    if (reads > MAX_NUM_READS || (memory_budget && reads * estimateMemoryPerRead(cp.max_readlen) > memory_budget)) {
+        partitionByBucket();
+    } else {
+        finishPartition();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Preprocessor::closePartitionFiles() {
     for (int j = 0; j < 2; j++) {
         if (j == 1 && !cp.paired_end) continue;
         fout_clean[j].close();
@@ -137,17 +336,25 @@ void Preprocessor::finish(size_t id) {
         if (cp.preserve_quality) fout_quality[j].close();
     }
     if (cp.preserve_id) fout_id.close();
+    fout_bucket.close();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Preprocessor::finishPartition() {
+    closePartitionFiles();
+    removeTempFile(outfilebucket);
 
     if (cp.paired_end) {
         // merge input_N and input_order_N for the two files
-        std::ofstream fout_N_PE(outfileN[0], std::ios::app | std::ios::binary);
-        std::ifstream fin_N_PE(outfileN[1], std::ios::binary);
+        TempOutFile fout_N_PE(outfileN[0], std::ios::app | std::ios::binary);
+        TempInFile fin_N_PE(outfileN[1], std::ios::binary);
         fout_N_PE << fin_N_PE.rdbuf();
         fout_N_PE.close();
         fin_N_PE.close();
-        remove(outfileN[1].c_str());
-        std::ofstream fout_order_N_PE(outfileorderN[0], std::ios::app | std::ios::binary);
-        std::ifstream fin_order_N(outfileorderN[1], std::ios::binary);
+        removeTempFile(outfileN[1]);
+        TempOutFile fout_order_N_PE(outfileorderN[0], std::ios::app | std::ios::binary);
+        TempInFile fin_order_N(outfileorderN[1], std::ios::binary);
         uint32_t num_N_file_2 = cp.num_reads - cp.num_reads_clean[1];
         uint32_t order_N;
         for (uint32_t i = 0; i < num_N_file_2; i++) {
@@ -157,7 +364,7 @@ void Preprocessor::finish(size_t id) {
         }
         fin_order_N.close();
         fout_order_N_PE.close();
-        remove(outfileorderN[1].c_str());
+        removeTempFile(outfileorderN[1]);
     }
 
     cp.num_reads = cp.paired_end ? cp.num_reads * 2 : cp.num_reads;
@@ -166,6 +373,219 @@ void Preprocessor::finish(size_t id) {
     std::cerr << "Total number of reads: " << cp.num_reads << "\n";
 
     std::cerr << "Total number of reads without N: " << cp.num_reads_clean[0] + cp.num_reads_clean[1] << "\n";
+    if (memory_budget || !partitions.empty()) {
+        std::cerr << "Partition " << partitions.size() << " estimated memory: "
+                  << cp.num_reads * estimateMemoryPerRead(cp.max_readlen) / (1024 * 1024) << " MiB\n";
+    }
+
+    partitions.push_back({temp_dir, cp});
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Preprocessor::partitionByBucket() {
+    closePartitionFiles();
+    const uint32_t segments = cp.paired_end ? 2 : 1;
+    uint64_t capacity = MAX_NUM_READS / segments;
+    if (memory_budget) {
+        capacity = std::min(capacity, memory_budget / (segments * estimateMemoryPerRead(cp.max_readlen)));
+    }
+    capacity = std::max<uint64_t>(capacity, 1);
+
+    // Merge linked buckets, most links first, as long as the merged buckets still fit into one partition
+    std::vector<uint32_t> parent(NUM_PARTITION_BUCKETS);
+    std::iota(parent.begin(), parent.end(), 0);
+    std::vector<uint64_t> group_records = bucket_records;
+    auto root = [&parent](uint32_t b) {
+        while (parent[b] != b) {
+            parent[b] = parent[parent[b]];
+            b = parent[b];
+        }
+        return b;
+    };
+    std::vector<std::pair<uint64_t, uint32_t>> links;
+    for (const auto &l : bucket_links) {
+        links.emplace_back(l.second, l.first);
+    }
+    std::unordered_map<uint32_t, uint64_t>().swap(bucket_links);
+    std::sort(links.begin(), links.end());
+    std::stable_sort(links.begin(), links.end(),
+                     [](const std::pair<uint64_t, uint32_t> &a, const std::pair<uint64_t, uint32_t> &b) {
+                         return a.first > b.first;
+                     });
+    for (const auto &l : links) {
+        uint32_t a = root(l.second / NUM_PARTITION_BUCKETS);
+        uint32_t b = root(l.second % NUM_PARTITION_BUCKETS);
+        if (a == b || group_records[a] + group_records[b] > capacity) {
+            continue;
+        }
+        if (b < a) {
+            std::swap(a, b);
+        }
+        parent[b] = a;
+        group_records[a] += group_records[b];
+    }
+
+    // Pack the merged buckets into partitions, largest first. Only a single bucket larger than a partition is split.
+    std::vector<std::vector<uint32_t>> groups(NUM_PARTITION_BUCKETS);
+    std::vector<uint32_t> order;
+    for (uint32_t b = 0; b < NUM_PARTITION_BUCKETS; ++b) {
+        if (bucket_records[b]) {
+            groups[root(b)].push_back(b);
+        }
+    }
+    for (uint32_t r = 0; r < NUM_PARTITION_BUCKETS; ++r) {
+        if (!groups[r].empty()) {
+            order.push_back(r);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&group_records](uint32_t a, uint32_t b) { return group_records[a] > group_records[b]; });
+    std::vector<std::vector<std::pair<size_t, uint64_t>>> routes(NUM_PARTITION_BUCKETS);  // Partition, records
+    std::vector<uint64_t> fill;
+    for (const auto r : order) {
+        if (group_records[r] <= capacity) {
+            size_t p = 0;
+            while (p < fill.size() && fill[p] + group_records[r] > capacity) {
+                ++p;
+            }
+            if (p == fill.size()) {
+                fill.push_back(0);
+            }
+            fill[p] += group_records[r];
+            for (const auto b : groups[r]) {
+                routes[b].emplace_back(p, bucket_records[b]);
+            }
+            continue;
+        }
+        for (const auto b : groups[r]) {
+            uint64_t remaining = bucket_records[b];
+            while (remaining) {
+                if (fill.empty() || fill.back() == capacity) {
+                    fill.push_back(0);
+                }
+                const uint64_t records = std::min(remaining, capacity - fill.back());
+                routes[b].emplace_back(fill.size() - 1, records);
+                fill.back() += records;
+                remaining -= records;
+            }
+        }
+    }
+
+    // Links between partitions are the contig joins the budget forced apart
+    uint64_t total_links = 0;
+    uint64_t split_links = 0;
+    for (const auto &l : links) {
+        const auto &a = routes[l.second / NUM_PARTITION_BUCKETS];
+        const auto &b = routes[l.second % NUM_PARTITION_BUCKETS];
+        if (a.empty() || b.empty()) {
+            continue;
+        }
+        total_links += l.first;
+        if (a.front().first != b.front().first) {
+            split_links += l.first;
+        }
+    }
+    stats.addInteger("spring-bucket-links", total_links);
+    stats.addInteger("spring-bucket-links-split", split_links);
+    std::cerr << "Records linking minimizer buckets: " << total_links << ", split across partitions: " << split_links
+              << "\n";
+
+    // Each partition is written by a preprocessor of its own
+    std::vector<std::unique_ptr<Preprocessor>> writers;
+    for (size_t p = 0; p < fill.size(); ++p) {
+        writers.emplace_back(util::make_unique<Preprocessor>());
+        writers.back()->setup(working_dir, cp.num_thr, cp.paired_end, in_memory);
+        writers.back()->used = true;
+    }
+
+    TempInFile fin_clean[2];
+    TempInFile fin_N[2];
+    TempInFile fin_order_N[2];
+    TempInFile fin_quality[2];
+    TempInFile fin_id;
+    TempInFile fin_bucket(outfilebucket, std::ios::binary);
+    uint32_t num_N[2] = {0, 0};
+    uint32_t next_N[2] = {std::numeric_limits<uint32_t>::max(), std::numeric_limits<uint32_t>::max()};
+    bool has_quality[2] = {false, false};
+    for (uint32_t j = 0; j < segments; ++j) {
+        fin_clean[j].open(outfileclean[j], std::ios::binary);
+        fin_N[j].open(outfileN[j], std::ios::binary);
+        fin_order_N[j].open(outfileorderN[j], std::ios::binary);
+        num_N[j] = cp.num_reads - cp.num_reads_clean[j];
+        if (num_N[j]) {
+            fin_order_N[j].read(reinterpret_cast<char *>(&next_N[j]), sizeof(uint32_t));
+        }
+        has_quality[j] = cp.preserve_quality && getTempFileSize(outfilequality[j]) > 0;
+        if (has_quality[j]) {
+            fin_quality[j].open(outfilequality[j]);
+        }
+    }
+    if (cp.preserve_id) {
+        fin_id.open(outfileid);
+    }
+
+    std::vector<size_t> next_route(NUM_PARTITION_BUCKETS, 0);
+    std::string sequence;
+    std::string qualities;
+    std::string name;
+    for (uint32_t i = 0; i < cp.num_reads; ++i) {
+        uint16_t bucket;
+        fin_bucket.read(reinterpret_cast<char *>(&bucket), sizeof(uint16_t));
+        auto &route = routes[bucket][next_route[bucket]];
+        Preprocessor &writer = *writers[route.first];
+        if (--route.second == 0) {
+            ++next_route[bucket];
+        }
+        for (uint32_t j = 0; j < segments; ++j) {
+            if (next_N[j] == i) {
+                read_dnaN_from_bits(sequence, fin_N[j]);
+                if (--num_N[j]) {
+                    fin_order_N[j].read(reinterpret_cast<char *>(&next_N[j]), sizeof(uint32_t));
+                }
+            } else {
+                read_dna_from_bits(sequence, fin_clean[j]);
+            }
+            util::StringView view(0, 0, nullptr);
+            if (has_quality[j]) {
+                std::getline(fin_quality[j], qualities);
+                view = {0, qualities.length(), qualities.data()};
+            }
+            writer.preprocessSegment(sequence, view, j, 0);
+        }
+        if (cp.preserve_id) {
+            std::getline(fin_id, name);
+            writer.fout_id << name << "\n";
+        }
+        writer.cp.num_reads++;
+    }
+
+    for (uint32_t j = 0; j < segments; ++j) {
+        fin_clean[j].close();
+        fin_N[j].close();
+        fin_order_N[j].close();
+        if (has_quality[j]) fin_quality[j].close();
+        removeTempFile(outfileclean[j]);
+        removeTempFile(outfileN[j]);
+        removeTempFile(outfileorderN[j]);
+        if (cp.preserve_quality) removeTempFile(outfilequality[j]);
+    }
+    if (cp.preserve_id) {
+        fin_id.close();
+        removeTempFile(outfileid);
+    }
+    fin_bucket.close();
+    removeTempFile(outfilebucket);
+    removeTempDirectory(temp_dir);
+
+    for (auto &writer : writers) {
+        writer->finishPartition();
+        partitions.push_back(writer->partitions.front());
+        std::cerr << "Partition " << partitions.size() - 1 << " estimated memory: "
+                  << partitions.back().cp.num_reads * estimateMemoryPerRead(partitions.back().cp.max_readlen) /
+                         (1024 * 1024)
+                  << " MiB\n";
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -176,25 +596,19 @@ core::stats::PerfStats &Preprocessor::getStats() { return stats; }
 
 Preprocessor::~Preprocessor() {
     if (!used) {
-        for (int j = 0; j < 2; j++) {
-            if (j == 1 && !cp.paired_end) continue;
-            fout_clean[j].close();
-            fout_N[j].close();
-            fout_order_N[j].close();
-            if (cp.preserve_quality) fout_quality[j].close();
-        }
-        if (cp.preserve_id) fout_id.close();
+        closePartitionFiles();
+        removeTempFile(outfilebucket);
 
         for (int j = 0; j < 2; j++) {
             if (j == 1 && !cp.paired_end) continue;
-            ghc::filesystem::remove(outfileclean[j]);
-            ghc::filesystem::remove(outfileN[j]);
-            ghc::filesystem::remove(outfileorderN[j]);
-            if (cp.preserve_quality) ghc::filesystem::remove(outfilequality[j]);
+            removeTempFile(outfileclean[j]);
+            removeTempFile(outfileN[j]);
+            removeTempFile(outfileorderN[j]);
+            if (cp.preserve_quality) removeTempFile(outfilequality[j]);
         }
-        if (cp.preserve_id) ghc::filesystem::remove(outfileid);
+        if (cp.preserve_id) removeTempFile(outfileid);
 
-        ghc::filesystem::remove(temp_dir);
+        removeTempDirectory(temp_dir);
     }
 }
 
@@ -9,13 +9,17 @@
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "filesystem/filesystem.hpp"
 #include "genie/core/record/chunk.h"
 #include "genie/read/spring/util.h"
 #include "genie/util/drain.h"
 #include "genie/util/ordered-lock.h"
 #include "genie/util/ordered-section.h"
+#include "genie/util/stringview.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -23,6 +27,16 @@ namespace genie {
 namespace read {
 namespace spring {
 
+/**
+ * @brief Reads of one reordering partition, preprocessed but not compressed yet
+ */
+struct PreprocessedPartition {
+    std::string temp_dir;   //!< @brief Temporary directory holding the files of the partition
+    compression_params cp;  //!< @brief Parameters describing the reads of the partition
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 /**
  * @brief
  */
@@ -35,15 +49,27 @@ struct Preprocessor {
     std::string outfileid;             //!< @brief
     std::string outfilequality[2];     //!< @brief
     std::string outfilereadlength[2];  //!< @brief
+    std::string outfilebucket;         //!< @brief
+
+    TempOutFile fout_clean[2];    //!< @brief
+    TempOutFile fout_N[2];        //!< @brief
+    TempOutFile fout_order_N[2];  //!< @brief
+    TempOutFile fout_id;          //!< @brief
+    TempOutFile fout_quality[2];  //!< @brief
+    TempOutFile fout_bucket;      //!< @brief Minimizer bucket of each record
+
+    std::string temp_dir;        //!< @brief
+    std::string working_dir;     //!< @brief
+    bool in_memory = false;      //!< @brief Keep the temporary files in memory
+    uint64_t memory_budget = 0;  //!< @brief Approximate reordering memory per partition in bytes, 0 for no limit
 
-    std::ofstream fout_clean[2];    //!< @brief
-    std::ofstream fout_N[2];        //!< @brief
-    std::ofstream fout_order_N[2];  //!< @brief
-    std::ofstream fout_id;          //!< @brief
-    std::ofstream fout_quality[2];  //!< @brief
+    std::vector<PreprocessedPartition> partitions;  //!< @brief Finished partitions
 
-    std::string temp_dir;     //!< @brief
-    std::string working_dir;  //!< @brief
+    std::vector<uint64_t> bucket_records;                 //!< @brief Number of records per minimizer bucket
+    std::unordered_map<uint32_t, uint64_t> bucket_links;  //!< @brief Records linking two buckets, by bucket pair
+    uint64_t max_bucket_links = 0;                        //!< @brief Number of bucket pairs counted at most
+    std::vector<uint64_t> minimizers;                     //!< @brief Window minimizers of the current record
+    std::vector<uint64_t> kmer_hashes;                    //!< @brief K-mer hashes of the current segment
 
     util::OrderedLock lock;  //!< @brief
 
@@ -62,8 +88,36 @@ struct Preprocessor {
      * @param working_dir
      * @param num_thr
      * @param paired_end
+     * @param in_memory Keep the temporary files in memory instead of the working directory
+     * @param memory_budget Approximate reordering memory per partition in bytes, 0 for no limit
+     */
+    void setup(const std::string& working_dir, size_t num_thr, bool paired_end, bool in_memory,
+               uint64_t memory_budget = 0);
+
+    /**
+     * @brief Create a new temporary directory and open the files of a new partition
+     */
+    void startPartition();
+
+    /**
+     * @brief Close the files of the current partition and append it to the finished partitions
+     */
+    void finishPartition();
+
+    /**
+     * @brief Close the temporary files of the current partition
+     */
+    void closePartitionFiles();
+
+    /**
+     * @brief Split the finished input into partitions by minimizer bucket. Every record goes to the bucket of its
+     * smallest canonical k-mer and links it to the buckets of its window minimizers. Reads overlapping by at least
+     * one window share a window minimizer, so the reads of a contig form a connected set of buckets. Before the
+     * buckets are packed into partitions, linked buckets are merged, most links first, as long as they fit into one
+     * partition. A bucket holds several genome regions once there are more minimizers than buckets, so the merge
+     * keeps fewer contigs together on large genomes. The links left between partitions are reported.
      */
-    void setup(const std::string& working_dir, size_t num_thr, bool paired_end);
+    void partitionByBucket();
 
     /**
      * @brief
@@ -77,6 +131,30 @@ struct Preprocessor {
      */
     void preprocess(core::record::Chunk&& t, const util::Section& id);
 
+    /**
+     * @brief Write one segment to the temporary files
+     * @param seq Sequence
+     * @param qualities Quality values, empty if there are none
+     * @param seg_index Segment index in the record
+     * @param rec_index Record index in the chunk
+     */
+    void preprocessSegment(const std::string& seq, const util::StringView& qualities, size_t seg_index,
+                           size_t rec_index);
+
+    /**
+     * @brief Add the window minimizers of one segment to the minimizers of the current record
+     * @param seq Sequence
+     * @param length Sequence length
+     */
+    void addMinimizers(const char* seq, size_t length);
+
+    /**
+     * @brief Write the minimizer bucket of the current record and count its links to the buckets of its other window
+     * minimizers
+     * @param rec_index Record index in the chunk
+     */
+    void addRecordBucket(size_t rec_index);
+
     /**
      * @brief
      * @param id
@@ -84,7 +162,8 @@ struct Preprocessor {
     void skip(const util::Section& id);
 
     /**
-     * @brief
+     * @brief Finish the input. It stays one partition if it fits into the memory budget and the global assembly
+     * limit, otherwise it is split by minimizer bucket.
      * @param pos
      */
     void finish(size_t pos);
@@ -36,6 +36,7 @@ void reorder_compress_quality_id(const std::string &temp_dir, const compression_
                                  genie::core::ReadEncoder::QvSelector *qv_coder,
                                  genie::core::ReadEncoder::NameSelector *name_coder,
                                  genie::core::ReadEncoder::EntropySelector *entropy,
+                                 const std::vector<util::Section> &sections,
                                  std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
                                  bool write_raw) {
     // Read some parameters
@@ -73,17 +74,17 @@ void reorder_compress_quality_id(const std::string &temp_dir, const compression_
             std::cerr << "Compressing qualities\n";
             uint32_t num_reads_per_file = numreads;
             reorder_compress(file_quality[0], temp_dir, num_reads_per_file, num_thr, num_reads_per_block, str_array,
-                             str_array_size, order_array, "quality", qv_coder, name_coder, entropy, params, stats,
-                             write_raw);
-            remove(file_quality[0].c_str());
+                             str_array_size, order_array, "quality", qv_coder, name_coder, entropy, sections, params,
+                             stats, write_raw);
+            removeTempFile(file_quality[0]);
         }
         if (preserve_id) {
             std::cerr << "Compressing ids\n";
             uint32_t num_reads_per_file = numreads;
             reorder_compress(file_id, temp_dir, num_reads_per_file, num_thr, num_reads_per_block, str_array,
-                             str_array_size, order_array, "id", qv_coder, name_coder, entropy, params, stats,
+                             str_array_size, order_array, "id", qv_coder, name_coder, entropy, sections, params, stats,
                              write_raw);
-            remove(file_id.c_str());
+            removeTempFile(file_id);
         }
 
         delete[] order_array;
@@ -109,31 +110,31 @@ void reorder_compress_quality_id(const std::string &temp_dir, const compression_
             // (needed because block sizes are not exactly equal to
             // num_reads_per_block
             reorder_compress_quality_pe(file_quality, outfile_quality, temp_dir, quality_array, quality_array_size,
-                                        order_array, block_start, block_end, cp, qv_coder, entropy, params, stats,
-                                        write_raw);
+                                        order_array, block_start, block_end, cp, qv_coder, entropy, sections, params,
+                                        stats, write_raw);
             delete[] quality_array;
             delete[] order_array;
-            remove(file_quality[0].c_str());
-            remove(file_quality[1].c_str());
+            removeTempFile(file_quality[0]);
+            removeTempFile(file_quality[1]);
             block_start.clear();
             block_end.clear();
         }
         if (preserve_id) {
             read_block_start_end(file_blocks_id, block_start, block_end);
             std::string *id_array = new std::string[numreads / 2];
-            std::ifstream f_id(file_id);
+            TempInFile f_id(file_id);
             for (uint32_t i = 0; i < numreads / 2; i++) std::getline(f_id, id_array[i]);
             reorder_compress_id_pe(id_array, temp_dir, file_order_id, block_start, block_end, file_id, cp, name_coder,
-                                   entropy, params, stats, write_raw);
+                                   entropy, sections, params, stats, write_raw);
             delete[] id_array;
-            for (uint32_t i = 0; i < block_start.size(); i++) remove((file_order_id + "." + std::to_string(i)).c_str());
-            remove(file_id.c_str());
+            for (uint32_t i = 0; i < block_start.size(); i++) removeTempFile(file_order_id + "." + std::to_string(i));
+            removeTempFile(file_id);
             block_start.clear();
             block_end.clear();
         }
-        remove(file_order_quality.c_str());
-        remove(file_blocks_quality.c_str());
-        remove(file_blocks_quality.c_str());
+        removeTempFile(file_order_quality);
+        removeTempFile(file_blocks_quality);
+        removeTempFile(file_blocks_quality);
     }
 }
 
@@ -141,7 +142,7 @@ void reorder_compress_quality_id(const std::string &temp_dir, const compression_
 
 void read_block_start_end(const std::string &file_blocks, std::vector<uint32_t> &block_start,
                           std::vector<uint32_t> &block_end) {
-    std::ifstream f_blocks(file_blocks, std::ios::binary);
+    TempInFile f_blocks(file_blocks, std::ios::binary);
     uint32_t block_pos_temp;
     f_blocks.read(reinterpret_cast<char *>(&block_pos_temp), sizeof(uint32_t));
     while (!f_blocks.eof()) {
@@ -156,7 +157,7 @@ void read_block_start_end(const std::string &file_blocks, std::vector<uint32_t>
 // ---------------------------------------------------------------------------------------------------------------------
 
 void generate_order(const std::string &file_order, uint32_t *order_array, const uint32_t &numreads) {
-    std::ifstream fin_order(file_order, std::ios::binary);
+    TempInFile fin_order(file_order, std::ios::binary);
     uint32_t order;
     for (uint32_t i = 0; i < numreads; i++) {
         fin_order.read(reinterpret_cast<char *>(&order), sizeof(uint32_t));
@@ -172,6 +173,7 @@ void reorder_compress_id_pe(std::string *id_array, const std::string &temp_dir,
                             const std::string &file_name, const compression_params &cp,
                             genie::core::ReadEncoder::NameSelector *name_coder,
                             genie::core::ReadEncoder::EntropySelector *entropy,
+                            const std::vector<util::Section> &sections,
                             std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
                             bool write_raw) {
     const std::string id_desc_prefix = temp_dir + "/id_streams.";
@@ -183,7 +185,7 @@ void reorder_compress_id_pe(std::string *id_array, const std::string &temp_dir,
 #pragma omp parallel for num_threads(cp.num_thr) schedule(dynamic)
 #endif
     for (int64_t block_num = 0; block_num < static_cast<int64_t>(block_start.size()); block_num++) {
-        std::ifstream f_order_id(file_order_id + "." + std::to_string(block_num), std::ios::binary);
+        TempInFile f_order_id(file_order_id + "." + std::to_string(block_num), std::ios::binary);
         std::string *id_array_block = new std::string[block_end[block_num] - block_start[block_num]];
         uint32_t index;
         for (uint32_t j = block_start[block_num]; j < block_end[block_num]; j++) {
@@ -205,19 +207,19 @@ void reorder_compress_id_pe(std::string *id_array, const std::string &temp_dir,
                 if (std::get<0>(raw_desc).get(i).isEmpty()) {
                     continue;
                 }
-                std::ofstream out_file_stream("rawstream_" + std::to_string(block_num) + "_" +
+                TempOutFile out_file_stream("rawstream_" + std::to_string(block_num) + "_" +
                                               std::to_string(static_cast<uint8_t>(genie::core::GenDesc::RNAME)) + "_" +
                                               std::to_string(static_cast<uint8_t>(i)));
                 out_file_stream.write(static_cast<char *>(std::get<0>(raw_desc).get(i).getData().getData()),
                                       std::get<0>(raw_desc).get(i).getData().getRawSize());
             }
         }
-        auto encoded = entropy->process(std::get<0>(raw_desc));
+        auto encoded = entropy->process(std::get<0>(raw_desc), sections[block_num]);
         stat_vec[block_num].add(std::get<2>(encoded));
         std::string name = file_name + "." + std::to_string(block_num);
         params[block_num].setDescriptor(core::GenDesc::RNAME, std::move(std::get<0>(encoded)));
         std::string file_to_save_streams = id_desc_prefix + std::to_string(block_num);
-        std::ofstream outfile(file_to_save_streams, std::ios::binary);
+        TempOutFile outfile(file_to_save_streams, std::ios::binary);
         util::BitWriter bw(&outfile);
         std::get<1>(encoded).write(bw);
 
@@ -238,6 +240,7 @@ void reorder_compress_quality_pe(std::string file_quality[2], const std::string
                                  const std::vector<uint32_t> &block_start, const std::vector<uint32_t> &block_end,
                                  const compression_params &cp, genie::core::ReadEncoder::QvSelector *qv_coder,
                                  genie::core::ReadEncoder::EntropySelector *entropy,
+                                 const std::vector<util::Section> &sections,
                                  std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
                                  bool write_raw) {
     const std::string quality_desc_prefix = temp_dir + "/quality_streams.";
@@ -253,7 +256,7 @@ void reorder_compress_quality_pe(std::string file_quality[2], const std::string
         }
         std::string temp_str;
         for (int j = 0; j < 2; j++) {
-            std::ifstream f_in(file_quality[j]);
+            TempInFile f_in(file_quality[j]);
             uint32_t num_reads_offset = j * (cp.num_reads / 2);
             for (uint32_t i = 0; i < cp.num_reads / 2; i++) {
                 std::getline(f_in, temp_str);
@@ -289,7 +292,7 @@ void reorder_compress_quality_pe(std::string file_quality[2], const std::string
                     if (std::get<1>(raw_desc).get(i).isEmpty()) {
                         continue;
                     }
-                    std::ofstream out_file_stream("rawstream_" + std::to_string(block_num) + "_" +
+                    TempOutFile out_file_stream("rawstream_" + std::to_string(block_num) + "_" +
                                                   std::to_string(static_cast<uint8_t>(genie::core::GenDesc::QV)) + "_" +
                                                   std::to_string(static_cast<uint8_t>(i)));
                     out_file_stream.write(static_cast<char *>(std::get<1>(raw_desc).get(i).getData().getData()),
@@ -297,12 +300,12 @@ void reorder_compress_quality_pe(std::string file_quality[2], const std::string
                 }
             }
 
-            auto encoded = entropy->process(std::get<1>(raw_desc));
+            auto encoded = entropy->process(std::get<1>(raw_desc), sections[block_num]);
             stat_vec[block_num - start_block_num].add(std::get<2>(encoded));
             params[block_num].addClass(core::record::ClassType::CLASS_U, std::move(std::get<0>(raw_desc)));
             params[block_num].setDescriptor(core::GenDesc::QV, std::move(std::get<0>(encoded)));
             std::string file_to_save_streams = quality_desc_prefix + std::to_string(block_num);
-            std::ofstream out(file_to_save_streams, std::ios::binary);
+            TempOutFile out(file_to_save_streams, std::ios::binary);
             util::BitWriter bw(&out);
             std::get<1>(encoded).write(bw);
         }
@@ -322,6 +325,7 @@ void reorder_compress(const std::string &file_name, const std::string &temp_dir,
                       genie::core::ReadEncoder::QvSelector *qv_coder,
                       genie::core::ReadEncoder::NameSelector *name_coder,
                       genie::core::ReadEncoder::EntropySelector *entropy,
+                      const std::vector<util::Section> &sections,
                       std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
                       bool write_raw) {
     const std::string id_desc_prefix = temp_dir + "/id_streams.";
@@ -333,7 +337,7 @@ void reorder_compress(const std::string &file_name, const std::string &temp_dir,
         uint32_t start_read_bin = ndex * str_array_size;
         uint32_t end_read_bin = ndex * str_array_size + num_reads_bin;
         // Read the file and pick up lines corresponding to this bin
-        std::ifstream f_in(file_name);
+        TempInFile f_in(file_name);
         std::string temp_str;
         for (uint32_t i = 0; i < num_reads_per_file; i++) {
             std::getline(f_in, temp_str);
@@ -394,7 +398,7 @@ void reorder_compress(const std::string &file_name, const std::string &temp_dir,
                         if (std::get<0>(name_raw).get(i).isEmpty()) {
                             continue;
                         }
-                        std::ofstream out_file_stream(
+                        TempOutFile out_file_stream(
                             "rawstream_" + std::to_string(block_num_offset + block_num) + "_" +
                             std::to_string(static_cast<uint8_t>(genie::core::GenDesc::RNAME)) + "_" +
                             std::to_string(static_cast<uint8_t>(i)));
@@ -403,12 +407,12 @@ void reorder_compress(const std::string &file_name, const std::string &temp_dir,
                     }
                 }
 
-                auto encoded = entropy->process(std::get<0>(name_raw));
+                auto encoded = entropy->process(std::get<0>(name_raw), sections[block_num_offset + block_num]);
                 stat_vec[block_num].add(std::get<2>(encoded));
                 params[block_num_offset + block_num].setDescriptor(core::GenDesc::RNAME,
                                                                    std::move(std::get<0>(encoded)));
                 std::string file_to_save_streams = id_desc_prefix + std::to_string(block_num_offset + block_num);
-                std::ofstream out(file_to_save_streams, std::ios::binary);
+                TempOutFile out(file_to_save_streams, std::ios::binary);
                 util::BitWriter bw(&out);
                 std::get<1>(encoded).write(bw);
             } else /* mode == "quality" */ {
@@ -428,7 +432,7 @@ void reorder_compress(const std::string &file_name, const std::string &temp_dir,
                         if (std::get<1>(qv_str).get(i).isEmpty()) {
                             continue;
                         }
-                        std::ofstream out_file_stream("rawstream_" + std::to_string(block_num_offset + block_num) +
+                        TempOutFile out_file_stream("rawstream_" + std::to_string(block_num_offset + block_num) +
                                                       "_" +
                                                       std::to_string(static_cast<uint8_t>(genie::core::GenDesc::QV)) +
                                                       "_" + std::to_string(static_cast<uint8_t>(i)));
@@ -437,13 +441,13 @@ void reorder_compress(const std::string &file_name, const std::string &temp_dir,
                     }
                 }
 
-                auto encoded = entropy->process(std::get<1>(qv_str));
+                auto encoded = entropy->process(std::get<1>(qv_str), sections[block_num_offset + block_num]);
                 stat_vec[block_num].add(std::get<2>(encoded));
                 params[block_num_offset + block_num].addClass(core::record::ClassType::CLASS_U,
                                                               std::move(std::get<0>(qv_str)));
                 params[block_num_offset + block_num].setDescriptor(core::GenDesc::QV, std::move(std::get<0>(encoded)));
                 std::string file_to_save_streams = quality_desc_prefix + std::to_string(block_num_offset + block_num);
-                std::ofstream out(file_to_save_streams, std::ios::binary);
+                TempOutFile out(file_to_save_streams, std::ios::binary);
                 util::BitWriter bw(&out);
                 std::get<1>(encoded).write(bw);
             }
@@ -30,6 +30,7 @@ namespace spring {
  * @param qv_coder
  * @param name_coder
  * @param entropy
+ * @param sections Records of the access unit of each block, qualities and names belong to it
  * @param params
  * @param stats
  * @param write_raw
@@ -38,6 +39,7 @@ void reorder_compress_quality_id(const std::string &temp_dir, const compression_
                                  genie::core::ReadEncoder::QvSelector *qv_coder,
                                  genie::core::ReadEncoder::NameSelector *name_coder,
                                  genie::core::ReadEncoder::EntropySelector *entropy,
+                                 const std::vector<util::Section> &sections,
                                  std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
                                  bool write_raw);
 
@@ -69,6 +71,7 @@ void read_block_start_end(const std::string &file_blocks, std::vector<uint32_t>
  * @param cp
  * @param name_coder
  * @param entropy
+ * @param sections Records of the access unit of each block, qualities and names belong to it
  * @param params
  * @param stats
  * @param write_raw
@@ -78,6 +81,7 @@ void reorder_compress_id_pe(std::string *id_array, const std::string &temp_dir,
                             const std::string &file_name, const compression_params &cp,
                             genie::core::ReadEncoder::NameSelector *name_coder,
                             genie::core::ReadEncoder::EntropySelector *entropy,
+                            const std::vector<util::Section> &sections,
                             std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
                             bool write_raw);
 
@@ -94,6 +98,7 @@ void reorder_compress_id_pe(std::string *id_array, const std::string &temp_dir,
  * @param cp
  * @param qv_coder
  * @param entropy
+ * @param sections Records of the access unit of each block, qualities and names belong to it
  * @param params
  * @param stats
  * @param write_raw
@@ -104,6 +109,7 @@ void reorder_compress_quality_pe(std::string file_quality[2], const std::string
                                  const std::vector<uint32_t> &block_start, const std::vector<uint32_t> &block_end,
                                  const compression_params &cp, genie::core::ReadEncoder::QvSelector *qv_coder,
                                  genie::core::ReadEncoder::EntropySelector *entropy,
+                                 const std::vector<util::Section> &sections,
                                  std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats,
                                  bool write_raw);
 
@@ -121,6 +127,7 @@ void reorder_compress_quality_pe(std::string file_quality[2], const std::string
  * @param qv_coder
  * @param name_coder
  * @param entropy
+ * @param sections Records of the access unit of each block, qualities and names belong to it
  * @param params
  * @param stats
  * @param write_raw
@@ -131,6 +138,7 @@ void reorder_compress(const std::string &file_name, const std::string &temp_dir,
                       genie::core::ReadEncoder::QvSelector *qv_coder,
                       genie::core::ReadEncoder::NameSelector *name_coder,
                       genie::core::ReadEncoder::EntropySelector *entropy,
+                      const std::vector<util::Section> &sections,
                       std::vector<core::parameter::EncodingSet> &params, core::stats::PerfStats &stats, bool write_raw);
 
 // ---------------------------------------------------------------------------------------------------------------------
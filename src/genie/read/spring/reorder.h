@@ -57,10 +57,8 @@ struct reorder_global {
 
     bool paired_end;  //!< @brief
 
-    std::bitset<bitset_size> **basemask;  //!< @brief bitset for A,G,C,T at each position used in stringtobitset,
-                                          //!< chartobitset and bitsettostring (alloc in construtctor)
-    std::bitset<bitset_size>
-        mask64;  //!< @brief bitset with 64 bits set to 1 (used in bitsettostring for conversion to ullong)
+    std::bitset<bitset_size> **basemask;  //!< @brief bitset for A,G,C,T at each position used in stringtobitset
+                                          //!< and chartobitset (alloc in construtctor)
 
     /**
      * @brief
@@ -80,10 +78,9 @@ struct reorder_global {
  * @param b
  * @param s
  * @param readlen
- * @param rg
  */
 template <size_t bitset_size>
-void bitsettostring(std::bitset<bitset_size> b, char *s, const uint16_t readlen, const reorder_global<bitset_size> &rg);
+void bitsettostring(const std::bitset<bitset_size> &b, char *s, const uint16_t readlen);
 
 /**
  * @brief
@@ -126,7 +123,6 @@ void readDnaFile(std::bitset<bitset_size> *read, uint16_t *read_lengths, const r
  * @brief
  * @tparam bitset_size
  * @param ref
- * @param mask1
  * @param mask
  * @param read_lengths
  * @param remainingreads
@@ -141,7 +137,7 @@ void readDnaFile(std::bitset<bitset_size> *read, uint16_t *read_lengths, const r
  * @note  the search_match() function is invoked from within the OpenMP parallel region in reorder().
  */
 template <size_t bitset_size>
-bool search_match(const std::bitset<bitset_size> &ref, std::bitset<bitset_size> *mask1,
+bool search_match(const std::bitset<bitset_size> &ref,
 #ifdef GENIE_USE_OPENMP
                   omp_lock *dict_lock, omp_lock *read_lock,
 #endif
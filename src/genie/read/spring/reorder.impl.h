@@ -38,15 +38,11 @@ reorder_global<bitset_size>::~reorder_global() {
 // ---------------------------------------------------------------------------------------------------------------------
 
 template <size_t bitset_size>
-void bitsettostring(std::bitset<bitset_size> b, char *s, const uint16_t readlen,
-                    const reorder_global<bitset_size> &rg) {
-    // destroys bitset b
+void bitsettostring(const std::bitset<bitset_size> &b, char *s, const uint16_t readlen) {
     static const char revinttochar[4] = {'A', 'G', 'C', 'T'};
-    uint64_t ull;
-    for (int i = 0; i < 2 * readlen / 64 + 1; i++) {
-        ull = (b & rg.mask64).to_ullong();
-        b >>= 64;
-        for (int j = 32 * i; j < 32 * i + 32 && j < readlen; j++) {
+    for (int i = 0; i < readlen; i += 32) {
+        uint64_t ull = extractbits<bitset_size>(b, 2 * i, 64);
+        for (int j = i; j < i + 32 && j < readlen; j++) {
             s[j] = revinttochar[ull % 4];
             ull /= 4;
         }
@@ -59,7 +55,6 @@ void bitsettostring(std::bitset<bitset_size> b, char *s, const uint16_t readlen,
 
 template <size_t bitset_size>
 void setglobalarrays(reorder_global<bitset_size> &rg) {
-    for (int i = 0; i < 64; i++) rg.mask64[i] = 1;
     for (int i = 0; i < rg.max_readlen; i++) {
         rg.basemask[i][(uint8_t)'A'][2 * i] = 0;
         rg.basemask[i][(uint8_t)'A'][2 * i + 1] = 0;
@@ -84,7 +79,7 @@ void updaterefcount(std::bitset<bitset_size> &cur, std::bitset<bitset_size> &ref
     static const char inttochar[4] = {'A', 'C', 'T', 'G'};
     auto chartoint = [](uint8_t a) { return (a & 0x06) >> 1; };  // inverse of above
     char s[MAX_READ_LEN + 1], s1[MAX_READ_LEN + 1], *current;
-    bitsettostring<bitset_size>(cur, s, cur_readlen, rg);
+    bitsettostring<bitset_size>(cur, s, cur_readlen);
     if (rev == false) {
         current = s;
     } else {
@@ -176,23 +171,23 @@ void updaterefcount(std::bitset<bitset_size> &cur, std::bitset<bitset_size> &ref
 
 template <size_t bitset_size>
 void readDnaFile(std::bitset<bitset_size> *read, uint16_t *read_lengths, const reorder_global<bitset_size> &rg) {
-    std::ifstream f(rg.infile[0], std::ifstream::in | std::ios::binary);
+    TempInFile f(rg.infile[0], TempInFile::in | std::ios::binary);
     for (uint32_t i = 0; i < rg.numreads_array[0]; i++) {
         f.read(reinterpret_cast<char *>(&read_lengths[i]), sizeof(uint16_t));
         uint16_t num_bytes_to_read = ((uint32_t)read_lengths[i] + 4 - 1) / 4;
         f.read(reinterpret_cast<char *>(&read[i]), num_bytes_to_read);
     }
     f.close();
-    remove(rg.infile[0].c_str());
+    removeTempFile(rg.infile[0]);
     if (rg.paired_end) {
-        f.open(rg.infile[1], std::ifstream::in | std::ios::binary);
+        f.open(rg.infile[1], TempInFile::in | std::ios::binary);
         for (uint32_t i = rg.numreads_array[0]; i < rg.numreads_array[0] + rg.numreads_array[1]; i++) {
             f.read(reinterpret_cast<char *>(&read_lengths[i]), sizeof(uint16_t));
             uint16_t num_bytes_to_read = ((uint32_t)read_lengths[i] + 4 - 1) / 4;
             f.read(reinterpret_cast<char *>(&read[i]), num_bytes_to_read);
         }
         f.close();
-        remove(rg.infile[1].c_str());
+        removeTempFile(rg.infile[1]);
     }
     return;
 }
@@ -200,7 +195,7 @@ void readDnaFile(std::bitset<bitset_size> *read, uint16_t *read_lengths, const r
 // ---------------------------------------------------------------------------------------------------------------------
 
 template <size_t bitset_size>
-bool search_match(const std::bitset<bitset_size> &ref, std::bitset<bitset_size> *mask1,
+bool search_match(const std::bitset<bitset_size> &ref,
 #ifdef GENIE_USE_OPENMP
                   omp_lock *dict_lock, omp_lock *read_lock,
 #endif
@@ -209,7 +204,6 @@ bool search_match(const std::bitset<bitset_size> &ref, std::bitset<bitset_size>
                   const int &ref_len, const reorder_global<bitset_size> &rg) {
     static const unsigned int thresh = THRESH_REORDER;
     const int maxsearch = MAX_SEARCH_REORDER;
-    std::bitset<bitset_size> b;
     uint64_t ull;
     int64_t dictidx[2];  // to store the start and end index (end not inclusive)
     // in the dict read_id array
@@ -222,8 +216,7 @@ bool search_match(const std::bitset<bitset_size> &ref, std::bitset<bitset_size>
         } else {
             if (dict[l].end >= ref_len + shift || dict[l].start <= shift) continue;
         }
-        b = ref & mask1[l];
-        ull = (b >> 2 * dict[l].start).to_ullong();
+        ull = extractbits<bitset_size>(ref, 2 * dict[l].start, 2 * (dict[l].end - dict[l].start + 1));
         startposidx = dict[l].bphf->lookup(ull);
         if (startposidx >= dict[l].numkeys)  // not found
             continue;
@@ -238,19 +231,19 @@ bool search_match(const std::bitset<bitset_size> &ref, std::bitset<bitset_size>
 #endif
             continue;
         }
-        uint64_t ull1 = ((read[dict[l].read_id[dictidx[0]]] & mask1[l]) >> 2 * dict[l].start).to_ullong();
+        uint64_t ull1 = extractbits<bitset_size>(read[dict[l].read_id[dictidx[0]]], 2 * dict[l].start,
+                                                 2 * (dict[l].end - dict[l].start + 1));
         if (ull == ull1) {  // checking if ull is actually the key for this bin
             for (int64_t i = dictidx[1] - 1; i >= dictidx[0] && i >= dictidx[1] - maxsearch; i--) {
                 auto rid = dict[l].read_id[i];
                 size_t hamming;
                 if (!rev) {
-                    hamming = ((ref ^ read[rid]) &
-                               mask[0][rg.max_readlen - std::min<int>(ref_len - shift, read_lengths[rid])])
-                                  .count();
+                    hamming = hammingdistance<bitset_size>(
+                        ref, read[rid], mask[0][rg.max_readlen - std::min<int>(ref_len - shift, read_lengths[rid])]);
                 } else {
-                    hamming = ((ref ^ read[rid]) &
-                               mask[shift][rg.max_readlen - std::min<int>(ref_len + shift, read_lengths[rid])])
-                                  .count();
+                    hamming = hammingdistance<bitset_size>(
+                        ref, read[rid],
+                        mask[shift][rg.max_readlen - std::min<int>(ref_len + shift, read_lengths[rid])]);
                 }
                 if (hamming <= thresh) {
 #ifdef GENIE_USE_OPENMP
@@ -289,8 +282,6 @@ void reorder(std::bitset<bitset_size> *read, bbhashdict *dict, uint16_t *read_le
     std::bitset<bitset_size> **mask = new std::bitset<bitset_size> *[rg.max_readlen];
     for (int i = 0; i < rg.max_readlen; i++) mask[i] = new std::bitset<bitset_size>[rg.max_readlen];
     generatemasks<bitset_size>(mask, rg.max_readlen, 2);
-    std::bitset<bitset_size> *mask1 = new std::bitset<bitset_size>[rg.numdict];
-    generateindexmasks<bitset_size>(mask1, dict, rg.numdict, 2);
     bool *remainingreads = new bool[rg.numreads];
     std::fill(remainingreads, remainingreads + rg.numreads, 1);
 
@@ -319,15 +310,15 @@ void reorder(std::bitset<bitset_size> *read, bbhashdict *dict, uint16_t *read_le
         int tid = 0;       // set thread ID to zero if not using OpenMP
 #endif
         std::string tid_str = std::to_string(tid);
-        std::ofstream foutRC(rg.outfileRC + '.' + tid_str, std::ofstream::out);
-        std::ofstream foutflag(rg.outfileflag + '.' + tid_str, std::ofstream::out);
-        std::ofstream foutpos(rg.outfilepos + '.' + tid_str, std::ofstream::out | std::ios::binary);
-        std::ofstream foutorder(rg.outfileorder + '.' + tid_str, std::ofstream::out | std::ios::binary);
-        std::ofstream foutorder_s(rg.outfileorder + ".singleton." + tid_str, std::ofstream::out | std::ios::binary);
-        std::ofstream foutlength(rg.outfilereadlength + '.' + tid_str, std::ofstream::out | std::ios::binary);
+        TempOutFile foutRC(rg.outfileRC + '.' + tid_str, TempOutFile::out);
+        TempOutFile foutflag(rg.outfileflag + '.' + tid_str, TempOutFile::out);
+        TempOutFile foutpos(rg.outfilepos + '.' + tid_str, TempOutFile::out | std::ios::binary);
+        TempOutFile foutorder(rg.outfileorder + '.' + tid_str, TempOutFile::out | std::ios::binary);
+        TempOutFile foutorder_s(rg.outfileorder + ".singleton." + tid_str, TempOutFile::out | std::ios::binary);
+        TempOutFile foutlength(rg.outfilereadlength + '.' + tid_str, TempOutFile::out | std::ios::binary);
 
         unmatched[tid] = 0;
-        std::bitset<bitset_size> ref, revref, b;
+        std::bitset<bitset_size> ref, revref;
 
         int64_t first_rid = 0;
         // first_rid represents first read of contig, used for left searching
@@ -399,8 +390,8 @@ void reorder(std::bitset<bitset_size> *read, bbhashdict *dict, uint16_t *read_le
             if (!left_search_start) {
                 for (int l = 0; l < rg.numdict; l++) {
                     if (read_lengths[current] <= dict[l].end) continue;
-                    b = read[current] & mask1[l];
-                    ull = (b >> 2 * dict[l].start).to_ullong();
+                    ull = extractbits<bitset_size>(read[current], 2 * dict[l].start,
+                                                   2 * (dict[l].end - dict[l].start + 1));
                     startposidx = dict[l].bphf->lookup(ull);
                     // check if any other thread is modifying same dictpos
 #ifdef GENIE_USE_OPENMP
@@ -420,7 +411,7 @@ void reorder(std::bitset<bitset_size> *read, bbhashdict *dict, uint16_t *read_le
             if (!stop_searching) {
                 for (int shift = 0; shift < rg.maxshift; shift++) {
                     // find forward match
-                    flag = search_match<bitset_size>(ref, mask1,
+                    flag = search_match<bitset_size>(ref,
 #ifdef GENIE_USE_OPENMP
                                                      dict_lock, read_lock,
 #endif
@@ -457,7 +448,7 @@ void reorder(std::bitset<bitset_size> *read, bbhashdict *dict, uint16_t *read_le
                     }
 
                     // find reverse match
-                    flag = search_match<bitset_size>(revref, mask1,
+                    flag = search_match<bitset_size>(revref,
 #ifdef GENIE_USE_OPENMP
                                                      dict_lock, read_lock,
 #endif
@@ -569,7 +560,6 @@ void reorder(std::bitset<bitset_size> *read, bbhashdict *dict, uint16_t *read_le
     std::cerr << "Reordering done, " << std::accumulate(unmatched, unmatched + rg.num_thr, 0) << " were unmatched\n";
     for (int i = 0; i < rg.max_readlen; i++) delete[] mask[i];
     delete[] mask;
-    delete[] mask1;
     delete[] unmatched;
     return;
 }
@@ -598,11 +588,11 @@ void writetofile(std::bitset<bitset_size> *read, uint16_t *read_lengths, reorder
         uint32_t tid = 0;  // set thread ID to zero if not using OpenMP
 #endif
         std::string tid_str = std::to_string(tid);
-        std::ofstream fout(rg.outfile + '.' + tid_str, std::ofstream::out | std::ios::binary);
-        std::ofstream fout_s(rg.outfile + ".singleton." + tid_str, std::ofstream::out | std::ios::binary);
-        std::ifstream finRC(rg.outfileRC + '.' + tid_str, std::ifstream::in);
-        std::ifstream finorder(rg.outfileorder + '.' + tid_str, std::ifstream::in | std::ios::binary);
-        std::ifstream finorder_s(rg.outfileorder + ".singleton." + tid_str, std::ifstream::in | std::ios::binary);
+        TempOutFile fout(rg.outfile + '.' + tid_str, TempOutFile::out | std::ios::binary);
+        TempOutFile fout_s(rg.outfile + ".singleton." + tid_str, TempOutFile::out | std::ios::binary);
+        TempInFile finRC(rg.outfileRC + '.' + tid_str, TempInFile::in);
+        TempInFile finorder(rg.outfileorder + '.' + tid_str, TempInFile::in | std::ios::binary);
+        TempInFile finorder_s(rg.outfileorder + ".singleton." + tid_str, TempInFile::in | std::ios::binary);
         char s[MAX_READ_LEN + 1], s1[MAX_READ_LEN + 1];
         uint32_t current;
         char c;
@@ -614,7 +604,7 @@ void writetofile(std::bitset<bitset_size> *read, uint16_t *read_lengths, reorder
                 fout.write(reinterpret_cast<char *>(&read_lengths[current]), sizeof(uint16_t));
                 fout.write(reinterpret_cast<char *>(&read[current]), num_bytes_to_write);
             } else {
-                bitsettostring<bitset_size>(read[current], s, read_lengths[current], rg);
+                bitsettostring<bitset_size>(read[current], s, read_lengths[current]);
                 reverse_complement(s, s1, read_lengths[current]);
                 write_dna_in_bits(s1, fout);
             }
@@ -638,17 +628,17 @@ void writetofile(std::bitset<bitset_size> *read, uint16_t *read_lengths, reorder
     uint32_t numreads_s = 0;
     for (int i = 0; i < rg.num_thr; i++) numreads_s += numreads_s_thr[i];
     // write numreads_s to a file
-    std::ofstream fout_s_count(rg.outfile + ".singleton" + ".count", std::ofstream::out | std::ios::binary);
+    TempOutFile fout_s_count(rg.outfile + ".singleton" + ".count", TempOutFile::out | std::ios::binary);
     fout_s_count.write(reinterpret_cast<char *>(&numreads_s), sizeof(uint32_t));
     fout_s_count.close();
 
     // Now combine the num_thr order files
-    std::ofstream fout_s(rg.outfile + ".singleton", std::ofstream::out | std::ios::binary);
-    std::ofstream foutorder_s(rg.outfileorder + ".singleton", std::ofstream::out | std::ios::binary);
+    TempOutFile fout_s(rg.outfile + ".singleton", TempOutFile::out | std::ios::binary);
+    TempOutFile foutorder_s(rg.outfileorder + ".singleton", TempOutFile::out | std::ios::binary);
     for (int tid = 0; tid < rg.num_thr; tid++) {
         std::string tid_str = std::to_string(tid);
-        std::ifstream fin_s(rg.outfile + ".singleton." + tid_str, std::ifstream::in | std::ios::binary);
-        std::ifstream finorder_s(rg.outfileorder + ".singleton." + tid_str, std::ifstream::in | std::ios::binary);
+        TempInFile fin_s(rg.outfile + ".singleton." + tid_str, TempInFile::in | std::ios::binary);
+        TempInFile finorder_s(rg.outfileorder + ".singleton." + tid_str, TempInFile::in | std::ios::binary);
 
         fout_s << fin_s.rdbuf();  // write entire file
         foutorder_s << finorder_s.rdbuf();
@@ -660,8 +650,8 @@ void writetofile(std::bitset<bitset_size> *read, uint16_t *read_lengths, reorder
         fin_s.close();
         finorder_s.close();
 
-        remove((rg.outfile + ".singleton." + tid_str).c_str());
-        remove((rg.outfileorder + ".singleton." + tid_str).c_str());
+        removeTempFile(rg.outfile + ".singleton." + tid_str);
+        removeTempFile(rg.outfileorder + ".singleton." + tid_str);
     }
     fout_s.close();
     foutorder_s.close();
@@ -68,9 +68,9 @@ std::string buildcontig(std::list<contig_reads> &current_contig, const uint32_t
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void writecontig(const std::string &ref, std::list<contig_reads> &current_contig, std::ofstream &f_seq,
-                 std::ofstream &f_pos, std::ofstream &f_noise, std::ofstream &f_noisepos, std::ofstream &f_order,
-                 std::ofstream &f_RC, std::ofstream &f_readlength, uint64_t &abs_pos) {
+void writecontig(const std::string &ref, std::list<contig_reads> &current_contig, TempOutFile &f_seq,
+                 TempOutFile &f_pos, TempOutFile &f_noise, TempOutFile &f_noisepos, TempOutFile &f_order,
+                 TempOutFile &f_RC, TempOutFile &f_readlength, uint64_t &abs_pos) {
     f_seq << ref;
     uint16_t pos_var;
     int64_t prevj = 0;
@@ -100,16 +100,24 @@ void writecontig(const std::string &ref, std::list<contig_reads> &current_contig
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+uint32_t readSingletonCount(const std::string &temp_dir) {
+    uint32_t numreads_s = 0;
+    TempInFile myfile_s_count(temp_dir + "/temp.dna" + ".singleton" + ".count", TempInFile::in | std::ios::binary);
+    myfile_s_count.read(reinterpret_cast<char *>(&numreads_s), sizeof(uint32_t));
+    myfile_s_count.close();
+    return numreads_s;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void getDataParams(encoder_global &eg, const compression_params &cp) {
     uint32_t numreads_clean, numreads_total;
     numreads_clean = cp.num_reads_clean[0] + cp.num_reads_clean[1];
     numreads_total = cp.num_reads;
 
-    std::ifstream myfile_s_count(eg.infile + ".singleton" + ".count", std::ifstream::in | std::ios::binary);
-    myfile_s_count.read(reinterpret_cast<char *>(&eg.numreads_s), sizeof(uint32_t));
-    myfile_s_count.close();
+    eg.numreads_s = readSingletonCount(eg.basedir);
     std::string file_s_count = eg.infile + ".singleton" + ".count";
-    remove(file_s_count.c_str());
+    removeTempFile(file_s_count);
 
     eg.numreads = numreads_clean - eg.numreads_s;
     eg.numreads_N = numreads_total - numreads_clean;
@@ -145,8 +153,8 @@ void correct_order(uint32_t *order_s, const encoder_global &eg) {
 
     // Now correct for clean reads (this is stored on file)
     for (int tid = 0; tid < eg.num_thr; tid++) {
-        std::ifstream fin_order(eg.infile_order + '.' + std::to_string(tid), std::ios::binary);
-        std::ofstream fout_order(eg.infile_order + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
+        TempInFile fin_order(eg.infile_order + '.' + std::to_string(tid), std::ios::binary);
+        TempOutFile fout_order(eg.infile_order + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
         uint32_t pos;
         fin_order.read(reinterpret_cast<char *>(&pos), sizeof(uint32_t));
         while (!fin_order.eof()) {
@@ -156,11 +164,11 @@ void correct_order(uint32_t *order_s, const encoder_global &eg) {
         }
         fin_order.close();
         fout_order.close();
-        remove((eg.infile_order + '.' + std::to_string(tid)).c_str());
-        rename((eg.infile_order + '.' + std::to_string(tid) + ".tmp").c_str(),
-               (eg.infile_order + '.' + std::to_string(tid)).c_str());
+        removeTempFile(eg.infile_order + '.' + std::to_string(tid));
+        renameTempFile(eg.infile_order + '.' + std::to_string(tid) + ".tmp",
+                       eg.infile_order + '.' + std::to_string(tid));
     }
-    remove(eg.infile_order_N.c_str());
+    removeTempFile(eg.infile_order_N);
     delete[] read_flag_N;
     delete[] cumulative_N_reads;
     return;
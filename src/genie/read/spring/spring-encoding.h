@@ -43,9 +43,7 @@ struct encoder_global_b {
     std::bitset<bitset_size> **basemask;  //!< @brief
     int max_readlen;                      //!< @brief
     // bitset for A,G,C,T,N at each position
-    // used in stringtobitset, and bitsettostring
-    std::bitset<bitset_size> mask63;  //!< bitset with 63 bits set to 1 (used in
-    // bitsettostring for conversion to ullong)
+    // used in stringtobitset
 
     /**
      * @brief
@@ -126,9 +124,16 @@ std::string buildcontig(std::list<contig_reads> &current_contig, const uint32_t
  * @param f_readlength
  * @param abs_pos
  */
-void writecontig(const std::string &ref, std::list<contig_reads> &current_contig, std::ofstream &f_seq,
-                 std::ofstream &f_pos, std::ofstream &f_noise, std::ofstream &f_noisepos, std::ofstream &f_order,
-                 std::ofstream &f_RC, std::ofstream &f_readlength, uint64_t &abs_pos);
+void writecontig(const std::string &ref, std::list<contig_reads> &current_contig, TempOutFile &f_seq,
+                 TempOutFile &f_pos, TempOutFile &f_noise, TempOutFile &f_noisepos, TempOutFile &f_order,
+                 TempOutFile &f_RC, TempOutFile &f_readlength, uint64_t &abs_pos);
+
+/**
+ * @brief Read the number of singleton reads written by the reordering step
+ * @param temp_dir Working directory of the partition
+ * @return Number of reads that were not matched to any contig
+ */
+uint32_t readSingletonCount(const std::string &temp_dir);
 
 /**
  * @brief
@@ -149,12 +154,10 @@ void correct_order(uint32_t *order_s, const encoder_global &eg);
  * @tparam bitset_size
  * @param b
  * @param readlen
- * @param egb
  * @return
  */
 template <size_t bitset_size>
-std::string bitsettostring(std::bitset<bitset_size> b, const uint16_t readlen,
-                           const encoder_global_b<bitset_size> &egb);
+std::string bitsettostring(const std::bitset<bitset_size> &b, const uint16_t readlen);
 
 /**
  * @brief
@@ -38,17 +38,13 @@ encoder_global_b<bitset_size>::~encoder_global_b() {
 // ---------------------------------------------------------------------------------------------------------------------
 
 template <size_t bitset_size>
-std::string bitsettostring(std::bitset<bitset_size> b, const uint16_t readlen,
-                           const encoder_global_b<bitset_size> &egb) {
-    // destroys bitset b
+std::string bitsettostring(const std::bitset<bitset_size> &b, const uint16_t readlen) {
     static const char revinttochar[8] = {'A', 'N', 'G', 0, 'C', 0, 'T', 0};
     std::string s;
     s.resize(readlen);
-    uint64_t ull;
-    for (int i = 0; i < 3 * readlen / 63 + 1; i++) {
-        ull = (b & egb.mask63).to_ullong();
-        b >>= 63;
-        for (int j = 21 * i; j < 21 * i + 21 && j < readlen; j++) {
+    for (int i = 0; i < readlen; i += 21) {
+        uint64_t ull = extractbits<bitset_size>(b, 3 * i, 63);
+        for (int j = i; j < i + 21 && j < readlen; j++) {
             s[j] = revinttochar[ull % 8];
             ull /= 8;
         }
@@ -70,8 +66,6 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
     bool *remainingreads = new bool[eg.numreads_s + eg.numreads_N];
     std::fill(remainingreads, remainingreads + eg.numreads_s + eg.numreads_N, 1);
 
-    std::bitset<bitset_size> *mask1 = new std::bitset<bitset_size>[eg.numdict_s];
-    generateindexmasks<bitset_size>(mask1, dict, eg.numdict_s, 3);
     std::bitset<bitset_size> **mask = new std::bitset<bitset_size> *[eg.max_readlen];
     for (int i = 0; i < eg.max_readlen; i++) mask[i] = new std::bitset<bitset_size>[eg.max_readlen];
     generatemasks<bitset_size>(mask, eg.max_readlen, 3);
@@ -91,19 +85,19 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
 #else
         int tid = 0;
 #endif
-        std::ifstream f(eg.infile + '.' + std::to_string(tid), std::ios::binary);
-        std::ifstream in_flag(eg.infile_flag + '.' + std::to_string(tid));
-        std::ifstream in_pos(eg.infile_pos + '.' + std::to_string(tid), std::ios::binary);
-        std::ifstream in_order(eg.infile_order + '.' + std::to_string(tid), std::ios::binary);
-        std::ifstream in_RC(eg.infile_RC + '.' + std::to_string(tid));
-        std::ifstream in_readlength(eg.infile_readlength + '.' + std::to_string(tid), std::ios::binary);
-        std::ofstream f_seq(eg.outfile_seq + '.' + std::to_string(tid));
-        std::ofstream f_pos(eg.outfile_pos + '.' + std::to_string(tid), std::ios::binary);
-        std::ofstream f_noise(eg.outfile_noise + '.' + std::to_string(tid));
-        std::ofstream f_noisepos(eg.outfile_noisepos + '.' + std::to_string(tid), std::ios::binary);
-        std::ofstream f_order(eg.infile_order + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
-        std::ofstream f_RC(eg.infile_RC + '.' + std::to_string(tid) + ".tmp");
-        std::ofstream f_readlength(eg.infile_readlength + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
+        TempInFile f(eg.infile + '.' + std::to_string(tid), std::ios::binary);
+        TempInFile in_flag(eg.infile_flag + '.' + std::to_string(tid));
+        TempInFile in_pos(eg.infile_pos + '.' + std::to_string(tid), std::ios::binary);
+        TempInFile in_order(eg.infile_order + '.' + std::to_string(tid), std::ios::binary);
+        TempInFile in_RC(eg.infile_RC + '.' + std::to_string(tid));
+        TempInFile in_readlength(eg.infile_readlength + '.' + std::to_string(tid), std::ios::binary);
+        TempOutFile f_seq(eg.outfile_seq + '.' + std::to_string(tid));
+        TempOutFile f_pos(eg.outfile_pos + '.' + std::to_string(tid), std::ios::binary);
+        TempOutFile f_noise(eg.outfile_noise + '.' + std::to_string(tid));
+        TempOutFile f_noisepos(eg.outfile_noisepos + '.' + std::to_string(tid), std::ios::binary);
+        TempOutFile f_order(eg.infile_order + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
+        TempOutFile f_RC(eg.infile_RC + '.' + std::to_string(tid) + ".tmp");
+        TempOutFile f_readlength(eg.infile_readlength + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
         int64_t dictidx[2];  // to store the start and end index (end not inclusive)
         // in the dict read_id array
         uint64_t startposidx;  // index in startpos
@@ -113,7 +107,7 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
         bool flag = 0;
         // flag to check if match was found or not
         std::string current, ref;
-        std::bitset<bitset_size> forward_bitset, reverse_bitset, b;
+        std::bitset<bitset_size> forward_bitset, reverse_bitset;
         char c = '0', rc = 'd';
         std::list<contig_reads> current_contig;
         int64_t p = 0;
@@ -158,11 +152,9 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
                             // search for singleton reads
                             for (int rev = 0; rev < 2; rev++) {
                                 for (int l = 0; l < eg.numdict_s; l++) {
-                                    if (!rev)
-                                        b = forward_bitset & mask1[l];
-                                    else
-                                        b = reverse_bitset & mask1[l];
-                                    ull = (b >> 3 * dict[l].start).to_ullong();
+                                    ull = extractbits<bitset_size>(rev ? reverse_bitset : forward_bitset,
+                                                                   3 * dict[l].start,
+                                                                   3 * (dict[l].end - dict[l].start + 1));
                                     startposidx = dict[l].bphf->lookup(ull);
                                     if (startposidx >= dict[l].numkeys)  // not found
                                         continue;
@@ -181,24 +173,16 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
 #endif
                                         continue;
                                     }
-                                    uint64_t ull1 =
-                                        ((read[dict[l].read_id[dictidx[0]]] & mask1[l]) >> 3 * dict[l].start)
-                                            .to_ullong();
+                                    uint64_t ull1 = extractbits<bitset_size>(read[dict[l].read_id[dictidx[0]]],
+                                                                             3 * dict[l].start,
+                                                                             3 * (dict[l].end - dict[l].start + 1));
                                     if (ull == ull1) {  // checking if ull is actually the key for this bin
                                         for (int64_t i = dictidx[1] - 1; i >= dictidx[0] && i >= dictidx[1] - maxsearch;
                                              i--) {
                                             auto rid = dict[l].read_id[i];
-                                            int hamming;
-                                            if (!rev)
-                                                hamming =
-                                                    static_cast<int>(((forward_bitset ^ read[rid]) &
-                                                                      mask[0][eg.max_readlen - read_lengths_s[rid]])
-                                                                         .count());
-                                            else
-                                                hamming =
-                                                    static_cast<int>(((reverse_bitset ^ read[rid]) &
-                                                                      mask[0][eg.max_readlen - read_lengths_s[rid]])
-                                                                         .count());
+                                            int hamming = static_cast<int>(hammingdistance<bitset_size>(
+                                                rev ? reverse_bitset : forward_bitset, read[rid],
+                                                mask[0][eg.max_readlen - read_lengths_s[rid]]));
                                             if (hamming <= thresh_s) {
 #ifdef GENIE_USE_OPENMP
                                                 read_lock[rid].set();
@@ -217,11 +201,10 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
                                                 char l_rc = rev ? 'r' : 'd';
                                                 int64_t pos = rev ? (j + eg.max_readlen - read_lengths_s[rid]) : j;
                                                 std::string read_string =
-                                                    rev ? reverse_complement(bitsettostring<bitset_size>(
-                                                                                 read[rid], read_lengths_s[rid], egb),
-                                                                             read_lengths_s[rid])
-                                                        : bitsettostring<bitset_size>(read[rid], read_lengths_s[rid],
-                                                                                      egb);
+                                                    bitsettostring<bitset_size>(read[rid], read_lengths_s[rid]);
+                                                if (rev) {
+                                                    read_string = reverse_complement(read_string, read_lengths_s[rid]);
+                                                }
                                                 current_contig.push_back(
                                                     {read_string, pos, l_rc, order_s[rid], read_lengths_s[rid]});
                                                 for (int l1 = 0; l1 < eg.numdict_s; l1++) {
@@ -237,8 +220,8 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
                                     // delete from dictionaries
                                     for (int l1 = 0; l1 < eg.numdict_s; l1++)
                                         for (auto it = deleted_rids[l1].begin(); it != deleted_rids[l1].end();) {
-                                            b = read[*it] & mask1[l1];
-                                            ull = (b >> 3 * dict[l1].start).to_ullong();
+                                            ull = extractbits<bitset_size>(read[*it], 3 * dict[l1].start,
+                                                                           3 * (dict[l1].end - dict[l1].start + 1));
                                             startposidx = dict[l1].bphf->lookup(ull);
 #ifdef GENIE_USE_OPENMP
                                             if (!dict_lock[startposidx].test()) {
@@ -300,25 +283,25 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
 
     uint64_t *file_len_seq_thr = new uint64_t[eg.num_thr];
     for (int tid = 0; tid < eg.num_thr; tid++) {
-        std::ifstream in_seq(eg.outfile_seq + '.' + std::to_string(tid));
+        TempInFile in_seq(eg.outfile_seq + '.' + std::to_string(tid));
         in_seq.seekg(0, in_seq.end);
         file_len_seq_thr[tid] = in_seq.tellg();
         in_seq.close();
     }
     // Combine files produced by the threads
-    std::ofstream f_order(eg.infile_order, std::ios::binary);
-    std::ofstream f_readlength(eg.infile_readlength, std::ios::binary);
-    std::ofstream f_noisepos(eg.outfile_noisepos, std::ios::binary);
-    std::ofstream f_noise(eg.outfile_noise);
-    std::ofstream f_RC(eg.infile_RC);
-    std::ofstream f_seq(eg.outfile_seq);
+    TempOutFile f_order(eg.infile_order, std::ios::binary);
+    TempOutFile f_readlength(eg.infile_readlength, std::ios::binary);
+    TempOutFile f_noisepos(eg.outfile_noisepos, std::ios::binary);
+    TempOutFile f_noise(eg.outfile_noise);
+    TempOutFile f_RC(eg.infile_RC);
+    TempOutFile f_seq(eg.outfile_seq);
     for (int tid = 0; tid < eg.num_thr; tid++) {
-        std::ifstream in_seq(eg.outfile_seq + '.' + std::to_string(tid));
-        std::ifstream in_order(eg.infile_order + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
-        std::ifstream in_readlength(eg.infile_readlength + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
-        std::ifstream in_RC(eg.infile_RC + '.' + std::to_string(tid) + ".tmp");
-        std::ifstream in_noisepos(eg.outfile_noisepos + '.' + std::to_string(tid), std::ios::binary);
-        std::ifstream in_noise(eg.outfile_noise + '.' + std::to_string(tid));
+        TempInFile in_seq(eg.outfile_seq + '.' + std::to_string(tid));
+        TempInFile in_order(eg.infile_order + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
+        TempInFile in_readlength(eg.infile_readlength + '.' + std::to_string(tid) + ".tmp", std::ios::binary);
+        TempInFile in_RC(eg.infile_RC + '.' + std::to_string(tid) + ".tmp");
+        TempInFile in_noisepos(eg.outfile_noisepos + '.' + std::to_string(tid), std::ios::binary);
+        TempInFile in_noise(eg.outfile_noise + '.' + std::to_string(tid));
         f_seq << in_seq.rdbuf();
         f_seq.clear();
         f_order << in_order.rdbuf();
@@ -332,25 +315,25 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
         f_RC << in_RC.rdbuf();
         f_RC.clear();  // clear error flag in case in_RC is empty
 
-        remove((eg.outfile_seq + '.' + std::to_string(tid)).c_str());
-        remove((eg.infile_order + '.' + std::to_string(tid)).c_str());
-        remove((eg.infile_order + '.' + std::to_string(tid) + ".tmp").c_str());
-        remove((eg.infile_readlength + '.' + std::to_string(tid)).c_str());
-        remove((eg.infile_readlength + '.' + std::to_string(tid) + ".tmp").c_str());
-        remove((eg.outfile_noisepos + '.' + std::to_string(tid)).c_str());
-        remove((eg.outfile_noise + '.' + std::to_string(tid)).c_str());
-        remove((eg.infile_RC + '.' + std::to_string(tid) + ".tmp").c_str());
-        remove((eg.infile_RC + '.' + std::to_string(tid)).c_str());
-        remove((eg.infile_flag + '.' + std::to_string(tid)).c_str());
-        remove((eg.infile_pos + '.' + std::to_string(tid)).c_str());
-        remove((eg.infile + '.' + std::to_string(tid)).c_str());
+        removeTempFile(eg.outfile_seq + '.' + std::to_string(tid));
+        removeTempFile(eg.infile_order + '.' + std::to_string(tid));
+        removeTempFile(eg.infile_order + '.' + std::to_string(tid) + ".tmp");
+        removeTempFile(eg.infile_readlength + '.' + std::to_string(tid));
+        removeTempFile(eg.infile_readlength + '.' + std::to_string(tid) + ".tmp");
+        removeTempFile(eg.outfile_noisepos + '.' + std::to_string(tid));
+        removeTempFile(eg.outfile_noise + '.' + std::to_string(tid));
+        removeTempFile(eg.infile_RC + '.' + std::to_string(tid) + ".tmp");
+        removeTempFile(eg.infile_RC + '.' + std::to_string(tid));
+        removeTempFile(eg.infile_flag + '.' + std::to_string(tid));
+        removeTempFile(eg.infile_pos + '.' + std::to_string(tid));
+        removeTempFile(eg.infile + '.' + std::to_string(tid));
     }
     f_order.close();
     f_readlength.close();
     // write remaining singleton reads now
-    std::ofstream f_unaligned(eg.outfile_unaligned, std::ios::binary);
-    f_order.open(eg.infile_order, std::ios::binary | std::ofstream::app);
-    f_readlength.open(eg.infile_readlength, std::ios::binary | std::ofstream::app);
+    TempOutFile f_unaligned(eg.outfile_unaligned, std::ios::binary);
+    f_order.open(eg.infile_order, std::ios::binary | TempOutFile::app);
+    f_readlength.open(eg.infile_readlength, std::ios::binary | TempOutFile::app);
     uint32_t matched_s = eg.numreads_s;
     uint64_t len_unaligned = 0;
 
@@ -359,7 +342,7 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
             matched_s--;
             f_order.write(reinterpret_cast<char *>(&order_s[i]), sizeof(uint32_t));
             f_readlength.write(reinterpret_cast<char *>(&read_lengths_s[i]), sizeof(uint16_t));
-            std::string unaligned_read = bitsettostring<bitset_size>(read[i], read_lengths_s[i], egb);
+            std::string unaligned_read = bitsettostring<bitset_size>(read[i], read_lengths_s[i]);
             write_dnaN_in_bits(unaligned_read, f_unaligned);
             len_unaligned += read_lengths_s[i];
         }
@@ -367,7 +350,7 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
     for (uint32_t i = eg.numreads_s; i < eg.numreads_s + eg.numreads_N; i++)
         if (remainingreads[i] == 1) {
             matched_N--;
-            std::string unaligned_read = bitsettostring<bitset_size>(read[i], read_lengths_s[i], egb);
+            std::string unaligned_read = bitsettostring<bitset_size>(read[i], read_lengths_s[i]);
             write_dnaN_in_bits(unaligned_read, f_unaligned);
             f_order.write(reinterpret_cast<char *>(&order_s[i]), sizeof(uint32_t));
             f_readlength.write(reinterpret_cast<char *>(&read_lengths_s[i]), sizeof(uint16_t));
@@ -383,10 +366,9 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
 #endif
     for (int i = 0; i < eg.max_readlen; i++) delete[] mask[i];
     delete[] mask;
-    delete[] mask1;
 
     // write length of unaligned array
-    std::ofstream f_unaligned_count(eg.outfile_unaligned + ".count", std::ios::binary);
+    TempOutFile f_unaligned_count(eg.outfile_unaligned + ".count", std::ios::binary);
     f_unaligned_count.write(reinterpret_cast<char *>(&len_unaligned), sizeof(uint64_t));
     f_unaligned_count.close();
 
@@ -394,9 +376,9 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
     // positions
     uint64_t abs_pos = 0;
     uint64_t abs_pos_thr;
-    std::ofstream fout_pos(eg.outfile_pos, std::ios::binary);
+    TempOutFile fout_pos(eg.outfile_pos, std::ios::binary);
     for (int tid = 0; tid < eg.num_thr; tid++) {
-        std::ifstream fin_pos(eg.outfile_pos + '.' + std::to_string(tid), std::ios::binary);
+        TempInFile fin_pos(eg.outfile_pos + '.' + std::to_string(tid), std::ios::binary);
         fin_pos.read(reinterpret_cast<char *>(&abs_pos_thr), sizeof(uint64_t));
         while (!fin_pos.eof()) {
             abs_pos_thr += abs_pos;
@@ -404,7 +386,7 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
             fin_pos.read(reinterpret_cast<char *>(&abs_pos_thr), sizeof(uint64_t));
         }
         fin_pos.close();
-        remove((eg.outfile_pos + '.' + std::to_string(tid)).c_str());
+        removeTempFile(eg.outfile_pos + '.' + std::to_string(tid));
         abs_pos += file_len_seq_thr[tid];
     }
     fout_pos.close();
@@ -420,7 +402,6 @@ void encode(std::bitset<bitset_size> *read, bbhashdict *dict, uint32_t *order_s,
 
 template <size_t bitset_size>
 void setglobalarrays(encoder_global &eg, encoder_global_b<bitset_size> &egb) {
-    for (int i = 0; i < 63; i++) egb.mask63[i] = 1;
     for (int i = 0; i < eg.max_readlen; i++) {
         egb.basemask[i][(uint8_t)'A'][3 * i] = 0;
         egb.basemask[i][(uint8_t)'A'][3 * i + 1] = 0;
@@ -469,7 +450,7 @@ template <size_t bitset_size>
 void readsingletons(std::bitset<bitset_size> *read, uint32_t *order_s, uint16_t *read_lengths_s,
                     const encoder_global &eg, const encoder_global_b<bitset_size> &egb) {
     // not parallelized right now since these are very small number of reads
-    std::ifstream f(eg.infile + ".singleton", std::ifstream::in | std::ios::binary);
+    TempInFile f(eg.infile + ".singleton", TempInFile::in | std::ios::binary);
     std::string s;
     for (uint32_t i = 0; i < eg.numreads_s; i++) {
         read_dna_from_bits(s, f);
@@ -477,19 +458,19 @@ void readsingletons(std::bitset<bitset_size> *read, uint32_t *order_s, uint16_t
         stringtobitset<bitset_size>(s, read_lengths_s[i], read[i], egb.basemask);
     }
     f.close();
-    remove((eg.infile + ".singleton").c_str());
+    removeTempFile(eg.infile + ".singleton");
     f.open(eg.infile_N, std::ios::binary);
     for (uint32_t i = eg.numreads_s; i < eg.numreads_s + eg.numreads_N; i++) {
         read_dnaN_from_bits(s, f);
         read_lengths_s[i] = static_cast<uint16_t>(s.length());
         stringtobitset<bitset_size>(s, read_lengths_s[i], read[i], egb.basemask);
     }
-    std::ifstream f_order_s(eg.infile_order + ".singleton", std::ios::binary);
+    TempInFile f_order_s(eg.infile_order + ".singleton", std::ios::binary);
     for (uint32_t i = 0; i < eg.numreads_s; i++)
         f_order_s.read(reinterpret_cast<char *>(&order_s[i]), sizeof(uint32_t));
     f_order_s.close();
-    remove((eg.infile_order + ".singleton").c_str());
-    std::ifstream f_order_N(eg.infile_order_N, std::ios::binary);
+    removeTempFile(eg.infile_order + ".singleton");
+    TempInFile f_order_N(eg.infile_order_N, std::ios::binary);
     for (uint32_t i = eg.numreads_s; i < eg.numreads_s + eg.numreads_N; i++)
         f_order_N.read(reinterpret_cast<char *>(&order_s[i]), sizeof(uint32_t));
     f_order_N.close();
@@ -528,7 +509,7 @@ void encoder_main(const std::string &temp_dir, const compression_params &cp) {
     uint32_t *order_s = new uint32_t[eg.numreads_s + eg.numreads_N];
     uint16_t *read_lengths_s = new uint16_t[eg.numreads_s + eg.numreads_N];
     readsingletons<bitset_size>(read, order_s, read_lengths_s, eg, egb);
-    remove(eg.infile_N.c_str());
+    removeTempFile(eg.infile_N);
     correct_order(order_s, eg);
 
     bbhashdict *dict = new bbhashdict[eg.numdict_s];
@@ -0,0 +1,375 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/read/spring/temp-file.h"
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include "filesystem/filesystem.hpp"
+#include "genie/util/make-unique.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace read {
+namespace spring {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Temporary files kept in memory, shared by all threads
+ */
+struct MemoryFileStore {
+    std::mutex mutex;                                              //!< @brief Protects the members
+    std::set<std::string> directories;                             //!< @brief Directories kept in memory
+    std::map<std::string, std::shared_ptr<std::string>> files;     //!< @brief Content of each file by path
+
+    /**
+     * @brief Caller must hold the mutex
+     * @param path Path
+     * @return True if the file belongs to a directory kept in memory
+     */
+    bool contains(const std::string &path) const {
+        for (const auto &dir : directories) {
+            if (path.size() > dir.size() && path.compare(0, dir.size(), dir) == 0 && path[dir.size()] == '/') {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @return The store of this process
+ */
+static MemoryFileStore &getStore() {
+    static MemoryFileStore store;
+    return store;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Get a memory file
+ * @param path Path
+ * @param create Create the file if it does not exist
+ * @param truncate Empty an existing file
+ * @return File content, nullptr if the path is not kept in memory or the file does not exist
+ */
+static std::shared_ptr<std::string> getMemoryFile(const std::string &path, bool create, bool truncate) {
+    auto &store = getStore();
+    std::lock_guard<std::mutex> guard(store.mutex);
+    if (!store.contains(path)) {
+        return nullptr;
+    }
+    auto it = store.files.find(path);
+    if (it == store.files.end()) {
+        if (!create) {
+            return nullptr;
+        }
+        it = store.files.emplace(path, std::make_shared<std::string>()).first;
+    } else if (truncate) {
+        // Readers of the old content keep it alive
+        it->second = std::make_shared<std::string>();
+    }
+    return it->second;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param path Path
+ * @return True if the path is kept in memory
+ */
+static bool isInMemory(const std::string &path) {
+    auto &store = getStore();
+    std::lock_guard<std::mutex> guard(store.mutex);
+    return store.contains(path);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Read access to a memory file
+ */
+class MemoryInBuffer : public std::streambuf {
+ private:
+    std::shared_ptr<std::string> data;  //!< @brief File content
+
+ protected:
+    /**
+     * @brief
+     * @param off Offset
+     * @param dir Reference position
+     * @param which Only input is supported
+     * @return New position
+     */
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        off_type base = 0;
+        if (dir == std::ios_base::cur) {
+            base = gptr() - eback();
+        } else if (dir == std::ios_base::end) {
+            base = egptr() - eback();
+        }
+        off_type pos = base + off;
+        if (pos < 0 || pos > egptr() - eback()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), eback() + pos, egptr());
+        return pos_type(pos);
+    }
+
+    /**
+     * @brief
+     * @param pos Position
+     * @param which Only input is supported
+     * @return New position
+     */
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+ public:
+    /**
+     * @brief
+     * @param _data File content
+     */
+    explicit MemoryInBuffer(std::shared_ptr<std::string> _data) : data(std::move(_data)) {
+        auto begin = &(*data)[0];
+        setg(begin, begin, begin + data->size());
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Write access to a memory file, appending to its content
+ */
+class MemoryOutBuffer : public std::streambuf {
+ private:
+    std::shared_ptr<std::string> data;  //!< @brief File content
+
+ protected:
+    /**
+     * @brief
+     * @param c Character
+     * @return Character
+     */
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            data->push_back(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    /**
+     * @brief
+     * @param s Characters
+     * @param n Number of characters
+     * @return Number of characters written
+     */
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+        data->append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+ public:
+    /**
+     * @brief
+     * @param _data File content
+     */
+    explicit MemoryOutBuffer(std::shared_ptr<std::string> _data) : data(std::move(_data)) {}
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void keepTempFilesInMemory(const std::string &dir) {
+    auto &store = getStore();
+    std::lock_guard<std::mutex> guard(store.mutex);
+    store.directories.insert(dir);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void removeTempFile(const std::string &path) {
+    auto &store = getStore();
+    {
+        std::lock_guard<std::mutex> guard(store.mutex);
+        if (store.contains(path)) {
+            store.files.erase(path);
+            return;
+        }
+    }
+    std::remove(path.c_str());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void renameTempFile(const std::string &from, const std::string &to) {
+    auto &store = getStore();
+    {
+        std::lock_guard<std::mutex> guard(store.mutex);
+        if (store.contains(from)) {
+            auto it = store.files.find(from);
+            if (it != store.files.end()) {
+                store.files[to] = std::move(it->second);
+                store.files.erase(it);
+            }
+            return;
+        }
+    }
+    std::rename(from.c_str(), to.c_str());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool tempFileExists(const std::string &path) {
+    auto &store = getStore();
+    {
+        std::lock_guard<std::mutex> guard(store.mutex);
+        if (store.contains(path)) {
+            return store.files.count(path) != 0;
+        }
+    }
+    return ghc::filesystem::exists(path);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t getTempFileSize(const std::string &path) {
+    auto &store = getStore();
+    {
+        std::lock_guard<std::mutex> guard(store.mutex);
+        if (store.contains(path)) {
+            auto it = store.files.find(path);
+            return it == store.files.end() ? 0 : it->second->size();
+        }
+    }
+    return ghc::filesystem::file_size(path);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void removeTempDirectory(const std::string &dir) {
+    auto &store = getStore();
+    {
+        std::lock_guard<std::mutex> guard(store.mutex);
+        for (auto it = store.files.begin(); it != store.files.end();) {
+            if (it->first.size() > dir.size() && it->first.compare(0, dir.size(), dir) == 0 &&
+                it->first[dir.size()] == '/') {
+                it = store.files.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        store.directories.erase(dir);
+    }
+    ghc::filesystem::remove_all(dir);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TempInFile::TempInFile() : std::istream(nullptr) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TempInFile::TempInFile(const std::string &path, std::ios_base::openmode mode) : std::istream(nullptr) {
+    open(path, mode);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TempInFile::open(const std::string &path, std::ios_base::openmode mode) {
+    close();
+    if (isInMemory(path)) {
+        auto data = getMemoryFile(path, false, false);
+        if (data) {
+            buffer = util::make_unique<MemoryInBuffer>(std::move(data));
+        }
+    } else {
+        auto file = util::make_unique<std::filebuf>();
+        if (file->open(path, mode | std::ios_base::in)) {
+            buffer = std::move(file);
+        }
+    }
+    rdbuf(buffer.get());
+    if (!buffer) {
+        setstate(std::ios_base::failbit);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TempInFile::is_open() const { return buffer != nullptr; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TempInFile::close() {
+    rdbuf(nullptr);
+    buffer.reset();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TempOutFile::TempOutFile() : std::ostream(nullptr) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TempOutFile::TempOutFile(const std::string &path, std::ios_base::openmode mode) : std::ostream(nullptr) {
+    open(path, mode);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TempOutFile::open(const std::string &path, std::ios_base::openmode mode) {
+    close();
+    if (isInMemory(path)) {
+        buffer = util::make_unique<MemoryOutBuffer>(getMemoryFile(path, true, !(mode & std::ios_base::app)));
+    } else {
+        auto file = util::make_unique<std::filebuf>();
+        if (file->open(path, mode | std::ios_base::out)) {
+            buffer = std::move(file);
+        }
+    }
+    rdbuf(buffer.get());
+    if (!buffer) {
+        setstate(std::ios_base::failbit);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TempOutFile::is_open() const { return buffer != nullptr; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TempOutFile::close() {
+    if (buffer && buffer->pubsync() != 0) {
+        setstate(std::ios_base::badbit);
+    }
+    rdbuf(nullptr);
+    buffer.reset();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace spring
+}  // namespace read
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
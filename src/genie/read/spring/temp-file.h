@@ -0,0 +1,154 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_READ_SPRING_TEMP_FILE_H_
+#define SRC_GENIE_READ_SPRING_TEMP_FILE_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace read {
+namespace spring {
+
+/**
+ * @brief Keep all temporary files created in a directory in memory instead of writing them to disk. Files in the
+ * directory are then only visible through the functions and streams below.
+ * @param dir Temporary directory
+ */
+void keepTempFilesInMemory(const std::string &dir);
+
+/**
+ * @brief Remove a temporary file, missing files are ignored
+ * @param path Path
+ */
+void removeTempFile(const std::string &path);
+
+/**
+ * @brief Rename a temporary file, replacing the target
+ * @param from Old path
+ * @param to New path
+ */
+void renameTempFile(const std::string &from, const std::string &to);
+
+/**
+ * @brief
+ * @param path Path
+ * @return True if the temporary file exists
+ */
+bool tempFileExists(const std::string &path);
+
+/**
+ * @brief
+ * @param path Path
+ * @return Size of the temporary file in bytes
+ */
+uint64_t getTempFileSize(const std::string &path);
+
+/**
+ * @brief Remove a temporary directory with all files in it, in memory or on disk
+ * @param dir Temporary directory
+ */
+void removeTempDirectory(const std::string &dir);
+
+/**
+ * @brief Input stream for a temporary file, used like std::ifstream
+ */
+class TempInFile : public std::istream {
+ private:
+    std::unique_ptr<std::streambuf> buffer;  //!< @brief File or memory buffer, nullptr if closed
+
+ public:
+    /**
+     * @brief Closed file
+     */
+    TempInFile();
+
+    /**
+     * @brief
+     * @param path Path
+     * @param mode Open mode
+     */
+    explicit TempInFile(const std::string &path, std::ios_base::openmode mode = std::ios_base::in);
+
+    /**
+     * @brief Open a file, sets the failbit if it does not exist
+     * @param path Path
+     * @param mode Open mode
+     */
+    void open(const std::string &path, std::ios_base::openmode mode = std::ios_base::in);
+
+    /**
+     * @brief
+     * @return True if a file is open
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Close the file
+     */
+    void close();
+};
+
+/**
+ * @brief Output stream for a temporary file, used like std::ofstream
+ */
+class TempOutFile : public std::ostream {
+ private:
+    std::unique_ptr<std::streambuf> buffer;  //!< @brief File or memory buffer, nullptr if closed
+
+ public:
+    /**
+     * @brief Closed file
+     */
+    TempOutFile();
+
+    /**
+     * @brief
+     * @param path Path
+     * @param mode Open mode, std::ios_base::app to append
+     */
+    explicit TempOutFile(const std::string &path, std::ios_base::openmode mode = std::ios_base::out);
+
+    /**
+     * @brief Open a file, sets the failbit if it cannot be created
+     * @param path Path
+     * @param mode Open mode, std::ios_base::app to append
+     */
+    void open(const std::string &path, std::ios_base::openmode mode = std::ios_base::out);
+
+    /**
+     * @brief
+     * @return True if a file is open
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Flush and close the file
+     */
+    void close();
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace spring
+}  // namespace read
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_READ_SPRING_TEMP_FILE_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
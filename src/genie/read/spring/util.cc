@@ -22,7 +22,7 @@ namespace spring {
 // ---------------------------------------------------------------------------------------------------------------------
 
 std::vector<int64_t> read_vector_from_file(const std::string &file_name) {
-    std::ifstream f_in(file_name, std::ios::binary);
+    TempInFile f_in(file_name, std::ios::binary);
     std::vector<int64_t> vec;
     if (!f_in.is_open()) return vec;
     int64_t val;
@@ -69,7 +69,7 @@ std::string random_string(size_t length) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void write_dna_in_bits(const std::string &read, std::ofstream &fout) {
+void write_dna_in_bits(const std::string &read, TempOutFile &fout) {
     uint8_t dna2int[128];
     dna2int[(uint8_t)'A'] = 0;
     dna2int[(uint8_t)'C'] = 2;  // chosen to align with the bitset representation
@@ -97,7 +97,7 @@ void write_dna_in_bits(const std::string &read, std::ofstream &fout) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void read_dna_from_bits(std::string &read, std::ifstream &fin) {
+void read_dna_from_bits(std::string &read, TempInFile &fin) {
     uint16_t readlen;
     uint8_t bitarray[128];
     const char int2dna[4] = {'A', 'G', 'C', 'T'};
@@ -125,7 +125,7 @@ void read_dna_from_bits(std::string &read, std::ifstream &fin) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void write_dnaN_in_bits(const std::string &read, std::ofstream &fout) {
+void write_dnaN_in_bits(const std::string &read, TempOutFile &fout) {
     uint8_t dna2int[128];
     dna2int[(uint8_t)'A'] = 0;
     dna2int[(uint8_t)'C'] = 2;  // chosen to align with the bitset representation
@@ -154,7 +154,7 @@ void write_dnaN_in_bits(const std::string &read, std::ofstream &fout) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void read_dnaN_from_bits(std::string &read, std::ifstream &fin) {
+void read_dnaN_from_bits(std::string &read, TempInFile &fin) {
     uint16_t readlen;
     uint8_t bitarray[256];
     const char int2dna[5] = {'A', 'G', 'C', 'T', 'N'};
@@ -14,6 +14,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include "genie/read/spring/temp-file.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -72,7 +73,7 @@ std::string random_string(size_t length);
  * @param fout
  * @return
  */
-void write_dnaN_in_bits(const std::string &read, std::ofstream &fout);
+void write_dnaN_in_bits(const std::string &read, TempOutFile &fout);
 
 /**
  * @brief
@@ -80,7 +81,7 @@ void write_dnaN_in_bits(const std::string &read, std::ofstream &fout);
  * @param fin
  * @return
  */
-void read_dnaN_from_bits(std::string &read, std::ifstream &fin);
+void read_dnaN_from_bits(std::string &read, TempInFile &fin);
 
 /**
  * @brief
@@ -88,7 +89,7 @@ void read_dnaN_from_bits(std::string &read, std::ifstream &fin);
  * @param fout
  * @return
  */
-void write_dna_in_bits(const std::string &read, std::ofstream &fout);
+void write_dna_in_bits(const std::string &read, TempOutFile &fout);
 
 /**
  * @brief
@@ -96,7 +97,7 @@ void write_dna_in_bits(const std::string &read, std::ofstream &fout);
  * @param fin
  * @return
  */
-void read_dna_from_bits(std::string &read, std::ifstream &fin);
+void read_dna_from_bits(std::string &read, TempInFile &fin);
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -38,9 +38,23 @@ void BitReader::skip(size_t bytes) { istream.seekg(bytes, std::ios_base::cur); }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+size_t BitReader::readBytes(char *out, size_t size) {
+    if (!istream.good()) {
+        istream.setstate(std::ios_base::failbit);
+        return 0;
+    }
+    auto ret = static_cast<size_t>(istream.rdbuf()->sgetn(out, static_cast<std::streamsize>(size)));
+    if (ret != size) {
+        istream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void BitReader::readBypass(void *in, size_t size) {
     bitsRead += size * 8;
-    istream.read(reinterpret_cast<char *>(in), size);
+    readBytes(reinterpret_cast<char *>(in), size);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -50,8 +64,15 @@ BitReader::BitReader(std::istream &_istream) : istream(_istream), m_heldBits(0),
 // ---------------------------------------------------------------------------------------------------------------------
 
 uint64_t BitReader::getByte() {
-    char c = 0;
-    istream.read(&c, 1);
+    if (!istream.good()) {
+        istream.setstate(std::ios_base::failbit);
+        return 0;
+    }
+    auto c = istream.rdbuf()->sbumpc();
+    if (c == std::char_traits<char>::eof()) {
+        istream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+        return 0;
+    }
     return uint8_t(c);
 }
 
@@ -84,45 +105,19 @@ uint64_t BitReader::read_b(uint8_t numBits) {
     // bits = static_cast<uint64_t>(m_heldBits & ~(0xffu << m_numHeldBits));
     bits <<= numBits;  // make room for the bits to come
 
-    // Read in more bytes to satisfy the request
+    // Read in more bytes to satisfy the request, all at once from the stream buffer
     auto numBytesToLoad = uint8_t(((numBits - 1u) >> 3u) + 1);
     uint64_t alignedWord = 0;
-    // uint64_t alignedWord = 0;
     if (numBytesToLoad == 1) {
-        goto L1;
-    } else if (numBytesToLoad == 2) {
-        goto L2;
-    } else if (numBytesToLoad == 3) {
-        goto L3;
-    } else if (numBytesToLoad == 4) {
-        goto L4;
-    } else if (numBytesToLoad == 5) {
-        goto L5;
-    } else if (numBytesToLoad == 6) {
-        goto L6;
-    } else if (numBytesToLoad == 7) {
-        goto L7;
-    } else if (numBytesToLoad != 8) {
-        goto L0;
+        alignedWord = getByte();
+    } else {
+        uint8_t bytes[8] = {};
+        readBytes(reinterpret_cast<char *>(bytes), numBytesToLoad);
+        for (uint8_t i = 0; i < numBytesToLoad; ++i) {
+            alignedWord = (alignedWord << 8u) | bytes[i];
+        }
     }
 
-    alignedWord |= (getByte() << 56u);
-L7:
-    alignedWord |= (getByte() << 48u);
-L6:
-    alignedWord |= (getByte() << 40u);
-L5:
-    alignedWord |= (getByte() << 32u);
-L4:
-    alignedWord |= (getByte() << 24u);
-L3:
-    alignedWord |= (getByte() << 16u);
-L2:
-    alignedWord |= (getByte() << 8u);
-L1:
-    alignedWord |= (getByte());
-L0:
-
     // Resolve remainder bits
     auto numNextHeldBits = uint8_t((64 - numBits) % 8);
 
@@ -144,7 +139,7 @@ L0:
 
 void BitReader::readBypass(std::string &str) {
     bitsRead += str.length() * 8;
-    istream.read(&str[0], str.length());
+    readBytes(&str[0], str.length());
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
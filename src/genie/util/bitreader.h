@@ -20,6 +20,10 @@ namespace util {
 
 /**
  * @brief Wrapper around an input stream to read data bit by bit instead of byte aligned.
+ *
+ * Bytes are taken straight from the stream buffer, which already holds a large block of the input, instead of going
+ * through std::istream::read for every field. Nothing is read ahead beyond the current field, so the stream position
+ * stays valid for other readers and seeks on the same stream.
  */
 class BitReader {
  private:
@@ -28,6 +32,14 @@ class BitReader {
     uint8_t m_numHeldBits;  //!< @brief Number of bits from last byte which have not been consumed so far.
     uint64_t bitsRead;      //!< @brief Total number of bits read since the BitReader has been created.
 
+    /**
+     * @brief Copy bytes from the stream buffer, failing the stream like std::istream::read if there are not enough.
+     * @param out Destination.
+     * @param size Number of bytes.
+     * @return Number of bytes copied.
+     */
+    size_t readBytes(char *out, size_t size);
+
  public:
     /**
      * @brief
@@ -45,7 +45,7 @@ T BitReader::readBypassBE() {
     static_assert(SIZE > 0, "SIZE == 0");
     static_assert(SIZE <= sizeof(T), "SIZE > sizeof(T)");
     T ret = static_cast<T>(0);
-    istream.read(reinterpret_cast<char*>(&ret), SIZE);
+    readBytes(reinterpret_cast<char*>(&ret), SIZE);
 
     // Swap Endianness if necessary
     if (SIZE > 1) {
@@ -23,9 +23,14 @@ BitWriter::~BitWriter() { flush(); }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-inline void BitWriter::writeOut(uint8_t byte) {
-    stream->write(reinterpret_cast<char *>(&byte), 1);
-    m_bitsWritten += 8;
+void BitWriter::writeBytes(const char *out, size_t size) {
+    if (!stream->good()) {
+        stream->setstate(std::ios_base::failbit);
+        return;
+    }
+    if (stream->rdbuf()->sputn(out, static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size)) {
+        stream->setstate(std::ios_base::badbit);
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -55,42 +60,14 @@ void BitWriter::write(uint64_t bits, uint8_t numBits) {
     uint64_t writeBits = (m_heldBits << topword);
     writeBits |= (bits >> numNextHeldBits);
 
-    // Write everything
-    // 1 byte / L1 is the most common case, check for it first
-    if ((numTotalBits >> 3u) == 1) {
-        goto L1;
-    } else if ((numTotalBits >> 3u) == 2) {
-        goto L2;
-    } else if ((numTotalBits >> 3u) == 3) {
-        goto L3;
-    } else if ((numTotalBits >> 3u) == 4) {
-        goto L4;
-    } else if ((numTotalBits >> 3u) == 5) {
-        goto L5;
-    } else if ((numTotalBits >> 3u) == 6) {
-        goto L6;
-    } else if ((numTotalBits >> 3u) == 7) {
-        goto L7;
-    } else if ((numTotalBits >> 3u) != 8) {
-        goto L0;
+    // Write all complete bytes at once, most significant first
+    auto numBytes = uint8_t(numTotalBits >> 3u);
+    char bytes[8];
+    for (uint8_t i = 0; i < numBytes; ++i) {
+        bytes[i] = static_cast<char>((writeBits >> ((numBytes - 1u - i) * 8u)) & 0xffu);
     }
-
-    writeOut(static_cast<uint8_t>((writeBits >> 56u) & 0xffu));
-L7:
-    writeOut(static_cast<uint8_t>((writeBits >> 48u) & 0xffu));
-L6:
-    writeOut(static_cast<uint8_t>((writeBits >> 40u) & 0xffu));
-L5:
-    writeOut(static_cast<uint8_t>((writeBits >> 32u) & 0xffu));
-L4:
-    writeOut(static_cast<uint8_t>((writeBits >> 24u) & 0xffu));
-L3:
-    writeOut(static_cast<uint8_t>((writeBits >> 16u) & 0xffu));
-L2:
-    writeOut(static_cast<uint8_t>((writeBits >> 8u) & 0xffu));
-L1:
-    writeOut(static_cast<uint8_t>(writeBits & 0xffu));
-L0:
+    writeBytes(bytes, numBytes);
+    m_bitsWritten += numBytes * 8u;
 
     // Update output bitstream state
     m_heldBits = nextHeldBits;
@@ -100,6 +77,11 @@ L0:
 // ---------------------------------------------------------------------------------------------------------------------
 
 void BitWriter::write(const std::string &string) {
+    if (isAligned()) {
+        writeBytes(string.data(), string.length());
+        m_bitsWritten += string.length() * 8;
+        return;
+    }
     for (const auto &a : string) {
         write(uint8_t(a), 8);
     }
@@ -108,6 +90,10 @@ void BitWriter::write(const std::string &string) {
 // ---------------------------------------------------------------------------------------------------------------------
 
 void BitWriter::write(std::istream *in) {
+    if (isAligned()) {
+        writeBypass(in);
+        return;
+    }
     while (true) {
         char byte = 0;
         in->read(&byte, 1);
@@ -144,11 +130,11 @@ void BitWriter::writeBypass(std::istream *in) {
     if (!isAligned()) {
         UTILS_DIE("Writer not aligned when it should be");
     }
-    const size_t BUFFERSIZE = 100;
+    const size_t BUFFERSIZE = 4096;
     char byte[BUFFERSIZE];
     do {
         in->read(byte, BUFFERSIZE);
-        stream->write(byte, in->gcount());
+        writeBytes(byte, in->gcount());
         this->m_bitsWritten += in->gcount() * 8;
     } while (in->gcount() == BUFFERSIZE);
 }
@@ -160,7 +146,7 @@ void BitWriter::writeBypass(const void *in, size_t size) {
     if (!isAligned()) {
         UTILS_DIE("Writer not aligned when it should be");
     }
-    stream->write(reinterpret_cast<const char *>(in), size);
+    writeBytes(reinterpret_cast<const char *>(in), size);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -21,6 +21,9 @@ namespace util {
 
 /**
  * @brief Controlled output to an std::ostream. Allows to write single bits.
+ *
+ * Completed bytes are handed to the stream buffer in one piece per call instead of one std::ostream::write per byte.
+ * Nothing is held back apart from the bits of an incomplete byte, so the stream can be shared and repositioned.
  */
 class BitWriter {
  private:
@@ -30,10 +33,11 @@ class BitWriter {
     uint64_t m_bitsWritten;  //!< @brief Counts number of written bits for statistical usages.
 
     /**
-     * @brief Redirect assembled byte to the output stream
-     * @param byte Output data
+     * @brief Copy bytes to the stream buffer, failing the stream like std::ostream::write if they do not fit.
+     * @param out Output data
+     * @param size Number of bytes
      */
-    void writeOut(uint8_t byte);
+    void writeBytes(const char *out, size_t size);
 
  public:
     /**
@@ -36,7 +36,7 @@ void BitWriter::writeBypassBE(T val) {
         swap_endianness<T, SIZE>(val);
     }
 
-    stream->write(reinterpret_cast<char*>(&val), SIZE);
+    writeBytes(reinterpret_cast<char*>(&val), SIZE);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -34,6 +34,19 @@ class DataBlock {
     uint8_t lgWordSize;         //!< @brief log2 of the wordsize. Wordsize = 1 << lgWordsize
     std::vector<uint8_t> data;  //!< @brief The actual raw data.
 
+    /**
+     * @brief Map a range element by element, the inner loop of the bulk functions
+     * @tparam W Output type
+     * @tparam T Input type
+     * @tparam Func Callable mapping one input to one output
+     * @param begin First input
+     * @param end Behind the last input
+     * @param out First output
+     * @param translate Mapping
+     */
+    template <typename W, typename T, typename Func>
+    static void transformRange(const T *begin, const T *end, W *out, Func translate);
+
  public:
     /**
      * @brief Get lg base 2 of the size of one symbol in bytes
@@ -336,6 +349,56 @@ class DataBlock {
      */
     void emplace_back(uint64_t val);
 
+    /**
+     * @brief Typed access to the symbols, without dispatching on the word size for every element.
+     * @tparam T Unsigned integer type with the size of one symbol
+     * @return Pointer to the first symbol
+     */
+    template <typename T>
+    T *getTypedData();
+
+    /**
+     * @brief Typed access to the symbols, without dispatching on the word size for every element.
+     * @tparam T Unsigned integer type with the size of one symbol
+     * @return Pointer to the first symbol
+     */
+    template <typename T>
+    const T *getTypedData() const;
+
+    /**
+     * @brief Append a range of symbols, each narrowed to the word size. Memory is allocated and the word size
+     * dispatched once for the whole range.
+     * @tparam T Input type
+     * @param begin First input
+     * @param end Behind the last input
+     */
+    template <typename T>
+    void append(const T *begin, const T *end);
+
+    /**
+     * @brief Append a range of symbols, mapping each input to a symbol first. Like append(), but e.g. for alphabet
+     * lookup tables or offsets applied in the same pass.
+     * @tparam T Input type
+     * @tparam Func Callable mapping one input to one symbol
+     * @param begin First input
+     * @param end Behind the last input
+     * @param translate Mapping
+     */
+    template <typename T, typename Func>
+    void appendTransformed(const T *begin, const T *end, Func translate);
+
+    /**
+     * @brief Copy a range of symbols out of the block, mapping each symbol to an output first.
+     * @tparam T Output type
+     * @tparam Func Callable mapping one symbol to one output
+     * @param index Position of the first symbol
+     * @param begin First output
+     * @param end Behind the last output
+     * @param translate Mapping
+     */
+    template <typename T, typename Func>
+    void extractTransformed(size_t index, T *begin, T *end, Func translate) const;
+
     /**
      * @brief Get raw const pointer to memory block
      * @return Pointer
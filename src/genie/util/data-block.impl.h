@@ -129,6 +129,89 @@ inline void DataBlock::emplace_back(uint64_t val) { push_back(val); }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+template <typename T>
+inline T *DataBlock::getTypedData() {
+    UTILS_DIE_IF(sizeof(T) != getWordSize(), "Typed DataBlock access with wrong word size");
+    return reinterpret_cast<T *>(data.data());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline const T *DataBlock::getTypedData() const {
+    UTILS_DIE_IF(sizeof(T) != getWordSize(), "Typed DataBlock access with wrong word size");
+    return reinterpret_cast<const T *>(data.data());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename W, typename T, typename Func>
+inline void DataBlock::transformRange(const T *begin, const T *end, W *out, Func translate) {
+    for (; begin != end; ++begin, ++out) {
+        *out = static_cast<W>(translate(*begin));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename T>
+inline void DataBlock::append(const T *begin, const T *end) {
+    appendTransformed(begin, end, [](T v) { return v; });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename Func>
+inline void DataBlock::appendTransformed(const T *begin, const T *end, Func translate) {
+    const size_t offset = size();
+    resize(offset + static_cast<size_t>(end - begin));
+    switch (lgWordSize) {
+        case 0:
+            transformRange(begin, end, getTypedData<uint8_t>() + offset, translate);
+            return;
+        case 1:
+            transformRange(begin, end, getTypedData<uint16_t>() + offset, translate);
+            return;
+        case 2:
+            transformRange(begin, end, getTypedData<uint32_t>() + offset, translate);
+            return;
+        case 3:
+            transformRange(begin, end, getTypedData<uint64_t>() + offset, translate);
+            return;
+        default:
+            return;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename T, typename Func>
+inline void DataBlock::extractTransformed(size_t index, T *begin, T *end, Func translate) const {
+    const auto count = static_cast<size_t>(end - begin);
+    UTILS_DIE_IF(index + count > size(), "DataBlock range out of bounds");
+    switch (lgWordSize) {
+        case 0:
+            transformRange(getTypedData<uint8_t>() + index, getTypedData<uint8_t>() + index + count, begin, translate);
+            return;
+        case 1:
+            transformRange(getTypedData<uint16_t>() + index, getTypedData<uint16_t>() + index + count, begin,
+                           translate);
+            return;
+        case 2:
+            transformRange(getTypedData<uint32_t>() + index, getTypedData<uint32_t>() + index + count, begin,
+                           translate);
+            return;
+        case 3:
+            transformRange(getTypedData<uint64_t>() + index, getTypedData<uint64_t>() + index + count, begin,
+                           translate);
+            return;
+        default:
+            return;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 inline const void *DataBlock::getData() const { return data.data(); }
 
 // ---------------------------------------------------------------------------------------------------------------------
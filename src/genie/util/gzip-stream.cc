@@ -0,0 +1,249 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/util/gzip-stream.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include "genie/util/make-unique.h"
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param data Memory
+ * @return Little endian 16 bit value
+ */
+static uint32_t readLE16(const char *data) {
+    return uint32_t(uint8_t(data[0])) | (uint32_t(uint8_t(data[1])) << 8u);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param data Memory
+ * @return Little endian 32 bit value
+ */
+static uint32_t readLE32(const char *data) { return readLE16(data) | (readLE16(data + 2) << 16u); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Decompress the raw deflate data of one BGZF block
+ * @param in Compressed data
+ * @param inSize Compressed size
+ * @param out Destination
+ * @param outSize Decompressed size from the block trailer
+ * @param crc Checksum from the block trailer
+ * @return True on success
+ */
+static bool inflateBlock(const char *in, size_t inSize, char *out, size_t outSize, uint32_t crc) {
+    z_stream block;
+    std::memset(&block, 0, sizeof(block));
+    if (inflateInit2(&block, -MAX_WBITS) != Z_OK) {
+        return false;
+    }
+    block.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in));
+    block.avail_in = static_cast<uInt>(inSize);
+    block.next_out = reinterpret_cast<Bytef *>(out);
+    block.avail_out = static_cast<uInt>(outSize);
+    auto ret = inflate(&block, Z_FINISH);
+    bool success = ret == Z_STREAM_END && block.total_out == outSize;
+    inflateEnd(&block);
+    return success && crc32(0, reinterpret_cast<const Bytef *>(out), static_cast<uInt>(outSize)) == crc;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GzipStreamBuffer::GzipStreamBuffer(std::istream &_source, size_t _numThreads)
+    : source(_source),
+      numThreads(std::max<size_t>(_numThreads, 1)),
+      input(INPUT_SIZE),
+      inputBegin(0),
+      inputEnd(0),
+      stream(util::make_unique<z_stream_s>()),
+      memberOpen(false) {
+    UTILS_DIE_IF(inflateInit2(stream.get(), MAX_WBITS + 16) != Z_OK, "Could not initialize gzip decompression");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GzipStreamBuffer::~GzipStreamBuffer() { inflateEnd(stream.get()); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool GzipStreamBuffer::fillInput(size_t size) {
+    if (inputEnd - inputBegin >= size) {
+        return true;
+    }
+    std::copy(input.begin() + inputBegin, input.begin() + inputEnd, input.begin());
+    inputEnd -= inputBegin;
+    inputBegin = 0;
+    if (input.size() < size) {
+        input.resize(size);
+    }
+    while (inputEnd < size) {
+        source.read(input.data() + inputEnd, static_cast<std::streamsize>(input.size() - inputEnd));
+        if (!source.gcount()) {
+            return false;
+        }
+        inputEnd += static_cast<size_t>(source.gcount());
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t GzipStreamBuffer::getBgzfBlockSize(size_t offset, size_t &headerSize) {
+    constexpr size_t FIXED_HEADER_SIZE = 12;
+    constexpr uint8_t FLAG_EXTRA = 4;
+    if (!fillInput(offset + FIXED_HEADER_SIZE)) {
+        return 0;
+    }
+    const char *header = input.data() + inputBegin + offset;
+    if (uint8_t(header[0]) != 0x1f || uint8_t(header[1]) != 0x8b || header[2] != Z_DEFLATED ||
+        header[3] != FLAG_EXTRA) {
+        return 0;
+    }
+    headerSize = FIXED_HEADER_SIZE + readLE16(header + 10);
+    if (!fillInput(offset + headerSize)) {
+        return 0;
+    }
+    header = input.data() + inputBegin + offset;
+
+    // Look for the BC subfield holding the block size
+    size_t pos = FIXED_HEADER_SIZE;
+    while (pos + 4 <= headerSize) {
+        auto length = readLE16(header + pos + 2);
+        if (header[pos] == 'B' && header[pos + 1] == 'C' && length == 2 && pos + 6 <= headerSize) {
+            return readLE16(header + pos + 4) + 1;
+        }
+        pos += 4 + length;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t GzipStreamBuffer::inflateBgzfBlocks() {
+    struct Block {
+        size_t inOffset;
+        size_t inSize;
+        size_t outOffset;
+        size_t outSize;
+        uint32_t crc;
+    };
+    constexpr size_t TRAILER_SIZE = 8;
+
+    // Collect complete blocks. Offsets are relative to inputBegin, which stays valid if the input is compacted.
+    std::vector<Block> blocks;
+    size_t offset = 0;
+    size_t outSize = 0;
+    size_t headerSize = 0;
+    size_t blockSize = 0;
+    while (blocks.size() < numThreads * BGZF_BLOCKS_PER_THREAD &&
+           (blockSize = getBgzfBlockSize(offset, headerSize)) != 0) {
+        UTILS_DIE_IF(blockSize < headerSize + TRAILER_SIZE, "Invalid BGZF block size");
+        UTILS_DIE_IF(!fillInput(offset + blockSize), "Truncated BGZF block");
+        const char *trailer = input.data() + inputBegin + offset + blockSize - TRAILER_SIZE;
+        blocks.push_back(Block{offset + headerSize, blockSize - headerSize - TRAILER_SIZE, outSize,
+                               readLE32(trailer + 4), readLE32(trailer)});
+        outSize += blocks.back().outSize;
+        offset += blockSize;
+    }
+    if (blocks.empty()) {
+        return 0;
+    }
+
+    output.resize(std::max(outSize, size_t(1)));
+    const char *in = input.data() + inputBegin;
+    std::vector<uint8_t> success(blocks.size());
+#ifdef GENIE_USE_OPENMP
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+    for (int64_t i = 0; i < static_cast<int64_t>(blocks.size()); ++i) {
+        const auto &b = blocks[i];
+        success[i] = inflateBlock(in + b.inOffset, b.inSize, output.data() + b.outOffset, b.outSize, b.crc);
+    }
+    UTILS_DIE_IF(std::find(success.begin(), success.end(), 0) != success.end(), "Corrupt BGZF block");
+    inputBegin += offset;
+    return outSize;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t GzipStreamBuffer::inflateMember() {
+    output.resize(OUTPUT_SIZE);
+    stream->next_out = reinterpret_cast<Bytef *>(output.data());
+    stream->avail_out = static_cast<uInt>(output.size());
+    while (stream->avail_out) {
+        UTILS_DIE_IF(!fillInput(1), "Truncated gzip file");
+        stream->next_in = reinterpret_cast<Bytef *>(input.data() + inputBegin);
+        stream->avail_in = static_cast<uInt>(inputEnd - inputBegin);
+        auto ret = inflate(stream.get(), Z_NO_FLUSH);
+        inputBegin = inputEnd - stream->avail_in;
+        if (ret == Z_STREAM_END) {
+            memberOpen = false;
+            break;
+        }
+        UTILS_DIE_IF(ret != Z_OK, "Corrupt gzip file");
+    }
+    return output.size() - stream->avail_out;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GzipStreamBuffer::int_type GzipStreamBuffer::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    // Members and blocks may be empty, continue until there is data or the input ends
+    size_t size = 0;
+    while (!size) {
+        if (memberOpen) {
+            size = inflateMember();
+            continue;
+        }
+        size_t headerSize = 0;
+        if (getBgzfBlockSize(0, headerSize)) {
+            size = inflateBgzfBlocks();
+            continue;
+        }
+        if (!fillInput(1)) {
+            return traits_type::eof();
+        }
+        UTILS_DIE_IF(!fillInput(2) || uint8_t(input[inputBegin]) != 0x1f || uint8_t(input[inputBegin + 1]) != 0x8b,
+                     "Not a gzip file");
+        UTILS_DIE_IF(inflateReset(stream.get()) != Z_OK, "Could not reset gzip decompression");
+        memberOpen = true;
+    }
+    setg(output.data(), output.data(), output.data() + size);
+    return traits_type::to_int_type(*gptr());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+GzipStream::GzipStream(std::istream &source, size_t numThreads) : std::istream(nullptr), buffer(source, numThreads) {
+    rdbuf(&buffer);
+    // Report corrupt input instead of ending the stream early
+    exceptions(std::ios_base::badbit);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
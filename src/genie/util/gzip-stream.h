@@ -0,0 +1,134 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_GZIP_STREAM_H_
+#define SRC_GENIE_UTIL_GZIP_STREAM_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+struct z_stream_s;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+/**
+ * @brief Stream buffer decompressing gzip data from another stream. Files made of several members are read to the
+ * end. BGZF files (a gzip member per 64 KiB block, block size in the header) are decompressed a batch of blocks at a
+ * time, the blocks of a batch in parallel.
+ */
+class GzipStreamBuffer : public std::streambuf {
+ private:
+    static constexpr size_t INPUT_SIZE = 1024 * 1024;     //!< @brief Compressed bytes to read at once
+    static constexpr size_t OUTPUT_SIZE = 1024 * 1024;    //!< @brief Bytes to decompress at once without BGZF
+    static constexpr size_t BGZF_BLOCKS_PER_THREAD = 16;  //!< @brief BGZF blocks of one batch per thread
+
+    std::istream &source;                //!< @brief Compressed input
+    size_t numThreads;                   //!< @brief Threads for BGZF batches
+    std::vector<char> input;             //!< @brief Compressed data
+    size_t inputBegin;                   //!< @brief First unconsumed byte in input
+    size_t inputEnd;                     //!< @brief End of valid data in input
+    std::vector<char> output;            //!< @brief Decompressed data, the get area
+    std::unique_ptr<z_stream_s> stream;  //!< @brief State for members which are not BGZF blocks
+    bool memberOpen;                     //!< @brief True while in the middle of such a member
+
+    /**
+     * @brief Make sure the given number of compressed bytes is available behind inputBegin
+     * @param size Number of bytes
+     * @return False if the source ended before
+     */
+    bool fillInput(size_t size);
+
+    /**
+     * @brief Check if a BGZF block starts at an offset
+     * @param offset Offset relative to inputBegin
+     * @param headerSize Set to the length of the block header
+     * @return Size of the whole block, 0 if there is no BGZF block
+     */
+    size_t getBgzfBlockSize(size_t offset, size_t &headerSize);
+
+    /**
+     * @brief Decompress the next batch of BGZF blocks into the output buffer
+     * @return Number of decompressed bytes
+     */
+    size_t inflateBgzfBlocks();
+
+    /**
+     * @brief Continue decompressing the current member into the output buffer
+     * @return Number of decompressed bytes
+     */
+    size_t inflateMember();
+
+ protected:
+    /**
+     * @brief Decompress the next part of the input
+     * @return Next character or eof
+     */
+    int_type underflow() override;
+
+ public:
+    /**
+     * @brief
+     * @param _source Compressed input
+     * @param _numThreads Threads for BGZF input
+     */
+    explicit GzipStreamBuffer(std::istream &_source, size_t _numThreads = 1);
+
+    /**
+     * @brief
+     */
+    GzipStreamBuffer(const GzipStreamBuffer &) = delete;
+
+    /**
+     * @brief
+     * @return
+     */
+    GzipStreamBuffer &operator=(const GzipStreamBuffer &) = delete;
+
+    /**
+     * @brief Release the decompressor, the source stays open
+     */
+    ~GzipStreamBuffer() override;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Input stream reading decompressed data from a gzip compressed stream
+ */
+class GzipStream : public std::istream {
+ private:
+    GzipStreamBuffer buffer;  //!< @brief Decompressor
+
+ public:
+    /**
+     * @brief
+     * @param source Compressed input
+     * @param numThreads Threads for BGZF input
+     */
+    explicit GzipStream(std::istream &source, size_t numThreads = 1);
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_GZIP_STREAM_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/util/line-reader.h"
+#include <algorithm>
+#include <cstring>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+LineReader::LineReader(std::istream &_stream, size_t blockSize)
+    : stream(_stream), buffer(std::max<size_t>(blockSize, 1), '\0'), begin(0), pos(0), end(0), eof(false) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool LineReader::refill() {
+    if (eof) {
+        return false;
+    }
+    if (begin) {
+        std::memmove(&buffer[0], buffer.data() + begin, end - begin);
+        pos -= begin;
+        end -= begin;
+        begin = 0;
+    }
+    if (end == buffer.size()) {
+        // A single record does not fit, grow instead of dropping kept lines
+        buffer.resize(buffer.size() * 2);
+    }
+    stream.read(&buffer[end], static_cast<std::streamsize>(buffer.size() - end));
+    auto count = static_cast<size_t>(stream.gcount());
+    end += count;
+    eof = count == 0;
+    return !eof;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool LineReader::readLine(StringView &line) {
+    size_t scan = pos;
+    while (true) {
+        auto newline = static_cast<const char *>(std::memchr(buffer.data() + scan, '\n', end - scan));
+        if (newline) {
+            auto stop = static_cast<size_t>(newline - buffer.data());
+            line = StringView(pos - begin, stop - begin);
+            pos = stop + 1;
+            return true;
+        }
+        // Continue behind the part already scanned, refill() moves it to the front
+        scan = end - begin;
+        if (!refill()) {
+            break;
+        }
+    }
+    if (pos == end) {
+        return false;
+    }
+    line = StringView(pos - begin, end - begin);
+    pos = end;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const char *LineReader::data() const { return buffer.data() + begin; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void LineReader::discard() { begin = pos; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
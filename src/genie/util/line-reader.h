@@ -0,0 +1,82 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_LINE_READER_H_
+#define SRC_GENIE_UTIL_LINE_READER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <istream>
+#include <string>
+#include "genie/util/stringview.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+/**
+ * @brief Reads text lines from a stream in large blocks. Newlines are searched with memchr on the block and lines are
+ * returned as views into it, so nothing is copied or allocated per line. Like std::getline, the newline is removed
+ * and a last line without newline is returned as well.
+ *
+ * Lines stay in memory until discard() is called, even if the block has to be refilled or grown in between.
+ */
+class LineReader {
+ private:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;  //!< @brief Bytes to read at once
+
+    std::istream &stream;  //!< @brief Input
+    std::string buffer;    //!< @brief Kept lines followed by data not scanned yet
+    size_t begin;          //!< @brief First byte not discarded
+    size_t pos;            //!< @brief Start of the next line
+    size_t end;            //!< @brief End of valid data in the buffer
+    bool eof;              //!< @brief True if the stream is exhausted
+
+    /**
+     * @brief Move the kept data to the front of the buffer and read the next block behind it
+     * @return False if there is no more data
+     */
+    bool refill();
+
+ public:
+    /**
+     * @brief
+     * @param _stream Input
+     * @param blockSize Bytes to read at once
+     */
+    explicit LineReader(std::istream &_stream, size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    /**
+     * @brief Read the next line
+     * @param line Offsets of the line relative to data()
+     * @return False if the stream ended
+     */
+    bool readLine(StringView &line);
+
+    /**
+     * @brief
+     * @return Start of the lines read since the last discard(), valid until the next readLine()
+     */
+    const char *data() const;
+
+    /**
+     * @brief Release all lines read so far, their offsets become invalid
+     */
+    void discard();
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_LINE_READER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/util/mapped-file.h"
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+MappedFile::MappedFile(const std::string& path) : mem(nullptr), length(0) {
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* ptr = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if (ptr != MAP_FAILED) {
+            mem = static_cast<const char*>(ptr);
+            length = static_cast<size_t>(info.st_size);
+#ifdef POSIX_MADV_RANDOM
+            // Reference chunks are requested in data order, not file order
+            posix_madvise(ptr, length, POSIX_MADV_RANDOM);
+#endif
+        }
+    }
+    // The mapping stays valid after closing the descriptor
+    close(fd);
+#else
+    (void)path;
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mem) {
+        munmap(const_cast<char*>(mem), length);
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool MappedFile::isMapped() const { return mem != nullptr; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const char* MappedFile::data() const { return mem; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t MappedFile::size() const { return length; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_MAPPED_FILE_H_
+#define SRC_GENIE_UTIL_MAPPED_FILE_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <string>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+/**
+ * @brief Read-only memory mapping of a whole file. Concurrent readers can access any position without sharing a
+ * stream and its seek position. On platforms without mmap the file is not mapped and isMapped() returns false.
+ */
+class MappedFile {
+ private:
+    const char* mem;  //!< @brief Start of the mapping, nullptr if not mapped
+    size_t length;    //!< @brief Size of the file in bytes
+
+ public:
+    /**
+     * @brief Map a file. Failing to map is not an error, check isMapped() afterwards.
+     * @param path Path to the file
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief
+     */
+    MappedFile(const MappedFile&) = delete;
+
+    /**
+     * @brief
+     * @return
+     */
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Unmap the file
+     */
+    ~MappedFile();
+
+    /**
+     * @brief
+     * @return True if the file content is accessible via data()
+     */
+    bool isMapped() const;
+
+    /**
+     * @brief
+     * @return Start of the file content
+     */
+    const char* data() const;
+
+    /**
+     * @brief
+     * @return Size of the file in bytes
+     */
+    size_t size() const;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_MAPPED_FILE_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
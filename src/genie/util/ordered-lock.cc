@@ -23,6 +23,13 @@ void OrderedLock::wait(size_t id) {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+bool OrderedLock::tryWait(size_t id) {
+    std::unique_lock<std::mutex> lock(m);
+    return id == counter;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 void OrderedLock::finished(size_t length) {
     {
         std::unique_lock<std::mutex> lock(m);
@@ -38,6 +38,13 @@ class OrderedLock {
      */
     void wait(size_t id);
 
+    /**
+     * @brief Checks without blocking if the current thread / data block is allowed to execute
+     * @param id Block / thread identifier of this thread
+     * @return True if it is the turn of this block. It stays its turn until finished() is called.
+     */
+    bool tryWait(size_t id);
+
     /**
      * @brief Marks current block / thread as finished and triggers waiting threads to continue if allowed to.
      */
@@ -0,0 +1,128 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_REORDER_BUFFER_H_
+#define SRC_GENIE_UTIL_REORDER_BUFFER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "genie/util/drain.h"
+#include "genie/util/task-scheduler.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+/**
+ * @brief Brings data blocks finished by concurrent threads back into their original order. Finished blocks are
+ * deposited together with their section on a lock-free stack and the depositing thread continues immediately. The
+ * first thread finding the buffer idle becomes the drainer and passes all blocks which are next in line to the sink.
+ * Replaces waiting on an OrderedLock: only the drainer does the in-order work, nobody waits for its turn.
+ * @tparam TYPE Data block type.
+ */
+template <typename TYPE>
+class ReorderBuffer {
+ public:
+    using Sink = std::function<void(TYPE&&)>;  //!< @brief In-order consumer of the data blocks
+
+ private:
+    /**
+     * @brief A deposited data block
+     */
+    struct Entry {
+        std::unique_ptr<TYPE> data;  //!< @brief Data block, nullptr for skipped sections
+        Section section;             //!< @brief Position in the stream
+        Entry* next;                 //!< @brief Next entry on the incoming stack
+    };
+
+    Sink sink;                                             //!< @brief Where to write blocks in order
+    size_t capacity;                                       //!< @brief Maximum number of blocks waiting in the buffer
+    std::atomic<Entry*> incoming;                          //!< @brief Lock-free stack of freshly deposited blocks
+    std::atomic<bool> draining;                            //!< @brief Set while a thread is draining
+    std::atomic<size_t> numPending;                        //!< @brief Deposited blocks not passed to the sink yet
+    std::atomic<size_t> counter;                           //!< @brief Start of the next section in line
+    std::multimap<size_t, std::unique_ptr<Entry>> parked;  //!< @brief Out of order blocks, only used by the drainer
+    std::atomic<size_t> numWaiting;                        //!< @brief Depositors waiting for space in the buffer
+    std::mutex waitLock;                                   //!< @brief Protects waiting of threads without scheduler
+    std::condition_variable vacated;                       //!< @brief Signals space to threads without scheduler
+    std::atomic<TaskScheduler*> waitingScheduler;          //!< @brief Scheduler of helping waiters, woken on space
+
+    /**
+     * @brief Put an entry on the incoming stack and drain if possible. If the buffer is full and the entry is not
+     * next in line, wait for the drainer to make space first. Worker threads of a TaskScheduler run other tasks
+     * meanwhile, other threads sleep.
+     * @param e Entry
+     */
+    void push(Entry* e);
+
+    /**
+     * @brief Pass all blocks in line to the sink, unless another thread is already doing that
+     */
+    void drain();
+
+ public:
+    /**
+     * @brief
+     * @param _sink In-order consumer of the data blocks
+     * @param _capacity Deposits of blocks not in line wait while this many blocks are buffered, so at most this
+     * many blocks plus the one next in line are held. Sections must be handed out to the depositing threads in order,
+     * otherwise a full buffer may never see the next block in line.
+     */
+    explicit ReorderBuffer(Sink _sink, size_t _capacity = 1024);
+
+    /**
+     * @brief Deposit a finished data block. The sink may be called by this or any other depositing thread.
+     * @param t Data block
+     * @param id Section of the data block
+     */
+    void deposit(TYPE&& t, const Section& id);
+
+    /**
+     * @brief Mark a section as finished without data
+     * @param id Skipped section
+     */
+    void skip(const Section& id);
+
+    /**
+     * @brief
+     * @return Start of the next section in line
+     */
+    size_t getCounter() const;
+
+    /**
+     * @brief Check that all deposited blocks were passed to the sink. Call after all depositing threads have
+     * finished. Dies if a section never arrived, so that lost data does not go unnoticed.
+     */
+    void flush();
+
+    /**
+     * @brief Free blocks which never got in line, e.g. after a failed run
+     */
+    ~ReorderBuffer();
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include "genie/util/reorder-buffer.impl.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_REORDER_BUFFER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,165 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_REORDER_BUFFER_IMPL_H_
+#define SRC_GENIE_UTIL_REORDER_BUFFER_IMPL_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename TYPE>
+ReorderBuffer<TYPE>::ReorderBuffer(Sink _sink, size_t _capacity)
+    : sink(std::move(_sink)),
+      capacity(_capacity),
+      incoming(nullptr),
+      draining(false),
+      numPending(0),
+      counter(0),
+      numWaiting(0),
+      waitingScheduler(nullptr) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename TYPE>
+void ReorderBuffer<TYPE>::push(Entry* e) {
+    // Backpressure: only a block which is next in line may exceed the capacity, so the buffer can always make progress
+    auto hasSpace = [this, e]() -> bool { return numPending < capacity || e->section.start == counter; };
+    if (!hasSpace()) {
+        numWaiting++;
+        auto* scheduler = TaskScheduler::getCurrent();
+        if (scheduler && scheduler->isWorkerThread()) {
+            waitingScheduler = scheduler;
+            scheduler->helpUntil(hasSpace);
+        } else {
+            std::unique_lock<std::mutex> guard(waitLock);
+            vacated.wait(guard, hasSpace);
+        }
+        numWaiting--;
+    }
+    numPending++;
+    e->next = incoming.load(std::memory_order_relaxed);
+    while (!incoming.compare_exchange_weak(e->next, e, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    }
+    drain();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename TYPE>
+void ReorderBuffer<TYPE>::drain() {
+    // If another thread is draining, it will pick up our entry after releasing the flag. This is a store-then-load
+    // handshake on both sides (depositor: push entry, test flag; drainer: clear flag, test stack), so all four
+    // operations have to be sequentially consistent. With acquire / release only, both threads could see the old
+    // value of the other's store and the entry would be stranded.
+    while (incoming.load(std::memory_order_seq_cst) != nullptr) {
+        if (draining.exchange(true, std::memory_order_seq_cst)) {
+            return;
+        }
+        struct Release {
+            std::atomic<bool>* flag;
+            ~Release() { flag->store(false, std::memory_order_seq_cst); }
+        } release{&draining};
+
+        // The stack is in reverse deposit order
+        std::vector<Entry*> fresh;
+        for (Entry* e = incoming.exchange(nullptr, std::memory_order_acquire); e != nullptr; e = e->next) {
+            fresh.push_back(e);
+        }
+        for (auto it = fresh.rbegin(); it != fresh.rend(); ++it) {
+            parked.emplace((*it)->section.start, std::unique_ptr<Entry>(*it));
+        }
+
+        while (!parked.empty() && parked.begin()->first == counter) {
+            auto e = std::move(parked.begin()->second);
+            parked.erase(parked.begin());
+            if (e->data) {
+                sink(std::move(*e->data));
+            }
+            counter.store(counter.load(std::memory_order_relaxed) + e->section.length, std::memory_order_release);
+            numPending--;
+        }
+
+        // Same handshake as above: the waiter announces itself before testing for space, the drainer makes space
+        // before testing for waiters
+        if (numWaiting.load(std::memory_order_seq_cst)) {
+            {
+                std::lock_guard<std::mutex> guard(waitLock);
+            }
+            vacated.notify_all();
+            auto* scheduler = waitingScheduler.load();
+            if (scheduler) {
+                scheduler->wakeUp();
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename TYPE>
+void ReorderBuffer<TYPE>::deposit(TYPE&& t, const Section& id) {
+    push(new Entry{std::unique_ptr<TYPE>(new TYPE(std::move(t))), id, nullptr});
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename TYPE>
+void ReorderBuffer<TYPE>::skip(const Section& id) {
+    push(new Entry{nullptr, id, nullptr});
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename TYPE>
+size_t ReorderBuffer<TYPE>::getCounter() const {
+    return counter.load(std::memory_order_acquire);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename TYPE>
+void ReorderBuffer<TYPE>::flush() {
+    UTILS_DIE_IF(draining.load(), "ReorderBuffer flushed while draining");
+    UTILS_DIE_IF(incoming.load() != nullptr || !parked.empty(),
+                 "ReorderBuffer flushed with undelivered blocks, section " + std::to_string(getCounter()) +
+                     " never arrived");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template <typename TYPE>
+ReorderBuffer<TYPE>::~ReorderBuffer() {
+    // Only reached with undelivered blocks if the pipeline failed, flush() catches the regular case
+    Entry* e = incoming.exchange(nullptr);
+    while (e != nullptr) {
+        Entry* next = e->next;
+        delete e;
+        e = next;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_REORDER_BUFFER_IMPL_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
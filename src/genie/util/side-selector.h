@@ -63,6 +63,12 @@ class SideSelector {
      */
     void setSelection(std::function<size_t(Args...)> _select);
 
+    /**
+     * @brief Get all modules, e.g. to pass information the selection function does not apply to.
+     * @return List of modules.
+     */
+    const std::vector<Coder*>& getMods() const;
+
     /**
      * @brief
      * @param param
@@ -47,6 +47,13 @@ void SideSelector<Coder, Ret, Args...>::setSelection(std::function<size_t(Args..
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+template <typename Coder, typename Ret, typename... Args>
+const std::vector<Coder*>& SideSelector<Coder, Ret, Args...>::getMods() const {
+    return mods;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 template <typename Coder, typename Ret, typename... Args>
 Ret SideSelector<Coder, Ret, Args...>::process(Args... param) {
     size_t index = select(param...);
@@ -15,6 +15,10 @@ namespace util {
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+StringView::StringView() : StringView(0, 0) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 StringView::StringView(size_t start_p, size_t stop_p) : start(start_p), stop(stop_p), memory(nullptr) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -26,6 +26,11 @@ struct StringView {
     const char* memory;  //!< @brief String pointer.
 
  public:
+    /**
+     * @brief Create an empty string view.
+     */
+    StringView();
+
     /**
      * @brief Create a string view without deploying to an actual string. Just save the offsets.
      * @param start_p String begin.
@@ -0,0 +1,301 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include "genie/util/task-scheduler.h"
+#include <utility>
+#include "genie/util/runtime-exception.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+thread_local TaskScheduler* TaskScheduler::current = nullptr;
+thread_local size_t TaskScheduler::workerID = 0;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TaskScheduler::TaskScheduler(size_t num_threads)
+    : pending(0), pendingTasks(0), nextQueue(0), shutdownFlag(false) {
+    UTILS_DIE_IF(num_threads == 0, "Task scheduler needs at least one thread");
+    for (size_t i = 0; i < num_threads; ++i) {
+        queues.emplace_back(new WorkQueue());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers.emplace_back(&TaskScheduler::work, this, i);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskScheduler::work(size_t id) {
+    current = this;
+    workerID = id;
+    Task t;
+    while (true) {
+        if (findTask(t) || findLane(t)) {
+            t();
+            t = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(idleLock);
+        idleCond.wait(guard, [this]() -> bool { return pending > 0 || shutdownFlag; });
+        if (shutdownFlag && pending == 0) {
+            return;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskScheduler::push(WorkQueue* queue, Task&& t) {
+    const bool lane = queue == &laneQueue;
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        pending++;
+        if (!lane) {
+            pendingTasks++;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> guard(queue->lock);
+        queue->tasks.push_back(std::move(t));
+    }
+    // Helping threads only wait for non-lane tasks, so they need to be reached as well
+    if (lane) {
+        idleCond.notify_one();
+    } else {
+        idleCond.notify_all();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TaskScheduler::findTask(Task& t) {
+    const bool own = current == this;
+    if (own) {
+        auto& q = *queues[workerID];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            t = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            pending--;
+            pendingTasks--;
+            return true;
+        }
+    }
+    const size_t start = own ? workerID + 1 : 0;
+    for (size_t i = 0; i < queues.size(); ++i) {
+        auto& q = *queues[(start + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            t = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            pending--;
+            pendingTasks--;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TaskScheduler::findLane(Task& t) {
+    std::lock_guard<std::mutex> guard(laneQueue.lock);
+    if (laneQueue.tasks.empty()) {
+        return false;
+    }
+    t = std::move(laneQueue.tasks.front());
+    laneQueue.tasks.pop_front();
+    pending--;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskScheduler::submit(Task t) {
+    if (current == this) {
+        push(queues[workerID].get(), std::move(t));
+    } else {
+        push(queues[nextQueue++ % queues.size()].get(), std::move(t));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskScheduler::submitLane(Task t) { push(&laneQueue, std::move(t)); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TaskScheduler::runPendingTask() {
+    Task t;
+    if (!findTask(t)) {
+        return false;
+    }
+    t();
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskScheduler::helpUntil(const std::function<bool()>& done) {
+    Task t;
+    while (true) {
+        if (findTask(t)) {
+            t();
+            t = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(idleLock);
+        idleCond.wait(guard, [this, &done]() -> bool { return pendingTasks > 0 || done(); });
+        if (done()) {
+            return;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskScheduler::wakeUp() {
+    {
+        // Waiters evaluate their condition under the lock, so taking it orders the notification after that
+        std::lock_guard<std::mutex> guard(idleLock);
+    }
+    idleCond.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t TaskScheduler::getNumThreads() const { return workers.size(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TaskScheduler::isWorkerThread() const { return current == this; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TaskScheduler* TaskScheduler::getCurrent() { return current; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t TaskScheduler::getWorkerID() { return workerID; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskScheduler::shutdown() {
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        shutdownFlag = true;
+    }
+    idleCond.notify_all();
+    for (auto& w : workers) {
+        if (w.joinable()) {
+            w.join();
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TaskScheduler::~TaskScheduler() { shutdown(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TaskGroup::TaskGroup(TaskScheduler* _scheduler) : scheduler(_scheduler), outstanding(0) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskGroup::execute(const TaskScheduler::Task& t) {
+    try {
+        t();
+    } catch (...) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskGroup::finish() {
+    // A helping waiter may return and destroy the group as soon as the lock is released, so copy what is needed
+    TaskScheduler* sched = scheduler;
+    bool last = false;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        last = --outstanding == 0;
+        if (last) {
+            doneCond.notify_all();
+        }
+    }
+    if (last && sched) {
+        sched->wakeUp();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskGroup::run(TaskScheduler::Task t) {
+    if (!scheduler) {
+        execute(t);
+        return;
+    }
+    outstanding++;
+    scheduler->submit([this, t]() {
+        execute(t);
+        finish();
+    });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskGroup::runLane(TaskScheduler::Task t) {
+    if (!scheduler) {
+        execute(t);
+        return;
+    }
+    outstanding++;
+    scheduler->submitLane([this, t]() {
+        execute(t);
+        finish();
+    });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TaskGroup::wait() {
+    if (scheduler && scheduler->isWorkerThread()) {
+        scheduler->helpUntil([this]() -> bool { return outstanding == 0; });
+    }
+    std::unique_lock<std::mutex> guard(lock);
+    doneCond.wait(guard, [this]() -> bool { return outstanding == 0; });
+    if (error) {
+        auto e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,221 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#ifndef SRC_GENIE_UTIL_TASK_SCHEDULER_H_
+#define SRC_GENIE_UTIL_TASK_SCHEDULER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+namespace genie {
+namespace util {
+
+/**
+ * @brief Work stealing thread pool. Every worker owns a task queue. New tasks are pushed to the queue of the
+ * submitting worker and executed from the back (LIFO). Idle workers steal the oldest tasks from the front of the
+ * other queues. Long running pipeline tasks ("lanes") live in a separate queue, so that helping threads never pick up
+ * a lane while waiting for their own subtasks.
+ */
+class TaskScheduler {
+ public:
+    using Task = std::function<void()>;  //!< @brief Unit of work
+
+ private:
+    /**
+     * @brief Task queue of one worker
+     */
+    struct WorkQueue {
+        std::mutex lock;         //!< @brief Protects the queue
+        std::deque<Task> tasks;  //!< @brief Pending tasks, owner works on the back, thieves on the front
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;  //!< @brief One queue per worker
+    WorkQueue laneQueue;                             //!< @brief Long running pipeline tasks
+    std::vector<std::thread> workers;                //!< @brief Worker threads
+    std::atomic<size_t> pending;                     //!< @brief Number of tasks waiting in any queue
+    std::atomic<size_t> pendingTasks;                //!< @brief Number of those that are not lanes
+    std::atomic<size_t> nextQueue;                   //!< @brief Round robin counter for external submissions
+    std::atomic<bool> shutdownFlag;                  //!< @brief Workers exit when set and no work is left
+    std::mutex idleLock;                             //!< @brief Protects sleeping workers
+    std::condition_variable idleCond;                //!< @brief Wakes up sleeping workers
+
+    static thread_local TaskScheduler* current;  //!< @brief Scheduler the calling thread is working for
+    static thread_local size_t workerID;         //!< @brief Queue index of the calling worker thread
+
+    /**
+     * @brief Main loop of a worker thread
+     * @param id Worker index
+     */
+    void work(size_t id);
+
+    /**
+     * @brief Push a task to the back of a queue and wake up a sleeping worker
+     * @param queue Target queue
+     * @param t Task
+     */
+    void push(WorkQueue* queue, Task&& t);
+
+    /**
+     * @brief Take a task from the own queue or steal one from another worker
+     * @param t Output task
+     * @return True if a task was found
+     */
+    bool findTask(Task& t);
+
+    /**
+     * @brief Take the next lane task
+     * @param t Output task
+     * @return True if a lane was found
+     */
+    bool findLane(Task& t);
+
+ public:
+    /**
+     * @brief Start the worker threads
+     * @param num_threads Number of worker threads
+     */
+    explicit TaskScheduler(size_t num_threads);
+
+    /**
+     * @brief Submit a short task that any worker may steal
+     * @param t Task
+     */
+    void submit(Task t);
+
+    /**
+     * @brief Submit a long running pipeline task. Lanes are only started by idle workers, never by helping threads.
+     * @param t Task
+     */
+    void submitLane(Task t);
+
+    /**
+     * @brief Execute one pending (non-lane) task on the calling thread
+     * @return True if a task was executed
+     */
+    bool runPendingTask();
+
+    /**
+     * @brief Execute pending (non-lane) tasks on the calling thread until a condition holds, sleeping while there is
+     * nothing to do. Whoever makes the condition true has to call wakeUp() afterwards.
+     * @param done Condition, evaluated with the scheduler's idle lock held
+     */
+    void helpUntil(const std::function<bool()>& done);
+
+    /**
+     * @brief Wake up all threads sleeping in the scheduler, so that they reevaluate their conditions
+     */
+    void wakeUp();
+
+    /**
+     * @brief
+     * @return Number of worker threads
+     */
+    size_t getNumThreads() const;
+
+    /**
+     * @brief
+     * @return True if the calling thread is a worker of this scheduler
+     */
+    bool isWorkerThread() const;
+
+    /**
+     * @brief
+     * @return Scheduler of the calling worker thread or nullptr if not called from a worker
+     */
+    static TaskScheduler* getCurrent();
+
+    /**
+     * @brief
+     * @return Index of the calling worker thread inside its scheduler
+     */
+    static size_t getWorkerID();
+
+    /**
+     * @brief Finish all pending tasks and join the worker threads
+     */
+    void shutdown();
+
+    /**
+     * @brief Shutdown
+     */
+    ~TaskScheduler();
+};
+
+/**
+ * @brief A set of tasks to be waited on together. The thread calling wait() helps executing pending tasks if it is a
+ * worker of the scheduler and only sleeps when there are none. Without scheduler, tasks are executed directly in run().
+ */
+class TaskGroup {
+ private:
+    TaskScheduler* scheduler;          //!< @brief Where to run the tasks, may be nullptr
+    std::atomic<size_t> outstanding;   //!< @brief Number of unfinished tasks
+    std::exception_ptr error;          //!< @brief First exception thrown by a task
+    std::mutex lock;                   //!< @brief Protects error and wakes up non-worker waiters
+    std::condition_variable doneCond;  //!< @brief Signals completion of the last task
+
+    /**
+     * @brief Execute a task and record its exception
+     * @param t Task
+     */
+    void execute(const TaskScheduler::Task& t);
+
+    /**
+     * @brief Mark one task as finished and wake up waiting threads if it was the last one
+     */
+    void finish();
+
+ public:
+    /**
+     * @brief
+     * @param _scheduler Scheduler to use. Defaults to the one of the calling worker thread.
+     */
+    explicit TaskGroup(TaskScheduler* _scheduler = TaskScheduler::getCurrent());
+
+    /**
+     * @brief Add a task to the group
+     * @param t Task
+     */
+    void run(TaskScheduler::Task t);
+
+    /**
+     * @brief Add a long running pipeline task to the group
+     * @param t Task
+     */
+    void runLane(TaskScheduler::Task t);
+
+    /**
+     * @brief Wait until all tasks of the group are finished. Rethrows the first exception thrown by a task.
+     */
+    void wait();
+
+    /**
+     * @brief Waits for remaining tasks, exceptions are dropped
+     */
+    ~TaskGroup();
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace genie
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+#endif  // SRC_GENIE_UTIL_TASK_SCHEDULER_H_
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
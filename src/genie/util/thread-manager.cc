@@ -21,27 +21,32 @@ thread_local size_t ThreadManager::threadNum;
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void ThreadManager::action(size_t id) {
-    ThreadManager::threadID = id;
-    ThreadManager::threadNum = threads.size();
+void ThreadManager::action(size_t sourceID) {
+    ThreadManager::threadID = TaskScheduler::getWorkerID();
+    ThreadManager::threadNum = numThreads;
     try {
-        for (const auto& s : source) {
-            while (!stopFlag && s->pump(counter, lock)) {
+        for (; sourceID < source.size() && !stopFlag; ++sourceID) {
+            if (source[sourceID]->pump(counter, lock)) {
+                // Requeue instead of looping, so that this thread can pick up stolen subtasks in between
+                lanes->runLane([this, sourceID]() { action(sourceID); });
+                return;
             }
         }
     } catch (genie::util::Exception& e) {
         std::cerr << e.msg() << std::endl;
-        throw(e);
+        stopFlag = true;
+        throw;
     } catch (std::exception& e) {
         std::cerr << e.what() << std::endl;
-        throw(e);
+        stopFlag = true;
+        throw;
     }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 ThreadManager::ThreadManager(size_t thread_num, size_t ctr)
-    : counter(ctr), threads(thread_num), stopFlag(false), abortFlag(false) {}
+    : counter(ctr), numThreads(thread_num), stopFlag(false), abortFlag(false), lanes(nullptr) {}
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -50,12 +55,20 @@ void ThreadManager::setSource(std::vector<OriginalSource*> src) { source = std::
 // ---------------------------------------------------------------------------------------------------------------------
 
 uint64_t ThreadManager::run() {
-    size_t ctr = 0;
-    for (auto& t : threads) {
-        t = std::thread(&ThreadManager::action, this, ctr++);
-    }
-    for (auto& t : threads) {
-        t.join();
+    {
+        TaskScheduler scheduler(numThreads);
+        TaskGroup group(&scheduler);
+        lanes = &group;
+        for (size_t i = 0; i < numThreads; ++i) {
+            group.runLane([this]() { action(0); });
+        }
+        try {
+            group.wait();
+        } catch (...) {
+            lanes = nullptr;
+            throw;
+        }
+        lanes = nullptr;
     }
     if (!abortFlag) {
         source.front()->flushIn(counter);
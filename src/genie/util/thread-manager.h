@@ -11,9 +11,9 @@
 
 #include <atomic>
 #include <mutex>
-#include <thread>
 #include <vector>
 #include "genie/util/original-source.h"
+#include "genie/util/task-scheduler.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -21,21 +21,25 @@ namespace genie {
 namespace util {
 
 /**
- * @brief Allows to run the genie pipeline with multiple threads.
+ * @brief Allows to run the genie pipeline with multiple threads. The pipeline runs on a work stealing TaskScheduler:
+ * every thread drives one lane, which pumps one block at a time through the pipeline and then requeues itself.
+ * Pipeline stages can split their work into subtasks using a TaskGroup, which idle threads steal.
  */
 class ThreadManager {
  private:
-    uint64_t counter;                  //!< @brief Identifier for next block.
-    std::vector<std::thread> threads;  //!< @brief Storage for all the threads.
-    std::atomic<bool> stopFlag;        //!< @brief Threads will stop after current block when set.
-    bool abortFlag;                    //!< @brief The flushIn signal will be skipped after stop(). Used with stopFlag.
+    uint64_t counter;            //!< @brief Identifier for next block.
+    size_t numThreads;           //!< @brief Number of worker threads.
+    std::atomic<bool> stopFlag;  //!< @brief Threads will stop after current block when set.
+    bool abortFlag;              //!< @brief The flushIn signal will be skipped after stop(). Used with stopFlag.
     std::vector<OriginalSource*> source;  //!< @brief Entry points for the pipeline.
     std::mutex lock;                      //!< @brief Mutex protecting the counter variable.
+    TaskGroup* lanes;                     //!< @brief Running lanes, only valid inside run().
 
     /**
-     * @brief Threading code.
+     * @brief Pump one block from the first source with data left and requeue the lane.
+     * @param sourceID Index of the source to start with.
      */
-    void action(size_t id);
+    void action(size_t sourceID);
 
  public:
     static thread_local size_t threadID;   //!< @brief Each thread will see its own ID here
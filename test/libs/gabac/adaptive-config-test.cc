@@ -0,0 +1,164 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/constants.h>
+#include <genie/entropy/gabac/adaptive-config.h>
+#include <genie/entropy/gabac/decode-desc-subseq.h>
+#include <genie/entropy/gabac/gabac.h>
+#include <genie/util/bitreader.h>
+#include <genie/util/bitwriter.h>
+#include <genie/util/data-block.h>
+#include <genie/util/drain.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "common.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Pass a configuration through its parameter set syntax, as the decoder sees it
+ * @param conf Configuration
+ * @param desc Descriptor
+ * @return Parsed configuration
+ */
+static genie::entropy::paramcabac::Subsequence reparse(const genie::entropy::paramcabac::Subsequence& conf,
+                                                       genie::core::GenDesc desc) {
+    std::stringstream stream;
+    {
+        genie::util::BitWriter writer(&stream);
+        conf.write(writer);
+        writer.flush();
+    }
+    genie::util::BitReader reader(stream);
+    return genie::entropy::paramcabac::Subsequence(false, desc, reader);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param start First record of the access unit
+ * @param length Number of records
+ * @return Section
+ */
+static genie::util::Section records(size_t start, size_t length = 1) { return {start, length, true}; }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(AdaptiveConfigTest, selectionRoundTrip) {
+    for (const auto& desc : genie::core::getDescriptors()) {
+        for (const auto& subseq : desc.subseqs) {
+            if (!genie::entropy::gabac::AdaptiveConfigSelector::isAdaptable(subseq.id, false)) {
+                continue;
+            }
+            const uint8_t wordsize = genie::core::range2bytes(subseq.range);
+            const auto max = std::min<uint64_t>(uint64_t(subseq.range.second), 20);
+
+            // Runs, a small alphabet and a uniform distribution
+            std::vector<genie::util::DataBlock> inputs(3, genie::util::DataBlock(2000, wordsize));
+            for (size_t i = 0; i < inputs[0].size(); ++i) {
+                inputs[0].set(i, (i / 100) % (max + 1));
+            }
+            gabac_tests::fillVectorRandomUniform(0, std::min<uint64_t>(max, 2), &inputs[1]);
+            gabac_tests::fillVectorRandomUniform(0, max, &inputs[2]);
+
+            const genie::entropy::gabac::EncodingConfiguration manual(subseq.id);
+            for (const auto& symbols : inputs) {
+                auto selected = genie::entropy::gabac::AdaptiveConfigSelector::search(
+                    symbols, manual.getSubseqConfig(), subseq.id, 0.0f);
+                const genie::entropy::gabac::EncodingConfiguration encodeConf(std::move(selected));
+                const genie::entropy::gabac::EncodingConfiguration decodeConf(
+                    reparse(encodeConf.getSubseqConfig(), desc.id));
+
+                auto payload = gabac_tests::encode(encodeConf, symbols);
+                EXPECT_LE(payload.getRawSize(), gabac_tests::encode(manual, symbols).getRawSize()) << subseq.name;
+
+                genie::util::DataBlock decoded;
+                genie::entropy::gabac::decodeDescSubsequence(decodeConf, payload, &decoded, wordsize);
+                EXPECT_EQ(decoded, symbols) << subseq.name;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(AdaptiveConfigTest, selectionRounds) {
+    const size_t interval = 2;
+    genie::entropy::gabac::AdaptiveConfigSelector selector(0.0f, 1000, interval);
+    const genie::entropy::gabac::EncodingConfiguration manual(genie::core::GenSub::RLEN);
+
+    genie::util::DataBlock block(5000, 4);
+    gabac_tests::fillVectorRandomUniform(0, 3, &block);
+    genie::core::AccessUnit::Subsequence subseq(genie::core::GenSub::RLEN, std::move(block));
+
+    // Later access units of a round wait for the first one, whatever thread gets there first
+    std::shared_ptr<const genie::entropy::gabac::EncodingConfiguration> second;
+    std::thread waiter([&]() { second = selector.get(genie::core::GenSub::RLEN, records(1)); });
+    auto first = selector.select(subseq, manual, records(0));
+    waiter.join();
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(selector.select(subseq, manual, records(1)), first);
+
+    // Reevaluated in the next round
+    auto third = selector.select(subseq, manual, records(interval));
+    EXPECT_NE(third, first);
+    EXPECT_EQ(*third, *first);
+
+    // Without data in the first access unit of a round, the previous selection is kept
+    genie::core::AccessUnit::Descriptor empty(genie::core::GenDesc::RLEN);
+    selector.begin(empty, records(2 * interval));
+    EXPECT_EQ(selector.get(genie::core::GenSub::RLEN, records(2 * interval)), third);
+    EXPECT_EQ(selector.select(subseq, manual, records(2 * interval + 1)), third);
+
+    // No reevaluation after the last round
+    const uint64_t last = (genie::entropy::gabac::AdaptiveConfigSelector::MAX_ROUNDS - 1) * interval;
+    selector.skip(records(3 * interval, last - 3 * interval));
+    auto kept = selector.select(subseq, manual, records(last));
+    EXPECT_EQ(selector.select(subseq, manual, records(last + 10 * interval)), kept);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(AdaptiveConfigTest, skippedSections) {
+    const size_t interval = 4;
+    genie::entropy::gabac::AdaptiveConfigSelector selector(0.0f, 1000, interval);
+    const genie::entropy::gabac::EncodingConfiguration manual(genie::core::GenSub::RLEN);
+
+    genie::util::DataBlock block(5000, 4);
+    gabac_tests::fillVectorRandomUniform(0, 3, &block);
+    genie::core::AccessUnit::Subsequence subseq(genie::core::GenSub::RLEN, std::move(block));
+
+    auto first = selector.select(subseq, manual, records(0, interval));
+
+    // A round covered by skips keeps the previous selection, the first access unit after a skip selects
+    selector.skip(records(interval, interval + 1));
+    auto third = selector.select(subseq, manual, records(2 * interval + 1));
+    EXPECT_NE(third, first);
+    EXPECT_EQ(selector.get(genie::core::GenSub::RLEN, records(2 * interval + 2)), third);
+
+    // The first access unit does not wait for the skips before it, the last skip decides the round
+    std::shared_ptr<const genie::entropy::gabac::EncodingConfiguration> fourth;
+    std::thread owner([&]() { fourth = selector.select(subseq, manual, records(3 * interval + 2)); });
+    selector.skip(records(3 * interval + 1, 1));
+    selector.skip(records(3 * interval, 1));
+    owner.join();
+    EXPECT_NE(fourth, third);
+
+    // An access unit arriving before an earlier one of its round gets the choice of the earlier one
+    std::shared_ptr<const genie::entropy::gabac::EncodingConfiguration> late;
+    std::thread early([&]() { late = selector.select(subseq, manual, records(4 * interval + 1)); });
+    auto fifth = selector.select(subseq, manual, records(4 * interval));
+    early.join();
+    EXPECT_EQ(late, fifth);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
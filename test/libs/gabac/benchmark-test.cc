@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/constants.h>
+#include <genie/entropy/gabac/benchmark.h>
+#include <genie/entropy/gabac/decode-desc-subseq.h>
+#include <genie/entropy/gabac/gabac.h>
+#include <genie/util/data-block.h>
+#include <genie/util/task-scheduler.h>
+#include <gtest/gtest.h>
+#include "common.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(BenchmarkTest, parallelSearchMatchesSerial) {
+    const genie::core::GenSubIndex id = genie::core::GenSub::RTYPE;
+    genie::util::DataBlock symbols(3000, genie::core::range2bytes(genie::core::getSubsequence(id).range));
+    gabac_tests::fillVectorRandomUniform(0, 5, &symbols);
+
+    genie::entropy::gabac::BenchmarkOptions options;
+    const auto serial = genie::entropy::gabac::benchmark(symbols, id, options);
+
+    genie::util::TaskScheduler scheduler(3);
+    options.scheduler = &scheduler;
+    const auto parallel = genie::entropy::gabac::benchmark(symbols, id, options);
+    scheduler.shutdown();
+
+    // Pruning only stops candidates that cannot win, so the size only search is deterministic
+    ASSERT_EQ(parallel.transformations.size(), serial.transformations.size());
+    EXPECT_EQ(parallel.best, serial.best);
+    EXPECT_EQ(parallel.getBest().size, serial.getBest().size);
+    EXPECT_EQ(parallel.getBest().config, serial.getBest().config);
+    for (const auto& c : parallel.getBest().candidates) {
+        for (const auto& r : c) {
+            EXPECT_TRUE(r.full);
+        }
+    }
+
+    const genie::entropy::gabac::EncodingConfiguration conf(
+        genie::entropy::paramcabac::Subsequence(parallel.getBest().config));
+    auto payload = gabac_tests::encode(conf, symbols);
+    genie::util::DataBlock decoded;
+    genie::entropy::gabac::decodeDescSubsequence(conf, payload, &decoded, symbols.getWordSize());
+    EXPECT_EQ(decoded, symbols);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(BenchmarkTest, sampledSearch) {
+    const genie::core::GenSubIndex id = genie::core::GenSub::RTYPE;
+    genie::util::DataBlock symbols(20000, genie::core::range2bytes(genie::core::getSubsequence(id).range));
+    gabac_tests::fillVectorRandomUniform(0, 5, &symbols);
+
+    genie::entropy::gabac::BenchmarkOptions options;
+    options.sampleSize = 2000;
+    options.confirmedCandidates = 3;
+    const auto report = genie::entropy::gabac::benchmark(symbols, id, options);
+    EXPECT_EQ(report.sampleSymbols, 2000u);
+
+    for (const auto& t : report.transformations) {
+        for (const auto& c : t.candidates) {
+            size_t confirmed = 0;
+            for (const auto& r : c) {
+                confirmed += r.full;
+            }
+            EXPECT_GE(confirmed, 1u);
+            EXPECT_LE(confirmed, 3u);
+        }
+    }
+    EXPECT_TRUE(report.toJson()["transformations"].is_array());
+
+    const genie::entropy::gabac::EncodingConfiguration conf(
+        genie::entropy::paramcabac::Subsequence(report.getBest().config));
+    auto payload = gabac_tests::encode(conf, symbols);
+    genie::util::DataBlock decoded;
+    genie::entropy::gabac::decodeDescSubsequence(conf, payload, &decoded, symbols.getWordSize());
+    EXPECT_EQ(decoded, symbols);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/entropy/gabac/reader.h>
+#include <genie/entropy/gabac/streams.h>
+#include <genie/entropy/gabac/writer.h>
+#include <genie/util/data-block.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Write symbols with one binarization kernel and read them back
+ * @param binParams Binarization parameters
+ * @param symbols Symbols, all representable by the binarization
+ */
+template <genie::entropy::paramcabac::BinarizationParameters::BinarizationId binID, bool bypass>
+static void roundTrip(genie::entropy::gabac::BinParams binParams, const std::vector<uint64_t>& symbols) {
+    using namespace genie::entropy::gabac;
+    const unsigned int numContexts = 64;
+
+    genie::util::DataBlock block(0, 1);
+    genie::util::DataBlock bitstream(0, 1);
+    OBufferStream stream(&block);
+    Writer writer(&stream, bypass, numContexts);
+    writer.start();
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        binParams.ctxIdx = i % 4;
+        writer.writeAs<binID, bypass>(symbols[i], binParams);
+    }
+    writer.close();
+    stream.flush(&bitstream);
+
+    Reader reader(&bitstream, bypass, numContexts);
+    reader.start();
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        binParams.ctxIdx = i % 4;
+        EXPECT_EQ((reader.readAs<binID, bypass>(binParams)), symbols[i])
+            << "binarization " << int(binID) << ", bypass " << bypass << ", symbol " << i;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Round trip all binarizations in one bypass mode
+ */
+template <bool bypass>
+static void roundTripAll() {
+    using BinId = genie::entropy::paramcabac::BinarizationParameters::BinarizationId;
+    genie::entropy::gabac::BinParams binParams;
+
+    binParams.cMax = 8;
+    roundTrip<BinId::BI, bypass>(binParams, {0, 1, 255, 128, 7, 0, 200});
+    roundTrip<BinId::TU, bypass>(binParams, {0, 8, 3, 7, 1, 8, 0});
+    roundTrip<BinId::EG, bypass>(binParams, {0, 1, 2, 3, 1000, 65535, 7});
+    roundTrip<BinId::TEG, bypass>(binParams, {0, 7, 8, 9, 30, 1000, 2});
+
+    binParams.cMax = 8;
+    binParams.splitUnitSize = 3;
+    roundTrip<BinId::SUTU, bypass>(binParams, {0, 255, 17, 128, 1, 64});
+    binParams.cMaxDtu = 4;
+    roundTrip<BinId::DTU, bypass>(binParams, {0, 3, 4, 5, 200, 255 + 4});
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(BinarizationTest, roundTripBypass) { roundTripAll<true>(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(BinarizationTest, roundTripCabac) { roundTripAll<false>(); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
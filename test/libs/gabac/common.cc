@@ -1,4 +1,5 @@
 #include "common.h"
+#include <genie/entropy/gabac/gabac.h>
 #include <algorithm>
 #include <iostream>
 #include <limits>
@@ -41,4 +42,18 @@ void fillVectorRandomGeometric(genie::util::DataBlock *const vector) {
     });
 }
 
+genie::util::DataBlock encode(const genie::entropy::gabac::EncodingConfiguration &conf,
+                              genie::util::DataBlock symbols) {
+    const uint8_t wordsize = symbols.getWordSize();
+    genie::entropy::gabac::IBufferStream in(&symbols);
+    genie::util::DataBlock out(0, 1);
+    genie::entropy::gabac::OBufferStream outStream(&out);
+    const genie::entropy::gabac::IOConfiguration io = {
+        &in, wordsize, nullptr, &outStream, 1, 0, &std::cerr,
+        genie::entropy::gabac::IOConfiguration::LogLevel::LOG_WARNING};
+    genie::entropy::gabac::run(io, conf, false);
+    outStream.flush(&out);
+    return out;
+}
+
 }  // namespace gabac_tests
@@ -1,12 +1,14 @@
 #ifndef GABAC_TESTS_COMMON_H_
 #define GABAC_TESTS_COMMON_H_
 
+#include <genie/entropy/gabac/configuration.h>
 #include <genie/util/data-block.h>
 
 namespace gabac_tests {
 
 void fillVectorRandomUniform(uint64_t min, uint64_t max, genie::util::DataBlock *vector);
 void fillVectorRandomGeometric(genie::util::DataBlock *vector);
+genie::util::DataBlock encode(const genie::entropy::gabac::EncodingConfiguration &conf, genie::util::DataBlock symbols);
 
 }  // namespace gabac_tests
 
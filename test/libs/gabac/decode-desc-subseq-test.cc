@@ -0,0 +1,57 @@
+#include <genie/core/constants.h>
+#include <genie/entropy/gabac/decode-desc-subseq.h>
+#include <genie/entropy/gabac/gabac.h>
+#include <genie/util/data-block.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+#include "common.h"
+
+static genie::util::DataBlock decodeSubseqStream(const genie::entropy::gabac::EncodingConfiguration& conf,
+                                                 genie::util::DataBlock payload, uint8_t wordsize) {
+    genie::entropy::gabac::IBufferStream in(&payload, 0);
+    genie::util::DataBlock out(0, wordsize);
+    genie::entropy::gabac::OBufferStream outStream(&out);
+    const genie::entropy::gabac::IOConfiguration io = {
+        &in, 1, nullptr, &outStream, wordsize, 0, &std::cerr,
+        genie::entropy::gabac::IOConfiguration::LogLevel::LOG_WARNING};
+    genie::entropy::gabac::run(io, conf, true);
+    outStream.flush(&out);
+    return out;
+}
+
+TEST(DecodeDescSubseqTest, bufferMatchesStream) {
+    const std::vector<genie::core::GenSubIndex> subseqs = {
+        genie::core::GenSub::POS_MAPPING_FIRST, genie::core::GenSub::RCOMP, genie::core::GenSub::MMPOS_POSITION,
+        genie::core::GenSub::MMTYPE_TYPE,       genie::core::GenSub::RLEN,  genie::core::GenSub::UREADS};
+    for (const auto& id : subseqs) {
+        genie::entropy::gabac::EncodingConfiguration conf(id);
+        const uint8_t wordsize = genie::core::range2bytes(genie::core::getSubsequence(id).range);
+        const auto range = genie::core::getSubsequence(id).range;
+
+        genie::util::DataBlock symbols(1000, wordsize);
+        gabac_tests::fillVectorRandomUniform(0, std::min<uint64_t>(uint64_t(range.second), 100), &symbols);
+        auto payload = gabac_tests::encode(conf, symbols);
+
+        auto expected = decodeSubseqStream(conf, payload, wordsize);
+        genie::util::DataBlock decoded;
+        auto used = genie::entropy::gabac::decodeDescSubsequence(conf, payload, &decoded, wordsize);
+
+        EXPECT_EQ(used, payload.getRawSize());
+        EXPECT_EQ(decoded.getWordSize(), wordsize);
+        EXPECT_EQ(decoded, expected);
+        ASSERT_EQ(decoded.size(), symbols.size());
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            EXPECT_EQ(decoded.get(i), symbols.get(i));
+        }
+    }
+}
+
+TEST(DecodeDescSubseqTest, emptyInput) {
+    genie::entropy::gabac::EncodingConfiguration conf(genie::core::GenSub::RLEN);
+    genie::util::DataBlock payload(0, 1);
+    genie::util::DataBlock decoded;
+    EXPECT_EQ(genie::entropy::gabac::decodeDescSubsequence(conf, payload, &decoded, 4), 0);
+    EXPECT_EQ(decoded.size(), 0);
+    EXPECT_EQ(decoded.getWordSize(), 4);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/read/spring/bitset-util.h>
+#include <gtest/gtest.h>
+#include <bitset>
+#include <random>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Random bitset
+ * @param rng Random number generator
+ * @return Bitset
+ */
+template <size_t bitset_size>
+static std::bitset<bitset_size> randomBitset(std::mt19937_64& rng) {
+    std::bitset<bitset_size> b;
+    for (size_t i = 0; i < bitset_size; ++i) {
+        b[i] = rng() & 1;
+    }
+    return b;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Compare all kernels the CPU supports with std::bitset
+ * @param rng Random number generator
+ */
+template <size_t bitset_size>
+static void checkKernels(std::mt19937_64& rng) {
+    using namespace genie::read::spring;
+    for (int round = 0; round < 50; ++round) {
+        auto a = randomBitset<bitset_size>(rng);
+        auto b = randomBitset<bitset_size>(rng);
+        auto mask = randomBitset<bitset_size>(rng);
+        const size_t expected = ((a ^ b) & mask).count();
+        for (uint8_t k = 0; k <= uint8_t(getbestbitkernel()); ++k) {
+            EXPECT_EQ(countmaskeddiff(&a, &b, &mask, bitset_size / 64, BitKernel(k)), expected)
+                << "kernel " << int(k) << ", " << bitset_size << " bits";
+        }
+        EXPECT_EQ(hammingdistance<bitset_size>(a, b, mask), expected);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SpringBitset, kernels) {
+    std::mt19937_64 rng(7);
+    checkKernels<64>(rng);
+    checkKernels<128>(rng);
+    checkKernels<192>(rng);
+    checkKernels<256>(rng);
+    checkKernels<320>(rng);
+    checkKernels<512>(rng);
+    checkKernels<576>(rng);
+    checkKernels<1024>(rng);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SpringBitset, extractBits) {
+    using namespace genie::read::spring;
+    std::mt19937_64 rng(11);
+    auto b = randomBitset<192>(rng);
+    for (size_t first = 0; first < 192; first += 7) {
+        for (size_t count : {1, 21, 42, 63, 64}) {
+            std::bitset<192> expected = b >> first;
+            if (count < 64) {
+                expected &= std::bitset<192>((uint64_t(1) << count) - 1);
+            } else {
+                expected &= std::bitset<192>(~uint64_t(0));
+            }
+            EXPECT_EQ(extractbits<192>(b, first, count), expected.to_ullong()) << first << " " << count;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
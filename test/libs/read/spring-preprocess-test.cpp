@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/read/spring/preprocess.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "filesystem/filesystem.hpp"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Single end chunk of reads without N
+ * @param num_records Number of records
+ * @param readlen Length of each read
+ * @return Chunk
+ */
+static genie::core::record::Chunk makeChunk(size_t num_records, size_t readlen = 100) {
+    genie::core::record::Chunk chunk;
+    auto& columns = chunk.getColumns();
+    const std::string seq(readlen, 'A');
+    for (size_t i = 0; i < num_records; ++i) {
+        const std::string name = "r" + std::to_string(i);
+        std::memcpy(columns.addRecord(name.length()), name.data(), name.length());
+        std::memcpy(columns.addSequence(seq.length()), seq.data(), seq.length());
+        std::memset(columns.addQualities(seq.length()), 'I', seq.length());
+    }
+    return chunk;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Single end chunk of overlapping reads sampled from a random sequence, every third read reverse complemented
+ * @param name_prefix Prefix of the read names
+ * @param seed Seed of the random sequence
+ * @param num_records Number of records
+ * @return Chunk
+ */
+static genie::core::record::Chunk makeGenomeChunk(const std::string& name_prefix, uint32_t seed, size_t num_records) {
+    const size_t readlen = 100;
+    const size_t step = 5;
+    std::string genome(readlen + step * num_records, 'A');
+    uint32_t state = seed;
+    for (auto& c : genome) {
+        state = state * 1103515245 + 12345;
+        c = "ACGT"[(state >> 16) & 3];
+    }
+    genie::core::record::Chunk chunk;
+    auto& columns = chunk.getColumns();
+    for (size_t i = 0; i < num_records; ++i) {
+        std::string seq = genome.substr(i * step, readlen);
+        if (i % 3 == 0) {
+            seq = genie::read::spring::reverse_complement(seq, static_cast<int>(readlen));
+        }
+        const std::string name = name_prefix + std::to_string(i);
+        std::memcpy(columns.addRecord(name.length()), name.data(), name.length());
+        std::memcpy(columns.addSequence(seq.length()), seq.data(), seq.length());
+        std::memset(columns.addQualities(seq.length()), 'I', seq.length());
+    }
+    return chunk;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SpringPreprocess, partitionsByMinimizer) {
+    using namespace genie::read::spring;
+    const std::string wdir = ghc::filesystem::temp_directory_path().string();
+
+    // About 100 bytes per read, so each genome fits into a partition but both do not. The chunks interleave the
+    // genomes in input order.
+    Preprocessor preprocessor;
+    preprocessor.setup(wdir, 1, false, true, 250 * 100);
+    preprocessor.preprocess(makeGenomeChunk("a", 1, 90), {0, 90, true});
+    preprocessor.preprocess(makeGenomeChunk("b", 2, 180), {90, 180, true});
+    preprocessor.preprocess(makeGenomeChunk("c", 1, 180), {270, 180, true});
+    preprocessor.finish(450);
+
+    // Overlapping reads stay together regardless of chunk and orientation, apart from buckets both genomes share
+    ASSERT_EQ(preprocessor.partitions.size(), 2);
+    size_t reads = 0;
+    size_t genome_1[2] = {0, 0};
+    size_t genome_2[2] = {0, 0};
+    for (size_t p = 0; p < 2; ++p) {
+        const auto& partition = preprocessor.partitions[p];
+        reads += partition.cp.num_reads;
+        EXPECT_EQ(partition.cp.num_reads_clean[0], partition.cp.num_reads);
+        TempInFile fin_id(partition.temp_dir + "/id_1");
+        std::string name;
+        while (std::getline(fin_id, name)) {
+            (name[0] == 'b' ? genome_2 : genome_1)[p]++;
+        }
+    }
+    EXPECT_GE(std::max(genome_1[0], genome_1[1]), 270 * 9 / 10);
+    EXPECT_GE(std::max(genome_2[0], genome_2[1]), 180 * 9 / 10);
+    EXPECT_NE(genome_1[0] > genome_1[1], genome_2[0] > genome_2[1]);
+    EXPECT_EQ(reads, 450);
+    EXPECT_FALSE(tempFileExists(preprocessor.partitions[0].temp_dir + "/read_bucket.bin"));
+
+    // Without a budget everything stays in one partition
+    Preprocessor unlimited;
+    unlimited.setup(wdir, 1, false, true);
+    unlimited.preprocess(makeGenomeChunk("a", 1, 180), {0, 180, true});
+    unlimited.preprocess(makeGenomeChunk("b", 2, 180), {180, 180, true});
+    unlimited.finish(360);
+    ASSERT_EQ(unlimited.partitions.size(), 1);
+    EXPECT_EQ(unlimited.partitions[0].cp.num_reads, 360);
+
+    for (const auto& p : preprocessor.partitions) removeTempDirectory(p.temp_dir);
+    for (const auto& p : unlimited.partitions) removeTempDirectory(p.temp_dir);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SpringPreprocess, partitionsSplitLargeBucket) {
+    using namespace genie::read::spring;
+    const std::string wdir = ghc::filesystem::temp_directory_path().string();
+
+    // Identical reads share one bucket, which is larger than a partition
+    Preprocessor preprocessor;
+    preprocessor.setup(wdir, 1, false, true, 100 * 100);
+    preprocessor.preprocess(makeChunk(100), {0, 100, true});
+    preprocessor.preprocess(makeChunk(110), {100, 110, true});
+    preprocessor.finish(210);
+
+    ASSERT_GE(preprocessor.partitions.size(), 2);
+    size_t reads = 0;
+    for (const auto& p : preprocessor.partitions) {
+        EXPECT_EQ(p.cp.max_readlen, 100);
+        EXPECT_EQ(getTempFileSize(p.temp_dir + "/quality_1"), p.cp.num_reads * 101);
+        reads += p.cp.num_reads;
+    }
+    EXPECT_EQ(reads, 210);
+
+    for (const auto& p : preprocessor.partitions) removeTempDirectory(p.temp_dir);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,68 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/read/spring/temp-file.h>
+#include <gtest/gtest.h>
+#include <string>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SpringTempFile, inMemory) {
+    using namespace genie::read::spring;
+    // The directory is never created, so nothing can end up on disk
+    const std::string dir = "genie-spring-temp-file-test/does-not-exist";
+    keepTempFilesInMemory(dir);
+
+    EXPECT_FALSE(tempFileExists(dir + "/a"));
+    TempInFile missing(dir + "/a");
+    EXPECT_FALSE(missing.is_open());
+    EXPECT_FALSE(missing);
+
+    {
+        TempOutFile out(dir + "/a", std::ios::binary);
+        ASSERT_TRUE(out.is_open());
+        uint32_t value = 42;
+        out.write(reinterpret_cast<char*>(&value), sizeof(value));
+        out << "text " << 7 << '\n';
+    }
+    {
+        TempOutFile out(dir + "/a", std::ios::binary | std::ios::app);
+        out << "more\n";
+    }
+    EXPECT_TRUE(tempFileExists(dir + "/a"));
+    EXPECT_EQ(getTempFileSize(dir + "/a"), 4 + 7 + 5);
+
+    renameTempFile(dir + "/a", dir + "/b");
+    EXPECT_FALSE(tempFileExists(dir + "/a"));
+    TempInFile in(dir + "/b", std::ios::binary);
+    in.seekg(0, in.end);
+    EXPECT_EQ(in.tellg(), 16);
+    in.seekg(0);
+    uint32_t value = 0;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    EXPECT_EQ(value, 42u);
+    std::string word;
+    int number = 0;
+    in >> word >> number;
+    EXPECT_EQ(word, "text");
+    EXPECT_EQ(number, 7);
+    std::getline(in, word);
+    std::getline(in, word);
+    EXPECT_EQ(word, "more");
+    EXPECT_FALSE(std::getline(in, word));
+
+    // Truncating does not affect open readers
+    TempInFile reader(dir + "/b");
+    TempOutFile(dir + "/b").close();
+    EXPECT_EQ(getTempFileSize(dir + "/b"), 0);
+    EXPECT_TRUE(std::getline(reader, word));
+
+    removeTempDirectory(dir);
+    EXPECT_FALSE(tempFileExists(dir + "/b"));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,213 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/api.h>
+#include <genie/core/flowgraph-decode.h>
+#include <genie/core/read-decoder.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "helpers.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+using util_tests::makeRecord;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static genie::core::api::SimpleFilter allRecords() {
+    genie::core::api::SimpleFilter filter{};
+    filter.classID.fill(true);
+    filter.sequenceID = 0;
+    filter.startPos = 0;
+    filter.endPos = std::numeric_limits<uint64_t>::max();
+    filter.singleEndsStrand.fill(true);
+    filter.pairedEndsStrand.fill(true);
+    filter.includeClippedReads.fill(true);
+    filter.includeMultipleAlignments = true;
+    filter.includeOpticalDuplicates = true;
+    filter.includeQualityCheckFailed = true;
+    return filter;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Emits access units with metadata only and honors the access unit selector
+ */
+class TestImporter : public genie::core::FormatImporterCompressed {
+ public:
+    struct AU {
+        genie::core::record::ClassType type;
+        uint64_t start;
+        uint64_t end;
+    };
+    struct Log {
+        size_t read{0};
+        std::vector<genie::core::GenDesc> skipped;
+    };
+    std::vector<AU> aus;
+    size_t next{0};
+    Log* log{nullptr};
+
+    bool pump(uint64_t& id, std::mutex&) override {
+        while (next < aus.size() && auSelector && !auSelector(aus[next].type, 0, aus[next].start, aus[next].end)) {
+            next++;
+        }
+        if (next == aus.size()) {
+            return false;
+        }
+        log->read++;
+        log->skipped = skippedDesc;
+        genie::core::AccessUnit au(genie::core::parameter::EncodingSet(), 10);
+        au.setClassType(aus[next].type);
+        au.setMinPos(aus[next].start);
+        au.setMaxPos(aus[next].end);
+        genie::util::Section sec{id, 10, true};
+        id += 10;
+        next++;
+        flowOut(std::move(au), sec);
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Creates ten records spread evenly over the access unit range, every second one on the reverse strand
+ */
+class TestDecoder : public genie::core::ReadDecoder {
+ public:
+    void flowIn(genie::core::AccessUnit&& t, const genie::util::Section& id) override {
+        genie::core::record::Chunk chunk;
+        for (uint64_t i = 0; i < t.getNumReads(); ++i) {
+            auto pos = t.getMinPos() + i * (t.getMaxPos() - t.getMinPos()) / t.getNumReads();
+            chunk.getData().push_back(makeRecord(t.getClassType(), pos, "10=", i % 2));
+        }
+        flowOut(std::move(chunk), id);
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ApiTest, recordMatches) {
+    using genie::core::record::ClassType;
+    auto filter = allRecords();
+    filter.startPos = 100;
+    filter.endPos = 199;
+    EXPECT_TRUE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_P, 95, "10=")));
+    EXPECT_FALSE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_P, 200, "10=")));
+    EXPECT_TRUE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_U, 0, "")));
+
+    filter.classID[uint8_t(ClassType::CLASS_U) - 1] = false;
+    EXPECT_FALSE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_U, 0, "")));
+
+    filter.singleEndsStrand[uint8_t(genie::core::api::Strand::REVERSE)] = false;
+    EXPECT_TRUE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_P, 150, "10=", 0)));
+    EXPECT_FALSE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_P, 150, "10=", 1)));
+
+    filter.includeClippedReads[uint8_t(genie::core::api::ClipType::SOFT)] = false;
+    EXPECT_FALSE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_I, 150, "(2)8=")));
+    EXPECT_TRUE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_I, 150, "8=[2]")));
+
+    filter.groupNames = {"a", "b"};
+    EXPECT_TRUE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_P, 150, "10=", 0, "b")));
+    EXPECT_FALSE(genie::core::api::recordMatches(filter, makeRecord(ClassType::CLASS_P, 150, "10=", 0, "c")));
+
+    // There is no filter entry for records without class
+    EXPECT_THROW(genie::core::api::auMatches(filter, ClassType::NONE, 0, 0, 0), genie::util::RuntimeException);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ApiTest, segmentsMatch) {
+    using genie::core::record::ClassType;
+    genie::core::api::SegmentFilter filter{};
+    filter.filterScope.fill(true);
+    for (auto* r : {&filter.mappedBasesRange, &filter.errorsRange, &filter.substitutionsRange, &filter.insertionsRange,
+                    &filter.insertionsLengthRange, &filter.deletionsRange, &filter.deletionsLengthRange,
+                    &filter.splicesRange, &filter.splicesLengthRange, &filter.qualityScoreRange}) {
+        *r = {0, 1000};
+    }
+    for (auto* r : {&filter.mappedFractionRange, &filter.errorsFractionRange, &filter.substitutionsFractionRange,
+                    &filter.insertionsFractionRange, &filter.insertionsLengthFractionRange,
+                    &filter.deletionsFractionRange, &filter.deletionsLengthFractionRange,
+                    &filter.splicesFractionRange}) {
+        *r = {0.0f, 10.0f};
+    }
+    filter.alignmentScoreRange = {-1000.0f, 1000.0f};
+
+    auto rec = makeRecord(ClassType::CLASS_I, 100, "4=C2+3-2=T");
+    EXPECT_TRUE(genie::core::api::segmentsMatch(filter, rec));
+
+    filter.substitutionsRange = {0, 1};
+    EXPECT_FALSE(genie::core::api::segmentsMatch(filter, rec));
+    filter.substitutionsRange = {2, 2};
+    filter.errorsRange = {7, 7};
+    filter.insertionsLengthRange = {2, 2};
+    filter.deletionsRange = {1, 1};
+    filter.mappedBasesRange = {8, 8};
+    EXPECT_TRUE(genie::core::api::segmentsMatch(filter, rec));
+
+    filter.filterScope[uint8_t(genie::core::api::SegmentType::SINGLE)] = false;
+    filter.mappedBasesRange = {0, 0};
+    EXPECT_TRUE(genie::core::api::segmentsMatch(filter, rec));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ApiTest, getDataBySimpleFilter) {
+    using genie::core::record::ClassType;
+    genie::core::api::GenieState state;
+    TestImporter::Log log;
+    state.addDataset(1, 2, [&log]() {
+        auto flow = genie::util::make_unique<genie::core::FlowGraphDecode>(1);
+        auto imp = genie::util::make_unique<TestImporter>();
+        imp->aus = {{ClassType::CLASS_P, 0, 1000},
+                    {ClassType::CLASS_P, 1000, 2000},
+                    {ClassType::CLASS_M, 1500, 2500},
+                    {ClassType::CLASS_P, 2000, 3000},
+                    {ClassType::CLASS_U, 0, 0}};
+        imp->log = &log;
+        flow->addImporter(std::move(imp));
+        flow->addReadCoder(genie::util::make_unique<TestDecoder>());
+        return flow;
+    });
+
+    auto filter = allRecords();
+    filter.classID[uint8_t(ClassType::CLASS_U) - 1] = false;
+    filter.classID[uint8_t(ClassType::CLASS_M) - 1] = false;
+    filter.startPos = 1200;
+    filter.endPos = 1999;
+    filter.singleEndsStrand[uint8_t(genie::core::api::Strand::REVERSE)] = false;
+
+    auto result = state.getDataBySimpleFilter(1, 2, filter);
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result.front().datasetGroupID, 1);
+    EXPECT_EQ(result.front().datasetID, 2);
+    EXPECT_EQ(log.read, 1);
+    EXPECT_EQ(log.skipped,
+              std::vector<genie::core::GenDesc>({genie::core::GenDesc::RNAME, genie::core::GenDesc::QV}));
+
+    std::vector<uint64_t> positions;
+    for (const auto& r : result.front().records) {
+        positions.push_back(r.getAlignments().front().getPosition());
+    }
+    EXPECT_EQ(positions, std::vector<uint64_t>({1200, 1400, 1600, 1800}));
+
+    EXPECT_EQ(state.getHierarchy().groups.size(), 1);
+    EXPECT_THROW(state.getDataBySimpleFilter(1, 3, filter), genie::core::api::ExceptionDatasetNotFound);
+    EXPECT_THROW(state.getDataBySimpleFilter(2, 2, filter), genie::core::api::ExceptionDatasetGroupNotFound);
+
+    filter.includeAuxRecords = true;
+    EXPECT_THROW(state.getDataBySimpleFilter(1, 2, filter), genie::core::api::ExceptionParameterInvalid);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/format/mgb/au-index.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(AUIndexTest, roundtrip) {
+    using genie::core::record::ClassType;
+    genie::format::mgb::AUIndex index;
+    index.addSetupUnit(0);
+    index.add({120, 0, ClassType::CLASS_P, 1000, 0, 5, 3000});
+    index.add({4000, 0, ClassType::CLASS_P, 1000, 0, 2900, 6000});
+    index.addSetupUnit(8000);
+    index.add({8200, 1, ClassType::CLASS_I, 500, 2, 100, 200});
+    index.add({9000, 1, ClassType::CLASS_U, 300, 0, 0, 0});
+    index.setStreamSize(10000);
+
+    std::stringstream stream;
+    {
+        genie::util::BitWriter writer(&stream);
+        index.write(writer);
+    }
+    genie::util::BitReader reader(stream);
+    genie::format::mgb::AUIndex loaded(reader);
+
+    EXPECT_EQ(loaded.getStreamSize(), 10000);
+    EXPECT_EQ(loaded.getSetupUnits(), std::vector<uint64_t>({0, 8000}));
+    ASSERT_EQ(loaded.getEntries().size(), 4);
+    for (size_t i = 0; i < loaded.getEntries().size(); ++i) {
+        const auto& a = index.getEntries()[i];
+        const auto& b = loaded.getEntries()[i];
+        EXPECT_EQ(a.offset, b.offset);
+        EXPECT_EQ(a.parameterID, b.parameterID);
+        EXPECT_EQ(a.auClass, b.auClass);
+        EXPECT_EQ(a.readCount, b.readCount);
+        EXPECT_EQ(a.seqID, b.seqID);
+        EXPECT_EQ(a.startPos, b.startPos);
+        EXPECT_EQ(a.endPos, b.endPos);
+    }
+
+    auto hits = loaded.query(genie::core::LocusFilter(0, genie::core::Locus::fromString("0:2950-2960")));
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_EQ(hits[0].offset, 120);
+    EXPECT_EQ(hits[1].offset, 4000);
+    EXPECT_TRUE(loaded.query(genie::core::LocusFilter(1, genie::core::Locus::fromString("1"))).empty());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(AUIndexTest, invalid) {
+    std::stringstream stream("not an index");
+    genie::util::BitReader reader(stream);
+    EXPECT_ANY_THROW(genie::format::mgb::AUIndex index(reader));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(AUIndexTest, detectsChangedParameterSets) {
+    using genie::core::record::ClassType;
+    const std::string ps1 = std::string(1, '\x01') + "first parameter set";
+    const std::string au = std::string(1, '\x02') + "access unit";
+    const std::string ps2 = std::string(1, '\x01') + "second parameter set";
+    genie::format::mgb::AUIndex index;
+    index.addParameterSet(0, ps1);
+    index.add({ps1.size(), 0, ClassType::CLASS_U, 10, 0, 0, 0});
+    index.addParameterSet(ps1.size() + au.size(), ps2);
+    index.setStreamSize(ps1.size() + au.size() + ps2.size());
+
+    std::stringstream serialized;
+    {
+        genie::util::BitWriter writer(&serialized);
+        index.write(writer);
+    }
+    genie::util::BitReader reader(serialized);
+    genie::format::mgb::AUIndex loaded(reader);
+
+    std::stringstream stream(ps1 + au + ps2);
+    EXPECT_TRUE(loaded.matches(stream, stream.str().size()));
+    EXPECT_FALSE(loaded.matches(stream, stream.str().size() + 1));
+
+    // Same size, but one parameter set differs
+    std::string changed = ps2;
+    changed.back() = 'X';
+    std::stringstream other(ps1 + au + changed);
+    EXPECT_FALSE(loaded.matches(other, other.str().size()));
+
+    // Access unit payload is not part of the checksum
+    std::string changedAU = au;
+    changedAU.back() = 'X';
+    std::stringstream payload(ps1 + changedAU + ps2);
+    EXPECT_TRUE(loaded.matches(payload, payload.str().size()));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -102,4 +102,32 @@ TEST(BitRoundtrip, stream) {
 
 }
 
-// ---------------------------------------------------------------------------------------------------------------------
\ No newline at end of file
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(BitRoundtrip, mixedAlignment) {
+    std::stringstream str;
+    genie::util::BitWriter writer(&str);
+    writer.write(0x5, 3);
+    writer.write("AB");
+    writer.write(0x1f, 5);
+    writer.write("CD");
+    writer.writeBypassBE<uint16_t>(0x1234);
+    EXPECT_EQ(writer.getBitsWritten(), 3 + 16 + 5 + 16);
+    writer.flush();
+
+    genie::util::BitReader reader(str);
+    EXPECT_EQ(reader.read<uint8_t>(3), 0x5);
+    EXPECT_EQ(reader.read<uint16_t>(16), 0x4142);
+    EXPECT_EQ(reader.read<uint8_t>(5), 0x1f);
+    std::string output(2, ' ');
+    reader.readBypass(output);
+    EXPECT_EQ(output, "CD");
+    EXPECT_EQ(reader.readBypassBE<uint16_t>(), 0x1234);
+    EXPECT_TRUE(reader.isGood());
+
+    // Reading past the end fails the stream and yields zeros
+    EXPECT_EQ(reader.read<uint32_t>(24), 0);
+    EXPECT_FALSE(reader.isGood());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/access-unit.h>
+#include <genie/util/data-block.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(DataBlockTest, bulkAppendAndExtract) {
+    const std::vector<uint64_t> values = {0, 1, 255, 256, 65535, 65536, 0xffffffffull, 0x100000000ull};
+    for (uint8_t wordSize : {1, 2, 4, 8}) {
+        genie::util::DataBlock block(0, wordSize);
+        block.push_back(7);
+        block.append(values.data(), values.data() + values.size());
+        block.appendTransformed(values.data(), values.data() + 2, [](uint64_t v) { return v + 10; });
+
+        ASSERT_EQ(block.size(), values.size() + 3);
+        const uint64_t mask = wordSize == 8 ? ~0ull : (1ull << (wordSize * 8)) - 1;
+        EXPECT_EQ(block.get(0), 7);
+        for (size_t i = 0; i < values.size(); ++i) {
+            EXPECT_EQ(block.get(i + 1), values[i] & mask) << int(wordSize) << " " << i;
+        }
+        EXPECT_EQ(block.get(values.size() + 1), 10);
+        EXPECT_EQ(block.get(values.size() + 2), 11);
+
+        std::vector<uint64_t> out(3);
+        block.extractTransformed(1, out.data(), out.data() + out.size(), [](uint64_t v) { return v * 2; });
+        EXPECT_EQ(out, std::vector<uint64_t>({0, 2, 510}));
+        EXPECT_ANY_THROW(block.extractTransformed(block.size() - 1, out.data(), out.data() + 2,
+                                                  [](uint64_t v) { return v; }));
+    }
+
+    genie::util::DataBlock block(4, 2);
+    EXPECT_NE(block.getTypedData<uint16_t>(), nullptr);
+    EXPECT_ANY_THROW(block.getTypedData<uint32_t>());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(DataBlockTest, subsequencePushPull) {
+    const std::string seq = "ACGTNNA";
+    genie::core::AccessUnit::Subsequence subseq(1, genie::core::GenSub::UREADS);
+    subseq.push(seq.data(), seq.data() + seq.size(), [](char c) { return c - 'A'; });
+    subseq.push(0);
+    ASSERT_EQ(subseq.getNumSymbols(), seq.size() + 1);
+
+    std::string decoded(4, '\0');
+    subseq.pull(&decoded[0], &decoded[0] + 4, [](uint64_t v) { return char(v + 'A'); });
+    EXPECT_EQ(decoded, "ACGT");
+    EXPECT_EQ(subseq.pull(), 'N' - 'A');
+    EXPECT_ANY_THROW(subseq.pull(&decoded[0], &decoded[0] + 4, [](uint64_t v) { return char(v); }));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
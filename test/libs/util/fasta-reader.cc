@@ -0,0 +1,228 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/format/fasta/reader.h>
+#include <genie/util/runtime-exception.h>
+#include <genie/util/task-scheduler.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(FastaReaderTest, mappedSections) {
+    const std::string path = "fasta-reader-test.fa";
+    const std::string seq1 = "ACGTACGTacgtNNNNACGTAC";
+    const std::string seq2 = "ttttGGGGccccAAAA";
+    {
+        std::ofstream out(path);
+        out << ">seq1 description\n";
+        for (size_t i = 0; i < seq1.size(); i += 7) {
+            out << seq1.substr(i, 7) << "\n";
+        }
+        out << ">seq2\n";
+        for (size_t i = 0; i < seq2.size(); i += 5) {
+            out << seq2.substr(i, 5) << "\n";
+        }
+    }
+
+    std::stringstream fai;
+    std::stringstream sha;
+    {
+        std::ifstream in(path);
+        genie::format::fasta::FastaReader::index(in, fai);
+    }
+    std::ifstream fasta(path);
+    genie::format::fasta::FastaReader reader(fasta, fai, sha, path);
+    ASSERT_TRUE(reader.isMapped());
+
+    auto upper = [](std::string s) {
+        for (auto& c : s) {
+            c = static_cast<char>(toupper(c));
+        }
+        return s;
+    };
+    for (size_t start = 0; start < seq1.size(); ++start) {
+        for (size_t end = start; end <= seq1.size(); ++end) {
+            EXPECT_EQ(reader.loadSection("seq1", start, end), upper(seq1.substr(start, end - start)));
+        }
+    }
+    EXPECT_EQ(reader.loadSection("seq2", 3, 1000), upper(seq2.substr(3)));
+    EXPECT_EQ(reader.loadSection("seq2", 0, seq2.size()), upper(seq2));
+
+    std::remove(path.c_str());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(FastaReaderTest, parallelIndexAndHash) {
+    const std::string path = "fasta-reader-index-test.fa";
+    {
+        std::ofstream out(path);
+        for (size_t s = 0; s < 5; ++s) {
+            out << ">chr" << s << " some description\n";
+            std::string seq;
+            for (size_t i = 0; i < 1000 + s * 77; ++i) {
+                seq.push_back("ACGTNacgt"[(i * 7 + s) % 9]);
+            }
+            for (size_t i = 0; i < seq.size(); i += 60) {
+                out << seq.substr(i, 60) << "\n";
+            }
+        }
+    }
+
+    std::stringstream faiStream;
+    std::stringstream shaStream;
+    {
+        std::ifstream in(path);
+        genie::format::fasta::FastaReader::index(in, faiStream);
+        genie::format::fasta::FaiFile fai(faiStream);
+        in.clear();
+        genie::format::fasta::FastaReader::hash(fai, in, shaStream);
+    }
+
+    genie::util::MappedFile map(path);
+    ASSERT_TRUE(map.isMapped());
+    genie::util::TaskScheduler scheduler(2);
+    uint64_t lastDone = 0;
+    uint64_t lastTotal = 0;
+    auto progress = [&](uint64_t done, uint64_t total) {
+        EXPECT_GE(done, lastDone);
+        lastDone = done;
+        lastTotal = total;
+    };
+    std::stringstream faiMapped;
+    std::stringstream shaMapped;
+    genie::format::fasta::FastaReader::index(map, faiMapped, &scheduler, progress);
+    EXPECT_EQ(lastDone, lastTotal);
+    EXPECT_EQ(faiMapped.str(), faiStream.str());
+
+    genie::format::fasta::FaiFile fai(faiMapped);
+    lastDone = 0;
+    genie::format::fasta::FastaReader::hash(fai, map, shaMapped, &scheduler, progress);
+    EXPECT_EQ(lastDone, lastTotal);
+    EXPECT_EQ(shaMapped.str(), shaStream.str());
+    scheduler.shutdown();
+
+    std::remove(path.c_str());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Index and hash a fasta file with the stream and the mapped implementation
+ * @param path Fasta file
+ * @param fai Output index, must be the same for both implementations
+ * @param sha Output hashes, must be the same for both implementations
+ */
+static void indexBoth(const std::string& path, std::string* fai, std::string* sha) {
+    std::stringstream faiStream;
+    std::stringstream shaStream;
+    {
+        std::ifstream in(path, std::ios::binary);
+        genie::format::fasta::FastaReader::index(in, faiStream);
+        genie::format::fasta::FaiFile index(faiStream);
+        in.clear();
+        genie::format::fasta::FastaReader::hash(index, in, shaStream);
+    }
+
+    genie::util::MappedFile map(path);
+    ASSERT_TRUE(map.isMapped());
+    std::stringstream faiMapped;
+    std::stringstream shaMapped;
+    genie::format::fasta::FastaReader::index(map, faiMapped, nullptr);
+    genie::format::fasta::FaiFile index(faiMapped);
+    genie::format::fasta::FastaReader::hash(index, map, shaMapped, nullptr);
+    EXPECT_EQ(faiMapped.str(), faiStream.str());
+    EXPECT_EQ(shaMapped.str(), shaStream.str());
+    *fai = faiMapped.str();
+    *sha = shaMapped.str();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(FastaReaderTest, crlfLineEndings) {
+    const std::string pathLF = "fasta-reader-lf-test.fa";
+    const std::string pathCRLF = "fasta-reader-crlf-test.fa";
+    const std::string seq1 = "ACGTACGTacgtNNNNACGTAC";
+    for (const auto& path : {pathLF, pathCRLF}) {
+        const std::string eol = path == pathCRLF ? "\r\n" : "\n";
+        std::ofstream out(path, std::ios::binary);
+        out << ">seq1 description" << eol;
+        for (size_t i = 0; i < seq1.size(); i += 7) {
+            out << seq1.substr(i, 7) << eol;
+        }
+        out << ">seq2" << eol << "GGGG" << eol;
+    }
+
+    std::string faiLF, shaLF, faiCRLF, shaCRLF;
+    indexBoth(pathLF, &faiLF, &shaLF);
+    indexBoth(pathCRLF, &faiCRLF, &shaCRLF);
+    EXPECT_EQ(shaCRLF, shaLF);
+
+    // Like samtools, the line width includes the carriage return
+    std::stringstream faiStream(faiCRLF);
+    genie::format::fasta::FaiFile fai(faiStream);
+    EXPECT_EQ(fai.getLength("seq1"), seq1.size());
+    EXPECT_EQ(fai.getLength("seq2"), 4);
+    EXPECT_EQ(fai.getFilePosition("seq1", 8), 19 + 9 + 1);
+
+    std::stringstream faiCopy(faiCRLF);
+    std::stringstream sha(shaCRLF);
+    std::ifstream fasta(pathCRLF, std::ios::binary);
+    genie::format::fasta::FastaReader reader(fasta, faiCopy, sha, pathCRLF);
+    EXPECT_EQ(reader.loadSection("seq1", 0, seq1.size()), "ACGTACGTACGTNNNNACGTAC");
+    EXPECT_EQ(reader.loadSection("seq1", 5, 16), "CGTACGTNNNN");
+    EXPECT_EQ(reader.loadSection("seq2", 0, 4), "GGGG");
+
+    std::remove(pathLF.c_str());
+    std::remove(pathCRLF.c_str());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(FastaReaderTest, blankLinesAndEmptyRecords) {
+    const std::string path = "fasta-reader-blank-test.fa";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "\n>empty1\n\n>seq1\n\nACGTA\nCG\n\n\n>empty2\n>seq2\nTTT\n\n";
+    }
+    std::string faiStr, shaStr;
+    indexBoth(path, &faiStr, &shaStr);
+
+    std::stringstream faiStream(faiStr);
+    genie::format::fasta::FaiFile fai(faiStream);
+    ASSERT_EQ(fai.getSequences().size(), 2);
+    EXPECT_EQ(fai.getSequences().at(0), "seq1");
+    EXPECT_EQ(fai.getSequences().at(1), "seq2");
+    EXPECT_EQ(fai.getLength("seq1"), 7);
+    EXPECT_EQ(fai.getLength("seq2"), 3);
+
+    std::stringstream sha(shaStr);
+    std::stringstream faiCopy(faiStr);
+    std::ifstream fasta(path, std::ios::binary);
+    genie::format::fasta::FastaReader reader(fasta, faiCopy, sha, path);
+    EXPECT_EQ(reader.loadSection("seq1", 0, 7), "ACGTACG");
+    EXPECT_EQ(reader.loadSection("seq2", 0, 3), "TTT");
+    std::remove(path.c_str());
+
+    // The index cannot describe a blank line inside a sequence
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << ">seq1\nACGTA\n\nACGTA\nCG\n";
+    }
+    std::stringstream out;
+    std::ifstream in(path, std::ios::binary);
+    EXPECT_THROW(genie::format::fasta::FastaReader::index(in, out), genie::util::RuntimeException);
+    genie::util::MappedFile map(path);
+    EXPECT_THROW(genie::format::fasta::FastaReader::index(map, out, nullptr), genie::util::RuntimeException);
+    std::remove(path.c_str());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/util/gzip-stream.h>
+#include <genie/util/runtime-exception.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Compress data
+ * @param data Input
+ * @param windowBits MAX_WBITS + 16 for a gzip member, -MAX_WBITS for raw deflate data
+ * @return Compressed data
+ */
+static std::string deflateString(const std::string& data, int windowBits) {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+    std::string ret(deflateBound(&stream, static_cast<uLong>(data.size())) + 32, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&ret[0]);
+    stream.avail_out = static_cast<uInt>(ret.size());
+    deflate(&stream, Z_FINISH);
+    ret.resize(stream.total_out);
+    deflateEnd(&stream);
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param value Value
+ * @param size Bytes
+ * @return Little endian representation
+ */
+static std::string le(uint32_t value, size_t size) {
+    std::string ret;
+    for (size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>((value >> (8 * i)) & 0xffu));
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param data Block content
+ * @return BGZF block
+ */
+static std::string bgzfBlock(const std::string& data) {
+    auto payload = deflateString(data, -MAX_WBITS);
+    std::string ret("\x1f\x8b\x08\x04\0\0\0\0\0\xff", 10);
+    ret += le(6, 2) + "BC" + le(2, 2) + le(static_cast<uint32_t>(payload.size() + 25), 2);
+    auto crc = crc32(0, reinterpret_cast<const Bytef*>(data.data()), static_cast<uInt>(data.size()));
+    return ret + payload + le(static_cast<uint32_t>(crc), 4) + le(static_cast<uint32_t>(data.size()), 4);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static std::string readAll(std::istream& stream) {
+    std::stringstream ret;
+    ret << stream.rdbuf();
+    return ret.str();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(GzipStreamTest, members) {
+    std::string first = "@r1\nACGT\n+\nIIII\n";
+    std::string second(3000000, 'A');
+    std::stringstream compressed(deflateString(first, MAX_WBITS + 16) + deflateString("", MAX_WBITS + 16) +
+                                 deflateString(second, MAX_WBITS + 16));
+    genie::util::GzipStream stream(compressed);
+    EXPECT_EQ(readAll(stream), first + second);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(GzipStreamTest, bgzf) {
+    std::string content;
+    std::string blocks;
+    for (int i = 0; i < 100; ++i) {
+        auto data = "block " + std::to_string(i) + "\n" + std::string(size_t(i) * 100, char('a' + i % 26));
+        content += data;
+        blocks += bgzfBlock(data);
+    }
+    blocks += bgzfBlock("");
+
+    // Plain gzip members may follow
+    std::stringstream compressed(blocks + deflateString("tail\n", MAX_WBITS + 16));
+    genie::util::GzipStream stream(compressed, 4);
+    EXPECT_EQ(readAll(stream), content + "tail\n");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(GzipStreamTest, corrupt) {
+    auto data = deflateString(std::string(10000, 'C'), MAX_WBITS + 16);
+    std::stringstream truncated(data.substr(0, data.size() / 2));
+    genie::util::GzipStream stream(truncated);
+    std::string line;
+    EXPECT_THROW(std::getline(stream, line), genie::util::RuntimeException);
+
+    std::stringstream plain("@r1\nACGT\n");
+    genie::util::GzipStream stream2(plain);
+    EXPECT_THROW(std::getline(stream2, line), genie::util::RuntimeException);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -26,5 +26,16 @@ namespace util_tests {
     return result;
 }*/
 
+genie::core::record::Record makeRecord(genie::core::record::ClassType type, uint64_t pos, const std::string& ecigar,
+                                       uint8_t rcomp, const std::string& group, uint16_t seq) {
+    genie::core::record::Record rec(1, type, "", std::string(group), 0);
+    rec.addSegment(genie::core::record::Segment(std::string(10, 'A')));
+    if (type != genie::core::record::ClassType::CLASS_U) {
+        rec.addAlignment(seq, genie::core::record::AlignmentBox(
+                                  pos, genie::core::record::Alignment(std::string(ecigar), rcomp)));
+    }
+    return rec;
+}
+
 }  // namespace util_tests
 
@@ -1,13 +1,26 @@
 #ifndef UTIL_TESTS_HELPERS_H_
 #define UTIL_TESTS_HELPERS_H_
 
+#include <genie/core/record/record.h>
 #include <string>
 
 namespace util_tests {
 
 //std::string exec(const std::string &cmd);
 
+/**
+ * @brief Single segment record of 10 bases
+ * @param type Record class, unaligned for CLASS_U
+ * @param pos Mapping position
+ * @param ecigar Extended cigar of the alignment
+ * @param rcomp Reverse complement flag of the alignment
+ * @param group Read group
+ * @param seq Reference sequence
+ * @return Record
+ */
+genie::core::record::Record makeRecord(genie::core::record::ClassType type, uint64_t pos, const std::string& ecigar,
+                                       uint8_t rcomp = 0, const std::string& group = "", uint16_t seq = 0);
+
 }  // namespace util_tests
 
 #endif  // UTIL_TESTS_HELPERS_H_
-
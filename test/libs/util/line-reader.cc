@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/util/line-reader.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static std::string str(const genie::util::StringView& view, const genie::util::LineReader& reader) {
+    auto deployed = view.deploy(reader.data());
+    return std::string(deployed.begin(), deployed.end());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(LineReaderTest, lines) {
+    std::stringstream stream("first\n\nthird line\nlast");
+    genie::util::LineReader reader(stream);
+    genie::util::StringView line;
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(str(line, reader), "first");
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(str(line, reader), "");
+    reader.discard();
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(str(line, reader), "third line");
+    ASSERT_TRUE(reader.readLine(line));
+    EXPECT_EQ(str(line, reader), "last");
+    EXPECT_FALSE(reader.readLine(line));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(LineReaderTest, smallBlocks) {
+    // Lines longer than a block, kept lines have to survive refills and growing
+    std::stringstream stream("@name\nACGTACGTACGT\n+\nIIIIIIIIIIII\n@x\nA\n");
+    genie::util::LineReader reader(stream, 3);
+    genie::util::StringView lines[4];
+    for (auto& line : lines) {
+        ASSERT_TRUE(reader.readLine(line));
+    }
+    EXPECT_EQ(str(lines[0], reader), "@name");
+    EXPECT_EQ(str(lines[1], reader), "ACGTACGTACGT");
+    EXPECT_EQ(str(lines[2], reader), "+");
+    EXPECT_EQ(str(lines[3], reader), "IIIIIIIIIIII");
+    reader.discard();
+    ASSERT_TRUE(reader.readLine(lines[0]));
+    ASSERT_TRUE(reader.readLine(lines[1]));
+    EXPECT_EQ(str(lines[0], reader), "@x");
+    EXPECT_EQ(str(lines[1], reader), "A");
+    EXPECT_FALSE(reader.readLine(lines[2]));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
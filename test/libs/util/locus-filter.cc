@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/locus-filter.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "helpers.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+using util_tests::makeRecord;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(LocusFilterTest, rangeOverlap) {
+    genie::core::LocusFilter filter(1, genie::core::Locus::fromString("chr2:100-200"));
+    EXPECT_TRUE(filter.overlaps(1, 50, 100));
+    EXPECT_TRUE(filter.overlaps(1, 199, 300));
+    EXPECT_TRUE(filter.overlaps(1, 0, 1000));
+    EXPECT_FALSE(filter.overlaps(1, 50, 99));
+    EXPECT_FALSE(filter.overlaps(1, 200, 300));
+    EXPECT_FALSE(filter.overlaps(0, 150, 160));
+
+    genie::core::LocusFilter whole(1, genie::core::Locus::fromString("chr2"));
+    EXPECT_TRUE(whole.overlaps(1, 5000000, 5000001));
+    EXPECT_FALSE(whole.overlaps(2, 0, 10));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(LocusFilterTest, records) {
+    using genie::core::record::ClassType;
+    genie::core::LocusFilter filter(0, genie::core::Locus::fromString("0:100-200"));
+    EXPECT_TRUE(filter.overlaps(makeRecord(ClassType::CLASS_P, 95, "10=")));
+    EXPECT_FALSE(filter.overlaps(makeRecord(ClassType::CLASS_P, 90, "10=")));
+    EXPECT_TRUE(filter.overlaps(makeRecord(ClassType::CLASS_I, 90, "5=3-5=")));
+    EXPECT_FALSE(filter.overlaps(makeRecord(ClassType::CLASS_P, 200, "10=")));
+    EXPECT_FALSE(filter.overlaps(makeRecord(ClassType::CLASS_P, 150, "10=", 0, "", 1)));
+    EXPECT_FALSE(filter.overlaps(makeRecord(ClassType::CLASS_U, 0, "")));
+
+    struct Sink : public genie::util::Drain<genie::core::record::Chunk> {
+        std::vector<uint64_t> positions;
+        void flowIn(genie::core::record::Chunk&& t, const genie::util::Section&) override {
+            for (const auto& r : t.getData()) {
+                positions.push_back(r.getAlignments().front().getPosition());
+            }
+        }
+        void flushIn(uint64_t&) override {}
+        void skipIn(const genie::util::Section&) override {}
+    } sink;
+    filter.setDrain(&sink);
+
+    genie::core::record::Chunk chunk;
+    for (uint64_t p = 50; p < 250; p += 20) {
+        chunk.getData().push_back(makeRecord(ClassType::CLASS_P, p, "30="));
+    }
+    filter.flowIn(std::move(chunk), {0, 10, false});
+    EXPECT_EQ(sink.positions, std::vector<uint64_t>({90, 110, 130, 150, 170, 190}));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,68 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/stats/perf-stats.h>
+#include <genie/util/runtime-exception.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(PerfStatsTest, intern) {
+    using genie::core::stats::PerfStats;
+    auto a = PerfStats::intern("test-intern-a");
+    auto b = PerfStats::intern("test-intern-b");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, PerfStats::intern("test-intern-a"));
+    EXPECT_EQ(PerfStats::getName(b), "test-intern-b");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(PerfStatsTest, merge) {
+    using genie::core::stats::PerfStats;
+    auto id = PerfStats::intern("test-merge-int");
+    PerfStats chunk1;
+    chunk1.addInteger(id, 5);
+    chunk1.addInteger("test-merge-int", 7);
+    chunk1.addDouble("test-merge-double", 1.5);
+    PerfStats chunk2;
+    chunk2.addInteger(id, -2);
+
+    PerfStats total;
+    total.add(chunk1);
+    total.add(chunk2);
+    auto all = total.getAll();
+    ASSERT_EQ(all.size(), 2);
+    const auto& s = all.at("test-merge-int");
+    EXPECT_TRUE(s.isInteger);
+    EXPECT_EQ(s.ctr, 3);
+    EXPECT_EQ(s.sum.iData, 10);
+    EXPECT_EQ(s.min.iData, -2);
+    EXPECT_EQ(s.max.iData, 7);
+    EXPECT_DOUBLE_EQ(all.at("test-merge-double").sum.fData, 1.5);
+    EXPECT_THROW(total.addDouble(id, 1.0), genie::util::RuntimeException);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(PerfStatsTest, disabled) {
+    using genie::core::stats::PerfStats;
+    PerfStats::setDefaultActive(false);
+    PerfStats stats;
+    PerfStats::setDefaultActive(true);
+    EXPECT_FALSE(stats.isActive());
+    stats.addInteger("test-disabled", 1);
+    PerfStats other;
+    other.addInteger("test-disabled", 1);
+    stats.add(other);
+    EXPECT_TRUE(stats.getAll().empty());
+    std::stringstream out;
+    out << stats;
+    EXPECT_TRUE(out.str().empty());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/record/chunk.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static std::string str(const genie::util::StringView& view) { return std::string(view.begin(), view.end()); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void add(genie::core::record::ReadColumns& columns, const std::string& name, const std::string& seq1,
+                const std::string& qual1, const std::string& seq2, const std::string& qual2) {
+    std::memcpy(columns.addRecord(name.length()), name.data(), name.length());
+    std::memcpy(columns.addSequence(seq1.length()), seq1.data(), seq1.length());
+    std::memcpy(columns.addQualities(qual1.length()), qual1.data(), qual1.length());
+    std::memcpy(columns.addSequence(seq2.length()), seq2.data(), seq2.length());
+    if (!qual2.empty()) {
+        std::memcpy(columns.addQualities(qual2.length()), qual2.data(), qual2.length());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReadColumnsTest, addAndGet) {
+    genie::core::record::ReadColumns columns;
+    columns.setNumberOfTemplateSegments(2);
+    columns.reserve(2, 16, 8);
+    add(columns, "r0", "ACGT", "IIII", "GG", "");
+    add(columns, "read1", "T", "#", "", "");
+    columns.setFlags(4);
+
+    ASSERT_EQ(columns.size(), 2);
+    ASSERT_EQ(columns.getNumberOfSegments(), 4);
+    EXPECT_EQ(str(columns.getName(0)), "r0");
+    EXPECT_EQ(str(columns.getName(1)), "read1");
+    EXPECT_EQ(columns.getFlags(0), 0);
+    EXPECT_EQ(columns.getFlags(1), 4);
+    EXPECT_EQ(str(columns.getSequence(0)), "ACGT");
+    EXPECT_EQ(str(columns.getQualities(0)), "IIII");
+    EXPECT_EQ(str(columns.getSequence(1)), "GG");
+    EXPECT_EQ(str(columns.getQualities(1)), "");
+    EXPECT_EQ(str(columns.getSequence(2)), "T");
+    EXPECT_EQ(str(columns.getQualities(2)), "#");
+    EXPECT_EQ(str(columns.getSequence(3)), "");
+
+    auto rec = columns.getRecord(1);
+    EXPECT_EQ(rec.getClassID(), genie::core::record::ClassType::CLASS_U);
+    EXPECT_EQ(rec.getName(), "read1");
+    EXPECT_EQ(rec.getFlags(), 4);
+    ASSERT_EQ(rec.getSegments().size(), 2);
+    EXPECT_EQ(rec.getSegments()[0].getQualities(), std::vector<std::string>({"#"}));
+    EXPECT_EQ(rec.getSegments()[1].getQualities(), std::vector<std::string>({""}));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReadColumnsTest, appendAndExpand) {
+    genie::core::record::ReadColumns source;
+    source.setNumberOfTemplateSegments(2);
+    add(source, "a", "AA", "AA", "C", "D");
+    add(source, "b", "GGG", "BBB", "TT", "EE");
+    add(source, "c", "N", "C", "A", "F");
+
+    genie::core::record::Chunk chunk;
+    chunk.getColumns().append(source, 1, 2);
+    chunk.getColumns().append(source, 0, 1);
+    ASSERT_EQ(chunk.getNumRecords(), 3);
+    EXPECT_EQ(str(chunk.getColumns().getName(0)), "b");
+    EXPECT_EQ(str(chunk.getColumns().getSequence(1)), "TT");
+    EXPECT_EQ(str(chunk.getColumns().getQualities(3)), "F");
+    EXPECT_EQ(str(chunk.getColumns().getSequence(4)), "AA");
+    EXPECT_EQ(str(chunk.getColumns().getQualities(4)), "AA");
+
+    chunk.expandColumns();
+    EXPECT_TRUE(chunk.getColumns().empty());
+    ASSERT_EQ(chunk.getData().size(), 3);
+    EXPECT_EQ(chunk.getData()[2].getName(), "a");
+    EXPECT_EQ(chunk.getData()[2].getSegments()[1].getSequence(), "C");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/reference-manager.h>
+#include <genie/util/make-unique.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+class CountingReference : public genie::core::Reference {
+ public:
+    std::atomic<size_t>* loads;
+
+    CountingReference(const std::string& _name, uint64_t length, std::atomic<size_t>* _loads)
+        : Reference(_name, 0, length), loads(_loads) {}
+
+    std::string getSequence(uint64_t _start, uint64_t _end) override {
+        (*loads)++;
+        std::string ret;
+        for (uint64_t i = _start; i < std::min(_end, getEnd()); ++i) {
+            ret.push_back("ACGT"[(i / genie::core::ReferenceManager::getChunkSize()) % 4]);
+        }
+        return ret;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReferenceManagerTest, lruEviction) {
+    const auto chunk = genie::core::ReferenceManager::getChunkSize();
+    std::atomic<size_t> loads(0);
+    genie::core::ReferenceManager mgr(2 * chunk);
+    mgr.addRef(0, genie::util::make_unique<CountingReference>("chr1", 4 * chunk, &loads));
+
+    EXPECT_EQ(mgr.loadAt("chr1", 0)->front(), 'A');
+    EXPECT_EQ(mgr.loadAt("chr1", chunk)->front(), 'C');
+    EXPECT_EQ(mgr.loadAt("chr1", 10)->front(), 'A');  // Hit, chunk 0 is most recent now
+    EXPECT_EQ(mgr.loadAt("chr1", 2 * chunk)->front(), 'G');  // Evicts chunk 1
+    EXPECT_EQ(loads, 3);
+
+    auto stats = mgr.getCacheStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 3);
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(stats.bytes, 2 * chunk);
+
+    mgr.loadAt("chr1", 0);
+    EXPECT_EQ(loads, 3);
+    mgr.loadAt("chr1", chunk);
+    EXPECT_EQ(loads, 4);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReferenceManagerTest, evictedChunkStillReferenced) {
+    const auto chunk = genie::core::ReferenceManager::getChunkSize();
+    std::atomic<size_t> loads(0);
+    genie::core::ReferenceManager mgr(chunk);
+    mgr.addRef(0, genie::util::make_unique<CountingReference>("chr1", 2 * chunk, &loads));
+
+    auto first = mgr.loadAt("chr1", 0);
+    mgr.loadAt("chr1", chunk);
+    EXPECT_EQ(mgr.getCacheStats().evictions, 1);
+
+    // Chunk 0 was evicted from the cache, but is still alive and must not be read again
+    EXPECT_EQ(mgr.loadAt("chr1", 0), first);
+    EXPECT_EQ(loads, 2);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReferenceManagerTest, unknownChunk) {
+    const auto chunk = genie::core::ReferenceManager::getChunkSize();
+    std::atomic<size_t> loads(0);
+    genie::core::ReferenceManager mgr;
+    mgr.addRef(0, genie::util::make_unique<CountingReference>("chr1", chunk, &loads));
+
+    EXPECT_EQ(mgr.loadAt("chr2", 0), genie::core::ReferenceManager::ReferenceExcerpt::undef_page());
+    EXPECT_EQ(mgr.loadAt("chr1", chunk), genie::core::ReferenceManager::ReferenceExcerpt::undef_page());
+    EXPECT_EQ(loads, 0);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReferenceManagerTest, loadByID) {
+    const auto chunk = genie::core::ReferenceManager::getChunkSize();
+    std::atomic<size_t> loads(0);
+    genie::core::ReferenceManager mgr;
+    mgr.addRef(0, genie::util::make_unique<CountingReference>("chr1", 2 * chunk, &loads));
+    const auto seq = mgr.resolve("chr1");
+    EXPECT_EQ(mgr.resolve("chr2"), genie::core::ReferenceManager::UNKNOWN_SEQ);
+
+    EXPECT_EQ(mgr.loadAt(seq, chunk)->front(), 'C');
+    EXPECT_EQ(mgr.loadAt(seq, chunk), mgr.loadAt("chr1", chunk));
+    EXPECT_EQ(mgr.loadAt(genie::core::ReferenceManager::UNKNOWN_SEQ, 0),
+              genie::core::ReferenceManager::ReferenceExcerpt::undef_page());
+
+    // Adding references later keeps resolved IDs and loaded chunks valid
+    auto first = mgr.loadAt(seq, 0);
+    mgr.addRef(1, genie::util::make_unique<CountingReference>("chr2", chunk, &loads));
+    EXPECT_EQ(mgr.loadAt(seq, 0), first);
+    EXPECT_EQ(mgr.loadAt(mgr.resolve("chr2"), 0)->front(), 'A');
+    EXPECT_EQ(loads, 3);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReferenceManagerTest, manySequences) {
+    const auto chunk = genie::core::ReferenceManager::getChunkSize();
+    std::atomic<size_t> loads(0);
+    genie::core::ReferenceManager mgr;
+    mgr.addRef(0, genie::util::make_unique<CountingReference>("chr0", chunk, &loads));
+    auto first = mgr.loadAt("chr0", 0);
+
+    // Enough sequences to outgrow the directory several times
+    for (size_t i = 1; i < 100; ++i) {
+        mgr.addRef(i, genie::util::make_unique<CountingReference>("chr" + std::to_string(i), 2 * chunk, &loads));
+    }
+    EXPECT_EQ(mgr.loadAt("chr0", 0), first);
+    EXPECT_EQ(mgr.loadAt("chr99", chunk)->front(), 'C');
+    EXPECT_EQ(mgr.resolve("chr99"), 99);
+
+    mgr.validateRefID(120);
+    mgr.validateRefID(110);
+    EXPECT_EQ(mgr.resolve("120"), 220);
+    EXPECT_EQ(mgr.loadAt("120", 0), genie::core::ReferenceManager::ReferenceExcerpt::undef_page());
+    EXPECT_EQ(loads, 2);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,132 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/util/reorder-buffer.h>
+#include <genie/util/runtime-exception.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReorderBufferTest, outOfOrder) {
+    std::vector<size_t> out;
+    genie::util::ReorderBuffer<size_t> buffer([&out](size_t&& v) { out.push_back(v); });
+    buffer.deposit(2, {20, 5, true});
+    buffer.deposit(1, {10, 10, true});
+    EXPECT_TRUE(out.empty());
+    buffer.skip({25, 3, true});
+    buffer.deposit(0, {0, 10, true});
+    buffer.deposit(3, {28, 1, true});
+    EXPECT_EQ(out, std::vector<size_t>({0, 1, 2, 3}));
+    EXPECT_EQ(buffer.getCounter(), 29);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReorderBufferTest, concurrent) {
+    const size_t NUM_BLOCKS = 2000;
+    std::vector<size_t> out;
+    genie::util::ReorderBuffer<size_t> buffer([&out](size_t&& v) { out.push_back(v); }, 4);
+
+    // Sections are handed out in order like in the pipeline, but finish in random order
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&buffer, &next, t]() {
+            std::mt19937 rng(static_cast<uint32_t>(t));
+            size_t i = 0;
+            while ((i = next++) < NUM_BLOCKS) {
+                std::this_thread::sleep_for(std::chrono::microseconds(rng() % 50));
+                if (i % 7 == 3) {
+                    buffer.skip({i * 2, 2, true});
+                } else {
+                    buffer.deposit(size_t(i), {i * 2, 2, true});
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    ASSERT_EQ(buffer.getCounter(), NUM_BLOCKS * 2);
+    size_t expected = 0;
+    for (auto v : out) {
+        while (expected % 7 == 3) {
+            expected++;
+        }
+        EXPECT_EQ(v, expected);
+        expected++;
+    }
+    EXPECT_EQ(expected, NUM_BLOCKS);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReorderBufferTest, lastDepositorStress) {
+    // In every round, the block next in line is deposited last, racing with a drainer that is just giving up
+    const size_t NUM_THREADS = 8;
+    const size_t NUM_ROUNDS = 2000;
+    std::vector<size_t> out;
+    genie::util::ReorderBuffer<size_t> buffer([&out](size_t&& v) { out.push_back(v); }, NUM_THREADS);
+
+    std::atomic<size_t> arrived(0);
+    std::atomic<size_t> deposited(0);
+    std::atomic<size_t> stranded(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+                const size_t base = round * NUM_THREADS;
+                const size_t offset = (t + round) % NUM_THREADS;
+                arrived++;
+                while (arrived < base + NUM_THREADS) {
+                    std::this_thread::yield();
+                }
+                if (offset == 0) {
+                    while (deposited < base + NUM_THREADS - 1) {
+                        std::this_thread::yield();
+                    }
+                }
+                buffer.deposit(base + offset, {base + offset, 1, true});
+                if (++deposited == base + NUM_THREADS && buffer.getCounter() != base + NUM_THREADS) {
+                    // All deposits of this round returned, so nobody may be holding back a block in line
+                    stranded++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(stranded, 0);
+    ASSERT_EQ(buffer.getCounter(), NUM_ROUNDS * NUM_THREADS);
+    ASSERT_EQ(out.size(), NUM_ROUNDS * NUM_THREADS);
+    for (size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], i);
+    }
+    EXPECT_NO_THROW(buffer.flush());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ReorderBufferTest, flushDiesOnMissingSection) {
+    std::vector<size_t> out;
+    genie::util::ReorderBuffer<size_t> buffer([&out](size_t&& v) { out.push_back(v); });
+    buffer.deposit(0, {0, 1, true});
+    buffer.deposit(2, {2, 1, true});
+    EXPECT_THROW(buffer.flush(), genie::util::RuntimeException);
+    buffer.deposit(1, {1, 1, true});
+    EXPECT_NO_THROW(buffer.flush());
+    EXPECT_EQ(out, std::vector<size_t>({0, 1, 2}));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,235 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/format/sam/importer.h>
+#include <genie/util/make-unique.h>
+#include <genie/util/runtime-exception.h>
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Scripted alignments. A read is converted into one record of one segment per kept alignment, aligned at the
+ * first mapped alignment. Reference IDs are shifted by 10 when finishing, names starting with "bad" are unsupported.
+ */
+class ScriptedSource : public genie::format::sam::AlignmentSource {
+ private:
+    std::vector<genie::format::sam::Alignment> script;
+    std::map<std::string, std::vector<genie::format::sam::Alignment>> kept;
+
+ public:
+    size_t numRead{0};
+
+    explicit ScriptedSource(std::vector<genie::format::sam::Alignment> _script) : script(std::move(_script)) {}
+
+    bool read(genie::format::sam::Alignment* alignment) override {
+        if (numRead == script.size()) {
+            return false;
+        }
+        *alignment = script[numRead++];
+        return true;
+    }
+
+    void keep() override { kept[script[numRead - 1].qname].push_back(script[numRead - 1]); }
+
+    void convert(const std::string& qname, std::vector<genie::core::record::Record>* records) override {
+        auto alignments = std::move(kept.at(qname));
+        kept.erase(qname);
+        const genie::format::sam::Alignment* mapped = nullptr;
+        for (const auto& a : alignments) {
+            if (a.rid >= 0 && !mapped) {
+                mapped = &a;
+            }
+        }
+        genie::core::record::Record rec(static_cast<uint8_t>(alignments.size()),
+                                        mapped ? genie::core::record::ClassType::CLASS_M
+                                               : genie::core::record::ClassType::CLASS_U,
+                                        std::string(qname), "", 0);
+        for (size_t i = 0; i < alignments.size(); ++i) {
+            rec.addSegment(genie::core::record::Segment(std::string(10, 'A')));
+        }
+        if (mapped) {
+            rec.addAlignment(static_cast<uint16_t>(mapped->rid),
+                             genie::core::record::AlignmentBox(
+                                 mapped->pos, genie::core::record::Alignment(std::string("10"), 0)));
+        }
+        records->push_back(std::move(rec));
+    }
+
+    bool finish(genie::core::record::Record* record) override {
+        if (!record->getAlignments().empty()) {
+            record->patchRefID(record->getAlignmentSharedData().getSeqID() + 10);
+        }
+        return record->getName().substr(0, 3) != "bad";
+    }
+
+    void printStats() const override {}
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param qname Read name
+ * @param rid Reference ID, negative if unmapped
+ * @param pos Position
+ * @param mrid Reference ID of the mate, negative if unpaired
+ * @param mpos Position of the mate
+ * @param additional Secondary or supplementary alignment
+ * @return Alignment
+ */
+static genie::format::sam::Alignment aln(const std::string& qname, int64_t rid, uint64_t pos, int64_t mrid = -1,
+                                         uint64_t mpos = 0, bool additional = false) {
+    genie::format::sam::Alignment a;
+    a.qname = qname;
+    a.rid = rid;
+    a.pos = pos;
+    a.mrid = mrid;
+    a.mpos = mpos;
+    a.paired = mrid >= 0;
+    a.additional = additional;
+    return a;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Import all records
+ * @param importer Importer
+ * @param chunks Output, records of each chunk
+ */
+static void importAll(genie::format::sam::Importer& importer,
+                      std::vector<std::vector<genie::core::record::Record>>* chunks) {
+    bool more = true;
+    while (more) {
+        genie::core::record::Chunk chunk;
+        more = importer.pumpRetrieve(&chunk);
+        if (!chunk.getData().empty()) {
+            chunks->push_back(std::move(chunk.getData()));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ * @param chunks Imported chunks
+ * @return Name, reference and position of every record in output order, position -1 if unaligned
+ */
+static std::vector<std::string> summary(const std::vector<std::vector<genie::core::record::Record>>& chunks) {
+    std::vector<std::string> ret;
+    for (const auto& c : chunks) {
+        for (const auto& r : c) {
+            std::string s = r.getName() + ":" + std::to_string(r.getSegments().size());
+            if (!r.getAlignments().empty()) {
+                s += "@" + std::to_string(r.getAlignmentSharedData().getSeqID()) + ":" +
+                     std::to_string(r.getAlignments().front().getPosition());
+            }
+            ret.push_back(s);
+        }
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SamImporter, pairedReads) {  // NOLINT(cert-err58-cpp)
+    // Interleaved pairs on one reference and an unpaired read in between
+    std::vector<genie::format::sam::Alignment> script = {
+        aln("a", 0, 100, 0, 300), aln("b", 0, 150, 0, 200), aln("c", 0, 180),
+        aln("b", 0, 200, 0, 150), aln("a", 0, 300, 0, 100)};
+    genie::format::sam::Importer importer(100, genie::util::make_unique<ScriptedSource>(script));
+    std::vector<std::vector<genie::core::record::Record>> chunks;
+    importAll(importer, &chunks);
+
+    const std::vector<std::string> expected = {"a:2@10:100", "b:2@10:150", "c:1@10:180"};
+    EXPECT_EQ(summary(chunks), expected);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SamImporter, matesBeyondWindow) {  // NOLINT(cert-err58-cpp)
+    const uint64_t far = 900 + genie::format::sam::Importer::MAX_MATE_DISTANCE + 1;
+    const uint64_t near = 1000 + genie::format::sam::Importer::MAX_MATE_DISTANCE;
+    std::vector<genie::format::sam::Alignment> script = {aln("far", 0, 900, 0, far), aln("near", 0, 1000, 0, near),
+                                                         aln("x", 0, 2000), aln("far", 0, far, 0, 900),
+                                                         aln("near", 0, near, 0, 1000)};
+    auto source = genie::util::make_unique<ScriptedSource>(script);
+    auto* source_ptr = source.get();
+    genie::format::sam::Importer importer(1, std::move(source));
+
+    // "far" is not waited for, so its first alignment leaves as soon as the input is past it
+    genie::core::record::Chunk chunk;
+    EXPECT_TRUE(importer.pumpRetrieve(&chunk));
+    ASSERT_EQ(chunk.getData().size(), 1);
+    EXPECT_EQ(chunk.getData().front().getName(), "far");
+    EXPECT_EQ(chunk.getData().front().getSegments().size(), 1);
+    EXPECT_EQ(source_ptr->numRead, 2);
+
+    // "near" holds back everything behind it until its mate arrived
+    chunk = genie::core::record::Chunk();
+    EXPECT_TRUE(importer.pumpRetrieve(&chunk));
+    ASSERT_EQ(chunk.getData().size(), 1);
+    EXPECT_EQ(chunk.getData().front().getName(), "near");
+    EXPECT_EQ(chunk.getData().front().getSegments().size(), 2);
+    EXPECT_EQ(source_ptr->numRead, 5);
+
+    std::vector<std::vector<genie::core::record::Record>> chunks;
+    importAll(importer, &chunks);
+    const std::vector<std::string> expected = {"x:1@10:2000", "far:1@10:" + std::to_string(far)};
+    EXPECT_EQ(summary(chunks), expected);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SamImporter, missingAndUnmappedMates) {  // NOLINT(cert-err58-cpp)
+    // "u" has an unmapped mate placed at its position, "m" a mate that never comes, "s" has a secondary alignment
+    std::vector<genie::format::sam::Alignment> script = {
+        aln("u", 0, 100, 0, 100), aln("u", 0, 100, 0, 100), aln("m", 0, 200, 0, 400), aln("s", 0, 250),
+        aln("s", 0, 260, -1, 0, true), aln("bad", 0, 300), aln("y", 0, 500), aln("z", -1, 0), aln("z", -1, 0)};
+    genie::format::sam::Importer importer(100, genie::util::make_unique<ScriptedSource>(script));
+    std::vector<std::vector<genie::core::record::Record>> chunks;
+    importAll(importer, &chunks);
+
+    const std::vector<std::string> expected = {"u:2@10:100", "m:1@10:200", "s:1@10:250", "y:1@10:500", "z:1",
+                                               "z:1"};
+    EXPECT_EQ(summary(chunks), expected);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SamImporter, multipleReferences) {  // NOLINT(cert-err58-cpp)
+    // Mates on different references are not waited for, chunks never mix references
+    std::vector<genie::format::sam::Alignment> script = {aln("a", 0, 100, 1, 50), aln("b", 0, 200, 0, 250),
+                                                         aln("b", 0, 250, 0, 200), aln("a", 1, 50, 0, 100),
+                                                         aln("c", 1, 60), aln("d", 2, 10)};
+    genie::format::sam::Importer importer(100, genie::util::make_unique<ScriptedSource>(script));
+    std::vector<std::vector<genie::core::record::Record>> chunks;
+    importAll(importer, &chunks);
+
+    ASSERT_EQ(chunks.size(), 3);
+    const std::vector<std::string> expected = {"a:1@10:100", "b:2@10:200", "a:1@11:50", "c:1@11:60", "d:1@12:10"};
+    EXPECT_EQ(summary(chunks), expected);
+    EXPECT_EQ(chunks[0].size(), 2);
+    EXPECT_EQ(chunks[1].size(), 2);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(SamImporter, unsortedInput) {  // NOLINT(cert-err58-cpp)
+    std::vector<genie::format::sam::Alignment> script = {aln("a", 0, 200), aln("b", 0, 100)};
+    genie::format::sam::Importer importer(100, genie::util::make_unique<ScriptedSource>(script));
+    genie::core::record::Chunk chunk;
+    EXPECT_THROW(importer.pumpRetrieve(&chunk), genie::util::RuntimeException);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
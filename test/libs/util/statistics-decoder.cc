@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/core/statistics-decoder.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Descriptors of two single end class I records as written by the base encoder:
+ * 100 "3=N2=1+3=" forward, score 30, quality check failed;
+ * 150 "(2)4=1-4=" reverse, score 40
+ */
+static genie::core::AccessUnit makeAU() {
+    using genie::core::GenSub;
+    genie::core::AccessUnit au(genie::core::parameter::EncodingSet(), 2);
+    au.setClassType(genie::core::record::ClassType::CLASS_I);
+    au.setReference(0);
+    au.setMinPos(100);
+    au.setMaxPos(150);
+
+    for (uint64_t v : {0, 50}) au.push(GenSub::POS_MAPPING_FIRST, v);
+    for (uint64_t v : {0, 1}) au.push(GenSub::RCOMP, v);
+    for (uint64_t v : {9, 9}) au.push(GenSub::RLEN, v);
+    for (uint64_t v : {4, 4}) au.push(GenSub::RTYPE, v);
+    for (uint64_t v : {30, 40}) au.push(GenSub::MSCORE, v);
+    for (uint64_t v : {0, 0}) au.push(GenSub::FLAGS_PCR_DUPLICATE, v);
+    for (uint64_t v : {1, 0}) au.push(GenSub::FLAGS_QUALITY_FAIL, v);
+    for (uint64_t v : {0, 0}) au.push(GenSub::FLAGS_PROPER_PAIR, v);
+
+    for (uint64_t v : {0, 0, 1, 0, 1}) au.push(GenSub::MMPOS_TERMINATOR, v);
+    for (uint64_t v : {3, 2, 4}) au.push(GenSub::MMPOS_POSITION, v);
+    for (uint64_t v : {0, 1, 2}) au.push(GenSub::MMTYPE_TYPE, v);
+    au.push(GenSub::MMTYPE_INSERTION, 2);
+
+    au.push(GenSub::CLIPS_RECORD_ID, 1);
+    for (uint64_t v : {0, 8}) au.push(GenSub::CLIPS_TYPE, v);
+    for (uint64_t v : {0, 1, 5}) au.push(GenSub::CLIPS_SOFT_STRING, v);
+    return au;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(StatisticsDecoderTest, simple) {
+    genie::core::StatisticsDecoder decoder(0, 0, std::numeric_limits<uint64_t>::max(), false);
+    decoder.add(makeAU());
+    auto stats = decoder.getSimpleStatistics();
+
+    EXPECT_EQ(stats.readsNumber, 2);
+    EXPECT_EQ(stats.qualityCheckFailedReadsNumber, 1);
+    EXPECT_EQ(stats.segmentLength, (std::array<uint64_t, 3>{{10, 10, 10}}));
+    EXPECT_EQ(stats.mappedStrandSegmentDistribution[uint8_t(genie::core::api::Strand::FORWARD)], 1);
+    EXPECT_EQ(stats.mappedStrandSegmentDistribution[uint8_t(genie::core::api::Strand::REVERSE)], 1);
+    EXPECT_EQ(stats.substitutionsNumber, (std::array<uint64_t, 3>{{0, 1, 0}}));
+    EXPECT_EQ(stats.insertionsNumber, (std::array<uint64_t, 3>{{0, 1, 0}}));
+    EXPECT_EQ(stats.deletionsNumber, (std::array<uint64_t, 3>{{0, 1, 0}}));
+    EXPECT_EQ(stats.errorsNumber, (std::array<uint64_t, 3>{{1, 2, 1}}));
+    EXPECT_EQ(stats.alignmentScore, (std::array<uint64_t, 3>{{30, 40, 35}}));
+    EXPECT_EQ(stats.clippedSegmentDistribution, (std::array<uint64_t, 3>{{1, 1, 0}}));
+    EXPECT_EQ(stats.classSegmentDistribution[uint8_t(genie::core::record::ClassType::CLASS_I) - 1], 2);
+
+    // Both records cover 9 reference positions: 100-108 and 150-158
+    EXPECT_EQ(stats.coverage[uint8_t(genie::core::api::StatisticsIndex::MINIMUM)], 0);
+    EXPECT_EQ(stats.coverage[uint8_t(genie::core::api::StatisticsIndex::MAXIMUM)], 1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(StatisticsDecoderTest, regionAndStrands) {
+    genie::core::StatisticsDecoder decoder(0, 140, 199, true);
+    decoder.add(makeAU());
+    auto stats = decoder.getAdvancedStatistics();
+
+    const auto& forward = stats.simpleStatistics[uint8_t(genie::core::api::StrandStrict::FORWARD)];
+    const auto& reverse = stats.simpleStatistics[uint8_t(genie::core::api::StrandStrict::REVERSE)];
+    EXPECT_EQ(forward.readsNumber, 0);
+    EXPECT_EQ(reverse.readsNumber, 1);
+
+    const auto& extended = stats.extendedStatistics[uint8_t(genie::core::api::StrandStrict::REVERSE)];
+    ASSERT_EQ(extended.coverage.size(), 60);
+    EXPECT_EQ(extended.coverage[9], 0);
+    EXPECT_EQ(extended.coverage[10], 1);
+    EXPECT_EQ(extended.coverage[18], 1);
+    EXPECT_EQ(extended.coverage[19], 0);
+    EXPECT_EQ(extended.deletionsPositionDistribution, std::vector<uint64_t>({0, 0, 0, 0, 0, 0, 1}));
+    EXPECT_EQ(extended.mappedBasesNumberDistribution.size(), 9);
+    EXPECT_EQ(extended.mappedBasesNumberDistribution.back(), 1);
+
+    // Other sequence
+    genie::core::StatisticsDecoder other(1, 0, 1000, false);
+    other.add(makeAU());
+    EXPECT_EQ(other.getSimpleStatistics().readsNumber, 0);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(StatisticsDecoderTest, openRegionCoverage) {
+    genie::core::StatisticsDecoder decoder(0, 0, std::numeric_limits<uint64_t>::max(), true);
+    decoder.add(makeAU());
+    decoder.add(makeAU());
+    auto stats = decoder.getAdvancedStatistics();
+
+    // Reported from the first to the last covered position, 150-158 on the reverse strand
+    const auto& extended = stats.extendedStatistics[uint8_t(genie::core::api::StrandStrict::REVERSE)];
+    ASSERT_EQ(extended.coverage.size(), 9);
+    EXPECT_EQ(extended.coverage.front(), 2);
+    EXPECT_EQ(extended.coverage.back(), 2);
+
+    // 100-158, of which 18 positions are covered twice
+    genie::core::StatisticsDecoder simple(0, 0, std::numeric_limits<uint64_t>::max(), false);
+    simple.add(makeAU());
+    simple.add(makeAU());
+    EXPECT_EQ(simple.getSimpleStatistics().coverage, (std::array<uint64_t, 3>{{0, 2, 36 / 59}}));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(StatisticsDecoderTest, ecigar) {
+    using Mismatch = genie::core::StatisticsDecoder::SegmentInfo::Mismatch;
+    genie::core::StatisticsDecoder::SegmentInfo segment;
+    segment.length = 10;
+    segment.mismatches = {Mismatch{3, genie::core::GenConst::MMTYPE_SUBSTITUTION, 4, 1},
+                          Mismatch{6, genie::core::GenConst::MMTYPE_INSERTION, 4, 2}};
+    EXPECT_EQ(segment.getECigar(), "3=C2=1+3=");
+    EXPECT_EQ(segment.getReferenceLength(), 9);
+
+    segment.softClips = {{2, 0}};
+    segment.hardClips = {{0, 3}};
+    segment.mismatches = {Mismatch{6, genie::core::GenConst::MMTYPE_DELETION, 4, 4},
+                          Mismatch{6, genie::core::GenConst::MMTYPE_DELETION, 4, 4}};
+    EXPECT_EQ(segment.getECigar(), "(2)4=2-4=[3]");
+    EXPECT_EQ(segment.getReferenceLength(), 10);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
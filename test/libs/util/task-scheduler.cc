@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @copyright This file is part of GENIE. See LICENSE and/or
+ * https://github.com/mitogen/genie for more details.
+ */
+
+#include <genie/util/task-scheduler.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(TaskSchedulerTest, runAll) {
+    genie::util::TaskScheduler scheduler(4);
+    std::atomic<size_t> sum(0);
+    {
+        genie::util::TaskGroup group(&scheduler);
+        for (size_t i = 1; i <= 1000; ++i) {
+            group.run([&sum, i]() { sum += i; });
+        }
+        group.wait();
+    }
+    EXPECT_EQ(sum, 500500);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(TaskSchedulerTest, nested) {
+    genie::util::TaskScheduler scheduler(3);
+    std::atomic<size_t> count(0);
+    genie::util::TaskGroup outer(&scheduler);
+    for (size_t i = 0; i < 8; ++i) {
+        outer.run([&count]() {
+            // Subtasks go to the scheduler of the calling worker
+            genie::util::TaskGroup inner;
+            for (size_t j = 0; j < 16; ++j) {
+                inner.run([&count]() { count++; });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+    EXPECT_EQ(count, 128);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(TaskSchedulerTest, lanes) {
+    genie::util::TaskScheduler scheduler(2);
+    std::atomic<size_t> steps(0);
+    genie::util::TaskGroup group(&scheduler);
+    std::function<void(size_t)> lane = [&](size_t left) {
+        steps++;
+        if (left) {
+            group.runLane([&lane, left]() { lane(left - 1); });
+        }
+    };
+    group.runLane([&lane]() { lane(9); });
+    group.runLane([&lane]() { lane(4); });
+    group.wait();
+    EXPECT_EQ(steps, 15);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(TaskSchedulerTest, exception) {
+    genie::util::TaskScheduler scheduler(2);
+    genie::util::TaskGroup group(&scheduler);
+    group.run([]() {});
+    group.run([]() { throw std::runtime_error("task failed"); });
+    EXPECT_THROW(group.wait(), std::runtime_error);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(TaskSchedulerTest, inline) {
+    size_t count = 0;
+    genie::util::TaskGroup group(nullptr);
+    for (size_t i = 0; i < 10; ++i) {
+        group.run([&count]() { count++; });
+    }
+    EXPECT_EQ(count, 10);
+    group.wait();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(TaskSchedulerTest, waitSleepsUntilStolenTaskIsDone) {
+    genie::util::TaskScheduler scheduler(2);
+    std::atomic<bool> done(false);
+    genie::util::TaskGroup outer(&scheduler);
+    outer.run([&done]() {
+        genie::util::TaskGroup inner;
+        inner.run([&done]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            done = true;
+        });
+        // A pending lane must not keep the waiting worker busy
+        inner.wait();
+        EXPECT_TRUE(done);
+    });
+    outer.runLane([]() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); });
+    outer.wait();
+    EXPECT_TRUE(done);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
@@ -6,7 +6,9 @@
 
 #include <genie/util/thread-manager.h>
 #include <gtest/gtest.h>
+#include <atomic>
 #include <future>
+#include <stdexcept>
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -96,4 +98,45 @@ TEST(ThreadManagerTest, abort) {
     EXPECT_EQ(source1.getFlushpos(), -1);
 }
 
-// ---------------------------------------------------------------------------------------------------------------------
\ No newline at end of file
+// ---------------------------------------------------------------------------------------------------------------------
+
+class ThreadManager_ThrowingSource : public genie::util::OriginalSource {
+   private:
+    std::atomic<size_t> counter;
+   public:
+    virtual bool pump(uint64_t& t_id, std::mutex& lock) override {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            t_id++;
+        }
+        if (counter++ == 3) {
+            throw std::out_of_range("pump failed");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return counter < 1000;
+    }
+    virtual void flushIn(uint64_t&) override {
+    }
+
+    ThreadManager_ThrowingSource() : counter(0) {
+    }
+
+    size_t getCounter() const {
+        return counter;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TEST(ThreadManagerTest, exception) {
+    genie::util::ThreadManager manager(4);
+    ThreadManager_ThrowingSource source1;
+    std::vector<genie::util::OriginalSource*> srcvec = {&source1};
+    manager.setSource(srcvec);
+
+    // The exception keeps its type and stops the other lanes
+    EXPECT_THROW(manager.run(), std::out_of_range);
+    EXPECT_LT(source1.getCounter(), 100);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------